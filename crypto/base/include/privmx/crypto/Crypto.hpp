@@ -17,6 +17,7 @@ limitations under the License.
 #include <Poco/Types.h>
 
 #include <privmx/crypto/CryptoEnv.hpp>
+#include <privmx/utils/MetricsRegistry.hpp>
 
 namespace privmx {
 namespace crypto {
@@ -41,6 +42,7 @@ public:
     static std::string aes256CbcNoPadDecrypt(const std::string& data, const std::string& key, const std::string& iv);
     static std::string aes256GcmEncrypt(const std::string& data, const std::string& key, const std::string& iv, const std::string& aad = "");
     static std::string aes256GcmDecrypt(const std::string& data, const std::string& key, const std::string& iv, const std::string& aad = "");
+    static std::string aes256GcmDecrypt(const char* data, size_t dataSize, const std::string& key, const char* iv, const char* aad, size_t aadSize);
     static std::string prf_tls12(const std::string& key, const std::string& seed, size_t length);
     static std::string pbkdf2(const std::string& password, const std::string& salt, size_t rounds, size_t length, const std::string& algorithm);
     static std::string kdf(size_t length, const std::string& key, const std::string& label);
@@ -65,11 +67,13 @@ inline std::string Crypto::hmacSha1(const std::string& key, const std::string& d
 }
 
 inline std::string Crypto::hmacSha256(const std::string& key, const std::string& data) {
+    utils::MetricsRegistry::recordCryptoOperation(utils::MetricsRegistry::HMAC, data.size());
     auto crypto_service = CryptoEnv::getEnv()->getCryptoService();
     return crypto_service->hmacSha256(key, data);
 }
 
 inline std::string Crypto::hmacSha512(const std::string& key, const std::string& data) {
+    utils::MetricsRegistry::recordCryptoOperation(utils::MetricsRegistry::HMAC, data.size());
     auto crypto_service = CryptoEnv::getEnv()->getCryptoService();
     return crypto_service->hmacSha512(key, data);
 }
@@ -80,11 +84,13 @@ inline std::string Crypto::sha1(const std::string& data) {
 }
 
 inline std::string Crypto::sha256(const std::string& data) {
+    utils::MetricsRegistry::recordCryptoOperation(utils::MetricsRegistry::HASH, data.size());
     auto crypto_service = CryptoEnv::getEnv()->getCryptoService();
     return crypto_service->sha256(data);
 }
 
 inline std::string Crypto::sha512(const std::string& data) {
+    utils::MetricsRegistry::recordCryptoOperation(utils::MetricsRegistry::HASH, data.size());
     auto crypto_service = CryptoEnv::getEnv()->getCryptoService();
     return crypto_service->sha512(data);
 }
@@ -110,11 +116,13 @@ inline std::string Crypto::aes256EcbDecrypt(const std::string& data, const std::
 }
 
 inline std::string Crypto::aes256CbcPkcs7Encrypt(const std::string& data, const std::string& key, const std::string& iv) {
+    utils::MetricsRegistry::recordCryptoOperation(utils::MetricsRegistry::AES_ENCRYPT, data.size());
     auto crypto_service = CryptoEnv::getEnv()->getCryptoService();
     return crypto_service->aes256CbcPkcs7Encrypt(data, key, iv);
 }
 
 inline std::string Crypto::aes256CbcPkcs7Decrypt(const std::string& data, const std::string& key, const std::string& iv) {
+    utils::MetricsRegistry::recordCryptoOperation(utils::MetricsRegistry::AES_DECRYPT, data.size());
     auto crypto_service = CryptoEnv::getEnv()->getCryptoService();
     return crypto_service->aes256CbcPkcs7Decrypt(data, key, iv);
 }
@@ -130,15 +138,23 @@ inline std::string Crypto::aes256CbcNoPadDecrypt(const std::string& data, const
 }
 
 inline std::string Crypto::aes256GcmEncrypt(const std::string& data, const std::string& key, const std::string& iv, const std::string& aad) {
+    utils::MetricsRegistry::recordCryptoOperation(utils::MetricsRegistry::AES_ENCRYPT, data.size());
     auto crypto_service = CryptoEnv::getEnv()->getCryptoService();
     return crypto_service->aes256GcmEncrypt(data, key, iv, aad);
 }
 
 inline std::string Crypto::aes256GcmDecrypt(const std::string& data, const std::string& key, const std::string& iv, const std::string& aad) {
+    utils::MetricsRegistry::recordCryptoOperation(utils::MetricsRegistry::AES_DECRYPT, data.size());
     auto crypto_service = CryptoEnv::getEnv()->getCryptoService();
     return crypto_service->aes256GcmDecrypt(data, key, iv, aad);
 }
 
+inline std::string Crypto::aes256GcmDecrypt(const char* data, size_t dataSize, const std::string& key, const char* iv, const char* aad, size_t aadSize) {
+    utils::MetricsRegistry::recordCryptoOperation(utils::MetricsRegistry::AES_DECRYPT, dataSize);
+    auto crypto_service = CryptoEnv::getEnv()->getCryptoService();
+    return crypto_service->aes256GcmDecrypt(data, dataSize, key, iv, aad, aadSize);
+}
+
 inline std::string Crypto::prf_tls12(const std::string& key, const std::string& seed, size_t length) {
     auto crypto_service = CryptoEnv::getEnv()->getCryptoService();
     return crypto_service->prf_tls12(key, seed, length);
@@ -165,11 +181,13 @@ inline std::tuple<std::string, std::string> Crypto::getKEM(const std::string& ke
 }
 
 inline std::string Crypto::aes256CbcHmac256Encrypt(std::string data, const std::string& key32, std::string iv, size_t taglen) {
+    utils::MetricsRegistry::recordCryptoOperation(utils::MetricsRegistry::AES_ENCRYPT, data.size());
     auto crypto_service = CryptoEnv::getEnv()->getCryptoService();
     return crypto_service->aes256CbcHmac256Encrypt(data, key32, iv, taglen);
 }
 
 inline std::string Crypto::aes256CbcHmac256Decrypt(std::string data, const std::string& key32, size_t taglen) {
+    utils::MetricsRegistry::recordCryptoOperation(utils::MetricsRegistry::AES_DECRYPT, data.size());
     auto crypto_service = CryptoEnv::getEnv()->getCryptoService();
     return crypto_service->aes256CbcHmac256Decrypt(data, key32, taglen);
 }
@@ -43,6 +43,10 @@ public:
     virtual std::string aes256CbcNoPadDecrypt(const std::string& data, const std::string& key, const std::string& iv) const  = 0;
     virtual std::string aes256GcmEncrypt(const std::string& data, const std::string& key, const std::string& iv, const std::string& aad) const = 0;
     virtual std::string aes256GcmDecrypt(const std::string& data, const std::string& key, const std::string& iv, const std::string& aad) const = 0;
+    // data and aad are read in place, iv is 12 bytes, services without a native implementation copy them
+    virtual std::string aes256GcmDecrypt(const char* data, size_t dataSize, const std::string& key, const char* iv, const char* aad, size_t aadSize) const {
+        return aes256GcmDecrypt(std::string(data, dataSize), key, std::string(iv, 12), std::string(aad, aadSize));
+    }
     virtual std::string prf_tls12(const std::string& key, const std::string& seed, size_t length) const  = 0;
     virtual std::string kdf(size_t length, const std::string& key, const std::string& label) const  = 0;
     virtual std::string generateIv(const std::string& key, Poco::Int32 idx) const  = 0;
@@ -34,6 +34,9 @@ public:
     static std::string encryptObjectToBase64(const PublicKey& pub, Poco::JSON::Object::Ptr data, const PrivateKey& privForSignature);
     static std::string encryptToBase64(const PublicKey& pub, const std::string& data, const PrivateKey& privForSignature);
     static std::string encrypt(const PublicKey& pub, const std::string& data, const PrivateKey& privForSignature);
+
+private:
+    static std::string getSharedKey(const PrivateKey& priv, const std::string& pubDer, const std::optional<PublicKey>& pub = std::nullopt);
 };
 
 } // crypto
@@ -15,6 +15,7 @@ limitations under the License.
 #include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <privmx/crypto/ecc/BN.hpp>
 #include <privmx/crypto/ecc/Point.hpp>
@@ -51,6 +52,8 @@ public:
     Signature sign2(const std::string& data) const;
     bool verify(const std::string& data, const std::string& signature) const;
     bool verify2(const std::string& data, const Signature& signature) const;
+    std::vector<std::string> signMany(const std::vector<std::string>& data) const;
+    bool verifyMany(const std::vector<std::string>& data, const std::vector<std::string>& signatures) const;
     std::string derive(const ECC& ecc) const;
     std::string getOrder() const;
     BN getOrder2() const;
@@ -145,6 +148,14 @@ inline bool ECC::verify2(const std::string& data, const Signature& signature) co
     return _impl->verify2(data, {signature.r.getImpl(), signature.s.getImpl()});
 }
 
+inline std::vector<std::string> ECC::signMany(const std::vector<std::string>& data) const {
+    return _impl->signMany(data);
+}
+
+inline bool ECC::verifyMany(const std::vector<std::string>& data, const std::vector<std::string>& signatures) const {
+    return _impl->verifyMany(data, signatures);
+}
+
 inline std::string ECC::derive(const ECC& ecc) const {
     return _impl->derive(ecc.getImpl());
 }
@@ -13,10 +13,12 @@ limitations under the License.
 #define _PRIVMXLIB_CRYPTO_ECCIMPL_HPP_
 
 #include <string>
+#include <vector>
 #include <Poco/SharedPtr.h>
 
 #include <privmx/crypto/ecc/BNImpl.hpp>
 #include <privmx/crypto/ecc/PointImpl.hpp>
+#include <privmx/crypto/CryptoException.hpp>
 
 namespace privmx {
 namespace crypto {
@@ -46,6 +48,10 @@ public:
     virtual Signature sign2(const std::string& data) const = 0;
     virtual bool verify(const std::string& data, const std::string& signature) const = 0;
     virtual bool verify2(const std::string& data, const Signature& signature) const = 0;
+    // Batch variants for callers signing or verifying several digests with one key.
+    // Implementations may override them to share per-call setup between the items.
+    virtual std::vector<std::string> signMany(const std::vector<std::string>& data) const;
+    virtual bool verifyMany(const std::vector<std::string>& data, const std::vector<std::string>& signatures) const;
     virtual std::string derive(const ECCImpl::Ptr ecc) const = 0;
     virtual std::string getOrder() const = 0;
     virtual BNImpl::Ptr getOrder2() const = 0;
@@ -56,6 +62,27 @@ public:
 
 };
 
+inline std::vector<std::string> ECCImpl::signMany(const std::vector<std::string>& data) const {
+    std::vector<std::string> result;
+    result.reserve(data.size());
+    for (auto& item : data) {
+        result.push_back(sign(item));
+    }
+    return result;
+}
+
+inline bool ECCImpl::verifyMany(const std::vector<std::string>& data, const std::vector<std::string>& signatures) const {
+    if (data.size() != signatures.size()) {
+        throw SignaturesCountMismatchException();
+    }
+    for (size_t i = 0; i < data.size(); ++i) {
+        if (!verify(data[i], signatures[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
 } // crypto
 } // privmx
 
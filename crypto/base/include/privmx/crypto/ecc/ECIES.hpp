@@ -22,6 +22,11 @@ class ECIES
 {
 public:
     ECIES(const PrivateKey& private_key, const PublicKey& public_key);
+    ECIES(const PrivateKey& private_key, const std::string& shared_key);
+    ~ECIES();
+    ECIES(const ECIES&) = delete;
+    ECIES& operator=(const ECIES&) = delete;
+    static std::string deriveSharedKey(const PrivateKey& private_key, const PublicKey& public_key);
     std::string decrypt(const std::string& enc_buf) const;
     std::string encrypt(const std::string& data) const;
 
@@ -0,0 +1,62 @@
+/*
+PrivMX Endpoint.
+Copyright © 2024 Simplito sp. z o.o.
+
+This file is part of the PrivMX Platform (https://privmx.dev).
+This software is Licensed under the PrivMX Free License.
+
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef _PRIVMXLIB_CRYPTO_ECIESKEYCACHE_HPP_
+#define _PRIVMXLIB_CRYPTO_ECIESKEYCACHE_HPP_
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace privmx {
+namespace crypto {
+
+// Bounded LRU cache of ECIES key material (sha512 of the ECDH secret) keyed by the peer public key DER.
+// Owned by a single private key and shared between its copies. Evicted entries are zeroized.
+class EciesKeyCache
+{
+public:
+    using Ptr = std::shared_ptr<EciesKeyCache>;
+
+    EciesKeyCache(std::size_t maxSize = DEFAULT_MAX_SIZE);
+    ~EciesKeyCache();
+    EciesKeyCache(const EciesKeyCache&) = delete;
+    EciesKeyCache& operator=(const EciesKeyCache&) = delete;
+    std::optional<std::string> get(const std::string& publicKeyDer);
+    void set(const std::string& publicKeyDer, const std::string& sharedKey);
+    void setMaxSize(std::size_t maxSize);
+    void clear();
+    static void erase(std::string& secret);
+
+    static constexpr std::size_t DEFAULT_MAX_SIZE = 1024;
+
+private:
+    struct Entry {
+        std::string sharedKey;
+        std::list<std::string>::iterator lruIt;
+    };
+
+    void evict(std::size_t maxSize);
+
+    std::mutex _mutex;
+    std::size_t _maxSize;
+    std::unordered_map<std::string, Entry> _entries;
+    std::list<std::string> _lru;
+};
+
+} // crypto
+} // privmx
+
+#endif // _PRIVMXLIB_CRYPTO_ECIESKEYCACHE_HPP_
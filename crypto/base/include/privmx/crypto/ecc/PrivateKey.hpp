@@ -13,8 +13,10 @@ limitations under the License.
 #define _PRIVMXLIB_CRYPTO_PRIVATEKEY_HPP_
 
 #include <string>
+#include <vector>
 
 #include <privmx/crypto/ecc/ECC.hpp>
+#include <privmx/crypto/ecc/EciesKeyCache.hpp>
 #include <privmx/crypto/ecc/PublicKey.hpp>
 
 namespace privmx {
@@ -31,12 +33,16 @@ public:
     std::string getPrivateEncKey() const;
     std::string signToCompactSignature(const std::string& message) const;
     std::string signToCompactSignatureWithHash(const std::string& message) const;
+    std::vector<std::string> signManyToCompactSignature(const std::vector<std::string>& messages) const;
+    std::vector<std::string> signManyToCompactSignatureWithHash(const std::vector<std::string>& messages) const;
     std::string derive(const PublicKey& public_key) const;
     ECC getEccKey() const;
     std::string toWIF() const;
+    const EciesKeyCache::Ptr& getEciesKeyCache() const;
 
 private:
     ECC _key;
+    EciesKeyCache::Ptr _eciesKeyCache = std::make_shared<EciesKeyCache>();
 };
 
 inline PublicKey PrivateKey::getPublicKey() const {
@@ -47,6 +53,10 @@ inline ECC PrivateKey::getEccKey() const {
     return _key;
 }
 
+inline const EciesKeyCache::Ptr& PrivateKey::getEciesKeyCache() const {
+    return _eciesKeyCache;
+}
+
 } // crypto
 } // privmx
 
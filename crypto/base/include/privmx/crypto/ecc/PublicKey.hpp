@@ -13,6 +13,7 @@ limitations under the License.
 #define _PRIVMXLIB_CRYPTO_PUBLICKEY_HPP_
 
 #include <string>
+#include <vector>
 
 #include <privmx/crypto/ecc/ECC.hpp>
 
@@ -33,6 +34,8 @@ public:
     std::string toBase58Address() const;
     bool verifyCompactSignature(const std::string& message, const std::string& signature) const;
     bool verifyCompactSignatureWithHash(const std::string& message, const std::string& signature) const;
+    bool verifyManyCompactSignatures(const std::vector<std::string>& messages, const std::vector<std::string>& signatures) const;
+    bool verifyManyCompactSignaturesWithHash(const std::vector<std::string>& messages, const std::vector<std::string>& signatures) const;
     const ECC& getEcc() const;
 
 private:
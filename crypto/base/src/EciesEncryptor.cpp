@@ -33,21 +33,20 @@ string EciesEncryptor::decrypt(const PrivateKey& priv, const string& cipher, con
     }
     auto external_pub = cipher.substr(1, 33);
     auto my_pub = cipher.substr(34, 33);
-    auto external_pub_ec = PublicKey::fromDER(external_pub);
-    if(pubOfSignature.has_value() && external_pub_ec != pubOfSignature.value()) {
+    // both keys are compressed DER, so comparing bytes is enough and spares parsing the points
+    if(pubOfSignature.has_value() && external_pub != pubOfSignature.value().toDER()) {
         throw GivenPublicKeyDoesNotMatchWithSignatureException();
     }
-    auto my_pub_ec = PublicKey::fromDER(my_pub);
-    if (my_pub_ec != priv.getPublicKey()) {
+    if (my_pub != priv.getPublicKey().toDER()) {
         throw GivenPrivKeyDoesNotMatchException();
     }
-    ECIES ecies(priv, external_pub_ec);
+    ECIES ecies(priv, getSharedKey(priv, external_pub, pubOfSignature));
     auto key = ecies.decrypt(cipher.substr(67));
     return key;
 }
 
 string EciesEncryptor::decryptV0(const PrivateKey& priv, const PublicKey& pub, const string& cipher) {
-    ECIES ecies(priv, pub);
+    ECIES ecies(priv, getSharedKey(priv, pub.toDER(), pub));
     return ecies.decrypt(cipher);
 }
 
@@ -60,10 +59,22 @@ string EciesEncryptor::encryptToBase64(const PublicKey& pub, const string& data,
 }
 
 string EciesEncryptor::encrypt(const PublicKey& pub, const string& data, const PrivateKey& privForSignature) {
-    ECIES ecies(privForSignature, pub);
+    auto pubDer = pub.toDER();
+    ECIES ecies(privForSignature, getSharedKey(privForSignature, pubDer, pub));
     auto cipher = ecies.encrypt(data);
     return string("e")
             .append(privForSignature.getPublicKey().toDER())
-            .append(pub.toDER())
+            .append(pubDer)
             .append(cipher);
 }
+
+string EciesEncryptor::getSharedKey(const PrivateKey& priv, const string& pubDer, const std::optional<PublicKey>& pub) {
+    auto& cache = priv.getEciesKeyCache();
+    auto cached = cache->get(pubDer);
+    if (cached.has_value()) {
+        return cached.value();
+    }
+    auto sharedKey = ECIES::deriveSharedKey(priv, pub.has_value() ? pub.value() : PublicKey::fromDER(pubDer));
+    cache->set(pubDer, sharedKey);
+    return sharedKey;
+}
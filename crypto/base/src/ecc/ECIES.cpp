@@ -12,6 +12,7 @@ limitations under the License.
 #include <privmx/crypto/Crypto.hpp>
 #include <privmx/crypto/CryptoException.hpp>
 #include <privmx/crypto/ecc/ECIES.hpp>
+#include <privmx/utils/MetricsRegistry.hpp>
 #include <privmx/utils/Utils.hpp>
 
 using namespace privmx;
@@ -19,27 +20,48 @@ using namespace privmx::crypto;
 using namespace std;
 
 ECIES::ECIES(const PrivateKey& private_key, const PublicKey& public_key) {
-    string secret = private_key.derive(public_key);
-    _shared_key = Crypto::sha512(secret);
+    _shared_key = deriveSharedKey(private_key, public_key);
     _private_enc_key = private_key.getPrivateEncKey();
 }
 
+ECIES::ECIES(const PrivateKey& private_key, const string& shared_key) {
+    _shared_key = shared_key;
+    _private_enc_key = private_key.getPrivateEncKey();
+}
+
+ECIES::~ECIES() {
+    EciesKeyCache::erase(_shared_key);
+    EciesKeyCache::erase(_private_enc_key);
+}
+
+string ECIES::deriveSharedKey(const PrivateKey& private_key, const PublicKey& public_key) {
+    string secret = private_key.derive(public_key);
+    string shared_key = Crypto::sha512(secret);
+    EciesKeyCache::erase(secret);
+    return shared_key;
+}
+
+// HMAC and AES are called on the crypto service, not through the Crypto facade, so that they are counted only as ECIES
 string ECIES::encrypt(const string& data) const {
-    string iv = Crypto::hmacSha256(_private_enc_key, data).substr(0, 16);
+    utils::MetricsRegistry::recordCryptoOperation(utils::MetricsRegistry::ECIES_ENCRYPT, data.size());
+    auto crypto_service = CryptoEnv::getEnv()->getCryptoService();
+    string iv = crypto_service->hmacSha256(_private_enc_key, data).substr(0, 16);
     string M = getM();
     string E = getE();
-    string c = iv + Crypto::aes256CbcPkcs7Encrypt(data, E, iv);
-    return c + Crypto::hmacSha256(M, c).substr(0, 4);
+    string c = iv + crypto_service->aes256CbcPkcs7Encrypt(data, E, iv);
+    return c + crypto_service->hmacSha256(M, c).substr(0, 4);
 }
 
 string ECIES::decrypt(const string& enc_buf) const {
+    utils::MetricsRegistry::recordCryptoOperation(utils::MetricsRegistry::ECIES_DECRYPT, enc_buf.size());
+    auto crypto_service = CryptoEnv::getEnv()->getCryptoService();
     string c = enc_buf.substr(0, enc_buf.length() - 4);
     string d = enc_buf.substr(enc_buf.length() - 4, 4);
     string M = getM();
-    string d2 = Crypto::hmacSha256(M, c).substr(0, 4);
+    string d2 = crypto_service->hmacSha256(M, c).substr(0, 4);
     if (d != d2) {
         throw InvalidChecksumException();
     }
     string E = getE();
-    return Crypto::aes256CbcPkcs7Decrypt(c.substr(16), E, c.substr(0, 16));
+    return crypto_service->aes256CbcPkcs7Decrypt(c.substr(16), E, c.substr(0, 16));
 }
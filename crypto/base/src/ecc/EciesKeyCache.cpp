@@ -0,0 +1,76 @@
+/*
+PrivMX Endpoint.
+Copyright © 2024 Simplito sp. z o.o.
+
+This file is part of the PrivMX Platform (https://privmx.dev).
+This software is Licensed under the PrivMX Free License.
+
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <privmx/crypto/ecc/EciesKeyCache.hpp>
+
+using namespace privmx;
+using namespace privmx::crypto;
+using namespace std;
+
+EciesKeyCache::EciesKeyCache(size_t maxSize) : _maxSize(maxSize) {}
+
+EciesKeyCache::~EciesKeyCache() {
+    clear();
+}
+
+optional<string> EciesKeyCache::get(const string& publicKeyDer) {
+    lock_guard<mutex> lock(_mutex);
+    auto it = _entries.find(publicKeyDer);
+    if (it == _entries.end()) {
+        return nullopt;
+    }
+    _lru.splice(_lru.begin(), _lru, it->second.lruIt);
+    return it->second.sharedKey;
+}
+
+void EciesKeyCache::set(const string& publicKeyDer, const string& sharedKey) {
+    lock_guard<mutex> lock(_mutex);
+    if (_maxSize == 0) {
+        return;
+    }
+    auto it = _entries.find(publicKeyDer);
+    if (it != _entries.end()) {
+        _lru.splice(_lru.begin(), _lru, it->second.lruIt);
+        return;
+    }
+    evict(_maxSize - 1);
+    _lru.push_front(publicKeyDer);
+    _entries.emplace(publicKeyDer, Entry{sharedKey, _lru.begin()});
+}
+
+void EciesKeyCache::setMaxSize(size_t maxSize) {
+    lock_guard<mutex> lock(_mutex);
+    _maxSize = maxSize;
+    evict(_maxSize);
+}
+
+void EciesKeyCache::clear() {
+    lock_guard<mutex> lock(_mutex);
+    evict(0);
+}
+
+void EciesKeyCache::erase(string& secret) {
+    // volatile access keeps the compiler from dropping the stores to memory which is about to be freed
+    volatile char* ptr = secret.data();
+    for (size_t i = 0; i < secret.size(); ++i) {
+        ptr[i] = 0;
+    }
+    secret.clear();
+}
+
+void EciesKeyCache::evict(size_t maxSize) {
+    while (_entries.size() > maxSize) {
+        auto it = _entries.find(_lru.back());
+        erase(it->second.sharedKey);
+        _entries.erase(it);
+        _lru.pop_back();
+    }
+}
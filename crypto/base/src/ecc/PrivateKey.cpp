@@ -14,6 +14,7 @@ limitations under the License.
 #include <privmx/crypto/ecc/Networks.hpp>
 #include <privmx/crypto/ecc/PrivateKey.hpp>
 #include <privmx/utils/Base58.hpp>
+#include <privmx/utils/MetricsRegistry.hpp>
 #include <privmx/utils/Utils.hpp>
 
 using namespace privmx;
@@ -53,6 +54,7 @@ string PrivateKey::getPrivateEncKey() const {
 }
 
 string PrivateKey::signToCompactSignature(const string& message) const {
+    MetricsRegistry::recordCryptoOperation(MetricsRegistry::ECDSA_SIGN, message.size());
     return _key.sign(message);
 }
 
@@ -61,7 +63,24 @@ string PrivateKey::signToCompactSignatureWithHash(const string& message) const {
     return signToCompactSignature(hash);
 }
 
+vector<string> PrivateKey::signManyToCompactSignature(const vector<string>& messages) const {
+    for (auto& message : messages) {
+        MetricsRegistry::recordCryptoOperation(MetricsRegistry::ECDSA_SIGN, message.size());
+    }
+    return _key.signMany(messages);
+}
+
+vector<string> PrivateKey::signManyToCompactSignatureWithHash(const vector<string>& messages) const {
+    vector<string> hashes;
+    hashes.reserve(messages.size());
+    for (auto& message : messages) {
+        hashes.push_back(Crypto::sha256(message));
+    }
+    return signManyToCompactSignature(hashes);
+}
+
 string PrivateKey::derive(const PublicKey& public_key) const {
+    MetricsRegistry::recordCryptoOperation(MetricsRegistry::ECDH, 0);
     return _key.derive(public_key.getEcc());
 }
 
@@ -13,6 +13,7 @@ limitations under the License.
 #include <privmx/crypto/ecc/Networks.hpp>
 #include <privmx/crypto/ecc/PublicKey.hpp>
 #include <privmx/utils/Base58.hpp>
+#include <privmx/utils/MetricsRegistry.hpp>
 
 using namespace privmx;
 using namespace privmx::crypto;
@@ -54,6 +55,7 @@ string PublicKey::toBase58Address() const {
 }
 
 bool PublicKey::verifyCompactSignature(const string& message, const string& signature) const {
+    MetricsRegistry::recordCryptoOperation(MetricsRegistry::ECDSA_VERIFY, message.size());
     return _key.verify(message, signature);
 }
 
@@ -61,3 +63,19 @@ bool PublicKey::verifyCompactSignatureWithHash(const string& message, const stri
     string hash = Crypto::sha256(message);
     return verifyCompactSignature(hash, signature);
 }
+
+bool PublicKey::verifyManyCompactSignatures(const vector<string>& messages, const vector<string>& signatures) const {
+    for (auto& message : messages) {
+        MetricsRegistry::recordCryptoOperation(MetricsRegistry::ECDSA_VERIFY, message.size());
+    }
+    return _key.verifyMany(messages, signatures);
+}
+
+bool PublicKey::verifyManyCompactSignaturesWithHash(const vector<string>& messages, const vector<string>& signatures) const {
+    vector<string> hashes;
+    hashes.reserve(messages.size());
+    for (auto& message : messages) {
+        hashes.push_back(Crypto::sha256(message));
+    }
+    return verifyManyCompactSignatures(hashes, signatures);
+}
@@ -0,0 +1,73 @@
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include <privmx/crypto/Crypto.hpp>
+#include <privmx/crypto/CryptoException.hpp>
+#include <privmx/crypto/ecc/PrivateKey.hpp>
+#include <privmx/crypto/ecc/PublicKey.hpp>
+#include <privmx/utils/Utils.hpp>
+
+using namespace std;
+
+namespace privmx {
+namespace crypto {
+namespace {
+
+TEST(ECCTest, VerifyExternalSignature) {
+    // signature of sha256("privmx") created with `openssl pkeyutl -sign`, in compact form: 27 | r | s
+    const string pub_der = utils::Hex::toString("0385ceba7986289fc8ae6636635024b12022291ac129e523bffa8aef8f9f8e9d1e");
+    const string signature = string(1, 27)
+        .append(utils::Hex::toString("418e39915890613bd6a11502cbff7d4148daceb950ac97c5f51b1f84d8364968"))
+        .append(utils::Hex::toString("ad40ff20961cc4591551b3ea85b244f27d329ffaea3a7170edcf0e814636e337"));
+    PublicKey pub = PublicKey::fromDER(pub_der);
+    EXPECT_TRUE(pub.verifyCompactSignatureWithHash("privmx", signature));
+    EXPECT_FALSE(pub.verifyCompactSignatureWithHash("privmx2", signature));
+    EXPECT_TRUE(pub.verifyManyCompactSignaturesWithHash({"privmx", "privmx"}, {signature, signature}));
+    // the same key parsed again (served from the public key cache) gives the same results
+    PublicKey pub2 = PublicKey::fromDER(pub_der);
+    EXPECT_EQ(pub2.toDER(), pub_der);
+    EXPECT_TRUE(pub2.verifyCompactSignatureWithHash("privmx", signature));
+}
+
+TEST(ECCTest, SignManyMatchesSign) {
+    PrivateKey priv = PrivateKey::generateRandom();
+    PublicKey pub = PublicKey::fromDER(priv.getPublicKey().toDER());
+    vector<string> messages {"publicMeta", "privateMeta", "data", string(1024, 'x')};
+    auto signatures = priv.signManyToCompactSignatureWithHash(messages);
+    ASSERT_EQ(signatures.size(), messages.size());
+    for (size_t i = 0; i < messages.size(); ++i) {
+        EXPECT_EQ(signatures[i].size(), 65u);
+        EXPECT_EQ(signatures[i][0], 27);
+        EXPECT_TRUE(pub.verifyCompactSignatureWithHash(messages[i], signatures[i]));
+    }
+    EXPECT_TRUE(pub.verifyManyCompactSignaturesWithHash(messages, signatures));
+    vector<string> single;
+    for (auto& message : messages) {
+        single.push_back(priv.signToCompactSignatureWithHash(message));
+    }
+    EXPECT_TRUE(pub.verifyManyCompactSignaturesWithHash(messages, single));
+}
+
+TEST(ECCTest, VerifyManyRejectsInvalid) {
+    PrivateKey priv = PrivateKey::generateRandom();
+    PublicKey pub = priv.getPublicKey();
+    vector<string> messages {"a", "b", "c"};
+    auto signatures = priv.signManyToCompactSignatureWithHash(messages);
+    auto swapped = signatures;
+    swap(swapped[0], swapped[1]);
+    EXPECT_FALSE(pub.verifyManyCompactSignaturesWithHash(messages, swapped));
+    auto tampered = signatures;
+    tampered[2][40] ^= 0x01;
+    EXPECT_FALSE(pub.verifyManyCompactSignaturesWithHash(messages, tampered));
+    EXPECT_FALSE(PrivateKey::generateRandom().getPublicKey().verifyManyCompactSignaturesWithHash(messages, signatures));
+    EXPECT_THROW(pub.verifyManyCompactSignaturesWithHash(messages, {signatures[0]}), SignaturesCountMismatchException);
+    auto truncated = signatures;
+    truncated[1].pop_back();
+    EXPECT_THROW(pub.verifyManyCompactSignaturesWithHash(messages, truncated), InvalidSignatureSizeException);
+    EXPECT_TRUE(pub.verifyManyCompactSignaturesWithHash({}, {}));
+}
+
+} // namespace
+} // namespace crypto
+} // namespace privmx
@@ -0,0 +1,50 @@
+#include <string>
+#include <gtest/gtest.h>
+
+#include <privmx/crypto/EciesEncryptor.hpp>
+#include <privmx/crypto/ecc/EciesKeyCache.hpp>
+#include <privmx/crypto/ecc/PrivateKey.hpp>
+
+using namespace std;
+
+namespace privmx {
+namespace crypto {
+namespace {
+
+TEST(EciesKeyCacheTest, EvictsLeastRecentlyUsed) {
+    EciesKeyCache cache(2);
+    cache.set("a", "key_a");
+    cache.set("b", "key_b");
+    EXPECT_EQ(cache.get("a").value(), "key_a");
+    cache.set("c", "key_c");
+    EXPECT_FALSE(cache.get("b").has_value());
+    EXPECT_EQ(cache.get("a").value(), "key_a");
+    EXPECT_EQ(cache.get("c").value(), "key_c");
+    cache.setMaxSize(0);
+    EXPECT_FALSE(cache.get("a").has_value());
+    cache.set("d", "key_d");
+    EXPECT_FALSE(cache.get("d").has_value());
+}
+
+TEST(EciesKeyCacheTest, EncryptDecryptWithCache) {
+    PrivateKey alice = PrivateKey::generateRandom();
+    PrivateKey bob = PrivateKey::generateRandom();
+    PrivateKey bobCopy = bob;
+    for (int i = 0; i < 3; ++i) {
+        string cipher = EciesEncryptor::encrypt(bob.getPublicKey(), "secret", alice);
+        EXPECT_EQ(EciesEncryptor::decrypt(bobCopy, cipher, alice.getPublicKey()), "secret");
+    }
+    EXPECT_TRUE(alice.getEciesKeyCache()->get(bob.getPublicKey().toDER()).has_value());
+    EXPECT_TRUE(bob.getEciesKeyCache()->get(alice.getPublicKey().toDER()).has_value());
+    EXPECT_EQ(
+        alice.getEciesKeyCache()->get(bob.getPublicKey().toDER()).value(),
+        bob.getEciesKeyCache()->get(alice.getPublicKey().toDER()).value()
+    );
+    string cipher = EciesEncryptor::encrypt(bob.getPublicKey(), "secret", alice);
+    EXPECT_THROW(EciesEncryptor::decrypt(alice, cipher), std::exception);
+    EXPECT_THROW(EciesEncryptor::decrypt(bob, cipher, bob.getPublicKey()), std::exception);
+}
+
+} // namespace
+} // namespace crypto
+} // namespace privmx
@@ -38,6 +38,7 @@ public:
     virtual std::string aes256CbcNoPadDecrypt(const std::string& data, const std::string& key, const std::string& iv) const override;
     virtual std::string aes256GcmEncrypt(const std::string& data, const std::string& key, const std::string& iv, const std::string& aad) const override;
     virtual std::string aes256GcmDecrypt(const std::string& data, const std::string& key, const std::string& iv, const std::string& aad) const override;
+    virtual std::string aes256GcmDecrypt(const char* data, size_t dataSize, const std::string& key, const char* iv, const char* aad, size_t aadSize) const override;
     virtual std::string prf_tls12(const std::string& key, const std::string& seed, size_t length) const override;
     virtual std::string kdf(size_t length, const std::string& key, const std::string& label) const override;
     virtual std::string generateIv(const std::string& key, Poco::Int32 idx) const override;
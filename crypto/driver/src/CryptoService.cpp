@@ -216,14 +216,17 @@ std::string driverimpl::CryptoService::aes256GcmEncrypt(const std::string& data,
 }
 
 std::string driverimpl::CryptoService::aes256GcmDecrypt(const std::string& data, const std::string& key, const std::string& iv, const std::string& aad) const {
-    if(data.size() < 16) {
+    return aes256GcmDecrypt(data.data(), data.size(), key, iv.data(), aad.data(), aad.size());
+}
+
+std::string driverimpl::CryptoService::aes256GcmDecrypt(const char* data, size_t dataSize, const std::string& key, const char* iv, const char* aad, size_t aadSize) const {
+    if(dataSize < 16) {
         throw PrivmxDriverCryptoException("aes256GcmDecrypt: no tag");
     }
-    std::string tag = data.substr(data.size()-16, 16); 
-    std::string dataWithoutTag = data.substr(0, data.size()-16);
+    // the tag is the last 16 bytes of the data, both are passed in place
     char* out;
     unsigned int outlen;
-    int status = privmxDrvCrypto_aeadDecrypt(key.data(), iv.data(), aad.data(), aad.size(), dataWithoutTag.data(), dataWithoutTag.size(), tag.data(), tag.size(), "AES-256-GCM", &out, &outlen);
+    int status = privmxDrvCrypto_aeadDecrypt(key.data(), iv, aad, aadSize, data, dataSize - 16, data + dataSize - 16, 16, "AES-256-GCM", &out, &outlen);
     if (status != 0) {
         throw PrivmxDriverCryptoException("aes256GcmDecrypt: " + to_string(status));
     }
@@ -15,6 +15,7 @@ limitations under the License.
 #include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 #include <openssl/ec.h>
 #include <Poco/SharedPtr.h>
 
@@ -50,6 +51,7 @@ public:
     Signature sign2(const std::string& data) const override;
     bool verify(const std::string& data, const std::string& signature) const override;
     bool verify2(const std::string& data, const Signature& signature) const override;
+    bool verifyMany(const std::vector<std::string>& data, const std::vector<std::string>& signatures) const override;
     std::string derive(const ECCImpl::Ptr ecc) const override;
     std::string getOrder() const override;
     BNImpl::Ptr getOrder2() const override;
@@ -67,6 +69,7 @@ private:
     using ec_group_unique_ptr = std::unique_ptr<EC_GROUP, std::function<decltype(EC_GROUP_free)>>;
 
     static ec_key_unique_ptr newEcKey();
+    static ecdsa_sig_unique_ptr newEcdsaSig();
     static ec_key_unique_ptr copyEcKey(const ec_key_unique_ptr& key);
     static bignum_unique_ptr newBignum();
     static bignum_unique_ptr copyBignum(const BIGNUM* raw_bn);
@@ -80,6 +83,11 @@ private:
     static bignum_unique_ptr bin2bignum(const std::string& bin);
     static ec_point_unique_ptr oct2point(const ec_key_unique_ptr& key, const std::string& oct);
     static ec_group_unique_ptr getEcGroup();
+    static const EC_GROUP* getPrecomputedEcGroup();
+    static BN_CTX* getThreadBnCtx();
+    static void checkSignature(const std::string& signature);
+    static void setSignature(ECDSA_SIG* raw_sig, const std::string& signature);
+    static bool verifySignature(const std::string& data, const ECDSA_SIG* raw_sig, EC_KEY* raw_key);
     EC_KEY* checkIfInitializedKeyAndGet() const;
 
     ec_key_unique_ptr _key;
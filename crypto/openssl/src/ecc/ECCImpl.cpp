@@ -14,6 +14,10 @@ limitations under the License.
 #include <openssl/ecdh.h>
 #include <openssl/ecdsa.h>
 #include <openssl/evp.h>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
 
 #include <privmx/crypto/ecc/ECC.hpp>
 #include <privmx/crypto/CryptoException.hpp>
@@ -25,6 +29,50 @@ using namespace privmx;
 using namespace privmx::crypto::opensslimpl;
 using namespace std;
 
+namespace {
+
+// Parsed and validated public keys, so keys seen again (e.g. authors of listed items)
+// skip point decompression and the EC_KEY_check_key scalar multiplication
+class PublicKeyCache
+{
+public:
+    privmx::crypto::ECCImpl::Ptr get(const string& public_key) {
+        lock_guard<mutex> lock(_mutex);
+        auto it = _entries.find(public_key);
+        if (it == _entries.end()) {
+            return privmx::crypto::ECCImpl::Ptr();
+        }
+        _lru.splice(_lru.begin(), _lru, it->second.second);
+        return it->second.first;
+    }
+
+    void set(const string& public_key, const privmx::crypto::ECCImpl::Ptr& ecc) {
+        lock_guard<mutex> lock(_mutex);
+        if (_entries.find(public_key) != _entries.end()) {
+            return;
+        }
+        _lru.push_front(public_key);
+        _entries.emplace(public_key, make_pair(ecc, _lru.begin()));
+        if (_entries.size() > MAX_SIZE) {
+            _entries.erase(_lru.back());
+            _lru.pop_back();
+        }
+    }
+
+private:
+    static constexpr size_t MAX_SIZE = 1024;
+    mutex _mutex;
+    list<string> _lru;
+    unordered_map<string, pair<privmx::crypto::ECCImpl::Ptr, list<string>::iterator>> _entries;
+};
+
+PublicKeyCache& getPublicKeyCache() {
+    static PublicKeyCache cache;
+    return cache;
+}
+
+} // namespace
+
 #ifdef PRIVMX_DEFAULT_CRYPTO_OPENSSL
 privmx::crypto::ECCImpl::Ptr privmx::crypto::ECCImpl::genPair() {
     return privmx::crypto::opensslimpl::ECCImpl::genPair();
@@ -49,11 +97,18 @@ ECCImpl::Ptr ECCImpl::genPair() {
 }
 
 ECCImpl::Ptr ECCImpl::fromPublicKey(const string& public_key) {
+    // public-only instances are never modified, so one instance can be shared by all users of the key
+    ECCImpl::Ptr cached = getPublicKeyCache().get(public_key);
+    if (!cached.isNull()) {
+        return cached;
+    }
     ec_key_unique_ptr key = newEcKey();
     ec_point_unique_ptr public_point = oct2point(key, public_key);
     setPublicKey(key, public_point);
     checkKey(key);
-    return new ECCImpl(move(key), false);
+    ECCImpl::Ptr result = new ECCImpl(move(key), false);
+    getPublicKeyCache().set(public_key, result);
+    return result;
 }
 
 ECCImpl::Ptr ECCImpl::fromPrivateKey(const std::string& private_key) {
@@ -167,42 +222,10 @@ ECCImpl::Signature ECCImpl::sign2(const string& data) const {
 
 bool ECCImpl::verify(const std::string& data, const std::string& signature) const {
     EC_KEY* raw_key = checkIfInitializedKeyAndGet();
-    if (signature.size() != 65) {
-        throw InvalidSignatureSizeException();
-    }
-    if (signature.front() < 27 || signature.front() > 42) {
-        throw InvalidSignatureHeaderException();
-    }
-    const unsigned char* dgst = reinterpret_cast<const unsigned char*>(data.data());
-    int dgst_len = data.size();
-    const unsigned char* sign = reinterpret_cast<const unsigned char*>(signature.data());
-    ecdsa_sig_unique_ptr sig(ECDSA_SIG_new(), ECDSA_SIG_free);
-    ECDSA_SIG* raw_sig = sig.get();
-    if (raw_sig == NULL) {
-        OpenSSLUtils::handleErrors();
-    }
-    bignum_unique_ptr r = newBignum();
-    bignum_unique_ptr s = newBignum();
-    BIGNUM* raw_r = r.get();
-    BIGNUM* raw_s = s.get();
-    if (BN_bin2bn(&sign[1], 32, raw_r) == NULL) {
-        OpenSSLUtils::handleErrors();
-    }
-    if (BN_bin2bn(&sign[33], 32, raw_s) == NULL) {
-        OpenSSLUtils::handleErrors();
-    }
-    if (ECDSA_SIG_set0(raw_sig, raw_r, raw_s) == 0) {
-        OpenSSLUtils::handleErrors();
-    }
-    // Release r and s, cause calling ECDSA_SIG_set0() transfers
-    // the memory management of the values to the ECDSA_SIG object
-    r.release();
-    s.release();
-    int result = ECDSA_do_verify(dgst, dgst_len, raw_sig, raw_key);
-    if (result == -1) {
-        OpenSSLUtils::handleErrors();
-    }
-    return (result == 1);
+    checkSignature(signature);
+    ecdsa_sig_unique_ptr sig = newEcdsaSig();
+    setSignature(sig.get(), signature);
+    return verifySignature(data, sig.get(), raw_key);
 }
 
 bool ECCImpl::verify2(const std::string& data, const ECCImpl::Signature& signature) const {
@@ -210,13 +233,8 @@ bool ECCImpl::verify2(const std::string& data, const ECCImpl::Signature& signatu
     if (signature.r->getBitsLength() > 256 || signature.s->getBitsLength() > 256) {
         throw InvalidSignatureSizeException();
     }
-    const unsigned char* dgst = reinterpret_cast<const unsigned char*>(data.data());
-    int dgst_len = data.size();
-    ecdsa_sig_unique_ptr sig(ECDSA_SIG_new(), ECDSA_SIG_free);
+    ecdsa_sig_unique_ptr sig = newEcdsaSig();
     ECDSA_SIG* raw_sig = sig.get();
-    if (raw_sig == NULL) {
-        OpenSSLUtils::handleErrors();
-    }
     bignum_unique_ptr r = copyBignum(signature.r.cast<BNImpl>()->getRaw());
     bignum_unique_ptr s = copyBignum(signature.s.cast<BNImpl>()->getRaw());
     BIGNUM* raw_r = r.get();
@@ -228,11 +246,25 @@ bool ECCImpl::verify2(const std::string& data, const ECCImpl::Signature& signatu
     // the memory management of the values to the ECDSA_SIG object
     r.release();
     s.release();
-    int result = ECDSA_do_verify(dgst, dgst_len, raw_sig, raw_key);
-    if (result == -1) {
-        OpenSSLUtils::handleErrors();
+    return verifySignature(data, raw_sig, raw_key);
+}
+
+bool ECCImpl::verifyMany(const std::vector<std::string>& data, const std::vector<std::string>& signatures) const {
+    EC_KEY* raw_key = checkIfInitializedKeyAndGet();
+    if (data.size() != signatures.size()) {
+        throw SignaturesCountMismatchException();
     }
-    return (result == 1);
+    for (auto& signature : signatures) {
+        checkSignature(signature);
+    }
+    ecdsa_sig_unique_ptr sig = newEcdsaSig();
+    for (size_t i = 0; i < data.size(); ++i) {
+        setSignature(sig.get(), signatures[i]);
+        if (!verifySignature(data[i], sig.get(), raw_key)) {
+            return false;
+        }
+    }
+    return true;
 }
 
 string ECCImpl::derive(const ECCImpl::Ptr ecc) const {
@@ -289,13 +321,25 @@ PointImpl::Ptr ECCImpl::getEcGenerator() const {
 }
 
 ECCImpl::ec_key_unique_ptr ECCImpl::newEcKey() {
-    ec_key_unique_ptr key(EC_KEY_new_by_curve_name(NID_secp256k1), EC_KEY_free);
+    ec_key_unique_ptr key(EC_KEY_new(), EC_KEY_free);
     if (key.get() == NULL) {
         OpenSSLUtils::handleErrors();
     }
+    // the key gets a copy of the group, which shares the precomputed generator table
+    if (EC_KEY_set_group(key.get(), getPrecomputedEcGroup()) == 0) {
+        OpenSSLUtils::handleErrors();
+    }
     return key;
 }
 
+ECCImpl::ecdsa_sig_unique_ptr ECCImpl::newEcdsaSig() {
+    ecdsa_sig_unique_ptr sig(ECDSA_SIG_new(), ECDSA_SIG_free);
+    if (sig.get() == NULL) {
+        OpenSSLUtils::handleErrors();
+    }
+    return sig;
+}
+
 ECCImpl::ec_key_unique_ptr ECCImpl::copyEcKey(const ec_key_unique_ptr& key) {
     if (!key) {
         return nullptr;
@@ -384,8 +428,7 @@ ECCImpl::ec_point_unique_ptr ECCImpl::mul(ec_key_unique_ptr& key) {
     const EC_KEY* raw_key = key.get();
     const EC_GROUP* group = EC_KEY_get0_group(raw_key);
     const BIGNUM* raw_private_key = EC_KEY_get0_private_key(raw_key);
-    bn_ctx_unique_ptr ctx = newBnCtx();
-    BN_CTX* raw_ctx = ctx.get();
+    BN_CTX* raw_ctx = getThreadBnCtx();
     ec_point_unique_ptr public_point = newEcPoint(group);
     EC_POINT* raw_public_point = public_point.get();
     if (EC_POINT_mul(group, raw_public_point, raw_private_key, NULL, NULL, raw_ctx) == 0) {
@@ -410,8 +453,7 @@ ECCImpl::ec_point_unique_ptr ECCImpl::oct2point(const ec_key_unique_ptr& key, co
     const EC_GROUP* group = EC_KEY_get0_group(raw_key);
     const unsigned char* buf = reinterpret_cast<const unsigned char*>(oct.data());
     size_t len = oct.size();
-    bn_ctx_unique_ptr ctx = newBnCtx();
-    BN_CTX* raw_ctx = ctx.get();
+    BN_CTX* raw_ctx = getThreadBnCtx();
     ec_point_unique_ptr public_point = newEcPoint(group);
     EC_POINT* raw_public_point = public_point.get();
     if (EC_POINT_oct2point(group, raw_public_point, buf, len, raw_ctx) == 0) {
@@ -425,6 +467,68 @@ ECCImpl::ec_group_unique_ptr ECCImpl::getEcGroup() {
     return group;
 }
 
+const EC_GROUP* ECCImpl::getPrecomputedEcGroup() {
+    // multiples of the generator are computed once and reused by every key operation
+    // that multiplies the generator (key generation, signing, verification)
+    static ec_group_unique_ptr group = []() {
+        ec_group_unique_ptr result = getEcGroup();
+        if (result.get() == NULL) {
+            OpenSSLUtils::handleErrors();
+        }
+        if (EC_GROUP_precompute_mult(result.get(), getThreadBnCtx()) == 0) {
+            OpenSSLUtils::handleErrors();
+        }
+        return result;
+    }();
+    return group.get();
+}
+
+BN_CTX* ECCImpl::getThreadBnCtx() {
+    thread_local bn_ctx_unique_ptr ctx = newBnCtx();
+    return ctx.get();
+}
+
+void ECCImpl::checkSignature(const std::string& signature) {
+    if (signature.size() != 65) {
+        throw InvalidSignatureSizeException();
+    }
+    if (signature.front() < 27 || signature.front() > 42) {
+        throw InvalidSignatureHeaderException();
+    }
+}
+
+void ECCImpl::setSignature(ECDSA_SIG* raw_sig, const std::string& signature) {
+    const unsigned char* sign = reinterpret_cast<const unsigned char*>(signature.data());
+    bignum_unique_ptr r = newBignum();
+    bignum_unique_ptr s = newBignum();
+    BIGNUM* raw_r = r.get();
+    BIGNUM* raw_s = s.get();
+    if (BN_bin2bn(&sign[1], 32, raw_r) == NULL) {
+        OpenSSLUtils::handleErrors();
+    }
+    if (BN_bin2bn(&sign[33], 32, raw_s) == NULL) {
+        OpenSSLUtils::handleErrors();
+    }
+    // ECDSA_SIG_set0() frees the previous values, so one ECDSA_SIG can be reused for many signatures
+    if (ECDSA_SIG_set0(raw_sig, raw_r, raw_s) == 0) {
+        OpenSSLUtils::handleErrors();
+    }
+    // Release r and s, cause calling ECDSA_SIG_set0() transfers
+    // the memory management of the values to the ECDSA_SIG object
+    r.release();
+    s.release();
+}
+
+bool ECCImpl::verifySignature(const std::string& data, const ECDSA_SIG* raw_sig, EC_KEY* raw_key) {
+    const unsigned char* dgst = reinterpret_cast<const unsigned char*>(data.data());
+    int dgst_len = data.size();
+    int result = ECDSA_do_verify(dgst, dgst_len, raw_sig, raw_key);
+    if (result == -1) {
+        OpenSSLUtils::handleErrors();
+    }
+    return (result == 1);
+}
+
 EC_KEY* ECCImpl::checkIfInitializedKeyAndGet() const {
     if (!_key) {
         throw ECCIsNotInitializedException();
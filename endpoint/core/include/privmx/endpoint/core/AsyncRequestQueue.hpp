@@ -0,0 +1,110 @@
+/*
+PrivMX Endpoint.
+Copyright © 2024 Simplito sp. z o.o.
+
+This file is part of the PrivMX Platform (https://privmx.dev).
+This software is Licensed under the PrivMX Free License.
+
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef _PRIVMXLIB_ENDPOINT_CORE_ASYNCREQUESTQUEUE_HPP_
+#define _PRIVMXLIB_ENDPOINT_CORE_ASYNCREQUESTQUEUE_HPP_
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+
+#include "privmx/endpoint/core/Future.hpp"
+
+namespace privmx {
+namespace endpoint {
+namespace core {
+
+// Runs the asynchronous calls of a Connection. At most maxInFlightRequests calls are processed at the same
+// time by the workers of the queue, each one blocking on its own RPC, so that many requests are in flight on
+// the transport at once. A call which is cancelled or whose deadline passes fails right away, if it is still
+// waiting in the queue it is never started. A running call cannot be interrupted, it keeps blocking its worker
+// until its RPC returns. When its deadline passes, its slot is given to the next call, but only for up to
+// maxInFlightRequests such abandoned calls at a time, the next timed out calls keep their slots. So at most
+// 2 * maxInFlightRequests workers exist and a stuck transport cannot make the queue start new threads forever.
+class AsyncRequestQueue {
+public:
+    static constexpr int64_t DEFAULT_MAX_IN_FLIGHT_REQUESTS = 8;
+
+    AsyncRequestQueue(const AsyncOptions& options = {.maxInFlightRequests = DEFAULT_MAX_IN_FLIGHT_REQUESTS, .completionExecutor = {}});
+    // fails the waiting calls, the running ones finish on the detached workers
+    ~AsyncRequestQueue();
+    void setOptions(const AsyncOptions& options);
+    template<typename T>
+    Future<T> submit(const std::function<T()>& task, const AsyncCallOptions& callOptions = {});
+    void cancelAll();
+
+private:
+    using Clock = std::chrono::steady_clock;
+    struct Task {
+        std::shared_ptr<AsyncRequest> request;
+        std::function<void()> run;
+    };
+    struct State {
+        std::mutex mutex;
+        std::condition_variable workersCv;
+        std::condition_variable timerCv;
+        std::deque<Task> tasks;
+        std::multimap<Clock::time_point, std::weak_ptr<AsyncRequest>> deadlines;
+        AsyncOptions options;
+        size_t workers = 0;
+        size_t idleWorkers = 0;
+        size_t runningTasks = 0;
+        // running tasks, true once the task has timed out and its slot has been given to the next call
+        std::map<AsyncRequest*, bool> running;
+        size_t abandonedTasks = 0;
+        bool timerStarted = false;
+        bool stopping = false;
+    };
+
+    void push(const std::shared_ptr<AsyncRequest>& request, const std::function<void()>& run, const std::optional<int64_t>& timeout);
+    AsyncRequest::CompletionExecutor getCompletionExecutor();
+    static void startWorker(const std::shared_ptr<State>& state);
+    static void workerLoop(const std::shared_ptr<State>& state);
+    static void timerLoop(const std::shared_ptr<State>& state);
+
+    std::shared_ptr<State> _state;
+};
+
+template<typename T>
+Future<T> AsyncRequestQueue::submit(const std::function<T()>& task, const AsyncCallOptions& callOptions) {
+    auto promise = std::make_shared<std::promise<T>>();
+    auto request = std::make_shared<AsyncRequest>(getCompletionExecutor(), [promise](std::exception_ptr error) {
+        promise->set_exception(error);
+    });
+    Future<T> future(promise->get_future().share(), request);
+    push(request, [promise, request, task]() {
+        try {
+            if constexpr (std::is_void_v<T>) {
+                task();
+                request->complete([&]() { promise->set_value(); });
+            } else {
+                auto result = task();
+                request->complete([&]() { promise->set_value(std::move(result)); });
+            }
+        } catch (...) {
+            request->fail(std::current_exception());
+        }
+    }, callOptions.timeout);
+    return future;
+}
+
+}  // namespace core
+}  // namespace endpoint
+}  // namespace privmx
+
+#endif  // _PRIVMXLIB_ENDPOINT_CORE_ASYNCREQUESTQUEUE_HPP_
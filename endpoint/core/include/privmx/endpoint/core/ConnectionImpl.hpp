@@ -12,11 +12,13 @@ limitations under the License.
 #ifndef _PRIVMXLIB_ENDPOINT_CORE_CONNECTIONIMPL_HPP_
 #define _PRIVMXLIB_ENDPOINT_CORE_CONNECTIONIMPL_HPP_
 
+#include <chrono>
 #include <exception>
 #include <functional>
 #include <memory>
 #include <optional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <mutex>
 #include <shared_mutex>
@@ -25,7 +27,11 @@ limitations under the License.
 #include <privmx/crypto/ecc/PrivateKey.hpp>
 #include <privmx/privfs/gateway/RpcGateway.hpp>
 #include <privmx/utils/NotificationQueue.hpp>
+#include "privmx/endpoint/core/AsyncRequestQueue.hpp"
+#include "privmx/endpoint/core/encryptors/DataCompressor.hpp"
 #include "privmx/endpoint/core/Connection.hpp"
+#include "privmx/endpoint/core/ContainerKeyCache.hpp"
+#include "privmx/endpoint/core/ContainerMembersUpdater.hpp"
 #include "privmx/endpoint/core/EventMiddleware.hpp"
 #include "privmx/endpoint/core/HandleManager.hpp"
 #include "privmx/endpoint/core/KeyProvider.hpp"
@@ -63,6 +69,13 @@ public:
     int64_t getConnectionId();
     core::PagingList<Context> listContexts(const PagingQuery& pagingQuery);
     PagingList<UserInfo> listContextUsers(const std::string& contextId, const PagingQuery& pagingQuery);
+    std::vector<UserWithPubKey> getContextUsersPubKeys(const std::string& contextId, const std::vector<std::string>& userIds);
+    std::vector<ContainerMembersUpdateResult> updateContainersMembers(
+        const std::vector<ContainerMembersTarget>& targets,
+        const std::vector<UserWithPubKey>& usersToAdd,
+        const std::vector<UserWithPubKey>& managersToAdd,
+        const std::vector<std::string>& userIdsToRemove
+    );
     std::vector<std::string> subscribeFor(const std::vector<std::string>& subscriptionQueries);
     void unsubscribeFrom(const std::vector<std::string>& subscriptionIds);
     std::string buildSubscriptionQuery(EventType eventType, EventSelectorType selectorType, const std::string& selectorId);
@@ -73,6 +86,10 @@ public:
     const std::shared_ptr<KeyProvider>& getKeyProvider() const { return _keyProvider; }
     const std::shared_ptr<EventMiddleware>& getEventMiddleware() const { return _eventMiddleware; }
     const std::shared_ptr<HandleManager>& getHandleManager() const { return _handleManager; }
+    const std::shared_ptr<ContainerMembersUpdater>& getContainerMembersUpdater() const { return _containerMembersUpdater; }
+    const std::shared_ptr<ContainerKeyCacheStats>& getContainerKeyCacheStats() const { return _containerKeyCacheStats; }
+    const std::shared_ptr<AsyncRequestQueue>& getAsyncRequestQueue() const { return _asyncRequestQueue; }
+    const std::shared_ptr<DataCompressor>& getDataCompressor() const { return _dataCompressor; }
 
     const rpc::ServerConfig& getServerConfig() const { return _serverConfig; }
 
@@ -81,6 +98,16 @@ public:
         std::shared_lock lock(_mutex);
         return _userVerifier;    
     }
+    void setUserVerifierCacheOptions(const UserVerifierCacheOptions& options);
+    void invalidateUserVerifierCache(const std::optional<std::string>& contextId, const std::optional<std::string>& userId);
+    UserVerifierMetrics getUserVerifierMetrics();
+    KeyCacheMetrics getKeyCacheMetrics();
+    static PerformanceMetrics getPerformanceMetrics();
+    static void resetPerformanceMetrics();
+    static void setPerformanceMetricsEnabled(bool enabled);
+    void setAsyncOptions(const AsyncOptions& options);
+    void setDataCompressionOptions(const DataCompressionOptions& options);
+    void setKeyChainEnabled(bool enabled);
     std::string getMyUserId(const std::string& contextId);
     DataIntegrityObject createDIO(
         const std::string& contextId, 
@@ -97,6 +124,16 @@ public:
     );
     inline bool isConnected() {return _gateway->isConnected();};
 private:
+    static constexpr int64_t CONTEXT_USERS_PAGE_SIZE = 100;
+    static constexpr int64_t CONTEXT_USERS_CACHE_TTL = 60 * 1000; // 1 minute
+
+    // public keys of the Context users read so far, the next lookup pages on from the users already read
+    struct ContextUsersPubKeys {
+        std::unordered_map<std::string, std::string> pubKeys;
+        int64_t scanned;
+        std::chrono::steady_clock::time_point expires;
+    };
+
     void assertServerVersion();
     std::string generateDIORandomId();
     DataIntegrityObject createDIOExt(
@@ -111,6 +148,10 @@ private:
     NotificationEvent convertRpcNotificationEventToCoreNotificationEvent(const rpc::NotificationEvent& event);
     NotificationEvent convertJanusEventToCoreNotificationEvent(const rpc::NotificationEvent& event);
     void processNotificationEvent(const std::string& type, const core::NotificationEvent& notification);
+    // withReadUsers adds the other users read from the server on the way to the result
+    std::vector<UserWithPubKey> getContextUsersPubKeys(const std::string& contextId, const std::vector<std::string>& userIds, bool withReadUsers);
+    std::vector<bool> verifyContextUsersPubKeys(const std::string& contextId, const std::vector<UserWithPubKey>& users);
+    void invalidateContextUsersPubKeys(const std::string& contextId);
     
     const int64_t _connectionId;
     privfs::RpcGateway::Ptr _gateway;
@@ -121,9 +162,16 @@ private:
     std::shared_ptr<KeyProvider> _keyProvider;
     std::shared_ptr<EventMiddleware> _eventMiddleware;
     std::shared_ptr<HandleManager> _handleManager;
+    std::shared_ptr<ContainerMembersUpdater> _containerMembersUpdater;
+    std::shared_ptr<ContainerKeyCacheStats> _containerKeyCacheStats;
+    std::shared_ptr<AsyncRequestQueue> _asyncRequestQueue;
+    std::shared_ptr<DataCompressor> _dataCompressor;
     std::shared_ptr<UserVerifier> _userVerifier;
+    UserVerifierCacheOptions _userVerifierCacheOptions;
     std::shared_ptr<ContextProvider> _contextProvider;
     std::shared_mutex _mutex;
+    std::mutex _contextUsersMutex;
+    std::unordered_map<std::string, ContextUsersPubKeys> _contextUsersPubKeys;
     std::shared_ptr<SubscriberImpl> _subscriber;
     std::optional<ServerApi> _serverApi;
     std::shared_ptr<privmx::utils::GuardedExecutor> _guardedExecutor;
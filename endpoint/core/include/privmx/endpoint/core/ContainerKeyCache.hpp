@@ -12,7 +12,9 @@ limitations under the License.
 #ifndef _PRIVMXLIB_ENDPOINT_CORE_CONTAINERKEYCACHE_HPP_
 #define _PRIVMXLIB_ENDPOINT_CORE_CONTAINERKEYCACHE_HPP_
 
+#include <atomic>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <shared_mutex>
 #include <optional>
@@ -27,9 +29,18 @@ namespace privmx {
 namespace endpoint {
 namespace core {
 
+// counters shared by the key caches of all the modules of a connection
+struct ContainerKeyCacheStats {
+    std::atomic_int64_t hits = 0;
+    std::atomic_int64_t misses = 0;
+    std::atomic_int64_t writeThroughUpdates = 0;
+    std::atomic_int64_t revalidatedEntries = 0;
+    std::atomic_int64_t invalidatedEntries = 0;
+};
+
 class ContainerKeyCache {
 public:
-    ContainerKeyCache();
+    ContainerKeyCache(const std::shared_ptr<ContainerKeyCacheStats>& stats = std::make_shared<ContainerKeyCacheStats>());
     struct CachedModuleKeys {
         std::vector<server::KeyEntry> keys;
         std::string currentKeyId;
@@ -37,6 +48,9 @@ public:
         std::string moduleResourceId;
         std::string contextId;
         int64_t moduleVersion;
+        Poco::Dynamic::Var currentData;
+        // IDs of keys the user has no entries for in this module version, resolved through the key chain
+        std::set<std::string> keyIdsMissingOnServer;
     };
     std::optional<CachedModuleKeys> getKeys(
         const std::string& moduleId, 
@@ -45,12 +59,21 @@ public:
     );
 
     void set(const std::string& moduleId, const CachedModuleKeys& newKeys, bool force = false);
+    // installs the keys of a module updated by the user, instead of fetching them from the server again
+    void writeThrough(const std::string& moduleId, const CachedModuleKeys& newKeys);
+    void setKeysMissingOnServer(const std::string& moduleId, int64_t moduleVersion, const std::set<std::string>& keyIds);
     void clear(const std::optional<std::string>& moduleId = std::nullopt);
+    // notifications may have been missed, so the current key of every cached module is checked with the server
+    // on its next use, keys requested by ID are still served from the cache as they never change
+    void markForRevalidation();
 protected:
     
     std::optional<CachedModuleKeys> getCachedModuleKeys(const std::string& moduleId);
+    bool setUnlocked(const std::string& moduleId, const CachedModuleKeys& newKeys, bool force);
     std::map<std::string, CachedModuleKeys> _storage;
+    std::set<std::string> _toRevalidate;
     std::shared_mutex _mutex;
+    std::shared_ptr<ContainerKeyCacheStats> _stats;
 
 };
 
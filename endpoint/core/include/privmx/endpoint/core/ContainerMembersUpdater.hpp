@@ -0,0 +1,92 @@
+/*
+PrivMX Endpoint.
+Copyright © 2024 Simplito sp. z o.o.
+
+This file is part of the PrivMX Platform (https://privmx.dev).
+This software is Licensed under the PrivMX Free License.
+
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef _PRIVMXLIB_ENDPOINT_CORE_CONTAINERMEMBERSUPDATER_HPP_
+#define _PRIVMXLIB_ENDPOINT_CORE_CONTAINERMEMBERSUPDATER_HPP_
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <privmx/utils/ThreadSaveMap.hpp>
+
+#include "privmx/endpoint/core/Types.hpp"
+
+namespace privmx {
+namespace endpoint {
+namespace core {
+
+struct ContainerMembersDelta {
+    std::vector<UserWithPubKey> usersToAdd;
+    std::vector<UserWithPubKey> managersToAdd;
+    std::vector<std::string> userIdsToRemove;
+    // looks up public keys of the Context users which stay members, needed when the container gets a new key;
+    // users no longer in the Context are left out, keys failing user verification throw UserVerificationFailureException
+    std::function<std::vector<UserWithPubKey>(const std::string& contextId, const std::vector<std::string>& userIds)> getContextUsersPubKeys;
+};
+
+// Applies the same change of members to many containers of the modules which registered a handler.
+// Containers are updated by a bounded number of workers, each one fetching, re-encrypting and sending
+// a single container at a time. A handler throws ContainerVersionConflictException when the container was
+// modified after it has been fetched, such a container is updated again from its new version.
+class ContainerMembersUpdater {
+public:
+    using Handler = std::function<void(const std::string& containerId, const ContainerMembersDelta& delta)>;
+    // returns the public keys of the given users, it may also return other users of the Context it has read
+    using ContextUsersPubKeysGetter = std::function<std::vector<UserWithPubKey>(const std::string& contextId, const std::vector<std::string>& userIds)>;
+    // checks the public keys read from the server with the user verifier before the container key is shared with them
+    using ContextUsersPubKeysVerifier = std::function<std::vector<bool>(const std::string& contextId, const std::vector<UserWithPubKey>& users)>;
+
+    static constexpr size_t MAX_CONCURRENT_UPDATES = 8;
+    static constexpr int64_t MAX_ATTEMPTS = 3;
+
+    ContainerMembersUpdater(const ContextUsersPubKeysGetter& getContextUsersPubKeys, const ContextUsersPubKeysVerifier& verifyContextUsersPubKeys);
+    int addHandler(const std::string& module, const Handler& handler);
+    void removeHandler(int id) noexcept;
+    // delta of a single container update, looking up public keys without caching them
+    ContainerMembersDelta createDelta(
+        const std::vector<UserWithPubKey>& usersToAdd,
+        const std::vector<UserWithPubKey>& managersToAdd,
+        const std::vector<std::string>& userIdsToRemove
+    );
+    std::vector<ContainerMembersUpdateResult> update(
+        const std::vector<ContainerMembersTarget>& targets,
+        const std::vector<UserWithPubKey>& usersToAdd,
+        const std::vector<UserWithPubKey>& managersToAdd,
+        const std::vector<std::string>& userIdsToRemove,
+        size_t maxConcurrentUpdates = MAX_CONCURRENT_UPDATES
+    );
+
+private:
+    // public keys of one Context read during an update, shared by the containers of the Context
+    struct ContextPubKeys {
+        std::mutex mutex;
+        std::unordered_map<std::string, std::string> pubKeys;
+        std::unordered_set<std::string> absent;
+        std::unordered_set<std::string> verified;
+    };
+
+    std::vector<UserWithPubKey> getVerifiedPubKeys(const std::string& contextId, const std::vector<std::string>& userIds, ContextPubKeys& context);
+
+    ContextUsersPubKeysGetter _getContextUsersPubKeys;
+    ContextUsersPubKeysVerifier _verifyContextUsersPubKeys;
+    utils::ThreadSaveMap<int, std::pair<std::string, Handler>> _handlers;
+    std::atomic_int _id = 0;
+};
+
+}  // namespace core
+}  // namespace endpoint
+}  // namespace privmx
+
+#endif  // _PRIVMXLIB_ENDPOINT_CORE_CONTAINERMEMBERSUPDATER_HPP_
@@ -94,6 +94,8 @@ struct ModuleKeys {
         int64_t moduleSchemaVersion;
         std::string moduleResourceId;
         std::string contextId;
+        // encrypted current data of the module, holding the key chain in its internal meta
+        Poco::Dynamic::Var currentData;
     };
 
 }  // namespace core
@@ -31,7 +31,7 @@ public:
                                                                 const std::vector<UserWithPubKey>& list2);
 
     /**
-     * Returns vector of elements which do exist on the baseList and not on the subList
+     * Returns vector of elements which do exist on the baseList and not on the subList, in the baseList order
      */
     static std::vector<std::string> getDifference(const std::vector<std::string>& baseList,
                                                   const std::vector<std::string>& subList);
@@ -48,7 +48,7 @@ public:
         return ret;
     }
 
-    static std::vector<std::string> usersWithPubKeyToIds(std::vector<core::UserWithPubKey>& users);
+    static std::vector<std::string> usersWithPubKeyToIds(const std::vector<core::UserWithPubKey>& users);
 
     static std::string generateId();
 
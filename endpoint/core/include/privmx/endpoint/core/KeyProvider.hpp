@@ -12,10 +12,14 @@ limitations under the License.
 #ifndef _PRIVMXLIB_ENDPOINT_CORE_KEYPROVIDER_HPP_
 #define _PRIVMXLIB_ENDPOINT_CORE_KEYPROVIDER_HPP_
 
+#include <atomic>
 #include <memory>
 #include <functional>
 #include <vector>
 #include <map>
+#include <mutex>
+#include <set>
+#include <unordered_map>
 #include <privmx/crypto/ecc/PrivateKey.hpp>
 
 #include "privmx/endpoint/core/CoreTypes.hpp"
@@ -23,6 +27,7 @@ limitations under the License.
 #include "privmx/endpoint/core/Types.hpp"
 #include "privmx/endpoint/core/encryptors/EncKey/EncKeyEncryptorV1.hpp"
 #include "privmx/endpoint/core/encryptors/EncKey/EncKeyEncryptorV2.hpp"
+#include "privmx/endpoint/core/encryptors/module/ModuleDataEncryptorV5.hpp"
 #include "privmx/endpoint/core/UserVerifier.hpp"
 
 namespace privmx {
@@ -35,8 +40,11 @@ public:
     void addOne(const std::vector<server::KeyEntry>& keys, const std::string& keyId, const EncKeyLocation& location);
     void addMany(const std::vector<server::KeyEntry>& keys, std::set<std::string> keyIds, const EncKeyLocation& location);
     void addAll(const std::vector<server::KeyEntry>& keys, const EncKeyLocation& location);
+    // requested keys the user has no entries for are then resolved through the module's key chain
+    void addKeyChain(const ModuleKeys& moduleKeys, const EncKeyLocation& location);
     void markAsCompleted();
     std::unordered_map<EncKeyLocation, std::unordered_map<std::string, server::KeyEntry>> requestData;
+    std::unordered_map<EncKeyLocation, ModuleKeys> keyChainSources;
 private:
 
     bool _completed = false;
@@ -45,6 +53,11 @@ private:
 
 class KeyProvider {
 public:
+    static constexpr size_t MAX_CACHED_PUBLIC_KEYS = 10000;
+    static constexpr size_t MAX_CACHED_DECRYPTED_KEYS = 10000;
+    // key entries are encrypted in parallel when there are at least that many of them
+    static constexpr size_t PARALLEL_KEY_ENTRIES_THRESHOLD = 16;
+
     KeyProvider(const privmx::crypto::PrivateKey& key, std::function<std::shared_ptr<UserVerifier>()> getUserVerifier);
     EncKey generateKey();
     std::string generateSecret();
@@ -64,9 +77,26 @@ public:
         const std::string& containerSecret
     );
     bool verifyKeysSecret(const std::unordered_map<std::string, DecryptedEncKeyV2>& decryptedKeys, const EncKeyLocation& location, const std::string& containerSecret);
-    
+    // containers get a key chain only when enabled or when they already have one, as library versions
+    // without key chain support cannot read the module data carrying it
+    void setKeyChainEnabled(bool enabled) { _keyChainEnabled = enabled; }
+    std::vector<ModuleKeyChainLink> prepareKeyChain(
+        const std::vector<ModuleKeyChainLink>& currentKeyChain,
+        const std::unordered_map<std::string, DecryptedEncKeyV2>& keys,
+        const EncKey& currentKey,
+        const EncKey& newKey
+    );
+    std::unordered_map<std::string, DecryptedEncKeyV2> getKeysOutsideKeyChain(
+        const std::unordered_map<std::string, DecryptedEncKeyV2>& keys,
+        const std::vector<ModuleKeyChainLink>& keyChain,
+        const std::string& newestKeyId
+    );
+    int64_t getDecryptedKeysCount() const { return _decryptedKeysCount; }
+    int64_t getReusedDecryptedKeysCount() const { return _reusedDecryptedKeysCount; }
+
 private:
     std::unordered_map<std::string, DecryptedEncKeyV2> decryptAndVerifyKeys(std::unordered_map<std::string, server::KeyEntry> keys, const EncKeyLocation& location);
+    DecryptedEncKeyV2 decryptKeyEntry(const server::KeyEntry& keyEntry);
     server::KeyEntrySet createKeyEntrySet(
         const UserWithPubKey& user,
         const EncKey& key, 
@@ -77,10 +107,38 @@ private:
     void verifyForDuplication(std::unordered_map<std::string, DecryptedEncKeyV2>& keys);
     void verifyData(std::unordered_map<std::string, DecryptedEncKeyV2>& decryptedKeys, const EncKeyLocation& location);
     void verifyUserData(std::unordered_map<EncKeyLocation,std::unordered_map<std::string, DecryptedEncKeyV2>>& decryptedKeys);
+    std::unordered_map<std::string, DecryptedEncKeyV2> resolveKeysFromKeyChain(
+        const ModuleKeys& moduleKeys,
+        const EncKeyLocation& location,
+        std::set<std::string> keyIds
+    );
+    std::optional<std::vector<ModuleKeyChainLink>> decryptKeyChain(
+        const ModuleKeys& moduleKeys,
+        const EncKeyLocation& location,
+        const DecryptedEncKeyV2& currentKey
+    );
+    static ModuleKeyChainLink createKeyChainLink(const EncKey& key, const EncKey& previousKey);
+    std::vector<server::KeyEntrySet> createKeyEntrySets(
+        const std::vector<UserWithPubKey>& users,
+        const std::vector<std::pair<EncKey, DataIntegrityObject>>& keys,
+        const EncKeyLocation& location,
+        const std::string& containerSecret
+    );
+    crypto::PublicKey getPublicKey(const std::string& pubKey);
     privmx::crypto::PrivateKey _key;
     std::function<std::shared_ptr<UserVerifier>()> _getUserVerifier;
     EncKeyEncryptorV1 _encKeyEncryptorV1;
     EncKeyEncryptorV2 _encKeyEncryptorV2;
+    ModuleDataEncryptorV5 _moduleDataEncryptorV5;
+    // parsed public keys of users, the same users get keys of many containers
+    std::mutex _publicKeysMutex;
+    std::unordered_map<std::string, crypto::PublicKey> _publicKeys;
+    // decrypted key entries by key ID with the entry they come from, so refreshed modules decrypt only their new keys
+    std::mutex _decryptedKeysMutex;
+    std::unordered_map<std::string, std::pair<std::string, DecryptedEncKeyV2>> _decryptedKeys;
+    std::atomic_int64_t _decryptedKeysCount = 0;
+    std::atomic_int64_t _reusedDecryptedKeysCount = 0;
+    std::atomic_bool _keyChainEnabled = false;
 };
 
 }  // namespace core
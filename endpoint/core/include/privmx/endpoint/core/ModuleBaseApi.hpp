@@ -17,8 +17,11 @@ limitations under the License.
 #include <string>
 #include <type_traits>
 #include <functional>
+#include <future>
+#include <mutex>
 #include <vector>
 #include <map>
+#include <unordered_map>
 
 #include <privmx/endpoint/core/ConnectionImpl.hpp>
 #include <privmx/endpoint/core/encryptors/DataEncryptorV4.hpp>
@@ -34,6 +37,7 @@ limitations under the License.
 #include <privmx/endpoint/core/ServerTypes.hpp>
 #include "privmx/endpoint/core/Factory.hpp"
 #include "privmx/endpoint/core/ContainerKeyCache.hpp"
+#include "privmx/endpoint/core/AsyncRequestQueue.hpp"
 #include <privmx/utils/GuardedExecutor.hpp>
 
 namespace privmx {
@@ -54,6 +58,7 @@ public:
 
     virtual ~ModuleBaseApi() = default;
 protected:
+    const std::shared_ptr<AsyncRequestQueue>& getAsyncRequestQueue() const { return _asyncRequestQueue; }
 
     template<typename ModuleStruct>
     auto decryptModuleDataV4(
@@ -102,13 +107,25 @@ protected:
     virtual std::pair<ModuleKeys, int64_t> getModuleKeysAndVersionFromServer(std::string moduleId) = 0;
     ModuleKeys getNewModuleKeysAndUpdateCache(const std::string& moduleId);
     void setNewModuleKeysInCache(const std::string& moduleId, const ModuleKeys& newKeys, int64_t moduleVersion);
+    // puts the keys of a module just updated by the user into the cache: the user's entries of the keys before
+    // the update, given in moduleKeys, with the user's entries of the new keys added by the update
+    void writeThroughModuleKeysInCache(
+        const std::string& moduleId,
+        ModuleKeys moduleKeys,
+        const std::vector<server::KeyEntrySet>& newKeys,
+        const std::string& userId,
+        int64_t moduleVersion
+    );
     void invalidateModuleKeysInCache(const std::optional<std::string>& moduleId = std::nullopt);
+    void revalidateModuleKeysInCache();
     
 
     std::shared_ptr<privmx::utils::GuardedExecutor> _guardedExecutor;
 private:
     static core::ContainerKeyCache::CachedModuleKeys convertModuleKeysToContainerKeyCacheFormat(const ModuleKeys& moduleKeys, int64_t moduleVersion);
     static ModuleKeys convertContainerKeyCacheModuleKeysToModuleApiFormat(const core::ContainerKeyCache::CachedModuleKeys& moduleKeys);
+    // concurrent cache misses of the same module share a single request for its keys
+    std::pair<ModuleKeys, int64_t> getSharedModuleKeysAndVersionFromServer(const std::string& moduleId);
 
     privmx::crypto::PrivateKey _userPrivKey;
     std::shared_ptr<core::KeyProvider> _keyProvider;
@@ -118,6 +135,9 @@ private:
     core::ModuleDataEncryptorV4 _moduleDataEncryptorV4;
     core::ModuleDataEncryptorV5 _moduleDataEncryptorV5;
     core::ContainerKeyCache _keyCache;
+    std::shared_ptr<AsyncRequestQueue> _asyncRequestQueue;
+    std::mutex _moduleKeysRequestsMutex;
+    std::unordered_map<std::string, std::shared_future<std::pair<ModuleKeys, int64_t>>> _moduleKeysRequests;
 };
 
 template<typename ModuleStruct>
@@ -177,6 +197,7 @@ auto ModuleBaseApi::extractAndDecryptModuleInternalMeta(
         case core::ModuleDataSchema::Version::VERSION_4:
             return core::ModuleInternalMetaV5();
         case core::ModuleDataSchema::Version::VERSION_5:
+        case core::ModuleDataSchema::Version::VERSION_6:
             return decryptModuleDataV5(moduleObj, encKey).internalMeta;
         default:
             return core::ModuleInternalMetaV5();
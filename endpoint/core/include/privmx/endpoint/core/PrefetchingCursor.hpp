@@ -0,0 +1,212 @@
+/*
+PrivMX Endpoint.
+Copyright © 2024 Simplito sp. z o.o.
+
+This file is part of the PrivMX Platform (https://privmx.dev).
+This software is Licensed under the PrivMX Free License.
+
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef _PRIVMXLIB_ENDPOINT_CORE_PREFETCHINGCURSOR_HPP_
+#define _PRIVMXLIB_ENDPOINT_CORE_PREFETCHINGCURSOR_HPP_
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "privmx/endpoint/core/Cursor.hpp"
+#include "privmx/endpoint/core/ExceptionConverter.hpp"
+#include "privmx/endpoint/core/Types.hpp"
+
+namespace privmx {
+namespace endpoint {
+namespace core {
+
+// Page downloaded from the server and not decrypted yet.
+template<typename T>
+struct CursorPage {
+    int64_t totalAvailable;
+    // number of items returned by the server and ID of the last one, used to request the following page
+    size_t size;
+    std::optional<std::string> lastId;
+    std::function<std::vector<T>()> decrypt;
+};
+
+// Cursor downloading up to pagesAhead pages on its own thread, while next() decrypts the oldest page on the
+// caller's thread. Pages are requested one after another, as each query continues from the last item of the
+// previous page. The thread holds only the shared state, so a closed cursor is released after its last request.
+// The cursor ends once the items read (after the skipped ones) reach the total of the first page or a page is empty,
+// a page shorter than the limit is not the end, as the server may return fewer items than requested.
+template<typename T>
+class PrefetchingCursor : public CursorSource<T> {
+public:
+    using FetchPage = std::function<CursorPage<T>(const PagingQuery& query)>;
+
+    PrefetchingCursor(const FetchPage& fetchPage, const PagingQuery& query, int64_t pagesAhead);
+    ~PrefetchingCursor() override;
+    std::vector<T> next() override;
+    int64_t getTotalAvailable() override;
+    void close() override;
+    // continues from the last item when the items are sorted by creation (the order of their IDs), otherwise skips the page
+    static PagingQuery getNextQuery(const PagingQuery& query, size_t pageSize, const std::optional<std::string>& lastId);
+
+private:
+    struct State {
+        std::mutex mutex;
+        std::condition_variable cv;
+        FetchPage fetchPage;
+        PagingQuery query;
+        size_t pagesAhead;
+        std::deque<CursorPage<T>> pages;
+        std::optional<int64_t> totalAvailable;
+        // position of the next page in the list, counting the initially skipped items
+        int64_t position = 0;
+        std::exception_ptr error;
+        bool finished = false;
+        bool closed = false;
+    };
+
+    template<typename F>
+    static auto runWithCoreExceptions(const F& function);
+    static void fetchLoop(const std::shared_ptr<State>& state);
+
+    std::shared_ptr<State> _state;
+};
+
+template<typename T>
+PrefetchingCursor<T>::PrefetchingCursor(const FetchPage& fetchPage, const PagingQuery& query, int64_t pagesAhead)
+    : _state(std::make_shared<State>()) {
+    _state->fetchPage = fetchPage;
+    _state->query = query;
+    _state->position = query.skip;
+    _state->pagesAhead = pagesAhead;
+    std::thread(&PrefetchingCursor<T>::fetchLoop, _state).detach();
+}
+
+template<typename T>
+PrefetchingCursor<T>::~PrefetchingCursor() {
+    close();
+}
+
+template<typename T>
+std::vector<T> PrefetchingCursor<T>::next() {
+    std::optional<CursorPage<T>> page;
+    {
+        std::unique_lock lock(_state->mutex);
+        _state->cv.wait(lock, [&]() { return !_state->pages.empty() || _state->finished || _state->closed; });
+        if (_state->pages.empty()) {
+            if (_state->error && !_state->closed) {
+                std::rethrow_exception(_state->error);
+            }
+            return {};
+        }
+        page = std::move(_state->pages.front());
+        _state->pages.pop_front();
+    }
+    // lets the thread download the following page while this one is decrypted
+    _state->cv.notify_all();
+    return runWithCoreExceptions(page->decrypt);
+}
+
+template<typename T>
+int64_t PrefetchingCursor<T>::getTotalAvailable() {
+    std::unique_lock lock(_state->mutex);
+    _state->cv.wait(lock, [&]() { return _state->totalAvailable.has_value() || _state->finished || _state->closed; });
+    if (!_state->totalAvailable.has_value() && _state->error && !_state->closed) {
+        std::rethrow_exception(_state->error);
+    }
+    return _state->totalAvailable.value_or(0);
+}
+
+template<typename T>
+void PrefetchingCursor<T>::close() {
+    {
+        std::unique_lock lock(_state->mutex);
+        _state->closed = true;
+        _state->pages.clear();
+    }
+    _state->cv.notify_all();
+}
+
+template<typename T>
+PagingQuery PrefetchingCursor<T>::getNextQuery(const PagingQuery& query, size_t pageSize, const std::optional<std::string>& lastId) {
+    PagingQuery result = query;
+    if (lastId.has_value() && (!query.sortBy.has_value() || query.sortBy.value() == "createDate")) {
+        result.skip = 0;
+        result.lastId = lastId;
+    } else {
+        result.skip += pageSize;
+    }
+    return result;
+}
+
+template<typename T>
+template<typename F>
+auto PrefetchingCursor<T>::runWithCoreExceptions(const F& function) {
+    try {
+        return function();
+    } catch (const privmx::utils::PrivmxException& e) {
+        ExceptionConverter::rethrowAsCoreException(e);
+        throw Exception("ExceptionConverter rethrow error");
+    }
+}
+
+template<typename T>
+void PrefetchingCursor<T>::fetchLoop(const std::shared_ptr<State>& state) {
+    while (true) {
+        PagingQuery query;
+        {
+            std::unique_lock lock(state->mutex);
+            state->cv.wait(lock, [&]() { return state->closed || state->pages.size() < state->pagesAhead; });
+            if (state->closed) {
+                return;
+            }
+            query = state->query;
+        }
+        std::optional<CursorPage<T>> page;
+        std::exception_ptr error;
+        try {
+            page = runWithCoreExceptions([&]() { return state->fetchPage(query); });
+        } catch (...) {
+            error = std::current_exception();
+        }
+        bool last = true;
+        {
+            std::unique_lock lock(state->mutex);
+            if (state->closed) {
+                return;
+            }
+            if (error) {
+                state->error = error;
+            } else {
+                if (!state->totalAvailable.has_value()) {
+                    state->totalAvailable = page->totalAvailable;
+                }
+                state->position += page->size;
+                last = page->size == 0 || state->position >= state->totalAvailable.value();
+                state->query = getNextQuery(query, page->size, page->lastId);
+                state->pages.push_back(std::move(page.value()));
+            }
+            state->finished = last;
+        }
+        state->cv.notify_all();
+        if (last) {
+            return;
+        }
+    }
+}
+
+}  // namespace core
+}  // namespace endpoint
+}  // namespace privmx
+
+#endif  // _PRIVMXLIB_ENDPOINT_CORE_PREFETCHINGCURSOR_HPP_
@@ -71,6 +71,7 @@ public:
     void unsubscribeFromCurrentlySubscribed();
     std::optional<std::string> getSubscriptionQuery(const std::string& subscriptionId);
     std::optional<std::string> getSubscriptionQuery(const std::vector<std::string>& subscriptionIds);
+    bool hasSubscriptionForChannel(const std::string& channel);
 private:
     
 
@@ -1,19 +1,68 @@
 #ifndef _PRIVMXLIB_ENDPOINT_CORE_USERVERIFIER_HPP_
 #define _PRIVMXLIB_ENDPOINT_CORE_USERVERIFIER_HPP_
 
+#include <chrono>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <unordered_map>
+#include <privmx/endpoint/core/Types.hpp>
 #include <privmx/endpoint/core/UserVerifierInterface.hpp>
 #include <privmx/utils/Debug.hpp>
 namespace privmx {
 namespace endpoint {
 namespace core {
 
+// Verifies the items of a batch per sender key (context, user, public key and bridge). A key is assumed
+// to be valid over one continuous period, so the dates of a key are verified by asking the
+// UserVerifierInterface about the earliest and the latest of them only. Items of the keys which are
+// not valid at both ends of their range are verified one date at a time in a second call.
+// The cache keeps the range of dates each key was verified valid for until the ttl passes.
 class UserVerifier {
 public:
-    UserVerifier(std::shared_ptr<UserVerifierInterface> userVerifier);
+    static constexpr int64_t DEFAULT_CACHE_TTL = 60000;
+    static constexpr int64_t DEFAULT_CACHE_MAX_ENTRIES = 10000;
+
+    UserVerifier(
+        std::shared_ptr<UserVerifierInterface> userVerifier,
+        const UserVerifierCacheOptions& cacheOptions = {.ttl = DEFAULT_CACHE_TTL, .maxEntries = DEFAULT_CACHE_MAX_ENTRIES}
+    );
     std::vector<bool> verify(const std::vector<VerificationRequest>& request);
+    void setCacheOptions(const UserVerifierCacheOptions& cacheOptions);
+    void invalidate(const std::optional<std::string>& contextId, const std::optional<std::string>& userId);
+    UserVerifierMetrics getMetrics();
+
 private:
+    struct CacheEntry {
+        std::string contextId;
+        std::string userId;
+        std::chrono::steady_clock::time_point expires;
+        int64_t validFrom;
+        int64_t validTo;
+        std::list<std::string>::iterator lruPosition;
+    };
+
+    // requested items of one sender key which were not resolved from the cache
+    struct PendingKey {
+        std::vector<size_t> items;
+        size_t first;
+        size_t last;
+    };
+
+    static std::string cacheKey(const VerificationRequest& request);
+    bool isCachedValid(const std::string& key, int64_t date);
+    std::vector<bool> callVerifier(const std::vector<VerificationRequest>& request);
+    void storeValid(const std::string& key, const VerificationRequest& request);
+    void erase(const std::string& key);
+
     std::shared_ptr<UserVerifierInterface> _userVerifier;
+    std::mutex _mutex;
+    UserVerifierCacheOptions _cacheOptions;
+    std::unordered_map<std::string, CacheEntry> _cache;
+    std::list<std::string> _lru;
+    UserVerifierMetrics _metrics {};
 };
 
 }  // namespace core
@@ -13,6 +13,7 @@ limitations under the License.
 #define _PRIVMXLIB_ENDPOINT_CORE_USERS_KEYS_RESOLVER_HPP_
 
 #include <algorithm>
+#include <functional>
 #include <memory>
 #include <map>
 #include <set>
@@ -28,6 +29,9 @@ namespace core {
 
 class UsersKeysResolver {
 public:
+    // returns users with public keys for the given user ids
+    using UsersPubKeysGetter = std::function<std::vector<core::UserWithPubKey>(const std::vector<std::string>& userIds)>;
+
     template<typename ModuleStructAsTypedObj>
     static auto create(
             ModuleStructAsTypedObj moduleObj,
@@ -46,20 +50,27 @@ public:
             const DecryptedEncKeyV2& moduleCurrentKey
     );
 
+    // Resolves the change of members given as a difference: the removed users lose both roles, then the added ones
+    // are appended to the lists. Public keys of the members which were not added are looked up with getUsersPubKeys,
+    // which is needed only when the key has to be shared with all members. Members it does not return (they have left
+    // the Context) are dropped from the lists.
+    static std::shared_ptr<UsersKeysResolver> createFromDelta(
+            const std::vector<std::string>& currentUserIds,
+            const std::vector<std::string>& currentManagerIds,
+            const std::vector<core::UserWithPubKey>& usersToAdd,
+            const std::vector<core::UserWithPubKey>& managersToAdd,
+            const std::vector<std::string>& userIdsToRemove,
+            const DecryptedEncKeyV2& moduleCurrentKey,
+            const UsersPubKeysGetter& getUsersPubKeys
+    );
+
     std::vector<core::UserWithPubKey> getUsersToAddKey();
     std::vector<core::UserWithPubKey> getNewUsers();
     bool doNeedNewKey();
+    const std::vector<std::string>& getUserIds();
+    const std::vector<std::string>& getManagerIds();
 
 private:
-    template<typename ModuleStructAsTypedObj>
-    auto init(
-            ModuleStructAsTypedObj moduleObj,
-            const std::vector<core::UserWithPubKey>& users,
-            const std::vector<core::UserWithPubKey>& managers,
-            const bool forceGenerateNewKey,
-            const DecryptedEncKeyV2& moduleCurrentKey
-    )-> decltype(moduleObj.users, moduleObj.managers, void());
-
     void init(
             const std::vector<std::string>& currentUserIds,
             const std::vector<std::string>& currentManagerIds,
@@ -68,9 +79,20 @@ private:
             const bool forceGenerateNewKey,
             const DecryptedEncKeyV2& moduleCurrentKey
     );
+    void initFromDelta(
+            const std::vector<std::string>& currentUserIds,
+            const std::vector<std::string>& currentManagerIds,
+            const std::vector<core::UserWithPubKey>& usersToAdd,
+            const std::vector<core::UserWithPubKey>& managersToAdd,
+            const std::vector<std::string>& userIdsToRemove,
+            const DecryptedEncKeyV2& moduleCurrentKey,
+            const UsersPubKeysGetter& getUsersPubKeys
+    );
 
     std::vector<core::UserWithPubKey> _usersToAddMissingKey;
     std::vector<core::UserWithPubKey> _new_users;
+    std::vector<std::string> _userIds;
+    std::vector<std::string> _managerIds;
 
     bool _needNewKey;
 };
@@ -83,44 +105,13 @@ auto UsersKeysResolver::create(
         const bool forceGenerateNewKey,
         const DecryptedEncKeyV2& moduleCurrentKey
 )-> decltype(moduleObj.users, moduleObj.managers, std::shared_ptr<UsersKeysResolver>()) {
-    auto instance = std::make_shared<UsersKeysResolver>();
-    instance->init(moduleObj, users, managers, forceGenerateNewKey, moduleCurrentKey);
-    return instance;
-}
-
-template<typename ModuleStructAsTypedObj>
-auto UsersKeysResolver::init(
-    ModuleStructAsTypedObj moduleObj,
-    const std::vector<core::UserWithPubKey>& users,
-    const std::vector<core::UserWithPubKey>& managers,
-    const bool forceGenerateNewKey,
-    const DecryptedEncKeyV2& moduleCurrentKey
-)-> decltype(moduleObj.users, moduleObj.managers, void()) {
     auto usersVec {std::vector<std::string>(moduleObj.users.begin(), moduleObj.users.end())};
     auto managersVec {std::vector<std::string>(moduleObj.managers.begin(), moduleObj.managers.end())};
-    auto oldUsersIds {core::EndpointUtils::uniqueList(usersVec, managersVec)};
-
-    _new_users = core::EndpointUtils::uniqueListUserWithPubKey(users, managers);
-    auto newUsersIds {core::EndpointUtils::usersWithPubKeyToIds(_new_users)};
-    auto deletedUsersIds {core::EndpointUtils::getDifference(oldUsersIds, newUsersIds)};
-    auto addedUsersIds {core::EndpointUtils::getDifference(newUsersIds, oldUsersIds)};
-
-    // adjust key
-    if(moduleCurrentKey.dataStructureVersion < 2) {
-        //force update all keys if thread keys is in older version
-        _usersToAddMissingKey = _new_users;
-    } else {
-        for(auto new_user: _new_users) {
-            if( std::find(addedUsersIds.begin(), addedUsersIds.end(), new_user.userId) != addedUsersIds.end()) {
-                _usersToAddMissingKey.push_back(new_user);
-            }
-        }
-    }
-    _needNewKey = deletedUsersIds.size() > 0 || forceGenerateNewKey;
+    return create(usersVec, managersVec, users, managers, forceGenerateNewKey, moduleCurrentKey);
 }
 
 }  // namespace core
 }  // namespace endpoint
 }  // namespace privmx
 
-#endif  // _PRIVMXLIB_ENDPOINT_CORE_USERS_KEYS_RESOLVER_HPP_
\ No newline at end of file
+#endif  // _PRIVMXLIB_ENDPOINT_CORE_USERS_KEYS_RESOLVER_HPP_
@@ -90,6 +90,7 @@ public:
     static void validateJSON(const std::string& value, const std::string& stack_trace = "");
     static void validatePagingQuery(const PagingQuery& value,const std::vector<std::string>& sort_by_field, const std::string& stack_trace = "");
     static void validateBufferSize(const core::Buffer& value,size_t min_len, size_t max_len,const std::string& stack_trace = "");
+    static void validateDataFields(int64_t value, const std::string& stack_trace = "");
 
     template<typename T>
     static void validateClass(const T& value, const std::string& stack_trace = "") {
@@ -111,6 +111,15 @@ ContainerPolicy VarDeserializer::deserialize<ContainerPolicy>(const Poco::Dynami
 template<>
 PKIVerificationOptions VarDeserializer::deserialize<PKIVerificationOptions>(const Poco::Dynamic::Var& val, const std::string& name);
 
+template<>
+UserVerifierCacheOptions VarDeserializer::deserialize<UserVerifierCacheOptions>(const Poco::Dynamic::Var& val, const std::string& name);
+
+template<>
+ContainerMembersTarget VarDeserializer::deserialize<ContainerMembersTarget>(const Poco::Dynamic::Var& val, const std::string& name);
+
+template<>
+DataCompressionOptions VarDeserializer::deserialize<DataCompressionOptions>(const Poco::Dynamic::Var& val, const std::string& name);
+
 template<>
 core::EventType VarDeserializer::deserialize<core::EventType>(const Poco::Dynamic::Var& val, const std::string& name);
 
@@ -171,6 +171,30 @@ Poco::Dynamic::Var VarSerializer::serialize<BridgeIdentity>(const BridgeIdentity
 template<>
 Poco::Dynamic::Var VarSerializer::serialize<VerificationRequest>(const VerificationRequest& val);
 
+template<>
+Poco::Dynamic::Var VarSerializer::serialize<UserVerifierMetrics>(const UserVerifierMetrics& val);
+
+template<>
+Poco::Dynamic::Var VarSerializer::serialize<ContainerMembersUpdateResult>(const ContainerMembersUpdateResult& val);
+
+template<>
+Poco::Dynamic::Var VarSerializer::serialize<KeyCacheMetrics>(const KeyCacheMetrics& val);
+
+template<>
+Poco::Dynamic::Var VarSerializer::serialize<LatencyMetrics>(const LatencyMetrics& val);
+
+template<>
+Poco::Dynamic::Var VarSerializer::serialize<RpcMethodMetrics>(const RpcMethodMetrics& val);
+
+template<>
+Poco::Dynamic::Var VarSerializer::serialize<CryptoOperationMetrics>(const CryptoOperationMetrics& val);
+
+template<>
+Poco::Dynamic::Var VarSerializer::serialize<QueueMetrics>(const QueueMetrics& val);
+
+template<>
+Poco::Dynamic::Var VarSerializer::serialize<PerformanceMetrics>(const PerformanceMetrics& val);
+
 
 }  // namespace core
 }  // namespace endpoint
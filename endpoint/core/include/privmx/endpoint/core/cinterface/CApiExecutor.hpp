@@ -12,14 +12,20 @@ limitations under the License.
 #ifndef _PRIVMXLIB_UTILS_CAPIEXECUTOR_HPP_
 #define _PRIVMXLIB_UTILS_CAPIEXECUTOR_HPP_
 
+#include <algorithm>
+#include <cstring>
 #include <functional>
+#include <string>
 #include <Poco/Exception.h>
 #include <Poco/Dynamic/Var.h>
 #include <Pson/pson.h>
 
 #include <privmx/utils/PrivmxException.hpp>
 
+#include "privmx/endpoint/core/Buffer.hpp"
+#include "privmx/endpoint/core/cinterface/core.h"
 #include "privmx/endpoint/core/cinterface/ExceptionHandler.hpp"
+#include "privmx/endpoint/core/cinterface/InterfaceException.hpp"
 
 namespace privmx {
 namespace endpoint {
@@ -29,6 +35,34 @@ class CApiExecutor
 {
 public:
     static int execFunc(pson_value** result, const std::function<Poco::Dynamic::Var(void)>& func) noexcept;
+    static int execBinaryFunc(privmx_error* error, const std::function<void(void)>& func) noexcept;
+    static privmx_buffer toBuffer(std::string&& data);
+    static privmx_buffer toBuffer(core::Buffer&& data);
+    static void freeBuffer(privmx_buffer* buffer) noexcept;
+    static void assertNotNull(const void* value, const char* name);
+    static std::string toString(const char* value, const char* name);
+    static core::Buffer toCoreBuffer(const privmx_const_buffer& buffer, const char* name);
+private:
+    static void setError(privmx_error* error, int64_t code, const std::string& message) noexcept;
+};
+
+// Holds a privmx_buffer until it is handed over to the caller, so a throw while building
+// the remaining fields of an output struct does not leak the buffers built so far.
+class OwnedBuffer
+{
+public:
+    OwnedBuffer(std::string&& data) : _buffer(CApiExecutor::toBuffer(std::move(data))) {}
+    OwnedBuffer(core::Buffer&& data) : _buffer(CApiExecutor::toBuffer(std::move(data))) {}
+    OwnedBuffer(const OwnedBuffer&) = delete;
+    OwnedBuffer& operator=(const OwnedBuffer&) = delete;
+    ~OwnedBuffer() { CApiExecutor::freeBuffer(&_buffer); }
+    privmx_buffer release() noexcept {
+        privmx_buffer result = _buffer;
+        _buffer = privmx_buffer{.data = nullptr, .size = 0, .owner = nullptr};
+        return result;
+    }
+private:
+    privmx_buffer _buffer;
 };
 
 inline int CApiExecutor::execFunc(pson_value** result, const std::function<Poco::Dynamic::Var(void)>& func) noexcept {
@@ -64,6 +98,74 @@ inline int CApiExecutor::execFunc(pson_value** result, const std::function<Poco:
     return res->getValue<bool>("status");
 }
 
+inline int CApiExecutor::execBinaryFunc(privmx_error* error, const std::function<void(void)>& func) noexcept {
+    try {
+        func();
+        setError(error, 0, std::string());
+        return 1;
+    } catch (const endpoint::core::Exception& e) {
+        setError(error, e.getCode(), e.getFull());
+    } catch (const utils::PrivmxException& e) {
+        setError(error, UncaughtException().getCode(), std::string("utils::PrivmxException: ") + e.what() + ", code: " + std::to_string(e.getCode()));
+    } catch (const Poco::Exception& e) {
+        setError(error, UncaughtException().getCode(), std::string("Poco::Exception: ") + e.displayText());
+    } catch (const std::exception& e) {
+        setError(error, UncaughtException().getCode(), std::string("std::exception: ") + e.what());
+    } catch (...) {
+        setError(error, UncaughtException().getCode(), "Unknown");
+    }
+    return 0;
+}
+
+inline privmx_buffer CApiExecutor::toBuffer(std::string&& data) {
+    // the string is moved to the heap as is, so returning it does not copy the payload
+    std::string* owner = new std::string(std::move(data));
+    return privmx_buffer{.data = owner->data(), .size = owner->size(), .owner = owner};
+}
+
+inline privmx_buffer CApiExecutor::toBuffer(core::Buffer&& data) {
+    // the string is moved out of the Buffer as is
+    return toBuffer(std::move(data.stdString()));
+}
+
+inline void CApiExecutor::freeBuffer(privmx_buffer* buffer) noexcept {
+    if(buffer == nullptr) {
+        return;
+    }
+    delete (std::string*)buffer->owner;
+    *buffer = privmx_buffer{.data = nullptr, .size = 0, .owner = nullptr};
+}
+
+inline void CApiExecutor::assertNotNull(const void* value, const char* name) {
+    if(value == nullptr) {
+        throw NullPointerException(std::string(name) + " is NULL");
+    }
+}
+
+inline std::string CApiExecutor::toString(const char* value, const char* name) {
+    assertNotNull(value, name);
+    return std::string(value);
+}
+
+inline core::Buffer CApiExecutor::toCoreBuffer(const privmx_const_buffer& buffer, const char* name) {
+    // an empty buffer may come without data
+    if(buffer.size == 0) {
+        return core::Buffer();
+    }
+    assertNotNull(buffer.data, name);
+    return core::Buffer::from(buffer.data, buffer.size);
+}
+
+inline void CApiExecutor::setError(privmx_error* error, int64_t code, const std::string& message) noexcept {
+    if(error == nullptr) {
+        return;
+    }
+    error->code = code;
+    size_t size = std::min(message.size(), sizeof(error->message) - 1);
+    std::memcpy(error->message, message.data(), size);
+    error->message[size] = '\0';
+}
+
 } // cinterface
 } // endpoint
 } // privmx
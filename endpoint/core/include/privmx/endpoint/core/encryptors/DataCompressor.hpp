@@ -0,0 +1,61 @@
+/*
+PrivMX Endpoint.
+Copyright © 2024 Simplito sp. z o.o.
+
+This file is part of the PrivMX Platform (https://privmx.dev).
+This software is Licensed under the PrivMX Free License.
+
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef _PRIVMXLIB_ENDPOINT_CORE_DATACOMPRESSOR_HPP_
+#define _PRIVMXLIB_ENDPOINT_CORE_DATACOMPRESSOR_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <optional>
+
+#include "privmx/endpoint/core/Buffer.hpp"
+#include "privmx/endpoint/core/Types.hpp"
+
+namespace privmx {
+namespace endpoint {
+namespace core {
+
+// Compresses data fields before they are signed and encrypted. A compressed field is stored as
+// [codec][uncompressed size, 4 bytes big-endian][compressed data]. Decompression refuses fields declaring
+// more than the configured maximum size or inflating beyond the declared size, so the maximum size bounds
+// the memory a single field can take, and should match the largest field the server accepts.
+// The compressed length depends on the content, so a field mixing secret data with data chosen by someone
+// else leaks how much they have in common (CRIME-style), even though it is encrypted.
+class DataCompressor {
+public:
+    enum Codec : uint8_t {
+        DEFLATE = 1
+    };
+
+    static constexpr int64_t DEFAULT_MIN_SIZE = 1024;
+    static constexpr int64_t DEFAULT_MAX_DECOMPRESSED_SIZE = 16 * 1024 * 1024;
+    static constexpr int COMPRESSION_LEVEL = 6;
+
+    void setOptions(const DataCompressionOptions& options);
+    DataCompressionOptions getOptions() const;
+    size_t getMaxDecompressedSize() const;
+    // empty when compression is disabled, the data is smaller than the minimum size, larger than the maximum size
+    // or does not get smaller
+    std::optional<core::Buffer> compress(const core::Buffer& data) const;
+    static core::Buffer deflate(const core::Buffer& data);
+    static core::Buffer decompress(const core::Buffer& compressed, size_t maxSize = DEFAULT_MAX_DECOMPRESSED_SIZE);
+
+private:
+    std::atomic_bool _enabled {false};
+    std::atomic<int64_t> _minSize {DEFAULT_MIN_SIZE};
+    std::atomic<int64_t> _maxDecompressedSize {DEFAULT_MAX_DECOMPRESSED_SIZE};
+};
+
+}  // namespace core
+}  // namespace endpoint
+}  // namespace privmx
+
+#endif  // _PRIVMXLIB_ENDPOINT_CORE_DATACOMPRESSOR_HPP_
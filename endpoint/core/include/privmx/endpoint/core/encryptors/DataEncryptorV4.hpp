@@ -12,9 +12,16 @@ limitations under the License.
 #ifndef _PRIVMXLIB_ENDPOINT_CORE_DATAENCRYPTORV4_HPP_
 #define _PRIVMXLIB_ENDPOINT_CORE_DATAENCRYPTORV4_HPP_
 
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
 #include "privmx/crypto/ecc/PrivateKey.hpp"
 #include "privmx/crypto/ecc/PublicKey.hpp"
 #include "privmx/endpoint/core/Buffer.hpp"
+#include "privmx/endpoint/core/encryptors/DataCompressor.hpp"
 #include "privmx/endpoint/core/encryptors/DataInnerEncryptorV4.hpp"
 
 namespace privmx {
@@ -23,15 +30,34 @@ namespace core {
 
 class DataEncryptorV4 {
 public:
+    struct FieldToEncode {
+        std::reference_wrapper<const core::Buffer> data;
+        std::optional<std::string> encryptionKey;
+    };
+    struct FieldToDecode {
+        std::reference_wrapper<const std::string> dataAsBase64;
+        std::optional<std::string> encryptionKey;
+    };
+
     std::string signAndEncode(const core::Buffer& data, const crypto::PrivateKey& authorPrivateKey);
     std::string signAndEncryptAndEncode(const core::Buffer& data, const crypto::PrivateKey& authorPrivateKey,
                                         const std::string& encryptionKey);
     core::Buffer decodeAndVerify(const std::string& publicDataBase64, const crypto::PublicKey& authorPublicKey);
     core::Buffer decodeAndDecryptAndVerify(const std::string& privateDataBase64,
                                            const crypto::PublicKey& authorPublicKey, const std::string& encryptionKey);
+    // Signs (or verifies) all fields of one item with a single batch call.
+    // Fields with an encryption key are encrypted after signing (decrypted before verifying).
+    std::vector<std::string> signAndEncodeMany(const std::vector<FieldToEncode>& fields, const crypto::PrivateKey& authorPrivateKey);
+    std::vector<core::Buffer> decodeAndVerifyMany(const std::vector<FieldToDecode>& fields, const crypto::PublicKey& authorPublicKey);
+    // fields with an encryption key are compressed before signing when the compressor allows it,
+    // decoding handles compressed fields up to the maximum size of the compressor (the default one without it)
+    void setCompressor(const std::shared_ptr<const DataCompressor>& compressor);
 
 private:
+    size_t getMaxDecompressedSize() const;
+
     DataInnerEncryptorV4 _innerEncryptor;
+    std::shared_ptr<const DataCompressor> _compressor;
 };
 
 }  // namespace core
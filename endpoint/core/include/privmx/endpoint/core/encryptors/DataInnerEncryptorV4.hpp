@@ -12,9 +12,16 @@ limitations under the License.
 #ifndef _PRIVMXLIB_ENDPOINT_CORE_DATAINNERENCRYPTORV4_HPP_
 #define _PRIVMXLIB_ENDPOINT_CORE_DATAINNERENCRYPTORV4_HPP_
 
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
 #include "privmx/crypto/ecc/PrivateKey.hpp"
 #include "privmx/crypto/ecc/PublicKey.hpp"
 #include "privmx/endpoint/core/Buffer.hpp"
+#include "privmx/endpoint/core/encryptors/DataCompressor.hpp"
 
 namespace privmx {
 namespace endpoint {
@@ -22,23 +29,45 @@ namespace core {
 
 class DataInnerEncryptorV4 {
 public:
+    // packed data starts with the format: 1 for plain data, 2 for data compressed by DataCompressor
+    enum Format : uint8_t {
+        PLAIN = 1,
+        COMPRESSED = 2
+    };
     struct DataWithSignature {
         core::Buffer signature;
         core::Buffer data;
+        bool compressed = false;
     };
 
     std::string encode(const core::Buffer& data);
     core::Buffer decode(const std::string& dataAsBase64);
     core::Buffer encrypt(const core::Buffer& data, const std::string& encryptionKey);
     core::Buffer decrypt(const core::Buffer& privateData, const std::string& encryptionKey);
-    core::Buffer signAndPackDataWithSignature(const core::Buffer& data, const crypto::PrivateKey& authorPrivateKey);
-    core::Buffer verifyAndExtractData(const core::Buffer& signedData, const crypto::PublicKey& authorPublicKey);
+    core::Buffer signAndPackDataWithSignature(const core::Buffer& data, const crypto::PrivateKey& authorPrivateKey, bool compressed = false);
+    // compressed data declaring more than maxDecompressedSize bytes is refused
+    core::Buffer verifyAndExtractData(const core::Buffer& signedData, const crypto::PublicKey& authorPublicKey,
+                                      size_t maxDecompressedSize = DataCompressor::DEFAULT_MAX_DECOMPRESSED_SIZE);
+    // takes over the signed data and strips the header in place, so the data is not copied
+    core::Buffer verifyAndExtractData(core::Buffer&& signedData, const crypto::PublicKey& authorPublicKey,
+                                      size_t maxDecompressedSize = DataCompressor::DEFAULT_MAX_DECOMPRESSED_SIZE);
+    // compressed[i] tells whether data[i] has been compressed, all the data is plain when it is empty
+    std::vector<core::Buffer> signAndPackManyDataWithSignature(const std::vector<std::reference_wrapper<const core::Buffer>>& data,
+                                                               const crypto::PrivateKey& authorPrivateKey,
+                                                               const std::vector<bool>& compressed = {});
+    std::vector<core::Buffer> verifyAndExtractManyData(const std::vector<core::Buffer>& signedData, const crypto::PublicKey& authorPublicKey,
+                                                       size_t maxDecompressedSize = DataCompressor::DEFAULT_MAX_DECOMPRESSED_SIZE);
+    std::vector<core::Buffer> verifyAndExtractManyData(std::vector<core::Buffer>&& signedData, const crypto::PublicKey& authorPublicKey,
+                                                       size_t maxDecompressedSize = DataCompressor::DEFAULT_MAX_DECOMPRESSED_SIZE);
     
     DataWithSignature extractDataWithSignature(const core::Buffer& signedData);
     bool verifySignature(const DataWithSignature& dataWithSignature, const crypto::PublicKey& authorPublicKey);
 private:
-    DataWithSignature sign(const core::Buffer& data, const crypto::PrivateKey& authorPrivateKey);
-    core::Buffer packDataWithSignature(const DataWithSignature& dataWithSignature);
+    std::string sign(const core::Buffer& data, const crypto::PrivateKey& authorPrivateKey);
+    core::Buffer packDataWithSignature(const std::string& signature, const core::Buffer& data, bool compressed);
+    // returns the signature and the format flag, leaving only the data in signedData
+    std::pair<std::string, bool> stripSignature(core::Buffer& signedData);
+    static size_t getSignatureLength(std::string_view signedData);
 };
 
 }  // namespace core
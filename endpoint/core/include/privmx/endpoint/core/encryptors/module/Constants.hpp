@@ -22,7 +22,10 @@ namespace ModuleDataSchema {
    enum Version : int64_t {
       UNKNOWN = 0,
       VERSION_4 = 4,
-      VERSION_5 = 5
+      VERSION_5 = 5,
+      // version 5 with the key chain in the internal meta, written only when the key chain is enabled;
+      // clients unaware of the chain treat it as unknown and can neither read nor rewrite such data
+      VERSION_6 = 6
    };
 }
 
@@ -34,10 +34,17 @@ JSON_STRUCT_EXT(EncryptedModuleDataV4, VersionedData, ENCRYPTED_MODULE_DATA_V4_F
 
 // Version 5 
 
+#define MODULE_KEY_CHAIN_LINK_FIELDS(F)\
+    F(keyId, std::string)\
+    F(previousKeyId, std::string)\
+    F(encryptedPreviousKey, std::string)
+JSON_STRUCT(ModuleKeyChainLink, MODULE_KEY_CHAIN_LINK_FIELDS);
+
 #define MODULE_INTERNAL_META_V5_FIELDS(F)\
     F(secret, std::string)\
     F(resourceId, std::string)\
-    F(randomId, std::string)
+    F(randomId, std::string)\
+    F(keyChain, std::optional<std::vector<ModuleKeyChainLink>>)
 JSON_STRUCT(ModuleInternalMetaV5, MODULE_INTERNAL_META_V5_FIELDS);
 
 #define ENCRYPTED_MODULE_DATA_V5_FIELDS(F)\
@@ -36,6 +36,7 @@ public:
     DecryptedModuleDataV5 decrypt(const dynamic::EncryptedModuleDataV5& encryptedModuleData, const std::string& encryptionKey);
     DecryptedModuleDataV5 extractPublic(const dynamic::EncryptedModuleDataV5& encryptedModuleData);
     core::DataIntegrityObject getDIOAndAssertIntegrity(const dynamic::EncryptedModuleDataV5& encryptedModuleData);
+    void setCompressor(const std::shared_ptr<const core::DataCompressor>& compressor);
 private:
     void assertDataFormat(const dynamic::EncryptedModuleDataV5& encryptedModuleData);
     core::DataEncryptorV4 _dataEncryptor;
@@ -13,6 +13,7 @@ limitations under the License.
 #define _PRIVMXLIB_ENDPOINT_CORE_ENCRYPTORS_MODULE_TYPES_HPP_
 
 #include <string>
+#include <vector>
 #include "privmx/endpoint/core/Buffer.hpp"
 #include "privmx/endpoint/core/CoreTypes.hpp"
 
@@ -36,10 +37,18 @@ struct DecryptedModuleDataV4 : public core::DecryptedVersionedData {
 };
 
 // Version 5 
+// Link of the backward key chain: the key with keyId encrypts the key which preceded it
+struct ModuleKeyChainLink {
+    std::string keyId;
+    std::string previousKeyId;
+    std::string encryptedPreviousKey;
+};
+
 struct ModuleInternalMetaV5 {
     std::string secret;
     std::string resourceId;
     std::string randomId;
+    std::vector<ModuleKeyChainLink> keyChain;
 };
 
 struct ModuleDataToEncryptV5 {
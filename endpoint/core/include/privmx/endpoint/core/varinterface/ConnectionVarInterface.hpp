@@ -36,6 +36,16 @@ public:
         UnsubscribeFrom = 8,
         BuildSubscriptionQuery = 9,
         ListContextUsers = 10,
+        SetUserVerifierCacheOptions = 11,
+        InvalidateUserVerifierCache = 12,
+        GetUserVerifierMetrics = 13,
+        UpdateContainersMembers = 14,
+        GetKeyCacheMetrics = 15,
+        GetPerformanceMetrics = 16,
+        ResetPerformanceMetrics = 17,
+        SetPerformanceMetricsEnabled = 18,
+        SetDataCompressionOptions = 19,
+        SetKeyChainEnabled = 20,
     };
     
 
@@ -49,6 +59,16 @@ public:
     Poco::Dynamic::Var disconnect(const Poco::Dynamic::Var& args);
     Poco::Dynamic::Var listContextUsers(const Poco::Dynamic::Var& args);
     Poco::Dynamic::Var setUserVerifier(const std::function<Poco::Dynamic::Var(const Poco::Dynamic::Var&)>& verifierCallback);
+    Poco::Dynamic::Var setUserVerifierCacheOptions(const Poco::Dynamic::Var& args);
+    Poco::Dynamic::Var invalidateUserVerifierCache(const Poco::Dynamic::Var& args);
+    Poco::Dynamic::Var getUserVerifierMetrics(const Poco::Dynamic::Var& args);
+    Poco::Dynamic::Var updateContainersMembers(const Poco::Dynamic::Var& args);
+    Poco::Dynamic::Var getKeyCacheMetrics(const Poco::Dynamic::Var& args);
+    Poco::Dynamic::Var getPerformanceMetrics(const Poco::Dynamic::Var& args);
+    Poco::Dynamic::Var resetPerformanceMetrics(const Poco::Dynamic::Var& args);
+    Poco::Dynamic::Var setPerformanceMetricsEnabled(const Poco::Dynamic::Var& args);
+    Poco::Dynamic::Var setDataCompressionOptions(const Poco::Dynamic::Var& args);
+    Poco::Dynamic::Var setKeyChainEnabled(const Poco::Dynamic::Var& args);
     Poco::Dynamic::Var subscribeFor(const Poco::Dynamic::Var& args);
     Poco::Dynamic::Var unsubscribeFrom(const Poco::Dynamic::Var& args);
     Poco::Dynamic::Var buildSubscriptionQuery(const Poco::Dynamic::Var& args);
@@ -34,6 +34,8 @@ public:
 
     Poco::Dynamic::Var exec(METHOD method, const Poco::Dynamic::Var& args);
 
+    EventQueue getApi() const { return _eventQueue; }
+
 private:
     static std::map<METHOD, Poco::Dynamic::Var (EventQueueVarInterface::*)(const Poco::Dynamic::Var&)> methodMap;
 
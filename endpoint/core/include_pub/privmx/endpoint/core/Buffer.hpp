@@ -2,6 +2,7 @@
 #define _PRIVMXLIB_ENDPOINT_CORE_BUFFER_HPP_
 
 #include <string>
+#include <string_view>
 
 namespace privmx {
 namespace endpoint {
@@ -9,29 +10,44 @@ namespace core {
 
 /**
  * 'Buffer' provides simple string buffer implementation.
+ *
+ * For shared data with slicing and views that do not copy it, see `SharedBuffer`.
  */
 class Buffer {
 public:
 
     /**
      * Creates Buffer from `std::string`.
-     * 
+     *
      * @param str string to convert to Buffer
-     * 
+     *
      * @return Buffer object
      */
     static Buffer from(const std::string& str) { return Buffer(str); }
 
+    /**
+     * Creates Buffer from `std::string` taking over its content without copying.
+     *
+     * @param str string to convert to Buffer
+     *
+     * @return Buffer object
+     */
+    static Buffer from(std::string&& str) {
+        Buffer result;
+        result._data = std::move(str);
+        return result;
+    }
+
     /**
      * Creates Buffer from `char*`.
-     * 
+     *
      * @param data the char* to convert to Buffer
      * @param size data length
-     * 
+     *
      * @return Buffer object
      */
     static Buffer from(const char* data, std::size_t size) { return Buffer({data, size}); }
-    
+
     /**
      * //doc-gen:ignore
      */
@@ -39,14 +55,14 @@ public:
 
     /**
      * Gets data as `std::string` from Buffer.
-     * 
+     *
      * @return data as std::string
      */
     const std::string& stdString() const { return _data; }
 
     /**
      * Gets data as `std::string` from Buffer.
-     * 
+     *
      * @return data as std::string
      *
      */
@@ -54,7 +70,7 @@ public:
 
     /**
      * Gets Buffer data size.
-     * 
+     *
      * @return data size
      *
      */
@@ -63,12 +79,20 @@ public:
 
     /**
      * Gets data as char* from Buffer.
-     * 
+     *
      * @return data as char*
      *
      */
     const char* data() const { return _data.data(); }
 
+    /**
+     * Gets data as `std::string_view` without copying it.
+     *
+     * @return view of the data, valid until the Buffer is modified or destroyed
+     *
+     */
+    std::string_view view() const { return std::string_view(_data.data(), _data.size()); }
+
     bool operator==(const Buffer& obj) const {return this->_data == obj._data;}
 
 private:
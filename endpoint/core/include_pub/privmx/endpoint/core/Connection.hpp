@@ -5,6 +5,7 @@
 #include <string>
 #include <optional>
 
+#include "privmx/endpoint/core/Future.hpp"
 #include "privmx/endpoint/core/Types.hpp"
 #include "privmx/endpoint/core/UserVerifierInterface.hpp"
 #include "privmx/endpoint/core/ExtendedPointer.hpp"
@@ -115,11 +116,132 @@ public:
      * A developer can implement an interface and pass the implementation to the function. 
      * Each time data is read from the container, a callback will be triggered, allowing the developer to validate the sender in an external service,
      * e.g. Developer's Application Server or PKI Server.
+     * Items of the same sender's key are verified by passing the earliest and the latest of their dates to the callback,
+     * a key valid at both of them is treated as valid at every date in between.
      * @param verifier an implementation of the UserVerifierInterface
      * 
      */
     void setUserVerifier(std::shared_ptr<UserVerifierInterface> verifier);
 
+    /**
+     * Sets options of the cache of user verification results.
+     * 
+     * The cache is enabled by default. It keeps, for each sender's key, the range of dates the key was verified valid for,
+     * so dates within the range are not verified again until the result expires. A key is assumed to be valid over
+     * one continuous period. Invalid results are not cached. Setting the options clears the cache.
+     * @param options cache options, `ttl` equal to 0 disables the cache
+     * 
+     */
+    void setUserVerifierCacheOptions(const UserVerifierCacheOptions& options);
+
+    /**
+     * Removes cached user verification results, e.g. after a user's key has been revoked.
+     * 
+     * @param contextId ID of the Context to remove the results of, or all Contexts when empty
+     * @param userId ID of the user to remove the results of, or all users when empty
+     * 
+     */
+    void invalidateUserVerifierCache(const std::optional<std::string>& contextId, const std::optional<std::string>& userId);
+
+    /**
+     * Gets statistics of user verification since the verifier was set.
+     * 
+     * @return struct containing the numbers of verified items, cache hits and verification callback calls and their time
+     * 
+     */
+    UserVerifierMetrics getUserVerifierMetrics();
+
+    /**
+     * Gets statistics of the caches of container encryption keys, showing how many container fetches and key decryptions were saved.
+     * 
+     * @return struct containing the numbers of cache hits and misses, cache updates and decrypted key entries
+     * 
+     */
+    KeyCacheMetrics getKeyCacheMetrics();
+
+    /**
+     * Gets performance statistics of the library: latency of the Bridge RPC calls, cryptographic operations and queues.
+     * 
+     * The statistics are collected in the whole process, from all the connections, so this method does not need a connection.
+     * Statistics of a single connection are returned by getKeyCacheMetrics() and getUserVerifierMetrics().
+     * @return struct containing the statistics collected since the library was loaded or the last resetPerformanceMetrics() call
+     * 
+     */
+    static PerformanceMetrics getPerformanceMetrics();
+
+    /**
+     * Clears the counters and histograms of the process-wide performance statistics, e.g. to measure a single period of time.
+     * 
+     * The maximum queue depths start again from the current depths.
+     * 
+     */
+    static void resetPerformanceMetrics();
+
+    /**
+     * Enables or disables collecting the process-wide performance statistics, which is enabled by default.
+     * 
+     * @param enabled whether to collect the statistics
+     * 
+     */
+    static void setPerformanceMetricsEnabled(bool enabled);
+
+    /**
+     * Sets options of the asynchronous methods of the module APIs created for this Connection, e.g. ThreadApi::sendMessageAsync().
+     * 
+     * Asynchronous calls are queued and processed in parallel, so many requests are sent to the server without waiting for the previous ones.
+     * @param options maximum number of calls processed at the same time and the executor of completion callbacks
+     * 
+     */
+    void setAsyncOptions(const AsyncOptions& options);
+
+    /**
+     * Sets whether the private data of messages, KVDB entries, files and containers is compressed before it is encrypted.
+     * 
+     * Compression saves bandwidth and storage of large text or JSON data, while the reading side always recognizes compressed data.
+     * Compressed data cannot be read by older library versions, so enable it only when all the clients are up to date.
+     * The length of encrypted compressed data reveals how well it compresses, so a field holding both secrets and data
+     * chosen by someone else lets them guess the secrets from the length (as in the CRIME attack); keep compression
+     * disabled for such data.
+     * @param options whether to compress, the minimum size of a field to compress and the maximum size of a decompressed field
+     * 
+     */
+    void setDataCompressionOptions(const DataCompressionOptions& options);
+
+    /**
+     * Sets whether Threads, Stores and Kvdbs get a key chain when their members or keys change, which is disabled by default.
+     * 
+     * With the key chain each new key encrypts the key it replaces, so a new member is given only the newest key
+     * instead of all the keys of the container. Containers with the key chain are written in a data format which
+     * older library versions do not recognize, so they cannot read such containers at all.
+     * Enable it only when all the clients are up to date. Containers which already have a key chain
+     * keep it even when it is disabled, so members given only the newest key do not lose access to older data.
+     * @param enabled whether to create key chains
+     * 
+     */
+    void setKeyChainEnabled(bool enabled);
+
+    /**
+     * Changes the members of many containers at once, e.g. to add or remove an employee from all their Threads, Stores and Kvdbs.
+     * 
+     * The removed users lose access to the containers, then the added users and managers are given access to them.
+     * Containers are updated in parallel and each one is updated again when it was modified by someone else in the meantime.
+     * An error of a single container does not stop the update of the others, it is reported in the result of that container.
+     * The API of each module used by the targets (e.g. ThreadApi) has to be created for this Connection before the call.
+     * @param targets list of containers to update
+     * @param usersToAdd list of users to add to the containers
+     * @param managersToAdd list of managers to add to the containers
+     * @param userIdsToRemove list of IDs of the users and managers to remove from the containers
+     * 
+     * @return list of results of the update of each container, in the order of the targets
+     * 
+     */
+    std::vector<ContainerMembersUpdateResult> updateContainersMembers(
+        const std::vector<ContainerMembersTarget>& targets,
+        const std::vector<UserWithPubKey>& usersToAdd,
+        const std::vector<UserWithPubKey>& managersToAdd,
+        const std::vector<std::string>& userIdsToRemove
+    );
+
 private:
     void assertConnection(const std::shared_ptr<ConnectionImpl>& impl);
     Connection(const std::shared_ptr<ConnectionImpl>& impl);
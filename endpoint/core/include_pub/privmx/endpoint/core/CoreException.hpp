@@ -68,6 +68,12 @@ DECLARE_ENDPOINT_EXCEPTION(EndpointCoreException, UnknownModuleFormatException,
 DECLARE_ENDPOINT_EXCEPTION(EndpointCoreException, InvalidSubscriptionQueryException, "Invalid subscriptionQuery", 0x00024)
 DECLARE_ENDPOINT_EXCEPTION(EndpointCoreException, InvalidSingletonsHolderStateException, "Invalid Singletons Holder state", 0x00025)
 DECLARE_ENDPOINT_EXCEPTION(EndpointCoreException, MissingBridgeIdentityException, "Missing Bridge Identity", 0x00026)
+DECLARE_ENDPOINT_EXCEPTION(EndpointCoreException, ContextUserNotFoundException, "User not found in Context", 0x00027)
+DECLARE_ENDPOINT_EXCEPTION(EndpointCoreException, ContainerVersionConflictException, "Container modified concurrently", 0x00028)
+DECLARE_ENDPOINT_EXCEPTION(EndpointCoreException, UnknownContainerModuleException, "Unknown container module", 0x00029)
+DECLARE_ENDPOINT_EXCEPTION(EndpointCoreException, AsyncRequestCancelledException, "Asynchronous request cancelled", 0x0002A)
+DECLARE_ENDPOINT_EXCEPTION(EndpointCoreException, AsyncRequestTimeoutException, "Asynchronous request timed out", 0x0002B)
+DECLARE_ENDPOINT_EXCEPTION(EndpointCoreException, DataDecompressionException, "Invalid compressed data", 0x0002C)
 
 DECLARE_SCOPE_ENDPOINT_EXCEPTION(EndpointConnectionException, "Unknown endpoint connection exception", "Connection", 0x0002)
 DECLARE_ENDPOINT_EXCEPTION(EndpointConnectionException, NotInitializedException, "Endpoint not initialized", 0x0001)
@@ -0,0 +1,81 @@
+#ifndef _PRIVMXLIB_ENDPOINT_CORE_CURSOR_HPP_
+#define _PRIVMXLIB_ENDPOINT_CORE_CURSOR_HPP_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace privmx {
+namespace endpoint {
+namespace core {
+
+/**
+ * Default number of pages a Cursor downloads ahead of the page being read.
+ */
+constexpr int64_t DEFAULT_CURSOR_PAGES_AHEAD = 2;
+
+/**
+ * //doc-gen:ignore
+ */
+template<typename T>
+class CursorSource {
+public:
+    virtual ~CursorSource() = default;
+    virtual std::vector<T> next() = 0;
+    virtual int64_t getTotalAvailable() = 0;
+    virtual void close() = 0;
+};
+
+/**
+ * Reads a whole listing page by page. The following pages are downloaded in the background,
+ * while the current page is decrypted and processed by the application.
+ */
+template<typename T>
+class Cursor {
+public:
+    /**
+     * //doc-gen:ignore
+     */
+    Cursor() = default;
+
+    /**
+     * //doc-gen:ignore
+     */
+    Cursor(const std::shared_ptr<CursorSource<T>>& source) : _source(source) {}
+
+    /**
+     * Gets the next page of the listing, waiting for it when it has not been downloaded yet.
+     * Throws the exception which failed the download of the page.
+     *
+     * @return list of items of the next page, empty when all the items have been read or the cursor is closed
+     */
+    std::vector<T> next() const {
+        return _source->next();
+    }
+
+    /**
+     * Gets the total number of items of the listing, as returned with the first page.
+     *
+     * @return total items available to get
+     */
+    int64_t getTotalAvailable() const {
+        return _source->getTotalAvailable();
+    }
+
+    /**
+     * Stops downloading the following pages and frees the downloaded ones.
+     * A cursor is also closed when its last copy is destroyed.
+     */
+    void close() const {
+        _source->close();
+    }
+
+private:
+    std::shared_ptr<CursorSource<T>> _source;
+};
+
+}  // namespace core
+}  // namespace endpoint
+}  // namespace privmx
+
+#endif  // _PRIVMXLIB_ENDPOINT_CORE_CURSOR_HPP_
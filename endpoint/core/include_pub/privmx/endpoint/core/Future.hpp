@@ -0,0 +1,152 @@
+#ifndef _PRIVMXLIB_ENDPOINT_CORE_FUTURE_HPP_
+#define _PRIVMXLIB_ENDPOINT_CORE_FUTURE_HPP_
+
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace privmx {
+namespace endpoint {
+namespace core {
+
+/**
+ * Options of the asynchronous methods of the module APIs created for a Connection.
+ */
+struct AsyncOptions {
+    /**
+     * Maximum number of asynchronous calls processed at the same time, the other calls wait in a queue.
+     */
+    int64_t maxInFlightRequests;
+
+    /**
+     * Function running the completion callbacks, e.g. posting them to the application's event loop.
+     * When empty, a callback runs on the library thread which completed the call.
+     */
+    std::function<void(const std::function<void()>& callback)> completionExecutor;
+};
+
+/**
+ * Options of a single asynchronous call.
+ */
+struct AsyncCallOptions {
+    /**
+     * Time in milliseconds after which the call fails with AsyncRequestTimeoutException, no deadline when empty.
+     * A call which has already been sent is not interrupted, it may still be applied by the server and its result is discarded.
+     */
+    std::optional<int64_t> timeout;
+};
+
+/**
+ * //doc-gen:ignore
+ */
+class AsyncRequest {
+public:
+    using CompletionExecutor = std::function<void(const std::function<void()>& callback)>;
+
+    AsyncRequest(const CompletionExecutor& completionExecutor, const std::function<void(std::exception_ptr)>& setError);
+    void cancel();
+    void addCompletionCallback(const std::function<void()>& callback);
+    bool isCompleted();
+    // both return false when the request has already been completed, e.g. cancelled or timed out
+    bool complete(const std::function<void()>& setResult);
+    bool fail(std::exception_ptr error);
+
+private:
+    bool finish(const std::function<void()>& setOutcome);
+    void runCallback(const std::function<void()>& callback);
+
+    std::mutex _mutex;
+    bool _completed = false;
+    std::vector<std::function<void()>> _callbacks;
+    CompletionExecutor _completionExecutor;
+    std::function<void(std::exception_ptr)> _setError;
+};
+
+/**
+ * Result of an asynchronous call, available when the call is completed.
+ */
+template<typename T>
+class Future {
+public:
+    /**
+     * //doc-gen:ignore
+     */
+    Future() = default;
+
+    /**
+     * //doc-gen:ignore
+     */
+    Future(const std::shared_future<T>& future, const std::shared_ptr<AsyncRequest>& request) : _future(future), _request(request) {}
+
+    /**
+     * Waits for the call to complete and returns its result.
+     * Throws the exception which failed the call, AsyncRequestCancelledException or AsyncRequestTimeoutException.
+     *
+     * @return result of the call
+     */
+    T get() const {
+        return _future.get();
+    }
+
+    /**
+     * Waits for the call to complete.
+     */
+    void wait() const {
+        _future.wait();
+    }
+
+    /**
+     * Waits for the call to complete, at most the given time.
+     *
+     * @param timeout time to wait in milliseconds
+     * @return whether the call is completed
+     */
+    bool waitFor(int64_t timeout) const {
+        return _future.wait_for(std::chrono::milliseconds(timeout)) == std::future_status::ready;
+    }
+
+    /**
+     * Checks whether the call is completed, without waiting.
+     *
+     * @return whether the call is completed
+     */
+    bool isReady() const {
+        return waitFor(0);
+    }
+
+    /**
+     * Cancels the call, which then fails with AsyncRequestCancelledException.
+     * A call which has already been sent to the server may still take effect there.
+     */
+    void cancel() const {
+        _request->cancel();
+    }
+
+    /**
+     * Sets a callback run once the call is completed, right away when it is already completed.
+     * Callbacks run on the completion executor of the Connection.
+     *
+     * @param callback function called with this Future, whose get() does not block
+     */
+    void then(const std::function<void(const Future<T>& future)>& callback) const {
+        Future<T> self = *this;
+        _request->addCompletionCallback([self, callback]() {
+            callback(self);
+        });
+    }
+
+private:
+    std::shared_future<T> _future;
+    std::shared_ptr<AsyncRequest> _request;
+};
+
+}  // namespace core
+}  // namespace endpoint
+}  // namespace privmx
+
+#endif  // _PRIVMXLIB_ENDPOINT_CORE_FUTURE_HPP_
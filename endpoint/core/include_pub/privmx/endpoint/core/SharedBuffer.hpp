@@ -0,0 +1,137 @@
+#ifndef _PRIVMXLIB_ENDPOINT_CORE_SHAREDBUFFER_HPP_
+#define _PRIVMXLIB_ENDPOINT_CORE_SHAREDBUFFER_HPP_
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "privmx/endpoint/core/Buffer.hpp"
+
+namespace privmx {
+namespace endpoint {
+namespace core {
+
+/**
+ * 'SharedBuffer' provides immutable byte buffer implementation with shared storage.
+ *
+ * Copies and slices of a SharedBuffer share its storage, so they do not copy the data.
+ * The data is copied only when it is converted to a `Buffer` which does not own it alone.
+ */
+class SharedBuffer {
+public:
+
+    /**
+     * Creates SharedBuffer from `std::string` taking over its content without copying.
+     *
+     * @param str string to convert to SharedBuffer
+     *
+     * @return SharedBuffer object
+     */
+    static SharedBuffer from(std::string&& str);
+
+    /**
+     * Creates SharedBuffer from `std::vector<uint8_t>` taking over its content without copying.
+     *
+     * @param data the vector to convert to SharedBuffer
+     *
+     * @return SharedBuffer object
+     */
+    static SharedBuffer from(std::vector<uint8_t>&& data);
+
+    /**
+     * Creates SharedBuffer from `Buffer` taking over its content without copying.
+     *
+     * @param buffer the Buffer to convert to SharedBuffer
+     *
+     * @return SharedBuffer object
+     */
+    static SharedBuffer from(Buffer&& buffer) { return from(std::move(buffer.stdString())); }
+
+    /**
+     * Creates SharedBuffer over memory owned by the caller without copying it.
+     * The memory has to stay valid and unchanged until `release` is called,
+     * which happens when the last SharedBuffer using it is destroyed.
+     *
+     * @param data pointer to the data
+     * @param size data length
+     * @param release function called when the memory is no longer used
+     *
+     * @return SharedBuffer object
+     */
+    static SharedBuffer adopt(const char* data, std::size_t size, std::function<void()> release);
+
+    /**
+     * //doc-gen:ignore
+     */
+    SharedBuffer() = default;
+
+    /**
+     * Gets SharedBuffer data size.
+     *
+     * @return data size
+     *
+     */
+    std::size_t size() const { return _size; }
+
+    /**
+     * Gets data as char* from SharedBuffer.
+     *
+     * @return data as char*
+     *
+     */
+    const char* data() const { return _size == 0 ? "" : _data; }
+
+    /**
+     * Gets data as `std::string_view` without copying it.
+     *
+     * @return view of the data, valid as long as the SharedBuffer or any of its copies and slices
+     *
+     */
+    std::string_view view() const { return std::string_view(data(), size()); }
+
+    /**
+     * Gets a part of the SharedBuffer without copying the data.
+     *
+     * @param offset position of the first byte of the part
+     * @param length maximal length of the part
+     *
+     * @return SharedBuffer sharing the data with this SharedBuffer
+     *
+     */
+    SharedBuffer slice(std::size_t offset, std::size_t length = std::string::npos) const;
+
+    /**
+     * Converts the data to a Buffer.
+     * The data is moved when this SharedBuffer is the only user of a whole string, otherwise it is copied.
+     *
+     * @return Buffer with the data
+     *
+     */
+    Buffer toBuffer() &&;
+
+    /**
+     * Converts the data to a Buffer by copying it.
+     *
+     * @return Buffer with the data
+     *
+     */
+    Buffer toBuffer() const & { return Buffer::from(data(), size()); }
+
+    bool operator==(const SharedBuffer& obj) const {return view() == obj.view();}
+
+private:
+    struct Storage;
+
+    std::shared_ptr<Storage> _storage;
+    const char* _data = nullptr;
+    std::size_t _size = 0;
+};
+
+}  // namespace core
+}  // namespace endpoint
+}  // namespace privmx
+
+#endif  // _PRIVMXLIB_ENDPOINT_CORE_SHAREDBUFFER_HPP_
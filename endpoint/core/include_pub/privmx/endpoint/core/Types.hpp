@@ -227,6 +227,265 @@ struct BridgeIdentity {
     std::optional<std::string> instanceId;
 };
 
+/**
+ * Options of the cache of user verification results.
+ */
+struct UserVerifierCacheOptions {
+    /**
+     * Time in milliseconds after which a cached result is verified again (60000 by default), 0 disables the cache.
+     */
+    int64_t ttl;
+    /**
+     * Maximum number of cached sender keys.
+     */
+    int64_t maxEntries;
+};
+
+/**
+ * Statistics of user verification since the verifier was set.
+ */
+struct UserVerifierMetrics {
+    /**
+     * Number of verified items requested by the library.
+     */
+    int64_t requestedItems;
+    /**
+     * Number of requested items resolved from the cache.
+     */
+    int64_t cacheHits;
+    /**
+     * Number of calls of the UserVerifierInterface.
+     */
+    int64_t verifierCalls;
+    /**
+     * Number of items passed to the UserVerifierInterface.
+     */
+    int64_t verifierItems;
+    /**
+     * Total time in milliseconds spent in the UserVerifierInterface.
+     */
+    int64_t verifierTime;
+    /**
+     * Longest call of the UserVerifierInterface in milliseconds.
+     */
+    int64_t maxVerifierTime;
+};
+
+/**
+ * Statistics of the caches of container encryption keys since the connection was created.
+ */
+struct KeyCacheMetrics {
+    /**
+     * Number of requests for the keys of a container resolved from the cache.
+     */
+    int64_t cacheHits;
+    /**
+     * Number of requests for the keys of a container which had to fetch the container from the server.
+     */
+    int64_t cacheMisses;
+    /**
+     * Number of containers updated by the user whose new keys were put into the cache directly.
+     */
+    int64_t writeThroughUpdates;
+    /**
+     * Number of cached containers checked with the server after a reconnect and found unchanged.
+     */
+    int64_t revalidatedEntries;
+    /**
+     * Number of cached containers dropped from the cache or replaced after a reconnect because they changed.
+     */
+    int64_t invalidatedEntries;
+    /**
+     * Number of decrypted key entries.
+     */
+    int64_t decryptedKeys;
+    /**
+     * Number of key entries not decrypted again, as they had already been decrypted before.
+     */
+    int64_t reusedDecryptedKeys;
+};
+
+/**
+ * Distribution of durations in microseconds, the percentiles are approximated with a relative error below 12.5%.
+ */
+struct LatencyMetrics {
+    /**
+     * Number of measured durations.
+     */
+    int64_t count;
+    /**
+     * Sum of the measured durations.
+     */
+    int64_t totalTime;
+    /**
+     * Longest measured duration.
+     */
+    int64_t maxTime;
+    /**
+     * Median of the measured durations.
+     */
+    int64_t p50;
+    /**
+     * 90th percentile of the measured durations.
+     */
+    int64_t p90;
+    /**
+     * 99th percentile of the measured durations.
+     */
+    int64_t p99;
+};
+
+/**
+ * Statistics of the calls of a single Bridge RPC method.
+ */
+struct RpcMethodMetrics {
+    /**
+     * Name of the RPC method.
+     */
+    std::string method;
+    /**
+     * Number of failed calls.
+     */
+    int64_t errors;
+    /**
+     * Time of the calls from sending the request until receiving the response, including failed calls.
+     */
+    LatencyMetrics latency;
+};
+
+/**
+ * Statistics of a single cryptographic primitive.
+ */
+struct CryptoOperationMetrics {
+    /**
+     * Name of the primitive: "aesEncrypt", "aesDecrypt", "hash", "hmac", "eciesEncrypt", "eciesDecrypt", "ecdh", "ecdsaSign" or "ecdsaVerify".
+     */
+    std::string operation;
+    /**
+     * Number of operations, the AES and HMAC done inside ECIES are counted only as ECIES.
+     */
+    int64_t operations;
+    /**
+     * Number of processed input bytes.
+     */
+    int64_t bytes;
+};
+
+/**
+ * Size of a queue.
+ */
+struct QueueMetrics {
+    /**
+     * Current number of queued items.
+     */
+    int64_t depth;
+    /**
+     * Largest number of queued items.
+     */
+    int64_t maxDepth;
+};
+
+/**
+ * Performance statistics of the library, collected in the whole process.
+ */
+struct PerformanceMetrics {
+    /**
+     * Statistics of each called Bridge RPC method, collected from all the connections of the process.
+     */
+    std::vector<RpcMethodMetrics> rpcMethods;
+    /**
+     * Statistics of the cryptographic primitives, collected in the whole process.
+     */
+    std::vector<CryptoOperationMetrics> cryptoOperations;
+    /**
+     * Size of the queue of the tasks run by the library threads in background.
+     */
+    QueueMetrics executorQueue;
+    /**
+     * Time the background tasks wait in the queue before they are started.
+     */
+    LatencyMetrics executorQueueWait;
+    /**
+     * Size of the queue of events not taken yet from the EventQueue.
+     */
+    QueueMetrics eventQueue;
+};
+
+/**
+ * Options of compressing the private data of messages, KVDB entries, files and containers before it is encrypted.
+ */
+struct DataCompressionOptions {
+    /**
+     * Whether to compress the private data, disabled by default. Compressed data can be read only by library versions supporting it.
+     * The length of compressed data depends on its content, so do not enable it when a field mixes secrets with data chosen by others.
+     */
+    bool enabled;
+    /**
+     * Minimum size in bytes of a field to compress, smaller fields are stored as they are.
+     */
+    int64_t minSize;
+    /**
+     * Maximum size in bytes of a decompressed field, 16 MiB by default. Read fields declaring more are refused
+     * and larger fields are stored as they are. Set it to the maximum field size accepted by the PrivMX Bridge.
+     */
+    int64_t maxDecompressedSize;
+};
+
+/**
+ * Container whose members are changed by a bulk members update.
+ */
+struct ContainerMembersTarget {
+    /**
+     * Module of the container: "thread", "store" or "kvdb".
+     */
+    std::string module;
+    /**
+     * ID of the container.
+     */
+    std::string containerId;
+};
+
+/**
+ * Result of changing the members of a single container in a bulk members update.
+ */
+struct ContainerMembersUpdateResult {
+    /**
+     * Module of the container.
+     */
+    std::string module;
+    /**
+     * ID of the container.
+     */
+    std::string containerId;
+    /**
+     * Whether the members of the container have been changed.
+     */
+    bool success;
+    /**
+     * Number of update attempts, more than 1 when the container was modified by someone else in the meantime.
+     */
+    int64_t attempts;
+    /**
+     * Code of the error which stopped the update.
+     */
+    std::optional<int64_t> errorCode;
+    /**
+     * Description of the error which stopped the update.
+     */
+    std::optional<std::string> errorMessage;
+};
+
+/**
+ * Fields of messages and KVDB entries decrypted by list and get calls, combined into a bitmask.
+ * Fields left out are returned empty, while the integrity and the author of the item are always verified.
+ */
+enum DataField: int64_t {
+    PUBLIC_META = 1,
+    PRIVATE_META = 2,
+    DATA = 4,
+    ALL_DATA_FIELDS = PUBLIC_META | PRIVATE_META | DATA
+};
+
 enum EventType: int64_t {
     USER_ADD = 0,
     USER_REMOVE = 1,
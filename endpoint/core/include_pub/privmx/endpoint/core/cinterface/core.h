@@ -1,17 +1,58 @@
 #ifndef _PRIVMX_ENDPOINT_CORE_INTERFACE_API_
 #define _PRIVMX_ENDPOINT_CORE_INTERFACE_API_
 
+#include <stddef.h>
+#include <stdint.h>
 #include <Pson/pson.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+// Binary interface: flat structs and raw buffers, without pson values in between.
+// Functions return 1 on success and 0 on failure, in which case the error (when given) is filled.
+// NULL pointers and strings are reported as an error, only a privmx_const_buffer of size 0 may have NULL data.
+
+// Buffer owned by the library, released with privmx_endpoint_freeBuffer(). Data is always followed by a '\0'.
+typedef struct privmx_buffer {
+    const char* data;
+    size_t size;
+    void* owner;
+} privmx_buffer;
+
+// Buffer owned by the caller, read by the library only during the call.
+typedef struct privmx_const_buffer {
+    const char* data;
+    size_t size;
+} privmx_const_buffer;
+
+typedef struct privmx_user_with_pub_key {
+    const char* userId;
+    const char* pubKey;
+} privmx_user_with_pub_key;
+
+typedef struct privmx_error {
+    int64_t code;
+    char message[256];
+} privmx_error;
+
+typedef struct privmx_event {
+    privmx_buffer type;
+    privmx_buffer channel;
+    int64_t connectionId;
+    int64_t timestamp;
+    privmx_buffer json;
+} privmx_event;
+
+void privmx_endpoint_freeBuffer(privmx_buffer* buffer);
+void privmx_endpoint_freeEvent(privmx_event* event);
+
 typedef struct EventQueue EventQueue;
 
 int privmx_endpoint_newEventQueue(EventQueue** outPtr);
 int privmx_endpoint_freeEventQueue(EventQueue* ptr);
 int privmx_endpoint_execEventQueue(EventQueue* ptr, int method, const pson_value* args, pson_value** res);
+int privmx_endpoint_waitEvent(EventQueue* ptr, privmx_event* outEvent, privmx_error* error);
 
 typedef struct Connection Connection;
 typedef int (*privmx_user_verifier)(void* ctx, const pson_value* args, pson_value** res);
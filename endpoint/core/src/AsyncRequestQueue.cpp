@@ -0,0 +1,158 @@
+/*
+PrivMX Endpoint.
+Copyright © 2024 Simplito sp. z o.o.
+
+This file is part of the PrivMX Platform (https://privmx.dev).
+This software is Licensed under the PrivMX Free License.
+
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <thread>
+
+#include "privmx/endpoint/core/AsyncRequestQueue.hpp"
+#include "privmx/endpoint/core/CoreException.hpp"
+
+using namespace privmx::endpoint::core;
+
+AsyncRequestQueue::AsyncRequestQueue(const AsyncOptions& options) : _state(std::make_shared<State>()) {
+    _state->options = options;
+}
+
+AsyncRequestQueue::~AsyncRequestQueue() {
+    {
+        std::unique_lock lock(_state->mutex);
+        _state->stopping = true;
+    }
+    _state->workersCv.notify_all();
+    _state->timerCv.notify_all();
+    cancelAll();
+}
+
+void AsyncRequestQueue::setOptions(const AsyncOptions& options) {
+    {
+        std::unique_lock lock(_state->mutex);
+        _state->options = options;
+    }
+    // workers waiting for a free slot may start their tasks now
+    _state->workersCv.notify_all();
+}
+
+void AsyncRequestQueue::cancelAll() {
+    std::deque<Task> tasks;
+    {
+        std::unique_lock lock(_state->mutex);
+        tasks.swap(_state->tasks);
+    }
+    for(const auto& task : tasks) {
+        task.request->cancel();
+    }
+}
+
+void AsyncRequestQueue::push(const std::shared_ptr<AsyncRequest>& request, const std::function<void()>& run, const std::optional<int64_t>& timeout) {
+    std::unique_lock lock(_state->mutex);
+    if(_state->stopping) {
+        lock.unlock();
+        request->cancel();
+        return;
+    }
+    _state->tasks.push_back(Task{.request = request, .run = run});
+    if(timeout.has_value()) {
+        _state->deadlines.emplace(Clock::now() + std::chrono::milliseconds(timeout.value()), request);
+        if(!_state->timerStarted) {
+            _state->timerStarted = true;
+            std::thread(&AsyncRequestQueue::timerLoop, _state).detach();
+        }
+        _state->timerCv.notify_one();
+    }
+    startWorker(_state);
+    _state->workersCv.notify_one();
+}
+
+AsyncRequest::CompletionExecutor AsyncRequestQueue::getCompletionExecutor() {
+    std::unique_lock lock(_state->mutex);
+    return _state->options.completionExecutor;
+}
+
+void AsyncRequestQueue::startWorker(const std::shared_ptr<State>& state) {
+    // workers are started on demand, up to the limit of calls in flight plus the workers blocked by abandoned calls
+    if(state->tasks.size() > state->idleWorkers && state->workers < static_cast<size_t>(state->options.maxInFlightRequests) + state->abandonedTasks) {
+        state->workers++;
+        state->idleWorkers++;
+        std::thread(&AsyncRequestQueue::workerLoop, state).detach();
+    }
+}
+
+void AsyncRequestQueue::workerLoop(const std::shared_ptr<State>& state) {
+    std::unique_lock lock(state->mutex);
+    while(true) {
+        state->workersCv.wait(lock, [&]() {
+            return state->stopping || (!state->tasks.empty() && state->runningTasks < static_cast<size_t>(state->options.maxInFlightRequests));
+        });
+        if(state->stopping) {
+            break;
+        }
+        auto task = std::move(state->tasks.front());
+        state->tasks.pop_front();
+        if(task.request->isCompleted()) {
+            // cancelled or timed out while waiting in the queue
+            continue;
+        }
+        auto request = task.request;
+        state->idleWorkers--;
+        state->runningTasks++;
+        state->running.emplace(request.get(), false);
+        lock.unlock();
+        task.run();
+        task = Task();
+        lock.lock();
+        auto running = state->running.find(request.get());
+        if(running->second) {
+            state->abandonedTasks--;
+        } else {
+            state->runningTasks--;
+        }
+        state->running.erase(running);
+        state->idleWorkers++;
+        if(!state->tasks.empty()) {
+            state->workersCv.notify_one();
+        }
+    }
+    state->workers--;
+    state->idleWorkers--;
+}
+
+void AsyncRequestQueue::timerLoop(const std::shared_ptr<State>& state) {
+    std::unique_lock lock(state->mutex);
+    while(!state->stopping) {
+        if(state->deadlines.empty()) {
+            state->timerCv.wait(lock);
+            continue;
+        }
+        auto next = state->deadlines.begin();
+        if(next->first > Clock::now()) {
+            state->timerCv.wait_until(lock, next->first);
+            continue;
+        }
+        auto request = next->second.lock();
+        state->deadlines.erase(next);
+        if(request) {
+            lock.unlock();
+            bool failed = request->fail(std::make_exception_ptr(AsyncRequestTimeoutException()));
+            lock.lock();
+            auto running = state->running.find(request.get());
+            if(
+                failed && running != state->running.end() && !running->second &&
+                state->abandonedTasks < static_cast<size_t>(state->options.maxInFlightRequests)
+            ) {
+                // the call keeps its worker until the RPC returns, its slot is given to the next call
+                running->second = true;
+                state->runningTasks--;
+                state->abandonedTasks++;
+                startWorker(state);
+                state->workersCv.notify_one();
+            }
+        }
+    }
+}
@@ -111,6 +111,82 @@ void Connection::setUserVerifier(std::shared_ptr<UserVerifierInterface> verifier
     impl->setUserVerifier(verifier);
 }
 
+void Connection::setUserVerifierCacheOptions(const UserVerifierCacheOptions& options) {
+    auto impl = getImpl();
+    Validator::validateNumberNonNegative(options.ttl, "field:options.ttl ");
+    Validator::validateNumberNonNegative(options.maxEntries, "field:options.maxEntries ");
+    impl->setUserVerifierCacheOptions(options);
+}
+
+void Connection::invalidateUserVerifierCache(const std::optional<std::string>& contextId, const std::optional<std::string>& userId) {
+    auto impl = getImpl();
+    impl->invalidateUserVerifierCache(contextId, userId);
+}
+
+UserVerifierMetrics Connection::getUserVerifierMetrics() {
+    auto impl = getImpl();
+    return impl->getUserVerifierMetrics();
+}
+
+KeyCacheMetrics Connection::getKeyCacheMetrics() {
+    auto impl = getImpl();
+    return impl->getKeyCacheMetrics();
+}
+
+PerformanceMetrics Connection::getPerformanceMetrics() {
+    return ConnectionImpl::getPerformanceMetrics();
+}
+
+void Connection::resetPerformanceMetrics() {
+    ConnectionImpl::resetPerformanceMetrics();
+}
+
+void Connection::setPerformanceMetricsEnabled(bool enabled) {
+    ConnectionImpl::setPerformanceMetricsEnabled(enabled);
+}
+
+void Connection::setAsyncOptions(const AsyncOptions& options) {
+    auto impl = getImpl();
+    Validator::validateNumberPositive(options.maxInFlightRequests, "field:options.maxInFlightRequests ");
+    impl->setAsyncOptions(options);
+}
+
+void Connection::setDataCompressionOptions(const DataCompressionOptions& options) {
+    auto impl = getImpl();
+    Validator::validateNumberNonNegative(options.minSize, "field:options.minSize ");
+    Validator::validateNumberPositive(options.maxDecompressedSize, "field:options.maxDecompressedSize ");
+    impl->setDataCompressionOptions(options);
+}
+
+void Connection::setKeyChainEnabled(bool enabled) {
+    auto impl = getImpl();
+    impl->setKeyChainEnabled(enabled);
+}
+
+std::vector<ContainerMembersUpdateResult> Connection::updateContainersMembers(
+    const std::vector<ContainerMembersTarget>& targets,
+    const std::vector<UserWithPubKey>& usersToAdd,
+    const std::vector<UserWithPubKey>& managersToAdd,
+    const std::vector<std::string>& userIdsToRemove
+) {
+    auto impl = getImpl();
+    assertConnection(impl);
+    for(const auto& target : targets) {
+        Validator::validateId(target.containerId, "field:targets.containerId ");
+    }
+    Validator::validateClass<std::vector<UserWithPubKey>>(usersToAdd, "field:usersToAdd ");
+    Validator::validateClass<std::vector<UserWithPubKey>>(managersToAdd, "field:managersToAdd ");
+    for(const auto& userId : userIdsToRemove) {
+        Validator::validateId(userId, "field:userIdsToRemove ");
+    }
+    try {
+        return impl->updateContainersMembers(targets, usersToAdd, managersToAdd, userIdsToRemove);
+    } catch (const privmx::utils::PrivmxException& e) {
+        core::ExceptionConverter::rethrowAsCoreException(e);
+        throw core::Exception("ExceptionConverter rethrow error");
+    }
+}
+
 std::vector<std::string> Connection::subscribeFor(const std::vector<std::string>& subscriptionQueries) {
     auto impl = getImpl();
     assertConnection(impl);
@@ -12,8 +12,11 @@ limitations under the License.
 #include "privmx/endpoint/core/ConnectionImpl.hpp"
 
 #include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
 #include <privmx/rpc/Types.hpp>
 #include <privmx/utils/Logger.hpp>
+#include <privmx/utils/MetricsRegistry.hpp>
 #include "privmx/endpoint/core/CoreException.hpp"
 #include "privmx/endpoint/core/EventQueueImpl.hpp"
 #include "privmx/endpoint/core/Exception.hpp"
@@ -29,8 +32,20 @@ using namespace privmx::endpoint::core;
 
 ConnectionImpl::ConnectionImpl() : _connectionId(generateConnectionId()) {
     LOG_TRACE("ConnectionImpl");
-    _userVerifier = std::make_shared<core::UserVerifier>(std::make_shared<core::DefaultUserVerifierInterface>());
+    _userVerifierCacheOptions = {.ttl = UserVerifier::DEFAULT_CACHE_TTL, .maxEntries = UserVerifier::DEFAULT_CACHE_MAX_ENTRIES};
+    _userVerifier = std::make_shared<core::UserVerifier>(std::make_shared<core::DefaultUserVerifierInterface>(), _userVerifierCacheOptions);
     _guardedExecutor = std::make_shared<privmx::utils::GuardedExecutor>();
+    _containerMembersUpdater = std::make_shared<ContainerMembersUpdater>(
+        [this](const std::string& contextId, const std::vector<std::string>& userIds) {
+            return getContextUsersPubKeys(contextId, userIds, true);
+        },
+        [this](const std::string& contextId, const std::vector<UserWithPubKey>& users) {
+            return verifyContextUsersPubKeys(contextId, users);
+        }
+    );
+    _containerKeyCacheStats = std::make_shared<ContainerKeyCacheStats>();
+    _asyncRequestQueue = std::make_shared<AsyncRequestQueue>();
+    _dataCompressor = std::make_shared<DataCompressor>();
 }
 
 ConnectionImpl::~ConnectionImpl() {
@@ -235,9 +250,197 @@ PagingList<UserInfo> ConnectionImpl::listContextUsers(const std::string& context
     return result;
 }
 
+std::vector<UserWithPubKey> ConnectionImpl::getContextUsersPubKeys(const std::string& contextId, const std::vector<std::string>& userIds) {
+    return getContextUsersPubKeys(contextId, userIds, false);
+}
+
+std::vector<UserWithPubKey> ConnectionImpl::getContextUsersPubKeys(const std::string& contextId, const std::vector<std::string>& userIds, bool withReadUsers) {
+    auto buildResult = [&](const std::unordered_map<std::string, std::string>& pubKeys) {
+        std::vector<UserWithPubKey> result;
+        result.reserve(userIds.size());
+        for(const auto& userId : userIds) {
+            auto it = pubKeys.find(userId);
+            if(it == pubKeys.end()) {
+                throw ContextUserNotFoundException(userId);
+            }
+            result.push_back(UserWithPubKey{.userId = userId, .pubKey = it->second});
+        }
+        return result;
+    };
+    std::unordered_set<std::string> missing;
+    int64_t skip = 0;
+    {
+        std::unique_lock lock(_contextUsersMutex);
+        auto cached = _contextUsersPubKeys.find(contextId);
+        if(cached != _contextUsersPubKeys.end() && cached->second.expires <= std::chrono::steady_clock::now()) {
+            _contextUsersPubKeys.erase(cached);
+            cached = _contextUsersPubKeys.end();
+        }
+        for(const auto& userId : userIds) {
+            if(cached == _contextUsersPubKeys.end() || cached->second.pubKeys.find(userId) == cached->second.pubKeys.end()) {
+                missing.insert(userId);
+            }
+        }
+        if(missing.empty()) {
+            return buildResult(cached->second.pubKeys);
+        }
+        skip = cached != _contextUsersPubKeys.end() ? cached->second.scanned : 0;
+    }
+    // pages only until the missing users are found, all the users read on the way are kept for the next lookups
+    std::unordered_map<std::string, std::string> fetched;
+    int64_t start = skip;
+    server::ContextListUsersModel model;
+    model.contextId = contextId;
+    model.sortOrder = "asc";
+    model.limit = CONTEXT_USERS_PAGE_SIZE;
+    while(!missing.empty()) {
+        model.skip = skip;
+        auto response = _serverApi->contextListUsers(model);
+        for(const auto& user : response.users) {
+            fetched.insert_or_assign(user.id, user.pub);
+            missing.erase(user.id);
+        }
+        skip += response.users.size();
+        if(response.users.empty() || skip >= response.count) {
+            if(start == 0) {
+                break;
+            }
+            // users removed from the Context shift the pages, so the ones before the resumed page are read again
+            start = skip = 0;
+        }
+    }
+    std::unique_lock lock(_contextUsersMutex);
+    auto [cached, inserted] = _contextUsersPubKeys.try_emplace(contextId, ContextUsersPubKeys{
+        .pubKeys = {},
+        .scanned = 0,
+        .expires = std::chrono::steady_clock::now() + std::chrono::milliseconds(CONTEXT_USERS_CACHE_TTL)
+    });
+    for(const auto& [userId, pubKey] : fetched) {
+        cached->second.pubKeys.insert_or_assign(userId, pubKey);
+    }
+    cached->second.scanned = skip;
+    auto result = buildResult(cached->second.pubKeys);
+    if(withReadUsers) {
+        std::unordered_set<std::string> requested(userIds.begin(), userIds.end());
+        for(auto& [userId, pubKey] : fetched) {
+            if(requested.find(userId) == requested.end()) {
+                result.push_back(UserWithPubKey{.userId = userId, .pubKey = std::move(pubKey)});
+            }
+        }
+    }
+    return result;
+}
+
+std::vector<bool> ConnectionImpl::verifyContextUsersPubKeys(const std::string& contextId, const std::vector<UserWithPubKey>& users) {
+    std::vector<VerificationRequest> request;
+    request.reserve(users.size());
+    auto now = privmx::utils::Utils::getNowTimestamp();
+    for(const auto& user : users) {
+        request.push_back(VerificationRequest{
+            .contextId = contextId,
+            .senderId = user.userId,
+            .senderPubKey = user.pubKey,
+            .date = now,
+            .bridgeIdentity = _bridgeIdentity
+        });
+    }
+    return getUserVerifier()->verify(request);
+}
+
+void ConnectionImpl::invalidateContextUsersPubKeys(const std::string& contextId) {
+    std::unique_lock lock(_contextUsersMutex);
+    _contextUsersPubKeys.erase(contextId);
+}
+
+std::vector<ContainerMembersUpdateResult> ConnectionImpl::updateContainersMembers(
+    const std::vector<ContainerMembersTarget>& targets,
+    const std::vector<UserWithPubKey>& usersToAdd,
+    const std::vector<UserWithPubKey>& managersToAdd,
+    const std::vector<std::string>& userIdsToRemove
+) {
+    return _containerMembersUpdater->update(targets, usersToAdd, managersToAdd, userIdsToRemove);
+}
+
 void ConnectionImpl::setUserVerifier(std::shared_ptr<UserVerifierInterface> verifier) {
     std::unique_lock lock(_mutex);
-    _userVerifier = std::make_shared<UserVerifier>(verifier);
+    _userVerifier = std::make_shared<UserVerifier>(verifier, _userVerifierCacheOptions);
+}
+
+void ConnectionImpl::setUserVerifierCacheOptions(const UserVerifierCacheOptions& options) {
+    std::unique_lock lock(_mutex);
+    _userVerifierCacheOptions = options;
+    _userVerifier->setCacheOptions(options);
+}
+
+void ConnectionImpl::invalidateUserVerifierCache(const std::optional<std::string>& contextId, const std::optional<std::string>& userId) {
+    getUserVerifier()->invalidate(contextId, userId);
+}
+
+UserVerifierMetrics ConnectionImpl::getUserVerifierMetrics() {
+    return getUserVerifier()->getMetrics();
+}
+
+KeyCacheMetrics ConnectionImpl::getKeyCacheMetrics() {
+    return KeyCacheMetrics{
+        .cacheHits = _containerKeyCacheStats->hits,
+        .cacheMisses = _containerKeyCacheStats->misses,
+        .writeThroughUpdates = _containerKeyCacheStats->writeThroughUpdates,
+        .revalidatedEntries = _containerKeyCacheStats->revalidatedEntries,
+        .invalidatedEntries = _containerKeyCacheStats->invalidatedEntries,
+        .decryptedKeys = _keyProvider ? _keyProvider->getDecryptedKeysCount() : 0,
+        .reusedDecryptedKeys = _keyProvider ? _keyProvider->getReusedDecryptedKeysCount() : 0
+    };
+}
+
+PerformanceMetrics ConnectionImpl::getPerformanceMetrics() {
+    auto convertLatency = [](const utils::LatencyHistogram::Snapshot& latency) {
+        return LatencyMetrics{
+            .count = latency.count,
+            .totalTime = latency.total,
+            .maxTime = latency.max,
+            .p50 = latency.p50,
+            .p90 = latency.p90,
+            .p99 = latency.p99
+        };
+    };
+    auto convertQueue = [](const utils::MetricsRegistry::QueueSnapshot& queue) {
+        return QueueMetrics{.depth = queue.depth, .maxDepth = queue.maxDepth};
+    };
+    auto snapshot = utils::MetricsRegistry::getSnapshot();
+    PerformanceMetrics result {
+        .rpcMethods = {},
+        .cryptoOperations = {},
+        .executorQueue = convertQueue(snapshot.executorQueue),
+        .executorQueueWait = convertLatency(snapshot.executorQueueWait),
+        .eventQueue = convertQueue(snapshot.eventQueue)
+    };
+    for(const auto& method : snapshot.rpcMethods) {
+        result.rpcMethods.push_back(RpcMethodMetrics{.method = method.method, .errors = method.errors, .latency = convertLatency(method.latency)});
+    }
+    for(const auto& operation : snapshot.cryptoOperations) {
+        result.cryptoOperations.push_back(CryptoOperationMetrics{.operation = operation.operation, .operations = operation.operations, .bytes = operation.bytes});
+    }
+    return result;
+}
+
+void ConnectionImpl::resetPerformanceMetrics() {
+    utils::MetricsRegistry::reset();
+}
+
+void ConnectionImpl::setPerformanceMetricsEnabled(bool enabled) {
+    utils::MetricsRegistry::setEnabled(enabled);
+}
+
+void ConnectionImpl::setAsyncOptions(const AsyncOptions& options) {
+    _asyncRequestQueue->setOptions(options);
+}
+
+void ConnectionImpl::setDataCompressionOptions(const DataCompressionOptions& options) {
+    _dataCompressor->setOptions(options);
+}
+
+void ConnectionImpl::setKeyChainEnabled(bool enabled) {
+    _keyProvider->setKeyChainEnabled(enabled);
 }
 
 std::vector<std::string> ConnectionImpl::subscribeFor(const std::vector<std::string>& subscriptionQueries) {
@@ -257,6 +460,8 @@ std::string ConnectionImpl::buildSubscriptionQuery(EventType eventType, EventSel
 
 void ConnectionImpl::disconnect() {
     _eventMiddleware->removeNotificationEventListener(_notificationListenerId);
+    // queued asynchronous calls would fail anyway without the gateway
+    _asyncRequestQueue->cancelAll();
     if (!_gateway.isNull()) {
         _gateway->destroy();
     }
@@ -371,16 +576,19 @@ void ConnectionImpl::processNotificationEvent(const std::string& type, const cor
     _guardedExecutor->exec([&, type, notification]() {
         if (type == "contextUserAdded") {
             auto raw = server::ContextUserEventData::fromJSON(notification.data);
+            invalidateContextUsersPubKeys(raw.contextId);
             auto data = Mapper::mapToContextUserEventData(raw);
             auto event = EventBuilder::buildEvent<ContextUserAddedEvent>("context/userAdded", data, notification);
             _eventMiddleware->emitApiEvent(event);
         } else if (type == "contextUserRemoved") {
             auto raw = server::ContextUserEventData::fromJSON(notification.data);
+            invalidateContextUsersPubKeys(raw.contextId);
             auto data = Mapper::mapToContextUserEventData(raw);
             auto event = EventBuilder::buildEvent<ContextUserRemovedEvent>("context/userRemoved", data, notification);
             _eventMiddleware->emitApiEvent(event);
         } else if (type == "contextUserStatusChanged") {
             auto raw = server::ContextUsersStatusChangeEventData::fromJSON(notification.data);
+            invalidateContextUsersPubKeys(raw.contextId);
             auto data = Mapper::mapToContextUsersStatusChangedEventData(raw);
             auto event = EventBuilder::buildEvent<ContextUsersStatusChangedEvent>("context/userStatus", data, notification);
             _eventMiddleware->emitApiEvent(event);
@@ -13,7 +13,8 @@ limitations under the License.
 
 using namespace privmx::endpoint::core;
 
-ContainerKeyCache::ContainerKeyCache() : _storage(std::map<std::string, ContainerKeyCache::CachedModuleKeys>()) {}
+ContainerKeyCache::ContainerKeyCache(const std::shared_ptr<ContainerKeyCacheStats>& stats)
+    : _storage(std::map<std::string, ContainerKeyCache::CachedModuleKeys>()), _stats(stats) {}
 
 std::optional<ContainerKeyCache::CachedModuleKeys> ContainerKeyCache::getKeys(
     const std::string& moduleId, 
@@ -21,11 +22,14 @@ std::optional<ContainerKeyCache::CachedModuleKeys> ContainerKeyCache::getKeys(
     const std::optional<int64_t> minimumRequiredModuleSchemaVersion
 ) {
     std::optional<ContainerKeyCache::CachedModuleKeys> moduleKeys;
+    bool toRevalidate;
     {
         std::shared_lock<std::shared_mutex> lock(_mutex);
         moduleKeys = getCachedModuleKeys(moduleId);
+        toRevalidate = _toRevalidate.find(moduleId) != _toRevalidate.end();
     }
-    if(!moduleKeys.has_value()) {
+    if(!moduleKeys.has_value() || (toRevalidate && !requiredKeyIds.has_value())) {
+        _stats->misses++;
         return std::nullopt;
     }
     if(requiredKeyIds.has_value()) {
@@ -36,36 +40,84 @@ std::optional<ContainerKeyCache::CachedModuleKeys> ContainerKeyCache::getKeys(
                 keyIds.erase(key.keyId);
             }
         }
+        for (const auto& keyId : moduleKeys->keyIdsMissingOnServer) {
+            keyIds.erase(keyId);
+        }
         if(keyIds.size() != 0) {
+            _stats->misses++;
             return std::nullopt;
         }
     }
     if(requiredKeyIds.has_value() && moduleKeys->moduleSchemaVersion < minimumRequiredModuleSchemaVersion) {
+        _stats->misses++;
         return std::nullopt;
     }  
+    _stats->hits++;
     return moduleKeys;
 }
 
 void ContainerKeyCache::set(const std::string& moduleId, const CachedModuleKeys& newKeys, bool force) {
     std::unique_lock<std::shared_mutex> lock(_mutex);
-    auto moduleKeys = getCachedModuleKeys(moduleId);
-    if(moduleKeys.has_value() && moduleKeys->moduleVersion > newKeys.moduleVersion && !force) {
+    setUnlocked(moduleId, newKeys, force);
+}
+
+void ContainerKeyCache::writeThrough(const std::string& moduleId, const CachedModuleKeys& newKeys) {
+    std::unique_lock<std::shared_mutex> lock(_mutex);
+    if(setUnlocked(moduleId, newKeys, false)) {
+        _stats->writeThroughUpdates++;
+    }
+}
+
+bool ContainerKeyCache::setUnlocked(const std::string& moduleId, const CachedModuleKeys& newKeys, bool force) {
+    auto moduleKeys = _storage.find(moduleId);
+    if(moduleKeys != _storage.end() && moduleKeys->second.moduleVersion > newKeys.moduleVersion && !force) {
         // nothin to change version is older then version in cache
-        return;
+        return false;
+    }
+    if(_toRevalidate.erase(moduleId) > 0) {
+        if(moduleKeys->second.moduleVersion == newKeys.moduleVersion) {
+            // the module has not changed while disconnected, keys resolved through the key chain are still missing
+            _stats->revalidatedEntries++;
+            auto keys = newKeys;
+            keys.keyIdsMissingOnServer.insert(moduleKeys->second.keyIdsMissingOnServer.begin(), moduleKeys->second.keyIdsMissingOnServer.end());
+            moduleKeys->second = keys;
+            return true;
+        }
+        _stats->invalidatedEntries++;
     }
     _storage.insert_or_assign(
         moduleId,
         newKeys
     );
+    return true;
+}
+
+void ContainerKeyCache::setKeysMissingOnServer(const std::string& moduleId, int64_t moduleVersion, const std::set<std::string>& keyIds) {
+    std::unique_lock<std::shared_mutex> lock(_mutex);
+    auto moduleKeys = _storage.find(moduleId);
+    if(moduleKeys == _storage.end() || moduleKeys->second.moduleVersion != moduleVersion) {
+        return;
+    }
+    moduleKeys->second.keyIdsMissingOnServer.insert(keyIds.begin(), keyIds.end());
 }
 
 void ContainerKeyCache::clear(const std::optional<std::string>& moduleId) {
     std::unique_lock<std::shared_mutex> lock(_mutex);
     if(!moduleId.has_value()) {
+        _stats->invalidatedEntries += _storage.size();
         _storage.clear();
+        _toRevalidate.clear();
         return;
     }
-    _storage.erase(moduleId.value());
+    _stats->invalidatedEntries += _storage.erase(moduleId.value());
+    _toRevalidate.erase(moduleId.value());
+}
+
+void ContainerKeyCache::markForRevalidation() {
+    std::unique_lock<std::shared_mutex> lock(_mutex);
+    for(const auto& moduleKeys : _storage) {
+        _toRevalidate.insert(moduleKeys.first);
+    }
 }
 
 std::optional<ContainerKeyCache::CachedModuleKeys> ContainerKeyCache::getCachedModuleKeys(const std::string& moduleId) {
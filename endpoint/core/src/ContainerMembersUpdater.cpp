@@ -0,0 +1,181 @@
+/*
+PrivMX Endpoint.
+Copyright © 2024 Simplito sp. z o.o.
+
+This file is part of the PrivMX Platform (https://privmx.dev).
+This software is Licensed under the PrivMX Free License.
+
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <privmx/utils/ParallelFor.hpp>
+#include <privmx/utils/PrivmxException.hpp>
+
+#include "privmx/endpoint/core/ContainerMembersUpdater.hpp"
+#include "privmx/endpoint/core/CoreException.hpp"
+#include "privmx/endpoint/core/ExceptionConverter.hpp"
+
+using namespace privmx::endpoint::core;
+
+ContainerMembersUpdater::ContainerMembersUpdater(const ContextUsersPubKeysGetter& getContextUsersPubKeys, const ContextUsersPubKeysVerifier& verifyContextUsersPubKeys)
+    : _getContextUsersPubKeys(getContextUsersPubKeys), _verifyContextUsersPubKeys(verifyContextUsersPubKeys) {}
+
+int ContainerMembersUpdater::addHandler(const std::string& module, const Handler& handler) {
+    int id = _id.fetch_add(1);
+    _handlers.set(id, std::make_pair(module, handler));
+    return id;
+}
+
+void ContainerMembersUpdater::removeHandler(int id) noexcept {
+    try {
+        _handlers.erase(id);
+    } catch (...) {}
+}
+
+ContainerMembersDelta ContainerMembersUpdater::createDelta(
+    const std::vector<UserWithPubKey>& usersToAdd,
+    const std::vector<UserWithPubKey>& managersToAdd,
+    const std::vector<std::string>& userIdsToRemove
+) {
+    auto context = std::make_shared<ContextPubKeys>();
+    return ContainerMembersDelta{
+        .usersToAdd = usersToAdd,
+        .managersToAdd = managersToAdd,
+        .userIdsToRemove = userIdsToRemove,
+        .getContextUsersPubKeys = [this, context](const std::string& contextId, const std::vector<std::string>& userIds) {
+            std::unique_lock lock(context->mutex);
+            return getVerifiedPubKeys(contextId, userIds, *context);
+        }
+    };
+}
+
+std::vector<ContainerMembersUpdateResult> ContainerMembersUpdater::update(
+    const std::vector<ContainerMembersTarget>& targets,
+    const std::vector<UserWithPubKey>& usersToAdd,
+    const std::vector<UserWithPubKey>& managersToAdd,
+    const std::vector<std::string>& userIdsToRemove,
+    size_t maxConcurrentUpdates
+) {
+    std::unordered_map<std::string, Handler> handlers;
+    _handlers.forAllLockSave([&](const int&, const std::pair<std::string, Handler>& handler) {
+        handlers.insert_or_assign(handler.first, handler.second);
+    });
+    // public keys of the members staying in the containers are fetched and verified once per Context for all the
+    // containers, the workers of the same Context wait for a running fetch instead of starting their own
+    std::mutex contextsMutex;
+    std::unordered_map<std::string, ContextPubKeys> contexts;
+    ContainerMembersDelta delta {
+        .usersToAdd = usersToAdd,
+        .managersToAdd = managersToAdd,
+        .userIdsToRemove = userIdsToRemove,
+        .getContextUsersPubKeys = [&](const std::string& contextId, const std::vector<std::string>& userIds) {
+            ContextPubKeys* context;
+            {
+                std::unique_lock lock(contextsMutex);
+                context = &contexts[contextId];
+            }
+            std::unique_lock lock(context->mutex);
+            return getVerifiedPubKeys(contextId, userIds, *context);
+        }
+    };
+    std::vector<ContainerMembersUpdateResult> results(targets.size());
+    utils::ParallelFor::run(targets.size(), [&](size_t i) {
+        const auto& target = targets[i];
+        auto& result = results[i];
+        result = ContainerMembersUpdateResult{
+            .module = target.module,
+            .containerId = target.containerId,
+            .success = false,
+            .attempts = 0,
+            .errorCode = std::nullopt,
+            .errorMessage = std::nullopt
+        };
+        auto handler = handlers.find(target.module);
+        if(handler == handlers.end()) {
+            UnknownContainerModuleException e(target.module);
+            result.errorCode = e.getCode();
+            result.errorMessage = std::string(e.what()) + ": " + target.module;
+            return;
+        }
+        while(result.attempts < MAX_ATTEMPTS) {
+            result.attempts++;
+            try {
+                handler->second(target.containerId, delta);
+                result.success = true;
+                result.errorCode.reset();
+                result.errorMessage.reset();
+                return;
+            } catch (const ContainerVersionConflictException& e) {
+                result.errorCode = e.getCode();
+                result.errorMessage = e.what();
+            } catch (const Exception& e) {
+                result.errorCode = e.getCode();
+                result.errorMessage = e.what();
+                return;
+            } catch (const privmx::utils::PrivmxException& e) {
+                auto converted = ExceptionConverter::convert(e);
+                result.errorCode = converted.getCode();
+                result.errorMessage = converted.what();
+                return;
+            } catch (const std::exception& e) {
+                // not an endpoint exception, reported with the code of an unknown core error
+                result.errorCode = EndpointCoreException().getCode();
+                result.errorMessage = e.what();
+                return;
+            }
+        }
+    }, maxConcurrentUpdates);
+    return results;
+}
+
+std::vector<UserWithPubKey> ContainerMembersUpdater::getVerifiedPubKeys(
+    const std::string& contextId,
+    const std::vector<std::string>& userIds,
+    ContextPubKeys& context
+) {
+    std::vector<std::string> missing;
+    for(const auto& userId : userIds) {
+        if(context.pubKeys.find(userId) == context.pubKeys.end() && context.absent.find(userId) == context.absent.end()) {
+            missing.push_back(userId);
+        }
+    }
+    if(!missing.empty()) {
+        // the getter returns also the other users read on the way, they are kept for the next containers
+        for(auto& user : _getContextUsersPubKeys(contextId, missing)) {
+            context.pubKeys.insert_or_assign(std::move(user.userId), std::move(user.pubKey));
+        }
+        for(const auto& userId : missing) {
+            if(context.pubKeys.find(userId) == context.pubKeys.end()) {
+                context.absent.insert(userId);
+            }
+        }
+    }
+    // members who have left the Context are skipped, they cannot be given the key anyway
+    std::vector<UserWithPubKey> result;
+    std::vector<UserWithPubKey> unverified;
+    result.reserve(userIds.size());
+    for(const auto& userId : userIds) {
+        auto pubKey = context.pubKeys.find(userId);
+        if(pubKey == context.pubKeys.end()) {
+            continue;
+        }
+        result.push_back(UserWithPubKey{.userId = userId, .pubKey = pubKey->second});
+        if(context.verified.find(userId) == context.verified.end()) {
+            unverified.push_back(result.back());
+        }
+    }
+    if(!unverified.empty()) {
+        auto verified = _verifyContextUsersPubKeys(contextId, unverified);
+        for(size_t i = 0; i < unverified.size(); ++i) {
+            if(i >= verified.size() || !verified[i]) {
+                throw UserVerificationFailureException(unverified[i].userId);
+            }
+            context.verified.insert(unverified[i].userId);
+        }
+    }
+    return result;
+}
@@ -50,6 +50,38 @@ int privmx_endpoint_execEventQueue(EventQueue* ptr, int method, const pson_value
     });
 }
 
+int privmx_endpoint_waitEvent(EventQueue* ptr, privmx_event* outEvent, privmx_error* error) {
+    return CApiExecutor::execBinaryFunc(error, [&]{
+        CApiExecutor::assertNotNull(ptr, "ptr");
+        CApiExecutor::assertNotNull(outEvent, "outEvent");
+        core::EventQueueVarInterface* _ptr = (core::EventQueueVarInterface*)ptr;
+        auto event = _ptr->getApi().waitEvent();
+        OwnedBuffer type(std::string(event.type()));
+        OwnedBuffer channel(std::string(event.channel()));
+        OwnedBuffer json(event.toJSON());
+        *outEvent = privmx_event{
+            .type = type.release(),
+            .channel = channel.release(),
+            .connectionId = event.get()->connectionId,
+            .timestamp = event.get()->timestamp,
+            .json = json.release()
+        };
+    });
+}
+
+void privmx_endpoint_freeBuffer(privmx_buffer* buffer) {
+    CApiExecutor::freeBuffer(buffer);
+}
+
+void privmx_endpoint_freeEvent(privmx_event* event) {
+    if(event == nullptr) {
+        return;
+    }
+    CApiExecutor::freeBuffer(&event->type);
+    CApiExecutor::freeBuffer(&event->channel);
+    CApiExecutor::freeBuffer(&event->json);
+}
+
 int privmx_endpoint_newConnection(Connection** outPtr) {
     core::ConnectionVarInterface* ptr = new core::ConnectionVarInterface(core::VarSerializer::Options{.addType=true, .binaryFormat=core::VarSerializer::Options::PSON_BINARYSTRING});
     *outPtr = (Connection*)ptr;
@@ -14,60 +14,61 @@ limitations under the License.
 #include <privmx/crypto/Crypto.hpp>
 #include <Poco/UUID.h>
 #include <Poco/UUIDGenerator.h>
+#include <algorithm>
+#include <string_view>
+#include <unordered_set>
 
 
 using namespace privmx::endpoint::core;
 
-std::vector<privmx::endpoint::core::UserWithPubKey> EndpointUtils::uniqueListUserWithPubKey(const std::vector<core::UserWithPubKey>& list1, const std::vector<core::UserWithPubKey>& list2) {
-    std::map<std::string, core::UserWithPubKey> map;
-    for(const auto &a : list1) {
-        map[a.userId+a.pubKey] = a;
-    }
-    for(const auto &a : list2) {
-        map[a.userId+a.pubKey] = a;
+namespace {
+struct StringViewPairHash {
+    size_t operator()(const std::pair<std::string_view, std::string_view>& value) const {
+        size_t first = std::hash<std::string_view>()(value.first);
+        return first ^ (std::hash<std::string_view>()(value.second) + 0x9e3779b9 + (first << 6) + (first >> 2));
     }
+};
+} // namespace
+
+std::vector<privmx::endpoint::core::UserWithPubKey> EndpointUtils::uniqueListUserWithPubKey(const std::vector<core::UserWithPubKey>& list1, const std::vector<core::UserWithPubKey>& list2) {
+    std::unordered_set<std::pair<std::string_view, std::string_view>, StringViewPairHash> seen;
+    seen.reserve(list1.size() + list2.size());
     std::vector<core::UserWithPubKey> unique_list;
-    for(const auto &a : map) {
-        unique_list.push_back(a.second);
+    unique_list.reserve(list1.size() + list2.size());
+    for(const auto& list : {&list1, &list2}) {
+        for(const auto &a : *list) {
+            if(seen.emplace(a.userId, a.pubKey).second) {
+                unique_list.push_back(a);
+            }
+        }
     }
     return unique_list;
 }
 
-
 std::vector<std::string> EndpointUtils::getDifference(const std::vector<std::string>& baseList, const std::vector<std::string>& subList) {
-    auto vec1 {baseList};
-    auto vec2 {subList};
-    std::sort(vec1.begin(), vec1.end());
-    std::sort(vec2.begin(), vec2.end());
+    std::unordered_set<std::string_view> sub(subList.begin(), subList.end());
     std::vector<std::string> diff{};
-
-    size_t i = 0;
-    while (i < vec1.size() && i < vec2.size() && vec1[i].compare(vec2[i]) == 0) {
-        i++;
-    }
-    for (size_t n = i; n < vec1.size(); ++n) {
-        if (std::find(vec2.begin() + i, vec2.end(), vec1[n]) == vec2.end()) {
-            diff.push_back(vec1[n]);
+    for (const auto& x : baseList) {
+        if (sub.find(x) == sub.end()) {
+            diff.push_back(x);
         }
     }
     return diff;
 }
 
 std::vector<std::string> EndpointUtils::uniqueList(const std::vector<std::string> &list1, const std::vector<std::string> &list2) {
-    std::set<std::string> input{};
     std::vector<std::string> output;
-    for (auto & x : list1) {
-        input.insert(x);
-    }
-    for (auto & x : list2) {
-        input.insert(x);
-    }
-    std::copy(input.begin(), input.end(), std::back_inserter(output));
+    output.reserve(list1.size() + list2.size());
+    output.insert(output.end(), list1.begin(), list1.end());
+    output.insert(output.end(), list2.begin(), list2.end());
+    std::sort(output.begin(), output.end());
+    output.erase(std::unique(output.begin(), output.end()), output.end());
     return output;
 }
 
-std::vector<std::string> EndpointUtils::usersWithPubKeyToIds(std::vector<core::UserWithPubKey>& users) {
+std::vector<std::string> EndpointUtils::usersWithPubKeyToIds(const std::vector<core::UserWithPubKey>& users) {
     std::vector<std::string> ids{};
+    ids.reserve(users.size());
     for (auto & user : users) {
         ids.push_back(user.userId);
     }
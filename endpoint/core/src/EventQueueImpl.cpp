@@ -11,6 +11,7 @@ limitations under the License.
 
 #include "privmx/endpoint/core/EventQueueImpl.hpp"
 #include <privmx/utils/Logger.hpp>
+#include <privmx/utils/MetricsRegistry.hpp>
 
 using namespace privmx::endpoint::core;
 
@@ -30,15 +31,18 @@ void EventQueueImpl::freeInstance() {
 }
 
 void EventQueueImpl::emit(const std::shared_ptr<Event>& event) {
+    privmx::utils::MetricsRegistry::recordEventQueued();
     _queue.enqueueNotification(new Notification(event));
 }
 
 void EventQueueImpl::emitBreakEvent() {
+    privmx::utils::MetricsRegistry::recordEventQueued();
     _queue.enqueueNotification(new Notification(std::make_shared<LibBreakEvent>()));
 }
 
 EventHolder EventQueueImpl::waitEvent() {
     Poco::AutoPtr<Poco::Notification> notification(_queue.waitDequeueNotification());
+    privmx::utils::MetricsRegistry::recordEventDequeued();
     return EventHolder(dynamic_cast<Notification*>(notification.get())->data());
 }
 
@@ -46,6 +50,7 @@ std::optional<EventHolder> EventQueueImpl::getEvent() {
     Poco::AutoPtr<Poco::Notification> notification(_queue.dequeueNotification());
     auto ret {dynamic_cast<Notification*>(notification.get())};
     if (ret) {
+        privmx::utils::MetricsRegistry::recordEventDequeued();
         return EventHolder(ret->data());
     }
     else {
@@ -55,4 +60,5 @@ std::optional<EventHolder> EventQueueImpl::getEvent() {
 
 void EventQueueImpl::clear() {
     _queue.clear();
+    privmx::utils::MetricsRegistry::recordEventQueueCleared();
 }
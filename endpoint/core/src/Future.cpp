@@ -0,0 +1,81 @@
+/*
+PrivMX Endpoint.
+Copyright © 2024 Simplito sp. z o.o.
+
+This file is part of the PrivMX Platform (https://privmx.dev).
+This software is Licensed under the PrivMX Free License.
+
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <privmx/utils/Logger.hpp>
+
+#include "privmx/endpoint/core/Future.hpp"
+#include "privmx/endpoint/core/CoreException.hpp"
+
+using namespace privmx::endpoint::core;
+
+AsyncRequest::AsyncRequest(const CompletionExecutor& completionExecutor, const std::function<void(std::exception_ptr)>& setError)
+    : _completionExecutor(completionExecutor), _setError(setError) {}
+
+void AsyncRequest::cancel() {
+    fail(std::make_exception_ptr(AsyncRequestCancelledException()));
+}
+
+void AsyncRequest::addCompletionCallback(const std::function<void()>& callback) {
+    {
+        std::unique_lock lock(_mutex);
+        if(!_completed) {
+            _callbacks.push_back(callback);
+            return;
+        }
+    }
+    runCallback(callback);
+}
+
+bool AsyncRequest::isCompleted() {
+    std::unique_lock lock(_mutex);
+    return _completed;
+}
+
+bool AsyncRequest::complete(const std::function<void()>& setResult) {
+    return finish(setResult);
+}
+
+bool AsyncRequest::fail(std::exception_ptr error) {
+    return finish([&]() {
+        _setError(error);
+    });
+}
+
+bool AsyncRequest::finish(const std::function<void()>& setOutcome) {
+    std::vector<std::function<void()>> callbacks;
+    {
+        std::unique_lock lock(_mutex);
+        if(_completed) {
+            return false;
+        }
+        _completed = true;
+        setOutcome();
+        callbacks.swap(_callbacks);
+    }
+    for(const auto& callback : callbacks) {
+        runCallback(callback);
+    }
+    return true;
+}
+
+void AsyncRequest::runCallback(const std::function<void()>& callback) {
+    try {
+        if(_completionExecutor) {
+            _completionExecutor(callback);
+        } else {
+            callback();
+        }
+    } catch (const std::exception& e) {
+        LOG_ERROR("AsyncRequest completion callback thrown an exception: ", e.what())
+    } catch (...) {
+        LOG_ERROR("AsyncRequest completion callback thrown an unknown exception")
+    }
+}
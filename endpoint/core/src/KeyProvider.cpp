@@ -12,6 +12,10 @@ limitations under the License.
 #include <privmx/crypto/Crypto.hpp>
 #include <privmx/crypto/ecc/PublicKey.hpp>
 #include <privmx/crypto/EciesEncryptor.hpp>
+#include <privmx/utils/ParallelFor.hpp>
+#include <privmx/utils/Utils.hpp>
+#include <string_view>
+#include <unordered_set>
 
 #include <privmx/endpoint/core/CoreException.hpp>
 #include "privmx/endpoint/core/ExceptionConverter.hpp"
@@ -102,6 +106,16 @@ void KeyDecryptionAndVerificationRequest::addAll(
         requestData.insert(std::make_pair(location, toDecrypt));
     }
 }
+void KeyDecryptionAndVerificationRequest::addKeyChain(const ModuleKeys& moduleKeys, const EncKeyLocation& location) {
+    if(_completed) {
+        throw KeyProviderRequestCompletedException();
+    }
+    if(moduleKeys.currentData.isEmpty()) {
+        return;
+    }
+    keyChainSources.insert_or_assign(location, moduleKeys);
+}
+
 void KeyDecryptionAndVerificationRequest::markAsCompleted() {
     _completed = true;
 }
@@ -132,6 +146,25 @@ std::unordered_map<EncKeyLocation,std::unordered_map<std::string, DecryptedEncKe
         result.insert(std::make_pair(locationKeyMap.first, locationResult));
     }
     verifyUserData(result);
+    for (const auto& [location, moduleKeys] : request.keyChainSources) {
+        auto locationResult = result.find(location);
+        auto requested = request.requestData.find(location);
+        if(locationResult == result.end() || requested == request.requestData.end()) {
+            continue;
+        }
+        std::set<std::string> missingKeyIds;
+        for(const auto& [keyId, keyEntry] : requested->second) {
+            if(keyEntry.data.isEmpty()) {
+                missingKeyIds.insert(keyId);
+            }
+        }
+        if(missingKeyIds.empty()) {
+            continue;
+        }
+        for(const auto& [keyId, key] : resolveKeysFromKeyChain(moduleKeys, location, missingKeyIds)) {
+            locationResult->second.insert_or_assign(keyId, key);
+        }
+    }
     return result;
 }
 
@@ -142,11 +175,7 @@ std::vector<server::KeyEntrySet> KeyProvider::prepareKeysList(
     const EncKeyLocation& location, 
     const std::string& containerSecret
 ) {
-    std::vector<server::KeyEntrySet> result;
-    for (auto user : users) {
-        result.push_back(createKeyEntrySet(user, key, dio, location, containerSecret));
-    }    
-    return result;
+    return createKeyEntrySets(users, {{key, dio}}, location, containerSecret);
 }
 
 std::vector<server::KeyEntrySet> KeyProvider::prepareMissingKeysForNewUsers(
@@ -156,7 +185,7 @@ std::vector<server::KeyEntrySet> KeyProvider::prepareMissingKeysForNewUsers(
     const EncKeyLocation& location, 
     const std::string& containerSecret
 ) {
-    std::vector<server::KeyEntrySet> result;
+    std::vector<std::pair<EncKey, DataIntegrityObject>> keys;
     for (auto t : missingKeys) {
         auto key = t.second;
         DataIntegrityObject missingKeyDIO = dio;
@@ -166,10 +195,23 @@ std::vector<server::KeyEntrySet> KeyProvider::prepareMissingKeysForNewUsers(
             missingKeyDIO.randomId = t.second.dio.randomId;
         }
         if(key.statusCode != 0) continue;
-        for (auto user : users) {
-            result.push_back(createKeyEntrySet(user, key, missingKeyDIO, location, containerSecret));
-        }
+        keys.push_back({key, missingKeyDIO});
     }
+    return createKeyEntrySets(users, keys, location, containerSecret);
+}
+
+std::vector<server::KeyEntrySet> KeyProvider::createKeyEntrySets(
+    const std::vector<UserWithPubKey>& users,
+    const std::vector<std::pair<EncKey, DataIntegrityObject>>& keys,
+    const EncKeyLocation& location,
+    const std::string& containerSecret
+) {
+    std::vector<server::KeyEntrySet> result(keys.size() * users.size());
+    auto createEntry = [&](size_t i) {
+        const auto& [key, dio] = keys[i / users.size()];
+        result[i] = createKeyEntrySet(users[i % users.size()], key, dio, location, containerSecret);
+    };
+    utils::ParallelFor::run(result.size(), createEntry, result.size() < PARALLEL_KEY_ENTRIES_THRESHOLD ? 1 : utils::ParallelFor::MAX_THREADS);
     return result;
 }
 
@@ -192,12 +234,29 @@ server::KeyEntrySet KeyProvider::createKeyEntrySet(
             .keySecret = keySecret,
             .secretHash = privmx::crypto::Crypto::hmacSha256(containerSecret ,keySecret + location.contextId + location.resourceId)
         }, 
-        crypto::PublicKey::fromBase58DER(user.pubKey), _key
+        getPublicKey(user.pubKey), _key
     ).toJSON();
     return key_entry_set;
 }
 
 
+crypto::PublicKey KeyProvider::getPublicKey(const std::string& pubKey) {
+    {
+        std::unique_lock lock(_publicKeysMutex);
+        auto it = _publicKeys.find(pubKey);
+        if(it != _publicKeys.end()) {
+            return it->second;
+        }
+    }
+    auto result = crypto::PublicKey::fromBase58DER(pubKey);
+    std::unique_lock lock(_publicKeysMutex);
+    if(_publicKeys.size() >= MAX_CACHED_PUBLIC_KEYS) {
+        _publicKeys.clear();
+    }
+    _publicKeys.emplace(pubKey, result);
+    return result;
+}
+
 bool KeyProvider::verifyKeysSecret(const std::unordered_map<std::string, DecryptedEncKeyV2>& decryptedKeys, const EncKeyLocation& location, const std::string& containerSecret) {
     for(auto key : decryptedKeys) {
         auto keySecretHash = privmx::crypto::Crypto::hmacSha256(containerSecret, key.second.keySecret + location.contextId + location.resourceId);
@@ -211,49 +270,185 @@ bool KeyProvider::verifyKeysSecret(const std::unordered_map<std::string, Decrypt
     return true;
 }
 
-std::unordered_map<std::string, DecryptedEncKeyV2> KeyProvider::decryptAndVerifyKeys(std::unordered_map<std::string, server::KeyEntry> keys, const EncKeyLocation& location) {
+std::vector<ModuleKeyChainLink> KeyProvider::prepareKeyChain(
+    const std::vector<ModuleKeyChainLink>& currentKeyChain,
+    const std::unordered_map<std::string, DecryptedEncKeyV2>& keys,
+    const EncKey& currentKey,
+    const EncKey& newKey
+) {
+    if(!_keyChainEnabled && currentKeyChain.empty()) {
+        // the module data stays readable by older clients and new members get all the keys
+        return {};
+    }
+    std::vector<ModuleKeyChainLink> keyChain = currentKeyChain;
+    if(newKey.id != currentKey.id) {
+        keyChain.push_back(createKeyChainLink(newKey, currentKey));
+    }
+    // keys which are not in the chain yet (created before it or by older clients) are chained behind the newest key
+    std::map<std::string, EncKey> unchained;
+    for(const auto& [keyId, key] : getKeysOutsideKeyChain(keys, keyChain, newKey.id)) {
+        if(keyId != newKey.id && key.statusCode == 0) {
+            unchained.emplace(keyId, EncKey{.id=keyId, .key=key.key});
+        }
+    }
+    EncKey successor = newKey;
+    for(const auto& [keyId, key] : unchained) {
+        keyChain.push_back(createKeyChainLink(successor, key));
+        successor = key;
+    }
+    return keyChain;
+}
+
+std::unordered_map<std::string, DecryptedEncKeyV2> KeyProvider::getKeysOutsideKeyChain(
+    const std::unordered_map<std::string, DecryptedEncKeyV2>& keys,
+    const std::vector<ModuleKeyChainLink>& keyChain,
+    const std::string& newestKeyId
+) {
+    std::unordered_multimap<std::string_view, std::string_view> previousKeyIds;
+    for(const auto& link : keyChain) {
+        previousKeyIds.emplace(link.keyId, link.previousKeyId);
+    }
+    std::unordered_set<std::string_view> chained;
+    std::vector<std::string_view> toVisit {newestKeyId};
+    while(!toVisit.empty()) {
+        auto range = previousKeyIds.equal_range(toVisit.back());
+        toVisit.pop_back();
+        for(auto it = range.first; it != range.second; ++it) {
+            if(chained.insert(it->second).second) {
+                toVisit.push_back(it->second);
+            }
+        }
+    }
     std::unordered_map<std::string, DecryptedEncKeyV2> result;
-    for(auto key : keys) {
-        DecryptedEncKeyV2 decryptedEncKey;
-        decryptedEncKey.statusCode = 0;
-        if(key.second.data.type() == typeid(Poco::JSON::Object::Ptr)) {
-            dynamic::VersionedData versioned;
-            try {
-                versioned = dynamic::VersionedData::fromJSON(key.second.data);
-            } catch (const privmx::endpoint::core::Exception& e) {
-                decryptedEncKey.statusCode = e.getCode();
-                result.insert(std::make_pair(key.first, decryptedEncKey));
-                continue;
-            } catch (const privmx::utils::PrivmxException& e) {
-                decryptedEncKey.statusCode = core::ExceptionConverter::convert(e).getCode();
-                result.insert(std::make_pair(key.first, decryptedEncKey));
+    for(const auto& [keyId, key] : keys) {
+        if(chained.find(keyId) == chained.end()) {
+            result.insert(std::make_pair(keyId, key));
+        }
+    }
+    return result;
+}
+
+std::unordered_map<std::string, DecryptedEncKeyV2> KeyProvider::resolveKeysFromKeyChain(
+    const ModuleKeys& moduleKeys,
+    const EncKeyLocation& location,
+    std::set<std::string> keyIds
+) {
+    KeyDecryptionAndVerificationRequest currentKeyRequest;
+    currentKeyRequest.addOne(moduleKeys.keys, moduleKeys.currentKeyId, location);
+    std::unordered_map<EncKeyLocation,std::unordered_map<std::string, DecryptedEncKeyV2>> currentKeys;
+    currentKeys.insert(std::make_pair(location, decryptAndVerifyKeys(currentKeyRequest.requestData.at(location), location)));
+    verifyUserData(currentKeys);
+    auto currentKey = currentKeys.at(location).at(moduleKeys.currentKeyId);
+    if(currentKey.statusCode != 0) {
+        return {};
+    }
+    auto keyChain = decryptKeyChain(moduleKeys, location, currentKey);
+    if(!keyChain.has_value()) {
+        return {};
+    }
+    std::unordered_multimap<std::string_view, const ModuleKeyChainLink*> links;
+    for(const auto& link : keyChain.value()) {
+        links.emplace(link.keyId, &link);
+    }
+    // walk back from the current key, each link gives the key preceding the one which decrypts it
+    std::unordered_map<std::string, std::string> known {{moduleKeys.currentKeyId, currentKey.key}};
+    std::vector<std::string> toVisit {moduleKeys.currentKeyId};
+    std::unordered_map<std::string, DecryptedEncKeyV2> result;
+    while(!toVisit.empty() && !keyIds.empty()) {
+        auto keyId = toVisit.back();
+        toVisit.pop_back();
+        auto range = links.equal_range(keyId);
+        for(auto it = range.first; it != range.second; ++it) {
+            const auto& link = *it->second;
+            if(known.find(link.previousKeyId) != known.end()) {
                 continue;
+            }
+            std::string previousKey;
+            try {
+                previousKey = privmx::crypto::Crypto::aes256CbcHmac256Decrypt(privmx::utils::Base64::toString(link.encryptedPreviousKey), known.at(keyId));
             } catch (...) {
-                decryptedEncKey.statusCode = ENDPOINT_CORE_EXCEPTION_CODE;
-                result.insert(std::make_pair(key.first, decryptedEncKey));
                 continue;
             }
-            if(versioned.version == EncryptionKeyDataSchema::Version::VERSION_2) { 
-                DecryptedEncKeyV2 decryptedEncKey = _encKeyEncryptorV2.decrypt(
-                    server::EncryptedKeyEntryDataV2::fromJSON(key.second.data),
-                    _key
-                );
-                result.insert(std::make_pair(key.first,decryptedEncKey));
-            } else {
-                decryptedEncKey.statusCode = UnknownEncryptionKeyVersionException().getCode();
-                result.insert(std::make_pair(key.first, decryptedEncKey));
+            known.insert(std::make_pair(link.previousKeyId, previousKey));
+            toVisit.push_back(link.previousKeyId);
+            if(keyIds.erase(link.previousKeyId) > 0) {
+                // the key is as trusted as the current key and the module data holding the chain
+                DecryptedEncKeyV2 resolved = currentKey;
+                resolved.id = link.previousKeyId;
+                resolved.key = previousKey;
+                result.insert(std::make_pair(link.previousKeyId, resolved));
             }
-        } else if(key.second.data.isString()) {
-            decryptedEncKey.id = key.second.keyId;
-            decryptedEncKey.key = _encKeyEncryptorV1.decrypt(key.second.data, _key);
-            decryptedEncKey.dataStructureVersion = EncryptionKeyDataSchema::Version::VERSION_1;
-            decryptedEncKey.secretHash = "";
-            result.insert(std::make_pair(key.first, decryptedEncKey));
-        } else {
-            decryptedEncKey.statusCode = UnknownEncryptionKeyVersionException().getCode();
-            result.insert(std::make_pair(key.first, decryptedEncKey));
         }
     }
+    return result;
+}
+
+std::optional<std::vector<ModuleKeyChainLink>> KeyProvider::decryptKeyChain(
+    const ModuleKeys& moduleKeys,
+    const EncKeyLocation& location,
+    const DecryptedEncKeyV2& currentKey
+) {
+    try {
+        auto versioned = dynamic::VersionedData::fromJSON(moduleKeys.currentData);
+        if(versioned.version != ModuleDataSchema::Version::VERSION_6) {
+            return std::nullopt;
+        }
+        auto moduleData = _moduleDataEncryptorV5.decrypt(dynamic::EncryptedModuleDataV5::fromJSON(moduleKeys.currentData), currentKey.key);
+        if(moduleData.statusCode != 0 || moduleData.dio.contextId != location.contextId || moduleData.dio.resourceId != location.resourceId) {
+            return std::nullopt;
+        }
+        auto verified = _getUserVerifier()->verify({VerificationRequest{
+            .contextId = moduleData.dio.contextId,
+            .senderId = moduleData.dio.creatorUserId,
+            .senderPubKey = moduleData.dio.creatorPubKey,
+            .date = moduleData.dio.timestamp,
+            .bridgeIdentity = moduleData.dio.bridgeIdentity
+        }});
+        if(!verified[0]) {
+            return std::nullopt;
+        }
+        return moduleData.internalMeta.keyChain;
+    } catch (...) {
+        return std::nullopt;
+    }
+}
+
+ModuleKeyChainLink KeyProvider::createKeyChainLink(const EncKey& key, const EncKey& previousKey) {
+    return ModuleKeyChainLink{
+        .keyId = key.id,
+        .previousKeyId = previousKey.id,
+        .encryptedPreviousKey = privmx::utils::Base64::from(privmx::crypto::Crypto::aes256CbcHmac256Encrypt(previousKey.key, key.key))
+    };
+}
+
+std::unordered_map<std::string, DecryptedEncKeyV2> KeyProvider::decryptAndVerifyKeys(std::unordered_map<std::string, server::KeyEntry> keys, const EncKeyLocation& location) {
+    std::unordered_map<std::string, DecryptedEncKeyV2> result;
+    for(auto key : keys) {
+        if(!key.second.data.isString() && key.second.data.type() != typeid(Poco::JSON::Object::Ptr)) {
+            result.insert(std::make_pair(key.first, decryptKeyEntry(key.second)));
+            continue;
+        }
+        std::string entryData = key.second.data.isString() ? key.second.data.convert<std::string>() : privmx::utils::Utils::stringifyVar(key.second.data);
+        {
+            std::unique_lock lock(_decryptedKeysMutex);
+            auto decrypted = _decryptedKeys.find(key.second.keyId);
+            if(decrypted != _decryptedKeys.end() && decrypted->second.first == entryData) {
+                _reusedDecryptedKeysCount++;
+                result.insert(std::make_pair(key.first, decrypted->second.second));
+                continue;
+            }
+        }
+        auto decryptedEncKey = decryptKeyEntry(key.second);
+        _decryptedKeysCount++;
+        if(decryptedEncKey.statusCode == 0) {
+            std::unique_lock lock(_decryptedKeysMutex);
+            if(_decryptedKeys.size() >= MAX_CACHED_DECRYPTED_KEYS) {
+                _decryptedKeys.clear();
+            }
+            _decryptedKeys.insert_or_assign(key.second.keyId, std::make_pair(entryData, decryptedEncKey));
+        }
+        result.insert(std::make_pair(key.first, decryptedEncKey));
+    }
     verifyData(result, location);
     if(result.size() > 1) {
         verifyForDuplication(result);
@@ -261,6 +456,41 @@ std::unordered_map<std::string, DecryptedEncKeyV2> KeyProvider::decryptAndVerify
     return result;
 }
 
+DecryptedEncKeyV2 KeyProvider::decryptKeyEntry(const server::KeyEntry& keyEntry) {
+    DecryptedEncKeyV2 decryptedEncKey;
+    decryptedEncKey.statusCode = 0;
+    if(keyEntry.data.type() == typeid(Poco::JSON::Object::Ptr)) {
+        dynamic::VersionedData versioned;
+        try {
+            versioned = dynamic::VersionedData::fromJSON(keyEntry.data);
+        } catch (const privmx::endpoint::core::Exception& e) {
+            decryptedEncKey.statusCode = e.getCode();
+            return decryptedEncKey;
+        } catch (const privmx::utils::PrivmxException& e) {
+            decryptedEncKey.statusCode = core::ExceptionConverter::convert(e).getCode();
+            return decryptedEncKey;
+        } catch (...) {
+            decryptedEncKey.statusCode = ENDPOINT_CORE_EXCEPTION_CODE;
+            return decryptedEncKey;
+        }
+        if(versioned.version == EncryptionKeyDataSchema::Version::VERSION_2) { 
+            return _encKeyEncryptorV2.decrypt(
+                server::EncryptedKeyEntryDataV2::fromJSON(keyEntry.data),
+                _key
+            );
+        }
+        decryptedEncKey.statusCode = UnknownEncryptionKeyVersionException().getCode();
+    } else if(keyEntry.data.isString()) {
+        decryptedEncKey.id = keyEntry.keyId;
+        decryptedEncKey.key = _encKeyEncryptorV1.decrypt(keyEntry.data, _key);
+        decryptedEncKey.dataStructureVersion = EncryptionKeyDataSchema::Version::VERSION_1;
+        decryptedEncKey.secretHash = "";
+    } else {
+        decryptedEncKey.statusCode = UnknownEncryptionKeyVersionException().getCode();
+    }
+    return decryptedEncKey;
+}
+
 void KeyProvider::verifyData(std::unordered_map<std::string, DecryptedEncKeyV2>& decryptedKeys, const EncKeyLocation& location) {
     //create data validation request
     for(auto it = decryptedKeys.begin(); it != decryptedKeys.end(); ++it) {
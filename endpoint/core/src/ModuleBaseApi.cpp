@@ -37,7 +37,9 @@ ModuleBaseApi::ModuleBaseApi(
     _keyProvider(keyProvider),
     _host(host),
     _eventMiddleware(eventMiddleware),
-    _connection(connection) {}
+    _connection(connection),
+    _keyCache(connection.getImpl()->getContainerKeyCacheStats()),
+    _asyncRequestQueue(connection.getImpl()->getAsyncRequestQueue()) {}
 
 DecryptedEncKeyV2 ModuleBaseApi::findEncKeyByKeyId(std::unordered_map<std::string, DecryptedEncKeyV2> keys, const std::string& keyId) {
     for (auto key : keys) {
@@ -63,7 +65,19 @@ ModuleKeys ModuleBaseApi::getModuleKeys(
     auto keys = _keyCache.getKeys(moduleId, keyIds, minimumSchemaVersion);
     // if cache don't have decryption keys 
     if(!keys.has_value()) {
-        return getNewModuleKeysAndUpdateCache(moduleId);
+        auto moduleKeysAndVersion = getSharedModuleKeysAndVersionFromServer(moduleId);
+        _keyCache.set(moduleId, convertModuleKeysToContainerKeyCacheFormat(moduleKeysAndVersion.first, moduleKeysAndVersion.second));
+        if(keyIds.has_value()) {
+            // keys still missing after the refresh are resolved through the key chain, the refresh won't help next time
+            std::set<std::string> missingKeyIds = keyIds.value();
+            for(const auto& key : moduleKeysAndVersion.first.keys) {
+                missingKeyIds.erase(key.keyId);
+            }
+            if(!missingKeyIds.empty()) {
+                _keyCache.setKeysMissingOnServer(moduleId, moduleKeysAndVersion.second, missingKeyIds);
+            }
+        }
+        return moduleKeysAndVersion.first;
     }
     return convertContainerKeyCacheModuleKeysToModuleApiFormat(keys.value());
 }
@@ -73,10 +87,41 @@ void ModuleBaseApi::setNewModuleKeysInCache(const std::string& moduleId, const M
     _keyCache.set(moduleId, keys);
 }
 
+void ModuleBaseApi::writeThroughModuleKeysInCache(
+    const std::string& moduleId,
+    ModuleKeys moduleKeys,
+    const std::vector<server::KeyEntrySet>& newKeys,
+    const std::string& userId,
+    int64_t moduleVersion
+) {
+    std::set<std::string> keyIds;
+    for(const auto& key : moduleKeys.keys) {
+        keyIds.insert(key.keyId);
+    }
+    for(const auto& key : newKeys) {
+        if(key.user == userId && keyIds.insert(key.keyId).second) {
+            server::KeyEntry keyEntry;
+            keyEntry.keyId = key.keyId;
+            keyEntry.data = key.data;
+            moduleKeys.keys.push_back(keyEntry);
+        }
+    }
+    if(keyIds.find(moduleKeys.currentKeyId) == keyIds.end()) {
+        // the user is no longer a member of the module
+        _keyCache.clear(moduleId);
+        return;
+    }
+    _keyCache.writeThrough(moduleId, convertModuleKeysToContainerKeyCacheFormat(moduleKeys, moduleVersion));
+}
+
 void ModuleBaseApi::invalidateModuleKeysInCache(const std::optional<std::string>& moduleId) {
     _keyCache.clear(moduleId);
 }
 
+void ModuleBaseApi::revalidateModuleKeysInCache() {
+    _keyCache.markForRevalidation();
+}
+
 ModuleKeys ModuleBaseApi::getNewModuleKeysAndUpdateCache(const std::string& moduleId) {
     // get newest module
     PRIVMX_DEBUG("PlatformModule", "getNewModuleKeysAndUpdateCache")
@@ -86,6 +131,36 @@ ModuleKeys ModuleBaseApi::getNewModuleKeysAndUpdateCache(const std::string& modu
     return moduleKeys.first;
 }
 
+std::pair<ModuleKeys, int64_t> ModuleBaseApi::getSharedModuleKeysAndVersionFromServer(const std::string& moduleId) {
+    std::promise<std::pair<ModuleKeys, int64_t>> promise;
+    {
+        std::unique_lock lock(_moduleKeysRequestsMutex);
+        auto request = _moduleKeysRequests.find(moduleId);
+        if(request != _moduleKeysRequests.end()) {
+            auto future = request->second;
+            lock.unlock();
+            return future.get();
+        }
+        _moduleKeysRequests.emplace(moduleId, promise.get_future().share());
+    }
+    try {
+        auto result = getModuleKeysAndVersionFromServer(moduleId);
+        {
+            std::unique_lock lock(_moduleKeysRequestsMutex);
+            _moduleKeysRequests.erase(moduleId);
+        }
+        promise.set_value(result);
+        return result;
+    } catch (...) {
+        {
+            std::unique_lock lock(_moduleKeysRequestsMutex);
+            _moduleKeysRequests.erase(moduleId);
+        }
+        promise.set_exception(std::current_exception());
+        throw;
+    }
+}
+
 core::ContainerKeyCache::CachedModuleKeys ModuleBaseApi::convertModuleKeysToContainerKeyCacheFormat(const ModuleKeys& moduleKeys, int64_t moduleVersion) {
     return core::ContainerKeyCache::CachedModuleKeys{
         .keys=moduleKeys.keys,
@@ -93,7 +168,9 @@ core::ContainerKeyCache::CachedModuleKeys ModuleBaseApi::convertModuleKeysToCont
         .moduleSchemaVersion=moduleKeys.moduleSchemaVersion,
         .moduleResourceId=moduleKeys.moduleResourceId,
         .contextId = moduleKeys.contextId,
-        .moduleVersion = moduleVersion
+        .moduleVersion = moduleVersion,
+        .currentData = moduleKeys.currentData,
+        .keyIdsMissingOnServer = {}
     };
 }
 
@@ -103,6 +180,7 @@ ModuleKeys ModuleBaseApi::convertContainerKeyCacheModuleKeysToModuleApiFormat(co
         .currentKeyId=moduleKeys.currentKeyId,
         .moduleSchemaVersion=moduleKeys.moduleSchemaVersion,
         .moduleResourceId=moduleKeys.moduleResourceId,
-        .contextId = moduleKeys.contextId
+        .contextId = moduleKeys.contextId,
+        .currentData = moduleKeys.currentData
     };
 }
\ No newline at end of file
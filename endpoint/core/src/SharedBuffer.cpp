@@ -0,0 +1,77 @@
+/*
+PrivMX Endpoint.
+Copyright © 2024 Simplito sp. z o.o.
+
+This file is part of the PrivMX Platform (https://privmx.dev).
+This software is Licensed under the PrivMX Free License.
+
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "privmx/endpoint/core/SharedBuffer.hpp"
+
+using namespace privmx::endpoint::core;
+
+struct SharedBuffer::Storage {
+    std::string string;
+    std::vector<uint8_t> vector;
+    std::function<void()> release;
+
+    ~Storage() {
+        if (release) {
+            release();
+        }
+    }
+};
+
+SharedBuffer SharedBuffer::from(std::string&& str) {
+    SharedBuffer result;
+    result._storage = std::make_shared<Storage>();
+    result._storage->string = std::move(str);
+    result._data = result._storage->string.data();
+    result._size = result._storage->string.size();
+    return result;
+}
+
+SharedBuffer SharedBuffer::from(std::vector<uint8_t>&& data) {
+    SharedBuffer result;
+    result._storage = std::make_shared<Storage>();
+    result._storage->vector = std::move(data);
+    result._data = reinterpret_cast<const char*>(result._storage->vector.data());
+    result._size = result._storage->vector.size();
+    return result;
+}
+
+SharedBuffer SharedBuffer::adopt(const char* data, std::size_t size, std::function<void()> release) {
+    SharedBuffer result;
+    result._storage = std::make_shared<Storage>();
+    result._storage->release = std::move(release);
+    result._data = data;
+    result._size = size;
+    return result;
+}
+
+SharedBuffer SharedBuffer::slice(std::size_t offset, std::size_t length) const {
+    if (offset > _size) {
+        throw std::out_of_range("SharedBuffer::slice");
+    }
+    SharedBuffer result;
+    result._storage = _storage;
+    result._data = _data + offset;
+    result._size = std::min(length, _size - offset);
+    return result;
+}
+
+Buffer SharedBuffer::toBuffer() && {
+    // nothing else can see the string, so it is handed over as is
+    if (_storage && _storage.use_count() == 1 && _data == _storage->string.data() && _size == _storage->string.size()) {
+        Buffer result = Buffer::from(std::move(_storage->string));
+        *this = SharedBuffer();
+        return result;
+    }
+    return Buffer::from(data(), size());
+}
@@ -153,4 +153,14 @@ std::optional<std::string> Subscriber::getSubscriptionQuery(const std::vector<st
         }
     }
     return std::nullopt;
-}
\ No newline at end of file
+}
+
+bool Subscriber::hasSubscriptionForChannel(const std::string& channel) {
+    std::shared_lock<std::shared_mutex> lock(_map_mutex);
+    for(auto& s: _subscriptionIdToSubscriptionQuery) {
+        if(s.second == channel) {
+            return true;
+        }
+    }
+    return false;
+}
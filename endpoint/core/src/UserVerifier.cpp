@@ -9,22 +9,223 @@ See the License for the specific language governing permissions and
 limitations under the License.
 */
 
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
 #include "privmx/endpoint/core/UserVerifier.hpp"
 #include "privmx/endpoint/core/CoreException.hpp"
 
 using namespace privmx::endpoint::core;
 
-UserVerifier::UserVerifier(std::shared_ptr<UserVerifierInterface> userVerifier) : _userVerifier(userVerifier) {}
+UserVerifier::UserVerifier(std::shared_ptr<UserVerifierInterface> userVerifier, const UserVerifierCacheOptions& cacheOptions)
+    : _userVerifier(userVerifier), _cacheOptions(cacheOptions) {}
 
 std::vector<bool> UserVerifier::verify(const std::vector<VerificationRequest>& request) {
+    std::vector<bool> result(request.size(), false);
+    std::vector<std::string> keys;
+    std::unordered_map<std::string, PendingKey> pending;
+    std::vector<std::string> pendingOrder;
+    int64_t cacheHits = 0;
+    keys.reserve(request.size());
+    for(size_t i = 0; i < request.size(); ++i) {
+        keys.push_back(cacheKey(request[i]));
+        if(isCachedValid(keys[i], request[i].date)) {
+            result[i] = true;
+            cacheHits++;
+            continue;
+        }
+        auto [it, inserted] = pending.try_emplace(keys[i], PendingKey{.items = {}, .first = i, .last = i});
+        if(inserted) {
+            pendingOrder.push_back(keys[i]);
+        }
+        auto& key = it->second;
+        key.items.push_back(i);
+        if(request[i].date < request[key.first].date) {
+            key.first = i;
+        }
+        if(request[i].date > request[key.last].date) {
+            key.last = i;
+        }
+    }
+    {
+        std::unique_lock lock(_mutex);
+        _metrics.requestedItems += request.size();
+        _metrics.cacheHits += cacheHits;
+    }
+    if(pending.empty()) {
+        return result;
+    }
+    // the earliest and the latest date of each key
+    std::vector<VerificationRequest> rangeRequest;
+    for(const auto& keyName : pendingOrder) {
+        const auto& key = pending.at(keyName);
+        rangeRequest.push_back(request[key.first]);
+        if(request[key.last].date != request[key.first].date) {
+            rangeRequest.push_back(request[key.last]);
+        }
+    }
+    auto rangeResult = callVerifier(rangeRequest);
+    // dates of the keys not valid at both ends of their range, each distinct date is sent once
+    std::vector<size_t> single;
+    std::unordered_map<std::string, size_t> singleIndex;
+    std::vector<std::pair<size_t, size_t>> singleItems;
+    size_t r = 0;
+    for(const auto& keyName : pendingOrder) {
+        const auto& key = pending.at(keyName);
+        int64_t firstDate = request[key.first].date;
+        int64_t lastDate = request[key.last].date;
+        bool firstValid = rangeResult[r++];
+        bool lastValid = lastDate != firstDate ? static_cast<bool>(rangeResult[r++]) : firstValid;
+        if(firstValid) {
+            storeValid(keyName, request[key.first]);
+        }
+        if(lastValid) {
+            storeValid(keyName, request[key.last]);
+        }
+        for(auto i : key.items) {
+            if(firstValid && lastValid) {
+                result[i] = true;
+            } else if(request[i].date == firstDate) {
+                result[i] = firstValid;
+            } else if(request[i].date == lastDate) {
+                result[i] = lastValid;
+            } else {
+                auto [it, inserted] = singleIndex.try_emplace(keyName + '\0' + std::to_string(request[i].date), single.size());
+                if(inserted) {
+                    single.push_back(i);
+                }
+                singleItems.push_back({i, it->second});
+            }
+        }
+    }
+    if(!single.empty()) {
+        std::vector<VerificationRequest> singleRequest;
+        singleRequest.reserve(single.size());
+        for(auto i : single) {
+            singleRequest.push_back(request[i]);
+        }
+        auto singleResult = callVerifier(singleRequest);
+        for(size_t j = 0; j < single.size(); ++j) {
+            if(singleResult[j]) {
+                storeValid(keys[single[j]], request[single[j]]);
+            }
+        }
+        for(const auto& [i, j] : singleItems) {
+            result[i] = singleResult[j];
+        }
+    }
+    return result;
+}
+
+void UserVerifier::setCacheOptions(const UserVerifierCacheOptions& cacheOptions) {
+    std::unique_lock lock(_mutex);
+    _cacheOptions = cacheOptions;
+    _cache.clear();
+    _lru.clear();
+}
+
+void UserVerifier::invalidate(const std::optional<std::string>& contextId, const std::optional<std::string>& userId) {
+    std::unique_lock lock(_mutex);
+    for(auto it = _cache.begin(); it != _cache.end();) {
+        const CacheEntry& entry = it->second;
+        if((!contextId.has_value() || entry.contextId == contextId.value()) && (!userId.has_value() || entry.userId == userId.value())) {
+            _lru.erase(entry.lruPosition);
+            it = _cache.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+UserVerifierMetrics UserVerifier::getMetrics() {
+    std::unique_lock lock(_mutex);
+    return _metrics;
+}
+
+std::string UserVerifier::cacheKey(const VerificationRequest& request) {
+    std::string key;
+    key.append(request.contextId).push_back('\0');
+    key.append(request.senderId).push_back('\0');
+    key.append(request.senderPubKey);
+    if(request.bridgeIdentity.has_value()) {
+        const auto& bridge = request.bridgeIdentity.value();
+        key.push_back('\0');
+        key.append(bridge.url).push_back('\0');
+        key.append(bridge.pubKey.has_value() ? "1" + bridge.pubKey.value() : "0").push_back('\0');
+        key.append(bridge.instanceId.has_value() ? "1" + bridge.instanceId.value() : "0");
+    }
+    return key;
+}
+
+bool UserVerifier::isCachedValid(const std::string& key, int64_t date) {
+    std::unique_lock lock(_mutex);
+    auto it = _cache.find(key);
+    if(it == _cache.end()) {
+        return false;
+    }
+    if(it->second.expires <= std::chrono::steady_clock::now()) {
+        erase(key);
+        return false;
+    }
+    _lru.splice(_lru.begin(), _lru, it->second.lruPosition);
+    return it->second.validFrom <= date && date <= it->second.validTo;
+}
+
+std::vector<bool> UserVerifier::callVerifier(const std::vector<VerificationRequest>& request) {
     std::vector<bool> result;
+    auto start = std::chrono::steady_clock::now();
     try {
         result = _userVerifier->verify(request);
     } catch (...) {
         throw core::UserVerificationMethodUnhandledException();
     }
+    int64_t time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    {
+        std::unique_lock lock(_mutex);
+        _metrics.verifierCalls += 1;
+        _metrics.verifierItems += request.size();
+        _metrics.verifierTime += time;
+        _metrics.maxVerifierTime = std::max(_metrics.maxVerifierTime, time);
+    }
     if(result.size() != request.size()) {
         throw MalformedVerifierResponseException("VerificationResult size is " + std::to_string(result.size()) + " which is different from VerificationRequest size" + std::to_string(request.size()));
     }
     return result;
-};
\ No newline at end of file
+}
+
+void UserVerifier::storeValid(const std::string& key, const VerificationRequest& request) {
+    std::unique_lock lock(_mutex);
+    if(_cacheOptions.ttl <= 0 || _cacheOptions.maxEntries <= 0) {
+        return;
+    }
+    auto it = _cache.find(key);
+    if(it != _cache.end() && it->second.expires > std::chrono::steady_clock::now()) {
+        // the key is valid over one period, so it covers every date between the verified ones
+        it->second.validFrom = std::min(it->second.validFrom, request.date);
+        it->second.validTo = std::max(it->second.validTo, request.date);
+        _lru.splice(_lru.begin(), _lru, it->second.lruPosition);
+        return;
+    }
+    erase(key);
+    _lru.push_front(key);
+    _cache.emplace(key, CacheEntry{
+        .contextId = request.contextId,
+        .userId = request.senderId,
+        .expires = std::chrono::steady_clock::now() + std::chrono::milliseconds(_cacheOptions.ttl),
+        .validFrom = request.date,
+        .validTo = request.date,
+        .lruPosition = _lru.begin()
+    });
+    while(_cache.size() > static_cast<size_t>(_cacheOptions.maxEntries)) {
+        erase(_lru.back());
+    }
+}
+
+void UserVerifier::erase(const std::string& key) {
+    auto it = _cache.find(key);
+    if(it != _cache.end()) {
+        _lru.erase(it->second.lruPosition);
+        _cache.erase(it);
+    }
+}
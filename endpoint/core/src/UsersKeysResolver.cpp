@@ -11,6 +11,9 @@ limitations under the License.
 
 #include "privmx/endpoint/core/UsersKeysResolver.hpp"
 
+#include <string_view>
+#include <unordered_set>
+
 using namespace privmx::endpoint::core;
 
 std::shared_ptr<UsersKeysResolver> UsersKeysResolver::create(
@@ -26,6 +29,20 @@ std::shared_ptr<UsersKeysResolver> UsersKeysResolver::create(
     return instance;
 }
 
+std::shared_ptr<UsersKeysResolver> UsersKeysResolver::createFromDelta(
+        const std::vector<std::string>& currentUserIds,
+        const std::vector<std::string>& currentManagerIds,
+        const std::vector<core::UserWithPubKey>& usersToAdd,
+        const std::vector<core::UserWithPubKey>& managersToAdd,
+        const std::vector<std::string>& userIdsToRemove,
+        const DecryptedEncKeyV2& moduleCurrentKey,
+        const UsersPubKeysGetter& getUsersPubKeys
+) {
+    auto instance = std::make_shared<UsersKeysResolver>();
+    instance->initFromDelta(currentUserIds, currentManagerIds, usersToAdd, managersToAdd, userIdsToRemove, moduleCurrentKey, getUsersPubKeys);
+    return instance;
+}
+
 void UsersKeysResolver::init(
         const std::vector<std::string>& currentUserIds,
         const std::vector<std::string>& currentManagerIds,
@@ -34,23 +51,110 @@ void UsersKeysResolver::init(
         const bool forceGenerateNewKey,
         const DecryptedEncKeyV2& moduleCurrentKey
 ) {
-    auto oldUsersIds {core::EndpointUtils::uniqueList(currentUserIds, currentManagerIds)};
-
+    _userIds = core::EndpointUtils::usersWithPubKeyToIds(users);
+    _managerIds = core::EndpointUtils::usersWithPubKeyToIds(managers);
     _new_users = core::EndpointUtils::uniqueListUserWithPubKey(users, managers);
-    auto newUsersIds {core::EndpointUtils::usersWithPubKeyToIds(_new_users)};
-    auto deletedUsersIds {core::EndpointUtils::getDifference(oldUsersIds, newUsersIds)};
-    auto addedUsersIds {core::EndpointUtils::getDifference(newUsersIds, oldUsersIds)};
+    std::unordered_set<std::string_view> oldUsersIds(currentUserIds.begin(), currentUserIds.end());
+    oldUsersIds.insert(currentManagerIds.begin(), currentManagerIds.end());
+    std::unordered_set<std::string_view> newUsersIds;
+    newUsersIds.reserve(_new_users.size());
+    for(const auto& user : _new_users) {
+        newUsersIds.insert(user.userId);
+    }
 
     if(moduleCurrentKey.dataStructureVersion < 2) {
         _usersToAddMissingKey = _new_users;
     } else {
-        for(auto new_user: _new_users) {
-            if( std::find(addedUsersIds.begin(), addedUsersIds.end(), new_user.userId) != addedUsersIds.end()) {
+        for(const auto& new_user: _new_users) {
+            if(oldUsersIds.find(new_user.userId) == oldUsersIds.end()) {
                 _usersToAddMissingKey.push_back(new_user);
             }
         }
     }
-    _needNewKey = deletedUsersIds.size() > 0 || forceGenerateNewKey;
+    bool usersDeleted = std::any_of(oldUsersIds.begin(), oldUsersIds.end(), [&](const std::string_view& userId) {
+        return newUsersIds.find(userId) == newUsersIds.end();
+    });
+    _needNewKey = usersDeleted || forceGenerateNewKey;
+}
+
+void UsersKeysResolver::initFromDelta(
+        const std::vector<std::string>& currentUserIds,
+        const std::vector<std::string>& currentManagerIds,
+        const std::vector<core::UserWithPubKey>& usersToAdd,
+        const std::vector<core::UserWithPubKey>& managersToAdd,
+        const std::vector<std::string>& userIdsToRemove,
+        const DecryptedEncKeyV2& moduleCurrentKey,
+        const UsersPubKeysGetter& getUsersPubKeys
+) {
+    std::unordered_set<std::string_view> removed(userIdsToRemove.begin(), userIdsToRemove.end());
+    std::unordered_set<std::string_view> oldUsersIds(currentUserIds.begin(), currentUserIds.end());
+    oldUsersIds.insert(currentManagerIds.begin(), currentManagerIds.end());
+    auto applyDelta = [&](const std::vector<std::string>& current, const std::vector<core::UserWithPubKey>& toAdd) {
+        std::vector<std::string> result;
+        result.reserve(current.size() + toAdd.size());
+        std::unordered_set<std::string_view> present;
+        present.reserve(current.size() + toAdd.size());
+        for(const auto& userId : current) {
+            if(removed.find(userId) == removed.end() && present.insert(userId).second) {
+                result.push_back(userId);
+            }
+        }
+        for(const auto& user : toAdd) {
+            if(present.insert(user.userId).second) {
+                result.push_back(user.userId);
+            }
+        }
+        return result;
+    };
+    _userIds = applyDelta(currentUserIds, usersToAdd);
+    _managerIds = applyDelta(currentManagerIds, managersToAdd);
+
+    auto newUsersIds {core::EndpointUtils::uniqueList(_userIds, _managerIds)};
+    std::unordered_set<std::string_view> newUsersIdsSet(newUsersIds.begin(), newUsersIds.end());
+    _needNewKey = std::any_of(oldUsersIds.begin(), oldUsersIds.end(), [&](const std::string_view& userId) {
+        return newUsersIdsSet.find(userId) == newUsersIdsSet.end();
+    });
+
+    auto addedUsers {core::EndpointUtils::uniqueListUserWithPubKey(usersToAdd, managersToAdd)};
+    std::vector<core::UserWithPubKey> usersWithNewAccess;
+    for(const auto& user : addedUsers) {
+        if(oldUsersIds.find(user.userId) == oldUsersIds.end()) {
+            usersWithNewAccess.push_back(user);
+        }
+    }
+    if(_needNewKey || moduleCurrentKey.dataStructureVersion < 2) {
+        // every member gets the key, the public keys of the members kept from before are not known yet
+        std::unordered_set<std::string_view> known;
+        for(const auto& user : addedUsers) {
+            if(newUsersIdsSet.find(user.userId) != newUsersIdsSet.end()) {
+                known.insert(user.userId);
+                _new_users.push_back(user);
+            }
+        }
+        std::vector<std::string> unknownIds;
+        for(const auto& userId : newUsersIds) {
+            if(known.find(userId) == known.end()) {
+                unknownIds.push_back(userId);
+            }
+        }
+        if(!unknownIds.empty()) {
+            auto resolved = getUsersPubKeys(unknownIds);
+            // members who have left the Context are not returned, they are dropped as they cannot get the key
+            std::unordered_set<std::string_view> left(unknownIds.begin(), unknownIds.end());
+            for(const auto& user : resolved) {
+                left.erase(user.userId);
+            }
+            if(!left.empty()) {
+                auto hasLeft = [&](const std::string& userId) { return left.find(userId) != left.end(); };
+                _userIds.erase(std::remove_if(_userIds.begin(), _userIds.end(), hasLeft), _userIds.end());
+                _managerIds.erase(std::remove_if(_managerIds.begin(), _managerIds.end(), hasLeft), _managerIds.end());
+            }
+            _new_users.insert(_new_users.end(), resolved.begin(), resolved.end());
+        }
+    } else {
+        _new_users = addedUsers;
+    }
+    _usersToAddMissingKey = moduleCurrentKey.dataStructureVersion < 2 ? _new_users : usersWithNewAccess;
 }
 
 std::vector<UserWithPubKey> UsersKeysResolver::getUsersToAddKey() {
@@ -64,3 +168,11 @@ std::vector<UserWithPubKey> UsersKeysResolver::getNewUsers() {
 bool UsersKeysResolver::doNeedNewKey() {
     return _needNewKey;
 }
+
+const std::vector<std::string>& UsersKeysResolver::getUserIds() {
+    return _userIds;
+}
+
+const std::vector<std::string>& UsersKeysResolver::getManagerIds() {
+    return _managerIds;
+}
@@ -215,6 +215,12 @@ void Validator::validateBufferSize(const core::Buffer& value,size_t min_len, siz
     }
 }
 
+void Validator::validateDataFields(int64_t value, const std::string& stack_trace) {
+    if((value & ~int64_t(DataField::ALL_DATA_FIELDS)) != 0) {
+        throw InvalidParamsException(stack_trace + " | " + ("Invalid DataField bitmask, received " + to_string(value)));
+    }
+}
+
 void Validator::validateJSON(const std::string& value, const std::string& stack_trace) {
     try {
         privmx::utils::Utils::parseJson(value);
@@ -134,6 +134,37 @@ PKIVerificationOptions VarDeserializer::deserialize<PKIVerificationOptions>(cons
     return result;
 }
 
+template<>
+UserVerifierCacheOptions VarDeserializer::deserialize<UserVerifierCacheOptions>(const Poco::Dynamic::Var& val, const std::string& name) {
+    TypeValidator::validateObject(val, name);
+    Poco::JSON::Object::Ptr obj = val.extract<Poco::JSON::Object::Ptr>();
+    return {
+        .ttl = deserialize<int64_t>(obj->get("ttl"), name + ".ttl"),
+        .maxEntries = deserialize<int64_t>(obj->get("maxEntries"), name + ".maxEntries")
+    };
+}
+
+template<>
+ContainerMembersTarget VarDeserializer::deserialize<ContainerMembersTarget>(const Poco::Dynamic::Var& val, const std::string& name) {
+    TypeValidator::validateObject(val, name);
+    Poco::JSON::Object::Ptr obj = val.extract<Poco::JSON::Object::Ptr>();
+    return {
+        .module = deserialize<std::string>(obj->get("module"), name + ".module"),
+        .containerId = deserialize<std::string>(obj->get("containerId"), name + ".containerId")
+    };
+}
+
+template<>
+DataCompressionOptions VarDeserializer::deserialize<DataCompressionOptions>(const Poco::Dynamic::Var& val, const std::string& name) {
+    TypeValidator::validateObject(val, name);
+    Poco::JSON::Object::Ptr obj = val.extract<Poco::JSON::Object::Ptr>();
+    return {
+        .enabled = deserialize<bool>(obj->get("enabled"), name + ".enabled"),
+        .minSize = deserialize<int64_t>(obj->get("minSize"), name + ".minSize"),
+        .maxDecompressedSize = deserialize<int64_t>(obj->get("maxDecompressedSize"), name + ".maxDecompressedSize")
+    };
+}
+
 template<>
 EventType VarDeserializer::deserialize<EventType>(const Poco::Dynamic::Var& val, const std::string& name) {
     switch (val.convert<int64_t>()) {
@@ -309,3 +309,113 @@ Poco::Dynamic::Var VarSerializer::serialize<VerificationRequest>(const Verificat
     obj->set("bridgeIdentity", serialize(val.bridgeIdentity));
     return obj;
 }
+
+template<>
+Poco::Dynamic::Var VarSerializer::serialize<UserVerifierMetrics>(const UserVerifierMetrics& val) {
+    Poco::JSON::Object::Ptr obj = new Poco::JSON::Object();
+    if (_options.addType) {
+        obj->set("__type", "core$UserVerifierMetrics");
+    }
+    obj->set("requestedItems", serialize(val.requestedItems));
+    obj->set("cacheHits", serialize(val.cacheHits));
+    obj->set("verifierCalls", serialize(val.verifierCalls));
+    obj->set("verifierItems", serialize(val.verifierItems));
+    obj->set("verifierTime", serialize(val.verifierTime));
+    obj->set("maxVerifierTime", serialize(val.maxVerifierTime));
+    return obj;
+}
+
+template<>
+Poco::Dynamic::Var VarSerializer::serialize<ContainerMembersUpdateResult>(const ContainerMembersUpdateResult& val) {
+    Poco::JSON::Object::Ptr obj = new Poco::JSON::Object();
+    if (_options.addType) {
+        obj->set("__type", "core$ContainerMembersUpdateResult");
+    }
+    obj->set("module", serialize(val.module));
+    obj->set("containerId", serialize(val.containerId));
+    obj->set("success", serialize(val.success));
+    obj->set("attempts", serialize(val.attempts));
+    obj->set("errorCode", serialize(val.errorCode));
+    obj->set("errorMessage", serialize(val.errorMessage));
+    return obj;
+}
+
+template<>
+Poco::Dynamic::Var VarSerializer::serialize<KeyCacheMetrics>(const KeyCacheMetrics& val) {
+    Poco::JSON::Object::Ptr obj = new Poco::JSON::Object();
+    if (_options.addType) {
+        obj->set("__type", "core$KeyCacheMetrics");
+    }
+    obj->set("cacheHits", serialize(val.cacheHits));
+    obj->set("cacheMisses", serialize(val.cacheMisses));
+    obj->set("writeThroughUpdates", serialize(val.writeThroughUpdates));
+    obj->set("revalidatedEntries", serialize(val.revalidatedEntries));
+    obj->set("invalidatedEntries", serialize(val.invalidatedEntries));
+    obj->set("decryptedKeys", serialize(val.decryptedKeys));
+    obj->set("reusedDecryptedKeys", serialize(val.reusedDecryptedKeys));
+    return obj;
+}
+
+template<>
+Poco::Dynamic::Var VarSerializer::serialize<LatencyMetrics>(const LatencyMetrics& val) {
+    Poco::JSON::Object::Ptr obj = new Poco::JSON::Object();
+    if (_options.addType) {
+        obj->set("__type", "core$LatencyMetrics");
+    }
+    obj->set("count", serialize(val.count));
+    obj->set("totalTime", serialize(val.totalTime));
+    obj->set("maxTime", serialize(val.maxTime));
+    obj->set("p50", serialize(val.p50));
+    obj->set("p90", serialize(val.p90));
+    obj->set("p99", serialize(val.p99));
+    return obj;
+}
+
+template<>
+Poco::Dynamic::Var VarSerializer::serialize<RpcMethodMetrics>(const RpcMethodMetrics& val) {
+    Poco::JSON::Object::Ptr obj = new Poco::JSON::Object();
+    if (_options.addType) {
+        obj->set("__type", "core$RpcMethodMetrics");
+    }
+    obj->set("method", serialize(val.method));
+    obj->set("errors", serialize(val.errors));
+    obj->set("latency", serialize(val.latency));
+    return obj;
+}
+
+template<>
+Poco::Dynamic::Var VarSerializer::serialize<CryptoOperationMetrics>(const CryptoOperationMetrics& val) {
+    Poco::JSON::Object::Ptr obj = new Poco::JSON::Object();
+    if (_options.addType) {
+        obj->set("__type", "core$CryptoOperationMetrics");
+    }
+    obj->set("operation", serialize(val.operation));
+    obj->set("operations", serialize(val.operations));
+    obj->set("bytes", serialize(val.bytes));
+    return obj;
+}
+
+template<>
+Poco::Dynamic::Var VarSerializer::serialize<QueueMetrics>(const QueueMetrics& val) {
+    Poco::JSON::Object::Ptr obj = new Poco::JSON::Object();
+    if (_options.addType) {
+        obj->set("__type", "core$QueueMetrics");
+    }
+    obj->set("depth", serialize(val.depth));
+    obj->set("maxDepth", serialize(val.maxDepth));
+    return obj;
+}
+
+template<>
+Poco::Dynamic::Var VarSerializer::serialize<PerformanceMetrics>(const PerformanceMetrics& val) {
+    Poco::JSON::Object::Ptr obj = new Poco::JSON::Object();
+    if (_options.addType) {
+        obj->set("__type", "core$PerformanceMetrics");
+    }
+    obj->set("rpcMethods", serialize(val.rpcMethods));
+    obj->set("cryptoOperations", serialize(val.cryptoOperations));
+    obj->set("executorQueue", serialize(val.executorQueue));
+    obj->set("executorQueueWait", serialize(val.executorQueueWait));
+    obj->set("eventQueue", serialize(val.eventQueue));
+    return obj;
+}
@@ -49,10 +49,8 @@ std::string DIOEncryptorV1::signAndEncode(const ExpandedDataIntegrityObject& dio
 }
 
 ExpandedDataIntegrityObject DIOEncryptorV1::decodeAndVerify(const std::string& signedDio) {
-    auto dioAndSignature = _dataEncryptor.extractDataWithSignature(_dataEncryptor.decode(signedDio));
-    dynamic::DataIntegrityObject dioJSON = dynamic::DataIntegrityObject::fromJSON(
-       privmx::utils::Utils::parseJsonObject(dioAndSignature.data.stdString())
-    );
+    const auto dioAndSignature = _dataEncryptor.extractDataWithSignature(_dataEncryptor.decode(signedDio));
+    dynamic::DataIntegrityObject dioJSON = dynamic::DataIntegrityObject::deserialize(dioAndSignature.data.stdString());
     assertDataFormat(dioJSON);
     std::unordered_map<std::string, std::string> fieldChecksums;
     for(const auto& checksumBase64 : dioJSON.fieldChecksums) {
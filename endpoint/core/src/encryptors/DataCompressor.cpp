@@ -0,0 +1,109 @@
+/*
+PrivMX Endpoint.
+Copyright © 2024 Simplito sp. z o.o.
+
+This file is part of the PrivMX Platform (https://privmx.dev).
+This software is Licensed under the PrivMX Free License.
+
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <algorithm>
+#include <sstream>
+#include <Poco/DeflatingStream.h>
+#include <Poco/InflatingStream.h>
+
+#include "privmx/endpoint/core/CoreException.hpp"
+#include "privmx/endpoint/core/encryptors/DataCompressor.hpp"
+
+using namespace privmx::endpoint;
+using namespace privmx::endpoint::core;
+
+namespace {
+
+constexpr size_t HEADER_SIZE = 5;
+constexpr size_t READ_CHUNK_SIZE = 64 * 1024;
+
+}
+
+void DataCompressor::setOptions(const DataCompressionOptions& options) {
+    _minSize = options.minSize;
+    _maxDecompressedSize = options.maxDecompressedSize;
+    _enabled = options.enabled;
+}
+
+DataCompressionOptions DataCompressor::getOptions() const {
+    return DataCompressionOptions{.enabled = _enabled, .minSize = _minSize, .maxDecompressedSize = _maxDecompressedSize};
+}
+
+size_t DataCompressor::getMaxDecompressedSize() const {
+    return _maxDecompressedSize;
+}
+
+std::optional<core::Buffer> DataCompressor::compress(const core::Buffer& data) const {
+    // data larger than the maximum size is stored as it is, so that it stays readable with the same options
+    if (!_enabled || data.size() < (size_t)std::max<int64_t>(_minSize, 1) || data.size() > getMaxDecompressedSize()) {
+        return std::nullopt;
+    }
+    auto compressed = deflate(data);
+    if (compressed.size() >= data.size()) {
+        return std::nullopt;
+    }
+    return compressed;
+}
+
+core::Buffer DataCompressor::deflate(const core::Buffer& data) {
+    std::ostringstream output;
+    uint32_t size = data.size();
+    output.put(static_cast<char>(Codec::DEFLATE))
+        .put(static_cast<char>(size >> 24))
+        .put(static_cast<char>(size >> 16))
+        .put(static_cast<char>(size >> 8))
+        .put(static_cast<char>(size));
+    {
+        Poco::DeflatingOutputStream deflating(output, Poco::DeflatingStreamBuf::STREAM_ZLIB, COMPRESSION_LEVEL);
+        auto view = data.view();
+        deflating.write(view.data(), view.size());
+        deflating.close();
+    }
+    return core::Buffer::from(output.str());
+}
+
+core::Buffer DataCompressor::decompress(const core::Buffer& compressed, size_t maxSize) {
+    auto buf = compressed.view();
+    if (buf.size() < HEADER_SIZE || static_cast<uint8_t>(buf[0]) != Codec::DEFLATE) {
+        throw DataDecompressionException("unknown codec");
+    }
+    size_t size = (size_t(static_cast<uint8_t>(buf[1])) << 24) | (size_t(static_cast<uint8_t>(buf[2])) << 16) |
+                  (size_t(static_cast<uint8_t>(buf[3])) << 8) | size_t(static_cast<uint8_t>(buf[4]));
+    if (size > maxSize) {
+        throw DataDecompressionException("declared size exceeds the limit");
+    }
+    std::istringstream input(std::string(buf.substr(HEADER_SIZE)));
+    Poco::InflatingInputStream inflating(input, Poco::InflatingStreamBuf::STREAM_ZLIB);
+    std::string result;
+    result.reserve(size);
+    char chunk[READ_CHUNK_SIZE];
+    try {
+        // reads at most one byte more than declared, so a longer stream is detected without inflating it all
+        while (result.size() <= size) {
+            inflating.read(chunk, std::min(READ_CHUNK_SIZE, size + 1 - result.size()));
+            auto read = inflating.gcount();
+            if (read <= 0) {
+                break;
+            }
+            result.append(chunk, read);
+        }
+    } catch (const Poco::Exception& e) {
+        throw DataDecompressionException(e.displayText());
+    }
+    // the stream catches errors of the inflating buffer, setting badbit
+    if (inflating.bad()) {
+        throw DataDecompressionException("invalid compressed stream");
+    }
+    if (result.size() != size) {
+        throw DataDecompressionException("size mismatch");
+    }
+    return core::Buffer::from(std::move(result));
+}
@@ -22,7 +22,10 @@ std::string DataEncryptorV4::signAndEncode(const core::Buffer& data, const crypt
 std::string DataEncryptorV4::signAndEncryptAndEncode(const core::Buffer& data,
                                                      const crypto::PrivateKey& authorPrivateKey,
                                                      const std::string& encryptionKey) {
-    auto signedData = _innerEncryptor.signAndPackDataWithSignature(data, authorPrivateKey);
+    auto compressed = _compressor ? _compressor->compress(data) : std::nullopt;
+    auto signedData = compressed.has_value() ?
+        _innerEncryptor.signAndPackDataWithSignature(compressed.value(), authorPrivateKey, true) :
+        _innerEncryptor.signAndPackDataWithSignature(data, authorPrivateKey);
     auto encrypted = _innerEncryptor.encrypt(signedData, encryptionKey);
     return _innerEncryptor.encode(encrypted);
 }
@@ -30,7 +33,7 @@ std::string DataEncryptorV4::signAndEncryptAndEncode(const core::Buffer& data,
 core::Buffer DataEncryptorV4::decodeAndVerify(const std::string& publicDataAsBase64,
                                               const crypto::PublicKey& authorPublicKey) {
     auto decoded = _innerEncryptor.decode(publicDataAsBase64);
-    return _innerEncryptor.verifyAndExtractData(decoded, authorPublicKey);
+    return _innerEncryptor.verifyAndExtractData(std::move(decoded), authorPublicKey, getMaxDecompressedSize());
 }
 
 core::Buffer DataEncryptorV4::decodeAndDecryptAndVerify(const std::string& privateDataAsBase64,
@@ -38,5 +41,58 @@ core::Buffer DataEncryptorV4::decodeAndDecryptAndVerify(const std::string& priva
                                                         const std::string& encryptionKey) {
     auto decoded = _innerEncryptor.decode(privateDataAsBase64);
     auto decrypted = _innerEncryptor.decrypt(decoded, encryptionKey);
-    return _innerEncryptor.verifyAndExtractData(decrypted, authorPublicKey);
+    return _innerEncryptor.verifyAndExtractData(std::move(decrypted), authorPublicKey, getMaxDecompressedSize());
+}
+
+std::vector<std::string> DataEncryptorV4::signAndEncodeMany(const std::vector<FieldToEncode>& fields,
+                                                            const crypto::PrivateKey& authorPrivateKey) {
+    std::vector<std::reference_wrapper<const core::Buffer>> data;
+    std::vector<std::optional<core::Buffer>> compressedData(fields.size());
+    std::vector<bool> compressed(fields.size(), false);
+    data.reserve(fields.size());
+    for (size_t i = 0; i < fields.size(); ++i) {
+        if (_compressor && fields[i].encryptionKey.has_value()) {
+            compressedData[i] = _compressor->compress(fields[i].data);
+        }
+        if (compressedData[i].has_value()) {
+            compressed[i] = true;
+            data.push_back(compressedData[i].value());
+        } else {
+            data.push_back(fields[i].data);
+        }
+    }
+    auto signedData = _innerEncryptor.signAndPackManyDataWithSignature(data, authorPrivateKey, compressed);
+    std::vector<std::string> result;
+    result.reserve(fields.size());
+    for (size_t i = 0; i < fields.size(); ++i) {
+        if (fields[i].encryptionKey.has_value()) {
+            result.push_back(_innerEncryptor.encode(_innerEncryptor.encrypt(signedData[i], fields[i].encryptionKey.value())));
+        } else {
+            result.push_back(_innerEncryptor.encode(signedData[i]));
+        }
+    }
+    return result;
+}
+
+std::vector<core::Buffer> DataEncryptorV4::decodeAndVerifyMany(const std::vector<FieldToDecode>& fields,
+                                                               const crypto::PublicKey& authorPublicKey) {
+    std::vector<core::Buffer> signedData;
+    signedData.reserve(fields.size());
+    for (auto& field : fields) {
+        auto decoded = _innerEncryptor.decode(field.dataAsBase64.get());
+        if (field.encryptionKey.has_value()) {
+            signedData.push_back(_innerEncryptor.decrypt(decoded, field.encryptionKey.value()));
+        } else {
+            signedData.push_back(std::move(decoded));
+        }
+    }
+    return _innerEncryptor.verifyAndExtractManyData(std::move(signedData), authorPublicKey, getMaxDecompressedSize());
+}
+
+void DataEncryptorV4::setCompressor(const std::shared_ptr<const DataCompressor>& compressor) {
+    _compressor = compressor;
+}
+
+size_t DataEncryptorV4::getMaxDecompressedSize() const {
+    return _compressor ? _compressor->getMaxDecompressedSize() : DataCompressor::DEFAULT_MAX_DECOMPRESSED_SIZE;
 }
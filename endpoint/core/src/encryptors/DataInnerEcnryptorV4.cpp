@@ -9,8 +9,10 @@ See the License for the specific language governing permissions and
 limitations under the License.
 */
 
+#include "privmx/crypto/Crypto.hpp"
 #include "privmx/crypto/CryptoPrivmx.hpp"
 #include "privmx/endpoint/core/CoreException.hpp"
+#include "privmx/endpoint/core/encryptors/DataCompressor.hpp"
 #include "privmx/endpoint/core/encryptors/DataInnerEncryptorV4.hpp"
 #include "privmx/utils/Utils.hpp"
 
@@ -20,57 +22,134 @@ using namespace privmx::endpoint::core;
 std::string DataInnerEncryptorV4::encode(const core::Buffer& data) { return utils::Base64::from(data.stdString()); }
 
 core::Buffer DataInnerEncryptorV4::decode(const std::string& dataAsBase64) {
-    auto decoded = utils::Base64::toString(dataAsBase64);
-    return core::Buffer::from(decoded);
+    return core::Buffer::from(utils::Base64::toString(dataAsBase64));
 }
 
 core::Buffer DataInnerEncryptorV4::encrypt(const core::Buffer& data, const std::string& encryptionKey) {
     auto encrypted = privmx::crypto::CryptoPrivmx::privmxEncrypt(
         privmx::crypto::CryptoPrivmx::privmxOptAesWithSignature(), data.stdString(), encryptionKey);
-    return core::Buffer::from(encrypted);
+    return core::Buffer::from(std::move(encrypted));
 }
 
 core::Buffer DataInnerEncryptorV4::decrypt(const core::Buffer& privateData, const std::string& encryptionKey) {
     auto decrypted = privmx::crypto::CryptoPrivmx::privmxDecrypt(true, privateData.stdString(), encryptionKey);
-    return core::Buffer::from(decrypted);
+    return core::Buffer::from(std::move(decrypted));
 }
 
 core::Buffer DataInnerEncryptorV4::signAndPackDataWithSignature(const core::Buffer& data,
-                                                                const crypto::PrivateKey& authorPrivateKey) {
-    auto dataWithSignature = sign(data, authorPrivateKey);
-    return packDataWithSignature(dataWithSignature);
+                                                                const crypto::PrivateKey& authorPrivateKey, bool compressed) {
+    return packDataWithSignature(sign(data, authorPrivateKey), data, compressed);
 }
 
 core::Buffer DataInnerEncryptorV4::verifyAndExtractData(const core::Buffer& signedData,
-                                                        const crypto::PublicKey& authorPublicKey) {
-    auto dataWithSignature = extractDataWithSignature(signedData);
-    if (!verifySignature(dataWithSignature, authorPublicKey)) {
+                                                        const crypto::PublicKey& authorPublicKey,
+                                                        size_t maxDecompressedSize) {
+    return verifyAndExtractData(core::Buffer(signedData), authorPublicKey, maxDecompressedSize);
+}
+
+core::Buffer DataInnerEncryptorV4::verifyAndExtractData(core::Buffer&& signedData,
+                                                        const crypto::PublicKey& authorPublicKey,
+                                                        size_t maxDecompressedSize) {
+    auto [signature, compressed] = stripSignature(signedData);
+    if (!authorPublicKey.verifyCompactSignatureWithHash(signedData.stdString(), signature)) {
+        throw InvalidDataSignatureException();
+    }
+    // the signature covers the compressed data, so nothing is inflated before it is verified
+    return compressed ? DataCompressor::decompress(signedData, maxDecompressedSize) : std::move(signedData);
+}
+
+std::vector<core::Buffer> DataInnerEncryptorV4::signAndPackManyDataWithSignature(const std::vector<std::reference_wrapper<const core::Buffer>>& data,
+                                                                                const crypto::PrivateKey& authorPrivateKey,
+                                                                                const std::vector<bool>& compressed) {
+    std::vector<std::string> hashes;
+    hashes.reserve(data.size());
+    for (auto& item : data) {
+        hashes.push_back(privmx::crypto::Crypto::sha256(item.get().stdString()));
+    }
+    auto signatures = authorPrivateKey.signManyToCompactSignature(hashes);
+    std::vector<core::Buffer> result;
+    result.reserve(data.size());
+    for (size_t i = 0; i < data.size(); ++i) {
+        result.push_back(packDataWithSignature(signatures[i], data[i].get(), !compressed.empty() && compressed[i]));
+    }
+    return result;
+}
+
+std::vector<core::Buffer> DataInnerEncryptorV4::verifyAndExtractManyData(const std::vector<core::Buffer>& signedData,
+                                                                        const crypto::PublicKey& authorPublicKey,
+                                                                        size_t maxDecompressedSize) {
+    return verifyAndExtractManyData(std::vector<core::Buffer>(signedData), authorPublicKey, maxDecompressedSize);
+}
+
+std::vector<core::Buffer> DataInnerEncryptorV4::verifyAndExtractManyData(std::vector<core::Buffer>&& signedData,
+                                                                        const crypto::PublicKey& authorPublicKey,
+                                                                        size_t maxDecompressedSize) {
+    std::vector<std::string> hashes;
+    std::vector<std::string> signatures;
+    std::vector<core::Buffer> result;
+    std::vector<bool> compressed;
+    hashes.reserve(signedData.size());
+    signatures.reserve(signedData.size());
+    result.reserve(signedData.size());
+    compressed.reserve(signedData.size());
+    for (auto& item : signedData) {
+        auto [signature, itemCompressed] = stripSignature(item);
+        hashes.push_back(privmx::crypto::Crypto::sha256(item.stdString()));
+        signatures.push_back(std::move(signature));
+        result.push_back(std::move(item));
+        compressed.push_back(itemCompressed);
+    }
+    if (!authorPublicKey.verifyManyCompactSignatures(hashes, signatures)) {
         throw InvalidDataSignatureException();
     }
-    return dataWithSignature.data;
+    for (size_t i = 0; i < result.size(); ++i) {
+        if (compressed[i]) {
+            result[i] = DataCompressor::decompress(result[i], maxDecompressedSize);
+        }
+    }
+    return result;
 }
 
-DataInnerEncryptorV4::DataWithSignature DataInnerEncryptorV4::sign(const core::Buffer& data,
-                                                                   const crypto::PrivateKey& authorPrivateKey) {
-    auto signature = authorPrivateKey.signToCompactSignatureWithHash(data.stdString());
-    return DataWithSignature{.signature = core::Buffer::from(signature), .data = data};
+std::string DataInnerEncryptorV4::sign(const core::Buffer& data, const crypto::PrivateKey& authorPrivateKey) {
+    return authorPrivateKey.signToCompactSignatureWithHash(data.stdString());
 }
 
-core::Buffer DataInnerEncryptorV4::packDataWithSignature(const DataWithSignature& dataWithSignature) {
-    auto packed = std::string(static_cast<std::size_t>(1), static_cast<char>(1))
-                      .append(static_cast<std::size_t>(1), static_cast<char>(dataWithSignature.signature.size()))
-                      .append(dataWithSignature.signature.stdString())
-                      .append(dataWithSignature.data.stdString());
-    return core::Buffer::from(packed);
+core::Buffer DataInnerEncryptorV4::packDataWithSignature(const std::string& signature, const core::Buffer& data, bool compressed) {
+    std::string packed;
+    packed.reserve(2 + signature.size() + data.size());
+    packed.append(static_cast<std::size_t>(1), static_cast<char>(compressed ? Format::COMPRESSED : Format::PLAIN))
+        .append(static_cast<std::size_t>(1), static_cast<char>(signature.size()))
+        .append(signature)
+        .append(data.view());
+    return core::Buffer::from(std::move(packed));
 }
 
 DataInnerEncryptorV4::DataWithSignature DataInnerEncryptorV4::extractDataWithSignature(const core::Buffer& signedData) {
-    const std::string& buf = signedData.stdString();
-    if (buf[0] == 1) {
-        size_t signatureLength = reinterpret_cast<const uint8_t&>(buf[1]);
-        auto signature = buf.substr(2, signatureLength);
-        auto data = buf.substr(2 + signatureLength);
-        return DataWithSignature{.signature = core::Buffer::from(signature), .data = core::Buffer::from(data)};
+    auto buf = signedData.view();
+    size_t signatureLength = getSignatureLength(buf);
+    return DataWithSignature{
+        .signature = core::Buffer::from(buf.data() + 2, signatureLength),
+        .data = core::Buffer::from(buf.data() + 2 + signatureLength, buf.size() - 2 - signatureLength),
+        .compressed = buf[0] == Format::COMPRESSED
+    };
+}
+
+std::pair<std::string, bool> DataInnerEncryptorV4::stripSignature(core::Buffer& signedData) {
+    // the header is erased in place, so the data stays in the same string and is not copied out
+    auto& buf = signedData.stdString();
+    size_t signatureLength = getSignatureLength(buf);
+    std::pair<std::string, bool> result{buf.substr(2, signatureLength), buf[0] == Format::COMPRESSED};
+    buf.erase(0, 2 + signatureLength);
+    return result;
+}
+
+size_t DataInnerEncryptorV4::getSignatureLength(std::string_view signedData) {
+    if (signedData.size() >= 2 && (signedData[0] == Format::PLAIN || signedData[0] == Format::COMPRESSED)) {
+        size_t signatureLength = reinterpret_cast<const uint8_t&>(signedData[1]);
+        if (signedData.size() < 2 + signatureLength) {
+            throw UnsupportedTypeException();
+        }
+        return signatureLength;
     }
     throw UnsupportedTypeException();
 }
@@ -22,22 +22,35 @@ dynamic::EncryptedModuleDataV5 ModuleDataEncryptorV5::encrypt(const ModuleDataTo
                                                                      const privmx::crypto::PrivateKey& authorPrivateKey,
                                                                      const std::string& encryptionKey) {
     dynamic::EncryptedModuleDataV5 result;
-    result.version = ModuleDataSchema::Version::VERSION_5;
+    result.version = kvdbData.internalMeta.keyChain.empty() ? ModuleDataSchema::Version::VERSION_5 : ModuleDataSchema::Version::VERSION_6;
     std::unordered_map<std::string, std::string> fieldChecksums;
-    result.publicMeta = _dataEncryptor.signAndEncode(kvdbData.publicMeta, authorPrivateKey);
+    dynamic::ModuleInternalMetaV5 internalMeta{.secret=kvdbData.internalMeta.secret, .resourceId=kvdbData.internalMeta.resourceId, .randomId=kvdbData.internalMeta.randomId, .keyChain=std::nullopt};
+    if(!kvdbData.internalMeta.keyChain.empty()) {
+        std::vector<dynamic::ModuleKeyChainLink> keyChain;
+        for(const auto& link : kvdbData.internalMeta.keyChain) {
+            keyChain.push_back({.keyId=link.keyId, .previousKeyId=link.previousKeyId, .encryptedPreviousKey=link.encryptedPreviousKey});
+        }
+        internalMeta.keyChain = keyChain;
+    }
+    auto internalMetaBuffer = Buffer::from(internalMeta.serialize());
+    auto encoded = _dataEncryptor.signAndEncodeMany({
+        {kvdbData.publicMeta, std::nullopt},
+        {kvdbData.privateMeta, encryptionKey},
+        {internalMetaBuffer, encryptionKey}
+    }, authorPrivateKey);
+    result.publicMeta = encoded[0];
     fieldChecksums.insert(std::make_pair("publicMeta",privmx::crypto::Crypto::sha256(result.publicMeta)));
     try {
         result.publicMetaObject = utils::Utils::parseJsonObject(kvdbData.publicMeta.stdString());
     } catch (...) {
         result.publicMetaObject = Poco::Dynamic::Var();
     }
-    result.privateMeta = _dataEncryptor.signAndEncryptAndEncode(kvdbData.privateMeta, authorPrivateKey, encryptionKey);
+    result.privateMeta = encoded[1];
     fieldChecksums.insert(std::make_pair("privateMeta",privmx::crypto::Crypto::sha256(result.privateMeta)));
-    dynamic::ModuleInternalMetaV5 internalMeta{.secret=kvdbData.internalMeta.secret, .resourceId=kvdbData.internalMeta.resourceId, .randomId=kvdbData.internalMeta.randomId};
-    result.internalMeta = _dataEncryptor.signAndEncryptAndEncode(Buffer::from(internalMeta.serialize()), authorPrivateKey, encryptionKey);
+    result.internalMeta = encoded[2];
     fieldChecksums.insert(std::make_pair("internalMeta",privmx::crypto::Crypto::sha256(result.internalMeta)));
     result.authorPubKey = authorPrivateKey.getPublicKey().toBase58DER();
-    ExpandedDataIntegrityObject expandedDio = {kvdbData.dio, .structureVersion=5, .fieldChecksums=fieldChecksums};
+    ExpandedDataIntegrityObject expandedDio = {kvdbData.dio, .structureVersion=result.version, .fieldChecksums=fieldChecksums};
     result.dio = _DIOEncryptor.signAndEncode(expandedDio, authorPrivateKey);
     return result;
 }
@@ -49,7 +62,12 @@ DecryptedModuleDataV5 ModuleDataEncryptorV5::decrypt(const dynamic::EncryptedMod
     try {  
         result.dio = getDIOAndAssertIntegrity(encryptedModuleData);
         auto authorPublicKey = crypto::PublicKey::fromBase58DER(encryptedModuleData.authorPubKey);
-        result.publicMeta = _dataEncryptor.decodeAndVerify(encryptedModuleData.publicMeta, authorPublicKey);
+        auto decoded = _dataEncryptor.decodeAndVerifyMany({
+            {encryptedModuleData.publicMeta, std::nullopt},
+            {encryptedModuleData.privateMeta, encryptionKey},
+            {encryptedModuleData.internalMeta, encryptionKey}
+        }, authorPublicKey);
+        result.publicMeta = decoded[0];
         if(!encryptedModuleData.publicMetaObject.isEmpty()) {
             auto tmp_1 = utils::Utils::stringifyVar(utils::Utils::parseJsonObject(result.publicMeta.stdString()));
             auto tmp_2 = utils::Utils::stringifyVar(encryptedModuleData.publicMetaObject);
@@ -58,10 +76,15 @@ DecryptedModuleDataV5 ModuleDataEncryptorV5::decrypt(const dynamic::EncryptedMod
                 result.statusCode = e.getCode();
             }
         }
-        result.privateMeta = _dataEncryptor.decodeAndDecryptAndVerify(encryptedModuleData.privateMeta, authorPublicKey, encryptionKey);
-        auto internalMeta = _dataEncryptor.decodeAndDecryptAndVerify(encryptedModuleData.internalMeta, authorPublicKey, encryptionKey).stdString();
-        auto internalMetaJSON = dynamic::ModuleInternalMetaV5::fromJSON(utils::Utils::parseJsonObject(internalMeta));
-        result.internalMeta = ModuleInternalMetaV5{.secret=internalMetaJSON.secret, .resourceId=internalMetaJSON.resourceId, .randomId=internalMetaJSON.randomId};
+        result.privateMeta = decoded[1];
+        auto internalMeta = decoded[2].stdString();
+        auto internalMetaJSON = dynamic::ModuleInternalMetaV5::deserialize(internalMeta);
+        result.internalMeta = ModuleInternalMetaV5{.secret=internalMetaJSON.secret, .resourceId=internalMetaJSON.resourceId, .randomId=internalMetaJSON.randomId, .keyChain={}};
+        if(encryptedModuleData.version == ModuleDataSchema::Version::VERSION_6 && internalMetaJSON.keyChain.has_value()) {
+            for(const auto& link : internalMetaJSON.keyChain.value()) {
+                result.internalMeta.keyChain.push_back({.keyId=link.keyId, .previousKeyId=link.previousKeyId, .encryptedPreviousKey=link.encryptedPreviousKey});
+            }
+        }
         result.authorPubKey = encryptedModuleData.authorPubKey;    
     }  catch (const privmx::endpoint::core::Exception& e) {
         result.statusCode = e.getCode();
@@ -106,7 +129,7 @@ DataIntegrityObject ModuleDataEncryptorV5::getDIOAndAssertIntegrity(const dynami
     auto encryptedDIO = encryptedModuleData.dio;
     auto dio = _DIOEncryptor.decodeAndVerify(encryptedDIO);
     if (
-        dio.structureVersion != ModuleDataSchema::Version::VERSION_5 ||
+        dio.structureVersion != encryptedModuleData.version ||
         dio.creatorPubKey != encryptedModuleData.authorPubKey ||
         dio.fieldChecksums.at("publicMeta") != privmx::crypto::Crypto::sha256(encryptedModuleData.publicMeta) ||
         dio.fieldChecksums.at("privateMeta") != privmx::crypto::Crypto::sha256(encryptedModuleData.privateMeta) ||
@@ -117,9 +140,13 @@ DataIntegrityObject ModuleDataEncryptorV5::getDIOAndAssertIntegrity(const dynami
     return dio;
 }
 
+void ModuleDataEncryptorV5::setCompressor(const std::shared_ptr<const core::DataCompressor>& compressor) {
+    _dataEncryptor.setCompressor(compressor);
+}
+
 void ModuleDataEncryptorV5::assertDataFormat(const dynamic::EncryptedModuleDataV5& encryptedModuleData) {
     if (
-        encryptedModuleData.version != ModuleDataSchema::Version::VERSION_5 ||
+        (encryptedModuleData.version != ModuleDataSchema::Version::VERSION_5 && encryptedModuleData.version != ModuleDataSchema::Version::VERSION_6) ||
         encryptedModuleData.publicMeta.empty() ||
         encryptedModuleData.privateMeta.empty() ||
         encryptedModuleData.internalMeta.empty() ||
@@ -25,7 +25,17 @@ std::map<ConnectionVarInterface::METHOD, Poco::Dynamic::Var (ConnectionVarInterf
                                          {SubscribeFor, &ConnectionVarInterface::subscribeFor},
                                          {UnsubscribeFrom, &ConnectionVarInterface::unsubscribeFrom},
                                          {BuildSubscriptionQuery, &ConnectionVarInterface::buildSubscriptionQuery},
-                                         {ListContextUsers, &ConnectionVarInterface::listContextUsers}
+                                         {ListContextUsers, &ConnectionVarInterface::listContextUsers},
+                                         {SetUserVerifierCacheOptions, &ConnectionVarInterface::setUserVerifierCacheOptions},
+                                         {InvalidateUserVerifierCache, &ConnectionVarInterface::invalidateUserVerifierCache},
+                                         {GetUserVerifierMetrics, &ConnectionVarInterface::getUserVerifierMetrics},
+                                         {UpdateContainersMembers, &ConnectionVarInterface::updateContainersMembers},
+                                         {GetKeyCacheMetrics, &ConnectionVarInterface::getKeyCacheMetrics},
+                                         {GetPerformanceMetrics, &ConnectionVarInterface::getPerformanceMetrics},
+                                         {ResetPerformanceMetrics, &ConnectionVarInterface::resetPerformanceMetrics},
+                                         {SetPerformanceMetricsEnabled, &ConnectionVarInterface::setPerformanceMetricsEnabled},
+                                         {SetDataCompressionOptions, &ConnectionVarInterface::setDataCompressionOptions},
+                                         {SetKeyChainEnabled, &ConnectionVarInterface::setKeyChainEnabled}
                                         };
 
 Poco::Dynamic::Var ConnectionVarInterface::connect(const Poco::Dynamic::Var& args) {
@@ -86,6 +96,76 @@ Poco::Dynamic::Var ConnectionVarInterface::setUserVerifier(const std::function<P
     return {};
 }
 
+Poco::Dynamic::Var ConnectionVarInterface::setUserVerifierCacheOptions(const Poco::Dynamic::Var& args) {
+    auto argsArr = VarInterfaceUtil::validateAndExtractArray(args, 1);
+    auto options = _deserializer.deserialize<UserVerifierCacheOptions>(argsArr->get(0), "options");
+    _connection.setUserVerifierCacheOptions(options);
+    return {};
+}
+
+Poco::Dynamic::Var ConnectionVarInterface::invalidateUserVerifierCache(const Poco::Dynamic::Var& args) {
+    auto argsArr = VarInterfaceUtil::validateAndExtractArray(args, 2);
+    auto contextId = _deserializer.deserializeOptional<std::string>(argsArr->get(0), "contextId");
+    auto userId = _deserializer.deserializeOptional<std::string>(argsArr->get(1), "userId");
+    _connection.invalidateUserVerifierCache(contextId, userId);
+    return {};
+}
+
+Poco::Dynamic::Var ConnectionVarInterface::getUserVerifierMetrics(const Poco::Dynamic::Var& args) {
+    VarInterfaceUtil::validateAndExtractArray(args, 0);
+    auto result = _connection.getUserVerifierMetrics();
+    return _serializer.serialize(result);
+}
+
+Poco::Dynamic::Var ConnectionVarInterface::updateContainersMembers(const Poco::Dynamic::Var& args) {
+    auto argsArr = VarInterfaceUtil::validateAndExtractArray(args, 4);
+    auto targets = _deserializer.deserializeVector<ContainerMembersTarget>(argsArr->get(0), "targets");
+    auto usersToAdd = _deserializer.deserializeVector<UserWithPubKey>(argsArr->get(1), "usersToAdd");
+    auto managersToAdd = _deserializer.deserializeVector<UserWithPubKey>(argsArr->get(2), "managersToAdd");
+    auto userIdsToRemove = _deserializer.deserializeVector<std::string>(argsArr->get(3), "userIdsToRemove");
+    auto result = _connection.updateContainersMembers(targets, usersToAdd, managersToAdd, userIdsToRemove);
+    return _serializer.serialize(result);
+}
+
+Poco::Dynamic::Var ConnectionVarInterface::getKeyCacheMetrics(const Poco::Dynamic::Var& args) {
+    VarInterfaceUtil::validateAndExtractArray(args, 0);
+    auto result = _connection.getKeyCacheMetrics();
+    return _serializer.serialize(result);
+}
+
+Poco::Dynamic::Var ConnectionVarInterface::getPerformanceMetrics(const Poco::Dynamic::Var& args) {
+    VarInterfaceUtil::validateAndExtractArray(args, 0);
+    auto result = Connection::getPerformanceMetrics();
+    return _serializer.serialize(result);
+}
+
+Poco::Dynamic::Var ConnectionVarInterface::resetPerformanceMetrics(const Poco::Dynamic::Var& args) {
+    VarInterfaceUtil::validateAndExtractArray(args, 0);
+    Connection::resetPerformanceMetrics();
+    return {};
+}
+
+Poco::Dynamic::Var ConnectionVarInterface::setPerformanceMetricsEnabled(const Poco::Dynamic::Var& args) {
+    auto argsArr = VarInterfaceUtil::validateAndExtractArray(args, 1);
+    auto enabled = _deserializer.deserialize<bool>(argsArr->get(0), "enabled");
+    Connection::setPerformanceMetricsEnabled(enabled);
+    return {};
+}
+
+Poco::Dynamic::Var ConnectionVarInterface::setDataCompressionOptions(const Poco::Dynamic::Var& args) {
+    auto argsArr = VarInterfaceUtil::validateAndExtractArray(args, 1);
+    auto options = _deserializer.deserialize<DataCompressionOptions>(argsArr->get(0), "options");
+    _connection.setDataCompressionOptions(options);
+    return {};
+}
+
+Poco::Dynamic::Var ConnectionVarInterface::setKeyChainEnabled(const Poco::Dynamic::Var& args) {
+    auto argsArr = VarInterfaceUtil::validateAndExtractArray(args, 1);
+    auto enabled = _deserializer.deserialize<bool>(argsArr->get(0), "enabled");
+    _connection.setKeyChainEnabled(enabled);
+    return {};
+}
+
 Poco::Dynamic::Var ConnectionVarInterface::subscribeFor(const Poco::Dynamic::Var& args) {
     auto argsArr = core::VarInterfaceUtil::validateAndExtractArray(args, 1);
     auto subscriptionQueries = _deserializer.deserializeVector<std::string>(argsArr->get(0), "subscriptionQueries");
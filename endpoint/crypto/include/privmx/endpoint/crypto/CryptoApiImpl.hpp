@@ -12,12 +12,15 @@ limitations under the License.
 #ifndef _PRIVMXLIB_ENDPOINT_CRYPTO_CRYPTOAPIIMPL_HPP_
 #define _PRIVMXLIB_ENDPOINT_CRYPTO_CRYPTOAPIIMPL_HPP_
 
+#include <atomic>
 #include <memory>
 #include <optional>
 #include <string>
 
 #include <privmx/crypto/ecc/PrivateKey.hpp>
+#include <privmx/utils/ThreadSaveMap.hpp>
 #include "privmx/endpoint/core/Buffer.hpp"
+#include "privmx/endpoint/crypto/SymmetricStream.hpp"
 #include "privmx/endpoint/crypto/Types.hpp"
 
 namespace privmx {
@@ -36,6 +39,13 @@ public:
     core::Buffer generateKeySymmetric();
     core::Buffer encryptDataSymmetric(const core::Buffer& data, const core::Buffer& key);
     core::Buffer decryptDataSymmetric(const core::Buffer& data, const core::Buffer& key);
+    int64_t openSymmetricEncryptionStream(const core::Buffer& key, size_t chunkSize, size_t maxThreads);
+    int64_t openSymmetricDecryptionStream(const core::Buffer& key, size_t maxThreads);
+    core::Buffer updateSymmetricStream(int64_t streamHandle, const core::Buffer& data);
+    core::Buffer finalizeSymmetricStream(int64_t streamHandle);
+    void closeSymmetricStream(int64_t streamHandle);
+    void encryptFileSymmetric(const std::string& inputPath, const std::string& outputPath, const core::Buffer& key, size_t maxThreads);
+    void decryptFileSymmetric(const std::string& inputPath, const std::string& outputPath, const core::Buffer& key, size_t maxThreads);
     std::string convertPEMKeytoWIFKey(const std::string& keyPEM);
     std::string convertPGPAsn1KeyToBase58DERKey(const std::string& keyPGP);
     BIP39_t generateBip39(std::size_t strength, const std::string& password = std::string());
@@ -47,6 +57,15 @@ public:
 
 private:
     privmx::crypto::PrivateKey getPrivKeyFromSeed(const std::string& seed, size_t rounds);
+    int64_t addSymmetricStream(const std::shared_ptr<SymmetricStream>& stream);
+    std::shared_ptr<SymmetricStream> getSymmetricStream(int64_t streamHandle);
+    void processFile(const std::string& inputPath, const std::string& outputPath, SymmetricStream& stream);
+
+    // the file helpers read and process this many chunks at once
+    static constexpr size_t FILE_READ_CHUNKS = 8;
+
+    utils::ThreadSaveMap<int64_t, std::shared_ptr<SymmetricStream>> _symmetricStreams;
+    std::atomic_int64_t _nextSymmetricStreamHandle = 1;
 };
 
 } // crypto
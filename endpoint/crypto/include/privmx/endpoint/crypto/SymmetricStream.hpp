@@ -0,0 +1,107 @@
+/*
+PrivMX Endpoint.
+Copyright © 2024 Simplito sp. z o.o.
+
+This file is part of the PrivMX Platform (https://privmx.dev).
+This software is Licensed under the PrivMX Free License.
+
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef _PRIVMXLIB_ENDPOINT_CRYPTO_SYMMETRICSTREAM_HPP_
+#define _PRIVMXLIB_ENDPOINT_CRYPTO_SYMMETRICSTREAM_HPP_
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace privmx {
+namespace endpoint {
+namespace crypto {
+
+// Chunked symmetric encryption of data of any size.
+// Encrypted stream: header (version: 1 B, plain chunk size: 4 B BE, salt: 32 B), chunks and a tag (32 B).
+// A chunk is hmac (32 B) + iv (16 B) + AES-256-CBC ciphertext of at most chunk size bytes, encrypted with
+// a key derived from the key of the stream and the chunk index, like chunks of Store files, so chunks cannot be
+// moved. The tag authenticates the number of chunks, the plain size and the hmacs of all the chunks, so a
+// truncated stream is detected when it is finalized.
+class SymmetricStream {
+public:
+    static constexpr uint8_t FORMAT_VERSION = 1;
+    static constexpr size_t SALT_SIZE = 32;
+    static constexpr size_t HEADER_SIZE = 1 + 4 + SALT_SIZE;
+    static constexpr size_t HMAC_SIZE = 32;
+    static constexpr size_t IV_SIZE = 16;
+    static constexpr size_t TAG_SIZE = 32;
+    static constexpr size_t DEFAULT_CHUNK_SIZE = 1024 * 1024;
+    static constexpr size_t MAX_CHUNK_SIZE = 64 * 1024 * 1024;
+
+    virtual ~SymmetricStream();
+    // returns the part of the output which is ready
+    virtual std::string update(std::string_view data) = 0;
+    // returns the rest of the output, verifying the whole stream when decrypting
+    virtual std::string finalize() = 0;
+    // zeroes the keys, the stream cannot be used afterwards
+    void wipe();
+    bool isWiped() const { return _wiped; }
+    static size_t getEncryptedChunkSize(size_t plainSize);
+
+    // streams are not thread safe, calls on the same stream are serialized by its owner
+    std::mutex mutex;
+
+protected:
+    SymmetricStream(const std::string& key, size_t maxThreads);
+    void init(const std::string& salt, size_t chunkSize);
+    std::string getChunkKey(uint64_t index) const;
+    void addToTag(std::string_view chunkHmac, size_t plainSize);
+    std::string getTag() const;
+    static std::string toBE(uint64_t value);
+    static void erase(std::string& secret);
+
+    std::string _key;
+    size_t _maxThreads;
+    std::string _streamKey;
+    size_t _chunkSize = 0;
+    uint64_t _chunksCount = 0;
+    uint64_t _plainSize = 0;
+    std::string _tagChain;
+    bool _wiped = false;
+};
+
+class SymmetricStreamEncryptor : public SymmetricStream {
+public:
+    SymmetricStreamEncryptor(const std::string& key, size_t chunkSize = DEFAULT_CHUNK_SIZE, size_t maxThreads = 1);
+    std::string update(std::string_view data) override;
+    std::string finalize() override;
+
+private:
+    std::string encryptChunks(const std::vector<std::string_view>& chunks);
+    std::string encryptChunk(uint64_t index, std::string_view data);
+
+    std::string _header;
+    std::string _pending;
+};
+
+class SymmetricStreamDecryptor : public SymmetricStream {
+public:
+    SymmetricStreamDecryptor(const std::string& key, size_t maxThreads = 1);
+    std::string update(std::string_view data) override;
+    std::string finalize() override;
+
+private:
+    bool readHeader();
+    std::string decryptChunks(const std::vector<std::string_view>& chunks);
+    std::string decryptChunk(uint64_t index, std::string_view data);
+
+    bool _headerRead = false;
+    std::string _buffer;
+};
+
+} // crypto
+} // endpoint
+} // privmx
+
+#endif // _PRIVMXLIB_ENDPOINT_CRYPTO_SYMMETRICSTREAM_HPP_
@@ -45,7 +45,14 @@ public:
         EntropyToMnemonic = 14,
         MnemonicToEntropy = 15,
         MnemonicToSeed = 16,
-        ConvertPGPAsn1KeyToBase58DERKey = 17
+        ConvertPGPAsn1KeyToBase58DERKey = 17,
+        OpenSymmetricEncryptionStream = 18,
+        OpenSymmetricDecryptionStream = 19,
+        UpdateSymmetricStream = 20,
+        FinalizeSymmetricStream = 21,
+        EncryptFileSymmetric = 22,
+        DecryptFileSymmetric = 23,
+        CloseSymmetricStream = 24
     };
 
     CryptoApiVarInterface(const core::VarSerializer& serializer)
@@ -70,6 +77,13 @@ public:
     Poco::Dynamic::Var mnemonicToEntropy(const Poco::Dynamic::Var& args);
     Poco::Dynamic::Var mnemonicToSeed(const Poco::Dynamic::Var& args);
     Poco::Dynamic::Var convertPGPAsn1KeyToBase58DERKey(const Poco::Dynamic::Var& args);
+    Poco::Dynamic::Var openSymmetricEncryptionStream(const Poco::Dynamic::Var& args);
+    Poco::Dynamic::Var openSymmetricDecryptionStream(const Poco::Dynamic::Var& args);
+    Poco::Dynamic::Var updateSymmetricStream(const Poco::Dynamic::Var& args);
+    Poco::Dynamic::Var finalizeSymmetricStream(const Poco::Dynamic::Var& args);
+    Poco::Dynamic::Var encryptFileSymmetric(const Poco::Dynamic::Var& args);
+    Poco::Dynamic::Var decryptFileSymmetric(const Poco::Dynamic::Var& args);
+    Poco::Dynamic::Var closeSymmetricStream(const Poco::Dynamic::Var& args);
 
     Poco::Dynamic::Var exec(METHOD method, const Poco::Dynamic::Var& args);
 
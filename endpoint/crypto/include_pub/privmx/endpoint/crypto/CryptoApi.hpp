@@ -19,6 +19,11 @@ class CryptoApiImpl;
  */
 class CryptoApi {
 public:
+    /**
+     * Size of the plain data chunks used by default by the symmetric encryption streams (1 MiB).
+     */
+    static constexpr int64_t DEFAULT_SYMMETRIC_STREAM_CHUNK_SIZE = 1024 * 1024;
+
     /**
      * Creates instance of 'CryptoApi'.
      * 
@@ -111,6 +116,87 @@ public:
      */
     core::Buffer decryptDataSymmetric(const core::Buffer& data, const core::Buffer& symmetricKey);
 
+    /**
+     * Opens a stream encrypting data of any size with a given key, in chunks authenticated separately.
+     * The encrypted data is not compatible with encryptDataSymmetric() and can be decrypted only by a decryption stream.
+     *
+     * @param symmetricKey key used to encrypt data
+     * @param chunkSize size of plain data chunks in bytes, at most 64 MiB
+     * @param maxThreads maximum number of threads encrypting the chunks passed in a single update
+     * @return handle of the stream
+     */
+    int64_t openSymmetricEncryptionStream(
+        const core::Buffer& symmetricKey,
+        const int64_t chunkSize = DEFAULT_SYMMETRIC_STREAM_CHUNK_SIZE,
+        const int64_t maxThreads = 1
+    );
+
+    /**
+     * Opens a stream decrypting data encrypted by an encryption stream.
+     * Every chunk is verified before it is released, and the completeness of the data is verified when the stream is finalized.
+     *
+     * @param symmetricKey key used to decrypt data
+     * @param maxThreads maximum number of threads decrypting the chunks passed in a single update
+     * @return handle of the stream
+     */
+    int64_t openSymmetricDecryptionStream(const core::Buffer& symmetricKey, const int64_t maxThreads = 1);
+
+    /**
+     * Passes the next part of data of any size to a stream.
+     * The stream is closed if the data cannot be processed.
+     *
+     * @param streamHandle handle of the stream
+     * @param data next part of data to encrypt or decrypt
+     * @return part of the output ready so far, may be empty
+     */
+    core::Buffer updateSymmetricStream(const int64_t streamHandle, const core::Buffer& data);
+
+    /**
+     * Finishes and closes a stream. Decryption of truncated or modified data fails here.
+     *
+     * @param streamHandle handle of the stream
+     * @return the rest of the output
+     */
+    core::Buffer finalizeSymmetricStream(const int64_t streamHandle);
+
+    /**
+     * Closes a stream without finishing it and wipes its key. Use it to abort a stream which is not finalized.
+     *
+     * @param streamHandle handle of the stream
+     */
+    void closeSymmetricStream(const int64_t streamHandle);
+
+    /**
+     * Encrypts a file with a given key using an encryption stream, without loading the whole file into memory.
+     *
+     * @param inputPath path of the file to encrypt
+     * @param outputPath path of the encrypted file to write
+     * @param symmetricKey key used to encrypt data
+     * @param maxThreads maximum number of threads encrypting the chunks
+     */
+    void encryptFileSymmetric(
+        const std::string& inputPath,
+        const std::string& outputPath,
+        const core::Buffer& symmetricKey,
+        const int64_t maxThreads = 1
+    );
+
+    /**
+     * Decrypts a file encrypted by encryptFileSymmetric() or an encryption stream.
+     * The output file is removed if the data cannot be verified.
+     *
+     * @param inputPath path of the file to decrypt
+     * @param outputPath path of the plain file to write
+     * @param symmetricKey key used to decrypt data
+     * @param maxThreads maximum number of threads decrypting the chunks
+     */
+    void decryptFileSymmetric(
+        const std::string& inputPath,
+        const std::string& outputPath,
+        const core::Buffer& symmetricKey,
+        const int64_t maxThreads = 1
+    );
+
     /**
      * Converts given private key in PEM format to its WIF format.
      *
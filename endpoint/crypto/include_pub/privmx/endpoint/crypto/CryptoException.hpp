@@ -0,0 +1,52 @@
+#ifndef _PRIVMXLIB_ENDPOINT_CRYPTO_EXT_EXCEPTION_HPP_
+#define _PRIVMXLIB_ENDPOINT_CRYPTO_EXT_EXCEPTION_HPP_
+
+
+#include "privmx/endpoint/core/Exception.hpp"
+
+#define DECLARE_SCOPE_ENDPOINT_EXCEPTION(NAME, MSG, SCOPE, CODE, ...)                                            \
+    class NAME : public privmx::endpoint::core::Exception {                                                      \
+    public:                                                                                                      \
+        NAME() : privmx::endpoint::core::Exception(MSG, #NAME, SCOPE, (CODE << 16)) {}                           \
+        NAME(const std::string& msg, const std::string& name, unsigned int code)                                 \
+            : privmx::endpoint::core::Exception(msg, name, SCOPE, (CODE << 16) | code, std::string()) {}         \
+        NAME(const std::string& msg, const std::string& name, unsigned int code, const std::string& description) \
+            : privmx::endpoint::core::Exception(msg, name, SCOPE, (CODE << 16) | code, description) {}           \
+        void rethrow() const override;                                                                           \
+    };                                                                                                           \
+    inline void NAME::rethrow() const {                                                                          \
+        throw *this;                                                                                             \
+    };
+
+#define DECLARE_ENDPOINT_EXCEPTION(BASE_SCOPED, NAME, MSG, CODE, ...)                                            \
+    class NAME : public BASE_SCOPED {                                                                            \
+    public:                                                                                                      \
+        NAME() : BASE_SCOPED(MSG, #NAME, CODE) {}                                                                \
+        NAME(const std::string& new_of_description) : BASE_SCOPED(MSG, #NAME, CODE, new_of_description) {}       \
+        void rethrow() const override;                                                                           \
+    };                                                                                                           \
+    inline void NAME::rethrow() const {                                                                          \
+        throw *this;                                                                                             \
+    };
+
+namespace privmx {
+namespace endpoint {
+namespace crypto {
+
+#define ENDPOINT_CRYPTO_EXCEPTION_CODE 0x000A0000
+
+DECLARE_SCOPE_ENDPOINT_EXCEPTION(EndpointCryptoApiException, "Unknown endpoint crypto exception", "CryptoApi", 0x000A)
+DECLARE_ENDPOINT_EXCEPTION(EndpointCryptoApiException, SymmetricStreamNotFoundException, "Symmetric stream with given handle not found", 0x0001)
+DECLARE_ENDPOINT_EXCEPTION(EndpointCryptoApiException, InvalidSymmetricStreamChunkSizeException, "Invalid chunk size of symmetric stream", 0x0002)
+DECLARE_ENDPOINT_EXCEPTION(EndpointCryptoApiException, InvalidSymmetricStreamHeaderException, "Invalid header of symmetric stream", 0x0003)
+DECLARE_ENDPOINT_EXCEPTION(EndpointCryptoApiException, SymmetricStreamChunkChecksumException, "Invalid checksum of symmetric stream chunk", 0x0004)
+DECLARE_ENDPOINT_EXCEPTION(EndpointCryptoApiException, SymmetricStreamTagMismatchException, "Symmetric stream truncated or modified", 0x0005)
+
+} // crypto
+} // endpoint
+} // privmx
+
+#undef DECLARE_SCOPE_ENDPOINT_EXCEPTION
+#undef DECLARE_ENDPOINT_EXCEPTION
+
+#endif // _PRIVMXLIB_ENDPOINT_CRYPTO_EXT_EXCEPTION_HPP_
@@ -11,6 +11,7 @@ limitations under the License.
 
 #include "privmx/endpoint/crypto/CryptoApi.hpp"
 #include "privmx/endpoint/crypto/CryptoApiImpl.hpp"
+#include "privmx/endpoint/crypto/CryptoException.hpp"
 #include "privmx/endpoint/core/Validator.hpp"
 #include "privmx/endpoint/core/ExceptionConverter.hpp"
 #include <privmx/utils/Logger.hpp>
@@ -111,6 +112,80 @@ core::Buffer CryptoApi::decryptDataSymmetric(const core::Buffer& data, const cor
     }
 }
 
+int64_t CryptoApi::openSymmetricEncryptionStream(const core::Buffer& symmetricKey, const int64_t chunkSize, const int64_t maxThreads) {
+    core::Validator::validateBufferSize(symmetricKey, 32, 32, "field:symmetricKey ");
+    if(chunkSize <= 0 || static_cast<uint64_t>(chunkSize) > SymmetricStream::MAX_CHUNK_SIZE) {
+        throw InvalidSymmetricStreamChunkSizeException();
+    }
+    core::Validator::validateNumberPositive(maxThreads, "field:maxThreads ");
+    try {
+        return _impl->openSymmetricEncryptionStream(symmetricKey, chunkSize, maxThreads);
+    } catch (const privmx::utils::PrivmxException& e) {
+        core::ExceptionConverter::rethrowAsCoreException(e);
+        throw core::Exception("ExceptionConverter rethrow error");
+    }
+}
+
+int64_t CryptoApi::openSymmetricDecryptionStream(const core::Buffer& symmetricKey, const int64_t maxThreads) {
+    core::Validator::validateBufferSize(symmetricKey, 32, 32, "field:symmetricKey ");
+    core::Validator::validateNumberPositive(maxThreads, "field:maxThreads ");
+    try {
+        return _impl->openSymmetricDecryptionStream(symmetricKey, maxThreads);
+    } catch (const privmx::utils::PrivmxException& e) {
+        core::ExceptionConverter::rethrowAsCoreException(e);
+        throw core::Exception("ExceptionConverter rethrow error");
+    }
+}
+
+core::Buffer CryptoApi::updateSymmetricStream(const int64_t streamHandle, const core::Buffer& data) {
+    try {
+        return _impl->updateSymmetricStream(streamHandle, data);
+    } catch (const privmx::utils::PrivmxException& e) {
+        core::ExceptionConverter::rethrowAsCoreException(e);
+        throw core::Exception("ExceptionConverter rethrow error");
+    }
+}
+
+core::Buffer CryptoApi::finalizeSymmetricStream(const int64_t streamHandle) {
+    try {
+        return _impl->finalizeSymmetricStream(streamHandle);
+    } catch (const privmx::utils::PrivmxException& e) {
+        core::ExceptionConverter::rethrowAsCoreException(e);
+        throw core::Exception("ExceptionConverter rethrow error");
+    }
+}
+
+void CryptoApi::closeSymmetricStream(const int64_t streamHandle) {
+    try {
+        _impl->closeSymmetricStream(streamHandle);
+    } catch (const privmx::utils::PrivmxException& e) {
+        core::ExceptionConverter::rethrowAsCoreException(e);
+        throw core::Exception("ExceptionConverter rethrow error");
+    }
+}
+
+void CryptoApi::encryptFileSymmetric(const std::string& inputPath, const std::string& outputPath, const core::Buffer& symmetricKey, const int64_t maxThreads) {
+    core::Validator::validateBufferSize(symmetricKey, 32, 32, "field:symmetricKey ");
+    core::Validator::validateNumberPositive(maxThreads, "field:maxThreads ");
+    try {
+        _impl->encryptFileSymmetric(inputPath, outputPath, symmetricKey, maxThreads);
+    } catch (const privmx::utils::PrivmxException& e) {
+        core::ExceptionConverter::rethrowAsCoreException(e);
+        throw core::Exception("ExceptionConverter rethrow error");
+    }
+}
+
+void CryptoApi::decryptFileSymmetric(const std::string& inputPath, const std::string& outputPath, const core::Buffer& symmetricKey, const int64_t maxThreads) {
+    core::Validator::validateBufferSize(symmetricKey, 32, 32, "field:symmetricKey ");
+    core::Validator::validateNumberPositive(maxThreads, "field:maxThreads ");
+    try {
+        _impl->decryptFileSymmetric(inputPath, outputPath, symmetricKey, maxThreads);
+    } catch (const privmx::utils::PrivmxException& e) {
+        core::ExceptionConverter::rethrowAsCoreException(e);
+        throw core::Exception("ExceptionConverter rethrow error");
+    }
+}
+
 std::string CryptoApi::convertPEMKeytoWIFKey(const std::string& pemKey) {
     try {
         return _impl->convertPEMKeytoWIFKey(pemKey);
@@ -14,8 +14,10 @@ limitations under the License.
 #include <privmx/crypto/ecc/ExtKey.hpp>
 #include <privmx/crypto/ecc/PrivateKey.hpp>
 #include <privmx/crypto/BIP39.hpp>
+#include <privmx/endpoint/store/LocalFile.hpp>
 
 #include "privmx/endpoint/crypto/CryptoApiImpl.hpp"
+#include "privmx/endpoint/crypto/CryptoException.hpp"
 #include "privmx/endpoint/crypto/KeyConverter.hpp"
 using namespace privmx::endpoint;
 using namespace privmx::endpoint::crypto;
@@ -23,7 +25,7 @@ using namespace privmx::endpoint::crypto;
 core::Buffer CryptoApiImpl::signData(const core::Buffer& data, const std::string& key) {
     auto privKey {privmx::crypto::PrivateKey::fromWIF(key)};
     auto sign {privKey.signToCompactSignatureWithHash(data.stdString())};
-    return core::Buffer::from(sign);
+    return core::Buffer::from(std::move(sign));
 }
 
 bool CryptoApiImpl::verifySignature(const core::Buffer& data, const core::Buffer& signature, const std::string& key) {
@@ -60,19 +62,106 @@ std::string CryptoApiImpl::derivePublicKey(const std::string& privkey) {
 
 core::Buffer CryptoApiImpl::generateKeySymmetric() {
     auto key {privmx::crypto::Crypto::randomBytes(32)};
-    return core::Buffer::from(key);
+    return core::Buffer::from(std::move(key));
 }
 
 core::Buffer CryptoApiImpl::encryptDataSymmetric(const core::Buffer& data, const core::Buffer& key) {
     auto cipher { privmx::crypto::CryptoPrivmx::privmxEncrypt(
         privmx::crypto::CryptoPrivmx::privmxOptAesWithSignature(), data.stdString(), key.stdString())
     };
-    return core::Buffer::from(cipher);
+    return core::Buffer::from(std::move(cipher));
 }
 
 core::Buffer CryptoApiImpl::decryptDataSymmetric(const core::Buffer& data, const core::Buffer& key) {
     auto decrypted { privmx::crypto::CryptoPrivmx::privmxDecrypt(true, data.stdString(), key.stdString()) };
-    return core::Buffer::from(decrypted);
+    return core::Buffer::from(std::move(decrypted));
+}
+
+int64_t CryptoApiImpl::openSymmetricEncryptionStream(const core::Buffer& key, size_t chunkSize, size_t maxThreads) {
+    return addSymmetricStream(std::make_shared<SymmetricStreamEncryptor>(key.stdString(), chunkSize, maxThreads));
+}
+
+int64_t CryptoApiImpl::openSymmetricDecryptionStream(const core::Buffer& key, size_t maxThreads) {
+    return addSymmetricStream(std::make_shared<SymmetricStreamDecryptor>(key.stdString(), maxThreads));
+}
+
+core::Buffer CryptoApiImpl::updateSymmetricStream(int64_t streamHandle, const core::Buffer& data) {
+    auto stream = getSymmetricStream(streamHandle);
+    std::unique_lock lock(stream->mutex);
+    if(stream->isWiped()) {
+        throw SymmetricStreamNotFoundException();
+    }
+    try {
+        return core::Buffer::from(stream->update(data.view()));
+    } catch (...) {
+        // a stream which failed verification cannot be continued
+        _symmetricStreams.erase(streamHandle);
+        throw;
+    }
+}
+
+core::Buffer CryptoApiImpl::finalizeSymmetricStream(int64_t streamHandle) {
+    auto stream = getSymmetricStream(streamHandle);
+    // the stream is closed even if its verification fails
+    _symmetricStreams.erase(streamHandle);
+    std::unique_lock lock(stream->mutex);
+    if(stream->isWiped()) {
+        throw SymmetricStreamNotFoundException();
+    }
+    return core::Buffer::from(stream->finalize());
+}
+
+void CryptoApiImpl::closeSymmetricStream(int64_t streamHandle) {
+    auto stream = getSymmetricStream(streamHandle);
+    _symmetricStreams.erase(streamHandle);
+    // the key is wiped now, not when the last call still holding the stream returns
+    std::unique_lock lock(stream->mutex);
+    stream->wipe();
+}
+
+void CryptoApiImpl::encryptFileSymmetric(const std::string& inputPath, const std::string& outputPath, const core::Buffer& key, size_t maxThreads) {
+    SymmetricStreamEncryptor stream(key.stdString(), SymmetricStream::DEFAULT_CHUNK_SIZE, maxThreads);
+    processFile(inputPath, outputPath, stream);
+}
+
+void CryptoApiImpl::decryptFileSymmetric(const std::string& inputPath, const std::string& outputPath, const core::Buffer& key, size_t maxThreads) {
+    SymmetricStreamDecryptor stream(key.stdString(), maxThreads);
+    processFile(inputPath, outputPath, stream);
+}
+
+int64_t CryptoApiImpl::addSymmetricStream(const std::shared_ptr<SymmetricStream>& stream) {
+    int64_t handle = _nextSymmetricStreamHandle.fetch_add(1);
+    _symmetricStreams.set(handle, stream);
+    return handle;
+}
+
+std::shared_ptr<SymmetricStream> CryptoApiImpl::getSymmetricStream(int64_t streamHandle) {
+    auto stream = _symmetricStreams.get(streamHandle);
+    if(!stream.has_value()) {
+        throw SymmetricStreamNotFoundException();
+    }
+    return stream.value();
+}
+
+void CryptoApiImpl::processFile(const std::string& inputPath, const std::string& outputPath, SymmetricStream& stream) {
+    store::LocalFileReader input(inputPath);
+    // the output size is not known up front, the file grows as the chunks are appended
+    store::LocalFileWriter output(outputPath, 0);
+    try {
+        uint64_t offset = 0;
+        std::string data;
+        while(!(data = input.read(FILE_READ_CHUNKS * SymmetricStream::DEFAULT_CHUNK_SIZE)).empty()) {
+            auto processed = stream.update(data);
+            output.writeAt(offset, processed);
+            offset += processed.size();
+        }
+        output.writeAt(offset, stream.finalize());
+        output.close();
+    } catch (...) {
+        // no partially written or unverified data is left behind
+        output.discard();
+        throw;
+    }
 }
 
 privmx::crypto::PrivateKey CryptoApiImpl::getPrivKeyFromSeed(const std::string& seed, size_t rounds) {
@@ -0,0 +1,225 @@
+/*
+PrivMX Endpoint.
+Copyright © 2024 Simplito sp. z o.o.
+
+This file is part of the PrivMX Platform (https://privmx.dev).
+This software is Licensed under the PrivMX Free License.
+
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <privmx/crypto/Crypto.hpp>
+#include <privmx/utils/ParallelFor.hpp>
+
+#include "privmx/endpoint/crypto/CryptoException.hpp"
+#include "privmx/endpoint/crypto/SymmetricStream.hpp"
+
+using namespace privmx::endpoint::crypto;
+
+SymmetricStream::SymmetricStream(const std::string& key, size_t maxThreads) : _key(key), _maxThreads(maxThreads) {}
+
+SymmetricStream::~SymmetricStream() {
+    wipe();
+}
+
+void SymmetricStream::wipe() {
+    erase(_key);
+    erase(_streamKey);
+    _wiped = true;
+}
+
+void SymmetricStream::erase(std::string& secret) {
+    // volatile access keeps the compiler from dropping the stores to memory which is about to be freed
+    volatile char* ptr = secret.data();
+    for (size_t i = 0; i < secret.size(); ++i) {
+        ptr[i] = 0;
+    }
+    secret.clear();
+}
+
+size_t SymmetricStream::getEncryptedChunkSize(size_t plainSize) {
+    // PKCS7 always adds from 1 to 16 bytes of padding
+    return HMAC_SIZE + IV_SIZE + plainSize + (16 - plainSize % 16);
+}
+
+void SymmetricStream::init(const std::string& salt, size_t chunkSize) {
+    _streamKey = privmx::crypto::Crypto::sha256(_key + salt);
+    _chunkSize = chunkSize;
+}
+
+std::string SymmetricStream::getChunkKey(uint64_t index) const {
+    return privmx::crypto::Crypto::sha256(_streamKey + toBE(index));
+}
+
+void SymmetricStream::addToTag(std::string_view chunkHmac, size_t plainSize) {
+    _tagChain = privmx::crypto::Crypto::sha256(_tagChain + std::string(chunkHmac));
+    _chunksCount++;
+    _plainSize += plainSize;
+}
+
+std::string SymmetricStream::getTag() const {
+    return privmx::crypto::Crypto::hmacSha256(_streamKey, "tag" + _tagChain + toBE(_chunksCount) + toBE(_plainSize));
+}
+
+std::string SymmetricStream::toBE(uint64_t value) {
+    std::string result(8, '\0');
+    for(int i = 7; i >= 0; i--) {
+        result[i] = static_cast<char>(value & 0xFF);
+        value >>= 8;
+    }
+    return result;
+}
+
+SymmetricStreamEncryptor::SymmetricStreamEncryptor(const std::string& key, size_t chunkSize, size_t maxThreads)
+    : SymmetricStream(key, maxThreads) {
+    if(chunkSize == 0 || chunkSize > MAX_CHUNK_SIZE) {
+        throw InvalidSymmetricStreamChunkSizeException();
+    }
+    auto salt = privmx::crypto::Crypto::randomBytes(SALT_SIZE);
+    init(salt, chunkSize);
+    _header.push_back(static_cast<char>(FORMAT_VERSION));
+    _header.append(toBE(chunkSize).substr(4));
+    _header.append(salt);
+}
+
+std::string SymmetricStreamEncryptor::update(std::string_view data) {
+    std::string result = std::move(_header);
+    _header.clear();
+    std::vector<std::string_view> chunks;
+    if(!_pending.empty()) {
+        auto missing = std::min(_chunkSize - _pending.size(), data.size());
+        _pending.append(data.substr(0, missing));
+        data.remove_prefix(missing);
+        if(_pending.size() < _chunkSize) {
+            return result;
+        }
+        chunks.push_back(_pending);
+    }
+    while(data.size() >= _chunkSize) {
+        chunks.push_back(data.substr(0, _chunkSize));
+        data.remove_prefix(_chunkSize);
+    }
+    result.append(encryptChunks(chunks));
+    _pending.assign(data);
+    return result;
+}
+
+std::string SymmetricStreamEncryptor::finalize() {
+    std::string result = std::move(_header);
+    _header.clear();
+    if(!_pending.empty()) {
+        result.append(encryptChunks({_pending}));
+        _pending.clear();
+    }
+    result.append(getTag());
+    return result;
+}
+
+std::string SymmetricStreamEncryptor::encryptChunks(const std::vector<std::string_view>& chunks) {
+    std::vector<std::string> encrypted(chunks.size());
+    auto firstIndex = _chunksCount;
+    privmx::utils::ParallelFor::run(chunks.size(), [&](size_t i) {
+        encrypted[i] = encryptChunk(firstIndex + i, chunks[i]);
+    }, _maxThreads);
+    std::string result;
+    result.reserve(chunks.size() * getEncryptedChunkSize(_chunkSize));
+    for(size_t i = 0; i < chunks.size(); i++) {
+        addToTag(std::string_view(encrypted[i]).substr(0, HMAC_SIZE), chunks[i].size());
+        result.append(encrypted[i]);
+    }
+    return result;
+}
+
+std::string SymmetricStreamEncryptor::encryptChunk(uint64_t index, std::string_view data) {
+    std::string chunkKey = getChunkKey(index);
+    std::string iv = privmx::crypto::Crypto::randomBytes(IV_SIZE);
+    std::string ivWithCipher = iv + privmx::crypto::Crypto::aes256CbcPkcs7Encrypt(std::string(data), chunkKey, iv);
+    return privmx::crypto::Crypto::hmacSha256(chunkKey, ivWithCipher) + ivWithCipher;
+}
+
+SymmetricStreamDecryptor::SymmetricStreamDecryptor(const std::string& key, size_t maxThreads) : SymmetricStream(key, maxThreads) {}
+
+std::string SymmetricStreamDecryptor::update(std::string_view data) {
+    _buffer.append(data);
+    if(!_headerRead && !readHeader()) {
+        return std::string();
+    }
+    // the last chunk and the tag are kept until the end of the stream is known
+    auto encryptedChunkSize = getEncryptedChunkSize(_chunkSize);
+    std::vector<std::string_view> chunks;
+    std::string_view available(_buffer);
+    while(available.size() > encryptedChunkSize + TAG_SIZE) {
+        chunks.push_back(available.substr(0, encryptedChunkSize));
+        available.remove_prefix(encryptedChunkSize);
+    }
+    auto result = decryptChunks(chunks);
+    _buffer.erase(0, chunks.size() * encryptedChunkSize);
+    return result;
+}
+
+std::string SymmetricStreamDecryptor::finalize() {
+    if(!_headerRead && !readHeader()) {
+        throw InvalidSymmetricStreamHeaderException();
+    }
+    if(_buffer.size() < TAG_SIZE) {
+        throw SymmetricStreamTagMismatchException();
+    }
+    std::string_view lastChunk = std::string_view(_buffer).substr(0, _buffer.size() - TAG_SIZE);
+    std::string result;
+    if(!lastChunk.empty()) {
+        if(lastChunk.size() < getEncryptedChunkSize(0) || lastChunk.size() > getEncryptedChunkSize(_chunkSize)) {
+            throw SymmetricStreamChunkChecksumException();
+        }
+        result = decryptChunks({lastChunk});
+    }
+    if(getTag() != _buffer.substr(_buffer.size() - TAG_SIZE)) {
+        throw SymmetricStreamTagMismatchException();
+    }
+    _buffer.clear();
+    return result;
+}
+
+bool SymmetricStreamDecryptor::readHeader() {
+    if(_buffer.size() < HEADER_SIZE) {
+        return false;
+    }
+    if(static_cast<uint8_t>(_buffer[0]) != FORMAT_VERSION) {
+        throw InvalidSymmetricStreamHeaderException();
+    }
+    size_t chunkSize = 0;
+    for(size_t i = 1; i < 5; i++) {
+        chunkSize = (chunkSize << 8) | static_cast<uint8_t>(_buffer[i]);
+    }
+    if(chunkSize == 0 || chunkSize > MAX_CHUNK_SIZE) {
+        throw InvalidSymmetricStreamHeaderException();
+    }
+    init(_buffer.substr(5, SALT_SIZE), chunkSize);
+    _buffer.erase(0, HEADER_SIZE);
+    _headerRead = true;
+    return true;
+}
+
+std::string SymmetricStreamDecryptor::decryptChunks(const std::vector<std::string_view>& chunks) {
+    std::vector<std::string> decrypted(chunks.size());
+    auto firstIndex = _chunksCount;
+    privmx::utils::ParallelFor::run(chunks.size(), [&](size_t i) {
+        decrypted[i] = decryptChunk(firstIndex + i, chunks[i]);
+    }, _maxThreads);
+    std::string result;
+    result.reserve(chunks.size() * _chunkSize);
+    for(size_t i = 0; i < chunks.size(); i++) {
+        addToTag(chunks[i].substr(0, HMAC_SIZE), decrypted[i].size());
+        result.append(decrypted[i]);
+    }
+    return result;
+}
+
+std::string SymmetricStreamDecryptor::decryptChunk(uint64_t index, std::string_view data) {
+    std::string chunkKey = getChunkKey(index);
+    std::string ivWithCipher(data.substr(HMAC_SIZE));
+    if(privmx::crypto::Crypto::hmacSha256(chunkKey, ivWithCipher) != data.substr(0, HMAC_SIZE)) {
+        throw SymmetricStreamChunkChecksumException();
+    }
+    return privmx::crypto::Crypto::aes256CbcPkcs7Decrypt(ivWithCipher.substr(IV_SIZE), chunkKey, ivWithCipher.substr(0, IV_SIZE));
+}
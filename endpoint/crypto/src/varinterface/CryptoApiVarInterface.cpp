@@ -36,7 +36,14 @@ std::map<CryptoApiVarInterface::METHOD, Poco::Dynamic::Var (CryptoApiVarInterfac
                                         {EntropyToMnemonic, &CryptoApiVarInterface::entropyToMnemonic},
                                         {MnemonicToEntropy, &CryptoApiVarInterface::mnemonicToEntropy},
                                         {MnemonicToSeed, &CryptoApiVarInterface::mnemonicToSeed},
-                                        {ConvertPGPAsn1KeyToBase58DERKey, &CryptoApiVarInterface::convertPGPAsn1KeyToBase58DERKey}};
+                                        {ConvertPGPAsn1KeyToBase58DERKey, &CryptoApiVarInterface::convertPGPAsn1KeyToBase58DERKey},
+                                        {OpenSymmetricEncryptionStream, &CryptoApiVarInterface::openSymmetricEncryptionStream},
+                                        {OpenSymmetricDecryptionStream, &CryptoApiVarInterface::openSymmetricDecryptionStream},
+                                        {UpdateSymmetricStream, &CryptoApiVarInterface::updateSymmetricStream},
+                                        {FinalizeSymmetricStream, &CryptoApiVarInterface::finalizeSymmetricStream},
+                                        {EncryptFileSymmetric, &CryptoApiVarInterface::encryptFileSymmetric},
+                                        {DecryptFileSymmetric, &CryptoApiVarInterface::decryptFileSymmetric},
+                                        {CloseSymmetricStream, &CryptoApiVarInterface::closeSymmetricStream}};
 
 
 Poco::Dynamic::Var CryptoApiVarInterface::create(const Poco::Dynamic::Var& args) {
@@ -189,6 +196,65 @@ Poco::Dynamic::Var CryptoApiVarInterface::convertPGPAsn1KeyToBase58DERKey(const
     return _serializer.serialize(result);
 }
 
+Poco::Dynamic::Var CryptoApiVarInterface::openSymmetricEncryptionStream(const Poco::Dynamic::Var& args) {
+    auto argsArr = core::VarInterfaceUtil::validateAndExtractArray(args, 3);
+    auto key = _deserializer.deserialize<core::Buffer>(argsArr->get(0), "symmetricKey");
+    auto chunkSize = _deserializer.deserialize<int64_t>(argsArr->get(1), "chunkSize");
+    auto maxThreads = _deserializer.deserialize<int64_t>(argsArr->get(2), "maxThreads");
+    auto result = _cryptoApi.openSymmetricEncryptionStream(key, chunkSize, maxThreads);
+    return _serializer.serialize(result);
+}
+
+Poco::Dynamic::Var CryptoApiVarInterface::openSymmetricDecryptionStream(const Poco::Dynamic::Var& args) {
+    auto argsArr = core::VarInterfaceUtil::validateAndExtractArray(args, 2);
+    auto key = _deserializer.deserialize<core::Buffer>(argsArr->get(0), "symmetricKey");
+    auto maxThreads = _deserializer.deserialize<int64_t>(argsArr->get(1), "maxThreads");
+    auto result = _cryptoApi.openSymmetricDecryptionStream(key, maxThreads);
+    return _serializer.serialize(result);
+}
+
+Poco::Dynamic::Var CryptoApiVarInterface::updateSymmetricStream(const Poco::Dynamic::Var& args) {
+    auto argsArr = core::VarInterfaceUtil::validateAndExtractArray(args, 2);
+    auto streamHandle = _deserializer.deserialize<int64_t>(argsArr->get(0), "streamHandle");
+    auto data = _deserializer.deserialize<core::Buffer>(argsArr->get(1), "data");
+    auto result = _cryptoApi.updateSymmetricStream(streamHandle, data);
+    return _serializer.serialize(result);
+}
+
+Poco::Dynamic::Var CryptoApiVarInterface::finalizeSymmetricStream(const Poco::Dynamic::Var& args) {
+    auto argsArr = core::VarInterfaceUtil::validateAndExtractArray(args, 1);
+    auto streamHandle = _deserializer.deserialize<int64_t>(argsArr->get(0), "streamHandle");
+    auto result = _cryptoApi.finalizeSymmetricStream(streamHandle);
+    return _serializer.serialize(result);
+}
+
+Poco::Dynamic::Var CryptoApiVarInterface::encryptFileSymmetric(const Poco::Dynamic::Var& args) {
+    auto argsArr = core::VarInterfaceUtil::validateAndExtractArray(args, 4);
+    auto inputPath = _deserializer.deserialize<std::string>(argsArr->get(0), "inputPath");
+    auto outputPath = _deserializer.deserialize<std::string>(argsArr->get(1), "outputPath");
+    auto key = _deserializer.deserialize<core::Buffer>(argsArr->get(2), "symmetricKey");
+    auto maxThreads = _deserializer.deserialize<int64_t>(argsArr->get(3), "maxThreads");
+    _cryptoApi.encryptFileSymmetric(inputPath, outputPath, key, maxThreads);
+    return {};
+}
+
+Poco::Dynamic::Var CryptoApiVarInterface::decryptFileSymmetric(const Poco::Dynamic::Var& args) {
+    auto argsArr = core::VarInterfaceUtil::validateAndExtractArray(args, 4);
+    auto inputPath = _deserializer.deserialize<std::string>(argsArr->get(0), "inputPath");
+    auto outputPath = _deserializer.deserialize<std::string>(argsArr->get(1), "outputPath");
+    auto key = _deserializer.deserialize<core::Buffer>(argsArr->get(2), "symmetricKey");
+    auto maxThreads = _deserializer.deserialize<int64_t>(argsArr->get(3), "maxThreads");
+    _cryptoApi.decryptFileSymmetric(inputPath, outputPath, key, maxThreads);
+    return {};
+}
+
+Poco::Dynamic::Var CryptoApiVarInterface::closeSymmetricStream(const Poco::Dynamic::Var& args) {
+    auto argsArr = core::VarInterfaceUtil::validateAndExtractArray(args, 1);
+    auto streamHandle = _deserializer.deserialize<int64_t>(argsArr->get(0), "streamHandle");
+    _cryptoApi.closeSymmetricStream(streamHandle);
+    return {};
+}
+
 Poco::Dynamic::Var CryptoApiVarInterface::exec(METHOD method, const Poco::Dynamic::Var& args) {
     auto it = methodMap.find(method);
     if (it == methodMap.end()) {
@@ -2,6 +2,9 @@
 #define _PRIVMXLIB_ENDPOINT_EVENT_EVENTAPI_IMPL_HPP_
 
 #include <atomic>
+#include <map>
+#include <mutex>
+#include <optional>
 #include <privmx/crypto/ecc/PrivateKey.hpp>
 #include <privmx/privfs/gateway/RpcGateway.hpp>
 #include <privmx/endpoint/core/encryptors/DataEncryptorV4.hpp>
@@ -41,11 +44,35 @@ public:
     void unsubscribeFromInternal(const std::vector<std::string>& subscriptionIds, int notificationListenerId);
     std::string buildSubscriptionQuery(const std::string& channelName, EventSelectorType selectorType, const std::string& selectorId);
     std::string buildSubscriptionQueryInternal(EventSelectorType selectorType, const std::string& selectorId);
+    void enableChannelSession(const std::string& contextId, const std::string& channelName, const int64_t maxEvents, const int64_t maxAge);
+    void disableChannelSession(const std::string& contextId, const std::string& channelName);
 private:
+    struct ChannelSession {
+        int64_t maxEvents;
+        int64_t maxAge;
+        std::string keyId;
+        std::string key;
+        std::string audience;
+        int64_t eventsCount;
+        int64_t createDate;
+        bool keyDelivered;
+        int64_t wrapDate;
+    };
+    struct ChannelSessionKey {
+        std::string keyId;
+        std::string key;
+        bool wrap;
+    };
+
     void processNotificationEvent(const std::string& type, const core::NotificationEvent& notification);
     void processConnectedEvent();
     void processDisconnectedEvent();
     void emitEventEx(const std::string& contextId, const std::vector<core::UserWithPubKey>& users, const std::string& channelName, Poco::Dynamic::Var encryptedEventData, const std::string &encryptionKey);
+    void emitEventEx(const std::string& contextId, const std::vector<server::UserKey>& userKeys, const std::string& channelName, Poco::Dynamic::Var encryptedEventData);
+    std::optional<ChannelSessionKey> getChannelSessionKey(const std::string& contextId, const std::vector<core::UserWithPubKey>& users, const std::string& channelName);
+    void setChannelSessionKeyDelivered(const std::string& contextId, const std::string& channelName, const std::string& keyId, bool delivered);
+    static std::string getChannelSessionId(const std::string& contextId, const std::string& channelName);
+    static std::string getAudienceHash(const std::vector<core::UserWithPubKey>& users);
     void validateChannelName(const std::string& channelName);
     bool verifyDecryptedEventDataV5(const DecryptedEventDataV5& data);
     core::Connection _connection;
@@ -61,6 +88,10 @@ private:
     EventDataEncryptorV5 _eventDataEncryptorV5;
     OldEventDataDecryptor _oldEventDataDecryptor;
     std::shared_ptr<privmx::utils::GuardedExecutor> _guardedExecutor;
+    std::mutex _channelSessionsMutex;
+    std::map<std::string, ChannelSession> _channelSessions;
+
+    static constexpr int64_t CHANNEL_SESSION_REWRAP_INTERVAL = 10000; // 10s
 };
 
 }  // namespace event
@@ -12,6 +12,12 @@ limitations under the License.
 #ifndef _PRIVMXLIB_ENDPOINT_EVENT_EVENTKEYPROVIDER_HPP_
 #define _PRIVMXLIB_ENDPOINT_EVENT_EVENTKEYPROVIDER_HPP_
 
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
 #include <privmx/crypto/ecc/PrivateKey.hpp>
 #include <privmx/endpoint/core/CoreTypes.hpp>
 #include <privmx/endpoint/core/ServerTypes.hpp>
@@ -36,8 +42,23 @@ public:
         const std::vector<core::UserWithPubKey>& users, 
         const std::string& key
     );
+    std::string generateKeyId();
+    // key is wrapped for the users only when given, otherwise the users get a reference to the previously sent key
+    std::vector<server::UserKey> prepareSessionKeysList(
+        const std::vector<core::UserWithPubKey>& users, 
+        const std::string& keyId,
+        const std::optional<std::string>& key
+    );
 private:
+    std::string decryptSessionKey(const std::string& encryptedKey, const privmx::crypto::PublicKey& authorPubKey);
+
     privmx::crypto::PrivateKey _key;
+    std::mutex _sessionKeysMutex;
+    std::unordered_map<std::string, std::string> _sessionKeys;
+    std::deque<std::string> _sessionKeysOrder;
+
+    inline static const std::string SESSION_KEY_PREFIX = "s1:";
+    static constexpr size_t MAX_SESSION_KEYS = 1024;
 };
 
 }  // namespace core
@@ -34,6 +34,8 @@ public:
         SubscribeFor = 4,
         UnsubscribeFrom = 5,
         BuildSubscriptionQuery = 6,
+        EnableChannelSession = 7,
+        DisableChannelSession = 8,
     };
 
     EventApiVarInterface(core::Connection connection, const core::VarSerializer& serializer)
@@ -44,6 +46,8 @@ public:
     Poco::Dynamic::Var subscribeFor(const Poco::Dynamic::Var& args);
     Poco::Dynamic::Var unsubscribeFrom(const Poco::Dynamic::Var& args);
     Poco::Dynamic::Var buildSubscriptionQuery(const Poco::Dynamic::Var& args);
+    Poco::Dynamic::Var enableChannelSession(const Poco::Dynamic::Var& args);
+    Poco::Dynamic::Var disableChannelSession(const Poco::Dynamic::Var& args);
 
     Poco::Dynamic::Var exec(METHOD method, const Poco::Dynamic::Var& args);
 
@@ -68,6 +68,28 @@ public:
      */
     std::string buildSubscriptionQuery(const std::string& channelName, EventSelectorType selectorType, const std::string& selectorId);
 
+    /**
+     * Enables the channel session mode for events emitted on the given Context and channel.
+     * Instead of a new key per event, a session key is wrapped once for the recipients and then referenced by its ID
+     * in the following events. The key is rotated when the list of recipients changes or when one of the limits is reached.
+     * The current key is also wrapped again in an event every 10 seconds, so recipients which subscribe later
+     * can decrypt events after at most that long, or after maxAge if it is shorter.
+     *
+     * @param contextId ID of the Context
+     * @param channelName name of the Channel
+     * @param maxEvents number of events after which the key is rotated (0 - no limit)
+     * @param maxAge time in milliseconds after which the key is rotated (must be greater than 0)
+     */
+    void enableChannelSession(const std::string& contextId, const std::string& channelName, const int64_t maxEvents, const int64_t maxAge);
+
+    /**
+     * Disables the channel session mode for the given Context and channel.
+     *
+     * @param contextId ID of the Context
+     * @param channelName name of the Channel
+     */
+    void disableChannelSession(const std::string& contextId, const std::string& channelName);
+
 private:
     EventApi(const std::shared_ptr<EventApiImpl>& impl);
 };
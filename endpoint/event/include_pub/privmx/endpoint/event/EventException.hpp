@@ -43,6 +43,8 @@ DECLARE_ENDPOINT_EXCEPTION(EndpointEventException, NotSubscribedException, "Not
 DECLARE_ENDPOINT_EXCEPTION(EndpointEventException, AlreadySubscribedException, "Already subscribed", 0x0005)
 DECLARE_ENDPOINT_EXCEPTION(EndpointEventException, InvalidEncryptedEventDataVersionException, "Invalid version of encrypted event data", 0x0005)
 DECLARE_ENDPOINT_EXCEPTION(EndpointEventException, InvalidSubscriptionQueryException, "Invalid subscriptionQuery", 0x0006)
+DECLARE_ENDPOINT_EXCEPTION(EndpointEventException, EventSessionKeyNotFoundException, "Channel session key not found", 0x0007)
+DECLARE_ENDPOINT_EXCEPTION(EndpointEventException, InvalidChannelSessionConfigException, "Invalid channel session config", 0x0008)
 
 } // event
 } // endpoint
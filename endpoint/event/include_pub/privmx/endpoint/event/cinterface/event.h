@@ -13,6 +13,8 @@ typedef struct EventApi EventApi;
 int privmx_endpoint_newEventApi(Connection* connectionPtr, EventApi** outPtr);
 int privmx_endpoint_freeEventApi(EventApi* ptr);
 int privmx_endpoint_execEventApi(EventApi* ptr, int method, const pson_value* args, pson_value** res);
+int privmx_endpoint_eventEmitEvent(EventApi* ptr, const char* contextId, const privmx_user_with_pub_key* users, size_t usersCount,
+    const char* channelName, privmx_const_buffer eventData, privmx_error* error);
 
 #ifdef __cplusplus
 }
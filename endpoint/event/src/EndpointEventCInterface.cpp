@@ -12,6 +12,7 @@ limitations under the License.
 #include <functional>
 #include <string>
 #include <unordered_map>
+#include <vector>
 #include <Poco/Dynamic/Var.h>
 #include <Poco/JSON/Array.h>
 #include <Pson/BinaryString.hpp>
@@ -39,6 +40,32 @@ int privmx_endpoint_freeEventApi(EventApi* ptr) {
     return 1;
 }
 
+int privmx_endpoint_eventEmitEvent(EventApi* ptr, const char* contextId, const privmx_user_with_pub_key* users, size_t usersCount,
+    const char* channelName, privmx_const_buffer eventData, privmx_error* error)
+{
+    return CApiExecutor::execBinaryFunc(error, [&]{
+        CApiExecutor::assertNotNull(ptr, "ptr");
+        if(usersCount > 0) {
+            CApiExecutor::assertNotNull(users, "users");
+        }
+        event::EventApiVarInterface* _ptr = (event::EventApiVarInterface*)ptr;
+        std::vector<core::UserWithPubKey> usersList;
+        usersList.reserve(usersCount);
+        for(size_t i = 0; i < usersCount; ++i) {
+            usersList.push_back(core::UserWithPubKey{
+                .userId = CApiExecutor::toString(users[i].userId, "users[].userId"),
+                .pubKey = CApiExecutor::toString(users[i].pubKey, "users[].pubKey")
+            });
+        }
+        _ptr->getApi().emitEvent(
+            CApiExecutor::toString(contextId, "contextId"),
+            usersList,
+            CApiExecutor::toString(channelName, "channelName"),
+            CApiExecutor::toCoreBuffer(eventData, "eventData")
+        );
+    });
+}
+
 int privmx_endpoint_execEventApi(EventApi* ptr, int method, const pson_value* args, pson_value** res) {
     return CApiExecutor::execFunc(res, [&]{
         event::EventApiVarInterface* _ptr = (event::EventApiVarInterface*)ptr;
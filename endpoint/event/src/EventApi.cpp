@@ -92,3 +92,26 @@ std::string EventApi::buildSubscriptionQuery(const std::string& channelName, Eve
     }
 }
 
+void EventApi::enableChannelSession(const std::string& contextId, const std::string& channelName, const int64_t maxEvents, const int64_t maxAge) {
+    auto impl = getImpl();
+    core::Validator::validateId(contextId, "field:contextId ");
+    core::Validator::validateNumberNonNegative(maxEvents, "field:maxEvents ");
+    core::Validator::validateNumberPositive(maxAge, "field:maxAge ");
+    try {
+        return impl->enableChannelSession(contextId, channelName, maxEvents, maxAge);
+    } catch (const privmx::utils::PrivmxException& e) {
+        core::ExceptionConverter::rethrowAsCoreException(e);
+        throw core::Exception("ExceptionConverter rethrow error");
+    }
+}
+
+void EventApi::disableChannelSession(const std::string& contextId, const std::string& channelName) {
+    auto impl = getImpl();
+    core::Validator::validateId(contextId, "field:contextId ");
+    try {
+        return impl->disableChannelSession(contextId, channelName);
+    } catch (const privmx::utils::PrivmxException& e) {
+        core::ExceptionConverter::rethrowAsCoreException(e);
+        throw core::Exception("ExceptionConverter rethrow error");
+    }
+}
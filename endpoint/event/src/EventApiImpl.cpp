@@ -9,6 +9,8 @@ See the License for the specific language governing permissions and
 limitations under the License.
 */
 
+#include <algorithm>
+
 #include <privmx/endpoint/core/Exception.hpp>
 #include <privmx/endpoint/core/JsonSerializer.hpp>
 #include <privmx/endpoint/core/ExceptionConverter.hpp>
@@ -38,7 +40,7 @@ EventApiImpl::EventApiImpl(
     _serverApi(ServerApi(gateway)),
     _eventMiddleware(eventMiddleware),
     _forbiddenChannelsNames({INTERNAL_EVENT_CHANNEL_NAME}), 
-    _eventKeyProvider(EventKeyProvider(userPrivKey)),
+    _eventKeyProvider(userPrivKey),
     _subscriber(SubscriberImpl(gateway)),
     _guardedExecutor(std::make_shared<privmx::utils::GuardedExecutor>())
 {
@@ -60,7 +62,8 @@ EventApiImpl::~EventApiImpl() {
 
 void EventApiImpl::emitEvent(const std::string& contextId, const std::vector<core::UserWithPubKey>& users, const std::string& channelName, const core::Buffer& eventData) {
     validateChannelName(channelName);
-    auto key = _eventKeyProvider.generateKey();
+    auto sessionKey = getChannelSessionKey(contextId, users, channelName);
+    auto key = sessionKey.has_value() ? sessionKey->key : _eventKeyProvider.generateKey();
     auto toEncrypt = ContextEventDataToEncryptV5{
         ContextEventDataV5{
             .data = eventData,
@@ -68,7 +71,26 @@ void EventApiImpl::emitEvent(const std::string& contextId, const std::vector<cor
             .dio = _connection.getImpl()->createDIO(contextId, "")
         }
     };
-    emitEventEx(contextId, users, channelName, _eventDataEncryptorV5.encrypt(toEncrypt, _userPrivKey, key).toJSON(), key);
+    auto encryptedEventData = _eventDataEncryptorV5.encrypt(toEncrypt, _userPrivKey, key).toJSON();
+    if (!sessionKey.has_value()) {
+        emitEventEx(contextId, users, channelName, encryptedEventData, key);
+        return;
+    }
+    try {
+        auto userKeys = _eventKeyProvider.prepareSessionKeysList(
+            users,
+            sessionKey->keyId,
+            sessionKey->wrap ? std::make_optional(key) : std::nullopt
+        );
+        emitEventEx(contextId, userKeys, channelName, encryptedEventData);
+    } catch (...) {
+        // recipients may have missed the wrapped key, so the next event has to send a new one
+        setChannelSessionKeyDelivered(contextId, channelName, sessionKey->keyId, false);
+        throw;
+    }
+    if (sessionKey->wrap) {
+        setChannelSessionKeyDelivered(contextId, channelName, sessionKey->keyId, true);
+    }
 }
 
 void EventApiImpl::emitEventInternal(const std::string& contextId, InternalContextEventDataV1 event, const std::vector<core::UserWithPubKey>& users) {
@@ -190,15 +212,99 @@ void EventApiImpl::processDisconnectedEvent() {
 }
 
 void EventApiImpl::emitEventEx(const std::string& contextId, const std::vector<core::UserWithPubKey>& users, const std::string& channelName, Poco::Dynamic::Var encryptedEventData, const std::string &encryptionKey) {
+    emitEventEx(contextId, _eventKeyProvider.prepareKeysList(users, encryptionKey), channelName, encryptedEventData);
+}
+
+void EventApiImpl::emitEventEx(const std::string& contextId, const std::vector<server::UserKey>& userKeys, const std::string& channelName, Poco::Dynamic::Var encryptedEventData) {
     server::ContextEmitCustomEventModel model;
     model.contextId = contextId;
     model.data = encryptedEventData;
     model.channel = channelName;
-    model.users = _eventKeyProvider.prepareKeysList(users, encryptionKey);
+    model.users = userKeys;
     _serverApi.contextSendCustomEvent(model);
     PRIVMX_DEBUG("EventApiImpl", "emitEventEx", model.serialize(), true);
 }
 
+void EventApiImpl::enableChannelSession(const std::string& contextId, const std::string& channelName, const int64_t maxEvents, const int64_t maxAge) {
+    validateChannelName(channelName);
+    // without an age limit a recipient that missed every wrapped key could never decrypt the events again
+    if (maxEvents < 0 || maxAge <= 0) {
+        throw InvalidChannelSessionConfigException();
+    }
+    std::lock_guard<std::mutex> lock(_channelSessionsMutex);
+    _channelSessions[getChannelSessionId(contextId, channelName)] = ChannelSession{
+        .maxEvents = maxEvents,
+        .maxAge = maxAge,
+        .keyId = std::string(),
+        .key = std::string(),
+        .audience = std::string(),
+        .eventsCount = 0,
+        .createDate = 0,
+        .keyDelivered = false,
+        .wrapDate = 0
+    };
+}
+
+void EventApiImpl::disableChannelSession(const std::string& contextId, const std::string& channelName) {
+    std::lock_guard<std::mutex> lock(_channelSessionsMutex);
+    _channelSessions.erase(getChannelSessionId(contextId, channelName));
+}
+
+std::optional<EventApiImpl::ChannelSessionKey> EventApiImpl::getChannelSessionKey(const std::string& contextId, const std::vector<core::UserWithPubKey>& users, const std::string& channelName) {
+    std::lock_guard<std::mutex> lock(_channelSessionsMutex);
+    auto it = _channelSessions.find(getChannelSessionId(contextId, channelName));
+    if (it == _channelSessions.end()) {
+        return std::nullopt;
+    }
+    auto& session = it->second;
+    auto audience = getAudienceHash(users);
+    auto now = privmx::utils::Utils::getNowTimestamp();
+    bool rotate = session.keyId.empty() || session.audience != audience ||
+        (session.maxEvents > 0 && session.eventsCount >= session.maxEvents) ||
+        (session.maxAge > 0 && now - session.createDate >= session.maxAge);
+    if (rotate) {
+        session.keyId = _eventKeyProvider.generateKeyId();
+        session.key = _eventKeyProvider.generateKey();
+        session.audience = audience;
+        session.eventsCount = 0;
+        session.createDate = now;
+        session.keyDelivered = false;
+    }
+    session.eventsCount++;
+    // until an event with the wrapped key reaches the server, every event carries the wrapped key,
+    // later the key is wrapped again from time to time for recipients which subscribed after it was sent
+    bool wrap = !session.keyDelivered || now - session.wrapDate >= CHANNEL_SESSION_REWRAP_INTERVAL;
+    return ChannelSessionKey{.keyId = session.keyId, .key = session.key, .wrap = wrap};
+}
+
+void EventApiImpl::setChannelSessionKeyDelivered(const std::string& contextId, const std::string& channelName, const std::string& keyId, bool delivered) {
+    std::lock_guard<std::mutex> lock(_channelSessionsMutex);
+    auto it = _channelSessions.find(getChannelSessionId(contextId, channelName));
+    if (it != _channelSessions.end() && it->second.keyId == keyId) {
+        it->second.keyDelivered = delivered;
+        if (delivered) {
+            it->second.wrapDate = privmx::utils::Utils::getNowTimestamp();
+        }
+    }
+}
+
+std::string EventApiImpl::getChannelSessionId(const std::string& contextId, const std::string& channelName) {
+    return contextId + "/" + channelName;
+}
+
+std::string EventApiImpl::getAudienceHash(const std::vector<core::UserWithPubKey>& users) {
+    std::vector<std::string> audience;
+    for (auto& user : users) {
+        audience.push_back(user.userId + ":" + user.pubKey);
+    }
+    std::sort(audience.begin(), audience.end());
+    std::string result;
+    for (auto& entry : audience) {
+        result += privmx::crypto::Crypto::sha256(entry);
+    }
+    return privmx::crypto::Crypto::sha256(result);
+}
+
 void EventApiImpl::validateChannelName(const std::string& channelName) {
     if(std::find(_forbiddenChannelsNames.begin(), _forbiddenChannelsNames.end(), channelName) != _forbiddenChannelsNames.end()) {
         throw ForbiddenChannelNameException();
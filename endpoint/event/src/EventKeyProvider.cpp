@@ -13,6 +13,8 @@ limitations under the License.
 #include "privmx/endpoint/event/EventKeyProvider.hpp"
 #include <privmx/endpoint/core/ExceptionConverter.hpp>
 #include <privmx/crypto/CryptoException.hpp>
+#include <privmx/utils/Utils.hpp>
+#include "privmx/endpoint/event/EventException.hpp"
 
 using namespace privmx::endpoint::event;
 
@@ -26,7 +28,11 @@ DecryptedEventEncKeyV1 EventKeyProvider::decryptKey(const std::string& encrypted
     std::string encKey;
     int64_t statusCode = 0;
     try {
-        encKey = privmx::crypto::EciesEncryptor::decryptFromBase64(_key, encryptedKey, authorPubKey);
+        if (encryptedKey.rfind(SESSION_KEY_PREFIX, 0) == 0) {
+            encKey = decryptSessionKey(encryptedKey, authorPubKey);
+        } else {
+            encKey = privmx::crypto::EciesEncryptor::decryptFromBase64(_key, encryptedKey, authorPubKey);
+        }
     } catch (const privmx::endpoint::core::Exception& e) {
         statusCode = e.getCode();
     } catch (const privmx::utils::PrivmxException& e) {
@@ -56,3 +62,50 @@ std::vector<server::UserKey> EventKeyProvider::prepareKeysList(
     return userKeys;
 }
 
+std::string EventKeyProvider::generateKeyId() {
+    return privmx::utils::Hex::from(privmx::crypto::Crypto::randomBytes(16));
+}
+
+std::vector<server::UserKey> EventKeyProvider::prepareSessionKeysList(
+    const std::vector<core::UserWithPubKey>& users, 
+    const std::string& keyId,
+    const std::optional<std::string>& key
+) {
+    std::vector<server::UserKey> userKeys;
+    for (auto& user : users) {
+        std::string userKey = SESSION_KEY_PREFIX + keyId;
+        if (key.has_value()) {
+            userKey += ":" + privmx::crypto::EciesEncryptor::encryptToBase64(crypto::PublicKey::fromBase58DER(user.pubKey), key.value(), _key);
+        }
+        userKeys.push_back(server::UserKey{
+            .id  = user.userId,
+            .key = userKey
+        });
+    }
+    return userKeys;
+}
+
+std::string EventKeyProvider::decryptSessionKey(const std::string& encryptedKey, const privmx::crypto::PublicKey& authorPubKey) {
+    // s1:<keyId>[:<wrapped key>]
+    auto separator = encryptedKey.find(':', SESSION_KEY_PREFIX.size());
+    auto keyId = encryptedKey.substr(SESSION_KEY_PREFIX.size(), separator == std::string::npos ? std::string::npos : separator - SESSION_KEY_PREFIX.size());
+    auto cacheKey = authorPubKey.toDER() + keyId;
+    std::lock_guard<std::mutex> lock(_sessionKeysMutex);
+    if (separator == std::string::npos) {
+        auto it = _sessionKeys.find(cacheKey);
+        if (it == _sessionKeys.end()) {
+            throw EventSessionKeyNotFoundException();
+        }
+        return it->second;
+    }
+    auto key = privmx::crypto::EciesEncryptor::decryptFromBase64(_key, encryptedKey.substr(separator + 1), authorPubKey);
+    if (_sessionKeys.find(cacheKey) == _sessionKeys.end()) {
+        _sessionKeysOrder.push_back(cacheKey);
+        if (_sessionKeysOrder.size() > MAX_SESSION_KEYS) {
+            _sessionKeys.erase(_sessionKeysOrder.front());
+            _sessionKeysOrder.pop_front();
+        }
+    }
+    _sessionKeys[cacheKey] = key;
+    return key;
+}
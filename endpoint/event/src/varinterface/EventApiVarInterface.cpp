@@ -21,7 +21,9 @@ std::map<EventApiVarInterface::METHOD, Poco::Dynamic::Var (EventApiVarInterface:
                                        {EmitEvent, &EventApiVarInterface::emitEvent},
                                        {SubscribeFor, &EventApiVarInterface::subscribeFor},
                                        {UnsubscribeFrom, &EventApiVarInterface::unsubscribeFrom},
-                                       {BuildSubscriptionQuery, &EventApiVarInterface::buildSubscriptionQuery}};
+                                       {BuildSubscriptionQuery, &EventApiVarInterface::buildSubscriptionQuery},
+                                       {EnableChannelSession, &EventApiVarInterface::enableChannelSession},
+                                       {DisableChannelSession, &EventApiVarInterface::disableChannelSession}};
 
 Poco::Dynamic::Var EventApiVarInterface::create(const Poco::Dynamic::Var& args) {
     core::VarInterfaceUtil::validateAndExtractArray(args, 0);
@@ -62,6 +64,24 @@ Poco::Dynamic::Var EventApiVarInterface::buildSubscriptionQuery(const Poco::Dyna
     return _serializer.serialize(result);
 }
 
+Poco::Dynamic::Var EventApiVarInterface::enableChannelSession(const Poco::Dynamic::Var& args) {
+    auto argsArr = core::VarInterfaceUtil::validateAndExtractArray(args, 4);
+    auto contextId = _deserializer.deserialize<std::string>(argsArr->get(0), "contextId");
+    auto channelName = _deserializer.deserialize<std::string>(argsArr->get(1), "channelName");
+    auto maxEvents = _deserializer.deserialize<int64_t>(argsArr->get(2), "maxEvents");
+    auto maxAge = _deserializer.deserialize<int64_t>(argsArr->get(3), "maxAge");
+    _eventApi.enableChannelSession(contextId, channelName, maxEvents, maxAge);
+    return {};
+}
+
+Poco::Dynamic::Var EventApiVarInterface::disableChannelSession(const Poco::Dynamic::Var& args) {
+    auto argsArr = core::VarInterfaceUtil::validateAndExtractArray(args, 2);
+    auto contextId = _deserializer.deserialize<std::string>(argsArr->get(0), "contextId");
+    auto channelName = _deserializer.deserialize<std::string>(argsArr->get(1), "channelName");
+    _eventApi.disableChannelSession(contextId, channelName);
+    return {};
+}
+
 Poco::Dynamic::Var EventApiVarInterface::exec(METHOD method, const Poco::Dynamic::Var& args) {
     auto it = methodMap.find(method);
     if (it == methodMap.end()) {
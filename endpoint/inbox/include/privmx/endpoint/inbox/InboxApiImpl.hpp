@@ -12,6 +12,7 @@ limitations under the License.
 #ifndef _PRIVMXLIB_ENDPOINT_INBOX_INBOXAPIIMPL_HPP_
 #define _PRIVMXLIB_ENDPOINT_INBOX_INBOXAPIIMPL_HPP_
 
+#include <functional>
 #include <memory>
 #include <optional>
 #include <string>
@@ -25,6 +26,7 @@ limitations under the License.
 #include <privmx/endpoint/core/KeyProvider.hpp>
 #include <privmx/endpoint/core/EventMiddleware.hpp>
 #include <privmx/endpoint/core/Types.hpp>
+#include <privmx/endpoint/core/UsersKeysResolver.hpp>
 #include <privmx/endpoint/thread/ServerTypes.hpp>
 #include <privmx/endpoint/thread/ThreadApi.hpp>
 #include <privmx/endpoint/store/StoreApi.hpp>
@@ -33,6 +35,7 @@ limitations under the License.
 #include <privmx/endpoint/store/encryptors/file/FileMetaEncryptorV4.hpp>
 #include <privmx/endpoint/store/encryptors/file/FileMetaEncryptorV5.hpp>
 #include <privmx/endpoint/core/ModuleBaseApi.hpp>
+#include <privmx/endpoint/core/PrefetchingCursor.hpp>
 #include "privmx/endpoint/inbox/InboxApi.hpp"
 #include "privmx/endpoint/inbox/ServerTypes.hpp"
 #include "privmx/endpoint/inbox/InboxEntriesDataEncryptorSerializer.hpp"
@@ -90,6 +93,8 @@ public:
     inbox::Inbox getInboxEx(const std::string& inboxId, const std::string& type);
     core::PagingList<inbox::Inbox> listInboxes(const std::string& contextId, const core::PagingQuery& query);
     inbox::InboxPublicView getInboxPublicView(const std::string& inboxId);
+    void addInboxMembers(const std::string& inboxId, const std::vector<core::UserWithPubKey>& users, const std::vector<core::UserWithPubKey>& managers);
+    void removeInboxMembers(const std::string& inboxId, const std::vector<std::string>& userIds);
     void deleteInbox(const std::string& inboxId);
 
     int64_t/*inboxHandle*/ prepareEntry(
@@ -102,6 +107,8 @@ public:
     void sendEntry(const int64_t inboxHandle);
     inbox::InboxEntry readEntry(const std::string& inboxEntryId);
     core::PagingList<inbox::InboxEntry> listEntries(const std::string& inboxId, const core::PagingQuery& query);
+    core::PagingList<inbox::InboxEntry> listEntriesWithoutFilesMeta(const std::string& inboxId, const core::PagingQuery& query);
+    core::CursorPage<inbox::InboxEntry> fetchEntriesPage(const std::string& inboxId, const core::PagingQuery& query, bool loadFilesMeta);
     void deleteEntry(const std::string& inboxEntryId);
     int64_t/*inboxFileHandle*/ createFileHandle(const core::Buffer& publicMeta, const core::Buffer& privateMeta, const int64_t fileSize);
     void writeToFile(const int64_t inboxHandle, const int64_t inboxFileHandle, const core::Buffer& dataChunk);
@@ -109,11 +116,27 @@ public:
     core::Buffer readFromFile(const int64_t handle, const int64_t length);
     void seekInFile(const int64_t handle, const int64_t pos);
     std::string closeFile(const int64_t handle);
+    void writeToFileFromPath(const int64_t inboxHandle, const int64_t inboxFileHandle, const std::string& filePath);
+    void downloadFileToPath(const std::string& fileId, const std::string& filePath);
 
     std::vector<std::string> subscribeFor(const std::vector<std::string>& subscriptionQueries);
     void unsubscribeFrom(const std::vector<std::string>& subscriptionIds);
     std::string buildSubscriptionQuery(EventType eventType, EventSelectorType selectorType, const std::string& selectorId);
 private:
+    void sendEntryEx(const int64_t inboxHandle, const std::shared_ptr<InboxHandle>& handle);
+    inbox::server::InboxData updateInboxMembers(
+        const std::string& inboxId,
+        const std::vector<core::UserWithPubKey>& usersToAdd,
+        const std::vector<core::UserWithPubKey>& managersToAdd,
+        const std::vector<std::string>& userIdsToRemove
+    );
+    inbox::server::InboxData updateInboxRequest(
+        const inbox::server::InboxInfo& currentInbox,
+        const std::function<std::shared_ptr<core::UsersKeysResolver>(const core::DecryptedEncKeyV2&)>& createUsersKeysResolver,
+        const core::Buffer& publicMeta, const core::Buffer& privateMeta,
+        const std::optional<inbox::FilesConfig>& fileConfig, const int64_t version, const bool force,
+        const std::optional<core::ContainerPolicyWithoutItem>& policies
+    );
     inbox::server::InboxInfo getServerInbox(const std::string& inboxId, const std::optional<std::string>& type = std::nullopt);
     inbox::Inbox _getInboxEx(const std::string& inboxId, const std::string& type);
     inbox::FilesConfig getFilesConfigOptOrDefault(const std::optional<inbox::FilesConfig>& fileConfig);
@@ -144,6 +167,9 @@ private:
 
     InboxEntryResult decryptInboxEntry(thread::server::Message message, const core::ModuleKeys& inboxKeys);
     inbox::InboxEntry convertInboxEntry(thread::server::Message message, const inbox::InboxEntryResult& inboxEntry);
+    void loadEntriesFiles(std::vector<inbox::InboxEntry>& entries, const std::vector<InboxEntryResult>& entriesData);
+    void setEntriesFilesIds(std::vector<inbox::InboxEntry>& entries, const std::vector<InboxEntryResult>& entriesData);
+    core::PagingList<inbox::InboxEntry> listEntriesEx(const std::string& inboxId, const core::PagingQuery& query, bool loadFilesMeta);
     inbox::InboxEntry decryptAndConvertInboxEntryDataToInboxEntry(thread::server::Message message, const core::ModuleKeys& inboxKeys);
     store::FileMetaToEncryptV4 prepareMeta(const inbox::CommitFileInfo& commitFileInfo);
     core::ModuleKeys getEntryDecryptionKeys(thread::server::Message message);
@@ -164,6 +190,7 @@ private:
     void assertInboxExist(const std::string& inboxId);
 
     static const Poco::Int64 _CHUNK_SIZE;
+    static const size_t _MAX_FILES_PER_REQUEST;
     core::Connection _connection;
     endpoint::thread::ThreadApi _threadApi;
     endpoint::store::StoreApi _storeApi;
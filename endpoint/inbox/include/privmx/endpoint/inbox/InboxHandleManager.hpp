@@ -20,6 +20,7 @@ limitations under the License.
 #include <privmx/endpoint/store/ChunkStreamer.hpp>
 #include <privmx/endpoint/store/FileHandle.hpp>
 #include "privmx/endpoint/inbox/InboxApi.hpp"
+#include "privmx/endpoint/inbox/InboxUploadScheduler.hpp"
 
 
 namespace privmx {
@@ -45,6 +46,7 @@ struct InboxHandle {
     std::string data;
     std::vector<std::shared_ptr<store::FileWriteHandle>> inboxFileHandles;
     std::optional<std::string> userPrivKey;
+    std::shared_ptr<InboxUploadScheduler> uploadScheduler;
 };
 
 
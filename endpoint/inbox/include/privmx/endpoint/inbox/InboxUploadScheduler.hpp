@@ -0,0 +1,92 @@
+/*
+PrivMX Endpoint.
+Copyright © 2024 Simplito sp. z o.o.
+
+This file is part of the PrivMX Platform (https://privmx.dev).
+This software is Licensed under the PrivMX Free License.
+
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef _PRIVMXLIB_ENDPOINT_INBOX_INBOXUPLOADSCHEDULER_HPP_
+#define _PRIVMXLIB_ENDPOINT_INBOX_INBOXUPLOADSCHEDULER_HPP_
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <privmx/endpoint/store/FileHandle.hpp>
+
+namespace privmx {
+namespace endpoint {
+namespace inbox {
+
+// Uploads data of all files of a single Inbox entry. Writes to one file are processed in order,
+// different files are processed concurrently. The amount of queued data is bounded across all files,
+// so a write blocks while the window is full. An error of a file is kept and rethrown on the next write
+// to that file and by flush().
+class InboxUploadScheduler
+{
+public:
+    static constexpr size_t MAX_WORKERS = 4;
+    static constexpr uint64_t MAX_PENDING_BYTES = 8*1024*1024; // 8MiB
+
+    InboxUploadScheduler(
+        const std::vector<std::shared_ptr<store::FileWriteHandle>>& fileHandles,
+        size_t maxWorkers = MAX_WORKERS,
+        uint64_t maxPendingBytes = MAX_PENDING_BYTES
+    );
+    ~InboxUploadScheduler();
+    InboxUploadScheduler(const InboxUploadScheduler&) = delete;
+    InboxUploadScheduler& operator=(const InboxUploadScheduler&) = delete;
+
+    bool hasFile(int64_t fileHandleId);
+    void write(int64_t fileHandleId, const std::string& data);
+    void writeFromFile(int64_t fileHandleId, const std::string& filePath);
+    void flush();
+    std::vector<store::ChunksSentInfo> finalize();
+    void cancel();
+
+private:
+    struct Task {
+        std::function<void()> run;
+        uint64_t size;
+    };
+    struct FileQueue {
+        std::shared_ptr<store::FileWriteHandle> handle;
+        std::deque<Task> tasks;
+        bool busy = false;
+        std::exception_ptr error;
+    };
+
+    size_t getFileIndex(int64_t fileHandleId);
+    void enqueue(size_t fileIndex, Task&& task);
+    void startWorkers();
+    void workerLoop();
+    FileQueue* findReadyQueue();
+    bool isIdle();
+
+    std::mutex _mutex;
+    std::condition_variable _stateChanged;
+    std::vector<FileQueue> _files;
+    std::vector<std::thread> _workers;
+    size_t _maxWorkers;
+    uint64_t _maxPendingBytes;
+    uint64_t _pendingBytes = 0;
+    size_t _nextFile = 0;
+    bool _stopping = false;
+};
+
+} // inbox
+} // endpoint
+} // privmx
+
+#endif // _PRIVMXLIB_ENDPOINT_INBOX_INBOXUPLOADSCHEDULER_HPP_
@@ -50,6 +50,11 @@ public:
         SubscribeFor = 22,
         UnsubscribeFrom = 23,
         BuildSubscriptionQuery = 24,
+        WriteToFileFromPath = 25,
+        DownloadFileToPath = 26,
+        ListEntriesWithoutFilesMeta = 27,
+        AddInboxMembers = 28,
+        RemoveInboxMembers = 29,
     };
 
     InboxApiVarInterface(core::Connection connection, thread::ThreadApi threadApi, store::StoreApi storeApi, const core::VarSerializer& serializer)
@@ -61,6 +66,8 @@ public:
     Poco::Dynamic::Var getInbox(const Poco::Dynamic::Var& args);
     Poco::Dynamic::Var listInboxes(const Poco::Dynamic::Var& args);
     Poco::Dynamic::Var getInboxPublicView(const Poco::Dynamic::Var& args);
+    Poco::Dynamic::Var addInboxMembers(const Poco::Dynamic::Var& args);
+    Poco::Dynamic::Var removeInboxMembers(const Poco::Dynamic::Var& args);
     Poco::Dynamic::Var deleteInbox(const Poco::Dynamic::Var& args);
     Poco::Dynamic::Var prepareEntry(const Poco::Dynamic::Var& args);
     Poco::Dynamic::Var sendEntry(const Poco::Dynamic::Var& args);
@@ -76,6 +83,9 @@ public:
     Poco::Dynamic::Var subscribeFor(const Poco::Dynamic::Var& args);
     Poco::Dynamic::Var unsubscribeFrom(const Poco::Dynamic::Var& args);
     Poco::Dynamic::Var buildSubscriptionQuery(const Poco::Dynamic::Var& args);
+    Poco::Dynamic::Var writeToFileFromPath(const Poco::Dynamic::Var& args);
+    Poco::Dynamic::Var downloadFileToPath(const Poco::Dynamic::Var& args);
+    Poco::Dynamic::Var listEntriesWithoutFilesMeta(const Poco::Dynamic::Var& args);
 
     Poco::Dynamic::Var exec(METHOD method, const Poco::Dynamic::Var& args);
 
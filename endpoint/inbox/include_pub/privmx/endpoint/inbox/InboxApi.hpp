@@ -7,6 +7,7 @@
 #include <vector>
 
 #include "privmx/endpoint/core/Connection.hpp"
+#include "privmx/endpoint/core/Cursor.hpp"
 #include "privmx/endpoint/core/Types.hpp"
 
 #include "privmx/endpoint/store/StoreApi.hpp"
@@ -115,6 +116,26 @@ public:
      */    
     inbox::InboxPublicView getInboxPublicView(const std::string& inboxId);
 
+    /**
+     * Gives users access to an existing Inbox, without changing its other members and metadata. The Store and the Thread of the Inbox are updated the same way.
+     *
+     * @param inboxId ID of the Inbox to update
+     * @param users vector of UserWithPubKey structs which indicates who will get access to the Inbox
+     * @param managers vector of UserWithPubKey structs which indicates who will get access (and management rights) to
+     * the Inbox
+     */
+    void addInboxMembers(const std::string& inboxId, const std::vector<core::UserWithPubKey>& users,
+                         const std::vector<core::UserWithPubKey>& managers);
+
+    /**
+     * Takes away access to an existing Inbox from the given users, both as users and managers.
+     * The Inbox gets a new key, which is shared with the remaining members using their public keys from the Context. The Store and the Thread of the Inbox are updated the same way.
+     *
+     * @param inboxId ID of the Inbox to update
+     * @param userIds IDs of the users to remove
+     */
+    void removeInboxMembers(const std::string& inboxId, const std::vector<std::string>& userIds);
+
     /**
      * Deletes an Inbox by given Inbox ID.
      *
@@ -139,6 +160,7 @@ public:
     /**
      * Sends data to an Inbox.
      * You do not have to be logged in to call this function.
+     * When sending fails, the Inbox handle and its file handles are closed.
      *
      * @param inboxHandle ID of the Inbox to which the request applies
      */
@@ -161,6 +183,29 @@ public:
      */
     core::PagingList<inbox::InboxEntry> listEntries(const std::string& inboxId, const core::PagingQuery& pagingQuery);
 
+    /**
+     * Opens a cursor reading all the entries of an Inbox page by page.
+     * The following pages are downloaded in the background while the application processes the current one.
+     *
+     * @param inboxId ID of the Inbox to read entries from
+     * @param pagingQuery struct with list query parameters of the first page, its limit is the size of every page
+     * @param pagesAhead maximum number of pages downloaded ahead of the page being read
+     * @return cursor returning the next page on every next() call
+     */
+    core::Cursor<inbox::InboxEntry> openEntryCursor(const std::string& inboxId, const core::PagingQuery& pagingQuery,
+                            int64_t pagesAhead = core::DEFAULT_CURSOR_PAGES_AHEAD);
+
+    /**
+     * Gets list of entries in given Inbox without fetching and decrypting metadata of their files.
+     * Each file of an entry is returned with only 'info.storeId' and 'info.fileId' set, so the number of files is known.
+     * Full file information of a single entry can be loaded later with readEntry().
+     *
+     * @param inboxId ID of the Inbox
+     * @param pagingQuery struct with list query parameters
+     * @return struct containing list of entries
+     */
+    core::PagingList<inbox::InboxEntry> listEntriesWithoutFilesMeta(const std::string& inboxId, const core::PagingQuery& pagingQuery);
+
     /**
      * Delete an entry from an Inbox.
      *
@@ -248,6 +293,26 @@ public:
      */
     std::string buildSubscriptionQuery(EventType eventType, EventSelectorType selectorType, const std::string& selectorId);
 
+    /**
+     * Sends the whole content of a local file to an Inbox.
+     * The size of the local file must match the size declared in createFileHandle().
+     * You do not have to be logged in to call this function.
+     *
+     * @param inboxHandle Handle to the prepared Inbox entry
+     * @param inboxFileHandle handle to the file where the uploaded data belongs
+     * @param filePath path of the local file to read data from
+     */
+    void writeToFileFromPath(const int64_t inboxHandle, const int64_t inboxFileHandle, const std::string& filePath);
+
+    /**
+     * Downloads a file directly to the local file system.
+     * An existing file at the given path is overwritten.
+     *
+     * @param fileId ID of the file to download
+     * @param filePath path of the local file to write data to
+     */
+    void downloadFileToPath(const std::string& fileId, const std::string& filePath);
+
 private:
     InboxApi(const std::shared_ptr<InboxApiImpl>& impl);
 };
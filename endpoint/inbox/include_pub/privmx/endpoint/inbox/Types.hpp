@@ -154,7 +154,9 @@ struct InboxEntry {
     core::Buffer data;
 
     /**
-     * list of files attached to the entry
+     * list of files attached to the entry, in the order they were sent;
+     * a file which could not be fetched from its Store is kept at its position with only its statusCode set,
+     * if the files of the entry cannot be fetched or decrypted at all, the list is empty and statusCode of the entry is set
      */
     std::vector<store::File> files;
 
@@ -132,6 +132,37 @@ InboxPublicView InboxApi::getInboxPublicView(const std::string& inboxId) {
     }
 }
 
+void InboxApi::addInboxMembers(
+    const std::string& inboxId,
+    const std::vector<core::UserWithPubKey>& users,
+    const std::vector<core::UserWithPubKey>& managers
+) {
+    auto impl = getImpl();
+    core::Validator::validateId(inboxId, "field:inboxId ");
+    core::Validator::validateClass<std::vector<core::UserWithPubKey>>(users, "field:users ");
+    core::Validator::validateClass<std::vector<core::UserWithPubKey>>(managers, "field:managers ");
+    try {
+        impl->addInboxMembers(inboxId, users, managers);
+    } catch (const privmx::utils::PrivmxException& e) {
+        core::ExceptionConverter::rethrowAsCoreException(e);
+        throw core::Exception("ExceptionConverter rethrow error");
+    }
+}
+
+void InboxApi::removeInboxMembers(const std::string& inboxId, const std::vector<std::string>& userIds) {
+    auto impl = getImpl();
+    core::Validator::validateId(inboxId, "field:inboxId ");
+    for (const auto& userId : userIds) {
+        core::Validator::validateId(userId, "field:userIds ");
+    }
+    try {
+        impl->removeInboxMembers(inboxId, userIds);
+    } catch (const privmx::utils::PrivmxException& e) {
+        core::ExceptionConverter::rethrowAsCoreException(e);
+        throw core::Exception("ExceptionConverter rethrow error");
+    }
+}
+
 void InboxApi::deleteInbox(const std::string& inboxId) {
     auto impl = getImpl();
     core::Validator::validateId(inboxId, "field:inboxId ");
@@ -206,6 +237,33 @@ core::PagingList<inbox::InboxEntry> InboxApi::listEntries(const std::string& inb
     }
 }
 
+core::Cursor<inbox::InboxEntry> InboxApi::openEntryCursor(const std::string& inboxId, const core::PagingQuery& pagingQuery, int64_t pagesAhead) {
+    auto impl = getImpl();
+    core::Validator::validateId(inboxId, "field:inboxId ");
+    core::Validator::validatePagingQuery(pagingQuery, {"createDate"}, "field:pagingQuery ");
+    core::Validator::validateNumberPositive(pagingQuery.limit, "field:pagingQuery.limit ");
+    core::Validator::validateNumberPositive(pagesAhead, "field:pagesAhead ");
+    return core::Cursor<inbox::InboxEntry>(std::make_shared<core::PrefetchingCursor<inbox::InboxEntry>>(
+        [impl, inboxId](const core::PagingQuery& query) {
+            return impl->fetchEntriesPage(inboxId, query, true);
+        },
+        pagingQuery,
+        pagesAhead
+    ));
+}
+
+core::PagingList<inbox::InboxEntry> InboxApi::listEntriesWithoutFilesMeta(const std::string& inboxId, const core::PagingQuery& query) {
+    auto impl = getImpl();
+    core::Validator::validateId(inboxId, "field:inboxId ");
+    core::Validator::validatePagingQuery(query, {"createDate"}, "field:query ");
+    try {
+        return impl->listEntriesWithoutFilesMeta(inboxId, query);
+    } catch (const privmx::utils::PrivmxException& e) {
+        core::ExceptionConverter::rethrowAsCoreException(e);
+        throw core::Exception("ExceptionConverter rethrow error");
+    }
+}
+
 int64_t/*inboxFileHandle*/ InboxApi::createFileHandle(const core::Buffer& publicMeta, const core::Buffer& privateMeta, const int64_t& fileSize) {
     auto impl = getImpl();
     core::Validator::validateNumberNonNegative(fileSize, "field:fileSize ");
@@ -270,6 +328,27 @@ std::string InboxApi::closeFile(const int64_t handle) {
     }
 }
 
+void InboxApi::writeToFileFromPath(const int64_t inboxHandle, const int64_t inboxFileHandle, const std::string& filePath) {
+    auto impl = getImpl();
+    try {
+        return impl->writeToFileFromPath(inboxHandle, inboxFileHandle, filePath);
+    } catch (const privmx::utils::PrivmxException& e) {
+        core::ExceptionConverter::rethrowAsCoreException(e);
+        throw core::Exception("ExceptionConverter rethrow error");
+    }
+}
+
+void InboxApi::downloadFileToPath(const std::string& fileId, const std::string& filePath) {
+    auto impl = getImpl();
+    core::Validator::validateId(fileId, "field:fileId ");
+    try {
+        return impl->downloadFileToPath(fileId, filePath);
+    } catch (const privmx::utils::PrivmxException& e) {
+        core::ExceptionConverter::rethrowAsCoreException(e);
+        throw core::Exception("ExceptionConverter rethrow error");
+    }
+}
+
 std::vector<std::string> InboxApi::subscribeFor(const std::vector<std::string>& subscriptionQueries) {
     auto impl = getImpl();
     try {
@@ -9,6 +9,8 @@ See the License for the specific language governing permissions and
 limitations under the License.
 */
 
+#include <iterator>
+#include <unordered_map>
 #include <Poco/ByteOrder.h>
 #include <privmx/crypto/Crypto.hpp>
 #include <privmx/utils/Debug.hpp>
@@ -33,6 +35,7 @@ limitations under the License.
 #include "privmx/endpoint/core/UsersKeysResolver.hpp"
 #include "privmx/endpoint/core/Mapper.hpp"
 #include "privmx/endpoint/core/EventBuilder.hpp"
+#include <privmx/utils/ParallelFor.hpp>
 
 
 using namespace privmx::endpoint::inbox;
@@ -41,6 +44,7 @@ using namespace privmx::utils;
 using namespace privmx;
 
 const Poco::Int64 InboxApiImpl::_CHUNK_SIZE = 128 * 1024;
+const size_t InboxApiImpl::_MAX_FILES_PER_REQUEST = 100;
 
 InboxApiImpl::InboxApiImpl(
     const core::Connection& connection,
@@ -155,6 +159,81 @@ void InboxApiImpl::updateInbox(
     const bool forceGenerateNewKey, const std::optional<core::ContainerPolicyWithoutItem>& policies
 ) {
     auto currentInbox = getServerInbox(inboxId);
+    auto currentInboxData = updateInboxRequest(currentInbox, [&](const core::DecryptedEncKeyV2& currentInboxKey) {
+        return core::UsersKeysResolver::create(currentInbox, users, managers, forceGenerateNewKey, currentInboxKey);
+    }, publicMeta, privateMeta, fileConfig, version, force, policies);
+
+    std::optional<core::ContainerPolicy> policiesWithItems { policies.has_value() ? std::make_optional<core::ContainerPolicy>({policies.value(), std::nullopt}) : std::nullopt};
+    auto store = (_storeApi.getImpl())->getStoreEx(currentInboxData.storeId, INBOX_TYPE_FILTER_FLAG);
+    (_storeApi.getImpl())->updateStore(
+        currentInboxData.storeId,
+        users,
+        managers,
+        store.publicMeta,
+        store.privateMeta,
+        store.version,
+        force,
+        forceGenerateNewKey,
+        policiesWithItems
+    );
+    auto thread = (_threadApi.getImpl())->getThreadEx(currentInboxData.threadId, INBOX_TYPE_FILTER_FLAG);
+    (_threadApi.getImpl())->updateThread(
+        currentInboxData.threadId,
+        users,
+        managers,
+        thread.publicMeta,
+        thread.privateMeta,
+        thread.version,
+        force,
+        forceGenerateNewKey,
+        policiesWithItems
+    );
+}
+
+void InboxApiImpl::addInboxMembers(
+    const std::string& inboxId,
+    const std::vector<core::UserWithPubKey>& users,
+    const std::vector<core::UserWithPubKey>& managers
+) {
+    auto currentInboxData = updateInboxMembers(inboxId, users, managers, {});
+    (_storeApi.getImpl())->addStoreMembers(currentInboxData.storeId, users, managers);
+    (_threadApi.getImpl())->addThreadMembers(currentInboxData.threadId, users, managers);
+}
+
+void InboxApiImpl::removeInboxMembers(const std::string& inboxId, const std::vector<std::string>& userIds) {
+    auto currentInboxData = updateInboxMembers(inboxId, {}, {}, userIds);
+    (_storeApi.getImpl())->removeStoreMembers(currentInboxData.storeId, userIds);
+    (_threadApi.getImpl())->removeThreadMembers(currentInboxData.threadId, userIds);
+}
+
+inbox::server::InboxData InboxApiImpl::updateInboxMembers(
+    const std::string& inboxId,
+    const std::vector<core::UserWithPubKey>& usersToAdd,
+    const std::vector<core::UserWithPubKey>& managersToAdd,
+    const std::vector<std::string>& userIdsToRemove
+) {
+    auto currentInbox = getServerInbox(inboxId);
+    auto inbox = validateDecryptAndConvertInboxDataToInbox(currentInbox);
+    if(inbox.statusCode != 0) {
+        throw InboxDataIntegrityException("Inbox data statusCode: " + std::to_string(inbox.statusCode));
+    }
+    auto delta = _connection.getImpl()->getContainerMembersUpdater()->createDelta(usersToAdd, managersToAdd, userIdsToRemove);
+    return updateInboxRequest(currentInbox, [&](const core::DecryptedEncKeyV2& currentInboxKey) {
+        return core::UsersKeysResolver::createFromDelta(
+            currentInbox.users, currentInbox.managers, usersToAdd, managersToAdd, userIdsToRemove, currentInboxKey,
+            [&](const std::vector<std::string>& userIds) { return delta.getContextUsersPubKeys(currentInbox.contextId, userIds); }
+        );
+    }, inbox.publicMeta, inbox.privateMeta, inbox.filesConfig, currentInbox.version, false, std::nullopt);
+}
+
+inbox::server::InboxData InboxApiImpl::updateInboxRequest(
+    const inbox::server::InboxInfo& currentInbox,
+    const std::function<std::shared_ptr<core::UsersKeysResolver>(const core::DecryptedEncKeyV2&)>& createUsersKeysResolver,
+    const core::Buffer& publicMeta, const core::Buffer& privateMeta,
+    const std::optional<inbox::FilesConfig>& fileConfig, const int64_t version, const bool force,
+    const std::optional<core::ContainerPolicyWithoutItem>& policies
+) {
+    const auto& inboxId = currentInbox.id;
     auto currentInboxEntry = getInboxCurrentDataEntry(currentInbox);
     auto currentInboxData = currentInboxEntry.data;
     auto currentInboxResourceId = currentInbox.resourceId.has_value() ? currentInbox.resourceId.value() : core::EndpointUtils::generateId();
@@ -163,7 +242,7 @@ void InboxApiImpl::updateInbox(
     auto currentInboxKey {findEncKeyByKeyId(inboxKeys, currentInboxEntry.keyId)};
     auto inboxInternalMeta = decryptInboxInternalMeta(currentInboxEntry, currentInboxKey);
 
-    auto usersKeysResolver {core::UsersKeysResolver::create(currentInbox, users, managers, forceGenerateNewKey, currentInboxKey)};
+    auto usersKeysResolver {createUsersKeysResolver(currentInboxKey)};
 
     if(!_keyProvider->verifyKeysSecret(inboxKeys, location, inboxInternalMeta.secret)) {
         throw InboxEncryptionKeyValidationException();
@@ -217,47 +296,21 @@ void InboxApiImpl::updateInbox(
     server::InboxUpdateModel inboxUpdateModel;
     inboxUpdateModel.id = inboxId;
     inboxUpdateModel.resourceId = currentInboxResourceId;
-    inboxUpdateModel.users = InboxDataHelper::mapUsers(users);
-    inboxUpdateModel.managers = InboxDataHelper::mapUsers(managers);
+    inboxUpdateModel.users = usersKeysResolver->getUserIds();
+    inboxUpdateModel.managers = usersKeysResolver->getManagerIds();
     inboxUpdateModel.data = _inboxDataProcessorV5.packForServer(inboxDataIn, _userPrivKey, inboxKey.key);
     inboxUpdateModel.keyId = inboxKey.id;
     inboxUpdateModel.keys = keysList;
     inboxUpdateModel.force = force;
     inboxUpdateModel.version = version;
 
-    std::optional<core::ContainerPolicy> policiesWithItems { policies.has_value() ? std::make_optional<core::ContainerPolicy>({policies.value(), std::nullopt}) : std::nullopt};
-
     if (policies.has_value()) {
         inboxUpdateModel.policy = privmx::endpoint::core::Factory::createPolicyServerObject(policies.value());
     }
 
     _serverApi->inboxUpdate(inboxUpdateModel);
     invalidateModuleKeysInCache(inboxId);
-
-    auto store = (_storeApi.getImpl())->getStoreEx(currentInboxData.storeId, INBOX_TYPE_FILTER_FLAG);
-    (_storeApi.getImpl())->updateStore(
-        currentInboxData.storeId,
-        users,
-        managers,
-        store.publicMeta,
-        store.privateMeta,
-        store.version,
-        force,
-        forceGenerateNewKey,
-        policiesWithItems
-    );
-    auto thread = (_threadApi.getImpl())->getThreadEx(currentInboxData.threadId, INBOX_TYPE_FILTER_FLAG);
-    (_threadApi.getImpl())->updateThread(
-        currentInboxData.threadId,
-        users,
-        managers,
-        thread.publicMeta,
-        thread.privateMeta,
-        thread.version,
-        force,
-        forceGenerateNewKey,
-        policiesWithItems
-    );
+    return currentInboxData;
 }
 
 Inbox InboxApiImpl::getInbox(const std::string& inboxId) {
@@ -361,6 +414,18 @@ int64_t InboxApiImpl::prepareEntry(
 
 void InboxApiImpl::sendEntry(const int64_t inboxHandle) {
     auto handle = _inboxHandleManager.getInboxHandle(inboxHandle);
+    try {
+        sendEntryEx(inboxHandle, handle);
+    } catch (...) {
+        // an entry which failed is not sent again, its upload workers are stopped and its handles released
+        if (_inboxHandleManager.hasInboxHandle(inboxHandle)) {
+            _inboxHandleManager.abortInboxHandle(inboxHandle);
+        }
+        throw;
+    }
+}
+
+void InboxApiImpl::sendEntryEx(const int64_t inboxHandle, const std::shared_ptr<InboxHandle>& handle) {
     auto publicData {getInboxPublicViewData(handle->inboxId)};
 
     auto inboxPubKeyECC = privmx::crypto::PublicKey::fromBase58DER(publicData.inboxEntriesPubKeyBase58DER);
@@ -386,16 +451,16 @@ void InboxApiImpl::sendEntry(const int64_t inboxHandle) {
     std::string requestId;
 
     if (hasFiles) {
-        int fileIndex = -1;
         CommitSendInfo commitSentInfo;
         try {
             commitSentInfo = _inboxHandleManager.commitInboxHandle(inboxHandle);
         } catch (const core::DataDifferentThanDeclaredException& e) {
-            _inboxHandleManager.abortInboxHandle(inboxHandle);
             throw WritingToEntryInteruptedWrittenDataSmallerThenDeclaredException();
         }
-        for (auto fileInfo : commitSentInfo.filesInfo) {
-            fileIndex++;
+        // files' meta are independent of each other, so they are encrypted in parallel and kept in fileIndex order
+        inboxFiles.resize(commitSentInfo.filesInfo.size());
+        utils::ParallelFor::run(commitSentInfo.filesInfo.size(), [&](size_t fileIndex) {
+            const auto& fileInfo = commitSentInfo.filesInfo[fileIndex];
             auto fileDIO = _connection.getImpl()->createPublicDIO(
                 "",
                 core::EndpointUtils::generateId(),
@@ -408,8 +473,8 @@ void InboxApiImpl::sendEntry(const int64_t inboxHandle) {
             inboxFile.fileIndex = fileIndex;
             inboxFile.meta = encryptedFileMeta.toJSON();
             inboxFile.resourceId = fileDIO.resourceId;
-            inboxFiles.push_back(inboxFile);
-        }
+            inboxFiles[fileIndex] = inboxFile;
+        });
         requestId = commitSentInfo.filesInfo[0].fileSendResult.requestId;
     }
 
@@ -445,10 +510,29 @@ inbox::InboxEntry InboxApiImpl::readEntry(const std::string& inboxEntryId) {
 }
 
 core::PagingList<inbox::InboxEntry> InboxApiImpl::listEntries(const std::string& inboxId, const core::PagingQuery& query) {
+    return listEntriesEx(inboxId, query, true);
+}
+
+core::PagingList<inbox::InboxEntry> InboxApiImpl::listEntriesWithoutFilesMeta(const std::string& inboxId, const core::PagingQuery& query) {
+    return listEntriesEx(inboxId, query, false);
+}
+
+core::PagingList<inbox::InboxEntry> InboxApiImpl::listEntriesEx(const std::string& inboxId, const core::PagingQuery& query, bool loadFilesMeta) {
+    PRIVMX_DEBUG_TIME_START(InboxApi, listEntries)
+    auto page = fetchEntriesPage(inboxId, query, loadFilesMeta);
+    PRIVMX_DEBUG_TIME_CHECKPOINT(InboxApi, listEntries, data recv)
+    auto messages = page.decrypt();
+    PRIVMX_DEBUG_TIME_STOP(InboxApi, listEntries, data decrypted)
+    return core::PagingList<inbox::InboxEntry> {
+        .totalAvailable = page.totalAvailable,
+        .readItems = messages
+    };
+}
+
+core::CursorPage<inbox::InboxEntry> InboxApiImpl::fetchEntriesPage(const std::string& inboxId, const core::PagingQuery& query, bool loadFilesMeta) {
     if(query.queryAsJson.has_value()) {
         throw InboxModuleDoesNotSupportQueriesYetException();
     }
-    PRIVMX_DEBUG_TIME_START(InboxApi, listEntries)
     auto inboxRaw {getServerInbox(inboxId)};
     setNewModuleKeysInCache(inboxRaw.id, inboxToModuleKeys(inboxRaw), inboxRaw.version);
     auto inboxData {getInboxCurrentDataEntry(inboxRaw).data};
@@ -456,19 +540,27 @@ core::PagingList<inbox::InboxEntry> InboxApiImpl::listEntries(const std::string&
     thread::server::ThreadMessagesGetModel model;
     model.threadId = threadId;
     core::ListQueryMapper::map(model, query);
-    PRIVMX_DEBUG_TIME_CHECKPOINT(InboxApi, listEntries)
     auto messagesList = _serverApi->threadMessagesGet(model);
-    PRIVMX_DEBUG_TIME_CHECKPOINT(InboxApi, listEntries, data recv)
-    std::vector<inbox::InboxEntry> messages;
-    if(messagesList.messages.size() > 0) {
-        for (auto message : messagesList.messages) {
-            messages.push_back(decryptAndConvertInboxEntryDataToInboxEntry(message, getEntryDecryptionKeys(message)));
-        }
-    }
-    PRIVMX_DEBUG_TIME_STOP(InboxApi, listEntries, data decrypted)
-    return core::PagingList<inbox::InboxEntry> {
+    auto serverMessages = messagesList.messages;
+    // files metadata is loaded with the decryption, as it needs the decrypted entries
+    return core::CursorPage<inbox::InboxEntry>{
         .totalAvailable = messagesList.count,
-        .readItems = messages
+        .size = serverMessages.size(),
+        .lastId = serverMessages.empty() ? std::nullopt : std::make_optional(serverMessages.back().id),
+        .decrypt = [this, serverMessages, loadFilesMeta]() {
+            std::vector<inbox::InboxEntry> messages;
+            std::vector<InboxEntryResult> entriesData;
+            for (auto message : serverMessages) {
+                entriesData.push_back(decryptInboxEntry(message, getEntryDecryptionKeys(message)));
+                messages.push_back(convertInboxEntry(message, entriesData.back()));
+            }
+            if(loadFilesMeta) {
+                loadEntriesFiles(messages, entriesData);
+            } else {
+                setEntriesFilesIds(messages, entriesData);
+            }
+            return messages;
+        }
     };
 }
 
@@ -515,11 +607,12 @@ int64_t InboxApiImpl::createInboxFileHandleForRead(const privmx::endpoint::store
 }
 
 void InboxApiImpl::writeToFile(const int64_t inboxHandle, const int64_t inboxFileHandle, const core::Buffer& dataChunk) {
-    if(_inboxHandleManager.getInboxHandle(inboxHandle)->inboxFileHandles.empty()) {
+    auto handle = _inboxHandleManager.getInboxHandle(inboxHandle);
+    if(handle->inboxFileHandles.empty()) {
         throw InboxHandleIsNotTiedToInboxFileHandleException();
     }
-    std::shared_ptr<store::FileWriteHandle> handle = _inboxHandleManager.getFileWriteHandle(inboxFileHandle);
-    handle->write(dataChunk.stdString());
+    _inboxHandleManager.getFileWriteHandle(inboxFileHandle);
+    handle->uploadScheduler->write(inboxFileHandle, dataChunk.stdString());
 }
 
 int64_t InboxApiImpl::openFile(const std::string& fileId) {
@@ -563,6 +656,36 @@ std::string InboxApiImpl::closeFile(const int64_t handle) {
     return handlePtr->getFileId();
 }
 
+void InboxApiImpl::writeToFileFromPath(const int64_t inboxHandle, const int64_t inboxFileHandle, const std::string& filePath) {
+    PRIVMX_DEBUG_TIME_START(InboxApi, writeToFileFromPath)
+    auto handle = _inboxHandleManager.getInboxHandle(inboxHandle);
+    if(handle->inboxFileHandles.empty()) {
+        throw InboxHandleIsNotTiedToInboxFileHandleException();
+    }
+    _inboxHandleManager.getFileWriteHandle(inboxFileHandle);
+    handle->uploadScheduler->writeFromFile(inboxFileHandle, filePath);
+    PRIVMX_DEBUG_TIME_STOP(InboxApi, writeToFileFromPath)
+}
+
+void InboxApiImpl::downloadFileToPath(const std::string& fileId, const std::string& filePath) {
+    PRIVMX_DEBUG_TIME_START(InboxApi, downloadFileToPath)
+    store::server::StoreFileGetModel storeFileGetModel {.fileId = fileId};
+    auto file {_serverApi->storeFileGet(storeFileGetModel).file};
+    auto handleId = createInboxFileHandleForRead(file);
+    std::shared_ptr<store::FileReadHandle> handle = _inboxHandleManager.getFileReadHandle(handleId);
+    _inboxHandleManager.removeFileHandle(handleId);
+    PRIVMX_DEBUG_TIME_CHECKPOINT(InboxApi, downloadFileToPath, handle created)
+    store::LocalFileWriter output(filePath, handle->getSize());
+    try {
+        handle->readToFile(output);
+        output.close();
+    } catch (...) {
+        output.discard();
+        throw;
+    }
+    PRIVMX_DEBUG_TIME_STOP(InboxApi, downloadFileToPath, data saved)
+}
+
 store::FileMetaToEncryptV4 InboxApiImpl::prepareMeta(const privmx::endpoint::inbox::CommitFileInfo& commitFileInfo) {
     store::dynamic::InternalStoreFileMeta internalFileMeta;
     internalFileMeta.version = 5;
@@ -904,45 +1027,145 @@ inbox::InboxEntry InboxApiImpl::convertInboxEntry(thread::server::Message messag
     result.entryId = message.id;
     result.inboxId = readInboxIdFromMessageKeyId(message.keyId);
     result.createDate = message.createDate;
-    core::DecryptedEncKey fileMetaEncKey{
-        core::EncKey{.id="", .key=inboxEntry.privateData.filesMetaKey},
-        core::DecryptedVersionedData{.dataStructureVersion=0, .statusCode=0}
-    };
     result.data = core::Buffer::from(inboxEntry.privateData.text);
     result.authorPubKey = inboxEntry.publicData.userPubKey;
     result.statusCode = inboxEntry.statusCode;
-    if(inboxEntry.statusCode == 0) {
-        try {
-            store::server::StoreFileGetManyModel filesGetModel;
-            filesGetModel.storeId = inboxEntry.storeId;
-            filesGetModel.fileIds = inboxEntry.filesIds;
-            filesGetModel.failOnError = false;
-            auto serverFiles {_serverApi->storeFileGetMany(filesGetModel)};
-            for (auto file : serverFiles.files) {
-                if(!file.error.has_value()) {
-                    result.files.push_back(std::get<0>(_storeApi.getImpl()->decryptAndConvertFileDataToFileInfo(file, fileMetaEncKey)));
-                } else {
-                    store::File error;
-                    auto e = FileFetchFailedException();
-                    error.statusCode = e.getCode();
-                    result.files.push_back(error);
-                }
+    result.schemaVersion = EntryDataSchema::Version::VERSION_1;
+    return result;
+}
+
+void InboxApiImpl::loadEntriesFiles(std::vector<inbox::InboxEntry>& entries, const std::vector<InboxEntryResult>& entriesData) {
+    // files of all entries are fetched with as few storeFileGetMany calls as possible, split into bounded batches per Store
+    struct FilesBatch {
+        std::string storeId;
+        std::vector<std::string> fileIds;
+        std::vector<std::pair<size_t, size_t>> targets; // (entry index, file index) of each requested file
+        std::vector<store::server::FileListElement> files;
+        int64_t statusCode = 0;
+    };
+    std::vector<FilesBatch> batches;
+    std::unordered_map<std::string, size_t> openBatches;
+    for (size_t i = 0; i < entries.size(); ++i) {
+        if (entries[i].statusCode != 0) {
+            continue;
+        }
+        const auto& entryData = entriesData[i];
+        entries[i].files.resize(entryData.filesIds.size());
+        for (size_t j = 0; j < entryData.filesIds.size(); ++j) {
+            auto openBatch = openBatches.find(entryData.storeId);
+            if (openBatch == openBatches.end() || batches[openBatch->second].fileIds.size() >= _MAX_FILES_PER_REQUEST) {
+                batches.push_back(FilesBatch{.storeId = entryData.storeId});
+                openBatch = openBatches.insert_or_assign(entryData.storeId, batches.size() - 1).first;
+            }
+            batches[openBatch->second].fileIds.push_back(entryData.filesIds[j]);
+            batches[openBatch->second].targets.push_back(std::make_pair(i, j));
+        }
+    }
+    auto fetchBatches = [&](std::vector<FilesBatch>& toFetch) {
+        utils::ParallelFor::run(toFetch.size(), [&](size_t b) {
+            auto& batch = toFetch[b];
+            try {
+                store::server::StoreFileGetManyModel filesGetModel;
+                filesGetModel.storeId = batch.storeId;
+                filesGetModel.fileIds = batch.fileIds;
+                filesGetModel.failOnError = false;
+                batch.files = _serverApi->storeFileGetMany(filesGetModel).files;
+            } catch (const privmx::endpoint::core::Exception& e) {
+                batch.statusCode = e.getCode();
+            } catch (const privmx::utils::PrivmxException& e) {
+                batch.statusCode = core::ExceptionConverter::convert(e).getCode();
+            } catch (...) {
+                batch.statusCode = ENDPOINT_CORE_EXCEPTION_CODE;
+            }
+        });
+    };
+    fetchBatches(batches);
+    // a failed request spanning several entries is sent again for each entry separately,
+    // so only the entries whose own files cannot be fetched get its error
+    std::vector<FilesBatch> retries;
+    for (auto& batch : batches) {
+        if (batch.statusCode == 0 || batch.targets.front().first == batch.targets.back().first) {
+            continue;
+        }
+        std::unordered_map<size_t, size_t> entryRetries;
+        for (size_t k = 0; k < batch.targets.size(); ++k) {
+            auto entryRetry = entryRetries.find(batch.targets[k].first);
+            if (entryRetry == entryRetries.end()) {
+                retries.push_back(FilesBatch{.storeId = batch.storeId});
+                entryRetry = entryRetries.emplace(batch.targets[k].first, retries.size() - 1).first;
             }
+            retries[entryRetry->second].fileIds.push_back(batch.fileIds[k]);
+            retries[entryRetry->second].targets.push_back(batch.targets[k]);
+        }
+        batch.targets.clear();
+    }
+    fetchBatches(retries);
+    batches.insert(batches.end(), std::make_move_iterator(retries.begin()), std::make_move_iterator(retries.end()));
+    std::vector<std::pair<size_t, size_t>> filesToDecrypt; // (batch index, file index in batch)
+    for (size_t b = 0; b < batches.size(); ++b) {
+        for (size_t k = 0; k < batches[b].targets.size(); ++k) {
+            if (batches[b].statusCode != 0) {
+                entries[batches[b].targets[k].first].statusCode = batches[b].statusCode;
+            } else {
+                filesToDecrypt.push_back(std::make_pair(b, k));
+            }
+        }
+    }
+    std::vector<int64_t> filesStatusCodes(filesToDecrypt.size(), 0);
+    utils::ParallelFor::run(filesToDecrypt.size(), [&](size_t f) {
+        const auto& batch = batches[filesToDecrypt[f].first];
+        size_t k = filesToDecrypt[f].second;
+        auto& target = entries[batch.targets[k].first].files[batch.targets[k].second];
+        if (k >= batch.files.size() || batch.files[k].error.has_value()) {
+            target.statusCode = FileFetchFailedException().getCode();
+            return;
+        }
+        core::DecryptedEncKey fileMetaEncKey{
+            core::EncKey{.id="", .key=entriesData[batch.targets[k].first].privateData.filesMetaKey},
+            core::DecryptedVersionedData{.dataStructureVersion=0, .statusCode=0}
+        };
+        try {
+            target = std::get<0>(_storeApi.getImpl()->decryptAndConvertFileDataToFileInfo(batch.files[k], fileMetaEncKey));
         } catch (const privmx::endpoint::core::Exception& e) {
-            result.statusCode = e.getCode();
+            filesStatusCodes[f] = e.getCode();
         } catch (const privmx::utils::PrivmxException& e) {
-            result.statusCode = core::ExceptionConverter::convert(e).getCode();
+            filesStatusCodes[f] = core::ExceptionConverter::convert(e).getCode();
         } catch (...) {
-            result.statusCode = ENDPOINT_CORE_EXCEPTION_CODE;
+            filesStatusCodes[f] = ENDPOINT_CORE_EXCEPTION_CODE;
+        }
+    });
+    for (size_t f = 0; f < filesToDecrypt.size(); ++f) {
+        auto& entry = entries[batches[filesToDecrypt[f].first].targets[filesToDecrypt[f].second].first];
+        if (filesStatusCodes[f] != 0 && entry.statusCode == 0) {
+            entry.statusCode = filesStatusCodes[f];
+        }
+    }
+    for (auto& entry : entries) {
+        if (entry.statusCode != 0) {
+            entry.files.clear();
+        }
+    }
+}
+
+void InboxApiImpl::setEntriesFilesIds(std::vector<inbox::InboxEntry>& entries, const std::vector<InboxEntryResult>& entriesData) {
+    for (size_t i = 0; i < entries.size(); ++i) {
+        if (entries[i].statusCode != 0) {
+            continue;
+        }
+        for (auto& fileId : entriesData[i].filesIds) {
+            store::File file{};
+            file.info.storeId = entriesData[i].storeId;
+            file.info.fileId = fileId;
+            entries[i].files.push_back(file);
         }
     }
-    result.schemaVersion = EntryDataSchema::Version::VERSION_1;
-    return result;
 }
 
 inbox::InboxEntry InboxApiImpl::decryptAndConvertInboxEntryDataToInboxEntry(thread::server::Message message, const core::ModuleKeys& inboxKeys) {
     auto inboxEntry = decryptInboxEntry(message, inboxKeys);
-    return convertInboxEntry(message, inboxEntry);
+    std::vector<inbox::InboxEntry> entries {convertInboxEntry(message, inboxEntry)};
+    loadEntriesFiles(entries, {inboxEntry});
+    return entries[0];
 }
 
 inbox::FilesConfig InboxApiImpl::getFilesConfigOptOrDefault(const std::optional<inbox::FilesConfig>& fileConfig) {
@@ -1034,12 +1257,12 @@ void InboxApiImpl::processNotificationEvent(const std::string& type, const core:
 }
 
 void InboxApiImpl::processConnectedEvent() {
-    invalidateModuleKeysInCache();
+    revalidateModuleKeysInCache();
 }
 
 void InboxApiImpl::processDisconnectedEvent() {
     LOG_TRACE("InboxApiImpl recived DisconnectedEvent");
-    invalidateModuleKeysInCache();
+    revalidateModuleKeysInCache();
     privmx::utils::ManualManagedClass<InboxApiImpl>::cleanup();
 }
 
@@ -39,7 +39,8 @@ std::shared_ptr<InboxHandle> InboxHandleManager::createInboxHandle(
         .inboxResourceId=inboxResourceId, 
         .data=data, 
         .inboxFileHandles=fileHandles, 
-        .userPrivKey=userPrivKey
+        .userPrivKey=userPrivKey,
+        .uploadScheduler=(fileHandles.empty() ? nullptr : std::make_shared<InboxUploadScheduler>(fileHandles))
     });
     _map.set(id, result);
     return result;
@@ -62,15 +63,21 @@ CommitSendInfo InboxHandleManager::commitInboxHandle(const int64_t& id) {
     if(!inboxHandle.has_value()) throw UnknownInboxHandleException();
     CommitSendInfo result; 
     if(!inboxHandle.value()->inboxFileHandles.empty()) {
+        auto uploadScheduler = inboxHandle.value()->uploadScheduler;
+        uploadScheduler->flush();
         for(auto file_handle : inboxHandle.value()->inboxFileHandles) {
             if(!file_handle->isReadyToFinalize()) {
                 throw core::DataDifferentThanDeclaredException();
             }
         }
 
-        for(auto file_handle : inboxHandle.value()->inboxFileHandles) {
+        auto filesSendResult = uploadScheduler->finalize();
+        // all data is sent, the workers are not needed anymore
+        uploadScheduler->cancel();
+        for(size_t i = 0; i < inboxHandle.value()->inboxFileHandles.size(); ++i) {
+            auto file_handle = inboxHandle.value()->inboxFileHandles[i];
             CommitFileInfo file_info;
-            file_info.fileSendResult = file_handle->finalize();
+            file_info.fileSendResult = filesSendResult[i];
             file_info.fileSize = file_handle->getEncryptedFileSize();
             file_info.size = file_handle->getSize();
             file_info.publicMeta = file_handle->getPublicMeta();
@@ -91,6 +98,9 @@ CommitSendInfo InboxHandleManager::commitInboxHandle(const int64_t& id) {
 void InboxHandleManager::abortInboxHandle(const int64_t& id) {
     auto inboxHandle = _map.get(id);
     if(!inboxHandle.has_value()) throw UnknownInboxHandleException();
+    if(inboxHandle.value()->uploadScheduler) {
+        inboxHandle.value()->uploadScheduler->cancel();
+    }
     _map.erase(id);
     _handleManager->removeHandle(id);
     if(!inboxHandle.value()->inboxFileHandles.empty()) {
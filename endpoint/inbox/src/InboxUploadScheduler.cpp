@@ -0,0 +1,198 @@
+/*
+PrivMX Endpoint.
+Copyright © 2024 Simplito sp. z o.o.
+
+This file is part of the PrivMX Platform (https://privmx.dev).
+This software is Licensed under the PrivMX Free License.
+
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <algorithm>
+
+#include <privmx/endpoint/store/LocalFile.hpp>
+
+#include "privmx/endpoint/inbox/InboxUploadScheduler.hpp"
+#include "privmx/endpoint/inbox/InboxException.hpp"
+
+using namespace privmx::endpoint;
+using namespace privmx::endpoint::inbox;
+
+InboxUploadScheduler::InboxUploadScheduler(
+    const std::vector<std::shared_ptr<store::FileWriteHandle>>& fileHandles,
+    size_t maxWorkers,
+    uint64_t maxPendingBytes
+) : _files(fileHandles.size()), _maxWorkers(std::max<size_t>(maxWorkers, 1)), _maxPendingBytes(maxPendingBytes) {
+    for(size_t i = 0; i < fileHandles.size(); ++i) {
+        _files[i].handle = fileHandles[i];
+    }
+}
+
+InboxUploadScheduler::~InboxUploadScheduler() {
+    cancel();
+}
+
+bool InboxUploadScheduler::hasFile(int64_t fileHandleId) {
+    return std::any_of(_files.begin(), _files.end(), [&](const FileQueue& file) {
+        return file.handle->getId() == fileHandleId;
+    });
+}
+
+void InboxUploadScheduler::write(int64_t fileHandleId, const std::string& data) {
+    size_t fileIndex = getFileIndex(fileHandleId);
+    auto handle = _files[fileIndex].handle;
+    enqueue(fileIndex, Task{
+        .run = [handle, data]() {
+            handle->write(data);
+        },
+        .size = data.size()
+    });
+}
+
+void InboxUploadScheduler::writeFromFile(int64_t fileHandleId, const std::string& filePath) {
+    size_t fileIndex = getFileIndex(fileHandleId);
+    auto handle = _files[fileIndex].handle;
+    // opened here so a missing file is reported to the caller right away,
+    // the file itself is read in blocks by the handle and is not counted in the window
+    auto input = std::make_shared<store::LocalFileReader>(filePath);
+    enqueue(fileIndex, Task{
+        .run = [handle, input]() {
+            handle->writeFromFile(*input);
+        },
+        .size = 0
+    });
+}
+
+void InboxUploadScheduler::flush() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _stateChanged.wait(lock, [&]{ return _stopping || isIdle(); });
+    for(auto& file : _files) {
+        if(file.error) {
+            std::rethrow_exception(file.error);
+        }
+    }
+}
+
+std::vector<store::ChunksSentInfo> InboxUploadScheduler::finalize() {
+    flush();
+    // shared with the tasks, which may outlive this call when the scheduler is cancelled meanwhile
+    auto result = std::make_shared<std::vector<store::ChunksSentInfo>>(_files.size());
+    for(size_t i = 0; i < _files.size(); ++i) {
+        auto handle = _files[i].handle;
+        enqueue(i, Task{
+            .run = [handle, result, i]() {
+                (*result)[i] = handle->finalize();
+            },
+            .size = 0
+        });
+    }
+    flush();
+    return *result;
+}
+
+void InboxUploadScheduler::cancel() {
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _stopping = true;
+        for(auto& file : _files) {
+            file.tasks.clear();
+        }
+        _pendingBytes = 0;
+    }
+    _stateChanged.notify_all();
+    for(auto& worker : _workers) {
+        if(worker.joinable()) {
+            worker.join();
+        }
+    }
+    _workers.clear();
+}
+
+size_t InboxUploadScheduler::getFileIndex(int64_t fileHandleId) {
+    for(size_t i = 0; i < _files.size(); ++i) {
+        if(_files[i].handle->getId() == fileHandleId) {
+            return i;
+        }
+    }
+    throw InboxHandleIsNotTiedToInboxFileHandleException();
+}
+
+void InboxUploadScheduler::enqueue(size_t fileIndex, Task&& task) {
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        FileQueue& file = _files[fileIndex];
+        _stateChanged.wait(lock, [&]{
+            return _stopping || file.error || _pendingBytes == 0 || _pendingBytes + task.size <= _maxPendingBytes;
+        });
+        if(_stopping) {
+            throw UnknownInboxHandleException();
+        }
+        if(file.error) {
+            std::rethrow_exception(file.error);
+        }
+        _pendingBytes += task.size;
+        file.tasks.push_back(std::move(task));
+        startWorkers();
+    }
+    _stateChanged.notify_all();
+}
+
+void InboxUploadScheduler::startWorkers() {
+    size_t workers = std::min(_maxWorkers, _files.size());
+    while(_workers.size() < workers) {
+        _workers.push_back(std::thread(&InboxUploadScheduler::workerLoop, this));
+    }
+}
+
+void InboxUploadScheduler::workerLoop() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    while(true) {
+        FileQueue* file = nullptr;
+        _stateChanged.wait(lock, [&]{ return _stopping || (file = findReadyQueue()) != nullptr; });
+        if(_stopping) {
+            return;
+        }
+        Task task = std::move(file->tasks.front());
+        file->tasks.pop_front();
+        file->busy = true;
+        lock.unlock();
+        std::exception_ptr error;
+        try {
+            task.run();
+        } catch (...) {
+            error = std::current_exception();
+        }
+        lock.lock();
+        file->busy = false;
+        if(!_stopping) {
+            _pendingBytes -= task.size;
+            if(error) {
+                // data queued after a failed write cannot be sent in order anymore
+                file->error = error;
+                for(auto& dropped : file->tasks) {
+                    _pendingBytes -= dropped.size;
+                }
+                file->tasks.clear();
+            }
+        }
+        _stateChanged.notify_all();
+    }
+}
+
+InboxUploadScheduler::FileQueue* InboxUploadScheduler::findReadyQueue() {
+    for(size_t i = 0; i < _files.size(); ++i) {
+        FileQueue& file = _files[(_nextFile + i) % _files.size()];
+        if(!file.busy && !file.tasks.empty()) {
+            _nextFile = (_nextFile + i + 1) % _files.size();
+            return &file;
+        }
+    }
+    return nullptr;
+}
+
+bool InboxUploadScheduler::isIdle() {
+    return std::all_of(_files.begin(), _files.end(), [](const FileQueue& file) {
+        return !file.busy && file.tasks.empty();
+    });
+}
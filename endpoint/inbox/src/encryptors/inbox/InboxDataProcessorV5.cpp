@@ -125,7 +125,7 @@ InboxPrivateDataV5AsResult InboxDataProcessorV5::unpackPrivate(
 
         result.privateMeta = _dataEncryptor.decodeAndDecryptAndVerify(privateDataV5.privateMeta, authorPublicKeyECC, inboxKey);
         auto internalMetaStr = _dataEncryptor.decodeAndDecryptAndVerify(privateDataV5.internalMeta, authorPublicKeyECC, inboxKey).stdString();
-        auto internalMetaJSON = dynamic::InboxInternalMetaV5::fromJSON(utils::Utils::parseJsonObject(internalMetaStr));
+        auto internalMetaJSON = dynamic::InboxInternalMetaV5::deserialize(internalMetaStr);
         result.internalMeta = InboxInternalMetaV5{.secret=internalMetaJSON.secret, .resourceId=internalMetaJSON.resourceId, .randomId=internalMetaJSON.randomId};
         result.authorPubKey = privateDataV5.authorPubKey;
 
@@ -38,7 +38,12 @@ std::map<InboxApiVarInterface::METHOD, Poco::Dynamic::Var (InboxApiVarInterface:
                                        {CloseFile, &InboxApiVarInterface::closeFile},
                                        {SubscribeFor, &InboxApiVarInterface::subscribeFor},
                                        {UnsubscribeFrom, &InboxApiVarInterface::unsubscribeFrom},
-                                       {BuildSubscriptionQuery, &InboxApiVarInterface::buildSubscriptionQuery}};
+                                       {BuildSubscriptionQuery, &InboxApiVarInterface::buildSubscriptionQuery},
+                                       {WriteToFileFromPath, &InboxApiVarInterface::writeToFileFromPath},
+                                       {DownloadFileToPath, &InboxApiVarInterface::downloadFileToPath},
+                                       {ListEntriesWithoutFilesMeta, &InboxApiVarInterface::listEntriesWithoutFilesMeta},
+                                       {AddInboxMembers, &InboxApiVarInterface::addInboxMembers},
+                                       {RemoveInboxMembers, &InboxApiVarInterface::removeInboxMembers}};
 
 Poco::Dynamic::Var InboxApiVarInterface::create(const Poco::Dynamic::Var& args) {
     core::VarInterfaceUtil::validateAndExtractArray(args, 0);
@@ -98,6 +103,23 @@ Poco::Dynamic::Var InboxApiVarInterface::getInboxPublicView(const Poco::Dynamic:
     return _serializer.serialize(result);
 }
 
+Poco::Dynamic::Var InboxApiVarInterface::addInboxMembers(const Poco::Dynamic::Var& args) {
+    auto argsArr = core::VarInterfaceUtil::validateAndExtractArray(args, 3);
+    auto inboxId = _deserializer.deserialize<std::string>(argsArr->get(0), "inboxId");
+    auto users = _deserializer.deserializeVector<core::UserWithPubKey>(argsArr->get(1), "users");
+    auto managers = _deserializer.deserializeVector<core::UserWithPubKey>(argsArr->get(2), "managers");
+    _inboxApi.addInboxMembers(inboxId, users, managers);
+    return {};
+}
+
+Poco::Dynamic::Var InboxApiVarInterface::removeInboxMembers(const Poco::Dynamic::Var& args) {
+    auto argsArr = core::VarInterfaceUtil::validateAndExtractArray(args, 2);
+    auto inboxId = _deserializer.deserialize<std::string>(argsArr->get(0), "inboxId");
+    auto userIds = _deserializer.deserializeVector<std::string>(argsArr->get(1), "userIds");
+    _inboxApi.removeInboxMembers(inboxId, userIds);
+    return {};
+}
+
 Poco::Dynamic::Var InboxApiVarInterface::deleteInbox(const Poco::Dynamic::Var& args) {
     auto argsArr = core::VarInterfaceUtil::validateAndExtractArray(args, 1);
     auto inboxId = _deserializer.deserialize<std::string>(argsArr->get(0), "inboxId");
@@ -215,6 +237,31 @@ Poco::Dynamic::Var InboxApiVarInterface::buildSubscriptionQuery(const Poco::Dyna
     return _serializer.serialize(result);
 }
 
+Poco::Dynamic::Var InboxApiVarInterface::writeToFileFromPath(const Poco::Dynamic::Var& args) {
+    auto argsArr = core::VarInterfaceUtil::validateAndExtractArray(args, 3);
+    auto inboxHandle = _deserializer.deserialize<int64_t>(argsArr->get(0), "inboxHandle");
+    auto inboxFileHandle = _deserializer.deserialize<int64_t>(argsArr->get(1), "inboxFileHandle");
+    auto filePath = _deserializer.deserialize<std::string>(argsArr->get(2), "filePath");
+    _inboxApi.writeToFileFromPath(inboxHandle, inboxFileHandle, filePath);
+    return {};
+}
+
+Poco::Dynamic::Var InboxApiVarInterface::downloadFileToPath(const Poco::Dynamic::Var& args) {
+    auto argsArr = core::VarInterfaceUtil::validateAndExtractArray(args, 2);
+    auto fileId = _deserializer.deserialize<std::string>(argsArr->get(0), "fileId");
+    auto filePath = _deserializer.deserialize<std::string>(argsArr->get(1), "filePath");
+    _inboxApi.downloadFileToPath(fileId, filePath);
+    return {};
+}
+
+Poco::Dynamic::Var InboxApiVarInterface::listEntriesWithoutFilesMeta(const Poco::Dynamic::Var& args) {
+    auto argsArr = core::VarInterfaceUtil::validateAndExtractArray(args, 2);
+    auto inboxId = _deserializer.deserialize<std::string>(argsArr->get(0), "inboxId");
+    auto pagingQuery = _deserializer.deserialize<core::PagingQuery>(argsArr->get(1), "pagingQuery");
+    auto result = _inboxApi.listEntriesWithoutFilesMeta(inboxId, pagingQuery);
+    return _serializer.serialize(result);
+}
+
 Poco::Dynamic::Var InboxApiVarInterface::exec(METHOD method, const Poco::Dynamic::Var& args) {
     auto it = methodMap.find(method);
     if (it == methodMap.end()) {
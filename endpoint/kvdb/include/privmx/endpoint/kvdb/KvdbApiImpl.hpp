@@ -12,6 +12,7 @@ limitations under the License.
 #ifndef _PRIVMXLIB_ENDPOINT_KVDB_KVDBAPIIMPL_HPP_
 #define _PRIVMXLIB_ENDPOINT_KVDB_KVDBAPIIMPL_HPP_
 
+#include <functional>
 #include <memory>
 #include <optional>
 #include <string>
@@ -23,7 +24,9 @@ limitations under the License.
 #include <privmx/endpoint/core/EventMiddleware.hpp>
 #include <privmx/endpoint/core/encryptors/module/ModuleDataEncryptorV5.hpp>
 #include <privmx/endpoint/core/ModuleBaseApi.hpp>
+#include <privmx/endpoint/core/PrefetchingCursor.hpp>
 #include <privmx/endpoint/core/ContainerKeyCache.hpp>
+#include <privmx/endpoint/core/UsersKeysResolver.hpp>
 
 #include "privmx/endpoint/kvdb/ServerApi.hpp"
 #include "privmx/endpoint/kvdb/KvdbApi.hpp"
@@ -51,6 +54,7 @@ public:
         const core::Connection& connection
     );
     ~KvdbApiImpl();
+    using core::ModuleBaseApi::getAsyncRequestQueue;
     std::string createKvdb(const std::string& contextId,
         const std::vector<core::UserWithPubKey>& users,
         const std::vector<core::UserWithPubKey>& managers,
@@ -68,16 +72,21 @@ public:
         const bool forceGenerateNewKey,
         const std::optional<core::ContainerPolicy>& policies = std::nullopt
     );
+    void addKvdbMembers(const std::string& kvdbId, const std::vector<core::UserWithPubKey>& users, const std::vector<core::UserWithPubKey>& managers);
+    void removeKvdbMembers(const std::string& kvdbId, const std::vector<std::string>& userIds);
     void deleteKvdb(const std::string& kvdbId);
     Kvdb getKvdb(const std::string& kvdbId);
     Kvdb getKvdbEx(const std::string& kvdbId, const std::string& type);
     core::PagingList<Kvdb> listKvdbs(const std::string& contextId, const core::PagingQuery& pagingQuery);
     core::PagingList<Kvdb> listKvdbsEx(const std::string& contextId, const core::PagingQuery& pagingQuery, const std::string& type);
 
-    KvdbEntry getEntry(const std::string& kvdbId, const std::string& key);
+    KvdbEntry getEntry(const std::string& kvdbId, const std::string& key, int64_t fields = core::DataField::ALL_DATA_FIELDS);
     bool hasEntry(const std::string& kvdbId, const std::string& key);
     core::PagingList<std::string> listEntriesKeys(const std::string& kvdbId, const core::PagingQuery& pagingQuery);
-    core::PagingList<KvdbEntry> listEntries(const std::string& kvdbId, const core::PagingQuery& pagingQuery);
+    core::PagingList<KvdbEntry> listEntries(const std::string& kvdbId, const core::PagingQuery& pagingQuery,
+                                            int64_t fields = core::DataField::ALL_DATA_FIELDS);
+    core::CursorPage<KvdbEntry> fetchEntriesPage(const std::string& kvdbId, const core::PagingQuery& pagingQuery,
+                                                 int64_t fields = core::DataField::ALL_DATA_FIELDS);
     void setEntry(const std::string& kvdbId, const std::string& key, const core::Buffer& publicMeta, const core::Buffer& privateMeta, const core::Buffer& data, int64_t version);
     void deleteEntry(const std::string& kvdbId, const std::string& key);
     std::map<std::string, bool> deleteEntries(const std::string& kvdbId, const std::vector<std::string>& keys);
@@ -87,6 +96,16 @@ public:
     std::string buildSubscriptionQuery(EventType eventType, EventSelectorType selectorType, const std::string& selectorId);
     std::string buildSubscriptionQueryForSelectedEntry(EventType eventType, const std::string& kvdbId, const std::string& kvdbEntryKey);
 private:
+    void updateKvdbMembers(const std::string& kvdbId, const core::ContainerMembersDelta& delta);
+    void updateKvdbRequest(
+        const server::KvdbInfo& currentKvdb,
+        const std::function<std::shared_ptr<core::UsersKeysResolver>(const core::DecryptedEncKeyV2&)>& createUsersKeysResolver,
+        const core::Buffer& publicMeta,
+        const core::Buffer& privateMeta,
+        const int64_t version,
+        const bool force,
+        const std::optional<core::ContainerPolicy>& policies
+    );
     std::string createKvdbEx(
         const std::string& contextId,
         const std::vector<core::UserWithPubKey>& users,
@@ -119,7 +138,7 @@ private:
     virtual std::pair<core::ModuleKeys, int64_t> getModuleKeysAndVersionFromServer(std::string moduleId) override;
     core::ModuleKeys kvdbToModuleKeys(server::KvdbInfo kvdb);
 
-    DecryptedKvdbEntryDataV5 decryptKvdbEntryDataV5(server::KvdbEntryInfo entry, const core::DecryptedEncKey& encKey);
+    DecryptedKvdbEntryDataV5 decryptKvdbEntryDataV5(server::KvdbEntryInfo entry, const core::DecryptedEncKey& encKey, int64_t fields);
     KvdbEntry convertDecryptedKvdbEntryDataV5ToKvdbEntry(server::KvdbEntryInfo entry, DecryptedKvdbEntryDataV5 entryData);
     KvdbEntry convertServerKvdbEntryToLibKvdbEntry(
         server::KvdbEntryInfo entry,
@@ -131,9 +150,11 @@ private:
         const int64_t& schemaVersion = KvdbEntryDataSchema::Version::UNKNOWN
     );
     KvdbEntryDataSchema::Version getEntryDataStructureVersion(server::KvdbEntryInfo entry);
-    std::tuple<KvdbEntry, core::DataIntegrityObject> decryptAndConvertEntryDataToEntry(server::KvdbEntryInfo entry, const core::DecryptedEncKey& encKey);
-    std::vector<KvdbEntry> validateDecryptAndConvertKvdbEntriesDataToKvdbEntries(std::vector<server::KvdbEntryInfo> entries, const core::ModuleKeys& kvdbKeys);
-    KvdbEntry validateDecryptAndConvertEntryDataToEntry(server::KvdbEntryInfo entry, const core::ModuleKeys& kvdbKeys);
+    std::tuple<KvdbEntry, core::DataIntegrityObject> decryptAndConvertEntryDataToEntry(server::KvdbEntryInfo entry, const core::DecryptedEncKey& encKey, int64_t fields);
+    std::vector<KvdbEntry> validateDecryptAndConvertKvdbEntriesDataToKvdbEntries(std::vector<server::KvdbEntryInfo> entries, const core::ModuleKeys& kvdbKeys,
+                                                                                 int64_t fields = core::DataField::ALL_DATA_FIELDS);
+    KvdbEntry validateDecryptAndConvertEntryDataToEntry(server::KvdbEntryInfo entry, const core::ModuleKeys& kvdbKeys,
+                                                        int64_t fields = core::DataField::ALL_DATA_FIELDS);
     core::ModuleKeys getEntryDecryptionKeys(server::KvdbEntryInfo entry);
     uint32_t validateEntryDataIntegrity(server::KvdbEntryInfo entry, const std::string& kvdbResourceId);
     Poco::Dynamic::Var encryptEntryData(
@@ -161,11 +182,13 @@ private:
     std::string _host;
     std::shared_ptr<core::EventMiddleware> _eventMiddleware;
     core::Connection _connection;
+    std::shared_ptr<core::ContainerMembersUpdater> _containerMembersUpdater;
     ServerApi _serverApi;
     SubscriberImpl _subscriber;
     core::ModuleDataEncryptorV5 _kvdbDataEncryptorV5;
     EntryDataEncryptorV5 _entryDataEncryptorV5;
     int _notificationListenerId, _connectedListenerId, _disconnectedListenerId;
+    int _containerMembersHandlerId;
     inline static const std::string KVDB_TYPE_FILTER_FLAG = "kvdb";
 };
 
@@ -32,9 +32,12 @@ public:
         const crypto::PrivateKey& authorPrivateKey,
         const std::string& encryptionKey
     );
-    DecryptedKvdbEntryDataV5 decrypt(const server::EncryptedKvdbEntryDataV5& encryptedEntryData, const std::string& encryptionKey);
+    // selectedFields is a bitmask of core::DataField, the fields left out stay empty
+    DecryptedKvdbEntryDataV5 decrypt(const server::EncryptedKvdbEntryDataV5& encryptedEntryData, const std::string& encryptionKey,
+                                     int64_t selectedFields = core::DataField::ALL_DATA_FIELDS);
     DecryptedKvdbEntryDataV5 extractPublic(const server::EncryptedKvdbEntryDataV5& encryptedEntryData);
     core::DataIntegrityObject getDIOAndAssertIntegrity(const server::EncryptedKvdbEntryDataV5& encryptedEntryData);
+    void setCompressor(const std::shared_ptr<const core::DataCompressor>& compressor);
 private:
     void assertDataFormat(const server::EncryptedKvdbEntryDataV5& encryptedKvdbData);
     core::DataEncryptorV4 _dataEncryptor;
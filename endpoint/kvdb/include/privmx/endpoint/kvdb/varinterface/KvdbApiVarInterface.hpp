@@ -46,6 +46,8 @@ public:
         UnsubscribeFrom = 18,
         BuildSubscriptionQuery = 19,
         BuildSubscriptionQueryForSelectedEntry = 20,
+        AddKvdbMembers = 21,
+        RemoveKvdbMembers = 22,
     };
 
     KvdbApiVarInterface(core::Connection connection, const core::VarSerializer& serializer)
@@ -54,6 +56,8 @@ public:
     Poco::Dynamic::Var create(const Poco::Dynamic::Var& args);
     Poco::Dynamic::Var createKvdb(const Poco::Dynamic::Var& args);
     Poco::Dynamic::Var updateKvdb(const Poco::Dynamic::Var& args);
+    Poco::Dynamic::Var addKvdbMembers(const Poco::Dynamic::Var& args);
+    Poco::Dynamic::Var removeKvdbMembers(const Poco::Dynamic::Var& args);
     Poco::Dynamic::Var deleteKvdb(const Poco::Dynamic::Var& args);
     Poco::Dynamic::Var getKvdb(const Poco::Dynamic::Var& args);
     Poco::Dynamic::Var listKvdbs(const Poco::Dynamic::Var& args);
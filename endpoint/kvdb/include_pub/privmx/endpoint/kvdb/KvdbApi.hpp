@@ -8,6 +8,8 @@
 #include <map>
 
 #include "privmx/endpoint/core/Connection.hpp"
+#include "privmx/endpoint/core/Cursor.hpp"
+#include "privmx/endpoint/core/Future.hpp"
 #include "privmx/endpoint/core/Types.hpp"
 #include "privmx/endpoint/kvdb/Types.hpp"
 #include <privmx/endpoint/core/ExtendedPointer.hpp>
@@ -84,6 +86,26 @@ public:
         const std::optional<core::ContainerPolicy>& policies = std::nullopt
     );
 
+    /**
+     * Gives users access to an existing KVDB, without changing its other members and metadata.
+     *
+     * @param kvdbId ID of the KVDB to update
+     * @param users vector of UserWithPubKey structs which indicates who will get access to the KVDB
+     * @param managers vector of UserWithPubKey structs which indicates who will get access (and management rights) to
+     * the KVDB
+     */
+    void addKvdbMembers(const std::string& kvdbId, const std::vector<core::UserWithPubKey>& users,
+                        const std::vector<core::UserWithPubKey>& managers);
+
+    /**
+     * Takes away access to an existing KVDB from the given users, both as users and managers.
+     * The KVDB gets a new key, which is shared with the remaining members using their public keys from the Context.
+     *
+     * @param kvdbId ID of the KVDB to update
+     * @param userIds IDs of the users to remove
+     */
+    void removeKvdbMembers(const std::string& kvdbId, const std::vector<std::string>& userIds);
+
     /**
      * Deletes a KVDB by given KVDB ID.
      *
@@ -113,9 +135,20 @@ public:
      *
      * @param kvdbId KVDB ID of the KVDB entry to get
      * @param key key of the KVDB entry to get
+     * @param fields bitmask of core::DataField fields to decrypt, the other fields of the KVDB entry are returned empty
      * @return struct containing the KVDB entry
      */    
-    KvdbEntry getEntry(const std::string& kvdbId, const std::string& key);
+    KvdbEntry getEntry(const std::string& kvdbId, const std::string& key, int64_t fields = core::DataField::ALL_DATA_FIELDS);
+
+    /**
+     * Gets a KVDB entry by given KVDB entry key and KVDB ID without waiting for the result.
+     *
+     * @param kvdbId KVDB ID of the KVDB entry to get
+     * @param key key of the KVDB entry to get
+     * @param options options of the call, e.g. its timeout
+     * @return future result: struct containing the KVDB entry
+     */
+    core::Future<KvdbEntry> getEntryAsync(const std::string& kvdbId, const std::string& key, const core::AsyncCallOptions& options = {});
 
     /**
      * Check whether the KVDB entry exists.
@@ -140,9 +173,25 @@ public:
      *
      * @param kvdbId ID of the KVDB to list KVDB entries from
      * @param pagingQuery  with list query parameters
+     * @param fields bitmask of core::DataField fields to decrypt, e.g. only PUBLIC_META for a list showing titles;
+     * the other fields are returned empty and can be read later with getEntry()
      * @return struct containing a list of KVDB entries
      */    
-    core::PagingList<KvdbEntry> listEntries(const std::string& kvdbId, const core::PagingQuery& pagingQuery);
+    core::PagingList<KvdbEntry> listEntries(const std::string& kvdbId, const core::PagingQuery& pagingQuery,
+                            int64_t fields = core::DataField::ALL_DATA_FIELDS);
+
+    /**
+     * Opens a cursor reading all the KVDB entries of a KVDB page by page.
+     * The following pages are downloaded in the background while the application processes the current one.
+     *
+     * @param kvdbId ID of the KVDB to read KVDB entries from
+     * @param pagingQuery struct with list query parameters of the first page, its limit is the size of every page
+     * @param pagesAhead maximum number of pages downloaded ahead of the page being read
+     * @param fields bitmask of core::DataField fields to decrypt, the other fields are returned empty
+     * @return cursor returning the next page on every next() call
+     */
+    core::Cursor<KvdbEntry> openEntryCursor(const std::string& kvdbId, const core::PagingQuery& pagingQuery,
+                            int64_t pagesAhead = core::DEFAULT_CURSOR_PAGES_AHEAD, int64_t fields = core::DataField::ALL_DATA_FIELDS);
 
     /**
      * Sets a KVDB entry in the given KVDB.
@@ -153,6 +202,19 @@ public:
      * @param data content of the KVDB entry
      */    
     void setEntry(const std::string& kvdbId, const std::string& key, const core::Buffer& publicMeta, const core::Buffer& privateMeta, const core::Buffer& data, int64_t version = 0);
+
+    /**
+     * Sets a KVDB entry in the given KVDB without waiting for the result.
+     * @param kvdbId ID of the KVDB to set the entry to
+     * @param key KVDB entry key
+     * @param publicMeta public KVDB entry metadata
+     * @param privateMeta private KVDB entry metadata
+     * @param data content of the KVDB entry
+     * @param version KVDB entry version (when updating the entry)
+     * @param options options of the call, e.g. its timeout
+     * @return future completed when the entry is set
+     */
+    core::Future<void> setEntryAsync(const std::string& kvdbId, const std::string& key, const core::Buffer& publicMeta, const core::Buffer& privateMeta, const core::Buffer& data, int64_t version = 0, const core::AsyncCallOptions& options = {});
     
     /**
      * Deletes a KVDB entry by given KVDB entry ID.
@@ -10,9 +10,25 @@ extern "C" {
 
 typedef struct KvdbApi KvdbApi;
 
+typedef struct privmx_kvdb_entry {
+    privmx_buffer kvdbId;
+    privmx_buffer key;
+    int64_t createDate;
+    privmx_buffer author;
+    privmx_buffer publicMeta;
+    privmx_buffer privateMeta;
+    privmx_buffer data;
+    privmx_buffer authorPubKey;
+    int64_t version;
+    int64_t statusCode;
+    int64_t schemaVersion;
+} privmx_kvdb_entry;
+
 int privmx_endpoint_newKvdbApi(Connection* connectionPtr, KvdbApi** outPtr);
 int privmx_endpoint_freeKvdbApi(KvdbApi* ptr);
 int privmx_endpoint_execKvdbApi(KvdbApi* ptr, int method, const pson_value* args, pson_value** res);
+int privmx_endpoint_kvdbGetEntry(KvdbApi* ptr, const char* kvdbId, const char* key, privmx_kvdb_entry* outEntry, privmx_error* error);
+void privmx_endpoint_freeKvdbEntry(privmx_kvdb_entry* entry);
 
 #ifdef __cplusplus
 }
@@ -39,6 +39,48 @@ int privmx_endpoint_freeKvdbApi(KvdbApi* ptr) {
     return 1;
 }
 
+int privmx_endpoint_kvdbGetEntry(KvdbApi* ptr, const char* kvdbId, const char* key, privmx_kvdb_entry* outEntry, privmx_error* error) {
+    return CApiExecutor::execBinaryFunc(error, [&]{
+        CApiExecutor::assertNotNull(ptr, "ptr");
+        CApiExecutor::assertNotNull(outEntry, "outEntry");
+        kvdb::KvdbApiVarInterface* _ptr = (kvdb::KvdbApiVarInterface*)ptr;
+        auto entry = _ptr->getApi().getEntry(CApiExecutor::toString(kvdbId, "kvdbId"), CApiExecutor::toString(key, "key"));
+        OwnedBuffer entryKvdbId(std::move(entry.info.kvdbId));
+        OwnedBuffer entryKey(std::move(entry.info.key));
+        OwnedBuffer author(std::move(entry.info.author));
+        OwnedBuffer publicMeta(std::move(entry.publicMeta));
+        OwnedBuffer privateMeta(std::move(entry.privateMeta));
+        OwnedBuffer data(std::move(entry.data));
+        OwnedBuffer authorPubKey(std::move(entry.authorPubKey));
+        *outEntry = privmx_kvdb_entry{
+            .kvdbId = entryKvdbId.release(),
+            .key = entryKey.release(),
+            .createDate = entry.info.createDate,
+            .author = author.release(),
+            .publicMeta = publicMeta.release(),
+            .privateMeta = privateMeta.release(),
+            .data = data.release(),
+            .authorPubKey = authorPubKey.release(),
+            .version = entry.version,
+            .statusCode = entry.statusCode,
+            .schemaVersion = entry.schemaVersion
+        };
+    });
+}
+
+void privmx_endpoint_freeKvdbEntry(privmx_kvdb_entry* entry) {
+    if(entry == nullptr) {
+        return;
+    }
+    CApiExecutor::freeBuffer(&entry->kvdbId);
+    CApiExecutor::freeBuffer(&entry->key);
+    CApiExecutor::freeBuffer(&entry->author);
+    CApiExecutor::freeBuffer(&entry->publicMeta);
+    CApiExecutor::freeBuffer(&entry->privateMeta);
+    CApiExecutor::freeBuffer(&entry->data);
+    CApiExecutor::freeBuffer(&entry->authorPubKey);
+}
+
 int privmx_endpoint_execKvdbApi(KvdbApi* ptr, int method, const pson_value* args, pson_value** res) {
     return CApiExecutor::execFunc(res, [&]{
         kvdb::KvdbApiVarInterface* _ptr = (kvdb::KvdbApiVarInterface*)ptr;
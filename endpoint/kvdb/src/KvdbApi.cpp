@@ -93,6 +93,37 @@ void KvdbApi::updateKvdb(const std::string& kvdbId,
     }
 }
 
+void KvdbApi::addKvdbMembers(
+    const std::string& kvdbId,
+    const std::vector<core::UserWithPubKey>& users,
+    const std::vector<core::UserWithPubKey>& managers
+) {
+    auto impl = getImpl();
+    core::Validator::validateId(kvdbId, "field:kvdbId ");
+    core::Validator::validateClass<std::vector<core::UserWithPubKey>>(users, "field:users ");
+    core::Validator::validateClass<std::vector<core::UserWithPubKey>>(managers, "field:managers ");
+    try {
+        impl->addKvdbMembers(kvdbId, users, managers);
+    } catch (const privmx::utils::PrivmxException& e) {
+        core::ExceptionConverter::rethrowAsCoreException(e);
+        throw core::Exception("ExceptionConverter rethrow error");
+    }
+}
+
+void KvdbApi::removeKvdbMembers(const std::string& kvdbId, const std::vector<std::string>& userIds) {
+    auto impl = getImpl();
+    core::Validator::validateId(kvdbId, "field:kvdbId ");
+    for (const auto& userId : userIds) {
+        core::Validator::validateId(userId, "field:userIds ");
+    }
+    try {
+        impl->removeKvdbMembers(kvdbId, userIds);
+    } catch (const privmx::utils::PrivmxException& e) {
+        core::ExceptionConverter::rethrowAsCoreException(e);
+        throw core::Exception("ExceptionConverter rethrow error");
+    }
+}
+
 void KvdbApi::deleteKvdb(const std::string& kvdbId) {
     auto impl = getImpl();
     core::Validator::validateId(kvdbId, "field:kvdbId ");
@@ -126,17 +157,31 @@ core::PagingList<Kvdb> KvdbApi::listKvdbs(const std::string& contextId, const co
     }
 }
 
-KvdbEntry KvdbApi::getEntry(const std::string& kvdbId, const std::string& key) {
+KvdbEntry KvdbApi::getEntry(const std::string& kvdbId, const std::string& key, int64_t fields) {
     auto impl = getImpl();
     core::Validator::validateId(kvdbId, "field:kvdbId ");
+    core::Validator::validateDataFields(fields, "field:fields ");
     try {
-        return impl->getEntry(kvdbId, key);
+        return impl->getEntry(kvdbId, key, fields);
     } catch (const privmx::utils::PrivmxException& e) {
         core::ExceptionConverter::rethrowAsCoreException(e);
         throw core::Exception("ExceptionConverter rethrow error");
     }
 }
 
+core::Future<KvdbEntry> KvdbApi::getEntryAsync(const std::string& kvdbId, const std::string& key, const core::AsyncCallOptions& options) {
+    auto impl = getImpl();
+    core::Validator::validateId(kvdbId, "field:kvdbId ");
+    return impl->getAsyncRequestQueue()->submit<KvdbEntry>([impl, kvdbId, key]() {
+        try {
+            return impl->getEntry(kvdbId, key);
+        } catch (const privmx::utils::PrivmxException& e) {
+            core::ExceptionConverter::rethrowAsCoreException(e);
+            throw core::Exception("ExceptionConverter rethrow error");
+        }
+    }, options);
+}
+
 bool KvdbApi::hasEntry(const std::string& kvdbId, const std::string& key) {
     auto impl = getImpl();
     core::Validator::validateId(kvdbId, "field:kvdbId ");
@@ -159,18 +204,35 @@ core::PagingList<std::string> KvdbApi::listEntriesKeys(const std::string& kvdbId
         throw core::Exception("ExceptionConverter rethrow error");
     }
 }
-core::PagingList<KvdbEntry> KvdbApi::listEntries(const std::string& kvdbId, const core::PagingQuery& pagingQuery) {
+core::PagingList<KvdbEntry> KvdbApi::listEntries(const std::string& kvdbId, const core::PagingQuery& pagingQuery, int64_t fields) {
     auto impl = getImpl();
     core::Validator::validateId(kvdbId, "field:kvdbId ");
     core::Validator::validatePagingQuery(pagingQuery, {"createDate", "entryKey", "lastModificationDate"}, "field:pagingQuery ");
+    core::Validator::validateDataFields(fields, "field:fields ");
     try {
-        return impl->listEntries(kvdbId, pagingQuery);
+        return impl->listEntries(kvdbId, pagingQuery, fields);
     } catch (const privmx::utils::PrivmxException& e) {
         core::ExceptionConverter::rethrowAsCoreException(e);
         throw core::Exception("ExceptionConverter rethrow error");
     }
 }
 
+core::Cursor<KvdbEntry> KvdbApi::openEntryCursor(const std::string& kvdbId, const core::PagingQuery& pagingQuery, int64_t pagesAhead, int64_t fields) {
+    auto impl = getImpl();
+    core::Validator::validateId(kvdbId, "field:kvdbId ");
+    core::Validator::validatePagingQuery(pagingQuery, {"createDate", "entryKey", "lastModificationDate"}, "field:pagingQuery ");
+    core::Validator::validateNumberPositive(pagingQuery.limit, "field:pagingQuery.limit ");
+    core::Validator::validateNumberPositive(pagesAhead, "field:pagesAhead ");
+    core::Validator::validateDataFields(fields, "field:fields ");
+    return core::Cursor<KvdbEntry>(std::make_shared<core::PrefetchingCursor<KvdbEntry>>(
+        [impl, kvdbId, fields](const core::PagingQuery& query) {
+            return impl->fetchEntriesPage(kvdbId, query, fields);
+        },
+        pagingQuery,
+        pagesAhead
+    ));
+}
+
 void KvdbApi::setEntry(const std::string& kvdbId, const std::string& key, const core::Buffer& publicMeta, const core::Buffer& privateMeta, const core::Buffer& data, int64_t version) {
     auto impl = getImpl();
     core::Validator::validateId(kvdbId, "field:kvdbId ");
@@ -182,6 +244,19 @@ void KvdbApi::setEntry(const std::string& kvdbId, const std::string& key, const
     }
 }
 
+core::Future<void> KvdbApi::setEntryAsync(const std::string& kvdbId, const std::string& key, const core::Buffer& publicMeta, const core::Buffer& privateMeta, const core::Buffer& data, int64_t version, const core::AsyncCallOptions& options) {
+    auto impl = getImpl();
+    core::Validator::validateId(kvdbId, "field:kvdbId ");
+    return impl->getAsyncRequestQueue()->submit<void>([impl, kvdbId, key, publicMeta, privateMeta, data, version]() {
+        try {
+            return impl->setEntry(kvdbId, key, publicMeta, privateMeta, data, version);
+        } catch (const privmx::utils::PrivmxException& e) {
+            core::ExceptionConverter::rethrowAsCoreException(e);
+            throw core::Exception("ExceptionConverter rethrow error");
+        }
+    }, options);
+}
+
 void KvdbApi::deleteEntry(const std::string& kvdbId, const std::string& key) {
     auto impl = getImpl();
     core::Validator::validateId(kvdbId, "field:kvdbId ");
@@ -49,18 +49,25 @@ KvdbApiImpl::KvdbApiImpl(
     _host(host),
     _eventMiddleware(eventMiddleware),
     _connection(connection),
+    _containerMembersUpdater(_connection.getImpl()->getContainerMembersUpdater()),
     _serverApi(ServerApi(gateway)),
     _subscriber(gateway, KVDB_TYPE_FILTER_FLAG)
 {
+    _entryDataEncryptorV5.setCompressor(_connection.getImpl()->getDataCompressor());
+    _kvdbDataEncryptorV5.setCompressor(_connection.getImpl()->getDataCompressor());
     _notificationListenerId = _eventMiddleware->addNotificationEventListener(std::bind(&KvdbApiImpl::processNotificationEvent, this, std::placeholders::_1, std::placeholders::_2));
     _connectedListenerId = _eventMiddleware->addConnectedEventListener(std::bind(&KvdbApiImpl::processConnectedEvent, this));
     _disconnectedListenerId = _eventMiddleware->addDisconnectedEventListener(std::bind(&KvdbApiImpl::processDisconnectedEvent, this));
+    _containerMembersHandlerId = _containerMembersUpdater->addHandler(
+        "kvdb", std::bind(&KvdbApiImpl::updateKvdbMembers, this, std::placeholders::_1, std::placeholders::_2)
+    );
 }
 
 KvdbApiImpl::~KvdbApiImpl() {
     _eventMiddleware->removeNotificationEventListener(_notificationListenerId);
     _eventMiddleware->removeConnectedEventListener(_connectedListenerId);
     _eventMiddleware->removeDisconnectedEventListener(_disconnectedListenerId);
+    _containerMembersUpdater->removeHandler(_containerMembersHandlerId);
     _guardedExecutor.reset();
     LOG_TRACE("~KvdbApiImpl Done");
 }
@@ -135,12 +142,66 @@ void KvdbApiImpl::updateKvdb(
     const bool forceGenerateNewKey,
     const std::optional<core::ContainerPolicy>& policies
 ) {
-    PRIVMX_DEBUG_TIME_START(PlatformKvdb, updateKvdb)
-
     // get current kvdb
     server::KvdbGetModel getModel;
     getModel.kvdbId = kvdbId;
     auto currentKvdb = _serverApi.kvdbGet(getModel).kvdb;
+    updateKvdbRequest(currentKvdb, [&](const core::DecryptedEncKeyV2& currentKvdbKey) {
+        return core::UsersKeysResolver::create(currentKvdb, users, managers, forceGenerateNewKey, currentKvdbKey);
+    }, publicMeta, privateMeta, version, force, policies);
+}
+
+void KvdbApiImpl::addKvdbMembers(
+    const std::string& kvdbId,
+    const std::vector<core::UserWithPubKey>& users,
+    const std::vector<core::UserWithPubKey>& managers
+) {
+    updateKvdbMembers(kvdbId, _containerMembersUpdater->createDelta(users, managers, {}));
+}
+
+void KvdbApiImpl::removeKvdbMembers(const std::string& kvdbId, const std::vector<std::string>& userIds) {
+    updateKvdbMembers(kvdbId, _containerMembersUpdater->createDelta({}, {}, userIds));
+}
+
+void KvdbApiImpl::updateKvdbMembers(const std::string& kvdbId, const core::ContainerMembersDelta& delta) {
+    server::KvdbGetModel getModel;
+    getModel.kvdbId = kvdbId;
+    auto currentKvdb = _serverApi.kvdbGet(getModel).kvdb;
+    auto kvdb = validateDecryptAndConvertKvdbDataToKvdb(currentKvdb);
+    if(kvdb.statusCode != 0) {
+        throw KvdbDataIntegrityException("Kvdb data statusCode: " + std::to_string(kvdb.statusCode));
+    }
+    try {
+        updateKvdbRequest(currentKvdb, [&](const core::DecryptedEncKeyV2& currentKvdbKey) {
+            return core::UsersKeysResolver::createFromDelta(
+                currentKvdb.users, currentKvdb.managers, delta.usersToAdd, delta.managersToAdd, delta.userIdsToRemove, currentKvdbKey,
+                [&](const std::vector<std::string>& userIds) { return delta.getContextUsersPubKeys(currentKvdb.contextId, userIds); }
+            );
+        }, kvdb.publicMeta, kvdb.privateMeta, currentKvdb.version, false, std::nullopt);
+    } catch (const privmx::utils::PrivmxException&) {
+        // the update is rejected when the Kvdb has been modified since it was fetched
+        std::optional<int64_t> version;
+        try {
+            version = _serverApi.kvdbGet(getModel).kvdb.version;
+        } catch (...) {}
+        if(version.has_value() && version.value() != currentKvdb.version) {
+            throw core::ContainerVersionConflictException();
+        }
+        throw;
+    }
+}
+
+void KvdbApiImpl::updateKvdbRequest(
+    const server::KvdbInfo& currentKvdb,
+    const std::function<std::shared_ptr<core::UsersKeysResolver>(const core::DecryptedEncKeyV2&)>& createUsersKeysResolver,
+    const core::Buffer& publicMeta,
+    const core::Buffer& privateMeta,
+    const int64_t version,
+    const bool force,
+    const std::optional<core::ContainerPolicy>& policies
+) {
+    PRIVMX_DEBUG_TIME_START(PlatformKvdb, updateKvdb)
+    const auto& kvdbId = currentKvdb.id;
     auto currentKvdbEntry = currentKvdb.data.back();
     auto currentKvdbResourceId = currentKvdb.resourceId;
     auto location {getModuleEncKeyLocation(currentKvdb, currentKvdbResourceId)};
@@ -148,7 +209,7 @@ void KvdbApiImpl::updateKvdb(
     auto currentKvdbKey {findEncKeyByKeyId(kvdbKeys, currentKvdbEntry.keyId)};
     auto kvdbInternalMeta = extractAndDecryptModuleInternalMeta(currentKvdbEntry, currentKvdbKey);
 
-    auto usersKeysResolver {core::UsersKeysResolver::create(currentKvdb, users, managers, forceGenerateNewKey, currentKvdbKey)};
+    auto usersKeysResolver {createUsersKeysResolver(currentKvdbKey)};
 
     if(!_keyProvider->verifyKeysSecret(kvdbKeys, location, kvdbInternalMeta.secret)) {
         throw KvdbEncryptionKeyValidationException();
@@ -168,10 +229,12 @@ void KvdbApiImpl::updateKvdb(
         );
     }
 
+    // new users get only the newest key, the older ones are reachable through the key chain
+    auto keyChain {_keyProvider->prepareKeyChain(kvdbInternalMeta.keyChain, kvdbKeys, currentKvdbKey, kvdbKey)};
     auto usersToAddMissingKey {usersKeysResolver->getUsersToAddKey()};
     if(usersToAddMissingKey.size() > 0) {
         auto tmp = _keyProvider->prepareMissingKeysForNewUsers(
-            kvdbKeys,
+            _keyProvider->getKeysOutsideKeyChain(kvdbKeys, keyChain, kvdbKey.id),
             usersToAddMissingKey,
             updateKvdbDio,
             location,
@@ -180,20 +243,12 @@ void KvdbApiImpl::updateKvdb(
         for(auto t: tmp) keys.push_back(t);
     }
     server::KvdbUpdateModel model;
-    std::vector<std::string> usersList;
-    for (auto user: users) {
-        usersList.push_back(user.userId);
-    }
-    std::vector<std::string> managersList;
-    for (auto x: managers) {
-        managersList.push_back(x.userId);
-    }
     model.id = kvdbId;
     model.resourceId = currentKvdbResourceId;
     model.keyId = kvdbKey.id;
     model.keys = keys;
-    model.users = usersList;
-    model.managers = managersList;
+    model.users = usersKeysResolver->getUserIds();
+    model.managers = usersKeysResolver->getManagerIds();
     model.version = version;
     model.force = force;
     if (policies.has_value()) {
@@ -202,14 +257,23 @@ void KvdbApiImpl::updateKvdb(
     core::ModuleDataToEncryptV5 kvdbDataToEncrypt {
         .publicMeta = publicMeta,
         .privateMeta = privateMeta,
-        .internalMeta = core::ModuleInternalMetaV5{.secret=kvdbInternalMeta.secret, .resourceId=currentKvdbResourceId, .randomId=updateKvdbDio.randomId},
+        .internalMeta = core::ModuleInternalMetaV5{.secret=kvdbInternalMeta.secret, .resourceId=currentKvdbResourceId, .randomId=updateKvdbDio.randomId, .keyChain=keyChain},
         .dio = updateKvdbDio
     };
     model.data = _kvdbDataEncryptorV5.encrypt(kvdbDataToEncrypt, _userPrivKey, kvdbKey.key).toJSON();
 
     PRIVMX_DEBUG_TIME_CHECKPOINT(PlatformKvdb, updateKvdb, data encrypted)
     _serverApi.kvdbUpdate(model);
-    invalidateModuleKeysInCache(kvdbId);
+    if(force) {
+        invalidateModuleKeysInCache(kvdbId);
+    } else {
+        // the keys after the update are already known, so the next operation on the Kvdb does not fetch them
+        auto updatedKeys {kvdbToModuleKeys(currentKvdb)};
+        updatedKeys.currentKeyId = kvdbKey.id;
+        updatedKeys.moduleSchemaVersion = KvdbDataSchema::Version::VERSION_5;
+        updatedKeys.currentData = model.data;
+        writeThroughModuleKeysInCache(kvdbId, updatedKeys, keys, updateKvdbDio.creatorUserId, version + 1);
+    }
     PRIVMX_DEBUG_TIME_STOP(PlatformKvdb, updateKvdb, data send)
 }
 
@@ -265,7 +329,7 @@ core::PagingList<Kvdb> KvdbApiImpl::listKvdbsEx(const std::string& contextId, co
     });
 }
 
-KvdbEntry KvdbApiImpl::getEntry(const std::string& kvdbId, const std::string& key) {
+KvdbEntry KvdbApiImpl::getEntry(const std::string& kvdbId, const std::string& key, int64_t fields) {
     PRIVMX_DEBUG_TIME_START(PlatformKvdb, getEntry)
     server::KvdbEntryGetModel model {.kvdbId = kvdbId, .kvdbEntryKey = key};
     PRIVMX_DEBUG_TIME_CHECKPOINT(PlatformKvdb, getEntry, getting entry)
@@ -273,7 +337,7 @@ KvdbEntry KvdbApiImpl::getEntry(const std::string& kvdbId, const std::string& ke
     PRIVMX_DEBUG_TIME_CHECKPOINT(PlatformKvdb, getEntry, data recived);
     KvdbEntry result;
     PRIVMX_DEBUG_TIME_CHECKPOINT(PlatformKvdb, getEntry, getting kvdb)
-    result = validateDecryptAndConvertEntryDataToEntry(entry, getEntryDecryptionKeys(entry));
+    result = validateDecryptAndConvertEntryDataToEntry(entry, getEntryDecryptionKeys(entry), fields);
     PRIVMX_DEBUG_TIME_STOP(PlatformKvdb, getEntry, data decrypted)
     return result;
 }
@@ -311,24 +375,36 @@ core::PagingList<std::string> KvdbApiImpl::listEntriesKeys(const std::string& kv
     });
 }
 
-core::PagingList<KvdbEntry> KvdbApiImpl::listEntries(const std::string& kvdbId, const core::PagingQuery& pagingQuery) {
+core::PagingList<KvdbEntry> KvdbApiImpl::listEntries(const std::string& kvdbId, const core::PagingQuery& pagingQuery, int64_t fields) {
     PRIVMX_DEBUG_TIME_START(PlatformKvdb, listEntry)
+    auto page = fetchEntriesPage(kvdbId, pagingQuery, fields);
+    PRIVMX_DEBUG_TIME_CHECKPOINT(PlatformKvdb, listEntriesKeys, data send)
+    auto entries = page.decrypt();
+    PRIVMX_DEBUG_TIME_STOP(PlatformKvdb, listEntriesKeys, data decrypted)
+    return core::PagingList<KvdbEntry>({
+        .totalAvailable = page.totalAvailable,
+        .readItems = entries
+    });
+}
+
+core::CursorPage<KvdbEntry> KvdbApiImpl::fetchEntriesPage(const std::string& kvdbId, const core::PagingQuery& pagingQuery, int64_t fields) {
     server::KvdbListEntriesModel model;
     model.kvdbId = kvdbId;
     core::ListQueryMapper::map(model, pagingQuery);
-    PRIVMX_DEBUG_TIME_CHECKPOINT(PlatformKvdb, listEntry, getting listEntry)
     auto entriesList = _serverApi.kvdbListEntries(model);
-    PRIVMX_DEBUG_TIME_CHECKPOINT(PlatformKvdb, listEntriesKeys, data send)
     auto kvdb = entriesList.kvdb;
     assertKvdbDataIntegrity(kvdb);
     setNewModuleKeysInCache(kvdb.id, kvdbToModuleKeys(kvdb), kvdb.version);
-    PRIVMX_DEBUG_TIME_CHECKPOINT(PlatformKvdb, listEntriesKeys, data send)
-    auto entries = validateDecryptAndConvertKvdbEntriesDataToKvdbEntries(entriesList.kvdbEntries, kvdbToModuleKeys(kvdb));
-    PRIVMX_DEBUG_TIME_STOP(PlatformKvdb, listEntriesKeys, data decrypted)
-    return core::PagingList<KvdbEntry>({
+    auto entries = entriesList.kvdbEntries;
+    // entries have no IDs, so the following pages are requested by skipping the read ones
+    return core::CursorPage<KvdbEntry>{
         .totalAvailable = entriesList.count,
-        .readItems = entries
-    });
+        .size = entries.size(),
+        .lastId = std::nullopt,
+        .decrypt = [this, entries, kvdbKeys = kvdbToModuleKeys(kvdb), fields]() {
+            return validateDecryptAndConvertKvdbEntriesDataToKvdbEntries(entries, kvdbKeys, fields);
+        }
+    };
 }
 
 void KvdbApiImpl::setEntry(const std::string& kvdbId, const std::string& key, const core::Buffer& publicMeta, const core::Buffer& privateMeta, const core::Buffer& data, int64_t version) {
@@ -460,12 +536,12 @@ void KvdbApiImpl::processNotificationEvent(const std::string& type, const core::
 }
 
 void KvdbApiImpl::processConnectedEvent() {
-    invalidateModuleKeysInCache();
+    revalidateModuleKeysInCache();
 }
 
 void KvdbApiImpl::processDisconnectedEvent() {
     LOG_TRACE("KvdbApiImpl recived DisconnectedEvent");
-    invalidateModuleKeysInCache();
+    revalidateModuleKeysInCache();
     privmx::utils::ManualManagedClass<KvdbApiImpl>::cleanup();
 }
 
@@ -528,6 +604,7 @@ KvdbDataSchema::Version KvdbApiImpl::getKvdbDataEntryStructureVersion(server::Kv
         auto version = versioned.version;
         switch (version) {
             case core::ModuleDataSchema::Version::VERSION_5:
+            case core::ModuleDataSchema::Version::VERSION_6:
                 return KvdbDataSchema::Version::VERSION_5;
             default:
                 return KvdbDataSchema::Version::UNKNOWN;
@@ -659,7 +736,7 @@ Kvdb KvdbApiImpl::validateDecryptAndConvertKvdbDataToKvdb(server::KvdbInfo kvdb)
 }
 
 
-DecryptedKvdbEntryDataV5 KvdbApiImpl::decryptKvdbEntryDataV5(server::KvdbEntryInfo entry, const core::DecryptedEncKey& encKey) {
+DecryptedKvdbEntryDataV5 KvdbApiImpl::decryptKvdbEntryDataV5(server::KvdbEntryInfo entry, const core::DecryptedEncKey& encKey, int64_t fields) {
     try {
         auto encryptedEntryData = server::EncryptedKvdbEntryDataV5::fromJSON(entry.kvdbEntryValue);
         if(encKey.statusCode != 0) {
@@ -667,7 +744,7 @@ DecryptedKvdbEntryDataV5 KvdbApiImpl::decryptKvdbEntryDataV5(server::KvdbEntryIn
             tmp.statusCode = encKey.statusCode;
             return tmp;
         }
-        return _entryDataEncryptorV5.decrypt(encryptedEntryData, encKey.key);
+        return _entryDataEncryptorV5.decrypt(encryptedEntryData, encKey.key, fields);
     } catch (const core::Exception& e) {
         return DecryptedKvdbEntryDataV5{{.dataStructureVersion = core::ModuleDataSchema::Version::VERSION_5, .statusCode = e.getCode()}, {},{},{},{},{},{}};
     } catch (const privmx::utils::PrivmxException& e) {
@@ -729,14 +806,14 @@ KvdbEntryDataSchema::Version KvdbApiImpl::getEntryDataStructureVersion(server::K
     return KvdbEntryDataSchema::Version::UNKNOWN;
 }
 
-std::tuple<KvdbEntry, core::DataIntegrityObject> KvdbApiImpl::decryptAndConvertEntryDataToEntry(server::KvdbEntryInfo entry, const core::DecryptedEncKey& encKey) {
+std::tuple<KvdbEntry, core::DataIntegrityObject> KvdbApiImpl::decryptAndConvertEntryDataToEntry(server::KvdbEntryInfo entry, const core::DecryptedEncKey& encKey, int64_t fields) {
     switch (getEntryDataStructureVersion(entry)) {
         case KvdbEntryDataSchema::Version::UNKNOWN: {
             auto e = UnknownKvdbEntryFormatException();
             return std::make_tuple(convertServerKvdbEntryToLibKvdbEntry(entry,{},{},{},{},e.getCode()), core::DataIntegrityObject());
         }
         case KvdbEntryDataSchema::Version::VERSION_5: {
-            auto decryptEntry = decryptKvdbEntryDataV5(entry, encKey);
+            auto decryptEntry = decryptKvdbEntryDataV5(entry, encKey, fields);
             return std::make_tuple(convertDecryptedKvdbEntryDataV5ToKvdbEntry(entry, decryptEntry), decryptEntry.dio);
         }
     }
@@ -744,7 +821,7 @@ std::tuple<KvdbEntry, core::DataIntegrityObject> KvdbApiImpl::decryptAndConvertE
     return std::make_tuple(convertServerKvdbEntryToLibKvdbEntry(entry,{},{},{},{},e.getCode()), core::DataIntegrityObject());
 }
 
-std::vector<KvdbEntry> KvdbApiImpl::validateDecryptAndConvertKvdbEntriesDataToKvdbEntries(std::vector<server::KvdbEntryInfo> entries, const core::ModuleKeys& kvdbKeys) {
+std::vector<KvdbEntry> KvdbApiImpl::validateDecryptAndConvertKvdbEntriesDataToKvdbEntries(std::vector<server::KvdbEntryInfo> entries, const core::ModuleKeys& kvdbKeys, int64_t fields) {
     std::set<std::string> keyIds;
     for (auto entry : entries) {
         keyIds.insert(entry.keyId);
@@ -752,6 +829,7 @@ std::vector<KvdbEntry> KvdbApiImpl::validateDecryptAndConvertKvdbEntriesDataToKv
     core::KeyDecryptionAndVerificationRequest keyProviderRequest;
     core::EncKeyLocation location{.contextId=kvdbKeys.contextId, .resourceId=kvdbKeys.moduleResourceId};
     keyProviderRequest.addMany(kvdbKeys.keys, keyIds, location);
+    keyProviderRequest.addKeyChain(kvdbKeys, location);
     auto keyMap = _keyProvider->getKeysAndVerify(keyProviderRequest).at(location);
     std::vector<KvdbEntry> result;
     std::vector<core::DataIntegrityObject> entriesDIO;
@@ -760,7 +838,7 @@ std::vector<KvdbEntry> KvdbApiImpl::validateDecryptAndConvertKvdbEntriesDataToKv
         try {
             auto statusCode = validateEntryDataIntegrity(entry, kvdbKeys.moduleResourceId);
             if(statusCode == 0) {
-                auto tmp = decryptAndConvertEntryDataToEntry(entry, keyMap.at(entry.keyId));
+                auto tmp = decryptAndConvertEntryDataToEntry(entry, keyMap.at(entry.keyId), fields);
                 result.push_back(std::get<0>(tmp));
                 auto entryDIO = std::get<1>(tmp);
                 entriesDIO.push_back(entryDIO);
@@ -805,7 +883,7 @@ std::vector<KvdbEntry> KvdbApiImpl::validateDecryptAndConvertKvdbEntriesDataToKv
     return result;
 }
 
-KvdbEntry KvdbApiImpl::validateDecryptAndConvertEntryDataToEntry(server::KvdbEntryInfo entry, const core::ModuleKeys& kvdbKeys) {
+KvdbEntry KvdbApiImpl::validateDecryptAndConvertEntryDataToEntry(server::KvdbEntryInfo entry, const core::ModuleKeys& kvdbKeys, int64_t fields) {
     try {
         auto keyId = entry.keyId;
         // Validate data Integrity
@@ -817,12 +895,13 @@ KvdbEntry KvdbApiImpl::validateDecryptAndConvertEntryDataToEntry(server::KvdbEnt
         core::KeyDecryptionAndVerificationRequest keyProviderRequest;
         core::EncKeyLocation location{.contextId=entry.contextId, .resourceId=kvdbKeys.moduleResourceId};
         keyProviderRequest.addOne(kvdbKeys.keys, keyId, location);
+        keyProviderRequest.addKeyChain(kvdbKeys, location);
         // Send request to KeyProvider
         auto encKey = _keyProvider->getKeysAndVerify(keyProviderRequest).at(location).at(keyId);
         // decrypt entry
         KvdbEntry result;
         core::DataIntegrityObject entryDIO;
-        std::tie(result, entryDIO) = decryptAndConvertEntryDataToEntry(entry, encKey);
+        std::tie(result, entryDIO) = decryptAndConvertEntryDataToEntry(entry, encKey, fields);
         if(result.statusCode != 0) return result;
         // Validate with UserVerifier
         std::vector<core::VerificationRequest> verifierInput {};
@@ -913,7 +992,8 @@ core::ModuleKeys KvdbApiImpl::kvdbToModuleKeys(server::KvdbInfo kvdb) {
         .currentKeyId=kvdb.keyId,
         .moduleSchemaVersion=getKvdbDataEntryStructureVersion(kvdb.data.back()),
         .moduleResourceId=kvdb.resourceId,
-        .contextId = kvdb.contextId
+        .contextId = kvdb.contextId,
+        .currentData = kvdb.data.back().data
     };
 }
 
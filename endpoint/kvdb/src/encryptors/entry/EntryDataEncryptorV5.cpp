@@ -28,19 +28,28 @@ server::EncryptedKvdbEntryDataV5 EntryDataEncryptorV5::encrypt(const KvdbEntryDa
     server::EncryptedKvdbEntryDataV5 result;
     result.version = KvdbEntryDataSchema::Version::VERSION_5;
     std::unordered_map<std::string, std::string> fieldChecksums;
-    result.publicMeta = _dataEncryptor.signAndEncode(messageData.publicMeta, authorPrivateKey);
+    std::vector<core::DataEncryptorV4::FieldToEncode> fields {
+        {messageData.publicMeta, std::nullopt},
+        {messageData.privateMeta, encryptionKey},
+        {messageData.data, encryptionKey}
+    };
+    if (messageData.internalMeta.has_value()) {
+        fields.push_back({messageData.internalMeta.value(), encryptionKey});
+    }
+    auto encoded = _dataEncryptor.signAndEncodeMany(fields, authorPrivateKey);
+    result.publicMeta = encoded[0];
     fieldChecksums.insert(std::make_pair("publicMeta", privmx::crypto::Crypto::sha256(result.publicMeta)));
     try {
         result.publicMetaObject = utils::Utils::parseJsonObject(messageData.publicMeta.stdString());
     } catch (...) {
         result.publicMetaObject = Poco::Dynamic::Var();
     }
-    result.privateMeta = _dataEncryptor.signAndEncryptAndEncode(messageData.privateMeta, authorPrivateKey, encryptionKey);
+    result.privateMeta = encoded[1];
     fieldChecksums.insert(std::make_pair("privateMeta", privmx::crypto::Crypto::sha256(result.privateMeta)));
-    result.data = _dataEncryptor.signAndEncryptAndEncode(messageData.data, authorPrivateKey, encryptionKey);
+    result.data = encoded[2];
     fieldChecksums.insert(std::make_pair("data", privmx::crypto::Crypto::sha256(result.data)));
     if (messageData.internalMeta.has_value()) {
-        result.internalMeta = _dataEncryptor.signAndEncryptAndEncode(messageData.internalMeta.value(), authorPrivateKey, encryptionKey);
+        result.internalMeta = encoded[3];
         fieldChecksums.insert(std::make_pair("internalMeta", privmx::crypto::Crypto::sha256(result.internalMeta.value())));
     }
     result.authorPubKey = authorPrivateKey.getPublicKey().toBase58DER();
@@ -49,27 +58,48 @@ server::EncryptedKvdbEntryDataV5 EntryDataEncryptorV5::encrypt(const KvdbEntryDa
     return result;
 }
 
-DecryptedKvdbEntryDataV5 EntryDataEncryptorV5::decrypt(const server::EncryptedKvdbEntryDataV5& encryptedEntryData, const std::string& encryptionKey) {
+DecryptedKvdbEntryDataV5 EntryDataEncryptorV5::decrypt(const server::EncryptedKvdbEntryDataV5& encryptedEntryData, const std::string& encryptionKey,
+                                                       int64_t selectedFields) {
     DecryptedKvdbEntryDataV5 result;
     result.statusCode = 0;
     result.dataStructureVersion = KvdbEntryDataSchema::Version::VERSION_5;
     try {
         result.dio = getDIOAndAssertIntegrity(encryptedEntryData);
         auto authorPublicKey = crypto::PublicKey::fromBase58DER(encryptedEntryData.authorPubKey);
-        result.publicMeta = _dataEncryptor.decodeAndVerify(encryptedEntryData.publicMeta, authorPublicKey);
-        if (!encryptedEntryData.publicMetaObject.isEmpty()) {
-            auto tmp_1 = utils::Utils::stringifyVar(utils::Utils::parseJsonObject(result.publicMeta.stdString()));
-            auto tmp_2 = utils::Utils::stringifyVar(encryptedEntryData.publicMetaObject);
-            if (tmp_1 != tmp_2) {
-                auto e = KvdbEntryPublicDataMismatchException();
-                result.statusCode = e.getCode();
+        // the fields left out are not decrypted, the checksums of the verified DIO already cover them
+        std::vector<core::DataEncryptorV4::FieldToDecode> fields;
+        if (selectedFields & core::DataField::PUBLIC_META) {
+            fields.push_back({encryptedEntryData.publicMeta, std::nullopt});
+        }
+        if (selectedFields & core::DataField::PRIVATE_META) {
+            fields.push_back({encryptedEntryData.privateMeta, encryptionKey});
+        }
+        if (selectedFields & core::DataField::DATA) {
+            fields.push_back({encryptedEntryData.data, encryptionKey});
+        }
+        if (encryptedEntryData.internalMeta.has_value()) {
+            fields.push_back({encryptedEntryData.internalMeta.value(), encryptionKey});
+        }
+        auto decoded = fields.empty() ? std::vector<core::Buffer>() : _dataEncryptor.decodeAndVerifyMany(fields, authorPublicKey);
+        size_t next = 0;
+        if (selectedFields & core::DataField::PUBLIC_META) {
+            result.publicMeta = decoded[next++];
+            if (!encryptedEntryData.publicMetaObject.isEmpty()) {
+                auto tmp_1 = utils::Utils::stringifyVar(utils::Utils::parseJsonObject(result.publicMeta.stdString()));
+                auto tmp_2 = utils::Utils::stringifyVar(encryptedEntryData.publicMetaObject);
+                if (tmp_1 != tmp_2) {
+                    auto e = KvdbEntryPublicDataMismatchException();
+                    result.statusCode = e.getCode();
+                }
             }
         }
-        result.privateMeta = _dataEncryptor.decodeAndDecryptAndVerify(encryptedEntryData.privateMeta, authorPublicKey, encryptionKey);
-        result.data = _dataEncryptor.decodeAndDecryptAndVerify(encryptedEntryData.data, authorPublicKey, encryptionKey);
-        result.internalMeta = encryptedEntryData.internalMeta.has_value() ?
-            std::make_optional(_dataEncryptor.decodeAndDecryptAndVerify(encryptedEntryData.internalMeta.value(), authorPublicKey, encryptionKey)) :
-            std::nullopt;
+        if (selectedFields & core::DataField::PRIVATE_META) {
+            result.privateMeta = decoded[next++];
+        }
+        if (selectedFields & core::DataField::DATA) {
+            result.data = decoded[next++];
+        }
+        result.internalMeta = encryptedEntryData.internalMeta.has_value() ? std::make_optional(decoded[next]) : std::nullopt;
         result.authorPubKey = encryptedEntryData.authorPubKey;
     } catch (const privmx::endpoint::core::Exception& e) {
         result.statusCode = e.getCode();
@@ -126,6 +156,10 @@ core::DataIntegrityObject EntryDataEncryptorV5::getDIOAndAssertIntegrity(const s
     return dio;
 }
 
+void EntryDataEncryptorV5::setCompressor(const std::shared_ptr<const core::DataCompressor>& compressor) {
+    _dataEncryptor.setCompressor(compressor);
+}
+
 void EntryDataEncryptorV5::assertDataFormat(const server::EncryptedKvdbEntryDataV5& encryptedEntryData) {
     if (
         encryptedEntryData.version != KvdbEntryDataSchema::Version::VERSION_5 ||
@@ -34,7 +34,9 @@ std::map<KvdbApiVarInterface::METHOD, Poco::Dynamic::Var (KvdbApiVarInterface::*
                                         {SubscribeFor, &KvdbApiVarInterface::subscribeFor},
                                         {UnsubscribeFrom, &KvdbApiVarInterface::unsubscribeFrom},
                                         {BuildSubscriptionQuery, &KvdbApiVarInterface::buildSubscriptionQuery},
-                                        {BuildSubscriptionQueryForSelectedEntry, &KvdbApiVarInterface::buildSubscriptionQueryForSelectedEntry}};
+                                        {BuildSubscriptionQueryForSelectedEntry, &KvdbApiVarInterface::buildSubscriptionQueryForSelectedEntry},
+                                        {AddKvdbMembers, &KvdbApiVarInterface::addKvdbMembers},
+                                        {RemoveKvdbMembers, &KvdbApiVarInterface::removeKvdbMembers}};
 
 Poco::Dynamic::Var KvdbApiVarInterface::create(const Poco::Dynamic::Var& args) {
     core::VarInterfaceUtil::validateAndExtractArray(args, 0);
@@ -69,6 +71,23 @@ Poco::Dynamic::Var KvdbApiVarInterface::updateKvdb(const Poco::Dynamic::Var& arg
     return {};
 }
 
+Poco::Dynamic::Var KvdbApiVarInterface::addKvdbMembers(const Poco::Dynamic::Var& args) {
+    auto argsArr = core::VarInterfaceUtil::validateAndExtractArray(args, 3);
+    auto kvdbId = _deserializer.deserialize<std::string>(argsArr->get(0), "kvdbId");
+    auto users = _deserializer.deserializeVector<core::UserWithPubKey>(argsArr->get(1), "users");
+    auto managers = _deserializer.deserializeVector<core::UserWithPubKey>(argsArr->get(2), "managers");
+    _kvdbApi.addKvdbMembers(kvdbId, users, managers);
+    return {};
+}
+
+Poco::Dynamic::Var KvdbApiVarInterface::removeKvdbMembers(const Poco::Dynamic::Var& args) {
+    auto argsArr = core::VarInterfaceUtil::validateAndExtractArray(args, 2);
+    auto kvdbId = _deserializer.deserialize<std::string>(argsArr->get(0), "kvdbId");
+    auto userIds = _deserializer.deserializeVector<std::string>(argsArr->get(1), "userIds");
+    _kvdbApi.removeKvdbMembers(kvdbId, userIds);
+    return {};
+}
+
 Poco::Dynamic::Var KvdbApiVarInterface::deleteKvdb(const Poco::Dynamic::Var& args) {
     auto argsArr = core::VarInterfaceUtil::validateAndExtractArray(args, 1);
     auto kvdbId = _deserializer.deserialize<std::string>(argsArr->get(0), "kvdbId");
@@ -92,10 +111,14 @@ Poco::Dynamic::Var KvdbApiVarInterface::listKvdbs(const Poco::Dynamic::Var& args
 }
 
 Poco::Dynamic::Var KvdbApiVarInterface::getEntry(const Poco::Dynamic::Var& args) {
-    auto argsArr = core::VarInterfaceUtil::validateAndExtractArray(args, 2);
+    auto argsArr = core::VarInterfaceUtil::validateAndExtractArray(args, 2, 3);
     auto kvdbId = _deserializer.deserialize<std::string>(argsArr->get(0), "kvdbId");
     auto key = _deserializer.deserialize<std::string>(argsArr->get(1), "key");
-    auto result = _kvdbApi.getEntry(kvdbId, key);
+    int64_t fields = core::DataField::ALL_DATA_FIELDS;
+    if(argsArr->size() >= 3) {
+        fields = _deserializer.deserialize<int64_t>(argsArr->get(2), "fields");
+    }
+    auto result = _kvdbApi.getEntry(kvdbId, key, fields);
     return _serializer.serialize(result);
 }
 
@@ -108,10 +131,14 @@ Poco::Dynamic::Var KvdbApiVarInterface::listEntriesKeys(const Poco::Dynamic::Var
 }
 
 Poco::Dynamic::Var KvdbApiVarInterface::listEntries(const Poco::Dynamic::Var& args) {
-    auto argsArr = core::VarInterfaceUtil::validateAndExtractArray(args, 2);
+    auto argsArr = core::VarInterfaceUtil::validateAndExtractArray(args, 2, 3);
     auto kvdbId = _deserializer.deserialize<std::string>(argsArr->get(0), "kvdbId");
     auto pagingQuery = _deserializer.deserialize<core::PagingQuery>(argsArr->get(1), "pagingQuery");
-    auto result = _kvdbApi.listEntries(kvdbId, pagingQuery);
+    int64_t fields = core::DataField::ALL_DATA_FIELDS;
+    if(argsArr->size() >= 3) {
+        fields = _deserializer.deserialize<int64_t>(argsArr->get(2), "fields");
+    }
+    auto result = _kvdbApi.listEntries(kvdbId, pagingQuery, fields);
     return _serializer.serialize(result);
 }
 
@@ -34,6 +34,39 @@ run_benchmark thread 65541
 echo "Thread sendMessage 4KB"
 run_benchmark thread 65542
 
+echo "Thread listMessages 10 messages"
+run_benchmark thread 196608
+
+echo "Thread listMessages 100 messages"
+run_benchmark thread 196609
+
+echo "Thread listMessages 1000 messages"
+run_benchmark thread 196610
+
+echo "Thread add and remove a member of 1000 threads one by one"
+run_benchmark thread 262144
+
+echo "Thread add and remove a member of 1000 threads with bulk update"
+run_benchmark thread 262145
+
+echo "Thread sendMessageAsync 100 messages 1 in flight, 20 ms latency"
+SIMULATED_LATENCY_MS=20 run_benchmark thread 327680
+
+echo "Thread sendMessageAsync 100 messages 4 in flight, 20 ms latency"
+SIMULATED_LATENCY_MS=20 run_benchmark thread 327681
+
+echo "Thread sendMessageAsync 100 messages 16 in flight, 20 ms latency"
+SIMULATED_LATENCY_MS=20 run_benchmark thread 327682
+
+echo "Thread sendMessageAsync 100 messages 64 in flight, 20 ms latency"
+SIMULATED_LATENCY_MS=20 run_benchmark thread 327683
+
+echo "Thread sendMessage 100 messages 64KB through C interface with JSON envelope"
+run_benchmark thread 393216
+
+echo "Thread sendMessage 100 messages 64KB through binary C interface"
+run_benchmark thread 393217
+
 echo "Store getFile"
 run_benchmark store 131072
 
@@ -43,6 +76,15 @@ run_benchmark store 131073
 echo "Store getFile 8MB"
 run_benchmark store 131074
 
+echo "Store read 512KB from 1MB file"
+run_benchmark store 196608
+
+echo "Store write and read 1MB in 64KB chunks through C interface with JSON envelope"
+run_benchmark store 262144
+
+echo "Store write and read 1MB in 64KB chunks through binary C interface"
+run_benchmark store 262145
+
 echo "Store create file"
 run_benchmark store 65536
 
@@ -70,6 +112,114 @@ run_benchmark inbox 65541
 echo "Inbox create entry 5 files 1MB"
 run_benchmark inbox 65542
 
+echo "Crypto wrap key for 100 members"
+run_benchmark crypto 65536
+
+echo "Crypto wrap key for 100 members no ECIES key cache"
+run_benchmark crypto 65537
+
+echo "Crypto unwrap 100 keys from 4 authors"
+run_benchmark crypto 65538
+
+echo "Crypto unwrap 100 keys from 4 authors no ECIES key cache"
+run_benchmark crypto 65539
+
+echo "Crypto data channel 1000 messages V1"
+run_benchmark crypto 131072
+
+echo "Crypto data channel 1000 messages V2"
+run_benchmark crypto 131073
+
+echo "Crypto data channel 1000 messages V2 reordered"
+run_benchmark crypto 131074
+
+echo "Crypto sign 100 messages"
+run_benchmark crypto 196608
+
+echo "Crypto signMany 100 messages"
+run_benchmark crypto 196609
+
+echo "Crypto verify 100 signatures"
+run_benchmark crypto 196610
+
+echo "Crypto verifyMany 100 signatures"
+run_benchmark crypto 196611
+
+echo "Crypto sign, encrypt, decrypt and verify 512KB message"
+run_benchmark crypto 327680
+
+echo "Resolve keys of 1k members full list update"
+run_benchmark crypto 458752
+
+echo "Resolve keys of 1k members delta update"
+run_benchmark crypto 458753
+
+echo "Resolve keys of 10k members full list update"
+run_benchmark crypto 458754
+
+echo "Resolve keys of 10k members delta update"
+run_benchmark crypto 458755
+
+echo "Resolve keys of 100k members full list update"
+run_benchmark crypto 458756
+
+echo "Resolve keys of 100k members delta update"
+run_benchmark crypto 458757
+
+echo "Encrypt 256 MiB with encryptDataSymmetric"
+run_benchmark crypto 589824
+
+echo "Encrypt 256 MiB with symmetric stream 1 thread"
+run_benchmark crypto 589825
+
+echo "Encrypt 256 MiB with symmetric stream 4 threads"
+run_benchmark crypto 589826
+
+echo "Encrypt and decrypt 256 MiB with symmetric streams 4 threads"
+run_benchmark crypto 589827
+
+echo "Crypto and RPC bookkeeping 10k times with performance metrics disabled"
+run_benchmark crypto 720896
+
+echo "Crypto and RPC bookkeeping 10k times with performance metrics enabled"
+run_benchmark crypto 720897
+
+echo "Encode 16 KiB JSON message 1000 times without compression"
+run_benchmark crypto 786432
+
+echo "Encode 16 KiB JSON message 1000 times with compression"
+run_benchmark crypto 786433
+
+echo "Decode 16 KiB JSON message 1000 times without compression"
+run_benchmark crypto 786434
+
+echo "Decode 16 KiB JSON message 1000 times with compression"
+run_benchmark crypto 786435
+
+echo "Scan 2000 messages in pages at 20 ms RTT page after page"
+run_benchmark crypto 851968
+
+echo "Scan 2000 messages in pages at 20 ms RTT with a cursor"
+run_benchmark crypto 851969
+
+echo "Scan 2000 messages in pages at 100 ms RTT page after page"
+run_benchmark crypto 851970
+
+echo "Scan 2000 messages in pages at 100 ms RTT with a cursor"
+run_benchmark crypto 851971
+
+echo "Decrypt a list of 100 messages with 64 KiB data, all fields"
+run_benchmark crypto 917504
+
+echo "Decrypt a list of 100 messages with 64 KiB data, public meta only"
+run_benchmark crypto 917505
+
+echo "C interface 1000 events with JSON envelope"
+run_benchmark crypto 262144
+
+echo "C interface 1000 events with binary interface"
+run_benchmark crypto 262145
+
 
 
 
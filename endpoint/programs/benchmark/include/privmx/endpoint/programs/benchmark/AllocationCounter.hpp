@@ -0,0 +1,25 @@
+/*
+PrivMX Endpoint.
+Copyright © 2024 Simplito sp. z o.o.
+
+This file is part of the PrivMX Platform (https://privmx.dev).
+This software is Licensed under the PrivMX Free License.
+
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef _PRIVMXLIB_ENDPOINT_BENCHMARK_ALLOCATIONCOUNTER_
+#define _PRIVMXLIB_ENDPOINT_BENCHMARK_ALLOCATIONCOUNTER_
+
+#include <cstdint>
+
+// Counts heap allocations made through operator new in the whole process.
+struct AllocationCounter {
+    uint64_t count;
+    uint64_t bytes;
+
+    static AllocationCounter get();
+};
+
+#endif // _PRIVMXLIB_ENDPOINT_BENCHMARK_ALLOCATIONCOUNTER_
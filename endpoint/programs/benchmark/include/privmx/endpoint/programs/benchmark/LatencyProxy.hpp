@@ -0,0 +1,37 @@
+/*
+PrivMX Endpoint.
+Copyright © 2024 Simplito sp. z o.o.
+
+This file is part of the PrivMX Platform (https://privmx.dev).
+This software is Licensed under the PrivMX Free License.
+
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef _PRIVMXLIB_ENDPOINT_BENCHMARK_LATENCYPROXY_
+#define _PRIVMXLIB_ENDPOINT_BENCHMARK_LATENCYPROXY_
+
+#include <chrono>
+#include <string>
+
+// Local TCP proxy in front of the plain HTTP platform url, delaying the data sent in each direction
+// by a fixed one-way latency, so that the benchmarks see the round trips of a remote server.
+// Data read from a socket is forwarded once its delay passes, without waiting for the data read before it.
+class LatencyProxy {
+public:
+    LatencyProxy(const std::string& platformUrl, std::chrono::milliseconds oneWayLatency);
+    // url of the proxy to connect to instead of the platform url
+    const std::string& getUrl() const { return _url; }
+
+private:
+    void acceptLoop();
+
+    std::string _host;
+    std::string _port;
+    std::chrono::milliseconds _latency;
+    int _listenSocket;
+    std::string _url;
+};
+
+#endif // _PRIVMXLIB_ENDPOINT_BENCHMARK_LATENCYPROXY_
@@ -3,7 +3,9 @@
 #include <chrono>
 #include <thread>
 #include <functional>
+#include <algorithm>
 #include <condition_variable>
+#include <sys/resource.h>
 #include <privmx/endpoint/core/Config.hpp>
 #include <privmx/endpoint/core/Connection.hpp>
 #include <privmx/endpoint/core/Exception.hpp>
@@ -14,6 +16,8 @@
 #include "privmx/endpoint/programs/benchmark/Types.hpp"
 #include "privmx/endpoint/programs/benchmark/GetTestFunction.hpp"
 #include "privmx/endpoint/programs/benchmark/PrepereInitData.hpp"
+#include "privmx/endpoint/programs/benchmark/AllocationCounter.hpp"
+#include "privmx/endpoint/programs/benchmark/LatencyProxy.hpp"
 #include <privmx/utils/Debug.hpp>
 
 using namespace std::chrono_literals;
@@ -56,8 +60,15 @@ int main(int argc, char** argv) {
     const std::string solution = reader->getString("Login.solutionId");
     auto env_platformUrl = std::getenv("PLATFORM_URL");
     const std::string platformUrl = env_platformUrl == NULL ? reader->getString("Login.instanceUrl") : ("http://" + std::string(env_platformUrl) + "/");
+    // SIMULATED_LATENCY_MS puts a local proxy adding the given one-way latency in front of the platform
+    auto env_latency = std::getenv("SIMULATED_LATENCY_MS");
+    std::string connectUrl = platformUrl;
+    if(env_latency != NULL) {
+        static LatencyProxy latencyProxy(platformUrl, std::chrono::milliseconds(std::stoll(env_latency)));
+        connectUrl = latencyProxy.getUrl();
+    }
     // initialising connection
-    std::shared_ptr<core::Connection> connection = std::make_shared<core::Connection>(core::Connection::connect(userPrivKey, solution, platformUrl));
+    std::shared_ptr<core::Connection> connection = std::make_shared<core::Connection>(core::Connection::connect(userPrivKey, solution, connectUrl));
     std::shared_ptr<thread::ThreadApi> threadApi = std::make_shared<thread::ThreadApi>(thread::ThreadApi::create(*connection));
     std::shared_ptr<store::StoreApi> storeApi = std::make_shared<store::StoreApi>(store::StoreApi::create(*connection));
     std::shared_ptr<inbox::InboxApi> inboxApi = std::make_shared<inbox::InboxApi>(inbox::InboxApi::create(*connection, *threadApi, *storeApi));
@@ -82,7 +93,10 @@ int main(int argc, char** argv) {
     std::condition_variable cv;
     bool stop = false;
     std::vector<std::chrono::_V2::system_clock::time_point> run_timestamps = {};
+    AllocationCounter allocationsStart;
+    AllocationCounter allocationsEnd;
     std::thread t([&]() {
+        allocationsStart = AllocationCounter::get();
         run_timestamps.push_back(std::chrono::system_clock::now());
         while (benchmark_mode == Mode::Timeout ? !stop : N < benchmark_duration) {
             exec(connection, threadApi, storeApi, inboxApi, initLoopData);
@@ -92,6 +106,7 @@ int main(int argc, char** argv) {
                 // std::cout << N << ": time - " << std::chrono::duration<double>{(run_timestamps[run_timestamps.size()-1] - run_timestamps[run_timestamps.size()-2])}.count()*1000 << "ms" << std::endl;
             }
         }
+        allocationsEnd = AllocationCounter::get();
         cv.notify_all();
     }); 
     t.detach();
@@ -122,6 +137,12 @@ int main(int argc, char** argv) {
     } 
     std::cout << "Min single exec time - " << min.count() * 1000 << "ms" << std::endl;
     std::cout << "Max single exec time - " << max.count() * 1000 << "ms" << std::endl;
+    std::cout << "Avarage allocations - " << (allocationsEnd.count - allocationsStart.count) / std::max<uint64_t>(N, 1) << std::endl;
+    std::cout << "Avarage allocated bytes - " << (allocationsEnd.bytes - allocationsStart.bytes) / std::max<uint64_t>(N, 1) << std::endl;
+    struct rusage usage;
+    if(getrusage(RUSAGE_SELF, &usage) == 0) {
+        std::cout << "Peak RSS - " << usage.ru_maxrss / 1024 << "MB" << std::endl;
+    }
     
     return 0;
 }
@@ -0,0 +1,39 @@
+/*
+PrivMX Endpoint.
+Copyright © 2024 Simplito sp. z o.o.
+
+This file is part of the PrivMX Platform (https://privmx.dev).
+This software is Licensed under the PrivMX Free License.
+
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include "privmx/endpoint/programs/benchmark/AllocationCounter.hpp"
+
+static std::atomic<uint64_t> allocationCount{0};
+static std::atomic<uint64_t> allocatedBytes{0};
+
+AllocationCounter AllocationCounter::get() {
+    return AllocationCounter{.count = allocationCount.load(), .bytes = allocatedBytes.load()};
+}
+
+void* operator new(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    if(void* ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
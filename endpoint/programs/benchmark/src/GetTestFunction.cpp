@@ -1,10 +1,46 @@
 #include "privmx/endpoint/programs/benchmark/GetTestFunction.hpp"
 #include <privmx/endpoint/crypto/CryptoApi.hpp>
 #include <privmx/utils/Utils.hpp>
+#include <privmx/crypto/Crypto.hpp>
+#include <privmx/crypto/EciesEncryptor.hpp>
+#include <privmx/endpoint/stream/encryptors/dataChannel/DataChannelMessageEncryptorV1.hpp>
+#include <privmx/endpoint/stream/encryptors/dataChannel/DataChannelMessageEncryptorV2.hpp>
+#include <privmx/endpoint/core/cinterface/core.h>
+#include <privmx/endpoint/core/encryptors/DataInnerEncryptorV4.hpp>
+#include <privmx/endpoint/core/encryptors/DataEncryptorV4.hpp>
+#include <privmx/endpoint/core/UsersKeysResolver.hpp>
+#include <privmx/endpoint/core/PrefetchingCursor.hpp>
+#include <privmx/endpoint/thread/ServerTypes.hpp>
+#include <privmx/endpoint/thread/encryptors/message/MessageDataEncryptorV5.hpp>
+#include <privmx/utils/MetricsRegistry.hpp>
+#include <privmx/endpoint/core/varinterface/EventQueueVarInterface.hpp>
+#include <privmx/endpoint/thread/cinterface/thread.h>
+#include <privmx/endpoint/thread/varinterface/ThreadApiVarInterface.hpp>
+#include <privmx/endpoint/store/cinterface/store.h>
+#include <privmx/endpoint/store/varinterface/StoreApiVarInterface.hpp>
+#include <Pson/BinaryString.hpp>
+#include <Poco/Dynamic/Var.h>
+#include <Poco/JSON/Array.h>
+#include <chrono>
 #include <iostream>
+#include <stdexcept>
+#include <thread>
 
 using namespace privmx::endpoint;
 
+// C interface handles made the same way as privmx_endpoint_newThreadApi/newStoreApi, but on the benchmark's connection
+static ThreadApi* getThreadCApi(std::shared_ptr<core::Connection> connection) {
+    auto api = new thread::ThreadApiVarInterface(*connection, core::VarSerializer::Options{.addType=true, .binaryFormat=core::VarSerializer::Options::PSON_BINARYSTRING});
+    api->exec(thread::ThreadApiVarInterface::Create, Poco::Dynamic::Var(Poco::JSON::Array::Ptr(new Poco::JSON::Array())));
+    return (ThreadApi*)api;
+}
+
+static StoreApi* getStoreCApi(std::shared_ptr<core::Connection> connection) {
+    auto api = new store::StoreApiVarInterface(*connection, core::VarSerializer::Options{.addType=true, .binaryFormat=core::VarSerializer::Options::PSON_BINARYSTRING});
+    api->exec(store::StoreApiVarInterface::Create, Poco::Dynamic::Var(Poco::JSON::Array::Ptr(new Poco::JSON::Array())));
+    return (StoreApi*)api;
+}
+
 std::function<
     void(
         std::shared_ptr<core::Connection>, 
@@ -227,6 +263,135 @@ std::function<
                     data[2]
                 );
             });
+        case 0x00030000:
+            // list 10 messages
+            return ([](std::shared_ptr<core::Connection> connection, std::shared_ptr<thread::ThreadApi> threadApi, std::shared_ptr<store::StoreApi> storeApi, std::shared_ptr<inbox::InboxApi> inboxApi, const std::vector<std::string>& data) {
+                threadApi->listMessages(
+                    data[2],
+                    {
+                        .skip=0, 
+                        .limit=10, 
+                        .sortOrder="desc"
+                    }
+                );
+            });
+        case 0x00030001:
+            // list 100 messages
+            return ([](std::shared_ptr<core::Connection> connection, std::shared_ptr<thread::ThreadApi> threadApi, std::shared_ptr<store::StoreApi> storeApi, std::shared_ptr<inbox::InboxApi> inboxApi, const std::vector<std::string>& data) {
+                threadApi->listMessages(
+                    data[2],
+                    {
+                        .skip=0, 
+                        .limit=100, 
+                        .sortOrder="desc"
+                    }
+                );
+            });
+        case 0x00030002:
+            // list 1000 messages, in pages of 100 as the server does not return more at once
+            return ([](std::shared_ptr<core::Connection> connection, std::shared_ptr<thread::ThreadApi> threadApi, std::shared_ptr<store::StoreApi> storeApi, std::shared_ptr<inbox::InboxApi> inboxApi, const std::vector<std::string>& data) {
+                for(int64_t skip = 0; skip < 1000; skip += 100) {
+                    threadApi->listMessages(
+                        data[2],
+                        {
+                            .skip=skip, 
+                            .limit=100, 
+                            .sortOrder="desc"
+                        }
+                    );
+                }
+            });
+        case 0x00040000:
+            // add a user to 1000 threads and remove them one thread at a time
+            return ([](std::shared_ptr<core::Connection> connection, std::shared_ptr<thread::ThreadApi> threadApi, std::shared_ptr<store::StoreApi> storeApi, std::shared_ptr<inbox::InboxApi> inboxApi, const std::vector<std::string>& data) {
+                std::vector<core::UserWithPubKey> usersToAdd {{.userId = data[2], .pubKey = data[3]}};
+                for(size_t i = 4; i < data.size(); i++) {
+                    threadApi->addThreadMembers(data[i], usersToAdd, {});
+                }
+                for(size_t i = 4; i < data.size(); i++) {
+                    threadApi->removeThreadMembers(data[i], {data[2]});
+                }
+            });
+        case 0x00040001:
+            // add a user to 1000 threads and remove them with the bulk members update
+            return ([](std::shared_ptr<core::Connection> connection, std::shared_ptr<thread::ThreadApi> threadApi, std::shared_ptr<store::StoreApi> storeApi, std::shared_ptr<inbox::InboxApi> inboxApi, const std::vector<std::string>& data) {
+                std::vector<core::ContainerMembersTarget> targets;
+                for(size_t i = 4; i < data.size(); i++) {
+                    targets.push_back({.module = "thread", .containerId = data[i]});
+                }
+                for(const auto& result : connection->updateContainersMembers(targets, {{.userId = data[2], .pubKey = data[3]}}, {}, {})) {
+                    if(!result.success) {
+                        throw std::runtime_error("members update failed: " + result.errorMessage.value_or(""));
+                    }
+                }
+                for(const auto& result : connection->updateContainersMembers(targets, {}, {}, {data[2]})) {
+                    if(!result.success) {
+                        throw std::runtime_error("members update failed: " + result.errorMessage.value_or(""));
+                    }
+                }
+            });
+        case 0x00060000:
+            // send 100 messages of 64 KiB through the C interface with the JSON envelope
+            return ([](std::shared_ptr<core::Connection> connection, std::shared_ptr<thread::ThreadApi> threadApi, std::shared_ptr<store::StoreApi> storeApi, std::shared_ptr<inbox::InboxApi> inboxApi, const std::vector<std::string>& data) {
+                static ThreadApi* api = getThreadCApi(connection);
+                Poco::JSON::Array::Ptr argsArr = new Poco::JSON::Array();
+                argsArr->add(data[2]);
+                argsArr->add(Pson::BinaryString("public"));
+                argsArr->add(Pson::BinaryString("private"));
+                argsArr->add(Pson::BinaryString(data[3]));
+                Poco::Dynamic::Var args = argsArr;
+                for(int i = 0; i < 100; i++) {
+                    pson_value* res = nullptr;
+                    int status = privmx_endpoint_execThreadApi(api, thread::ThreadApiVarInterface::SendMessage, (const pson_value*)&args, &res);
+                    pson_free_value(res);
+                    if(!status) {
+                        throw std::runtime_error("sendMessage failed");
+                    }
+                }
+            });
+        case 0x00060001:
+            // send 100 messages of 64 KiB through the binary C interface
+            return ([](std::shared_ptr<core::Connection> connection, std::shared_ptr<thread::ThreadApi> threadApi, std::shared_ptr<store::StoreApi> storeApi, std::shared_ptr<inbox::InboxApi> inboxApi, const std::vector<std::string>& data) {
+                static ThreadApi* api = getThreadCApi(connection);
+                for(int i = 0; i < 100; i++) {
+                    privmx_buffer messageId{};
+                    privmx_error error{};
+                    int status = privmx_endpoint_threadSendMessage(
+                        api,
+                        data[2].c_str(),
+                        privmx_const_buffer{.data = "public", .size = 6},
+                        privmx_const_buffer{.data = "private", .size = 7},
+                        privmx_const_buffer{.data = data[3].data(), .size = data[3].size()},
+                        &messageId,
+                        &error
+                    );
+                    if(!status) {
+                        throw std::runtime_error(error.message);
+                    }
+                    privmx_endpoint_freeBuffer(&messageId);
+                }
+            });
+        case 0x00050000:
+        case 0x00050001:
+        case 0x00050002:
+        case 0x00050003:
+            // send 100 messages of 1 KiB with sendMessageAsync, 1, 4, 16 or 64 calls in flight
+            return ([](std::shared_ptr<core::Connection> connection, std::shared_ptr<thread::ThreadApi> threadApi, std::shared_ptr<store::StoreApi> storeApi, std::shared_ptr<inbox::InboxApi> inboxApi, const std::vector<std::string>& data) {
+                connection->setAsyncOptions({.maxInFlightRequests = std::stoll(data[4]), .completionExecutor = {}});
+                auto message = core::Buffer::from(data[3]);
+                std::vector<core::Future<std::string>> results;
+                for(int i = 0; i < 100; i++) {
+                    results.push_back(threadApi->sendMessageAsync(
+                        data[2],
+                        core::Buffer::from("public"),
+                        core::Buffer::from("private"),
+                        message
+                    ));
+                }
+                for(const auto& result : results) {
+                    result.get();
+                }
+            });
         
     }
     std::cout << "ID not found" << std::endl;
@@ -479,6 +644,71 @@ std::function<
                 auto handle = storeApi->openFile(data[2]);
                 storeApi->readFromFile(handle, file.publicMeta.size());
             });
+        case 0x00030000:
+            // read 512 KiB from the middle of 1MB file
+            return ([](std::shared_ptr<core::Connection> connection, std::shared_ptr<thread::ThreadApi> threadApi, std::shared_ptr<store::StoreApi> storeApi, std::shared_ptr<inbox::InboxApi> inboxApi, const std::vector<std::string>& data) {
+                auto handle = storeApi->openFile(data[2]);
+                storeApi->seekInFile(handle, 1000);
+                storeApi->readFromFile(handle, 512*1024);
+                storeApi->closeFile(handle);
+            });
+        case 0x00040000:
+            // write a 1 MB file in 64 KiB chunks and read it back through the C interface with the JSON envelope,
+            // creating, opening and closing the file goes around the C interface
+            return ([](std::shared_ptr<core::Connection> connection, std::shared_ptr<thread::ThreadApi> threadApi, std::shared_ptr<store::StoreApi> storeApi, std::shared_ptr<inbox::InboxApi> inboxApi, const std::vector<std::string>& data) {
+                static StoreApi* api = getStoreCApi(connection);
+                auto apiImpl = ((store::StoreApiVarInterface*)api)->getApi();
+                auto handle = apiImpl.createFile(data[2], core::Buffer::from("public"), core::Buffer::from("private"), 16 * data[3].size());
+                for(int i = 0; i < 16; i++) {
+                    Poco::JSON::Array::Ptr argsArr = new Poco::JSON::Array();
+                    argsArr->add(handle);
+                    argsArr->add(Pson::BinaryString(data[3]));
+                    argsArr->add(false);
+                    Poco::Dynamic::Var args = argsArr;
+                    pson_value* res = nullptr;
+                    int status = privmx_endpoint_execStoreApi(api, store::StoreApiVarInterface::WriteToFile, (const pson_value*)&args, &res);
+                    pson_free_value(res);
+                    if(!status) {
+                        throw std::runtime_error("writeToFile failed");
+                    }
+                }
+                handle = apiImpl.openFile(apiImpl.closeFile(handle));
+                for(int i = 0; i < 16; i++) {
+                    Poco::JSON::Array::Ptr argsArr = new Poco::JSON::Array();
+                    argsArr->add(handle);
+                    argsArr->add((int64_t)data[3].size());
+                    Poco::Dynamic::Var args = argsArr;
+                    pson_value* res = nullptr;
+                    int status = privmx_endpoint_execStoreApi(api, store::StoreApiVarInterface::ReadFromFile, (const pson_value*)&args, &res);
+                    pson_free_value(res);
+                    if(!status) {
+                        throw std::runtime_error("readFromFile failed");
+                    }
+                }
+                apiImpl.closeFile(handle);
+            });
+        case 0x00040001:
+            // write a 1 MB file in 64 KiB chunks and read it back through the binary C interface
+            return ([](std::shared_ptr<core::Connection> connection, std::shared_ptr<thread::ThreadApi> threadApi, std::shared_ptr<store::StoreApi> storeApi, std::shared_ptr<inbox::InboxApi> inboxApi, const std::vector<std::string>& data) {
+                static StoreApi* api = getStoreCApi(connection);
+                auto apiImpl = ((store::StoreApiVarInterface*)api)->getApi();
+                auto handle = apiImpl.createFile(data[2], core::Buffer::from("public"), core::Buffer::from("private"), 16 * data[3].size());
+                privmx_error error{};
+                for(int i = 0; i < 16; i++) {
+                    if(!privmx_endpoint_storeWriteToFile(api, handle, privmx_const_buffer{.data = data[3].data(), .size = data[3].size()}, 0, &error)) {
+                        throw std::runtime_error(error.message);
+                    }
+                }
+                handle = apiImpl.openFile(apiImpl.closeFile(handle));
+                for(int i = 0; i < 16; i++) {
+                    privmx_buffer chunk{};
+                    if(!privmx_endpoint_storeReadFromFile(api, handle, data[3].size(), &chunk, &error)) {
+                        throw std::runtime_error(error.message);
+                    }
+                    privmx_endpoint_freeBuffer(&chunk);
+                }
+                apiImpl.closeFile(handle);
+            });
     }
     std::cout << "ID not found" << std::endl;
     throw "ID not found";
@@ -868,7 +1098,327 @@ std::function<
                 auto encrypted = crypto::CryptoApi::create().encryptDataSymmetric(core::Buffer::from(data[0]), key);
                 auto decrypted = crypto::CryptoApi::create().encryptDataSymmetric(encrypted, key);
             });
-            
+        case 0x00010000:
+            // wrap key for 100 members (ECIES key cache)
+            return ([](std::shared_ptr<core::Connection> connection, std::shared_ptr<thread::ThreadApi> threadApi, std::shared_ptr<store::StoreApi> storeApi, std::shared_ptr<inbox::InboxApi> inboxApi, const std::vector<std::string>& data) {
+                static auto owner = privmx::crypto::PrivateKey::fromWIF(data[0]);
+                auto key = privmx::crypto::Crypto::randomBytes(32);
+                for(size_t i = 1; i < data.size(); i++) {
+                    privmx::crypto::EciesEncryptor::encryptToBase64(privmx::crypto::PublicKey::fromBase58DER(data[i]), key, owner);
+                }
+            });
+        case 0x00010001:
+            // wrap key for 100 members (no ECIES key cache)
+            return ([](std::shared_ptr<core::Connection> connection, std::shared_ptr<thread::ThreadApi> threadApi, std::shared_ptr<store::StoreApi> storeApi, std::shared_ptr<inbox::InboxApi> inboxApi, const std::vector<std::string>& data) {
+                static auto owner = privmx::crypto::PrivateKey::fromWIF(data[0]);
+                owner.getEciesKeyCache()->setMaxSize(0);
+                auto key = privmx::crypto::Crypto::randomBytes(32);
+                for(size_t i = 1; i < data.size(); i++) {
+                    privmx::crypto::EciesEncryptor::encryptToBase64(privmx::crypto::PublicKey::fromBase58DER(data[i]), key, owner);
+                }
+            });
+        case 0x00010002:
+            // unwrap 100 keys from 4 authors (ECIES key cache)
+            return ([](std::shared_ptr<core::Connection> connection, std::shared_ptr<thread::ThreadApi> threadApi, std::shared_ptr<store::StoreApi> storeApi, std::shared_ptr<inbox::InboxApi> inboxApi, const std::vector<std::string>& data) {
+                static auto owner = privmx::crypto::PrivateKey::fromWIF(data[0]);
+                for(size_t i = 1; i < data.size(); i++) {
+                    privmx::crypto::EciesEncryptor::decrypt(owner, data[i]);
+                }
+            });
+        case 0x00010003:
+            // unwrap 100 keys from 4 authors (no ECIES key cache)
+            return ([](std::shared_ptr<core::Connection> connection, std::shared_ptr<thread::ThreadApi> threadApi, std::shared_ptr<store::StoreApi> storeApi, std::shared_ptr<inbox::InboxApi> inboxApi, const std::vector<std::string>& data) {
+                static auto owner = privmx::crypto::PrivateKey::fromWIF(data[0]);
+                owner.getEciesKeyCache()->setMaxSize(0);
+                for(size_t i = 1; i < data.size(); i++) {
+                    privmx::crypto::EciesEncryptor::decrypt(owner, data[i]);
+                }
+            });
+        case 0x00020000:
+            // data channel encrypt decrypt 1000 messages (V1)
+            return ([](std::shared_ptr<core::Connection> connection, std::shared_ptr<thread::ThreadApi> threadApi, std::shared_ptr<store::StoreApi> storeApi, std::shared_ptr<inbox::InboxApi> inboxApi, const std::vector<std::string>& data) {
+                static std::vector<stream::Key> keys {stream::Key{.keyId="benchmark", .key=core::Buffer::from(privmx::utils::Hex::toString("3ad696c8c37f286adbbd66b2f31e90041850ae2d3ec30250020c0209085f8c62")), .type=stream::KeyType::LOCAL}};
+                static stream::DataChannelMessageEncryptorV1 sender(keys);
+                static stream::DataChannelMessageEncryptorV1 receiver(keys);
+                static int64_t seq = 0;
+                auto message = core::Buffer::from(data[0]);
+                for(int i = 0; i < 1000; i++) {
+                    receiver.decryptMessage("benchmark", sender.encryptMessage({message, seq++}));
+                }
+            });
+        case 0x00020001:
+            // data channel encrypt decrypt 1000 messages (V2)
+            return ([](std::shared_ptr<core::Connection> connection, std::shared_ptr<thread::ThreadApi> threadApi, std::shared_ptr<store::StoreApi> storeApi, std::shared_ptr<inbox::InboxApi> inboxApi, const std::vector<std::string>& data) {
+                static std::vector<stream::Key> keys {stream::Key{.keyId="benchmark", .key=core::Buffer::from(privmx::utils::Hex::toString("3ad696c8c37f286adbbd66b2f31e90041850ae2d3ec30250020c0209085f8c62")), .type=stream::KeyType::LOCAL}};
+                static stream::DataChannelMessageEncryptorV2 sender(keys);
+                static stream::DataChannelMessageEncryptorV2 receiver(keys);
+                static int64_t seq = 0;
+                auto message = core::Buffer::from(data[0]);
+                for(int i = 0; i < 1000; i++) {
+                    receiver.decryptMessage("benchmark", sender.encryptMessage({message, seq++}));
+                }
+            });
+        case 0x00020002:
+            // data channel encrypt decrypt 1000 messages received in swapped pairs (V2)
+            return ([](std::shared_ptr<core::Connection> connection, std::shared_ptr<thread::ThreadApi> threadApi, std::shared_ptr<store::StoreApi> storeApi, std::shared_ptr<inbox::InboxApi> inboxApi, const std::vector<std::string>& data) {
+                static std::vector<stream::Key> keys {stream::Key{.keyId="benchmark", .key=core::Buffer::from(privmx::utils::Hex::toString("3ad696c8c37f286adbbd66b2f31e90041850ae2d3ec30250020c0209085f8c62")), .type=stream::KeyType::LOCAL}};
+                static stream::DataChannelMessageEncryptorV2 sender(keys);
+                static stream::DataChannelMessageEncryptorV2 receiver(keys);
+                static int64_t seq = 0;
+                auto message = core::Buffer::from(data[0]);
+                for(int i = 0; i < 500; i++) {
+                    auto first = sender.encryptMessage({message, seq++});
+                    auto second = sender.encryptMessage({message, seq++});
+                    receiver.decryptMessage("benchmark", second);
+                    receiver.decryptMessage("benchmark", first);
+                }
+            });
+        case 0x00030000:
+            // sign 100 messages one by one
+            return ([](std::shared_ptr<core::Connection> connection, std::shared_ptr<thread::ThreadApi> threadApi, std::shared_ptr<store::StoreApi> storeApi, std::shared_ptr<inbox::InboxApi> inboxApi, const std::vector<std::string>& data) {
+                static auto priv = privmx::crypto::PrivateKey::fromWIF(data[0]);
+                for(size_t i = 1; i < data.size(); i++) {
+                    priv.signToCompactSignatureWithHash(data[i]);
+                }
+            });
+        case 0x00030001:
+            // sign 100 messages with signMany
+            return ([](std::shared_ptr<core::Connection> connection, std::shared_ptr<thread::ThreadApi> threadApi, std::shared_ptr<store::StoreApi> storeApi, std::shared_ptr<inbox::InboxApi> inboxApi, const std::vector<std::string>& data) {
+                static auto priv = privmx::crypto::PrivateKey::fromWIF(data[0]);
+                static std::vector<std::string> messages(data.begin() + 1, data.end());
+                priv.signManyToCompactSignatureWithHash(messages);
+            });
+        case 0x00030002:
+            // verify 100 signatures one by one, author key parsed for every item
+            return ([](std::shared_ptr<core::Connection> connection, std::shared_ptr<thread::ThreadApi> threadApi, std::shared_ptr<store::StoreApi> storeApi, std::shared_ptr<inbox::InboxApi> inboxApi, const std::vector<std::string>& data) {
+                for(size_t i = 1; i + 1 < data.size(); i += 2) {
+                    privmx::crypto::PublicKey::fromBase58DER(data[0]).verifyCompactSignatureWithHash(data[i], data[i + 1]);
+                }
+            });
+        case 0x00030003:
+            // verify 100 signatures with verifyMany
+            return ([](std::shared_ptr<core::Connection> connection, std::shared_ptr<thread::ThreadApi> threadApi, std::shared_ptr<store::StoreApi> storeApi, std::shared_ptr<inbox::InboxApi> inboxApi, const std::vector<std::string>& data) {
+                static std::vector<std::string> messages;
+                static std::vector<std::string> signatures;
+                if(messages.empty()) {
+                    for(size_t i = 1; i + 1 < data.size(); i += 2) {
+                        messages.push_back(data[i]);
+                        signatures.push_back(data[i + 1]);
+                    }
+                }
+                privmx::crypto::PublicKey::fromBase58DER(data[0]).verifyManyCompactSignaturesWithHash(messages, signatures);
+            });
+        case 0x00050000:
+            // sign, encrypt, decrypt and verify 512 KiB message, as done for message data
+            return ([](std::shared_ptr<core::Connection> connection, std::shared_ptr<thread::ThreadApi> threadApi, std::shared_ptr<store::StoreApi> storeApi, std::shared_ptr<inbox::InboxApi> inboxApi, const std::vector<std::string>& data) {
+                static auto priv = privmx::crypto::PrivateKey::fromWIF(data[0]);
+                static auto pub = priv.getPublicKey();
+                static auto message = core::Buffer::from(data[2]);
+                core::DataInnerEncryptorV4 encryptor;
+                auto encrypted = encryptor.encrypt(encryptor.signAndPackDataWithSignature(message, priv), data[1]);
+                encryptor.verifyAndExtractData(encryptor.decrypt(encrypted, data[1]), pub);
+            });
+        case 0x00070000:
+        case 0x00070002:
+        case 0x00070004:
+            // resolve keys of a container with 1k, 10k or 100k members updated with the full list of members and one new user
+            return ([](std::shared_ptr<core::Connection> connection, std::shared_ptr<thread::ThreadApi> threadApi, std::shared_ptr<store::StoreApi> storeApi, std::shared_ptr<inbox::InboxApi> inboxApi, const std::vector<std::string>& data) {
+                static std::vector<std::string> userIds;
+                static std::vector<core::UserWithPubKey> users;
+                if(userIds.empty()) {
+                    userIds.assign(data.begin() + 1, data.end());
+                    for(const auto& userId : userIds) {
+                        users.push_back({.userId = userId, .pubKey = data[0]});
+                    }
+                    users.push_back({.userId = "newUser", .pubKey = data[0]});
+                }
+                core::DecryptedEncKeyV2 key {};
+                key.dataStructureVersion = 2;
+                core::UsersKeysResolver::create(userIds, userIds, users, users, false, key);
+            });
+        case 0x00070001:
+        case 0x00070003:
+        case 0x00070005:
+            // resolve keys of a container with 1k, 10k or 100k members updated with a delta adding one new user
+            return ([](std::shared_ptr<core::Connection> connection, std::shared_ptr<thread::ThreadApi> threadApi, std::shared_ptr<store::StoreApi> storeApi, std::shared_ptr<inbox::InboxApi> inboxApi, const std::vector<std::string>& data) {
+                static std::vector<std::string> userIds(data.begin() + 1, data.end());
+                std::vector<core::UserWithPubKey> usersToAdd {{.userId = "newUser", .pubKey = data[0]}};
+                core::DecryptedEncKeyV2 key {};
+                key.dataStructureVersion = 2;
+                core::UsersKeysResolver::createFromDelta(userIds, userIds, usersToAdd, usersToAdd, {}, key, [](const std::vector<std::string>&) {
+                    return std::vector<core::UserWithPubKey>();
+                });
+            });
+        case 0x00090000:
+            // encrypt 256 MiB with a single encryptDataSymmetric call, the whole payload kept in memory
+            return ([](std::shared_ptr<core::Connection> connection, std::shared_ptr<thread::ThreadApi> threadApi, std::shared_ptr<store::StoreApi> storeApi, std::shared_ptr<inbox::InboxApi> inboxApi, const std::vector<std::string>& data) {
+                std::string payload;
+                payload.reserve(32 * data[1].size());
+                for(int i = 0; i < 32; i++) {
+                    payload.append(data[1]);
+                }
+                crypto::CryptoApi::create().encryptDataSymmetric(core::Buffer::from(std::move(payload)), core::Buffer::from(data[0]));
+            });
+        case 0x00090001:
+        case 0x00090002:
+            // encrypt 256 MiB with a symmetric stream in 8 MiB parts using 1 or 4 threads
+            return ([](std::shared_ptr<core::Connection> connection, std::shared_ptr<thread::ThreadApi> threadApi, std::shared_ptr<store::StoreApi> storeApi, std::shared_ptr<inbox::InboxApi> inboxApi, const std::vector<std::string>& data) {
+                static int64_t maxThreads = data[2] == "1" ? 1 : 4;
+                auto cryptoApi = crypto::CryptoApi::create();
+                auto block = core::Buffer::from(data[1]);
+                auto stream = cryptoApi.openSymmetricEncryptionStream(core::Buffer::from(data[0]), crypto::CryptoApi::DEFAULT_SYMMETRIC_STREAM_CHUNK_SIZE, maxThreads);
+                for(int i = 0; i < 32; i++) {
+                    cryptoApi.updateSymmetricStream(stream, block);
+                }
+                cryptoApi.finalizeSymmetricStream(stream);
+            });
+        case 0x00090003:
+            // encrypt and decrypt 256 MiB with symmetric streams in 8 MiB parts using 4 threads
+            return ([](std::shared_ptr<core::Connection> connection, std::shared_ptr<thread::ThreadApi> threadApi, std::shared_ptr<store::StoreApi> storeApi, std::shared_ptr<inbox::InboxApi> inboxApi, const std::vector<std::string>& data) {
+                auto cryptoApi = crypto::CryptoApi::create();
+                auto key = core::Buffer::from(data[0]);
+                auto block = core::Buffer::from(data[1]);
+                auto encryptor = cryptoApi.openSymmetricEncryptionStream(key, crypto::CryptoApi::DEFAULT_SYMMETRIC_STREAM_CHUNK_SIZE, 4);
+                auto decryptor = cryptoApi.openSymmetricDecryptionStream(key, 4);
+                for(int i = 0; i < 32; i++) {
+                    cryptoApi.updateSymmetricStream(decryptor, cryptoApi.updateSymmetricStream(encryptor, block));
+                }
+                cryptoApi.updateSymmetricStream(decryptor, cryptoApi.finalizeSymmetricStream(encryptor));
+                cryptoApi.finalizeSymmetricStream(decryptor);
+            });
+        case 0x000B0000:
+        case 0x000B0001:
+            // 10k encryptions of 1 KiB messages, signatures of their hashes and recorded RPC calls with performance metrics disabled or enabled
+            return ([](std::shared_ptr<core::Connection> connection, std::shared_ptr<thread::ThreadApi> threadApi, std::shared_ptr<store::StoreApi> storeApi, std::shared_ptr<inbox::InboxApi> inboxApi, const std::vector<std::string>& data) {
+                static auto privKey = privmx::crypto::PrivateKey::fromWIF(data[2]);
+                privmx::utils::MetricsRegistry::setEnabled(data[3] == "1");
+                for(int i = 0; i < 10000; i++) {
+                    auto start = privmx::utils::MetricsRegistry::Clock::now();
+                    auto encrypted = privmx::crypto::Crypto::aes256CbcHmac256Encrypt(data[1], data[0]);
+                    privKey.signToCompactSignatureWithHash(encrypted);
+                    privmx::utils::MetricsRegistry::recordRpcCall("thread.threadMessageSend", start, false);
+                }
+                privmx::utils::MetricsRegistry::setEnabled(true);
+            });
+        case 0x000C0000:
+        case 0x000C0001:
+            // sign, encrypt and encode a 16 KiB JSON message 1000 times without or with compression
+            return ([](std::shared_ptr<core::Connection> connection, std::shared_ptr<thread::ThreadApi> threadApi, std::shared_ptr<store::StoreApi> storeApi, std::shared_ptr<inbox::InboxApi> inboxApi, const std::vector<std::string>& data) {
+                static auto privKey = privmx::crypto::PrivateKey::fromWIF(data[2]);
+                auto compressor = std::make_shared<core::DataCompressor>();
+                compressor->setOptions({.enabled = data[3] == "1", .minSize = core::DataCompressor::DEFAULT_MIN_SIZE, .maxDecompressedSize = core::DataCompressor::DEFAULT_MAX_DECOMPRESSED_SIZE});
+                core::DataEncryptorV4 encryptor;
+                encryptor.setCompressor(compressor);
+                auto message = core::Buffer::from(data[1]);
+                for(int i = 0; i < 1000; i++) {
+                    encryptor.signAndEncryptAndEncode(message, privKey, data[0]);
+                }
+            });
+        case 0x000C0002:
+        case 0x000C0003:
+            // decode, decrypt and verify a 16 KiB JSON message 1000 times stored without or with compression
+            return ([](std::shared_ptr<core::Connection> connection, std::shared_ptr<thread::ThreadApi> threadApi, std::shared_ptr<store::StoreApi> storeApi, std::shared_ptr<inbox::InboxApi> inboxApi, const std::vector<std::string>& data) {
+                static auto pubKey = privmx::crypto::PrivateKey::fromWIF(data[2]).getPublicKey();
+                core::DataEncryptorV4 encryptor;
+                for(int i = 0; i < 1000; i++) {
+                    encryptor.decodeAndDecryptAndVerify(data[4], pubKey, data[0]);
+                }
+            });
+        case 0x000D0000:
+        case 0x000D0001:
+        case 0x000D0002:
+        case 0x000D0003:
+            // scan a thread of 2000 signed and encrypted 1 KiB messages in pages of 100 at 20 or 100 ms round trip time, page after page or with a cursor
+            return ([](std::shared_ptr<core::Connection> connection, std::shared_ptr<thread::ThreadApi> threadApi, std::shared_ptr<store::StoreApi> storeApi, std::shared_ptr<inbox::InboxApi> inboxApi, const std::vector<std::string>& data) {
+                static auto pubKey = privmx::crypto::PrivateKey::fromWIF(data[4]).getPublicKey();
+                int64_t rtt = std::stoll(data[2]);
+                auto fetchPage = [&data, rtt](const core::PagingQuery& query) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(rtt));
+                    int64_t first = query.lastId.has_value() ? std::stoll(query.lastId.value()) + 1 : query.skip;
+                    int64_t size = std::max<int64_t>(std::min<int64_t>(query.limit, 2000 - first), 0);
+                    return core::CursorPage<std::string>{
+                        .totalAvailable = 2000,
+                        .size = (size_t)size,
+                        .lastId = std::to_string(first + size - 1),
+                        .decrypt = [&data, size]() {
+                            core::DataEncryptorV4 encryptor;
+                            std::vector<std::string> messages;
+                            for(int64_t i = 0; i < size; i++) {
+                                messages.push_back(encryptor.decodeAndDecryptAndVerify(data[1], pubKey, data[0]).stdString());
+                            }
+                            return messages;
+                        }
+                    };
+                };
+                core::PagingQuery query {.skip = 0, .limit = 100, .sortOrder = "asc", .lastId = std::nullopt, .sortBy = std::nullopt, .queryAsJson = std::nullopt};
+                if(data[3] == "1") {
+                    core::Cursor<std::string> cursor(std::make_shared<core::PrefetchingCursor<std::string>>(fetchPage, query, core::DEFAULT_CURSOR_PAGES_AHEAD));
+                    while(!cursor.next().empty());
+                } else {
+                    int64_t read = 0;
+                    for(auto page = fetchPage(query); page.size > 0; page = fetchPage(query)) {
+                        page.decrypt();
+                        query = core::PrefetchingCursor<std::string>::getNextQuery(query, page.size, page.lastId);
+                        read += page.size;
+                        if(read >= page.totalAvailable) {
+                            break;
+                        }
+                    }
+                }
+            });
+        case 0x000E0000:
+        case 0x000E0001:
+            // decrypt a list of 100 messages with 64 KiB data, all the fields or only the public meta holding their titles
+            return ([](std::shared_ptr<core::Connection> connection, std::shared_ptr<thread::ThreadApi> threadApi, std::shared_ptr<store::StoreApi> storeApi, std::shared_ptr<inbox::InboxApi> inboxApi, const std::vector<std::string>& data) {
+                auto encrypted = thread::server::EncryptedMessageDataV5::deserialize(data[1]);
+                int64_t fields = std::stoll(data[2]);
+                thread::MessageDataEncryptorV5 encryptor;
+                for(int i = 0; i < 100; i++) {
+                    if(encryptor.decrypt(encrypted, data[0], fields).statusCode != 0) {
+                        throw std::runtime_error("message decryption failed");
+                    }
+                }
+            });
+        case 0x00040000:
+            // 1000 event queue round trips through the C interface with the JSON envelope
+            return ([](std::shared_ptr<core::Connection> connection, std::shared_ptr<thread::ThreadApi> threadApi, std::shared_ptr<store::StoreApi> storeApi, std::shared_ptr<inbox::InboxApi> inboxApi, const std::vector<std::string>& data) {
+                static EventQueue* queue = nullptr;
+                if(queue == nullptr) {
+                    privmx_endpoint_newEventQueue(&queue);
+                }
+                Poco::Dynamic::Var args = Poco::JSON::Array::Ptr(new Poco::JSON::Array());
+                for(int i = 0; i < 1000; i++) {
+                    pson_value* res = nullptr;
+                    privmx_endpoint_execEventQueue(queue, core::EventQueueVarInterface::EmitBreakEvent, (const pson_value*)&args, &res);
+                    pson_free_value(res);
+                    int status = privmx_endpoint_execEventQueue(queue, core::EventQueueVarInterface::WaitEvent, (const pson_value*)&args, &res);
+                    pson_free_value(res);
+                    if(!status) {
+                        throw std::runtime_error("waitEvent failed");
+                    }
+                }
+            });
+        case 0x00040001:
+            // 1000 event queue round trips through the binary C interface
+            return ([](std::shared_ptr<core::Connection> connection, std::shared_ptr<thread::ThreadApi> threadApi, std::shared_ptr<store::StoreApi> storeApi, std::shared_ptr<inbox::InboxApi> inboxApi, const std::vector<std::string>& data) {
+                static EventQueue* queue = nullptr;
+                if(queue == nullptr) {
+                    privmx_endpoint_newEventQueue(&queue);
+                }
+                Poco::Dynamic::Var args = Poco::JSON::Array::Ptr(new Poco::JSON::Array());
+                for(int i = 0; i < 1000; i++) {
+                    pson_value* res = nullptr;
+                    privmx_endpoint_execEventQueue(queue, core::EventQueueVarInterface::EmitBreakEvent, (const pson_value*)&args, &res);
+                    pson_free_value(res);
+                    // privmx_error is a flat struct, it holds no memory to free
+                    privmx_event event{};
+                    privmx_error error{};
+                    if(!privmx_endpoint_waitEvent(queue, &event, &error)) {
+                        throw std::runtime_error(error.message);
+                    }
+                    privmx_endpoint_freeEvent(&event);
+                }
+            });
     }
     std::cout << "ID not found" << std::endl;
     throw "ID not found";
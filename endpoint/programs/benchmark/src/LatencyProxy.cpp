@@ -0,0 +1,158 @@
+/*
+PrivMX Endpoint.
+Copyright © 2024 Simplito sp. z o.o.
+
+This file is part of the PrivMX Platform (https://privmx.dev).
+This software is Licensed under the PrivMX Free License.
+
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "privmx/endpoint/programs/benchmark/LatencyProxy.hpp"
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// sockets of a proxied connection, closed when both directions are done
+struct Link {
+    int client;
+    int server;
+
+    ~Link() {
+        close(client);
+        close(server);
+    }
+};
+
+struct Chunks {
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<std::pair<Clock::time_point, std::string>> queue;
+    bool closed = false;
+};
+
+void forward(const std::shared_ptr<Link>& link, int from, int to, std::chrono::milliseconds latency) {
+    auto chunks = std::make_shared<Chunks>();
+    std::thread([link, to, chunks]() {
+        std::unique_lock lock(chunks->mutex);
+        while(true) {
+            chunks->cv.wait(lock, [&]() { return chunks->closed || !chunks->queue.empty(); });
+            if(chunks->queue.empty()) {
+                break;
+            }
+            // chunks are only appended, so the front one stays until it is sent
+            auto due = chunks->queue.front().first;
+            lock.unlock();
+            std::this_thread::sleep_until(due);
+            lock.lock();
+            auto data = std::move(chunks->queue.front().second);
+            chunks->queue.pop_front();
+            lock.unlock();
+            for(size_t sent = 0; sent < data.size();) {
+                auto result = send(to, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+                if(result <= 0) {
+                    return;
+                }
+                sent += result;
+            }
+            lock.lock();
+        }
+        shutdown(to, SHUT_WR);
+    }).detach();
+    std::thread([link, from, chunks, latency]() {
+        char buffer[64 * 1024];
+        while(true) {
+            auto result = recv(from, buffer, sizeof(buffer), 0);
+            std::unique_lock lock(chunks->mutex);
+            if(result <= 0) {
+                chunks->closed = true;
+                chunks->cv.notify_all();
+                return;
+            }
+            chunks->queue.emplace_back(Clock::now() + latency, std::string(buffer, result));
+            chunks->cv.notify_all();
+        }
+    }).detach();
+}
+
+int connectTo(const std::string& host, const std::string& port) {
+    addrinfo hints {};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* addresses = nullptr;
+    if(getaddrinfo(host.c_str(), port.c_str(), &hints, &addresses) != 0) {
+        return -1;
+    }
+    int result = -1;
+    for(auto address = addresses; address != nullptr && result == -1; address = address->ai_next) {
+        result = socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+        if(result != -1 && connect(result, address->ai_addr, address->ai_addrlen) != 0) {
+            close(result);
+            result = -1;
+        }
+    }
+    freeaddrinfo(addresses);
+    return result;
+}
+
+}
+
+LatencyProxy::LatencyProxy(const std::string& platformUrl, std::chrono::milliseconds oneWayLatency) : _latency(oneWayLatency) {
+    const std::string scheme = "http://";
+    if(platformUrl.compare(0, scheme.size(), scheme) != 0) {
+        throw std::invalid_argument("latency proxy supports only http platform url");
+    }
+    auto hostEnd = platformUrl.find('/', scheme.size());
+    auto hostPort = platformUrl.substr(scheme.size(), hostEnd == std::string::npos ? std::string::npos : hostEnd - scheme.size());
+    auto path = hostEnd == std::string::npos ? std::string("/") : platformUrl.substr(hostEnd);
+    auto colon = hostPort.find(':');
+    _host = hostPort.substr(0, colon);
+    _port = colon == std::string::npos ? "80" : hostPort.substr(colon + 1);
+    _listenSocket = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = 0;
+    socklen_t length = sizeof(address);
+    if(
+        _listenSocket == -1 ||
+        bind(_listenSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(_listenSocket, SOMAXCONN) != 0 ||
+        getsockname(_listenSocket, reinterpret_cast<sockaddr*>(&address), &length) != 0
+    ) {
+        throw std::runtime_error("cannot start latency proxy");
+    }
+    _url = scheme + "127.0.0.1:" + std::to_string(ntohs(address.sin_port)) + path;
+    // the proxy runs until the end of the process
+    std::thread(&LatencyProxy::acceptLoop, this).detach();
+}
+
+void LatencyProxy::acceptLoop() {
+    while(true) {
+        int client = accept(_listenSocket, nullptr, nullptr);
+        if(client == -1) {
+            continue;
+        }
+        int server = connectTo(_host, _port);
+        if(server == -1) {
+            close(client);
+            continue;
+        }
+        auto link = std::shared_ptr<Link>(new Link{.client = client, .server = server});
+        forward(link, client, server, _latency);
+        forward(link, server, client, _latency);
+    }
+}
@@ -1,5 +1,12 @@
 #include "privmx/endpoint/programs/benchmark/PrepereInitData.hpp"
+#include <algorithm>
 #include <iostream>
+#include <stdexcept>
+#include <privmx/crypto/Crypto.hpp>
+#include <privmx/crypto/EciesEncryptor.hpp>
+#include <privmx/utils/Utils.hpp>
+#include <privmx/endpoint/core/encryptors/DataEncryptorV4.hpp>
+#include <privmx/endpoint/thread/encryptors/message/MessageDataEncryptorV5.hpp>
 using namespace privmx::endpoint;
 
 std::vector<std::string> PrepareInitDataThread(
@@ -62,6 +69,27 @@ std::vector<std::string> PrepareInitDataThread(
             result.push_back(msg_data);
             return result;
         }
+        case 0x00060000 :
+        case 0x00060001 : {
+            auto contextId = connection->listContexts({.skip=0, .limit=1, .sortOrder="asc"}).readItems[0].contextId;
+            result.push_back(
+                threadApi->createThread(
+                    contextId,
+                    std::vector<core::UserWithPubKey>{core::UserWithPubKey{
+                        .userId=userId,
+                        .pubKey=userPubKey
+                    }},
+                    std::vector<core::UserWithPubKey>{core::UserWithPubKey{
+                        .userId=userId,
+                        .pubKey=userPubKey
+                    }},
+                    core::Buffer::from("public"),
+                    core::Buffer::from("private")
+                )
+            );
+            result.push_back(privmx::crypto::Crypto::randomBytes(64*1024));
+            return result;
+        }
         case 0x00010006 : {
             auto contextId = connection->listContexts({.skip=0, .limit=1, .sortOrder="asc"}).readItems[0].contextId;
             result.push_back(
@@ -169,6 +197,93 @@ std::vector<std::string> PrepareInitDataThread(
             );
             return result;
         }
+        case 0x00030000 :
+        case 0x00030001 :
+        case 0x00030002 : {
+            auto contextId = connection->listContexts({.skip=0, .limit=1, .sortOrder="asc"}).readItems[0].contextId;
+            auto threadId = threadApi->createThread(
+                contextId,
+                std::vector<core::UserWithPubKey>{core::UserWithPubKey{
+                    .userId=userId,
+                    .pubKey=userPubKey
+                }},
+                std::vector<core::UserWithPubKey>{core::UserWithPubKey{
+                    .userId=userId,
+                    .pubKey=userPubKey
+                }},
+                core::Buffer::from("public"),
+                core::Buffer::from("private")
+            );
+            // threadMessagesGet responses with 10, 100 or 1000 real messages
+            size_t count = fun_number == 0x00030000 ? 10 : fun_number == 0x00030001 ? 100 : 1000;
+            std::string data = privmx::crypto::Crypto::randomBytes(96);
+            for(size_t i = 0; i < count; i++) {
+                threadApi->sendMessage(
+                    threadId,
+                    core::Buffer::from("public"),
+                    core::Buffer::from("private"),
+                    core::Buffer::from(data)
+                );
+            }
+            result.push_back(threadId);
+            return result;
+        }
+        case 0x00040000 :
+        case 0x00040001 : {
+            auto contextId = connection->listContexts({.skip=0, .limit=1, .sortOrder="asc"}).readItems[0].contextId;
+            // another user of the Context added to and removed from the threads
+            auto users = connection->listContextUsers(contextId, {.skip=0, .limit=100, .sortOrder="asc"}).readItems;
+            auto user = std::find_if(users.begin(), users.end(), [&](const core::UserInfo& info) { return info.user.userId != userId; });
+            if(user == users.end()) {
+                throw std::runtime_error("benchmark requires a second user in the Context");
+            }
+            result.push_back(user->user.userId);
+            result.push_back(user->user.pubKey);
+            // 1000 threads of the user
+            for(int i = 0; i < 1000; i++) {
+                result.push_back(
+                    threadApi->createThread(
+                        contextId,
+                        std::vector<core::UserWithPubKey>{core::UserWithPubKey{
+                            .userId=userId,
+                            .pubKey=userPubKey
+                        }},
+                        std::vector<core::UserWithPubKey>{core::UserWithPubKey{
+                            .userId=userId,
+                            .pubKey=userPubKey
+                        }},
+                        core::Buffer::from("public"),
+                        core::Buffer::from("private")
+                    )
+                );
+            }
+            return result;
+        }
+        case 0x00050000 :
+        case 0x00050001 :
+        case 0x00050002 :
+        case 0x00050003 : {
+            auto contextId = connection->listContexts({.skip=0, .limit=1, .sortOrder="asc"}).readItems[0].contextId;
+            result.push_back(
+                threadApi->createThread(
+                    contextId,
+                    std::vector<core::UserWithPubKey>{core::UserWithPubKey{
+                        .userId=userId,
+                        .pubKey=userPubKey
+                    }},
+                    std::vector<core::UserWithPubKey>{core::UserWithPubKey{
+                        .userId=userId,
+                        .pubKey=userPubKey
+                    }},
+                    core::Buffer::from("public"),
+                    core::Buffer::from("private")
+                )
+            );
+            // 1 KiB message and number of calls in flight
+            result.push_back(privmx::crypto::Crypto::randomBytes(1024));
+            result.push_back(std::to_string(1 << (2 * (fun_number & 0xFFFF))));
+            return result;
+        }
         case 0x00000000 :
         case 0x00000001 :
         case 0x00000002 :
@@ -292,7 +407,29 @@ std::vector<std::string> PrepareInitDataStore(
             );
             return result;
         }
-        case 0x00020001 : {
+        case 0x00040000 :
+        case 0x00040001 : {
+            auto contextId = connection->listContexts({.skip=0, .limit=1, .sortOrder="asc"}).readItems[0].contextId;
+            result.push_back(
+                storeApi->createStore(
+                    contextId,
+                    std::vector<core::UserWithPubKey>{core::UserWithPubKey{
+                        .userId=userId,
+                        .pubKey=userPubKey
+                    }},
+                    std::vector<core::UserWithPubKey>{core::UserWithPubKey{
+                        .userId=userId,
+                        .pubKey=userPubKey
+                    }},
+                    core::Buffer::from("public"),
+                    core::Buffer::from("private")
+                )
+            );
+            result.push_back(privmx::crypto::Crypto::randomBytes(64*1024));
+            return result;
+        }
+        case 0x00020001 :
+        case 0x00030000 : {
             auto contextId = connection->listContexts({.skip=0, .limit=1, .sortOrder="asc"}).readItems[0].contextId;
             auto storeId = storeApi->createStore(
                 contextId,
@@ -674,6 +811,168 @@ std::vector<std::string> PrepareInitDataCrypto(
                 result.push_back(data);
             }
             break; 
+        case 0x00010000:
+        case 0x00010001: {
+                // owner key and 100 member keys
+                result.push_back(privmx::crypto::PrivateKey::generateRandom().toWIF());
+                for(int i = 0; i < 100; i++) {
+                    result.push_back(privmx::crypto::PrivateKey::generateRandom().getPublicKey().toBase58DER());
+                }
+            }
+            break;
+        case 0x00010002:
+        case 0x00010003: {
+                // owner key and 100 key entries wrapped by 4 authors
+                auto owner = privmx::crypto::PrivateKey::generateRandom();
+                std::vector<privmx::crypto::PrivateKey> authors;
+                for(int i = 0; i < 4; i++) {
+                    authors.push_back(privmx::crypto::PrivateKey::generateRandom());
+                }
+                result.push_back(owner.toWIF());
+                for(int i = 0; i < 100; i++) {
+                    result.push_back(privmx::crypto::EciesEncryptor::encrypt(owner.getPublicKey(), privmx::crypto::Crypto::randomBytes(32), authors[i % 4]));
+                }
+            }
+            break;
+        case 0x00020000:
+        case 0x00020001:
+        case 0x00020002: {
+                // 100 B data channel message
+                result.push_back(std::string(100, 's'));
+            }
+            break;
+        case 0x00030000:
+        case 0x00030001: {
+                // signing key and 100 messages
+                result.push_back(privmx::crypto::PrivateKey::generateRandom().toWIF());
+                for(int i = 0; i < 100; i++) {
+                    result.push_back(privmx::crypto::Crypto::randomBytes(256));
+                }
+            }
+            break;
+        case 0x00030002:
+        case 0x00030003: {
+                // author public key and 100 message, signature pairs
+                auto author = privmx::crypto::PrivateKey::generateRandom();
+                result.push_back(author.getPublicKey().toBase58DER());
+                for(int i = 0; i < 100; i++) {
+                    auto message = privmx::crypto::Crypto::randomBytes(256);
+                    result.push_back(message);
+                    result.push_back(author.signToCompactSignatureWithHash(message));
+                }
+            }
+            break;
+        case 0x00070000:
+        case 0x00070001:
+        case 0x00070002:
+        case 0x00070003:
+        case 0x00070004:
+        case 0x00070005: {
+                // public key shared by all members and IDs of 1k, 10k or 100k members
+                size_t count = (fun_number & 0xFFFF) < 2 ? 1000 : (fun_number & 0xFFFF) < 4 ? 10000 : 100000;
+                result.push_back(privmx::crypto::PrivateKey::generateRandom().getPublicKey().toBase58DER());
+                for(size_t i = 0; i < count; i++) {
+                    result.push_back("user" + std::to_string(i));
+                }
+            }
+            break;
+        case 0x00050000: {
+                // signing key, 32 B key and 512 KiB message
+                result.push_back(privmx::crypto::PrivateKey::generateRandom().toWIF());
+                result.push_back(privmx::crypto::Crypto::randomBytes(32));
+                result.push_back(privmx::crypto::Crypto::randomBytes(512*1024));
+            }
+            break;
+        case 0x00090000:
+        case 0x00090001:
+        case 0x00090002:
+        case 0x00090003: {
+                // 32 B key, 8 MiB part of the 256 MiB payload and number of stream threads
+                result.push_back(privmx::crypto::Crypto::randomBytes(32));
+                result.push_back(privmx::crypto::Crypto::randomBytes(8*1024*1024));
+                result.push_back(fun_number == 0x00090001 ? "1" : "4");
+            }
+            break;
+        case 0x000B0000:
+        case 0x000B0001: {
+                // 32 B key, 1 KiB message, signing key and whether the performance metrics are enabled
+                result.push_back(privmx::crypto::Crypto::randomBytes(32));
+                result.push_back(privmx::crypto::Crypto::randomBytes(1024));
+                result.push_back(privmx::crypto::PrivateKey::generateRandom().toWIF());
+                result.push_back(fun_number == 0x000B0001 ? "1" : "0");
+            }
+            break;
+        case 0x000C0000:
+        case 0x000C0001:
+        case 0x000C0002:
+        case 0x000C0003: {
+                // 32 B key, 16 KiB JSON message, signing key, whether to compress and the message encoded that way
+                std::string json = "[";
+                for(int i = 0; json.size() < 16*1024; i++) {
+                    json += "{\"id\":" + std::to_string(i) + ",\"author\":\"user" + std::to_string(i % 7) +
+                        "\",\"text\":\"Meeting notes for the project review, see the attached document\",\"read\":false},";
+                }
+                json.back() = ']';
+                auto key = privmx::crypto::Crypto::randomBytes(32);
+                auto privKey = privmx::crypto::PrivateKey::generateRandom();
+                bool compress = (fun_number & 1) == 1;
+                auto compressor = std::make_shared<core::DataCompressor>();
+                compressor->setOptions({.enabled = compress, .minSize = core::DataCompressor::DEFAULT_MIN_SIZE, .maxDecompressedSize = core::DataCompressor::DEFAULT_MAX_DECOMPRESSED_SIZE});
+                core::DataEncryptorV4 encryptor;
+                encryptor.setCompressor(compressor);
+                auto encoded = encryptor.signAndEncryptAndEncode(core::Buffer::from(json), privKey, key);
+                std::cout << "Bytes on wire - " << encoded.size() << " of " << json.size() << std::endl;
+                result.push_back(key);
+                result.push_back(json);
+                result.push_back(privKey.toWIF());
+                result.push_back(compress ? "1" : "0");
+                result.push_back(encoded);
+            }
+            break;
+        case 0x000D0000:
+        case 0x000D0001:
+        case 0x000D0002:
+        case 0x000D0003: {
+                // 32 B key, signed and encrypted 1 KiB message, simulated round trip time in ms, whether to read with a cursor and author's key
+                auto key = privmx::crypto::Crypto::randomBytes(32);
+                auto privKey = privmx::crypto::PrivateKey::generateRandom();
+                core::DataEncryptorV4 encryptor;
+                result.push_back(key);
+                result.push_back(encryptor.signAndEncryptAndEncode(core::Buffer::from(privmx::crypto::Crypto::randomBytes(1024)), privKey, key));
+                result.push_back((fun_number & 0xFFFF) < 2 ? "20" : "100");
+                result.push_back((fun_number & 1) == 1 ? "1" : "0");
+                result.push_back(privKey.toWIF());
+            }
+            break;
+        case 0x000E0000:
+        case 0x000E0001: {
+                // 32 B key, message with a title in public meta, 256 B private meta and 64 KiB data encrypted as stored on the server,
+                // and fields to decrypt: all of them or only the public meta
+                auto key = privmx::crypto::Crypto::randomBytes(32);
+                auto privKey = privmx::crypto::PrivateKey::generateRandom();
+                thread::MessageDataToEncryptV5 message {
+                    .publicMeta = core::Buffer::from("{\"title\":\"Meeting notes for the project review\"}"),
+                    .privateMeta = core::Buffer::from(privmx::crypto::Crypto::randomBytes(256)),
+                    .data = core::Buffer::from(privmx::crypto::Crypto::randomBytes(64*1024)),
+                    .internalMeta = std::nullopt,
+                    .dio = core::DataIntegrityObject{
+                        .creatorUserId = "user",
+                        .creatorPubKey = privKey.getPublicKey().toBase58DER(),
+                        .contextId = "context",
+                        .resourceId = "resource",
+                        .timestamp = 0,
+                        .randomId = "randomId",
+                        .containerId = "thread",
+                        .containerResourceId = "threadResource",
+                        .bridgeIdentity = std::nullopt
+                    }
+                };
+                thread::MessageDataEncryptorV5 encryptor;
+                result.push_back(key);
+                result.push_back(privmx::utils::Utils::stringify(encryptor.encrypt(message, privKey, key).toJSON()));
+                result.push_back(std::to_string(fun_number == 0x000E0001 ? core::DataField::PUBLIC_META : core::DataField::ALL_DATA_FIELDS));
+            }
+            break;
     }
     return result;
 }
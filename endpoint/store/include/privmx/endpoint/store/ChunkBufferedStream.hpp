@@ -33,6 +33,9 @@ public:
     std::string getFullChunk(uint64_t pos);
     void freeFullChunks();
     void write(const std::string& data);
+    std::string getBufferedData() const;
+    uint64_t getTotalDataSize() const;
+    void restore(const std::string& bufferedData, uint64_t totalDataSize);
 private:
     size_t _chunkSize;
     std::string _buf;
@@ -54,6 +57,14 @@ inline uint64_t ChunkBufferedStream::getNumberOfFullChunks() const {
     return _bufSize / _chunkSize;
 }
 
+inline std::string ChunkBufferedStream::getBufferedData() const {
+    return _buf.substr(0, _bufSize);
+}
+
+inline uint64_t ChunkBufferedStream::getTotalDataSize() const {
+    return _totalDataSize;
+}
+
 inline bool ChunkBufferedStream::isFullyFilled() {
     PRIVMX_DEBUG("DEBUG", "ChunkBufferedStream::isFullyFilled", std::to_string(_totalDataSize) + " == " + std::to_string(_maxTotalDataSize));
     return _sizeControl ? _totalDataSize == _maxTotalDataSize : false;
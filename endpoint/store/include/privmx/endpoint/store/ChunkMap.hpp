@@ -0,0 +1,52 @@
+/*
+PrivMX Endpoint.
+Copyright © 2024 Simplito sp. z o.o.
+
+This file is part of the PrivMX Platform (https://privmx.dev).
+This software is Licensed under the PrivMX Free License.
+
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef _PRIVMXLIB_ENDPOINT_STORE_CHUNKMAP_HPP_
+#define _PRIVMXLIB_ENDPOINT_STORE_CHUNKMAP_HPP_
+
+#include <cstdint>
+#include <map>
+#include <optional>
+#include "privmx/endpoint/store/DynamicTypes.hpp"
+
+namespace privmx {
+namespace endpoint {
+namespace store {
+
+// Holes of a sparse random-write file: ranges of chunks [from, to) that were never written.
+// Hole chunks are not uploaded, they are synthesized as zeros by the client. The data written after a hole
+// is stored at its chunk position, so the Bridge extends the file over the hole and the file size on the server
+// stays the size of the dense file (checked when the file is opened).
+class ChunkMap
+{
+public:
+    static constexpr int64_t CHUNK_MAP_VERSION = 1;
+    // internal meta version of files with holes, the only one with a chunk map (Store writes version 4, Inbox version 5).
+    // Releases from before sparse files do not check this version, so they misread such files: they take the holes
+    // for stored chunks and fail on their zeroed checksums instead of refusing the file version.
+    static constexpr int64_t SPARSE_FILE_META_VERSION = 6;
+
+    ChunkMap() = default;
+    ChunkMap(const std::optional<dynamic::InternalStoreFileChunkMap>& chunkMap);
+    bool isHole(uint64_t index) const;
+    void addHole(uint64_t from, uint64_t to);
+    void fill(uint64_t index);
+    void truncate(uint64_t chunksCount);
+    std::optional<dynamic::InternalStoreFileChunkMap> toInternalMeta() const;
+private:
+    std::map<uint64_t, uint64_t> _holes;
+};
+
+} // store
+} // endpoint
+} // privmx
+
+#endif // _PRIVMXLIB_ENDPOINT_STORE_CHUNKMAP_HPP_
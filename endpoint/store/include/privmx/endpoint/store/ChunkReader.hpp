@@ -19,6 +19,7 @@ limitations under the License.
 #include <privmx/endpoint/core/Buffer.hpp>
 #include "privmx/endpoint/store/StoreException.hpp"
 #include "privmx/endpoint/store/StoreTypes.hpp"
+#include "privmx/endpoint/store/ChunkMap.hpp"
 
 #include "privmx/endpoint/store/interfaces/IChunkDataProvider.hpp"
 #include "privmx/endpoint/store/interfaces/IChunkEncryptor.hpp"
@@ -44,6 +45,7 @@ public:
     virtual std::string getDecryptedChunk(uint64_t index) override;
     virtual void sync(const store::FileDecryptionParams& newParms) override;
     virtual void update(int64_t newfileVersion, uint64_t index) override;
+    virtual void updateChunkMap(const ChunkMap& chunkMap) override;
 private:
     struct DecryptedChunk {
         std::string decryptedData;
@@ -55,6 +57,7 @@ private:
     size_t _chunkSize;
     int64_t _version;
     std::optional<DecryptedChunk> _lastChunk;
+    ChunkMap _chunkMap;
 };
 
 } // store
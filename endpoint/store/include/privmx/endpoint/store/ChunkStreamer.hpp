@@ -39,6 +39,19 @@ struct ChunksSentInfo
         std::string requestId;
     };
 
+struct ChunkStreamerState
+{
+    std::string requestId;
+    std::string key;
+    uint64_t fileIndex;
+    uint32_t seq;
+    uint64_t serverSeq;
+    uint64_t dataProcessed;
+    uint64_t uploadedFileSize;
+    std::string checksums;
+    std::string pendingData;
+};
+
 class ChunkStreamer
 {
 public:
@@ -52,6 +65,8 @@ public:
     ChunksSentInfo finalize(const std::string& data);    
     FileSizeResult getFileSize() const;
     uint64_t getUploadedFileSize();
+    ChunkStreamerState getState() const;
+    void restoreState(const ChunkStreamerState& state);
 private:
     struct PreparedChunk
     {
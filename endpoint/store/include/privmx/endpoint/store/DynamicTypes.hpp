@@ -19,6 +19,16 @@ namespace endpoint {
 namespace store {
 namespace dynamic {
 
+#define INTERNAL_STORE_FILE_HOLE_FIELDS(F)\
+    F(from, int64_t)\
+    F(to,   int64_t)
+JSON_STRUCT(InternalStoreFileHole, INTERNAL_STORE_FILE_HOLE_FIELDS);
+
+#define INTERNAL_STORE_FILE_CHUNK_MAP_FIELDS(F)\
+    F(version, int64_t)\
+    F(holes,   std::vector<InternalStoreFileHole>)
+JSON_STRUCT(InternalStoreFileChunkMap, INTERNAL_STORE_FILE_CHUNK_MAP_FIELDS);
+
 #define INTERNAL_STORE_FILE_META_FIELDS(F)\
     F(version,     int64_t)\
     F(size,        int64_t)\
@@ -26,7 +36,8 @@ namespace dynamic {
     F(chunkSize,   int64_t)\
     F(key,         std::string)\
     F(hmac,        std::string)\
-    F(randomWrite, std::optional<bool>)
+    F(randomWrite, std::optional<bool>)\
+    F(chunkMap,    std::optional<InternalStoreFileChunkMap>)
 JSON_STRUCT(InternalStoreFileMeta, INTERNAL_STORE_FILE_META_FIELDS);
 
 #define STORE_FILE_META_V4_FIELDS(F)\
@@ -63,6 +74,30 @@ JSON_STRUCT_EXT(File, Blob, FILE_FIELDS_DYNAMIC);
     F(chunkSize,  int64_t)
 JSON_STRUCT(SendFileResult, SEND_FILE_RESULT_FIELDS);
 
+#define UPLOAD_CHECKPOINT_FIELDS(F)\
+    F(version,                int64_t)\
+    F(storeId,                std::string)\
+    F(fileId,                 std::string)\
+    F(resourceId,             std::string)\
+    F(size,                   int64_t)\
+    F(publicMeta,             std::string)\
+    F(privateMeta,            std::string)\
+    F(randomWrite,            bool)\
+    F(chunkSize,              int64_t)\
+    F(serverRequestChunkSize, int64_t)\
+    F(requestId,              std::string)\
+    F(key,                    std::string)\
+    F(fileIndex,              int64_t)\
+    F(seq,                    int64_t)\
+    F(serverSeq,              int64_t)\
+    F(dataProcessed,          int64_t)\
+    F(uploadedFileSize,       int64_t)\
+    F(checksums,              std::string)\
+    F(pendingEncryptedData,   std::string)\
+    F(pendingPlainData,       std::string)\
+    F(writtenSize,            int64_t)
+JSON_STRUCT(UploadCheckpoint, UPLOAD_CHECKPOINT_FIELDS);
+
 namespace compat_v1 {
 
 #define STORE_DATA_FIELDS(F)\
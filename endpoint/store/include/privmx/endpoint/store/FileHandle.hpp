@@ -22,6 +22,7 @@ limitations under the License.
 
 #include "privmx/endpoint/store/ChunkBufferedStream.hpp"
 #include "privmx/endpoint/store/ChunkStreamer.hpp"
+#include "privmx/endpoint/store/LocalFile.hpp"
 #include "privmx/endpoint/store/interfaces/IFileReader.hpp"
 #include "privmx/endpoint/store/interfaces/IFileHandler.hpp"
 #include "privmx/endpoint/store/interfaces/IChunkEncryptor.hpp"
@@ -73,6 +74,7 @@ public:
     bool isReadHandle() const override { return true; }
     std::string read(uint64_t length);
     void seek(uint64_t pos);
+    void readToFile(LocalFileWriter& output);
 private:
     std::shared_ptr<IChunkEncryptor> _chunkEncryptor;
     std::shared_ptr<IChunkDataProvider> _chunkDataProvider;
@@ -85,6 +87,9 @@ private:
 class FileWriteHandle : public FileHandle
 {
 public:
+    // number of chunks read from a local file in a single call by writeFromFile()
+    static constexpr uint64_t LOCAL_FILE_READ_CHUNKS = 32;
+
     FileWriteHandle(
         int64_t id,
         const std::string& storeId,
@@ -99,6 +104,7 @@ public:
         bool randomWriteSupport
     );
     void write(const std::string& data);
+    void writeFromFile(LocalFileReader& input);
     privmx::endpoint::store::ChunksSentInfo finalize();
     bool isReadyToFinalize();
     core::Buffer getPublicMeta();
@@ -106,10 +112,16 @@ public:
     privmx::endpoint::store::FileSizeResult getEncryptedFileSize();
     void createRequestData();
     void setRequestData(const std::string& requestId, const std::string& key, const Poco::Int64& fileIndex);
+    ChunkStreamerState getStreamerState() const;
+    std::string getPendingData() const;
+    uint64_t getWrittenSize() const;
+    uint64_t getChunkSize() const;
+    void restoreState(const ChunkStreamerState& streamerState, const std::string& pendingData, uint64_t writtenSize);
     bool isWriteHandle() const override { return true; }
 private:
     core::Buffer _publicMeta;
     core::Buffer _privateMeta;
+    uint64_t _chunkSize;
     ChunkBufferedStream _stream;
     ChunkStreamer _streamer;
 };
@@ -13,6 +13,7 @@ limitations under the License.
 #define _PRIVMXLIB_ENDPOINT_STORE_FILE_HANDLER_HPP_
 
 #include <cstdint>
+#include <map>
 #include <string>
 #include <privmx/endpoint/core/Buffer.hpp>
 #include <privmx/endpoint/core/CoreTypes.hpp>
@@ -20,6 +21,7 @@ limitations under the License.
 #include "privmx/endpoint/store/DynamicTypes.hpp"
 #include "privmx/endpoint/store/StoreTypes.hpp"
 #include "privmx/endpoint/store/ServerApi.hpp"
+#include "privmx/endpoint/store/ChunkMap.hpp"
 
 #include "privmx/endpoint/store/interfaces/IChunkEncryptor.hpp"
 #include "privmx/endpoint/store/interfaces/IHashList.hpp"
@@ -57,6 +59,7 @@ public:
     void sync(const FileMeta& fileMeta, const store::FileDecryptionParams& newParms, const core::DecryptedEncKey& fileEncKey);
     void close();
     void flush();
+    void setWriteBackBufferSize(uint64_t bufferSize);
 
 private:
     struct UpdateChunkData {
@@ -64,14 +67,23 @@ private:
         uint64_t chunkIndex;
         int64_t plainfileSizeChange;
         int64_t encryptedFileSizeChange;
+        bool hole = false;
     };
     struct UpdateChanges {
         std::string data;
         uint64_t dataPos;
         std::string checksum;
         uint64_t checksumPos;
+        // only checksums of holes, no file data is sent
+        bool holes = false;
     };
 
+    void writeDirect(uint64_t offset, const std::string& data, bool truncate);
+    void writeBuffered(uint64_t offset, const std::string& data);
+    std::string getCurrentPlainChunk(uint64_t index);
+    bool createsHole(uint64_t offset);
+    UpdateChunkData createHoleChunk(uint64_t index);
+    void commitUpdateChunks(const std::vector<UpdateChunkData>& chunksToUpdate, uint64_t newPlainfileSize, uint64_t newEncryptedFileSize, bool truncate);
     UpdateChunkData createUpdateChunk(uint64_t index, uint64_t chunkOffset, const std::string& data, bool truncate = false);
     void updateOnServer(const std::vector<UpdateChanges>& updatedChunks, Poco::Dynamic::Var updatedMeta, const std::string& encKeyId, bool truncate);
     std::vector<UpdateChanges> createListOfUpdateChangesFromUpdateChunkData(const std::vector<UpdateChunkData>& updatedChunks);
@@ -90,6 +102,11 @@ private:
     std::shared_ptr<ServerApi> _server;
     size_t _plainChunkSize;
     size_t _encryptedChunkSize;
+    ChunkMap _chunkMap;
+    // write-back buffer: patched plain chunks not yet sent to the server, keyed by chunk index
+    uint64_t _writeBackBufferSize = 0;
+    std::map<uint64_t, std::string> _dirtyChunks;
+    uint64_t _bufferedFileSize = 0;
     static constexpr size_t SERVER_OPERATIONS_LIMIT = 4;
     static constexpr size_t SERVER_OPERATION_SIZE_LIMIT = 512*1024; // 512KiB
 };
@@ -105,11 +122,18 @@ public:
     core::Buffer read(const uint64_t length) override;
     void write(const core::Buffer& chunk, bool truncate = false) override;
 
-    inline void close() override {}
+    inline void close() override {
+        return _file->close();
+    }
     inline void sync(const FileMeta& fileMeta, const store::FileDecryptionParams& newParms, const core::DecryptedEncKey& fileEncKey) override {
         return _file->sync(fileMeta, newParms, fileEncKey);
     }
-    inline void flush() override {throw NotImplementedException();}
+    inline void flush() override {
+        return _file->flush();
+    }
+    inline void setWriteBackBufferSize(const uint64_t bufferSize) override {
+        return _file->setWriteBackBufferSize(bufferSize);
+    }
 
 private:
     std::shared_ptr<FileHandler> _file;
@@ -0,0 +1,59 @@
+/*
+PrivMX Endpoint.
+Copyright © 2024 Simplito sp. z o.o.
+
+This file is part of the PrivMX Platform (https://privmx.dev).
+This software is Licensed under the PrivMX Free License.
+
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef _PRIVMXLIB_ENDPOINT_STORE_LOCALFILE_HPP_
+#define _PRIVMXLIB_ENDPOINT_STORE_LOCALFILE_HPP_
+
+#include <cstdint>
+#include <string>
+
+namespace privmx {
+namespace endpoint {
+namespace store {
+
+// Thin wrappers over a local file descriptor used by the direct-to-path transfer methods,
+// so that file data does not have to cross the public API chunk by chunk.
+class LocalFileReader
+{
+public:
+    LocalFileReader(const std::string& path);
+    ~LocalFileReader();
+    LocalFileReader(const LocalFileReader&) = delete;
+    LocalFileReader& operator=(const LocalFileReader&) = delete;
+    uint64_t getSize() const;
+    std::string read(size_t length);
+    void close();
+private:
+    std::string _path;
+    int _fd;
+    uint64_t _size;
+};
+
+class LocalFileWriter
+{
+public:
+    LocalFileWriter(const std::string& path, uint64_t size);
+    ~LocalFileWriter();
+    LocalFileWriter(const LocalFileWriter&) = delete;
+    LocalFileWriter& operator=(const LocalFileWriter&) = delete;
+    void writeAt(uint64_t offset, const std::string& data);
+    void close();
+    void discard();
+private:
+    std::string _path;
+    int _fd;
+};
+
+} // store
+} // endpoint
+} // privmx
+
+#endif // _PRIVMXLIB_ENDPOINT_STORE_LOCALFILE_HPP_
@@ -12,6 +12,7 @@ limitations under the License.
 #ifndef _PRIVMXLIB_ENDPOINT_STORE_STOREAPIIMPL_HPP_
 #define _PRIVMXLIB_ENDPOINT_STORE_STOREAPIIMPL_HPP_
 
+#include <functional>
 #include <memory>
 #include <optional>
 #include <string>
@@ -44,6 +45,8 @@ limitations under the License.
 #include "privmx/endpoint/store/Constants.hpp"
 #include "privmx/endpoint/store/SubscriberImpl.hpp"
 #include "privmx/endpoint/core/ModuleBaseApi.hpp"
+#include "privmx/endpoint/core/PrefetchingCursor.hpp"
+#include "privmx/endpoint/core/UsersKeysResolver.hpp"
 #include <privmx/utils/ManualManagedClass.hpp>
 
 namespace privmx {
@@ -66,6 +69,7 @@ public:
         size_t serverRequestChunkSize
     );
     ~StoreApiImpl();
+    using core::ModuleBaseApi::getAsyncRequestQueue;
     std::string createStore(const std::string& contextId, const std::vector<core::UserWithPubKey>& users, const std::vector<core::UserWithPubKey>& managers, 
                 const core::Buffer& publicMeta, const core::Buffer& privateMeta,
                 const std::optional<core::ContainerPolicy>& policies);
@@ -83,6 +87,8 @@ public:
         const bool forceGenerateNewKey,
         const std::optional<core::ContainerPolicy>& policies
     );
+    void addStoreMembers(const std::string& storeId, const std::vector<core::UserWithPubKey>& users, const std::vector<core::UserWithPubKey>& managers);
+    void removeStoreMembers(const std::string& storeId, const std::vector<std::string>& userIds);
     void deleteStore(const std::string& storeId);
     Store getStore(const std::string& storeId);
     Store getStoreEx(const std::string& storeId, const std::string& type);
@@ -90,6 +96,7 @@ public:
     core::PagingList<Store> listStoresEx(const std::string& contextId, const core::PagingQuery& query, const std::string& type);
     File getFile(const std::string& fileId);
     core::PagingList<store::File> listFiles(const std::string& storeId, const core::PagingQuery& query);
+    core::CursorPage<store::File> fetchFilesPage(const std::string& storeId, const core::PagingQuery& query);
     void deleteFile(const std::string& fileId);
     int64_t createFile(const std::string& storeId, const core::Buffer& publicMeta, const core::Buffer& privateMeta, const int64_t size, bool randomWriteSupport = false);
     int64_t updateFile(const std::string& fileId, const core::Buffer& publicMeta, const core::Buffer& privateMeta, const int64_t size);
@@ -100,6 +107,12 @@ public:
     void seekInFile(const int64_t handle, const int64_t pos);
     void syncFile(const int64_t handle);
     std::string closeFile(const int64_t handle);
+    void downloadFileToPath(const std::string& fileId, const std::string& filePath);
+    std::string uploadFileFromPath(const std::string& storeId, const core::Buffer& publicMeta, const core::Buffer& privateMeta, const std::string& filePath, bool randomWriteSupport = false);
+    void enableUploadProgressJournal(const std::string& directory);
+    UploadCheckpoint getUploadCheckpoint(const int64_t handle);
+    int64_t resumeUpload(const core::Buffer& checkpoint);
+    void setWriteBackBufferSize(const int64_t handle, const int64_t bufferSize);
     FileDecryptionParams getFileDecryptionParams(server::File file, const core::DecryptedEncKey& encKey);
     std::tuple<File, core::DataIntegrityObject> decryptAndConvertFileDataToFileInfo(server::File file, const core::DecryptedEncKey& encKey);
 
@@ -110,6 +123,16 @@ private:
     std::string _storeCreateEx(const std::string& contextId, const std::vector<core::UserWithPubKey>& users, const std::vector<core::UserWithPubKey>& managers, 
                 const core::Buffer& publicMeta, const core::Buffer& privateMeta, const std::string& type,
                 const std::optional<core::ContainerPolicy>& policies);
+    void updateStoreMembers(const std::string& storeId, const core::ContainerMembersDelta& delta);
+    void updateStoreRequest(
+        const server::Store& currentStore,
+        const std::function<std::shared_ptr<core::UsersKeysResolver>(const core::DecryptedEncKeyV2&)>& createUsersKeysResolver,
+        const core::Buffer& publicMeta,
+        const core::Buffer& privateMeta,
+        const int64_t version,
+        const bool force,
+        const std::optional<core::ContainerPolicy>& policies
+    );
     Store _storeGetEx(const std::string& storeId, const std::string& type);
     core::PagingList<Store> _storeListEx(const std::string& contextId, const core::PagingQuery& query, const std::string& type);
     std::string storeFileFinalizeWriteRequest(
@@ -175,6 +198,7 @@ private:
     FileEncryptionParams getFileEncryptionParams(server::File file, server::Store store);
     FileDecryptionParams getFileDecryptionParams(server::File file, dynamic::InternalStoreFileMeta internalMeta);
     
+    std::string getUploadCheckpointKey();
     int64_t createFileReadHandle(const FileDecryptionParams& storeFileDecryptionParams);
     int64_t createFileRandomWriteHandle(const FileDecryptionParams& storeFileDecryptionParams, const FileMeta& fileMeta);
     void assertStoreExist(const std::string& storeId);
@@ -191,6 +215,7 @@ private:
     std::shared_ptr<core::EventMiddleware> _eventMiddleware;
     std::shared_ptr<core::HandleManager> _handleManager;
     core::Connection _connection;
+    std::shared_ptr<core::ContainerMembersUpdater> _containerMembersUpdater;
     size_t _serverRequestChunkSize;
     
     FileHandleManager _fileHandleManager;
@@ -199,6 +224,7 @@ private:
     FileKeyIdFormatValidator _fileKeyIdFormatValidator;
     SubscriberImpl _subscriber;
     int _notificationListenerId, _connectedListenerId, _disconnectedListenerId;
+    int _containerMembersHandlerId;
     std::string _fileDecryptorId, _fileOpenerId, _fileSeekerId, _fileReaderId, _fileCloserId; 
 
     FileMetaEncryptorV4 _fileMetaEncryptorV4;
@@ -206,8 +232,10 @@ private:
     FileMetaEncryptorV5 _fileMetaEncryptorV5;
     core::ModuleDataEncryptorV5 _storeDataEncryptorV5;
     core::DataEncryptorV4 _eventDataEncryptorV4;
+    core::DataEncryptorV4 _uploadCheckpointEncryptorV4;
     
     inline static const std::string STORE_TYPE_FILTER_FLAG = "store";
+    inline static const int64_t UPLOAD_CHECKPOINT_VERSION = 1;
 };
 
 } // store
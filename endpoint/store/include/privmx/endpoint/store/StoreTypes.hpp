@@ -12,6 +12,7 @@ limitations under the License.
 #ifndef _PRIVMXLIB_ENDPOINT_STORE_STORETYPES_HPP_
 #define _PRIVMXLIB_ENDPOINT_STORE_STORETYPES_HPP_
 
+#include <optional>
 #include <string>
 
 #include "privmx/endpoint/store/DynamicTypes.hpp"
@@ -37,6 +38,7 @@ struct FileDecryptionParams {
     std::string key;
     std::string hmac;
     int64_t version;
+    std::optional<dynamic::InternalStoreFileChunkMap> chunkMap;
 };
 
 struct FileMetaSigned
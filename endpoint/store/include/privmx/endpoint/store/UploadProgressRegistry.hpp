@@ -0,0 +1,47 @@
+/*
+PrivMX Endpoint.
+Copyright © 2024 Simplito sp. z o.o.
+
+This file is part of the PrivMX Platform (https://privmx.dev).
+This software is Licensed under the PrivMX Free License.
+
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef _PRIVMXLIB_ENDPOINT_STORE_UPLOADPROGRESSREGISTRY_HPP_
+#define _PRIVMXLIB_ENDPOINT_STORE_UPLOADPROGRESSREGISTRY_HPP_
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace privmx {
+namespace endpoint {
+namespace store {
+
+// Number of chunks the server accepted for every upload request, shared by all connections of the process,
+// so resuming from a checkpoint older than the progress made after it can be refused.
+// The progress is also written to a journal directory, one small file per request replaced after every accepted chunk,
+// so the check holds after the process restarts. Checkpoints can be taken only once the journal is set.
+class UploadProgressRegistry
+{
+public:
+    static void setJournalDirectory(const std::string& directory);
+    static bool hasJournal();
+    static void recordChunkSent(const std::string& requestId, uint64_t serverSeq);
+    static void recordCommitted(const std::string& requestId);
+    // whether the server holds more chunks of the request than the given state has sent, or the upload was committed
+    static bool isStale(const std::string& requestId, uint64_t serverSeq);
+
+private:
+    static std::string getJournalPath(const std::string& directory, const std::string& requestId);
+    static std::optional<uint64_t> readJournal(const std::string& directory, const std::string& requestId);
+    static void writeJournal(const std::string& directory, const std::string& requestId, uint64_t serverSeq);
+};
+
+} // store
+} // endpoint
+} // privmx
+
+#endif // _PRIVMXLIB_ENDPOINT_STORE_UPLOADPROGRESSREGISTRY_HPP_
@@ -79,6 +79,9 @@ Poco::Dynamic::Var VarSerializer::serialize<PagingList<store::File>>(const Pagin
 template<>
 Poco::Dynamic::Var VarSerializer::serialize<store::ServerFileInfo>(const store::ServerFileInfo& val);
 
+template<>
+Poco::Dynamic::Var VarSerializer::serialize<store::UploadCheckpoint>(const store::UploadCheckpoint& val);
+
 
 
 }  // namespace core
@@ -33,6 +33,7 @@ public:
                                        const std::string& encryptionKey);
     store::DecryptedFileMetaV5 extractPublic(const store::server::EncryptedFileMetaV5& encryptedFileMeta);
     core::DataIntegrityObject getDIOAndAssertIntegrity(const server::EncryptedFileMetaV5& encryptedFileMeta);
+    void setCompressor(const std::shared_ptr<const core::DataCompressor>& compressor);
 private:
     void assertDataFormat(const store::server::EncryptedFileMetaV5& encryptedFileMeta);
     core::Buffer serializeNumber(const int64_t& number);
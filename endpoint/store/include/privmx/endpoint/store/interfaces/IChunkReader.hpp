@@ -12,6 +12,8 @@ limitations under the License.
 #ifndef _PRIVMXLIB_ENDPOINT_STORE_CHUNKREADER_INTERFACE_HPP_
 #define _PRIVMXLIB_ENDPOINT_STORE_CHUNKREADER_INTERFACE_HPP_
 
+#include "privmx/endpoint/store/ChunkMap.hpp"
+
 namespace privmx {
 namespace endpoint {
 namespace store {
@@ -25,6 +27,7 @@ public:
     virtual std::string getDecryptedChunk(uint64_t index) = 0;
     virtual void sync(const store::FileDecryptionParams& newParms) = 0;
     virtual void update(int64_t newfileVersion, uint64_t index) = 0;
+    virtual void updateChunkMap(const ChunkMap& chunkMap) = 0;
 };
 
 
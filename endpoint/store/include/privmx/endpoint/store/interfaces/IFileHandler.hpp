@@ -32,6 +32,7 @@ public:
     virtual void close() = 0;
     virtual void sync(const FileMeta& fileMeta, const store::FileDecryptionParams& newParms, const core::DecryptedEncKey& fileEncKey) = 0;
     virtual void flush() = 0;
+    virtual void setWriteBackBufferSize(const uint64_t bufferSize) = 0;
 };
 
 } // store
@@ -50,6 +50,14 @@ public:
         SubscribeFor = 22,
         UnsubscribeFrom = 23,
         BuildSubscriptionQuery = 24,
+        DownloadFileToPath = 25,
+        UploadFileFromPath = 26,
+        GetUploadCheckpoint = 27,
+        ResumeUpload = 28,
+        SetWriteBackBufferSize = 29,
+        AddStoreMembers = 30,
+        RemoveStoreMembers = 31,
+        EnableUploadProgressJournal = 32,
     };
 
     StoreApiVarInterface(core::Connection connection, const core::VarSerializer& serializer)
@@ -58,6 +66,8 @@ public:
     Poco::Dynamic::Var create(const Poco::Dynamic::Var& args);
     Poco::Dynamic::Var createStore(const Poco::Dynamic::Var& args);
     Poco::Dynamic::Var updateStore(const Poco::Dynamic::Var& args);
+    Poco::Dynamic::Var addStoreMembers(const Poco::Dynamic::Var& args);
+    Poco::Dynamic::Var removeStoreMembers(const Poco::Dynamic::Var& args);
     Poco::Dynamic::Var deleteStore(const Poco::Dynamic::Var& args);
     Poco::Dynamic::Var getStore(const Poco::Dynamic::Var& args);
     Poco::Dynamic::Var listStores(const Poco::Dynamic::Var& args);
@@ -76,6 +86,12 @@ public:
     Poco::Dynamic::Var subscribeFor(const Poco::Dynamic::Var& args);
     Poco::Dynamic::Var unsubscribeFrom(const Poco::Dynamic::Var& args);
     Poco::Dynamic::Var buildSubscriptionQuery(const Poco::Dynamic::Var& args);
+    Poco::Dynamic::Var downloadFileToPath(const Poco::Dynamic::Var& args);
+    Poco::Dynamic::Var uploadFileFromPath(const Poco::Dynamic::Var& args);
+    Poco::Dynamic::Var enableUploadProgressJournal(const Poco::Dynamic::Var& args);
+    Poco::Dynamic::Var getUploadCheckpoint(const Poco::Dynamic::Var& args);
+    Poco::Dynamic::Var resumeUpload(const Poco::Dynamic::Var& args);
+    Poco::Dynamic::Var setWriteBackBufferSize(const Poco::Dynamic::Var& args);
 
 
     Poco::Dynamic::Var exec(METHOD method, const Poco::Dynamic::Var& args);
@@ -7,6 +7,8 @@
 #include <vector>
 
 #include "privmx/endpoint/core/Connection.hpp"
+#include "privmx/endpoint/core/Cursor.hpp"
+#include "privmx/endpoint/core/Future.hpp"
 #include "privmx/endpoint/store/Types.hpp"
 #include <privmx/endpoint/core/ExtendedPointer.hpp>
 
@@ -75,6 +77,26 @@ public:
                      const bool force, const bool forceGenerateNewKey,
                      const std::optional<core::ContainerPolicy>& policies = std::nullopt);
 
+    /**
+     * Gives users access to an existing Store, without changing its other members and metadata.
+     *
+     * @param storeId ID of the Store to update
+     * @param users vector of UserWithPubKey structs which indicates who will get access to the Store
+     * @param managers vector of UserWithPubKey structs which indicates who will get access (and management rights) to
+     * the Store
+     */
+    void addStoreMembers(const std::string& storeId, const std::vector<core::UserWithPubKey>& users,
+                         const std::vector<core::UserWithPubKey>& managers);
+
+    /**
+     * Takes away access to an existing Store from the given users, both as users and managers.
+     * The Store gets a new key, which is shared with the remaining members using their public keys from the Context.
+     *
+     * @param storeId ID of the Store to update
+     * @param userIds IDs of the users to remove
+     */
+    void removeStoreMembers(const std::string& storeId, const std::vector<std::string>& userIds);
+
     /**
      * Deletes a Store by given Store ID.
      *
@@ -157,6 +179,15 @@ public:
      */
     File getFile(const std::string& fileId);
 
+    /**
+     * Gets a single file by the given file ID without waiting for the result.
+     *
+     * @param fileId ID of the file to get
+     * @param options options of the call, e.g. its timeout
+     * @return future result: struct containing information about the file
+     */
+    core::Future<File> getFileAsync(const std::string& fileId, const core::AsyncCallOptions& options = {});
+
     /**
      * Gets a list of files in given Store.
      *
@@ -166,6 +197,18 @@ public:
      */
     core::PagingList<File> listFiles(const std::string& storeId, const core::PagingQuery& pagingQuery);
 
+    /**
+     * Opens a cursor reading all the files of a Store page by page.
+     * The following pages are downloaded in the background while the application processes the current one.
+     *
+     * @param storeId ID of the Store to read files from
+     * @param pagingQuery struct with list query parameters of the first page, its limit is the size of every page
+     * @param pagesAhead maximum number of pages downloaded ahead of the page being read
+     * @return cursor returning the next page on every next() call
+     */
+    core::Cursor<File> openFileCursor(const std::string& storeId, const core::PagingQuery& pagingQuery,
+                            int64_t pagesAhead = core::DEFAULT_CURSOR_PAGES_AHEAD);
+
     /**
      * Opens a file to read.
      *
@@ -228,6 +271,75 @@ public:
      */ 
     void syncFile(const int64_t fileHandle);
 
+    /**
+     * Downloads a file directly to the local file system.
+     * Decrypted chunks are written straight to the given path without passing through the caller.
+     * An existing file at the given path is overwritten.
+     *
+     * @param fileId ID of the file to download
+     * @param filePath path of the local file to write data to
+     */
+    void downloadFileToPath(const std::string& fileId, const std::string& filePath);
+
+    /**
+     * Creates a new file in a Store from a local file.
+     * File data is read and sent in large blocks inside the library, the size of the file is taken from the local file.
+     *
+     * @param storeId ID of the Store to create the file in
+     * @param publicMeta public file metadata
+     * @param privateMeta private file metadata
+     * @param filePath path of the local file to read data from
+     * @param randomWriteSupport enable random write support for file
+     * @return ID of the created file
+     */
+    std::string uploadFileFromPath(const std::string& storeId, const core::Buffer& publicMeta, const core::Buffer& privateMeta,
+                            const std::string& filePath, bool randomWriteSupport = false);
+
+    /**
+     * Sets the directory of the upload progress journal, required to take and resume upload checkpoints.
+     * The server cannot be asked which chunks of an upload it holds, so the number of chunks it accepted
+     * is written to the journal after each of them, and checkpoints behind it are refused, also after a restart.
+     * The journal holds no key material. It is shared by all the connections of the process.
+     *
+     * @param directory path of the directory to store the journal in, created when missing
+     */
+    void enableUploadProgressJournal(const std::string& directory);
+
+    /**
+     * Takes a checkpoint of an unfinished upload.
+     * The checkpoint is encrypted with a key derived from the user's private key and can be stored
+     * by the application at any interval. It holds the file key, so it must be kept as securely as the user's data.
+     * Throws UploadProgressJournalNotSetException when enableUploadProgressJournal() has not been called.
+     *
+     * @param fileHandle handle to write file data
+     * @return struct with the encrypted upload state and the number of bytes already written
+     */
+    UploadCheckpoint getUploadCheckpoint(const int64_t fileHandle);
+
+    /**
+     * Resumes an upload from a checkpoint taken with getUploadCheckpoint().
+     * Data must be written to the returned handle starting from the checkpoint's offset.
+     * Throws StaleUploadCheckpointException when the upload progress journal records more chunks accepted by the server
+     * than the checkpoint has sent, or the upload has been committed. A process resuming an upload started by another one
+     * must use the same journal directory.
+     *
+     * @param checkpoint encrypted upload state
+     * @return handle to write file data
+     */
+    int64_t resumeUpload(const core::Buffer& checkpoint);
+
+    /**
+     * Sets the size of the write-back buffer of a file opened with random write support.
+     * Writes are collected in memory and sent to the server as one update when the buffer is full,
+     * on syncFile() and on closeFile(). Setting the size to 0 flushes the buffer and disables it.
+     * Writes which the server refused stay in the buffer and are sent again with the next flush; when they
+     * cannot be sent on syncFile() the handle is closed, and closeFile() releases the handle in any case.
+     *
+     * @param fileHandle handle to read/write file data
+     * @param bufferSize maximum size of buffered data in bytes
+     */
+    void setWriteBackBufferSize(const int64_t fileHandle, const int64_t bufferSize);
+
 private:
     StoreApi(const std::shared_ptr<StoreApiImpl>& impl);
 };
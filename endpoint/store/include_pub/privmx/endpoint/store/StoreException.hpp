@@ -81,6 +81,21 @@ DECLARE_ENDPOINT_EXCEPTION(EndpointStoreException, FileSyncFailedHandleCloseExce
 DECLARE_ENDPOINT_EXCEPTION(EndpointStoreException, FileRandomWriteInternalException, "File random write internal Exception ", 0x002C)
 
 DECLARE_ENDPOINT_EXCEPTION(EndpointStoreException, InvalidSubscriptionQueryException, "Invalid subscriptionQuery", 0x002D)
+// ------------------------------ Local File ------------------------------
+DECLARE_ENDPOINT_EXCEPTION(EndpointStoreException, LocalFileOpenFailedException, "Cannot open local file", 0x002E)
+DECLARE_ENDPOINT_EXCEPTION(EndpointStoreException, LocalFileReadFailedException, "Cannot read local file", 0x002F)
+DECLARE_ENDPOINT_EXCEPTION(EndpointStoreException, LocalFileWriteFailedException, "Cannot write local file", 0x0030)
+// ------------------------------ Resumable upload ------------------------------
+DECLARE_ENDPOINT_EXCEPTION(EndpointStoreException, InvalidUploadCheckpointException, "Invalid upload checkpoint", 0x0031)
+DECLARE_ENDPOINT_EXCEPTION(EndpointStoreException, StaleUploadCheckpointException, "Upload checkpoint older than the data already sent", 0x0035)
+DECLARE_ENDPOINT_EXCEPTION(EndpointStoreException, UploadProgressJournalNotSetException, "Upload progress journal directory not set", 0x0037)
+DECLARE_ENDPOINT_EXCEPTION(EndpointStoreException, UploadProgressJournalFailedException, "Cannot access upload progress journal", 0x0038)
+// ------------------------------ Write-back ------------------------------
+DECLARE_ENDPOINT_EXCEPTION(EndpointStoreException, InvalidFileReadWriteHandleException, "Invalid file handle: handle is not FILE_READ_WRITE_HANDLE", 0x0032)
+// ------------------------------ Sparse files ------------------------------
+DECLARE_ENDPOINT_EXCEPTION(EndpointStoreException, UnsupportedChunkMapVersionException, "Unsupported file chunk map version", 0x0033)
+DECLARE_ENDPOINT_EXCEPTION(EndpointStoreException, InvalidChunkMapException, "Invalid file chunk map", 0x0034)
+DECLARE_ENDPOINT_EXCEPTION(EndpointStoreException, UnsupportedFileMetaVersionException, "Unsupported file internal meta version", 0x0036)
 
 
 } // store
@@ -100,6 +100,22 @@ struct File {
     bool randomWrite;
 };
 
+/**
+ * Holds a snapshot of an unfinished file upload, which can be used to resume it.
+ */
+struct UploadCheckpoint {
+
+    /**
+     * encrypted upload state, to be passed to resumeUpload()
+     */
+    core::Buffer data;
+
+    /**
+     * number of file bytes already written to the upload, writing is continued from this position
+     */
+    int64_t offset;
+};
+
 
 /**
  * Holds all available information about a Store.
@@ -13,6 +13,8 @@ typedef struct StoreApi StoreApi;
 int privmx_endpoint_newStoreApi(Connection* connectionPtr, StoreApi** outPtr);
 int privmx_endpoint_freeStoreApi(StoreApi* ptr);
 int privmx_endpoint_execStoreApi(StoreApi* ptr, int method, const pson_value* args, pson_value** res);
+int privmx_endpoint_storeWriteToFile(StoreApi* ptr, int64_t fileHandle, privmx_const_buffer dataChunk, int truncate, privmx_error* error);
+int privmx_endpoint_storeReadFromFile(StoreApi* ptr, int64_t fileHandle, int64_t length, privmx_buffer* outData, privmx_error* error);
 
 #ifdef __cplusplus
 }
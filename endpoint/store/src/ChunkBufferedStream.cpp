@@ -42,4 +42,13 @@ std::string ChunkBufferedStream::getFullChunk(uint64_t pos) {
 void ChunkBufferedStream::freeFullChunks() {
     _buf = _buf.substr(_chunkSize*getNumberOfFullChunks());
     _bufSize = _bufSize - (_chunkSize*getNumberOfFullChunks());
-}
\ No newline at end of file
+}
+
+void ChunkBufferedStream::restore(const std::string& bufferedData, uint64_t totalDataSize) {
+    if(_sizeControl && totalDataSize > _maxTotalDataSize) {
+        throw core::DataBiggerThanDeclaredException();
+    }
+    _buf = bufferedData;
+    _bufSize = bufferedData.size();
+    _totalDataSize = totalDataSize;
+}
@@ -88,6 +88,9 @@ void ChunkDataProvider::update(int64_t newfileVersion, uint32_t chunkNumber, con
     uint64_t serverChunkPos = from % _serverChunkSize;
     if(_lastServerChunkNumber.has_value() && _lastServerChunkNumber.value() == serverChunkNumber) {
         std::string oldServerChunkDataBefore = _lastServerChunk.substr(0, serverChunkPos);
+        // chunk written after a hole, the hole bytes are never read back (holes are synthesized by the client),
+        // the padding only keeps the position of the new chunk in the cached server chunk
+        oldServerChunkDataBefore.resize(serverChunkPos, (char)0x00);
         std::string oldServerChunkDataAfter = "";
         if(!truncate && _lastServerChunk.size() > serverChunkPos + newChunkEncryptedData.size()) {
             oldServerChunkDataAfter = _lastServerChunk.substr(serverChunkPos + newChunkEncryptedData.size());
@@ -0,0 +1,99 @@
+/*
+PrivMX Endpoint.
+Copyright © 2024 Simplito sp. z o.o.
+
+This file is part of the PrivMX Platform (https://privmx.dev).
+This software is Licensed under the PrivMX Free License.
+
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <algorithm>
+#include <iterator>
+
+#include "privmx/endpoint/store/ChunkMap.hpp"
+#include "privmx/endpoint/store/StoreException.hpp"
+
+using namespace privmx::endpoint::store;
+
+ChunkMap::ChunkMap(const std::optional<dynamic::InternalStoreFileChunkMap>& chunkMap) {
+    if (!chunkMap.has_value()) {
+        return;
+    }
+    if (chunkMap->version != CHUNK_MAP_VERSION) {
+        throw UnsupportedChunkMapVersionException(std::to_string(chunkMap->version) + " expected version: " + std::to_string(CHUNK_MAP_VERSION));
+    }
+    for (const auto& hole : chunkMap->holes) {
+        if (hole.from < 0 || hole.to <= hole.from) {
+            throw InvalidChunkMapException();
+        }
+        addHole(hole.from, hole.to);
+    }
+}
+
+bool ChunkMap::isHole(uint64_t index) const {
+    auto it = _holes.upper_bound(index);
+    if (it == _holes.begin()) {
+        return false;
+    }
+    --it;
+    return index < it->second;
+}
+
+void ChunkMap::addHole(uint64_t from, uint64_t to) {
+    if (to <= from) {
+        return;
+    }
+    // merge with overlapping or adjacent holes
+    auto it = _holes.upper_bound(from);
+    if (it != _holes.begin() && std::prev(it)->second >= from) {
+        --it;
+        from = it->first;
+    }
+    while (it != _holes.end() && it->first <= to) {
+        to = std::max(to, it->second);
+        it = _holes.erase(it);
+    }
+    _holes[from] = to;
+}
+
+void ChunkMap::fill(uint64_t index) {
+    auto it = _holes.upper_bound(index);
+    if (it == _holes.begin()) {
+        return;
+    }
+    --it;
+    auto from = it->first;
+    auto to = it->second;
+    if (index >= to) {
+        return;
+    }
+    _holes.erase(it);
+    if (from < index) {
+        _holes[from] = index;
+    }
+    if (index + 1 < to) {
+        _holes[index + 1] = to;
+    }
+}
+
+void ChunkMap::truncate(uint64_t chunksCount) {
+    auto it = _holes.lower_bound(chunksCount);
+    _holes.erase(it, _holes.end());
+    if (!_holes.empty() && _holes.rbegin()->second > chunksCount) {
+        _holes.rbegin()->second = chunksCount;
+    }
+}
+
+std::optional<privmx::endpoint::store::dynamic::InternalStoreFileChunkMap> ChunkMap::toInternalMeta() const {
+    if (_holes.empty()) {
+        return std::nullopt;
+    }
+    dynamic::InternalStoreFileChunkMap result;
+    result.version = CHUNK_MAP_VERSION;
+    for (const auto& [from, to] : _holes) {
+        result.holes.push_back(dynamic::InternalStoreFileHole{.from = (int64_t)from, .to = (int64_t)to});
+    }
+    return result;
+}
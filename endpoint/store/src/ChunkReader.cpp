@@ -25,7 +25,8 @@ ChunkReader::ChunkReader(
     _hashList(hashList),
     _chunkSize(chunkEncryptor->getPlainChunkSize()),
     _version(decryptionParams.version),
-    _lastChunk(std::nullopt)
+    _lastChunk(std::nullopt),
+    _chunkMap(decryptionParams.chunkMap)
 {
     if(decryptionParams.sizeOnServer != _chunkEncryptor->getEncryptedFileSize(decryptionParams.originalSize)) {
         if (decryptionParams.originalSize != 0) throw FileCorruptedException();
@@ -41,6 +42,15 @@ uint64_t ChunkReader::filePosToPosInFileChunk(uint64_t position) {
 }
 
 std::string ChunkReader::getDecryptedChunk(uint64_t index) {
+    if(_chunkMap.isHole(index)) {
+        // holes are never read from the server, the chunk map is authenticated with the file meta
+        // and the zeroed checksum with the top hash, so the zeros are synthesized here
+        if(_hashList->getHash(index) != std::string(_hashList->getHashSize(), (char)0x00)) {
+            throw InvalidChunkMapException("hole with a checksum of stored data");
+        }
+        // a hole is never the last chunk of the file, so it always has the full size
+        return std::string(_chunkSize, (char)0x00);
+    }
     if(!_lastChunk.has_value() || _lastChunk->index != index) {
         std::string chunk = _chunkDataProvider->getChunk(index, _version);
         std::string plain = _chunkEncryptor->decrypt(index, {.data = chunk, .hmac = _hashList->getHash(index)});
@@ -52,6 +62,7 @@ std::string ChunkReader::getDecryptedChunk(uint64_t index) {
 void ChunkReader::sync(const store::FileDecryptionParams& newParms) {
     _version = newParms.version;
     _lastChunk = std::nullopt;
+    _chunkMap = ChunkMap(newParms.chunkMap);
 }
 
 void ChunkReader::update(int64_t newfileVersion, uint64_t index) {
@@ -60,3 +71,7 @@ void ChunkReader::update(int64_t newfileVersion, uint64_t index) {
         _lastChunk = std::nullopt;
     }
 }
+
+void ChunkReader::updateChunkMap(const ChunkMap& chunkMap) {
+    _chunkMap = chunkMap;
+}
@@ -19,6 +19,7 @@ limitations under the License.
 #include "privmx/endpoint/store/RequestApi.hpp"
 #include "privmx/endpoint/store/StoreException.hpp"
 #include "privmx/endpoint/store/StoreTypes.hpp"
+#include "privmx/endpoint/store/UploadProgressRegistry.hpp"
 
 using namespace privmx::endpoint::store;
 
@@ -128,6 +129,7 @@ void ChunkStreamer::commitFile() {
     commitFileModel.seq = _serverSeq;
     commitFileModel.checksum = _checksums;
     _requestApi->commitFile(commitFileModel);
+    UploadProgressRegistry::recordCommitted(_requestId);
 }
 
 std::string ChunkStreamer::getSeqBE() {
@@ -159,8 +161,38 @@ void ChunkStreamer::sendChunkToServer(std::string&& data) {
     chunkModel.data = Pson::BinaryString(std::move(data));
     _requestApi->sendChunk(chunkModel);
     ++_serverSeq;
+    UploadProgressRegistry::recordChunkSent(_requestId, _serverSeq);
 }
 
 Poco::UInt64 ChunkStreamer::getUploadedFileSize() {
     return _uploadedFileSize;
-}
\ No newline at end of file
+}
+
+ChunkStreamerState ChunkStreamer::getState() const {
+    return ChunkStreamerState{
+        .requestId = _requestId,
+        .key = _key,
+        .fileIndex = _fileIndex,
+        .seq = _seq,
+        .serverSeq = _serverSeq,
+        .dataProcessed = _dataProcessed,
+        .uploadedFileSize = _uploadedFileSize,
+        .checksums = _checksums,
+        .pendingData = _chunkBufferedStream.getBufferedData()
+    };
+}
+
+void ChunkStreamer::restoreState(const ChunkStreamerState& state) {
+    if (state.dataProcessed > _fileSize || state.checksums.size() != (size_t)state.seq * HMAC_SIZE) {
+        throw InvalidUploadCheckpointException();
+    }
+    _requestId = state.requestId;
+    _key = state.key;
+    _fileIndex = state.fileIndex;
+    _seq = state.seq;
+    _serverSeq = state.serverSeq;
+    _dataProcessed = state.dataProcessed;
+    _uploadedFileSize = state.uploadedFileSize;
+    _checksums = state.checksums;
+    _chunkBufferedStream.restore(state.pendingData, state.pendingData.size());
+}
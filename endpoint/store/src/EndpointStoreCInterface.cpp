@@ -39,6 +39,23 @@ int privmx_endpoint_freeStoreApi(StoreApi* ptr) {
     return 1;
 }
 
+int privmx_endpoint_storeWriteToFile(StoreApi* ptr, int64_t fileHandle, privmx_const_buffer dataChunk, int truncate, privmx_error* error) {
+    return CApiExecutor::execBinaryFunc(error, [&]{
+        CApiExecutor::assertNotNull(ptr, "ptr");
+        store::StoreApiVarInterface* _ptr = (store::StoreApiVarInterface*)ptr;
+        _ptr->getApi().writeToFile(fileHandle, CApiExecutor::toCoreBuffer(dataChunk, "dataChunk"), truncate != 0);
+    });
+}
+
+int privmx_endpoint_storeReadFromFile(StoreApi* ptr, int64_t fileHandle, int64_t length, privmx_buffer* outData, privmx_error* error) {
+    return CApiExecutor::execBinaryFunc(error, [&]{
+        CApiExecutor::assertNotNull(ptr, "ptr");
+        CApiExecutor::assertNotNull(outData, "outData");
+        store::StoreApiVarInterface* _ptr = (store::StoreApiVarInterface*)ptr;
+        *outData = CApiExecutor::toBuffer(_ptr->getApi().readFromFile(fileHandle, length));
+    });
+}
+
 int privmx_endpoint_execStoreApi(StoreApi* ptr, int method, const pson_value* args, pson_value** res) {
     return CApiExecutor::execFunc(res, [&]{
         store::StoreApiVarInterface* _ptr = (store::StoreApiVarInterface*)ptr;
@@ -9,6 +9,8 @@ See the License for the specific language governing permissions and
 limitations under the License.
 */
 
+#include <algorithm>
+
 #include "privmx/endpoint/store/FileHandle.hpp"
 
 #include "privmx/endpoint/store/StoreException.hpp"
@@ -109,6 +111,19 @@ void FileReadHandle::seek(uint64_t pos) {
     _pos = pos;
 }
 
+void FileReadHandle::readToFile(LocalFileWriter& output) {
+    if(_size == 0) return;
+    uint64_t chunkSize = _chunkEncryptor->getPlainChunkSize();
+    uint64_t lastIndex = _chunkReader->filePosToFileChunkIndex(_size - 1);
+    for(uint64_t i = 0; i <= lastIndex; i++) {
+        std::string chunk = _chunkReader->getDecryptedChunk(i);
+        if(i * chunkSize + chunk.size() > _size) {
+            chunk.resize(_size - i * chunkSize);
+        }
+        output.writeAt(i * chunkSize, chunk);
+    }
+}
+
 FileWriteHandle::FileWriteHandle(
     int64_t id, 
     const std::string& storeId,
@@ -125,6 +140,7 @@ FileWriteHandle::FileWriteHandle(
     : FileHandle(id, storeId, fileId, resourceId, size, randomWriteSupport),
     _publicMeta(publicMeta),
     _privateMeta(privateMeta),
+    _chunkSize(chunkSize),
     _stream(ChunkBufferedStream(chunkSize, size)),
     _streamer(ChunkStreamer(requestApi, chunkSize, size, serverRequestChunkSize))
 {}
@@ -137,6 +153,23 @@ void FileWriteHandle::write(const std::string& data) {
     _stream.freeFullChunks();
 }
 
+void FileWriteHandle::writeFromFile(LocalFileReader& input) {
+    if(input.getSize() != _size) {
+        throw core::DataDifferentThanDeclaredException();
+    }
+    // reads are a multiple of the chunk size, so the stream never has to carry a partial chunk between them
+    size_t readSize = _chunkSize * LOCAL_FILE_READ_CHUNKS;
+    uint64_t left = input.getSize();
+    while(left > 0) {
+        std::string data = input.read(std::min<uint64_t>(readSize, left));
+        if(data.empty()) {
+            throw core::DataDifferentThanDeclaredException();
+        }
+        left -= data.size();
+        write(data);
+    }
+}
+
 privmx::endpoint::store::ChunksSentInfo FileWriteHandle::finalize() {
     if(!_stream.isFullyFilled()) {
         throw core::DataDifferentThanDeclaredException();
@@ -169,6 +202,30 @@ void FileWriteHandle::setRequestData(const std::string& requestId, const std::st
     _streamer.setRequestData(requestId, key, fileIndex);
 }
 
+ChunkStreamerState FileWriteHandle::getStreamerState() const {
+    return _streamer.getState();
+}
+
+std::string FileWriteHandle::getPendingData() const {
+    return _stream.getBufferedData();
+}
+
+uint64_t FileWriteHandle::getWrittenSize() const {
+    return _stream.getTotalDataSize();
+}
+
+uint64_t FileWriteHandle::getChunkSize() const {
+    return _chunkSize;
+}
+
+void FileWriteHandle::restoreState(const ChunkStreamerState& streamerState, const std::string& pendingData, uint64_t writtenSize) {
+    if(pendingData.size() >= _chunkSize || streamerState.dataProcessed + pendingData.size() != writtenSize) {
+        throw InvalidUploadCheckpointException();
+    }
+    _streamer.restoreState(streamerState);
+    _stream.restore(pendingData, writtenSize);
+}
+
 FileReadWriteHandle::FileReadWriteHandle(
     int64_t id,
     const store::FileInfo &fileInfo,
@@ -42,12 +42,39 @@ FileHandler::FileHandler (
     _fileEncKey(fileEncKey),
     _server(server),
     _plainChunkSize(chunkEncryptor->getPlainChunkSize()),
-    _encryptedChunkSize(chunkEncryptor->getEncryptedChunkSize())
+    _encryptedChunkSize(chunkEncryptor->getEncryptedChunkSize()),
+    _chunkMap(fileMeta.internalFileMeta.chunkMap)
 {}
 
 void FileHandler::write(uint64_t offset, const core::Buffer& data, bool truncate) { // data = buf + size
-    auto toSend = data.stdString();
-    if (_plainfileSize < offset) { 
+    if (_writeBackBufferSize > 0 && !truncate && !createsHole(offset)) {
+        writeBuffered(offset, data.stdString());
+        if (_dirtyChunks.size() * _plainChunkSize > _writeBackBufferSize) {
+            flush();
+        }
+        return;
+    }
+    // pending writes go first, so the direct write is applied on top of them
+    flush();
+    writeDirect(offset, data.stdString(), truncate);
+}
+
+void FileHandler::writeDirect(uint64_t offset, const std::string& data, bool truncate) {
+    auto toSend = data;
+    std::vector<FileHandler::UpdateChunkData> chunksToUpdate;
+    bool holes = createsHole(offset);
+    if (holes) {
+        // whole chunks between the end of file and offset are left as holes, only the current last chunk is filled with 0
+        auto holeFrom = (_plainfileSize + _plainChunkSize - 1) / _plainChunkSize;
+        auto holeTo = offset / _plainChunkSize;
+        if (_plainfileSize % _plainChunkSize != 0) {
+            auto chunkOffset = _plainfileSize % _plainChunkSize;
+            chunksToUpdate.push_back(createUpdateChunk(holeFrom - 1, chunkOffset, std::string(_plainChunkSize - chunkOffset, (char)0x00)));
+        }
+        for(auto i = holeFrom; i < holeTo; i++) {
+            chunksToUpdate.push_back(createHoleChunk(i));
+        }
+    } else if (_plainfileSize < offset) { 
         // if fileSize smaller than offset fill here empty space with 0
         auto emptyChars = std::string(offset - _plainfileSize, (char)0x00);
         offset = _plainfileSize;
@@ -57,7 +84,6 @@ void FileHandler::write(uint64_t offset, const core::Buffer& data, bool truncate
     auto startIndex = _chunkReader->filePosToFileChunkIndex(offset);
     auto stopIndex = _chunkReader->filePosToFileChunkIndex(offset+toSend.size() - (data.size() == 0 ? 0 : 1));
     uint64_t dataSend = 0;
-    std::vector<FileHandler::UpdateChunkData> chunksToUpdate;
     auto newPlainfileSize = _plainfileSize;
     auto newEncryptedFileSize = _encryptedFileSize;
     // prepare chunk to update
@@ -74,14 +100,92 @@ void FileHandler::write(uint64_t offset, const core::Buffer& data, bool truncate
             dataSend += chunkData.size();
         }
     }
+    for(auto& updateInfo : chunksToUpdate) {
+        newPlainfileSize += updateInfo.plainfileSizeChange;
+        newEncryptedFileSize += updateInfo.encryptedFileSizeChange;
+    }
+    if (holes) {
+        // the chunk written after the holes is stored at its position, past the previous end of the file on the server
+        newEncryptedFileSize = _chunkEncryptor->getEncryptedFileSize(newPlainfileSize);
+    }
+    commitUpdateChunks(chunksToUpdate, newPlainfileSize, newEncryptedFileSize, truncate);
+}
+
+void FileHandler::writeBuffered(uint64_t offset, const std::string& data) {
+    auto fileSize = getFileSize();
+    auto toWrite = data;
+    if (fileSize < offset) {
+        // if fileSize smaller than offset fill here empty space with 0
+        toWrite = std::string(offset - fileSize, (char)0x00) + toWrite;
+        offset = fileSize;
+    }
+    if (toWrite.empty()) {
+        return;
+    }
+    if (_dirtyChunks.empty()) {
+        _bufferedFileSize = _plainfileSize;
+    }
+    auto startIndex = _chunkReader->filePosToFileChunkIndex(offset);
+    auto stopIndex = _chunkReader->filePosToFileChunkIndex(offset + toWrite.size() - 1);
+    uint64_t dataWritten = 0;
+    for(auto i = startIndex; i <= stopIndex; i++) {
+        uint64_t chunkOffset = (i == startIndex) ? offset % _plainChunkSize : 0;
+        auto chunkData = toWrite.substr(dataWritten, _plainChunkSize - chunkOffset);
+        auto it = _dirtyChunks.find(i);
+        std::string chunk = (it != _dirtyChunks.end()) ? it->second : getCurrentPlainChunk(i);
+        if (chunk.size() < chunkOffset + chunkData.size()) {
+            chunk.resize(chunkOffset + chunkData.size(), (char)0x00);
+        }
+        chunk.replace(chunkOffset, chunkData.size(), chunkData);
+        _dirtyChunks[i] = std::move(chunk);
+        dataWritten += chunkData.size();
+    }
+    _bufferedFileSize = std::max(_bufferedFileSize, offset + toWrite.size());
+}
+
+bool FileHandler::createsHole(uint64_t offset) {
+    auto fileSize = getFileSize();
+    if (offset <= fileSize) {
+        return false;
+    }
+    return (fileSize + _plainChunkSize - 1) / _plainChunkSize < offset / _plainChunkSize;
+}
+
+FileHandler::UpdateChunkData FileHandler::createHoleChunk(uint64_t index) {
+    // a hole has no data on the server, its checksum is zeroed and it reads as a chunk of 0,
+    // it does not change the encrypted size, which follows from the position of the data written after it
+    return FileHandler::UpdateChunkData{
+        store::IChunkEncryptor::Chunk{.data = std::string(), .hmac = std::string(_hashList->getHashSize(), (char)0x00)},
+        index,
+        (int64_t)_plainChunkSize,
+        0,
+        true
+    };
+}
+
+std::string FileHandler::getCurrentPlainChunk(uint64_t index) {
+    if (index * _plainChunkSize >= _plainfileSize) {
+        return std::string();
+    }
+    return _chunkReader->getDecryptedChunk(index);
+}
+
+void FileHandler::commitUpdateChunks(const std::vector<UpdateChunkData>& chunksToUpdate, uint64_t newPlainfileSize, uint64_t newEncryptedFileSize, bool truncate) {
     // prepare meta ChunksToUpdate and rollback HashList
     auto oldHashList = _hashList->getAll();
+    auto newChunkMap = _chunkMap;
     for(size_t i = 0; i < chunksToUpdate.size(); i++) {
-        //update _hashList, newPlainfileSize, newEncryptedFileSize
+        //update _hashList, newChunkMap
         auto& updateInfo = chunksToUpdate.at(i);
         _hashList->set(updateInfo.chunkIndex, updateInfo.chunk.hmac, i == chunksToUpdate.size()-1 ? truncate : false);
-        newPlainfileSize += updateInfo.plainfileSizeChange;
-        newEncryptedFileSize += updateInfo.encryptedFileSizeChange;
+        if (updateInfo.hole) {
+            newChunkMap.addHole(updateInfo.chunkIndex, updateInfo.chunkIndex + 1);
+        } else {
+            newChunkMap.fill(updateInfo.chunkIndex);
+        }
+    }
+    if (truncate && !chunksToUpdate.empty()) {
+        newChunkMap.truncate(chunksToUpdate.back().chunkIndex + 1);
     }
     // squash chunksToUpdate 
     auto squashedChunksToUpdate = createListOfUpdateChangesFromUpdateChunkData(chunksToUpdate);
@@ -93,6 +197,11 @@ void FileHandler::write(uint64_t offset, const core::Buffer& data, bool truncate
     };
     newFileMeta.internalFileMeta.hmac = utils::Base64::from(_hashList->getTopHash());
     newFileMeta.internalFileMeta.size = newPlainfileSize;
+    newFileMeta.internalFileMeta.chunkMap = newChunkMap.toInternalMeta();
+    if (newFileMeta.internalFileMeta.chunkMap.has_value()) {
+        // readers without sparse file support must refuse the file instead of reading the holes from the server
+        newFileMeta.internalFileMeta.version = ChunkMap::SPARSE_FILE_META_VERSION;
+    }
     auto newMeta = _fileMetaEncryptor->encrypt(_fileInfo, newFileMeta, _fileEncKey, _fileEncKey.dataStructureVersion);
     try {
         updateOnServer(squashedChunksToUpdate, newMeta, _fileEncKey.id, truncate);
@@ -110,28 +219,63 @@ void FileHandler::write(uint64_t offset, const core::Buffer& data, bool truncate
     _fileMeta = newFileMeta;
     _plainfileSize = newPlainfileSize;
     _encryptedFileSize = newEncryptedFileSize;
+    _chunkMap = newChunkMap;
+    _chunkReader->updateChunkMap(_chunkMap);
     for(auto& updateInfo : chunksToUpdate) {
-        _chunkDataProvider->update(_version, updateInfo.chunkIndex, updateInfo.chunk.data, _encryptedFileSize, truncate);
+        if (!updateInfo.hole) {
+            _chunkDataProvider->update(_version, updateInfo.chunkIndex, updateInfo.chunk.data, _encryptedFileSize, truncate);
+        }
         _chunkReader->update(_version, updateInfo.chunkIndex);
     }
     PRIVMX_DEBUG("FileHandler", "write", "_plainfileSize: " + std::to_string(_plainfileSize)+ " | _encryptedFileSize: " + std::to_string(_encryptedFileSize)); 
 }
 
 core::Buffer FileHandler::read(uint64_t offset, uint64_t size) {
-    if(offset >= _plainfileSize) return core::Buffer();
-    if(offset+size > _plainfileSize) size = _plainfileSize-offset;
+    auto fileSize = getFileSize();
+    if(offset >= fileSize) return core::Buffer();
+    if(offset+size > fileSize) size = fileSize-offset;
     if(size == 0) return core::Buffer();
     auto startIndex = _chunkReader->filePosToFileChunkIndex(offset);
     auto stopIndex = _chunkReader->filePosToFileChunkIndex(offset+size-1);
     std::string data = std::string();
     for(auto i = startIndex; i <= stopIndex; i++) {
-        data.append(_chunkReader->getDecryptedChunk(i));
+        // pending writes take precedence over the data on the server
+        auto it = _dirtyChunks.find(i);
+        data.append(it != _dirtyChunks.end() ? it->second : _chunkReader->getDecryptedChunk(i));
     }
-    return core::Buffer::from( data.substr(_chunkReader->filePosToPosInFileChunk(offset), size) );
+    // the requested range is cut out of the decrypted chunks in place, without allocating a copy
+    data.resize(_chunkReader->filePosToPosInFileChunk(offset) + size);
+    data.erase(0, _chunkReader->filePosToPosInFileChunk(offset));
+    return core::Buffer::from(std::move(data));
 }
 
 uint64_t FileHandler::getFileSize() {
-    return _plainfileSize;
+    return _dirtyChunks.empty() ? _plainfileSize : _bufferedFileSize;
+}
+
+void FileHandler::close() {
+    flush();
+}
+
+void FileHandler::flush() {
+    if (_dirtyChunks.empty()) {
+        return;
+    }
+    std::vector<FileHandler::UpdateChunkData> chunksToUpdate;
+    for(const auto& [index, plainChunk] : _dirtyChunks) {
+        chunksToUpdate.push_back(FileHandler::UpdateChunkData{_chunkEncryptor->encrypt(index, plainChunk), index, 0, 0});
+    }
+    auto newPlainfileSize = _bufferedFileSize;
+    commitUpdateChunks(chunksToUpdate, newPlainfileSize, _chunkEncryptor->getEncryptedFileSize(newPlainfileSize), false);
+    // buffered writes are kept until the server accepts them, so a failed flush can be retried
+    _dirtyChunks.clear();
+}
+
+void FileHandler::setWriteBackBufferSize(uint64_t bufferSize) {
+    _writeBackBufferSize = bufferSize;
+    if (_writeBackBufferSize == 0 || _dirtyChunks.size() * _plainChunkSize > _writeBackBufferSize) {
+        flush();
+    }
 }
 
 FileHandler::UpdateChunkData FileHandler::createUpdateChunk(uint64_t index, uint64_t chunkOffset, const std::string& data, bool truncate){
@@ -143,10 +287,18 @@ FileHandler::UpdateChunkData FileHandler::createUpdateChunk(uint64_t index, uint
     }
     std::string newChunk = std::string();
     // read old chunk
-    std::string prevEncryptedChunk = _chunkDataProvider->getChunk(index, _version);
     std::string prevChunk = "";
-    if(prevEncryptedChunk.size() != 0) {
-        prevChunk = _chunkEncryptor->decrypt(index, {.data = prevEncryptedChunk, .hmac = _hashList->getHash(index)});
+    uint64_t prevEncryptedChunkSize = 0;
+    if(_chunkMap.isHole(index)) {
+        // hole is already counted in the file size
+        prevChunk = std::string(_plainChunkSize, (char)0x00);
+        prevEncryptedChunkSize = _encryptedChunkSize;
+    } else if(index * _plainChunkSize < _plainfileSize) {
+        std::string prevEncryptedChunk = _chunkDataProvider->getChunk(index, _version);
+        if(prevEncryptedChunk.size() != 0) {
+            prevChunk = _chunkEncryptor->decrypt(index, {.data = prevEncryptedChunk, .hmac = _hashList->getHash(index)});
+        }
+        prevEncryptedChunkSize = prevEncryptedChunk.size();
     }
     // fill new chunk data to chunkOffset
     if(chunkOffset > 0) {
@@ -169,7 +321,7 @@ FileHandler::UpdateChunkData FileHandler::createUpdateChunk(uint64_t index, uint
         chunk,
         index,
         truncate ? (int64_t)(index * _plainChunkSize + newChunk.size()) - std::max((int64_t)_plainfileSize, (int64_t)(index * _plainChunkSize)) : (int64_t)newChunk.size() - (int64_t)prevChunk.size(),
-        truncate ? (int64_t)(index * _encryptedChunkSize + chunk.data.size()) - std::max((int64_t)_encryptedFileSize, (int64_t)(index * _encryptedChunkSize)) : (int64_t)chunk.data.size() - (int64_t)prevEncryptedChunk.size()
+        truncate ? (int64_t)(index * _encryptedChunkSize + chunk.data.size()) - std::max((int64_t)_encryptedFileSize, (int64_t)(index * _encryptedChunkSize)) : (int64_t)chunk.data.size() - (int64_t)prevEncryptedChunkSize
     };
 }
 
@@ -191,8 +343,10 @@ void FileHandler::updateOnServer(const std::vector<FileHandler::UpdateChanges>&
                 .data = updatedChunk.checksum,
                 .truncate = (i == updatedChunks.size()-1 ? truncate : true),
             };
-
-            operations.push_back(operation1);
+            // holes not followed by data in the same change send no empty file operation past the end of the file
+            if (!updatedChunk.holes) {
+                operations.push_back(operation1);
+            }
             operations.push_back(operation2);
         }
 
@@ -209,6 +363,10 @@ void FileHandler::updateOnServer(const std::vector<FileHandler::UpdateChanges>&
 }
 
 void FileHandler::sync(const FileMeta& fileMeta, const store::FileDecryptionParams& newParms, const core::DecryptedEncKey& fileEncKey) {
+    if (!_dirtyChunks.empty()) {
+        // pending writes would be lost, they have to be flushed before the newest version is taken from the server
+        throw FileRandomWriteInternalException("Cannot sync file with pending writes");
+    }
     _hashList->sync(newParms.key, newParms.hmac, _chunkDataProvider->getCurrentChecksumsFromBridge());
     _chunkDataProvider->sync(_version, _encryptedFileSize);
     _chunkReader->sync(newParms);
@@ -217,34 +375,38 @@ void FileHandler::sync(const FileMeta& fileMeta, const store::FileDecryptionPara
     _plainfileSize = newParms.originalSize;
     _encryptedFileSize = newParms.sizeOnServer;
     _fileEncKey = fileEncKey;
+    _chunkMap = ChunkMap(fileMeta.internalFileMeta.chunkMap);
 }
 
 std::vector<FileHandler::UpdateChanges> FileHandler::createListOfUpdateChangesFromUpdateChunkData(const std::vector<FileHandler::UpdateChunkData>& updatedChunks) {
-    if(updatedChunks.size() == 0) {
-        return std::vector<FileHandler::UpdateChanges>();
-    }
-    auto updatedChunk = updatedChunks.begin();
-    std::vector<FileHandler::UpdateChanges> result = {FileHandler::UpdateChanges{
-        updatedChunk->chunk.data,
-        updatedChunk->chunkIndex*_encryptedChunkSize,
-        updatedChunk->chunk.hmac,
-        updatedChunk->chunkIndex*_hashList->getHashSize()
-    }};
-    for(updatedChunk++; updatedChunk != updatedChunks.end(); updatedChunk++) {
-        auto& squashedChanges = result.back();
-        if (squashedChanges.dataPos + squashedChanges.data.size() == updatedChunk->chunkIndex*_encryptedChunkSize && 
-            squashedChanges.data.size() + updatedChunk->chunk.data.size() < SERVER_OPERATION_SIZE_LIMIT
-        ) {
-            squashedChanges.data += updatedChunk->chunk.data;
-            squashedChanges.checksum += updatedChunk->chunk.hmac;
-        } else {
-            result.push_back(FileHandler::UpdateChanges{
-                updatedChunk->chunk.data,
-                updatedChunk->chunkIndex*_encryptedChunkSize,
-                updatedChunk->chunk.hmac,
-                updatedChunk->chunkIndex*_hashList->getHashSize()
-            });
+    std::vector<FileHandler::UpdateChanges> result;
+    for(auto updatedChunk = updatedChunks.begin(); updatedChunk != updatedChunks.end(); updatedChunk++) {
+        // hole sends only its checksum, its data position is set to the end of the hole,
+        // so the chunk written after a run of holes is squashed with it
+        auto dataPos = (updatedChunk->chunkIndex + (updatedChunk->hole ? 1 : 0)) * _encryptedChunkSize;
+        if(!result.empty()) {
+            auto& squashedChanges = result.back();
+            bool contiguous = squashedChanges.dataPos + squashedChanges.data.size() == updatedChunk->chunkIndex*_encryptedChunkSize &&
+                squashedChanges.checksum.size() + updatedChunk->chunk.hmac.size() < SERVER_OPERATION_SIZE_LIMIT;
+            if (contiguous && updatedChunk->hole && squashedChanges.data.size() == 0) {
+                squashedChanges.dataPos = dataPos;
+                squashedChanges.checksum += updatedChunk->chunk.hmac;
+                continue;
+            }
+            if (contiguous && !updatedChunk->hole && squashedChanges.data.size() + updatedChunk->chunk.data.size() < SERVER_OPERATION_SIZE_LIMIT) {
+                squashedChanges.data += updatedChunk->chunk.data;
+                squashedChanges.checksum += updatedChunk->chunk.hmac;
+                squashedChanges.holes = false;
+                continue;
+            }
         }
+        result.push_back(FileHandler::UpdateChanges{
+            updatedChunk->chunk.data,
+            dataPos,
+            updatedChunk->chunk.hmac,
+            updatedChunk->chunkIndex*_hashList->getHashSize(),
+            updatedChunk->hole
+        });
     }
     return result;
 }
@@ -256,16 +418,12 @@ uint64_t FileHandlerImpl::size() {
 }
 
 void FileHandlerImpl::seekg(const uint64_t pos) {
-    if (pos > _file->getFileSize()) {
-        throw PosOutOfBoundsException("seekg out of bounds");
-    }
+    // positions past the end of file are allowed, reads there return no data
     _readPos = pos;
 }
 
 void FileHandlerImpl::seekp(const uint64_t pos) {
-    if (pos > _file->getFileSize()) {
-        throw PosOutOfBoundsException("seekg out of bounds");
-    }
+    // positions past the end of file are allowed, the gap is written as zeros or as holes
     _writePos = pos;
 }
 
@@ -0,0 +1,119 @@
+/*
+PrivMX Endpoint.
+Copyright © 2024 Simplito sp. z o.o.
+
+This file is part of the PrivMX Platform (https://privmx.dev).
+This software is Licensed under the PrivMX Free License.
+
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "privmx/endpoint/store/LocalFile.hpp"
+#include "privmx/endpoint/store/StoreException.hpp"
+
+using namespace privmx::endpoint::store;
+
+LocalFileReader::LocalFileReader(const std::string& path) : _path(path), _fd(-1), _size(0) {
+    _fd = ::open(path.c_str(), O_RDONLY);
+    if (_fd < 0) {
+        throw LocalFileOpenFailedException(path + ": " + std::strerror(errno));
+    }
+    struct stat st;
+    if (::fstat(_fd, &st) != 0) {
+        int err = errno;
+        close();
+        throw LocalFileReadFailedException(path + ": " + std::strerror(err));
+    }
+    _size = (uint64_t)st.st_size;
+#ifdef POSIX_FADV_SEQUENTIAL
+    ::posix_fadvise(_fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+}
+
+LocalFileReader::~LocalFileReader() {
+    close();
+}
+
+uint64_t LocalFileReader::getSize() const {
+    return _size;
+}
+
+std::string LocalFileReader::read(size_t length) {
+    std::string result(length, 0);
+    size_t done = 0;
+    while (done < length) {
+        ssize_t n = ::read(_fd, result.data() + done, length - done);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            throw LocalFileReadFailedException(_path + ": " + std::strerror(errno));
+        }
+        if (n == 0) break;
+        done += (size_t)n;
+    }
+    result.resize(done);
+    return result;
+}
+
+void LocalFileReader::close() {
+    if (_fd >= 0) {
+        ::close(_fd);
+        _fd = -1;
+    }
+}
+
+LocalFileWriter::LocalFileWriter(const std::string& path, uint64_t size) : _path(path), _fd(-1) {
+    _fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (_fd < 0) {
+        throw LocalFileOpenFailedException(path + ": " + std::strerror(errno));
+    }
+    // set the final size up front, so chunks can be placed at their offsets in any order
+    if (::ftruncate(_fd, (off_t)size) != 0) {
+        int err = errno;
+        discard();
+        throw LocalFileWriteFailedException(path + ": " + std::strerror(err));
+    }
+}
+
+LocalFileWriter::~LocalFileWriter() {
+    if (_fd >= 0) {
+        ::close(_fd);
+    }
+}
+
+void LocalFileWriter::writeAt(uint64_t offset, const std::string& data) {
+    size_t done = 0;
+    while (done < data.size()) {
+        ssize_t n = ::pwrite(_fd, data.data() + done, data.size() - done, (off_t)(offset + done));
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            throw LocalFileWriteFailedException(_path + ": " + std::strerror(errno));
+        }
+        done += (size_t)n;
+    }
+}
+
+void LocalFileWriter::close() {
+    if (_fd >= 0) {
+        int res = ::close(_fd);
+        _fd = -1;
+        if (res != 0) {
+            throw LocalFileWriteFailedException(_path + ": " + std::strerror(errno));
+        }
+    }
+}
+
+void LocalFileWriter::discard() {
+    if (_fd >= 0) {
+        ::close(_fd);
+        _fd = -1;
+    }
+    std::remove(_path.c_str());
+}
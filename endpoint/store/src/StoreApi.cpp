@@ -97,6 +97,37 @@ void StoreApi::updateStore(
 }
 
 
+void StoreApi::addStoreMembers(
+    const std::string& storeId,
+    const std::vector<core::UserWithPubKey>& users,
+    const std::vector<core::UserWithPubKey>& managers
+) {
+    auto impl = getImpl();
+    core::Validator::validateId(storeId, "field:storeId ");
+    core::Validator::validateClass<std::vector<core::UserWithPubKey>>(users, "field:users ");
+    core::Validator::validateClass<std::vector<core::UserWithPubKey>>(managers, "field:managers ");
+    try {
+        impl->addStoreMembers(storeId, users, managers);
+    } catch (const privmx::utils::PrivmxException& e) {
+        core::ExceptionConverter::rethrowAsCoreException(e);
+        throw core::Exception("ExceptionConverter rethrow error");
+    }
+}
+
+void StoreApi::removeStoreMembers(const std::string& storeId, const std::vector<std::string>& userIds) {
+    auto impl = getImpl();
+    core::Validator::validateId(storeId, "field:storeId ");
+    for (const auto& userId : userIds) {
+        core::Validator::validateId(userId, "field:userIds ");
+    }
+    try {
+        impl->removeStoreMembers(storeId, userIds);
+    } catch (const privmx::utils::PrivmxException& e) {
+        core::ExceptionConverter::rethrowAsCoreException(e);
+        throw core::Exception("ExceptionConverter rethrow error");
+    }
+}
+
 void StoreApi::deleteStore(const std::string& storeId) {
     auto impl = getImpl();
     core::Validator::validateId(storeId, "field:storeId ");
@@ -230,6 +261,19 @@ File StoreApi::getFile(const std::string& fileId) {
     }
 }
 
+core::Future<File> StoreApi::getFileAsync(const std::string& fileId, const core::AsyncCallOptions& options) {
+    auto impl = getImpl();
+    core::Validator::validateId(fileId, "field:fileId ");
+    return impl->getAsyncRequestQueue()->submit<File>([impl, fileId]() {
+        try {
+            return impl->getFile(fileId);
+        } catch (const privmx::utils::PrivmxException& e) {
+            core::ExceptionConverter::rethrowAsCoreException(e);
+            throw core::Exception("ExceptionConverter rethrow error");
+        }
+    }, options);
+}
+
 core::PagingList<File> StoreApi::listFiles(const std::string& storeId, const core::PagingQuery& listQuery) {
     auto impl = getImpl();
     core::Validator::validateId(storeId, "field:storeId ");
@@ -242,6 +286,21 @@ core::PagingList<File> StoreApi::listFiles(const std::string& storeId, const cor
     }
 }
 
+core::Cursor<File> StoreApi::openFileCursor(const std::string& storeId, const core::PagingQuery& pagingQuery, int64_t pagesAhead) {
+    auto impl = getImpl();
+    core::Validator::validateId(storeId, "field:storeId ");
+    core::Validator::validatePagingQuery(pagingQuery, {"createDate", "updates"}, "field:pagingQuery ");
+    core::Validator::validateNumberPositive(pagingQuery.limit, "field:pagingQuery.limit ");
+    core::Validator::validateNumberPositive(pagesAhead, "field:pagesAhead ");
+    return core::Cursor<File>(std::make_shared<core::PrefetchingCursor<File>>(
+        [impl, storeId](const core::PagingQuery& query) {
+            return impl->fetchFilesPage(storeId, query);
+        },
+        pagingQuery,
+        pagesAhead
+    ));
+}
+
 void StoreApi::updateFileMeta(const std::string& fileId, const core::Buffer& publicMeta, const core::Buffer& privateMeta) {
     auto impl = getImpl();
     core::Validator::validateId(fileId, "field:fileId ");
@@ -263,6 +322,70 @@ void StoreApi::syncFile(const int64_t handle) {
     }
 }
 
+void StoreApi::downloadFileToPath(const std::string& fileId, const std::string& filePath) {
+    auto impl = getImpl();
+    core::Validator::validateId(fileId, "field:fileId ");
+    try {
+        return impl->downloadFileToPath(fileId, filePath);
+    } catch (const privmx::utils::PrivmxException& e) {
+        core::ExceptionConverter::rethrowAsCoreException(e);
+        throw core::Exception("ExceptionConverter rethrow error");
+    }
+}
+
+std::string StoreApi::uploadFileFromPath(const std::string& storeId, const core::Buffer& publicMeta, const core::Buffer& privateMeta,
+                            const std::string& filePath, bool randomWriteSupport) {
+    auto impl = getImpl();
+    core::Validator::validateId(storeId, "field:storeId ");
+    try {
+        return impl->uploadFileFromPath(storeId, publicMeta, privateMeta, filePath, randomWriteSupport);
+    } catch (const privmx::utils::PrivmxException& e) {
+        core::ExceptionConverter::rethrowAsCoreException(e);
+        throw core::Exception("ExceptionConverter rethrow error");
+    }
+}
+
+void StoreApi::enableUploadProgressJournal(const std::string& directory) {
+    auto impl = getImpl();
+    try {
+        impl->enableUploadProgressJournal(directory);
+    } catch (const privmx::utils::PrivmxException& e) {
+        core::ExceptionConverter::rethrowAsCoreException(e);
+        throw core::Exception("ExceptionConverter rethrow error");
+    }
+}
+
+UploadCheckpoint StoreApi::getUploadCheckpoint(const int64_t handle) {
+    auto impl = getImpl();
+    try {
+        return impl->getUploadCheckpoint(handle);
+    } catch (const privmx::utils::PrivmxException& e) {
+        core::ExceptionConverter::rethrowAsCoreException(e);
+        throw core::Exception("ExceptionConverter rethrow error");
+    }
+}
+
+int64_t StoreApi::resumeUpload(const core::Buffer& checkpoint) {
+    auto impl = getImpl();
+    try {
+        return impl->resumeUpload(checkpoint);
+    } catch (const privmx::utils::PrivmxException& e) {
+        core::ExceptionConverter::rethrowAsCoreException(e);
+        throw core::Exception("ExceptionConverter rethrow error");
+    }
+}
+
+void StoreApi::setWriteBackBufferSize(const int64_t handle, const int64_t bufferSize) {
+    auto impl = getImpl();
+    core::Validator::validateNumberNonNegative(bufferSize, "field:bufferSize ");
+    try {
+        impl->setWriteBackBufferSize(handle, bufferSize);
+    } catch (const privmx::utils::PrivmxException& e) {
+        core::ExceptionConverter::rethrowAsCoreException(e);
+        throw core::Exception("ExceptionConverter rethrow error");
+    }
+}
+
 std::vector<std::string> StoreApi::subscribeFor(const std::vector<std::string>& subscriptionQueries) {
     auto impl = getImpl();
     try {
@@ -36,6 +36,7 @@ limitations under the License.
 #include "privmx/endpoint/store/interfaces/IChunkDataProvider.hpp"
 #include "privmx/endpoint/store/ChunkDataProvider.hpp"
 #include "privmx/endpoint/store/ChunkReader.hpp"
+#include "privmx/endpoint/store/UploadProgressRegistry.hpp"
 #include <privmx/endpoint/core/ConvertedExceptions.hpp>
 #include "privmx/endpoint/core/Mapper.hpp"
 #include "privmx/endpoint/core/EventBuilder.hpp"
@@ -66,6 +67,7 @@ StoreApiImpl::StoreApiImpl(
     _eventMiddleware(eventMiddleware),
     _handleManager(handleManager),
     _connection(connection),
+    _containerMembersUpdater(_connection.getImpl()->getContainerMembersUpdater()),
     _serverRequestChunkSize(serverRequestChunkSize),
 
     _fileHandleManager(FileHandleManager(handleManager, "Store")),
@@ -75,15 +77,21 @@ StoreApiImpl::StoreApiImpl(
     _subscriber(connection.getImpl()->getGateway(), STORE_TYPE_FILTER_FLAG),
     _fileMetaEncryptorV4(FileMetaEncryptorV4())
 {
+    _fileMetaEncryptorV5.setCompressor(_connection.getImpl()->getDataCompressor());
+    _storeDataEncryptorV5.setCompressor(_connection.getImpl()->getDataCompressor());
     _notificationListenerId = _eventMiddleware->addNotificationEventListener(std::bind(&StoreApiImpl::processNotificationEvent, this, std::placeholders::_1, std::placeholders::_2));
     _connectedListenerId = _eventMiddleware->addConnectedEventListener(std::bind(&StoreApiImpl::processConnectedEvent, this));
     _disconnectedListenerId = _eventMiddleware->addDisconnectedEventListener(std::bind(&StoreApiImpl::processDisconnectedEvent, this));
+    _containerMembersHandlerId = _containerMembersUpdater->addHandler(
+        "store", std::bind(&StoreApiImpl::updateStoreMembers, this, std::placeholders::_1, std::placeholders::_2)
+    );
 }
 
 StoreApiImpl::~StoreApiImpl() {
     _eventMiddleware->removeNotificationEventListener(_notificationListenerId);
     _eventMiddleware->removeConnectedEventListener(_connectedListenerId);
     _eventMiddleware->removeDisconnectedEventListener(_disconnectedListenerId);
+    _containerMembersUpdater->removeHandler(_containerMembersHandlerId);
     _guardedExecutor.reset();
     LOG_TRACE("~StoreApiImpl Done");
 }
@@ -171,11 +179,65 @@ void StoreApiImpl::updateStore(
         const bool forceGenerateNewKey,
         const std::optional<core::ContainerPolicy>& policies
 ) {
-    PRIVMX_DEBUG_TIME_START(PlatformStore, storeUpdate)
+    server::StoreGetModel getModel;
+    getModel.storeId = storeId;
+    auto currentStore {_serverApi->storeGet(getModel).store};
+    updateStoreRequest(currentStore, [&](const core::DecryptedEncKeyV2& currentStoreKey) {
+        return core::UsersKeysResolver::create(currentStore, users, managers, forceGenerateNewKey, currentStoreKey);
+    }, publicMeta, privateMeta, version, force, policies);
+}
 
+void StoreApiImpl::addStoreMembers(
+        const std::string& storeId,
+        const std::vector<core::UserWithPubKey>& users,
+        const std::vector<core::UserWithPubKey>& managers
+) {
+    updateStoreMembers(storeId, _containerMembersUpdater->createDelta(users, managers, {}));
+}
+
+void StoreApiImpl::removeStoreMembers(const std::string& storeId, const std::vector<std::string>& userIds) {
+    updateStoreMembers(storeId, _containerMembersUpdater->createDelta({}, {}, userIds));
+}
+
+void StoreApiImpl::updateStoreMembers(const std::string& storeId, const core::ContainerMembersDelta& delta) {
     server::StoreGetModel getModel;
     getModel.storeId = storeId;
     auto currentStore {_serverApi->storeGet(getModel).store};
+    auto store = validateDecryptAndConvertStoreDataToStore(currentStore);
+    if(store.statusCode != 0) {
+        throw StoreDataIntegrityException("Store data statusCode: " + std::to_string(store.statusCode));
+    }
+    try {
+        updateStoreRequest(currentStore, [&](const core::DecryptedEncKeyV2& currentStoreKey) {
+            return core::UsersKeysResolver::createFromDelta(
+                currentStore.users, currentStore.managers, delta.usersToAdd, delta.managersToAdd, delta.userIdsToRemove, currentStoreKey,
+                [&](const std::vector<std::string>& userIds) { return delta.getContextUsersPubKeys(currentStore.contextId, userIds); }
+            );
+        }, store.publicMeta, store.privateMeta, currentStore.version, false, std::nullopt);
+    } catch (const privmx::utils::PrivmxException&) {
+        // the update is rejected when the Store has been modified since it was fetched
+        std::optional<int64_t> version;
+        try {
+            version = _serverApi->storeGet(getModel).store.version;
+        } catch (...) {}
+        if(version.has_value() && version.value() != currentStore.version) {
+            throw core::ContainerVersionConflictException();
+        }
+        throw;
+    }
+}
+
+void StoreApiImpl::updateStoreRequest(
+        const server::Store& currentStore,
+        const std::function<std::shared_ptr<core::UsersKeysResolver>(const core::DecryptedEncKeyV2&)>& createUsersKeysResolver,
+        const core::Buffer& publicMeta,
+        const core::Buffer& privateMeta,
+        const int64_t version,
+        const bool force,
+        const std::optional<core::ContainerPolicy>& policies
+) {
+    PRIVMX_DEBUG_TIME_START(PlatformStore, storeUpdate)
+    const auto& storeId = currentStore.id;
     auto currentStoreEntry = currentStore.data.back();
     auto currentStoreResourceId = currentStore.resourceId.has_value() ? currentStore.resourceId.value() : core::EndpointUtils::generateId();
     auto location {getModuleEncKeyLocation(currentStore, currentStoreResourceId)};
@@ -183,7 +245,7 @@ void StoreApiImpl::updateStore(
     auto currentStoreKey {findEncKeyByKeyId(storeKeys, currentStoreEntry.keyId)};
     auto storeInternalMeta = extractAndDecryptModuleInternalMeta(currentStoreEntry, currentStoreKey);
 
-    auto usersKeysResolver {core::UsersKeysResolver::create(currentStore, users, managers, forceGenerateNewKey, currentStoreKey)};
+    auto usersKeysResolver {createUsersKeysResolver(currentStoreKey)};
 
     if(!_keyProvider->verifyKeysSecret(storeKeys, location, storeInternalMeta.secret)) {
         throw StoreEncryptionKeyValidationException();
@@ -203,10 +265,12 @@ void StoreApiImpl::updateStore(
         );
     }
 
+    // new users get only the newest key, the older ones are reachable through the key chain
+    auto keyChain {_keyProvider->prepareKeyChain(storeInternalMeta.keyChain, storeKeys, currentStoreKey, storeKey)};
     auto usersToAddMissingKey {usersKeysResolver->getUsersToAddKey()};
     if(usersToAddMissingKey.size() > 0) {
         auto tmp = _keyProvider->prepareMissingKeysForNewUsers(
-            storeKeys,
+            _keyProvider->getKeysOutsideKeyChain(storeKeys, keyChain, storeKey.id),
             usersToAddMissingKey,
             updateStoreDio,
             location,
@@ -216,20 +280,12 @@ void StoreApiImpl::updateStore(
     }
 
     server::StoreUpdateModel model;
-    std::vector<std::string> usersList;
-    for (auto user: users) {
-        usersList.push_back(user.userId);
-    }
-    std::vector<std::string> managersList;
-    for (auto x: managers) {
-        managersList.push_back(x.userId);
-    }
     model.id = storeId;
     model.resourceId = currentStoreResourceId;
     model.keyId = storeKey.id;
     model.keys = keys;
-    model.users = usersList;
-    model.managers = managersList;
+    model.users = usersKeysResolver->getUserIds();
+    model.managers = usersKeysResolver->getManagerIds();
     model.version = version;
     model.force = force;
     if (policies.has_value()) {
@@ -238,14 +294,24 @@ void StoreApiImpl::updateStore(
     core::ModuleDataToEncryptV5 storeDataToEncrypt {
         .publicMeta = publicMeta,
         .privateMeta = privateMeta,
-        .internalMeta = core::ModuleInternalMetaV5{.secret=storeInternalMeta.secret, .resourceId=currentStoreResourceId, .randomId=updateStoreDio.randomId},
+        .internalMeta = core::ModuleInternalMetaV5{.secret=storeInternalMeta.secret, .resourceId=currentStoreResourceId, .randomId=updateStoreDio.randomId, .keyChain=keyChain},
         .dio = updateStoreDio
     };
     model.data = _storeDataEncryptorV5.encrypt(storeDataToEncrypt, _userPrivKey, storeKey.key).toJSON();
 
     PRIVMX_DEBUG_TIME_CHECKPOINT(PlatformStore, storeUpdate, data encrypted)
     _serverApi->storeUpdate(model);
-    invalidateModuleKeysInCache(storeId);
+    if(force) {
+        invalidateModuleKeysInCache(storeId);
+    } else {
+        // the keys after the update are already known, so the next operation on the Store does not fetch them
+        auto updatedKeys {storeToModuleKeys(currentStore)};
+        updatedKeys.currentKeyId = storeKey.id;
+        updatedKeys.moduleSchemaVersion = StoreDataSchema::Version::VERSION_5;
+        updatedKeys.moduleResourceId = currentStoreResourceId;
+        updatedKeys.currentData = model.data;
+        writeThroughModuleKeysInCache(storeId, updatedKeys, keys, updateStoreDio.creatorUserId, version + 1);
+    }
     PRIVMX_DEBUG_TIME_STOP(PlatformStore, storeUpdate, data send)
 }
 
@@ -346,13 +412,21 @@ File StoreApiImpl::getFile(const std::string& fileId) {
 
 core::PagingList<File> StoreApiImpl::listFiles(const std::string& storeId, const core::PagingQuery& query) {
     PRIVMX_DEBUG_TIME_START(PlatformStore, storeFileList)
+    auto page = fetchFilesPage(storeId, query);
+    PRIVMX_DEBUG_TIME_CHECKPOINT(PlatformStore, storeFileList, data send);
+    auto files = page.decrypt();
+    PRIVMX_DEBUG_TIME_STOP(PlatformStore, storeFileList, data decrypted)
+    return core::PagingList<File>({
+        .totalAvailable = page.totalAvailable,
+        .readItems = files
+    });
+}
+
+core::CursorPage<File> StoreApiImpl::fetchFilesPage(const std::string& storeId, const core::PagingQuery& query) {
     server::StoreFileListModel model;
     model.storeId = storeId;
     core::ListQueryMapper::map(model, query);
-
-    PRIVMX_DEBUG_TIME_CHECKPOINT(PlatformStore, storeFileList)
     auto serverFilesResult = _serverApi->storeFileList(model);
-    PRIVMX_DEBUG_TIME_CHECKPOINT(PlatformStore, storeFileList, data send);
     auto store = serverFilesResult.store;
     assertStoreDataIntegrity(store);
     setNewModuleKeysInCache(
@@ -360,12 +434,15 @@ core::PagingList<File> StoreApiImpl::listFiles(const std::string& storeId, const
         storeToModuleKeys(store),
         store.version
     );
-    auto files = validateDecryptAndConvertFilesDataToFilesInfo(serverFilesResult.files, storeToModuleKeys(store));
-    PRIVMX_DEBUG_TIME_STOP(PlatformStore, storeFileList, data decrypted)
-    return core::PagingList<File>({
+    auto files = serverFilesResult.files;
+    return core::CursorPage<File>{
         .totalAvailable = serverFilesResult.count,
-        .readItems = files
-    });
+        .size = files.size(),
+        .lastId = files.empty() ? std::nullopt : std::make_optional(files.back().id),
+        .decrypt = [this, files, storeKeys = storeToModuleKeys(store)]() {
+            return validateDecryptAndConvertFilesDataToFilesInfo(files, storeKeys);
+        }
+    };
 }
 
 void StoreApiImpl::deleteFile(const std::string& fileId) {
@@ -450,6 +527,12 @@ FileDecryptionParams StoreApiImpl::getFileDecryptionParams(server::File file, dy
     if ((uint64_t)internalMeta.chunkSize > SIZE_MAX) {
         throw NumberToBigForCPUArchitectureException("chunkSize to big for this CPU architecture");
     }
+    if (internalMeta.version > ChunkMap::SPARSE_FILE_META_VERSION) {
+        throw UnsupportedFileMetaVersionException(std::to_string(internalMeta.version) + " expected version: " + std::to_string(ChunkMap::SPARSE_FILE_META_VERSION));
+    }
+    if (internalMeta.chunkMap.has_value() && internalMeta.version != ChunkMap::SPARSE_FILE_META_VERSION) {
+        throw InvalidChunkMapException("chunk map in file meta version " + std::to_string(internalMeta.version));
+    }
     return FileDecryptionParams {
         .fileId = file.id,
         .resourceId = file.resourceId,
@@ -459,7 +542,8 @@ FileDecryptionParams StoreApiImpl::getFileDecryptionParams(server::File file, dy
         .chunkSize = (size_t)internalMeta.chunkSize,
         .key = privmx::utils::Base64::toString(internalMeta.key),
         .hmac = privmx::utils::Base64::toString(internalMeta.hmac),
-        .version = file.version
+        .version = file.version,
+        .chunkMap = internalMeta.chunkMap
     };
 }
 
@@ -508,12 +592,22 @@ void StoreApiImpl::seekInFile(const int64_t handle, const int64_t pos) {
 
 void StoreApiImpl::syncFile(const int64_t handle) {
     std::shared_ptr<FileHandle> fileHandle = _fileHandleManager.getFileHandle(handle);
+    std::shared_ptr<FileReadWriteHandle> rw_handle = _fileHandleManager.tryGetFileReadWriteHandle(handle);
+    if (rw_handle) {
+        // send buffered writes before taking the newest version from the server,
+        // writes which cannot be sent would block every later sync, so the handle is closed
+        try {
+            rw_handle->file->flush();
+        } catch (...) {
+            _fileHandleManager.removeHandle(handle);
+            throw FileSyncFailedHandleCloseException("pending writes of file read write handle not sent");
+        }
+    }
     server::StoreFileGetModel storeFileGetModel;
     storeFileGetModel.fileId = fileHandle->getFileId();
     auto file_raw = _serverApi->storeFileGet(storeFileGetModel);
     auto encryptionParams = getFileEncryptionParams(file_raw.file, file_raw.store);
 
-    std::shared_ptr<FileReadWriteHandle> rw_handle = _fileHandleManager.tryGetFileReadWriteHandle(handle);
     if (rw_handle) {
         rw_handle->file->sync(
             encryptionParams.fileMeta,
@@ -536,8 +630,9 @@ void StoreApiImpl::syncFile(const int64_t handle) {
 std::string StoreApiImpl::closeFile(const int64_t handle) {
     std::shared_ptr<FileReadWriteHandle> rw_handle = _fileHandleManager.tryGetFileReadWriteHandle(handle);
     if (rw_handle) {
-        rw_handle->file->close();
+        // the handle is released even when its pending writes cannot be sent
         _fileHandleManager.removeHandle(handle);
+        rw_handle->file->close();
         return rw_handle->getFileId();
     }
     std::shared_ptr<FileHandle> handlePtr = _fileHandleManager.getFileHandle(handle);
@@ -552,6 +647,172 @@ std::string StoreApiImpl::closeFile(const int64_t handle) {
     return handlePtr->getFileId();
 }
 
+void StoreApiImpl::downloadFileToPath(const std::string& fileId, const std::string& filePath) {
+    PRIVMX_DEBUG_TIME_START(PlatformStore, downloadFileToPath)
+    server::StoreFileGetModel storeFileGetModel;
+    storeFileGetModel.fileId = fileId;
+    auto file_raw = _serverApi->storeFileGet(storeFileGetModel);
+    auto decryptionParams = getFileEncryptionParams(file_raw.file, file_raw.store).fileDecryptionParams;
+    if (decryptionParams.cipherType != 1) {
+        throw UnsupportedCipherTypeException(std::to_string(decryptionParams.cipherType) + " expected type: 1");
+    }
+    PRIVMX_DEBUG_TIME_CHECKPOINT(PlatformStore, downloadFileToPath, params decrypted)
+    std::shared_ptr<FileReadHandle> handle = _fileHandleManager.createFileReadHandle(
+        decryptionParams,
+        _serverRequestChunkSize,
+        _serverApi
+    );
+    _fileHandleManager.removeHandle(handle->getId());
+    LocalFileWriter output(filePath, handle->getSize());
+    try {
+        handle->readToFile(output);
+        output.close();
+    } catch (...) {
+        output.discard();
+        throw;
+    }
+    PRIVMX_DEBUG_TIME_STOP(PlatformStore, downloadFileToPath, data saved)
+}
+
+std::string StoreApiImpl::uploadFileFromPath(const std::string& storeId, const core::Buffer& publicMeta, const core::Buffer& privateMeta, const std::string& filePath, bool randomWriteSupport) {
+    PRIVMX_DEBUG_TIME_START(PlatformStore, uploadFileFromPath)
+    assertStoreExist(storeId);
+    LocalFileReader input(filePath);
+    std::shared_ptr<FileWriteHandle> handle = _fileHandleManager.createFileWriteHandle(
+        storeId,
+        std::string(),
+        core::EndpointUtils::generateId(),
+        input.getSize(),
+        publicMeta,
+        privateMeta,
+        _CHUNK_SIZE,
+        _serverRequestChunkSize,
+        _requestApi,
+        randomWriteSupport
+    );
+    _fileHandleManager.removeHandle(handle->getId());
+    handle->createRequestData();
+    handle->writeFromFile(input);
+    input.close();
+    PRIVMX_DEBUG_TIME_CHECKPOINT(PlatformStore, uploadFileFromPath, data sent)
+    auto result = storeFileFinalizeWrite(handle);
+    PRIVMX_DEBUG_TIME_STOP(PlatformStore, uploadFileFromPath, file created)
+    return result;
+}
+
+void StoreApiImpl::enableUploadProgressJournal(const std::string& directory) {
+    UploadProgressRegistry::setJournalDirectory(directory);
+}
+
+UploadCheckpoint StoreApiImpl::getUploadCheckpoint(const int64_t handleId) {
+    // without the journal a checkpoint could not be checked against the chunks sent after it once the process restarts
+    if (!UploadProgressRegistry::hasJournal()) {
+        throw UploadProgressJournalNotSetException();
+    }
+    std::shared_ptr<FileWriteHandle> handle = _fileHandleManager.getFileWriteHandle(handleId);
+    auto streamerState = handle->getStreamerState();
+    dynamic::UploadCheckpoint checkpoint;
+    checkpoint.version = UPLOAD_CHECKPOINT_VERSION;
+    checkpoint.storeId = handle->getStoreId();
+    checkpoint.fileId = handle->getFileId();
+    checkpoint.resourceId = handle->getResourceId();
+    checkpoint.size = handle->getSize();
+    checkpoint.publicMeta = utils::Base64::from(handle->getPublicMeta().stdString());
+    checkpoint.privateMeta = utils::Base64::from(handle->getPrivateMeta().stdString());
+    checkpoint.randomWrite = handle->getRandomWriteSupport();
+    checkpoint.chunkSize = handle->getChunkSize();
+    checkpoint.serverRequestChunkSize = _serverRequestChunkSize;
+    checkpoint.requestId = streamerState.requestId;
+    checkpoint.key = utils::Base64::from(streamerState.key);
+    checkpoint.fileIndex = streamerState.fileIndex;
+    checkpoint.seq = streamerState.seq;
+    checkpoint.serverSeq = streamerState.serverSeq;
+    checkpoint.dataProcessed = streamerState.dataProcessed;
+    checkpoint.uploadedFileSize = streamerState.uploadedFileSize;
+    checkpoint.checksums = utils::Base64::from(streamerState.checksums);
+    checkpoint.pendingEncryptedData = utils::Base64::from(streamerState.pendingData);
+    checkpoint.pendingPlainData = utils::Base64::from(handle->getPendingData());
+    checkpoint.writtenSize = handle->getWrittenSize();
+    auto encrypted = _uploadCheckpointEncryptorV4.signAndEncryptAndEncode(
+        core::Buffer::from(checkpoint.serialize()),
+        _userPrivKey,
+        getUploadCheckpointKey()
+    );
+    return UploadCheckpoint{
+        .data = core::Buffer::from(std::move(encrypted)),
+        .offset = checkpoint.writtenSize
+    };
+}
+
+int64_t StoreApiImpl::resumeUpload(const core::Buffer& checkpointData) {
+    dynamic::UploadCheckpoint checkpoint;
+    try {
+        auto decrypted = _uploadCheckpointEncryptorV4.decodeAndDecryptAndVerify(
+            checkpointData.stdString(),
+            _userPrivKey.getPublicKey(),
+            getUploadCheckpointKey()
+        );
+        checkpoint = dynamic::UploadCheckpoint::deserialize(decrypted.stdString());
+    } catch (const core::Exception& e) {
+        throw InvalidUploadCheckpointException(e.getFull());
+    } catch (const privmx::utils::PrivmxException& e) {
+        throw InvalidUploadCheckpointException(e.what());
+    }
+    if (checkpoint.version != UPLOAD_CHECKPOINT_VERSION || checkpoint.size < 0 || checkpoint.chunkSize <= 0 || checkpoint.serverRequestChunkSize <= 0) {
+        throw InvalidUploadCheckpointException();
+    }
+    // the chunks sent after the checkpoint are on the server already, so their checksums and sequence numbers would be lost,
+    // the progress is taken from the journal when the upload was started by another process
+    if (UploadProgressRegistry::isStale(checkpoint.requestId, checkpoint.serverSeq)) {
+        throw StaleUploadCheckpointException();
+    }
+    std::shared_ptr<FileWriteHandle> handle = _fileHandleManager.createFileWriteHandle(
+        checkpoint.storeId,
+        checkpoint.fileId,
+        checkpoint.resourceId,
+        (uint64_t)checkpoint.size,
+        core::Buffer::from(utils::Base64::toString(checkpoint.publicMeta)),
+        core::Buffer::from(utils::Base64::toString(checkpoint.privateMeta)),
+        (uint64_t)checkpoint.chunkSize,
+        (uint64_t)checkpoint.serverRequestChunkSize,
+        _requestApi,
+        checkpoint.randomWrite
+    );
+    try {
+        handle->restoreState(
+            ChunkStreamerState{
+                .requestId = checkpoint.requestId,
+                .key = utils::Base64::toString(checkpoint.key),
+                .fileIndex = (uint64_t)checkpoint.fileIndex,
+                .seq = (uint32_t)checkpoint.seq,
+                .serverSeq = (uint64_t)checkpoint.serverSeq,
+                .dataProcessed = (uint64_t)checkpoint.dataProcessed,
+                .uploadedFileSize = (uint64_t)checkpoint.uploadedFileSize,
+                .checksums = utils::Base64::toString(checkpoint.checksums),
+                .pendingData = utils::Base64::toString(checkpoint.pendingEncryptedData)
+            },
+            utils::Base64::toString(checkpoint.pendingPlainData),
+            (uint64_t)checkpoint.writtenSize
+        );
+    } catch (...) {
+        _fileHandleManager.removeHandle(handle->getId());
+        throw;
+    }
+    return handle->getId();
+}
+
+void StoreApiImpl::setWriteBackBufferSize(const int64_t handle, const int64_t bufferSize) {
+    std::shared_ptr<FileReadWriteHandle> rw_handle = _fileHandleManager.tryGetFileReadWriteHandle(handle);
+    if (!rw_handle) {
+        throw InvalidFileReadWriteHandleException();
+    }
+    rw_handle->file->setWriteBackBufferSize(bufferSize);
+}
+
+std::string StoreApiImpl::getUploadCheckpointKey() {
+    return privmx::crypto::Crypto::hmacSha256(_userPrivKey.getPrivateEncKey(), "privmx-store-upload-checkpoint");
+}
+
 std::string StoreApiImpl::storeFileFinalizeWrite(const std::shared_ptr<FileWriteHandle>& handle) {
     auto data = handle->finalize();
     try {
@@ -731,12 +992,12 @@ void StoreApiImpl::processNotificationEvent(const std::string& type, const core:
 }
 
 void StoreApiImpl::processConnectedEvent() {
-    invalidateModuleKeysInCache();
+    revalidateModuleKeysInCache();
 }
 
 void StoreApiImpl::processDisconnectedEvent() {
     LOG_TRACE("StoreApiImpl recived DisconnectedEvent");
-    invalidateModuleKeysInCache();
+    revalidateModuleKeysInCache();
     privmx::utils::ManualManagedClass<StoreApiImpl>::cleanup();
 }
 
@@ -836,6 +1097,7 @@ StoreDataSchema::Version StoreApiImpl::getStoreEntryDataStructureVersion(server:
             case core::ModuleDataSchema::Version::VERSION_4:
                 return StoreDataSchema::Version::VERSION_4;
             case core::ModuleDataSchema::Version::VERSION_5:
+            case core::ModuleDataSchema::Version::VERSION_6:
                 return StoreDataSchema::Version::VERSION_5;
             default:
                 return StoreDataSchema::Version::UNKNOWN;
@@ -1150,7 +1412,7 @@ File StoreApiImpl::convertDecryptedFileMetaV4ToFile(server::File file, const Dec
     auto statusCode = fileData.statusCode;
     if(statusCode == 0) {
         try {
-            auto internalMeta = dynamic::InternalStoreFileMeta::fromJSON(utils::Utils::parseJson(fileData.internalMeta.stdString()));
+            auto internalMeta = dynamic::InternalStoreFileMeta::deserialize(fileData.internalMeta.stdString());
             randomWrite = internalMeta.randomWrite.value_or(false);
         }  catch (const privmx::endpoint::core::Exception& e) {
             statusCode = e.getCode();
@@ -1178,7 +1440,7 @@ File StoreApiImpl::convertDecryptedFileMetaV5ToFile(server::File file, const Dec
     auto statusCode = fileData.statusCode;
     if(statusCode == 0) {
         try {
-            auto internalMeta = dynamic::InternalStoreFileMeta::fromJSON(utils::Utils::parseJson(fileData.internalMeta.stdString()));
+            auto internalMeta = dynamic::InternalStoreFileMeta::deserialize(fileData.internalMeta.stdString());
             size = internalMeta.size;
             randomWrite = internalMeta.randomWrite.value_or(false);
         }  catch (const privmx::endpoint::core::Exception& e) {
@@ -1260,7 +1522,7 @@ std::tuple<File, core::DataIntegrityObject> StoreApiImpl::decryptAndConvertFileD
         }
         case FileDataSchema::Version::VERSION_5: {
             auto decryptedFile = decryptFileMetaV5(file, encKey);
-            return std::make_tuple(convertDecryptedFileMetaV5ToFile(file, decryptFileMetaV5(file, encKey)), decryptedFile.dio);
+            return std::make_tuple(convertDecryptedFileMetaV5ToFile(file, decryptedFile), decryptedFile.dio);
         }
     }
     auto e = UnknowFileFormatException();
@@ -1275,6 +1537,7 @@ std::vector<File> StoreApiImpl::validateDecryptAndConvertFilesDataToFilesInfo(st
     core::KeyDecryptionAndVerificationRequest keyProviderRequest;
     core::EncKeyLocation location{.contextId=storeKeys.contextId, .resourceId=storeKeys.moduleResourceId};
     keyProviderRequest.addMany(storeKeys.keys, keyIds, location);
+    keyProviderRequest.addKeyChain(storeKeys, location);
     auto keyMap = _keyProvider->getKeysAndVerify(keyProviderRequest).at(location);
     std::vector<File> result;
     std::vector<core::DataIntegrityObject> filesDIO;
@@ -1330,6 +1593,7 @@ File StoreApiImpl::validateDecryptAndConvertFileDataToFileInfo(server::File file
         core::KeyDecryptionAndVerificationRequest keyProviderRequest;
         core::EncKeyLocation location{.contextId=file.contextId, .resourceId=storeKeys.moduleResourceId};
         keyProviderRequest.addOne(storeKeys.keys, keyId, location);
+        keyProviderRequest.addKeyChain(storeKeys, location);
         auto encKey = _keyProvider->getKeysAndVerify(keyProviderRequest).at(location).at(keyId);
         File result;
         core::DataIntegrityObject fileDIO;
@@ -1374,13 +1638,9 @@ dynamic::InternalStoreFileMeta StoreApiImpl::decryptFileInternalMeta(server::Fil
                 return internalFileMeta;
             }
             case FileDataSchema::Version::VERSION_4:
-                return dynamic::InternalStoreFileMeta::fromJSON(
-                    utils::Utils::parseJson(decryptFileMetaV4(file, encKey).internalMeta.stdString())
-                );
+                return dynamic::InternalStoreFileMeta::deserialize(decryptFileMetaV4(file, encKey).internalMeta.stdString());
             case FileDataSchema::Version::VERSION_5:
-                return dynamic::InternalStoreFileMeta::fromJSON(
-                    utils::Utils::parseJson(decryptFileMetaV5(file, encKey).internalMeta.stdString())
-                );
+                return dynamic::InternalStoreFileMeta::deserialize(decryptFileMetaV5(file, encKey).internalMeta.stdString());
         }
     }
     throw UnknowFileFormatException();
@@ -1391,6 +1651,7 @@ dynamic::InternalStoreFileMeta StoreApiImpl::validateDecryptFileInternalMeta(ser
     core::KeyDecryptionAndVerificationRequest keyProviderRequest;
     core::EncKeyLocation location{.contextId=file.contextId, .resourceId=storeKeys.moduleResourceId};
     keyProviderRequest.addOne(storeKeys.keys, keyId, location);
+    keyProviderRequest.addKeyChain(storeKeys, location);
     auto encKey = _keyProvider->getKeysAndVerify(keyProviderRequest).at(location).at(keyId);
     _fileKeyIdFormatValidator.assertKeyIdFormat(keyId);
     return decryptFileInternalMeta(file, encKey);
@@ -1499,7 +1760,8 @@ core::ModuleKeys StoreApiImpl::storeToModuleKeys(server::Store store) {
         .currentKeyId=store.keyId,
         .moduleSchemaVersion=getStoreEntryDataStructureVersion(store.data.back()),
         .moduleResourceId=store.resourceId.value_or(""),
-        .contextId = store.contextId
+        .contextId = store.contextId,
+        .currentData = store.data.back().data
     };
 }
 
@@ -0,0 +1,137 @@
+/*
+PrivMX Endpoint.
+Copyright © 2024 Simplito sp. z o.o.
+
+This file is part of the PrivMX Platform (https://privmx.dev).
+This software is Licensed under the PrivMX Free License.
+
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <unordered_map>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <privmx/crypto/Crypto.hpp>
+#include <privmx/utils/Utils.hpp>
+
+#include "privmx/endpoint/store/StoreException.hpp"
+#include "privmx/endpoint/store/UploadProgressRegistry.hpp"
+
+using namespace privmx::endpoint;
+using namespace privmx::endpoint::store;
+
+namespace {
+
+constexpr uint64_t COMMITTED = std::numeric_limits<uint64_t>::max();
+constexpr const char* JOURNAL_FILE_EXTENSION = ".upload";
+
+struct State {
+    std::mutex mutex;
+    std::unordered_map<std::string, uint64_t> serverSeqs;
+    std::string journalDirectory;
+};
+
+State& getState() {
+    // never destroyed, as the library threads may still upload while static objects are destroyed
+    static State* state = new State();
+    return *state;
+}
+
+}
+
+void UploadProgressRegistry::setJournalDirectory(const std::string& directory) {
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    if (ec || !std::filesystem::is_directory(directory, ec)) {
+        throw UploadProgressJournalFailedException(directory + ": " + ec.message());
+    }
+    auto& state = getState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.journalDirectory = directory;
+}
+
+bool UploadProgressRegistry::hasJournal() {
+    auto& state = getState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    return !state.journalDirectory.empty();
+}
+
+void UploadProgressRegistry::recordChunkSent(const std::string& requestId, uint64_t serverSeq) {
+    auto& state = getState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    auto& current = state.serverSeqs[requestId];
+    if (current != COMMITTED && serverSeq > current) {
+        current = serverSeq;
+        if (!state.journalDirectory.empty()) {
+            writeJournal(state.journalDirectory, requestId, serverSeq);
+        }
+    }
+}
+
+void UploadProgressRegistry::recordCommitted(const std::string& requestId) {
+    auto& state = getState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.serverSeqs[requestId] = COMMITTED;
+    if (!state.journalDirectory.empty()) {
+        writeJournal(state.journalDirectory, requestId, COMMITTED);
+    }
+}
+
+bool UploadProgressRegistry::isStale(const std::string& requestId, uint64_t serverSeq) {
+    auto& state = getState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    auto it = state.serverSeqs.find(requestId);
+    if (it != state.serverSeqs.end()) {
+        return it->second > serverSeq;
+    }
+    // a request not seen by this process, e.g. resumed after a restart
+    if (state.journalDirectory.empty()) {
+        throw UploadProgressJournalNotSetException();
+    }
+    auto journaled = readJournal(state.journalDirectory, requestId);
+    return journaled.has_value() && journaled.value() > serverSeq;
+}
+
+std::string UploadProgressRegistry::getJournalPath(const std::string& directory, const std::string& requestId) {
+    return (std::filesystem::path(directory) / (utils::Hex::from(privmx::crypto::Crypto::sha256(requestId)) + JOURNAL_FILE_EXTENSION)).string();
+}
+
+std::optional<uint64_t> UploadProgressRegistry::readJournal(const std::string& directory, const std::string& requestId) {
+    auto path = getJournalPath(directory, requestId);
+    std::ifstream input(path);
+    if (!input.is_open()) {
+        return std::nullopt;
+    }
+    uint64_t serverSeq;
+    if (!(input >> serverSeq)) {
+        throw UploadProgressJournalFailedException(path + ": invalid content");
+    }
+    return serverSeq;
+}
+
+void UploadProgressRegistry::writeJournal(const std::string& directory, const std::string& requestId, uint64_t serverSeq) {
+    // written to a temporary file, synced and renamed, so a crash leaves either the previous or the new value
+    auto path = getJournalPath(directory, requestId);
+    auto tmpPath = path + ".tmp";
+    auto content = std::to_string(serverSeq);
+    int fd = ::open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600);
+    if (fd < 0) {
+        throw UploadProgressJournalFailedException(tmpPath + ": " + std::strerror(errno));
+    }
+    bool written = ::write(fd, content.data(), content.size()) == (ssize_t)content.size() && ::fsync(fd) == 0;
+    int err = errno;
+    ::close(fd);
+    if (!written || ::rename(tmpPath.c_str(), path.c_str()) != 0) {
+        err = written ? errno : err;
+        ::unlink(tmpPath.c_str());
+        throw UploadProgressJournalFailedException(path + ": " + std::strerror(err));
+    }
+}
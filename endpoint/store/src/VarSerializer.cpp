@@ -164,6 +164,17 @@ Poco::Dynamic::Var VarSerializer::serialize<store::ServerFileInfo>(const store::
     return obj;
 }
 
+template<>
+Poco::Dynamic::Var VarSerializer::serialize<store::UploadCheckpoint>(const store::UploadCheckpoint& val) {
+    Poco::JSON::Object::Ptr obj = new Poco::JSON::Object();
+    if (_options.addType) {
+        obj->set("__type", "store$UploadCheckpoint");
+    }
+    obj->set("data", serialize(val.data));
+    obj->set("offset", serialize(val.offset));
+    return obj;
+}
+
 template<>
 Poco::Dynamic::Var VarSerializer::serialize<store::File>(const store::File& val) {
     Poco::JSON::Object::Ptr obj = new Poco::JSON::Object();
@@ -27,16 +27,21 @@ store::server::EncryptedFileMetaV5 FileMetaEncryptorV5::encrypt(
     server::EncryptedFileMetaV5 result;
     result.version = FileDataSchema::Version::VERSION_5;
     std::unordered_map<std::string, std::string> fieldChecksums;
-    result.publicMeta = _dataEncryptor.signAndEncode(fileMeta.publicMeta, authorPrivateKey);
+    auto encoded = _dataEncryptor.signAndEncodeMany({
+        {fileMeta.publicMeta, std::nullopt},
+        {fileMeta.privateMeta, encryptionKey},
+        {fileMeta.internalMeta, encryptionKey}
+    }, authorPrivateKey);
+    result.publicMeta = encoded[0];
     fieldChecksums.insert(std::make_pair("publicMeta", privmx::crypto::Crypto::sha256(result.publicMeta)));
     try {
         result.publicMetaObject = utils::Utils::parseJsonObject(fileMeta.publicMeta.stdString());
     } catch (...) {
         result.publicMetaObject = Poco::Dynamic::Var();
     }
-    result.privateMeta = _dataEncryptor.signAndEncryptAndEncode(fileMeta.privateMeta, authorPrivateKey, encryptionKey);
+    result.privateMeta = encoded[1];
     fieldChecksums.insert(std::make_pair("privateMeta", privmx::crypto::Crypto::sha256(result.privateMeta)));
-    auto internalMeta = _dataEncryptor.signAndEncryptAndEncode(fileMeta.internalMeta, authorPrivateKey, encryptionKey);
+    auto internalMeta = encoded[2];
     result.internalMeta = internalMeta;
     fieldChecksums.insert(std::make_pair("internalMeta", privmx::crypto::Crypto::sha256(internalMeta)));
     result.authorPubKey = authorPrivateKey.getPublicKey().toBase58DER();
@@ -53,7 +58,12 @@ store::DecryptedFileMetaV5 FileMetaEncryptorV5::decrypt(const store::server::Enc
     try {
         result.dio = getDIOAndAssertIntegrity(encryptedFileMeta);
         auto authorPublicKey = crypto::PublicKey::fromBase58DER(encryptedFileMeta.authorPubKey);
-        result.publicMeta = _dataEncryptor.decodeAndVerify(encryptedFileMeta.publicMeta, authorPublicKey);
+        auto decoded = _dataEncryptor.decodeAndVerifyMany({
+            {encryptedFileMeta.publicMeta, std::nullopt},
+            {encryptedFileMeta.privateMeta, encryptionKey},
+            {encryptedFileMeta.internalMeta.value(), encryptionKey}
+        }, authorPublicKey);
+        result.publicMeta = decoded[0];
         if (!encryptedFileMeta.publicMetaObject.isEmpty()) {
             auto tmp_1 = utils::Utils::stringifyVar(utils::Utils::parseJsonObject(result.publicMeta.stdString()));
             auto tmp_2 = utils::Utils::stringifyVar(encryptedFileMeta.publicMetaObject);
@@ -62,8 +72,8 @@ store::DecryptedFileMetaV5 FileMetaEncryptorV5::decrypt(const store::server::Enc
                 result.statusCode = e.getCode();
             }
         }
-        result.privateMeta = _dataEncryptor.decodeAndDecryptAndVerify(encryptedFileMeta.privateMeta, authorPublicKey, encryptionKey);
-        result.internalMeta = _dataEncryptor.decodeAndDecryptAndVerify(encryptedFileMeta.internalMeta.value(), authorPublicKey, encryptionKey);
+        result.privateMeta = decoded[1];
+        result.internalMeta = decoded[2];
         result.authorPubKey = encryptedFileMeta.authorPubKey;
     } catch (const privmx::endpoint::core::Exception& e) {
         result.statusCode = e.getCode();
@@ -117,6 +127,10 @@ core::DataIntegrityObject FileMetaEncryptorV5::getDIOAndAssertIntegrity(const se
     return dio;
 }
 
+void FileMetaEncryptorV5::setCompressor(const std::shared_ptr<const core::DataCompressor>& compressor) {
+    _dataEncryptor.setCompressor(compressor);
+}
+
 void FileMetaEncryptorV5::assertDataFormat(const server::EncryptedFileMetaV5& encryptedFileMeta) {
     if (
         encryptedFileMeta.version != FileDataSchema::Version::VERSION_5 ||
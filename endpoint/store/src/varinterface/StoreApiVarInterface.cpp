@@ -38,7 +38,15 @@ std::map<StoreApiVarInterface::METHOD, Poco::Dynamic::Var (StoreApiVarInterface:
                                        {SyncFile, &StoreApiVarInterface::syncFile},
                                        {SubscribeFor, &StoreApiVarInterface::subscribeFor},
                                        {UnsubscribeFrom, &StoreApiVarInterface::unsubscribeFrom},
-                                       {BuildSubscriptionQuery, &StoreApiVarInterface::buildSubscriptionQuery}};
+                                       {BuildSubscriptionQuery, &StoreApiVarInterface::buildSubscriptionQuery},
+                                       {DownloadFileToPath, &StoreApiVarInterface::downloadFileToPath},
+                                       {UploadFileFromPath, &StoreApiVarInterface::uploadFileFromPath},
+                                       {GetUploadCheckpoint, &StoreApiVarInterface::getUploadCheckpoint},
+                                       {ResumeUpload, &StoreApiVarInterface::resumeUpload},
+                                       {SetWriteBackBufferSize, &StoreApiVarInterface::setWriteBackBufferSize},
+                                       {AddStoreMembers, &StoreApiVarInterface::addStoreMembers},
+                                       {RemoveStoreMembers, &StoreApiVarInterface::removeStoreMembers},
+                                       {EnableUploadProgressJournal, &StoreApiVarInterface::enableUploadProgressJournal}};
 
 
 Poco::Dynamic::Var StoreApiVarInterface::create(const Poco::Dynamic::Var& args) {
@@ -74,6 +82,23 @@ Poco::Dynamic::Var StoreApiVarInterface::updateStore(const Poco::Dynamic::Var& a
     return {};
 }
 
+Poco::Dynamic::Var StoreApiVarInterface::addStoreMembers(const Poco::Dynamic::Var& args) {
+    auto argsArr = core::VarInterfaceUtil::validateAndExtractArray(args, 3);
+    auto storeId = _deserializer.deserialize<std::string>(argsArr->get(0), "storeId");
+    auto users = _deserializer.deserializeVector<core::UserWithPubKey>(argsArr->get(1), "users");
+    auto managers = _deserializer.deserializeVector<core::UserWithPubKey>(argsArr->get(2), "managers");
+    _storeApi.addStoreMembers(storeId, users, managers);
+    return {};
+}
+
+Poco::Dynamic::Var StoreApiVarInterface::removeStoreMembers(const Poco::Dynamic::Var& args) {
+    auto argsArr = core::VarInterfaceUtil::validateAndExtractArray(args, 2);
+    auto storeId = _deserializer.deserialize<std::string>(argsArr->get(0), "storeId");
+    auto userIds = _deserializer.deserializeVector<std::string>(argsArr->get(1), "userIds");
+    _storeApi.removeStoreMembers(storeId, userIds);
+    return {};
+}
+
 Poco::Dynamic::Var StoreApiVarInterface::deleteStore(const Poco::Dynamic::Var& args) {
     auto argsArr = core::VarInterfaceUtil::validateAndExtractArray(args, 1);
     auto storeId = _deserializer.deserialize<std::string>(argsArr->get(0), "storeId");
@@ -217,6 +242,54 @@ Poco::Dynamic::Var StoreApiVarInterface::buildSubscriptionQuery(const Poco::Dyna
     return _serializer.serialize(result);
 }
 
+Poco::Dynamic::Var StoreApiVarInterface::downloadFileToPath(const Poco::Dynamic::Var& args) {
+    auto argsArr = core::VarInterfaceUtil::validateAndExtractArray(args, 2);
+    auto fileId = _deserializer.deserialize<std::string>(argsArr->get(0), "fileId");
+    auto filePath = _deserializer.deserialize<std::string>(argsArr->get(1), "filePath");
+    _storeApi.downloadFileToPath(fileId, filePath);
+    return {};
+}
+
+Poco::Dynamic::Var StoreApiVarInterface::uploadFileFromPath(const Poco::Dynamic::Var& args) {
+    auto argsArr = core::VarInterfaceUtil::validateAndExtractArray(args, 5);
+    auto storeId = _deserializer.deserialize<std::string>(argsArr->get(0), "storeId");
+    auto publicMeta = _deserializer.deserialize<core::Buffer>(argsArr->get(1), "publicMeta");
+    auto privateMeta = _deserializer.deserialize<core::Buffer>(argsArr->get(2), "privateMeta");
+    auto filePath = _deserializer.deserialize<std::string>(argsArr->get(3), "filePath");
+    auto randomWriteSupport = _deserializer.deserialize<bool>(argsArr->get(4), "randomWriteSupport");
+    auto result = _storeApi.uploadFileFromPath(storeId, publicMeta, privateMeta, filePath, randomWriteSupport);
+    return _serializer.serialize(result);
+}
+
+Poco::Dynamic::Var StoreApiVarInterface::enableUploadProgressJournal(const Poco::Dynamic::Var& args) {
+    auto argsArr = core::VarInterfaceUtil::validateAndExtractArray(args, 1);
+    auto directory = _deserializer.deserialize<std::string>(argsArr->get(0), "directory");
+    _storeApi.enableUploadProgressJournal(directory);
+    return {};
+}
+
+Poco::Dynamic::Var StoreApiVarInterface::getUploadCheckpoint(const Poco::Dynamic::Var& args) {
+    auto argsArr = core::VarInterfaceUtil::validateAndExtractArray(args, 1);
+    auto fileHandle = _deserializer.deserialize<int64_t>(argsArr->get(0), "fileHandle");
+    auto result = _storeApi.getUploadCheckpoint(fileHandle);
+    return _serializer.serialize(result);
+}
+
+Poco::Dynamic::Var StoreApiVarInterface::resumeUpload(const Poco::Dynamic::Var& args) {
+    auto argsArr = core::VarInterfaceUtil::validateAndExtractArray(args, 1);
+    auto checkpoint = _deserializer.deserialize<core::Buffer>(argsArr->get(0), "checkpoint");
+    auto result = _storeApi.resumeUpload(checkpoint);
+    return _serializer.serialize(result);
+}
+
+Poco::Dynamic::Var StoreApiVarInterface::setWriteBackBufferSize(const Poco::Dynamic::Var& args) {
+    auto argsArr = core::VarInterfaceUtil::validateAndExtractArray(args, 2);
+    auto fileHandle = _deserializer.deserialize<int64_t>(argsArr->get(0), "fileHandle");
+    auto bufferSize = _deserializer.deserialize<int64_t>(argsArr->get(1), "bufferSize");
+    _storeApi.setWriteBackBufferSize(fileHandle, bufferSize);
+    return {};
+}
+
 Poco::Dynamic::Var StoreApiVarInterface::exec(METHOD method, const Poco::Dynamic::Var& args) {
     auto it = methodMap.find(method);
     if (it == methodMap.end()) {
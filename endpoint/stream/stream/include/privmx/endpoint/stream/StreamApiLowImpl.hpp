@@ -12,6 +12,7 @@ limitations under the License.
 #ifndef _PRIVMXLIB_ENDPOINT_STREAM_STREAMAPILOWIMPL_HPP_
 #define _PRIVMXLIB_ENDPOINT_STREAM_STREAMAPILOWIMPL_HPP_
 
+#include <atomic>
 #include <memory>
 #include <optional>
 #include <privmx/endpoint/core/Connection.hpp>
@@ -30,6 +31,7 @@ limitations under the License.
 #include "privmx/endpoint/stream/Types.hpp"
 #include "privmx/endpoint/stream/WebRTCInterface.hpp"
 #include "privmx/endpoint/stream/encryptors/dataChannel/DataChannelMessageEncryptorV1.hpp"
+#include "privmx/endpoint/stream/encryptors/dataChannel/DataChannelMessageEncryptorV2.hpp"
 #include <privmx/utils/ManualManagedClass.hpp>
 namespace privmx {
 namespace endpoint {
@@ -101,6 +103,7 @@ public:
     core::Buffer encryptDataChannelMessage(const std::string& streamRoomId, const DataChannelMessage& plainMessage); 
     void registerRemoteDataChannel(const std::string& streamRoomId, const std::string& remoteStreamId);
     DecryptedDataChannelMessage decryptDataChannelMessage(const std::string& streamRoomId, const std::string& remoteStreamId, const core::Buffer& encryptedData);
+    void setDataChannelMessageVersion(const std::string& streamRoomId, const int64_t version);
 
     inline static const std::string STREAM_TYPE_FILTER_FLAG = "stream";
 private:
@@ -109,12 +112,14 @@ private:
         std::optional<StreamHandle> streamHandle;
     };
     struct StreamRoomData {
-        StreamRoomData(std::shared_ptr<DataChannelMessageEncryptorV1> _messageEncryptor, const std::string _streamRoomId, std::shared_ptr<WebRTCInterface> _webRtc, const std::vector<std::string>& _subscriptionsIds, const std::string& _encryptionKeyId = ""):
-            messageEncryptor(_messageEncryptor), streamRoomId(_streamRoomId), webRtc(_webRtc), subscriptionsIds(_subscriptionsIds), encryptionKeyId(_encryptionKeyId)
+        StreamRoomData(std::shared_ptr<DataChannelMessageEncryptorV1> _messageEncryptor, std::shared_ptr<DataChannelMessageEncryptorV2> _messageEncryptorV2, const std::string _streamRoomId, std::shared_ptr<WebRTCInterface> _webRtc, const std::vector<std::string>& _subscriptionsIds, const std::string& _encryptionKeyId = ""):
+            messageEncryptor(_messageEncryptor), messageEncryptorV2(_messageEncryptorV2), streamRoomId(_streamRoomId), webRtc(_webRtc), subscriptionsIds(_subscriptionsIds), encryptionKeyId(_encryptionKeyId)
         {}
         std::shared_ptr<StreamData> publisherStream;
         std::shared_ptr<StreamData> subscriberStream;
         std::shared_ptr<DataChannelMessageEncryptorV1> messageEncryptor;
+        std::shared_ptr<DataChannelMessageEncryptorV2> messageEncryptorV2;
+        std::atomic<int64_t> messageVersion = DataChannelMessageEncryptorV1::WIRE_FORMAT_VERSION;
         std::string streamRoomId;
         std::shared_ptr<WebRTCInterface> webRtc;
         std::vector<std::string> subscriptionsIds;
@@ -30,6 +30,8 @@ public:
     DecryptedDataChannelMessage decryptMessage(const std::string& remoteStreamId, const core::Buffer& encryptedMessage);
     void registerRemoteStreamId(const std::string& remoteStreamId, int64_t initialSeq = -1);
     void updateKey(const std::vector<Key>& keys);
+
+    static constexpr uint8_t WIRE_FORMAT_VERSION = 1;
 private:
     struct Header {
         uint8_t version;
@@ -57,7 +59,6 @@ private:
     static constexpr uint64_t VERSION_LENGTH_BYTES = 1;         //uint8_t
     static constexpr uint64_t KEY_ID_LENGTH_BYTES = 1;          //uint8_t
     static constexpr uint64_t SEQUENCE_NUMBER_LENGTH_BYTES = 4; //uint32_t
-    static constexpr uint8_t WIRE_FORMAT_VERSION = 1;
     static constexpr uint64_t FIXED_HEADER_LENGTH = VERSION_LENGTH_BYTES + KEY_ID_LENGTH_BYTES + SEQUENCE_NUMBER_LENGTH_BYTES + GCM_NONCE_LENGTH_BYTES; 
     std::shared_mutex _keysMutex;
     std::vector<Key> _keys;
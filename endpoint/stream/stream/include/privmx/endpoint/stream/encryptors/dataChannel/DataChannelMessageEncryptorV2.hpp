@@ -0,0 +1,80 @@
+/*
+PrivMX Endpoint.
+Copyright © 2024 Simplito sp. z o.o.
+
+This file is part of the PrivMX Platform (https://privmx.dev).
+This software is Licensed under the PrivMX Free License.
+
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef _PRIVMXLIB_ENDPOINT_WEBRTC_DATACHANNELMESSAGEENCRYPTORV2_HPP_
+#define _PRIVMXLIB_ENDPOINT_WEBRTC_DATACHANNELMESSAGEENCRYPTORV2_HPP_
+
+#include <mutex>
+#include <shared_mutex>
+#include <string_view>
+#include <unordered_map>
+#include <privmx/endpoint/core/CoreTypes.hpp>
+#include "privmx/endpoint/stream/WebRTCInterface.hpp"
+
+namespace privmx {
+namespace endpoint {
+namespace stream {
+
+// Wire format V2: version(1) | seq(4, BE) | nonce(12) | keyIdLength(1) | keyId | ciphertext + tag
+// The GCM nonce is a random 8-byte salt chosen per encryption key followed by a 4-byte message counter,
+// so no random bytes are drawn per message. Received seq numbers are checked against a sliding window,
+// which accepts reordered messages and rejects replayed ones.
+class DataChannelMessageEncryptorV2 {
+public:
+    DataChannelMessageEncryptorV2(const std::vector<Key>& keys);
+    DataChannelMessageEncryptorV2() = default;
+    core::Buffer encryptMessage(const DataChannelMessage& plainMessage);
+    DecryptedDataChannelMessage decryptMessage(const std::string& remoteStreamId, const core::Buffer& encryptedMessage);
+    void registerRemoteStreamId(const std::string& remoteStreamId, int64_t initialSeq = -1);
+    void updateKey(const std::vector<Key>& keys);
+
+    static constexpr uint8_t WIRE_FORMAT_VERSION = 2;
+    static constexpr uint64_t REPLAY_WINDOW_SIZE = 64;
+private:
+    struct ReplayWindow {
+        int64_t highestSeq;
+        uint64_t bitmap; // bit n set - message highestSeq - n was received
+    };
+
+    std::string nextNonce(const std::string& keyId);
+    void assertData(const std::string& encryptedData);
+    void assertSeq(const std::string& remoteStreamId, uint32_t seq);
+    void assertSeq(const std::string& remoteStreamId, const ReplayWindow& window, uint32_t seq);
+    void updateSeq(const std::string& remoteStreamId, uint32_t seq);
+    ReplayWindow& getReplayWindow(const std::string& remoteStreamId);
+    const Key& getEncryptionKey();
+    const Key& getDecryptionKey(std::string_view keyId);
+
+    static constexpr uint64_t GCM_NONCE_LENGTH_BYTES = 12;
+    static constexpr uint64_t GCM_TAG_LENGTH_BYTES = 16;
+    static constexpr uint64_t NONCE_SALT_LENGTH_BYTES = 8;
+    static constexpr uint64_t VERSION_LENGTH_BYTES = 1;         //uint8_t
+    static constexpr uint64_t KEY_ID_LENGTH_BYTES = 1;          //uint8_t
+    static constexpr uint64_t SEQUENCE_NUMBER_LENGTH_BYTES = 4; //uint32_t
+    static constexpr uint64_t SEQUENCE_NUMBER_OFFSET = VERSION_LENGTH_BYTES;
+    static constexpr uint64_t NONCE_OFFSET = SEQUENCE_NUMBER_OFFSET + SEQUENCE_NUMBER_LENGTH_BYTES;
+    static constexpr uint64_t KEY_ID_LENGTH_OFFSET = NONCE_OFFSET + GCM_NONCE_LENGTH_BYTES;
+    static constexpr uint64_t FIXED_HEADER_LENGTH = KEY_ID_LENGTH_OFFSET + KEY_ID_LENGTH_BYTES;
+    std::shared_mutex _keysMutex;
+    std::vector<Key> _keys;
+    std::mutex _nonceMutex;
+    std::string _nonceKeyId;
+    std::string _nonceSalt;
+    uint64_t _nonceCounter = 0;
+    std::mutex _replayWindowsMutex;
+    std::unordered_map<std::string, ReplayWindow> _replayWindows;
+};
+
+}  // namespace stream
+}  // namespace endpoint
+}  // namespace privmx
+
+#endif  //_PRIVMXLIB_ENDPOINT_WEBRTC_DATACHANNELMESSAGEENCRYPTORV2_HPP_
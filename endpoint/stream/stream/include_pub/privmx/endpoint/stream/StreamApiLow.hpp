@@ -92,6 +92,7 @@ public:
     core::Buffer encryptDataChannelMessage(const std::string& streamRoomId, const DataChannelMessage& plainMessage); 
     void registerRemoteDataChannel(const std::string& streamRoomId, const std::string& remoteStreamId);
     DecryptedDataChannelMessage decryptDataChannelMessage(const std::string& streamRoomId, const std::string& remoteStreamId, const core::Buffer& encryptedData);
+    void setDataChannelMessageVersion(const std::string& streamRoomId, const int64_t version); // 1 (default) or 2 - counter nonces, reordering allowed
 private:
     StreamApiLow(const std::shared_ptr<StreamApiLowImpl>& impl);
 };
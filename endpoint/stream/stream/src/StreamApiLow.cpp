@@ -359,3 +359,14 @@ DecryptedDataChannelMessage StreamApiLow::decryptDataChannelMessage(const std::s
         throw core::Exception("ExceptionConverter rethrow error");
     }
 }
+
+void StreamApiLow::setDataChannelMessageVersion(const std::string& streamRoomId, const int64_t version) {
+    auto impl = getImpl();
+    core::Validator::validateId(streamRoomId, "field:streamRoomId ");
+    try {
+        return impl->setDataChannelMessageVersion(streamRoomId, version);
+    } catch (const privmx::utils::PrivmxException& e) {
+        core::ExceptionConverter::rethrowAsCoreException(e);
+        throw core::Exception("ExceptionConverter rethrow error");
+    }
+}
@@ -127,6 +127,8 @@ void StreamApiLowImpl::processNotificationEvent(const core::NotificationEvent& n
             if(streamRoomData.has_value()) {
                 std::vector<stream::Key> keys = generateWebRTCKeysFromStreamRoomInfo(raw, streamRoomData.value()->encryptionKeyId);
                 streamRoomData.value()->webRtc->updateKeys(eventData.streamRoomId, keys);
+                streamRoomData.value()->messageEncryptor->updateKey(keys);
+                streamRoomData.value()->messageEncryptorV2->updateKey(keys);
                 for(const auto& internalSubscription : streamRoomData.value()->subscriptionsIds) {
                     subscriptions.erase(remove(subscriptions.begin(), subscriptions.end(), internalSubscription), subscriptions.end());
                 }
@@ -232,6 +234,7 @@ std::shared_ptr<privmx::endpoint::stream::StreamApiLowImpl::StreamRoomData> Stre
     std::shared_ptr<DataChannelMessageEncryptorV1> dataChannelMessageEncryptorV1;
     std::vector<stream::Key> keys = generateWebRTCKeysFromStreamRoomInfo(streamRoom, streamRoom.data.back().keyId);
     dataChannelMessageEncryptorV1 = std::make_shared<DataChannelMessageEncryptorV1>(keys);
+    auto dataChannelMessageEncryptorV2 = std::make_shared<DataChannelMessageEncryptorV2>(keys);
     webRtc->updateKeys(streamRoomId, keys);
     // setup event listener
     auto internalSubscriptionQuery {_subscriber.getInternalEventsSubscriptionQuery(streamRoomId)};
@@ -240,6 +243,7 @@ std::shared_ptr<privmx::endpoint::stream::StreamApiLowImpl::StreamRoomData> Stre
     _eventMiddleware->notificationEventListenerAddSubscriptionIds(_notificationListenerId, subscriptionsIds);
     std::shared_ptr<StreamRoomData> streamRoomData = std::make_shared<StreamRoomData>(
             dataChannelMessageEncryptorV1,
+            dataChannelMessageEncryptorV2,
             streamRoomId,
             webRtc,
             subscriptionsIds,
@@ -1039,15 +1043,31 @@ std::string StreamApiLowImpl::deriveStreamEncryptionKey(privmx::endpoint::core::
 
 core::Buffer StreamApiLowImpl::encryptDataChannelMessage(const std::string& streamRoomId, const DataChannelMessage& plainMessage) {
     auto room = getStreamRoomData(streamRoomId);
+    if(room->messageVersion == DataChannelMessageEncryptorV2::WIRE_FORMAT_VERSION) {
+        return room->messageEncryptorV2->encryptMessage(plainMessage);
+    }
     return room->messageEncryptor->encryptMessage(plainMessage);
 }
 
 void StreamApiLowImpl::registerRemoteDataChannel(const std::string& streamRoomId, const std::string& remoteStreamId) {
     auto room = getStreamRoomData(streamRoomId);
     room->messageEncryptor->registerRemoteStreamId(remoteStreamId);
+    room->messageEncryptorV2->registerRemoteStreamId(remoteStreamId);
 }
 
 DecryptedDataChannelMessage StreamApiLowImpl::decryptDataChannelMessage(const std::string& streamRoomId, const std::string& remoteStreamId, const core::Buffer& encryptedData) {
     auto room = getStreamRoomData(streamRoomId);
+    // messages of both formats are accepted, the first byte holds the format version
+    if(encryptedData.size() > 0 && static_cast<uint8_t>(encryptedData.stdString()[0]) == DataChannelMessageEncryptorV2::WIRE_FORMAT_VERSION) {
+        return room->messageEncryptorV2->decryptMessage(remoteStreamId, encryptedData);
+    }
     return room->messageEncryptor->decryptMessage(remoteStreamId, encryptedData);
 }
+
+void StreamApiLowImpl::setDataChannelMessageVersion(const std::string& streamRoomId, const int64_t version) {
+    if(version != DataChannelMessageEncryptorV1::WIRE_FORMAT_VERSION && version != DataChannelMessageEncryptorV2::WIRE_FORMAT_VERSION) {
+        throw UnsupportedMessageFormatVersionException();
+    }
+    auto room = getStreamRoomData(streamRoomId);
+    room->messageVersion = version;
+}
@@ -0,0 +1,183 @@
+/*
+PrivMX Endpoint.
+Copyright © 2024 Simplito sp. z o.o.
+
+This file is part of the PrivMX Platform (https://privmx.dev).
+This software is Licensed under the PrivMX Free License.
+
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "privmx/endpoint/stream/encryptors/dataChannel/DataChannelMessageEncryptorV2.hpp"
+#include "privmx/endpoint/stream/StreamException.hpp"
+#include <privmx/endpoint/core/ExceptionConverter.hpp>
+#include <algorithm>
+#include <cstring>
+#include <Poco/ByteOrder.h>
+#include <privmx/crypto/Crypto.hpp>
+
+using namespace privmx::endpoint;
+using namespace privmx::endpoint::stream;
+
+DataChannelMessageEncryptorV2::DataChannelMessageEncryptorV2(const std::vector<Key>& keys): _keys(keys) {}
+
+core::Buffer DataChannelMessageEncryptorV2::encryptMessage(const DataChannelMessage& plainMessage) {
+    std::shared_lock<std::shared_mutex> lock(_keysMutex);
+    const Key& encKey = getEncryptionKey();
+    if(encKey.keyId.size() >= 0xff) {
+        throw InvalidEncryptionKeyIdLengthException();
+    }
+    auto nonce = nextNonce(encKey.keyId);
+    uint64_t headerLength = FIXED_HEADER_LENGTH + encKey.keyId.size();
+    std::string out;
+    out.reserve(headerLength + plainMessage.data.size() + GCM_TAG_LENGTH_BYTES);
+    out.resize(headerLength);
+    char* header = out.data();
+    header[0] = static_cast<char>(WIRE_FORMAT_VERSION);
+    uint32_t seq_be = Poco::ByteOrder::toBigEndian(static_cast<uint32_t>(plainMessage.seq));
+    std::memcpy(header + SEQUENCE_NUMBER_OFFSET, &seq_be, sizeof(seq_be));
+    std::memcpy(header + NONCE_OFFSET, nonce.data(), GCM_NONCE_LENGTH_BYTES);
+    header[KEY_ID_LENGTH_OFFSET] = static_cast<char>(encKey.keyId.size());
+    std::memcpy(header + FIXED_HEADER_LENGTH, encKey.keyId.data(), encKey.keyId.size());
+    out.append(privmx::crypto::Crypto::aes256GcmEncrypt(plainMessage.data.stdString(), encKey.key.stdString(), nonce, out));
+    return core::Buffer::from(std::move(out));
+}
+
+DecryptedDataChannelMessage DataChannelMessageEncryptorV2::decryptMessage(const std::string& remoteStreamId, const core::Buffer& encryptedData) {
+    DecryptedDataChannelMessage result = {core::Buffer(), 0, 0};
+    try {
+        const std::string& in = encryptedData.stdString();
+        assertData(in);
+        uint32_t seq_be = 0;
+        std::memcpy(&seq_be, in.data() + SEQUENCE_NUMBER_OFFSET, sizeof(seq_be));
+        uint32_t seq = Poco::ByteOrder::fromBigEndian(seq_be);
+        result.seq = seq;
+        assertSeq(remoteStreamId, seq);
+        uint64_t headerLength = FIXED_HEADER_LENGTH + static_cast<uint8_t>(in[KEY_ID_LENGTH_OFFSET]);
+        {
+            std::shared_lock<std::shared_mutex> lock(_keysMutex);
+            // key ID, nonce, ciphertext and header (AAD) are read in place, without copying them out of the frame
+            const Key& decKey = getDecryptionKey(std::string_view(in.data() + FIXED_HEADER_LENGTH, headerLength - FIXED_HEADER_LENGTH));
+            result.data = core::Buffer::from(privmx::crypto::Crypto::aes256GcmDecrypt(
+                in.data() + headerLength,
+                in.size() - headerLength,
+                decKey.key.stdString(),
+                in.data() + NONCE_OFFSET,
+                in.data(),
+                headerLength
+            ));
+        }
+        updateSeq(remoteStreamId, seq);
+    }  catch (const privmx::endpoint::core::Exception& e) {
+        result.data = core::Buffer();
+        result.statusCode = e.getCode();
+    } catch (const privmx::utils::PrivmxException& e) {
+        result.data = core::Buffer();
+        result.statusCode = core::ExceptionConverter::convert(e).getCode();
+    } catch (...) {
+        result.data = core::Buffer();
+        result.statusCode = ENDPOINT_CORE_EXCEPTION_CODE;
+    }
+    return result;
+}
+
+void DataChannelMessageEncryptorV2::registerRemoteStreamId(const std::string& remoteStreamId, int64_t initialSeq) {
+    std::lock_guard<std::mutex> lock(_replayWindowsMutex);
+    // everything up to initialSeq is treated as already received
+    _replayWindows[remoteStreamId] = ReplayWindow{.highestSeq = initialSeq, .bitmap = ~uint64_t(0)};
+}
+
+void DataChannelMessageEncryptorV2::updateKey(const std::vector<Key>& keys) {
+    std::unique_lock<std::shared_mutex> lock(_keysMutex);
+    _keys = keys;
+}
+
+std::string DataChannelMessageEncryptorV2::nextNonce(const std::string& keyId) {
+    std::lock_guard<std::mutex> lock(_nonceMutex);
+    if(keyId != _nonceKeyId || _nonceCounter > UINT32_MAX) {
+        // other senders share the key, the random salt keeps their nonces apart
+        _nonceKeyId = keyId;
+        _nonceSalt = privmx::crypto::Crypto::randomBytes(NONCE_SALT_LENGTH_BYTES);
+        _nonceCounter = 0;
+    }
+    std::string nonce(GCM_NONCE_LENGTH_BYTES, 0);
+    std::memcpy(nonce.data(), _nonceSalt.data(), NONCE_SALT_LENGTH_BYTES);
+    uint32_t counter_be = Poco::ByteOrder::toBigEndian(static_cast<uint32_t>(_nonceCounter++));
+    std::memcpy(nonce.data() + NONCE_SALT_LENGTH_BYTES, &counter_be, sizeof(counter_be));
+    return nonce;
+}
+
+void DataChannelMessageEncryptorV2::assertData(const std::string& encryptedData) {
+    if(encryptedData.size() < FIXED_HEADER_LENGTH) {
+        throw InvalidMessageHeaderLengthException();
+    }
+    if(static_cast<uint8_t>(encryptedData[0]) != WIRE_FORMAT_VERSION) {
+        throw UnsupportedMessageFormatVersionException();
+    }
+    if(encryptedData.size() < FIXED_HEADER_LENGTH + static_cast<uint8_t>(encryptedData[KEY_ID_LENGTH_OFFSET]) + GCM_TAG_LENGTH_BYTES) {
+        throw InvalidMessageHeaderLengthException();
+    }
+}
+
+void DataChannelMessageEncryptorV2::assertSeq(const std::string& remoteStreamId, uint32_t seq) {
+    std::lock_guard<std::mutex> lock(_replayWindowsMutex);
+    assertSeq(remoteStreamId, getReplayWindow(remoteStreamId), seq);
+}
+
+void DataChannelMessageEncryptorV2::assertSeq(const std::string& remoteStreamId, const ReplayWindow& window, uint32_t seq) {
+    if(static_cast<int64_t>(seq) > window.highestSeq) {
+        return;
+    }
+    uint64_t age = static_cast<uint64_t>(window.highestSeq - static_cast<int64_t>(seq));
+    if(age >= REPLAY_WINDOW_SIZE || (window.bitmap & (uint64_t(1) << age))) {
+        throw InvalidDataChannelSeqException(
+            "remoteStreamId=" + remoteStreamId +
+            ", currentSeq=" + std::to_string(window.highestSeq) +
+            ", receivedSeq=" + std::to_string(seq)
+        );
+    }
+}
+
+void DataChannelMessageEncryptorV2::updateSeq(const std::string& remoteStreamId, uint32_t seq) {
+    std::lock_guard<std::mutex> lock(_replayWindowsMutex);
+    auto& window = getReplayWindow(remoteStreamId);
+    // checked again under the lock, so a message replayed concurrently is accepted only once
+    assertSeq(remoteStreamId, window, seq);
+    if(static_cast<int64_t>(seq) > window.highestSeq) {
+        uint64_t shift = static_cast<uint64_t>(static_cast<int64_t>(seq) - window.highestSeq);
+        window.bitmap = shift >= REPLAY_WINDOW_SIZE ? 0 : window.bitmap << shift;
+        window.bitmap |= 1;
+        window.highestSeq = seq;
+    } else {
+        window.bitmap |= uint64_t(1) << (window.highestSeq - static_cast<int64_t>(seq));
+    }
+}
+
+DataChannelMessageEncryptorV2::ReplayWindow& DataChannelMessageEncryptorV2::getReplayWindow(const std::string& remoteStreamId) {
+    auto it = _replayWindows.find(remoteStreamId);
+    if(it == _replayWindows.end()) {
+        it = _replayWindows.emplace(remoteStreamId, ReplayWindow{.highestSeq = -1, .bitmap = 0}).first;
+    }
+    return it->second;
+}
+
+const Key& DataChannelMessageEncryptorV2::getEncryptionKey() {
+    auto encKey = std::find_if(_keys.begin(), _keys.end(), 
+        [](const Key& key) {return key.type == KeyType::LOCAL;}
+    );
+    if(encKey != _keys.end()) {
+        return *encKey;
+    }
+    throw NoStreamEncryptionKeyException();
+}
+
+const Key& DataChannelMessageEncryptorV2::getDecryptionKey(std::string_view keyId) {
+    auto decKey = std::find_if(_keys.begin(), _keys.end(), 
+        [&keyId](const Key& key) {return key.keyId == keyId;}
+    );
+    if(decKey != _keys.end()) {
+        return *decKey;
+    }
+    throw NoStreamDecryptionKeyException();
+}
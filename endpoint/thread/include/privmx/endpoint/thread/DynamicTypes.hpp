@@ -73,6 +73,22 @@ JSON_STRUCT_EXT(MessageDataV3, IMessageData, MESSAGE_DATA_V3_FIELDS);
     F(data, MessageDataV3)
 JSON_STRUCT_EXT(MessageDataV3Signed, IMessageDataSigned, MESSAGE_DATA_V3_SIGNED_FIELDS);
 
+// record of the local message cache log, binary fields are base64 encoded
+#define MESSAGE_CACHE_RECORD_FIELDS(F)\
+    F(type,          std::string)\
+    F(threadId,      std::string)\
+    F(messageId,     std::string)\
+    F(createDate,    std::optional<int64_t>)\
+    F(lastUpdate,    std::optional<int64_t>)\
+    F(author,        std::optional<std::string>)\
+    F(publicMeta,    std::optional<std::string>)\
+    F(privateMeta,   std::optional<std::string>)\
+    F(data,          std::optional<std::string>)\
+    F(authorPubKey,  std::optional<std::string>)\
+    F(statusCode,    std::optional<int64_t>)\
+    F(schemaVersion, std::optional<int64_t>)
+JSON_STRUCT(MessageCacheRecord, MESSAGE_CACHE_RECORD_FIELDS);
+
 
 } // dynamic
 } // thread
@@ -0,0 +1,101 @@
+/*
+PrivMX Endpoint.
+Copyright © 2024 Simplito sp. z o.o.
+
+This file is part of the PrivMX Platform (https://privmx.dev).
+This software is Licensed under the PrivMX Free License.
+
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef _PRIVMXLIB_ENDPOINT_THREAD_MESSAGECACHE_HPP_
+#define _PRIVMXLIB_ENDPOINT_THREAD_MESSAGECACHE_HPP_
+
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <privmx/endpoint/core/Types.hpp>
+
+#include "privmx/endpoint/thread/DynamicTypes.hpp"
+#include "privmx/endpoint/thread/Types.hpp"
+
+namespace privmx {
+namespace endpoint {
+namespace thread {
+
+// On-disk cache of decrypted messages. Each Thread has its own append-only log of records
+// encrypted at rest, replayed into an in-memory index ordered by createDate on first use.
+class MessageCache
+{
+public:
+    MessageCache(const std::string& directory, uint64_t maxSize, const std::string& key);
+
+    bool isSynced(const std::string& threadId);
+    void setSynced(const std::string& threadId, bool synced);
+    void invalidateSynced();
+    // date of the last update of every cached message of the Thread, by message ID
+    std::unordered_map<std::string, int64_t> getLastUpdates(const std::string& threadId);
+    void putMany(const std::string& threadId, const std::vector<std::pair<Message, int64_t>>& messages);
+    void put(const Message& message, int64_t lastUpdate);
+    void remove(const std::string& threadId, const std::string& messageId);
+    void removeMany(const std::string& threadId, const std::vector<std::string>& messageIds);
+    void removeMessage(const std::string& messageId);
+    void clear(const std::string& threadId);
+    std::optional<core::PagingList<Message>> list(const std::string& threadId, const core::PagingQuery& pagingQuery);
+
+private:
+    struct Entry {
+        Message message;
+        int64_t lastUpdate;
+        uint64_t recordSize;
+    };
+    struct ThreadLog {
+        std::unordered_map<std::string, Entry> messages;
+        std::set<std::pair<int64_t, std::string>> order;
+        uint64_t fileSize = 0;
+        uint64_t liveSize = 0;
+        bool synced = false;
+    };
+
+    ThreadLog& load(const std::string& threadId);
+    bool isTracked(const std::string& threadId);
+    void replay(const std::string& threadId, ThreadLog& log);
+    void apply(ThreadLog& log, const dynamic::MessageCacheRecord& record, uint64_t recordSize);
+    void append(const std::string& threadId, ThreadLog& log, const std::vector<dynamic::MessageCacheRecord>& records);
+    void compact(const std::string& threadId, ThreadLog& log);
+    // total size and last write time of every log in the directory
+    std::pair<uint64_t, std::vector<std::pair<std::filesystem::file_time_type, std::filesystem::path>>> scanLogs();
+    void enforceSizeLimit(const std::string& threadId);
+    void drop(const std::string& threadId);
+    std::string getLogPath(const std::string& threadId);
+    std::string encodeRecord(const dynamic::MessageCacheRecord& record);
+    static dynamic::MessageCacheRecord toRecord(const Message& message, int64_t lastUpdate);
+    static Message toMessage(const dynamic::MessageCacheRecord& record);
+
+    std::mutex _mutex;
+    std::string _directory;
+    uint64_t _maxSize;
+    uint64_t _totalSize = 0;
+    std::string _key;
+    std::unordered_map<std::string, ThreadLog> _threads;
+
+    static constexpr uint64_t COMPACTION_MIN_SIZE = 1024*1024; // 1MiB
+    static constexpr uint32_t MAX_RECORD_SIZE = 64*1024*1024; // 64MiB
+    inline static const std::string LOG_FILE_EXTENSION = ".mlog";
+    inline static const std::string RECORD_PUT = "put";
+    inline static const std::string RECORD_DELETE = "delete";
+};
+
+} // thread
+} // endpoint
+} // privmx
+
+#endif // _PRIVMXLIB_ENDPOINT_THREAD_MESSAGECACHE_HPP_
@@ -12,10 +12,12 @@ limitations under the License.
 #ifndef _PRIVMXLIB_ENDPOINT_THREAD_THREADAPIIMPL_HPP_
 #define _PRIVMXLIB_ENDPOINT_THREAD_THREADAPIIMPL_HPP_
 
+#include <functional>
 #include <memory>
 #include <optional>
 #include <string>
 #include <atomic>
+#include <mutex>
 
 #include <privmx/endpoint/core/ConnectionImpl.hpp>
 #include <privmx/endpoint/core/encryptors/DataEncryptorV4.hpp>
@@ -36,8 +38,11 @@ limitations under the License.
 #include "privmx/endpoint/core/Factory.hpp"
 #include "privmx/endpoint/thread/Constants.hpp"
 #include "privmx/endpoint/thread/SubscriberImpl.hpp"
+#include "privmx/endpoint/thread/MessageCache.hpp"
 #include "privmx/endpoint/core/ModuleBaseApi.hpp"
+#include "privmx/endpoint/core/PrefetchingCursor.hpp"
 #include "privmx/endpoint/core/ContainerKeyCache.hpp"
+#include "privmx/endpoint/core/UsersKeysResolver.hpp"
 #include <privmx/utils/ManualManagedClass.hpp>
 
 namespace privmx {
@@ -56,6 +61,7 @@ public:
         const core::Connection& connection
     );
     ~ThreadApiImpl();
+    using core::ModuleBaseApi::getAsyncRequestQueue;
     std::string createThread(const std::string& contextId, const std::vector<core::UserWithPubKey>& users,
                              const std::vector<core::UserWithPubKey>& managers, const core::Buffer& publicMeta, const core::Buffer& privateMeta, const std::optional<core::ContainerPolicy>& policies);
     std::string createThreadEx(const std::string& contextId, const std::vector<core::UserWithPubKey>& users,
@@ -64,6 +70,9 @@ public:
     void updateThread(const std::string& threadId, const std::vector<core::UserWithPubKey>& users,
                       const std::vector<core::UserWithPubKey>& managers, const core::Buffer& publicMeta, const core::Buffer& privateMeta,
                       const int64_t version, const bool force, const bool forceGenerateNewKey, const std::optional<core::ContainerPolicy>& policies);
+    void addThreadMembers(const std::string& threadId, const std::vector<core::UserWithPubKey>& users,
+                          const std::vector<core::UserWithPubKey>& managers);
+    void removeThreadMembers(const std::string& threadId, const std::vector<std::string>& userIds);
     void deleteThread(const std::string& threadId);
 
     Thread getThread(const std::string& threadId);
@@ -71,8 +80,11 @@ public:
     core::PagingList<Thread> listThreads(const std::string& contextId, const core::PagingQuery& pagingQuery);
     core::PagingList<Thread> listThreadsEx(const std::string& contextId, const core::PagingQuery& pagingQuery, const std::string& type);
 
-    Message getMessage(const std::string& messageId);
-    core::PagingList<Message> listMessages(const std::string& threadId, const core::PagingQuery& pagingQuery);
+    Message getMessage(const std::string& messageId, int64_t fields = core::DataField::ALL_DATA_FIELDS);
+    core::PagingList<Message> listMessages(const std::string& threadId, const core::PagingQuery& pagingQuery,
+                                           int64_t fields = core::DataField::ALL_DATA_FIELDS);
+    core::CursorPage<Message> fetchMessagesPage(const std::string& threadId, const core::PagingQuery& pagingQuery,
+                                                int64_t fields = core::DataField::ALL_DATA_FIELDS);
     std::string sendMessage(const std::string& threadId, const core::Buffer& publicMeta,
                             const core::Buffer& privateMeta, const core::Buffer& data);
     void deleteMessage(const std::string& messageId);
@@ -82,6 +94,9 @@ public:
     std::vector<std::string> subscribeFor(const std::vector<std::string>& subscriptionQueries);
     void unsubscribeFrom(const std::vector<std::string>& subscriptionIds);
     std::string buildSubscriptionQuery(EventType eventType, EventSelectorType selectorType, const std::string& selectorId);
+
+    void enableMessageCache(const std::string& cacheDirectory, const int64_t maxCacheSize);
+    void syncThread(const std::string& threadId);
 private:
     std::string _createThreadEx(
         const std::string& contextId, 
@@ -93,6 +108,16 @@ private:
         const std::optional<core::ContainerPolicy>& policies
     );
     
+    void updateThreadMembers(const std::string& threadId, const core::ContainerMembersDelta& delta);
+    void updateThreadRequest(
+        const server::ThreadInfo& currentThread,
+        const std::function<std::shared_ptr<core::UsersKeysResolver>(const core::DecryptedEncKeyV2&)>& createUsersKeysResolver,
+        const core::Buffer& publicMeta,
+        const core::Buffer& privateMeta,
+        const int64_t version,
+        const bool force,
+        const std::optional<core::ContainerPolicy>& policies
+    );
     Thread _getThreadEx(const std::string& threadId, const std::string& type);
     core::PagingList<Thread> _listThreadsEx(const std::string& contextId, const core::PagingQuery& pagingQuery, const std::string& type);
 
@@ -123,7 +148,7 @@ private:
     dynamic::MessageDataV2 decryptMessageDataV2(server::Message message, const core::DecryptedEncKey& encKey);
     dynamic::MessageDataV3 decryptMessageDataV3(server::Message message, const core::DecryptedEncKey& encKey);
     DecryptedMessageDataV4 decryptMessageDataV4(server::Message message, const core::DecryptedEncKey& encKey);
-    DecryptedMessageDataV5 decryptMessageDataV5(server::Message message, const core::DecryptedEncKey& encKey);
+    DecryptedMessageDataV5 decryptMessageDataV5(server::Message message, const core::DecryptedEncKey& encKey, int64_t fields);
     Message convertServerMessageToLibMessage(
         server::Message message,
         const core::Buffer& publicMeta = core::Buffer(),
@@ -138,9 +163,13 @@ private:
     Message convertDecryptedMessageDataV4ToMessage(server::Message message, DecryptedMessageDataV4 messageData);
     Message convertDecryptedMessageDataV5ToMessage(server::Message message, DecryptedMessageDataV5 messageData);
     MessageDataSchema::Version getMessagesDataStructureVersion(server::Message message);
-    std::tuple<Message, core::DataIntegrityObject> decryptAndConvertMessageDataToMessage(server::Message message, const core::DecryptedEncKey& encKey);
-    std::vector<Message> validateDecryptAndConvertMessagesDataToMessages(std::vector<server::Message> messages, const core::ModuleKeys& threadKeys);
-    Message validateDecryptAndConvertMessageDataToMessage(server::Message message, const core::ModuleKeys& threadKeys);
+    std::tuple<Message, core::DataIntegrityObject> decryptAndConvertMessageDataToMessage(server::Message message, const core::DecryptedEncKey& encKey, int64_t fields);
+    std::vector<Message> validateDecryptAndConvertMessagesDataToMessages(std::vector<server::Message> messages, const core::ModuleKeys& threadKeys,
+                                                                         int64_t fields = core::DataField::ALL_DATA_FIELDS);
+    Message validateDecryptAndConvertMessageDataToMessage(server::Message message, const core::ModuleKeys& threadKeys,
+                                                          int64_t fields = core::DataField::ALL_DATA_FIELDS);
+    // clears the fields of a message decrypted in full, e.g. from an older data version or from the cache
+    static Message selectMessageFields(Message message, int64_t fields);
     core::ModuleKeys getMessageDecryptionKeys(server::Message message);
     uint32_t validateMessageDataIntegrity(server::Message message, const std::string& threadResourceId);
     Poco::Dynamic::Var encryptMessageData(
@@ -169,6 +198,12 @@ private:
     );
 
     void assertThreadExist(const std::string& threadId);
+    core::PagingList<Message> listMessagesFromServer(const std::string& threadId, const core::PagingQuery& pagingQuery, int64_t fields);
+    std::string syncThreadMessages(const std::shared_ptr<MessageCache>& cache, const std::string& threadId);
+    bool isSubscribedForMessages(const std::string& threadId, const std::string& contextId);
+    static int64_t getMessageLastUpdate(const server::Message& message);
+    void putOwnMessageInCache(const std::string& threadId, const std::string& messageId);
+    std::shared_ptr<MessageCache> getMessageCache();
 
     privfs::RpcGateway::Ptr _gateway;
     privmx::crypto::PrivateKey _userPrivKey;
@@ -176,6 +211,7 @@ private:
     std::string _host;
     std::shared_ptr<core::EventMiddleware> _eventMiddleware;
     core::Connection _connection;
+    std::shared_ptr<core::ContainerMembersUpdater> _containerMembersUpdater;
     ServerApi _serverApi;
     core::DataEncryptor<dynamic::ThreadDataV1> _dataEncryptorThread;
     MessageDataV2Encryptor _messageDataV2Encryptor;
@@ -184,6 +220,7 @@ private:
     SubscriberImpl _subscriber;
 
     int _notificationListenerId, _connectedListenerId, _disconnectedListenerId;
+    int _containerMembersHandlerId;
     std::string _messageDecryptorId, _messageDeleterId;
     MessageDataEncryptorV4 _messageDataEncryptorV4;
     core::ModuleDataEncryptorV4 _threadDataEncryptorV4;
@@ -191,8 +228,11 @@ private:
     core::ModuleDataEncryptorV5 _threadDataEncryptorV5;
     core::DataEncryptorV4 _eventDataEncryptorV4;
     std::vector<std::string> _forbiddenChannelsNames;
+    std::mutex _messageCacheMutex;
+    std::shared_ptr<MessageCache> _messageCache;
 
     inline static const std::string THREAD_TYPE_FILTER_FLAG = "thread";
+    static constexpr int64_t MESSAGE_CACHE_SYNC_PAGE_SIZE = 100;
 };
 
 } // thread
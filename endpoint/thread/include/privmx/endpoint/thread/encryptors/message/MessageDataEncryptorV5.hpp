@@ -32,9 +32,12 @@ public:
         const crypto::PrivateKey& authorPrivateKey,
         const std::string& encryptionKey
     );
-    DecryptedMessageDataV5 decrypt(const server::EncryptedMessageDataV5& encryptedMessageData, const std::string& encryptionKey);
+    // selectedFields is a bitmask of core::DataField, the fields left out stay empty
+    DecryptedMessageDataV5 decrypt(const server::EncryptedMessageDataV5& encryptedMessageData, const std::string& encryptionKey,
+                                   int64_t selectedFields = core::DataField::ALL_DATA_FIELDS);
     DecryptedMessageDataV5 extractPublic(const server::EncryptedMessageDataV5& encryptedMessageData);
     core::DataIntegrityObject getDIOAndAssertIntegrity(const server::EncryptedMessageDataV5& encryptedMessageData);
+    void setCompressor(const std::shared_ptr<const core::DataCompressor>& compressor);
 private:
     void assertDataFormat(const server::EncryptedMessageDataV5& encryptedThreadData);
     core::DataEncryptorV4 _dataEncryptor;
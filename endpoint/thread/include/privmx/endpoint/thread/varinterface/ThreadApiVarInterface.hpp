@@ -43,6 +43,10 @@ public:
         SubscribeFor = 15,
         UnsubscribeFrom = 16,
         BuildSubscriptionQuery = 17,
+        EnableMessageCache = 18,
+        SyncThread = 19,
+        AddThreadMembers = 20,
+        RemoveThreadMembers = 21,
     };
 
     ThreadApiVarInterface(core::Connection connection, const core::VarSerializer& serializer)
@@ -51,6 +55,8 @@ public:
     Poco::Dynamic::Var create(const Poco::Dynamic::Var& args);
     Poco::Dynamic::Var createThread(const Poco::Dynamic::Var& args);
     Poco::Dynamic::Var updateThread(const Poco::Dynamic::Var& args);
+    Poco::Dynamic::Var addThreadMembers(const Poco::Dynamic::Var& args);
+    Poco::Dynamic::Var removeThreadMembers(const Poco::Dynamic::Var& args);
     Poco::Dynamic::Var deleteThread(const Poco::Dynamic::Var& args);
     Poco::Dynamic::Var getThread(const Poco::Dynamic::Var& args);
     Poco::Dynamic::Var listThreads(const Poco::Dynamic::Var& args);
@@ -62,6 +68,8 @@ public:
     Poco::Dynamic::Var subscribeFor(const Poco::Dynamic::Var& args);
     Poco::Dynamic::Var unsubscribeFrom(const Poco::Dynamic::Var& args);
     Poco::Dynamic::Var buildSubscriptionQuery(const Poco::Dynamic::Var& args);
+    Poco::Dynamic::Var enableMessageCache(const Poco::Dynamic::Var& args);
+    Poco::Dynamic::Var syncThread(const Poco::Dynamic::Var& args);
 
 
     Poco::Dynamic::Var exec(METHOD method, const Poco::Dynamic::Var& args);
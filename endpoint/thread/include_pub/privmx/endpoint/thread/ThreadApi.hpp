@@ -7,6 +7,8 @@
 #include <vector>
 
 #include "privmx/endpoint/core/Connection.hpp"
+#include "privmx/endpoint/core/Cursor.hpp"
+#include "privmx/endpoint/core/Future.hpp"
 #include "privmx/endpoint/core/Types.hpp"
 #include "privmx/endpoint/thread/Types.hpp"
 #include <privmx/endpoint/core/ExtendedPointer.hpp>
@@ -74,6 +76,26 @@ public:
                       const std::vector<core::UserWithPubKey>& managers, const core::Buffer& publicMeta, const core::Buffer& privateMeta,
                       const int64_t version, const bool force, const bool forceGenerateNewKey, const std::optional<core::ContainerPolicy>& policies = std::nullopt);
 
+    /**
+     * Gives users access to an existing Thread, without changing its other members and metadata.
+     *
+     * @param threadId ID of the Thread to update
+     * @param users vector of UserWithPubKey structs which indicates who will get access to the Thread
+     * @param managers vector of UserWithPubKey structs which indicates who will get access (and management rights) to
+     * the Thread
+     */
+    void addThreadMembers(const std::string& threadId, const std::vector<core::UserWithPubKey>& users,
+                          const std::vector<core::UserWithPubKey>& managers);
+
+    /**
+     * Takes away access to an existing Thread from the given users, both as users and managers.
+     * The Thread gets a new key, which is shared with the remaining members using their public keys from the Context.
+     *
+     * @param threadId ID of the Thread to update
+     * @param userIds IDs of the users to remove
+     */
+    void removeThreadMembers(const std::string& threadId, const std::vector<std::string>& userIds);
+
     /**
      * Deletes a Thread by given Thread ID.
      *
@@ -102,18 +124,44 @@ public:
      * Gets a message by given message ID.
      *
      * @param ID of the message to get
+     * @param fields bitmask of core::DataField fields to decrypt, the other fields of the message are returned empty
      * @return struct containing the message
      */
-    Message getMessage(const std::string& messageId);
+    Message getMessage(const std::string& messageId, int64_t fields = core::DataField::ALL_DATA_FIELDS);
+
+    /**
+     * Gets a message by given message ID without waiting for the result.
+     *
+     * @param messageId ID of the message to get
+     * @param options options of the call, e.g. its timeout
+     * @return future result: struct containing the message
+     */
+    core::Future<Message> getMessageAsync(const std::string& messageId, const core::AsyncCallOptions& options = {});
     
     /**
      * Gets a list of messages from a Thread.
      *
      * @param threadId ID of the Thread to list messages from
      * @param pagingQuery struct with list query parameters
+     * @param fields bitmask of core::DataField fields to decrypt, e.g. only PUBLIC_META for a list showing titles;
+     * the other fields are returned empty and can be read later with getMessage()
      * @return struct containing a list of messages
      */
-    core::PagingList<Message> listMessages(const std::string& threadId, const core::PagingQuery& pagingQuery);
+    core::PagingList<Message> listMessages(const std::string& threadId, const core::PagingQuery& pagingQuery,
+                            int64_t fields = core::DataField::ALL_DATA_FIELDS);
+
+    /**
+     * Opens a cursor reading all the messages of a Thread page by page.
+     * The following pages are downloaded in the background while the application processes the current one.
+     *
+     * @param threadId ID of the Thread to read messages from
+     * @param pagingQuery struct with list query parameters of the first page, its limit is the size of every page
+     * @param pagesAhead maximum number of pages downloaded ahead of the page being read
+     * @param fields bitmask of core::DataField fields to decrypt, the other fields are returned empty
+     * @return cursor returning the next page on every next() call
+     */
+    core::Cursor<Message> openMessageCursor(const std::string& threadId, const core::PagingQuery& pagingQuery,
+                            int64_t pagesAhead = core::DEFAULT_CURSOR_PAGES_AHEAD, int64_t fields = core::DataField::ALL_DATA_FIELDS);
     
     /**
      * Sends a message in a Thread.
@@ -126,6 +174,21 @@ public:
      */
     std::string sendMessage(const std::string& threadId, const core::Buffer& publicMeta,
                             const core::Buffer& privateMeta, const core::Buffer& data);
+
+    /**
+     * Sends a message in a Thread without waiting for the result.
+     * Many messages can be sent at the same time, up to the limit set by Connection::setAsyncOptions(),
+     * so the order in which they are stored in the Thread may differ from the order of the calls.
+     *
+     * @param threadId ID of the Thread to send message to
+     * @param publicMeta public message metadata
+     * @param privateMeta private message metadata
+     * @param data content of the message
+     * @param options options of the call, e.g. its timeout
+     * @return future result: ID of the new message
+     */
+    core::Future<std::string> sendMessageAsync(const std::string& threadId, const core::Buffer& publicMeta,
+                            const core::Buffer& privateMeta, const core::Buffer& data, const core::AsyncCallOptions& options = {});
     
     /**
      * Deletes a message by given message ID.
@@ -167,6 +230,27 @@ public:
      */
     std::string buildSubscriptionQuery(EventType eventType, EventSelectorType selectorType, const std::string& selectorId);
 
+    /**
+     * Enables the local cache of decrypted messages.
+     * Messages are stored on disk encrypted with a key derived from the user's private key.
+     * After syncThread() the messages of the Thread are listed from the cache and kept up to date by events,
+     * as long as the message events of the Thread (create, update and delete) are subscribed.
+     * Messages sent or updated through this API are put in the cache right away.
+     *
+     * @param cacheDirectory path of the directory to store the cache in, each user of each server gets a subdirectory
+     * @param maxCacheSize maximum size of the cache of the user on disk in bytes
+     */
+    void enableMessageCache(const std::string& cacheDirectory, const int64_t maxCacheSize);
+
+    /**
+     * Synchronizes the local message cache of the Thread with the server.
+     * Only new messages and messages updated since they were cached are decrypted, deleted messages are removed.
+     * The cache is used by listMessages() only when the message events of the Thread are subscribed.
+     *
+     * @param threadId ID of the Thread to synchronize
+     */
+    void syncThread(const std::string& threadId);
+
 private:
     ThreadApi(const std::shared_ptr<ThreadApiImpl>& impl);
 };
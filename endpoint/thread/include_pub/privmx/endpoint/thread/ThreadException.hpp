@@ -58,6 +58,8 @@ DECLARE_ENDPOINT_EXCEPTION(EndpointThreadException, MessageDataIntegrityExceptio
 DECLARE_ENDPOINT_EXCEPTION(EndpointThreadException, ThreadEncryptionKeyValidationException, "Failed Thread encryption key validation", 0x0016)
 DECLARE_ENDPOINT_EXCEPTION(EndpointThreadException, NotImplementedException, "Not Implemented", 0x0017)
 DECLARE_ENDPOINT_EXCEPTION(EndpointThreadException, InvalidSubscriptionQueryException, "Invalid subscriptionQuery", 0x0018)
+DECLARE_ENDPOINT_EXCEPTION(EndpointThreadException, MessageCacheNotEnabledException, "Message cache is not enabled", 0x0019)
+DECLARE_ENDPOINT_EXCEPTION(EndpointThreadException, MessageCacheInitFailedException, "Cannot initialize message cache", 0x001A)
 
 } // thread
 } // endpoint
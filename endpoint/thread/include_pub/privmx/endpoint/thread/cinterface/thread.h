@@ -13,6 +13,8 @@ typedef struct ThreadApi ThreadApi;
 int privmx_endpoint_newThreadApi(Connection* connectionPtr, ThreadApi** outPtr);
 int privmx_endpoint_freeThreadApi(ThreadApi* ptr);
 int privmx_endpoint_execThreadApi(ThreadApi* ptr, int method, const pson_value* args, pson_value** res);
+int privmx_endpoint_threadSendMessage(ThreadApi* ptr, const char* threadId, privmx_const_buffer publicMeta,
+    privmx_const_buffer privateMeta, privmx_const_buffer data, privmx_buffer* outMessageId, privmx_error* error);
 
 #ifdef __cplusplus
 }
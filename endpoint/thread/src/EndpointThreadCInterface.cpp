@@ -39,6 +39,22 @@ int privmx_endpoint_freeThreadApi(ThreadApi* ptr) {
     return 1;
 }
 
+int privmx_endpoint_threadSendMessage(ThreadApi* ptr, const char* threadId, privmx_const_buffer publicMeta,
+    privmx_const_buffer privateMeta, privmx_const_buffer data, privmx_buffer* outMessageId, privmx_error* error)
+{
+    return CApiExecutor::execBinaryFunc(error, [&]{
+        CApiExecutor::assertNotNull(ptr, "ptr");
+        CApiExecutor::assertNotNull(outMessageId, "outMessageId");
+        thread::ThreadApiVarInterface* _ptr = (thread::ThreadApiVarInterface*)ptr;
+        *outMessageId = CApiExecutor::toBuffer(_ptr->getApi().sendMessage(
+            CApiExecutor::toString(threadId, "threadId"),
+            CApiExecutor::toCoreBuffer(publicMeta, "publicMeta"),
+            CApiExecutor::toCoreBuffer(privateMeta, "privateMeta"),
+            CApiExecutor::toCoreBuffer(data, "data")
+        ));
+    });
+}
+
 int privmx_endpoint_execThreadApi(ThreadApi* ptr, int method, const pson_value* args, pson_value** res) {
     return CApiExecutor::execFunc(res, [&]{
         thread::ThreadApiVarInterface* _ptr = (thread::ThreadApiVarInterface*)ptr;
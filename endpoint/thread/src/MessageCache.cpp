@@ -0,0 +1,407 @@
+/*
+PrivMX Endpoint.
+Copyright © 2024 Simplito sp. z o.o.
+
+This file is part of the PrivMX Platform (https://privmx.dev).
+This software is Licensed under the PrivMX Free License.
+
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+#include <privmx/crypto/Crypto.hpp>
+#include <privmx/utils/Logger.hpp>
+#include <privmx/utils/Utils.hpp>
+
+#include "privmx/endpoint/thread/MessageCache.hpp"
+#include "privmx/endpoint/thread/ThreadException.hpp"
+
+using namespace privmx::endpoint;
+using namespace privmx::endpoint::thread;
+
+MessageCache::MessageCache(const std::string& directory, uint64_t maxSize, const std::string& key) :
+    _directory(directory), _maxSize(maxSize), _key(key)
+{
+    std::error_code ec;
+    std::filesystem::create_directories(_directory, ec);
+    if (ec || !std::filesystem::is_directory(_directory, ec)) {
+        throw MessageCacheInitFailedException(_directory + ": " + ec.message());
+    }
+    _totalSize = scanLogs().first;
+}
+
+bool MessageCache::isSynced(const std::string& threadId) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _threads.find(threadId);
+    return it != _threads.end() && it->second.synced;
+}
+
+void MessageCache::setSynced(const std::string& threadId, bool synced) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _threads.find(threadId);
+    if (it != _threads.end()) {
+        it->second.synced = synced;
+    }
+}
+
+void MessageCache::invalidateSynced() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (auto& [threadId, log] : _threads) {
+        log.synced = false;
+    }
+}
+
+std::unordered_map<std::string, int64_t> MessageCache::getLastUpdates(const std::string& threadId) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    std::unordered_map<std::string, int64_t> result;
+    for (const auto& [messageId, entry] : load(threadId).messages) {
+        result.emplace(messageId, entry.lastUpdate);
+    }
+    return result;
+}
+
+void MessageCache::putMany(const std::string& threadId, const std::vector<std::pair<Message, int64_t>>& messages) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto& log = load(threadId);
+    std::vector<dynamic::MessageCacheRecord> records;
+    for (const auto& [message, lastUpdate] : messages) {
+        records.push_back(toRecord(message, lastUpdate));
+    }
+    append(threadId, log, records);
+    enforceSizeLimit(threadId);
+}
+
+void MessageCache::put(const Message& message, int64_t lastUpdate) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!isTracked(message.info.threadId)) {
+        return;
+    }
+    auto& log = load(message.info.threadId);
+    append(message.info.threadId, log, {toRecord(message, lastUpdate)});
+    enforceSizeLimit(message.info.threadId);
+}
+
+void MessageCache::remove(const std::string& threadId, const std::string& messageId) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!isTracked(threadId)) {
+        return;
+    }
+    auto& log = load(threadId);
+    if (log.messages.find(messageId) == log.messages.end()) {
+        return;
+    }
+    dynamic::MessageCacheRecord record;
+    record.type = RECORD_DELETE;
+    record.threadId = threadId;
+    record.messageId = messageId;
+    append(threadId, log, {record});
+}
+
+void MessageCache::removeMany(const std::string& threadId, const std::vector<std::string>& messageIds) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto& log = load(threadId);
+    std::vector<dynamic::MessageCacheRecord> records;
+    for (const auto& messageId : messageIds) {
+        dynamic::MessageCacheRecord record;
+        record.type = RECORD_DELETE;
+        record.threadId = threadId;
+        record.messageId = messageId;
+        records.push_back(record);
+    }
+    append(threadId, log, records);
+}
+
+void MessageCache::removeMessage(const std::string& messageId) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (auto& [threadId, log] : _threads) {
+        if (log.messages.find(messageId) != log.messages.end()) {
+            dynamic::MessageCacheRecord record;
+            record.type = RECORD_DELETE;
+            record.threadId = threadId;
+            record.messageId = messageId;
+            append(threadId, log, {record});
+            return;
+        }
+    }
+}
+
+void MessageCache::clear(const std::string& threadId) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    drop(threadId);
+}
+
+std::optional<core::PagingList<Message>> MessageCache::list(const std::string& threadId, const core::PagingQuery& pagingQuery) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _threads.find(threadId);
+    if (it == _threads.end() || !it->second.synced) {
+        return std::nullopt;
+    }
+    // only the default ordering by createDate can be served from the cache
+    if (pagingQuery.queryAsJson.has_value() || (pagingQuery.sortBy.has_value() && pagingQuery.sortBy.value() != "createDate")) {
+        return std::nullopt;
+    }
+    if (pagingQuery.sortOrder != "asc" && pagingQuery.sortOrder != "desc") {
+        return std::nullopt;
+    }
+    auto& log = it->second;
+    std::vector<const std::pair<int64_t, std::string>*> ordered;
+    ordered.reserve(log.order.size());
+    if (pagingQuery.sortOrder == "asc") {
+        for (auto key = log.order.begin(); key != log.order.end(); ++key) ordered.push_back(&(*key));
+    } else {
+        for (auto key = log.order.rbegin(); key != log.order.rend(); ++key) ordered.push_back(&(*key));
+    }
+    size_t start = 0;
+    if (pagingQuery.lastId.has_value()) {
+        auto last = std::find_if(ordered.begin(), ordered.end(), [&](const auto* key) { return key->second == pagingQuery.lastId.value(); });
+        if (last == ordered.end()) {
+            return std::nullopt;
+        }
+        start = std::distance(ordered.begin(), last) + 1;
+    }
+    start += std::max<int64_t>(pagingQuery.skip, 0);
+    std::vector<Message> readItems;
+    for (size_t i = start; i < ordered.size() && (int64_t)readItems.size() < pagingQuery.limit; i++) {
+        readItems.push_back(log.messages.at(ordered[i]->second).message);
+    }
+    return core::PagingList<Message>({
+        .totalAvailable = (int64_t)log.messages.size(),
+        .readItems = readItems
+    });
+}
+
+MessageCache::ThreadLog& MessageCache::load(const std::string& threadId) {
+    auto it = _threads.find(threadId);
+    if (it != _threads.end()) {
+        return it->second;
+    }
+    auto& log = _threads[threadId];
+    replay(threadId, log);
+    return log;
+}
+
+bool MessageCache::isTracked(const std::string& threadId) {
+    if (_threads.find(threadId) != _threads.end()) {
+        return true;
+    }
+    std::error_code ec;
+    return std::filesystem::exists(getLogPath(threadId), ec);
+}
+
+void MessageCache::replay(const std::string& threadId, ThreadLog& log) {
+    auto path = getLogPath(threadId);
+    std::ifstream input(path, std::ios::binary);
+    if (!input.is_open()) {
+        return;
+    }
+    std::string content((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+    input.close();
+    size_t pos = 0;
+    try {
+        while (pos < content.size()) {
+            if (content.size() - pos < 4) {
+                throw MessageCacheInitFailedException("truncated record header");
+            }
+            uint32_t size = ((uint32_t)(uint8_t)content[pos] << 24) | ((uint32_t)(uint8_t)content[pos + 1] << 16) |
+                ((uint32_t)(uint8_t)content[pos + 2] << 8) | (uint32_t)(uint8_t)content[pos + 3];
+            if (size > MAX_RECORD_SIZE || content.size() - pos - 4 < size) {
+                throw MessageCacheInitFailedException("truncated record");
+            }
+            auto plain = privmx::crypto::Crypto::aes256CbcHmac256Decrypt(content.substr(pos + 4, size), _key);
+            auto record = dynamic::MessageCacheRecord::deserialize(plain);
+            if (record.threadId != threadId) {
+                throw MessageCacheInitFailedException("record of other Thread");
+            }
+            apply(log, record, size + 4);
+            pos += size + 4;
+        }
+    } catch (...) {
+        // corrupted or foreign log, the Thread is synced again from the server
+        LOG_WARN("MessageCache: dropping corrupted log of Thread " + threadId)
+        log = ThreadLog();
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+        _totalSize -= std::min<uint64_t>(_totalSize, content.size());
+        return;
+    }
+    log.fileSize = content.size();
+}
+
+void MessageCache::apply(ThreadLog& log, const dynamic::MessageCacheRecord& record, uint64_t recordSize) {
+    auto it = log.messages.find(record.messageId);
+    if (it != log.messages.end()) {
+        log.order.erase({it->second.message.info.createDate, record.messageId});
+        log.liveSize -= it->second.recordSize;
+        log.messages.erase(it);
+    }
+    if (record.type == RECORD_PUT) {
+        auto message = toMessage(record);
+        log.order.insert({message.info.createDate, record.messageId});
+        // records written before the last update was stored are always refetched
+        log.messages.emplace(record.messageId, Entry{std::move(message), record.lastUpdate.value_or(-1), recordSize});
+        log.liveSize += recordSize;
+    }
+}
+
+void MessageCache::append(const std::string& threadId, ThreadLog& log, const std::vector<dynamic::MessageCacheRecord>& records) {
+    std::string buffer;
+    for (const auto& record : records) {
+        auto encoded = encodeRecord(record);
+        apply(log, record, encoded.size());
+        buffer.append(encoded);
+    }
+    if (buffer.empty()) {
+        return;
+    }
+    std::ofstream output(getLogPath(threadId), std::ios::binary | std::ios::app);
+    output.write(buffer.data(), buffer.size());
+    output.close();
+    if (output.fail()) {
+        LOG_WARN("MessageCache: cannot write log of Thread " + threadId)
+        drop(threadId);
+        return;
+    }
+    log.fileSize += buffer.size();
+    _totalSize += buffer.size();
+    if (log.fileSize > COMPACTION_MIN_SIZE && log.fileSize > 2 * log.liveSize) {
+        compact(threadId, log);
+    }
+}
+
+void MessageCache::compact(const std::string& threadId, ThreadLog& log) {
+    auto path = getLogPath(threadId);
+    auto tmpPath = path + ".tmp";
+    std::string buffer;
+    for (auto& [messageId, entry] : log.messages) {
+        auto encoded = encodeRecord(toRecord(entry.message, entry.lastUpdate));
+        entry.recordSize = encoded.size();
+        buffer.append(encoded);
+    }
+    std::ofstream output(tmpPath, std::ios::binary | std::ios::trunc);
+    output.write(buffer.data(), buffer.size());
+    output.close();
+    std::error_code ec;
+    if (output.fail()) {
+        std::filesystem::remove(tmpPath, ec);
+        return;
+    }
+    std::filesystem::rename(tmpPath, path, ec);
+    if (ec) {
+        std::filesystem::remove(tmpPath, ec);
+        return;
+    }
+    _totalSize -= std::min<uint64_t>(_totalSize, log.fileSize - buffer.size());
+    log.fileSize = buffer.size();
+    log.liveSize = buffer.size();
+}
+
+std::pair<uint64_t, std::vector<std::pair<std::filesystem::file_time_type, std::filesystem::path>>> MessageCache::scanLogs() {
+    std::error_code ec;
+    std::vector<std::pair<std::filesystem::file_time_type, std::filesystem::path>> logs;
+    uint64_t totalSize = 0;
+    for (const auto& file : std::filesystem::directory_iterator(_directory, ec)) {
+        if (file.path().extension() != LOG_FILE_EXTENSION) continue;
+        totalSize += file.file_size(ec);
+        logs.push_back({file.last_write_time(ec), file.path()});
+    }
+    return {totalSize, logs};
+}
+
+void MessageCache::enforceSizeLimit(const std::string& threadId) {
+    // the directory is scanned only when the running total says the limit is exceeded
+    if (_totalSize <= _maxSize) {
+        return;
+    }
+    std::error_code ec;
+    auto [totalSize, logs] = scanLogs();
+    _totalSize = totalSize;
+    if (totalSize <= _maxSize) {
+        return;
+    }
+    // evict the least recently written logs, the current Thread goes last
+    std::sort(logs.begin(), logs.end());
+    auto currentPath = std::filesystem::path(getLogPath(threadId));
+    std::stable_partition(logs.begin(), logs.end(), [&](const auto& log) { return log.second != currentPath; });
+    for (const auto& log : logs) {
+        if (totalSize <= _maxSize) break;
+        const auto& path = log.second;
+        auto size = std::filesystem::file_size(path, ec);
+        auto evicted = std::find_if(_threads.begin(), _threads.end(), [&](const auto& thread) {
+            return std::filesystem::path(getLogPath(thread.first)) == path;
+        });
+        if (evicted != _threads.end()) {
+            drop(evicted->first);
+        } else {
+            std::filesystem::remove(path, ec);
+        }
+        totalSize -= std::min(totalSize, size);
+    }
+    _totalSize = totalSize;
+}
+
+void MessageCache::drop(const std::string& threadId) {
+    // threadId may be a key of _threads, so the path is taken before erasing it
+    auto path = getLogPath(threadId);
+    _threads.erase(threadId);
+    std::error_code ec;
+    auto size = std::filesystem::file_size(path, ec);
+    if (!ec && std::filesystem::remove(path, ec)) {
+        _totalSize -= std::min<uint64_t>(_totalSize, size);
+    }
+}
+
+std::string MessageCache::getLogPath(const std::string& threadId) {
+    return (std::filesystem::path(_directory) / (utils::Hex::from(privmx::crypto::Crypto::sha256(threadId)) + LOG_FILE_EXTENSION)).string();
+}
+
+std::string MessageCache::encodeRecord(const dynamic::MessageCacheRecord& record) {
+    auto encrypted = privmx::crypto::Crypto::aes256CbcHmac256Encrypt(record.serialize(), _key);
+    uint32_t size = encrypted.size();
+    std::string result;
+    result.reserve(size + 4);
+    result.push_back((char)(size >> 24));
+    result.push_back((char)(size >> 16));
+    result.push_back((char)(size >> 8));
+    result.push_back((char)size);
+    result.append(encrypted);
+    return result;
+}
+
+dynamic::MessageCacheRecord MessageCache::toRecord(const Message& message, int64_t lastUpdate) {
+    dynamic::MessageCacheRecord record;
+    record.type = RECORD_PUT;
+    record.threadId = message.info.threadId;
+    record.messageId = message.info.messageId;
+    record.createDate = message.info.createDate;
+    record.lastUpdate = lastUpdate;
+    record.author = message.info.author;
+    record.publicMeta = utils::Base64::from(message.publicMeta.stdString());
+    record.privateMeta = utils::Base64::from(message.privateMeta.stdString());
+    record.data = utils::Base64::from(message.data.stdString());
+    record.authorPubKey = message.authorPubKey;
+    record.statusCode = message.statusCode;
+    record.schemaVersion = message.schemaVersion;
+    return record;
+}
+
+Message MessageCache::toMessage(const dynamic::MessageCacheRecord& record) {
+    return Message{
+        .info = ServerMessageInfo{
+            .threadId = record.threadId,
+            .messageId = record.messageId,
+            .createDate = record.createDate.value_or(0),
+            .author = record.author.value_or(std::string())
+        },
+        .publicMeta = core::Buffer::from(utils::Base64::toString(record.publicMeta.value_or(std::string()))),
+        .privateMeta = core::Buffer::from(utils::Base64::toString(record.privateMeta.value_or(std::string()))),
+        .data = core::Buffer::from(utils::Base64::toString(record.data.value_or(std::string()))),
+        .authorPubKey = record.authorPubKey.value_or(std::string()),
+        .statusCode = record.statusCode.value_or(0),
+        .schemaVersion = record.schemaVersion.value_or(0)
+    };
+}
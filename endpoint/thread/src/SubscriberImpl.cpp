@@ -109,4 +109,8 @@ void SubscriberImpl::assertQuery(const std::vector<core::SubscriptionQueryObj>&
             throw InvalidSubscriptionQueryException();
         }
     }
-}
\ No newline at end of file
+}
+
+bool SubscriberImpl::isSubscribedFor(const std::string& subscriptionQuery) {
+    return hasSubscriptionForChannel(transform({core::SubscriptionQueryObj(subscriptionQuery)}).front());
+}
@@ -96,6 +96,37 @@ void ThreadApi::updateThread(
     }
 }
 
+void ThreadApi::addThreadMembers(
+    const std::string& threadId,
+    const std::vector<core::UserWithPubKey>& users,
+    const std::vector<core::UserWithPubKey>& managers
+) {
+    auto impl = getImpl();
+    core::Validator::validateId(threadId, "field:threadId ");
+    core::Validator::validateClass<std::vector<core::UserWithPubKey>>(users, "field:users ");
+    core::Validator::validateClass<std::vector<core::UserWithPubKey>>(managers, "field:managers ");
+    try {
+        impl->addThreadMembers(threadId, users, managers);
+    } catch (const privmx::utils::PrivmxException& e) {
+        core::ExceptionConverter::rethrowAsCoreException(e);
+        throw core::Exception("ExceptionConverter rethrow error");
+    }
+}
+
+void ThreadApi::removeThreadMembers(const std::string& threadId, const std::vector<std::string>& userIds) {
+    auto impl = getImpl();
+    core::Validator::validateId(threadId, "field:threadId ");
+    for (const auto& userId : userIds) {
+        core::Validator::validateId(userId, "field:userIds ");
+    }
+    try {
+        impl->removeThreadMembers(threadId, userIds);
+    } catch (const privmx::utils::PrivmxException& e) {
+        core::ExceptionConverter::rethrowAsCoreException(e);
+        throw core::Exception("ExceptionConverter rethrow error");
+    }
+}
+
 void ThreadApi::deleteThread(const std::string& threadId) {
     auto impl = getImpl();
     core::Validator::validateId(threadId, "field:threadId ");
@@ -130,29 +161,60 @@ core::PagingList<Thread> ThreadApi::listThreads(const std::string& contextId, co
     }
 }
 
-Message ThreadApi::getMessage(const std::string& messageId) {
+Message ThreadApi::getMessage(const std::string& messageId, int64_t fields) {
     auto impl = getImpl();
     core::Validator::validateId(messageId, "field:messageId ");
+    core::Validator::validateDataFields(fields, "field:fields ");
     try {
-        return impl->getMessage(messageId);
+        return impl->getMessage(messageId, fields);
     } catch (const privmx::utils::PrivmxException& e) {
         core::ExceptionConverter::rethrowAsCoreException(e);
         throw core::Exception("ExceptionConverter rethrow error");
     }
 }
 
-core::PagingList<Message> ThreadApi::listMessages(const std::string& threadId, const core::PagingQuery& pagingQuery) {
+core::Future<Message> ThreadApi::getMessageAsync(const std::string& messageId, const core::AsyncCallOptions& options) {
+    auto impl = getImpl();
+    core::Validator::validateId(messageId, "field:messageId ");
+    return impl->getAsyncRequestQueue()->submit<Message>([impl, messageId]() {
+        try {
+            return impl->getMessage(messageId);
+        } catch (const privmx::utils::PrivmxException& e) {
+            core::ExceptionConverter::rethrowAsCoreException(e);
+            throw core::Exception("ExceptionConverter rethrow error");
+        }
+    }, options);
+}
+
+core::PagingList<Message> ThreadApi::listMessages(const std::string& threadId, const core::PagingQuery& pagingQuery, int64_t fields) {
     auto impl = getImpl();
     core::Validator::validateId(threadId, "field:threadId ");
     core::Validator::validatePagingQuery(pagingQuery, {"createDate", "updates"}, "field:pagingQuery ");
+    core::Validator::validateDataFields(fields, "field:fields ");
     try {
-        return impl->listMessages(threadId, pagingQuery);
+        return impl->listMessages(threadId, pagingQuery, fields);
     } catch (const privmx::utils::PrivmxException& e) {
         core::ExceptionConverter::rethrowAsCoreException(e);
         throw core::Exception("ExceptionConverter rethrow error");
     }
 }
 
+core::Cursor<Message> ThreadApi::openMessageCursor(const std::string& threadId, const core::PagingQuery& pagingQuery, int64_t pagesAhead, int64_t fields) {
+    auto impl = getImpl();
+    core::Validator::validateId(threadId, "field:threadId ");
+    core::Validator::validatePagingQuery(pagingQuery, {"createDate", "updates"}, "field:pagingQuery ");
+    core::Validator::validateNumberPositive(pagingQuery.limit, "field:pagingQuery.limit ");
+    core::Validator::validateNumberPositive(pagesAhead, "field:pagesAhead ");
+    core::Validator::validateDataFields(fields, "field:fields ");
+    return core::Cursor<Message>(std::make_shared<core::PrefetchingCursor<Message>>(
+        [impl, threadId, fields](const core::PagingQuery& query) {
+            return impl->fetchMessagesPage(threadId, query, fields);
+        },
+        pagingQuery,
+        pagesAhead
+    ));
+}
+
 std::string ThreadApi::sendMessage(const std::string& threadId, const core::Buffer& publicMeta, const core::Buffer& privateMeta, const core::Buffer& data) {
     auto impl = getImpl();
     core::Validator::validateId(threadId, "field:threadId ");
@@ -164,6 +226,19 @@ std::string ThreadApi::sendMessage(const std::string& threadId, const core::Buff
     }
 }
 
+core::Future<std::string> ThreadApi::sendMessageAsync(const std::string& threadId, const core::Buffer& publicMeta, const core::Buffer& privateMeta, const core::Buffer& data, const core::AsyncCallOptions& options) {
+    auto impl = getImpl();
+    core::Validator::validateId(threadId, "field:threadId ");
+    return impl->getAsyncRequestQueue()->submit<std::string>([impl, threadId, publicMeta, privateMeta, data]() {
+        try {
+            return impl->sendMessage(threadId, publicMeta, privateMeta, data);
+        } catch (const privmx::utils::PrivmxException& e) {
+            core::ExceptionConverter::rethrowAsCoreException(e);
+            throw core::Exception("ExceptionConverter rethrow error");
+        }
+    }, options);
+}
+
 void ThreadApi::deleteMessage(const std::string& messageId) {
     auto impl = getImpl();
     core::Validator::validateId(messageId, "field:messageId ");
@@ -216,3 +291,25 @@ std::string ThreadApi::buildSubscriptionQuery(EventType eventType, EventSelector
     }
 }
 
+void ThreadApi::enableMessageCache(const std::string& cacheDirectory, const int64_t maxCacheSize) {
+    auto impl = getImpl();
+    core::Validator::validateNumberNonNegative(maxCacheSize, "field:maxCacheSize ");
+    try {
+        return impl->enableMessageCache(cacheDirectory, maxCacheSize);
+    } catch (const privmx::utils::PrivmxException& e) {
+        core::ExceptionConverter::rethrowAsCoreException(e);
+        throw core::Exception("ExceptionConverter rethrow error");
+    }
+}
+
+void ThreadApi::syncThread(const std::string& threadId) {
+    auto impl = getImpl();
+    core::Validator::validateId(threadId, "field:threadId ");
+    try {
+        return impl->syncThread(threadId);
+    } catch (const privmx::utils::PrivmxException& e) {
+        core::ExceptionConverter::rethrowAsCoreException(e);
+        throw core::Exception("ExceptionConverter rethrow error");
+    }
+}
+
@@ -9,6 +9,7 @@ See the License for the specific language governing permissions and
 limitations under the License.
 */
 
+#include <filesystem>
 #include <privmx/utils/Debug.hpp>
 #include <privmx/utils/Utils.hpp>
 #include <privmx/utils/JsonHelper.hpp>
@@ -22,6 +23,7 @@ limitations under the License.
 #include <privmx/endpoint/core/ExceptionConverter.hpp>
 #include <privmx/endpoint/core/TimestampValidator.hpp>
 #include <privmx/endpoint/core/CoreConstants.hpp>
+#include <privmx/crypto/Crypto.hpp>
 
 #include "privmx/endpoint/thread/DynamicTypes.hpp"
 #include "privmx/endpoint/thread/ThreadApiImpl.hpp"
@@ -51,6 +53,7 @@ ThreadApiImpl::ThreadApiImpl(
     _host(host),
     _eventMiddleware(eventMiddleware),
     _connection(connection),
+    _containerMembersUpdater(_connection.getImpl()->getContainerMembersUpdater()),
     _serverApi(ServerApi(gateway)),
     _dataEncryptorThread(core::DataEncryptor<dynamic::ThreadDataV1>()),
     _messageDataV2Encryptor(MessageDataV2Encryptor()),
@@ -59,15 +62,21 @@ ThreadApiImpl::ThreadApiImpl(
     _subscriber(gateway, THREAD_TYPE_FILTER_FLAG),
     _forbiddenChannelsNames({INTERNAL_EVENT_CHANNEL_NAME, "thread", "messages"})
 {
+    _messageDataEncryptorV5.setCompressor(_connection.getImpl()->getDataCompressor());
+    _threadDataEncryptorV5.setCompressor(_connection.getImpl()->getDataCompressor());
     _notificationListenerId = _eventMiddleware->addNotificationEventListener(std::bind(&ThreadApiImpl::processNotificationEvent, this, std::placeholders::_1, std::placeholders::_2));
     _connectedListenerId = _eventMiddleware->addConnectedEventListener(std::bind(&ThreadApiImpl::processConnectedEvent, this));
     _disconnectedListenerId = _eventMiddleware->addDisconnectedEventListener(std::bind(&ThreadApiImpl::processDisconnectedEvent, this));
+    _containerMembersHandlerId = _containerMembersUpdater->addHandler(
+        "thread", std::bind(&ThreadApiImpl::updateThreadMembers, this, std::placeholders::_1, std::placeholders::_2)
+    );
 }
 
 ThreadApiImpl::~ThreadApiImpl() {
     _eventMiddleware->removeNotificationEventListener(_notificationListenerId);
     _eventMiddleware->removeConnectedEventListener(_connectedListenerId);
     _eventMiddleware->removeDisconnectedEventListener(_disconnectedListenerId);
+    _containerMembersUpdater->removeHandler(_containerMembersHandlerId);
     _guardedExecutor.reset();
     LOG_TRACE("~ThreadApiImpl Done");
 }
@@ -157,12 +166,67 @@ void ThreadApiImpl::updateThread(
     const bool forceGenerateNewKey,
     const std::optional<core::ContainerPolicy>& policies
 ) {
-    PRIVMX_DEBUG_TIME_START(PlatformThread, updateThread)
-
     // get current thread
     server::ThreadGetModel getModel;
     getModel.threadId = threadId;
     auto currentThread = _serverApi.threadGet(getModel).thread;
+    updateThreadRequest(currentThread, [&](const core::DecryptedEncKeyV2& currentThreadKey) {
+        return core::UsersKeysResolver::create(currentThread.users, currentThread.managers, users, managers, forceGenerateNewKey, currentThreadKey);
+    }, publicMeta, privateMeta, version, force, policies);
+}
+
+void ThreadApiImpl::addThreadMembers(
+    const std::string& threadId,
+    const std::vector<core::UserWithPubKey>& users,
+    const std::vector<core::UserWithPubKey>& managers
+) {
+    updateThreadMembers(threadId, _containerMembersUpdater->createDelta(users, managers, {}));
+}
+
+void ThreadApiImpl::removeThreadMembers(const std::string& threadId, const std::vector<std::string>& userIds) {
+    updateThreadMembers(threadId, _containerMembersUpdater->createDelta({}, {}, userIds));
+}
+
+void ThreadApiImpl::updateThreadMembers(const std::string& threadId, const core::ContainerMembersDelta& delta) {
+    server::ThreadGetModel getModel;
+    getModel.threadId = threadId;
+    auto currentThread = _serverApi.threadGet(getModel).thread;
+    // the metadata is kept, so it is encrypted again with the current or the new key
+    auto thread = validateDecryptAndConvertThreadDataToThread(currentThread);
+    if(thread.statusCode != 0) {
+        throw ThreadDataIntegrityException("Thread data statusCode: " + std::to_string(thread.statusCode));
+    }
+    try {
+        updateThreadRequest(currentThread, [&](const core::DecryptedEncKeyV2& currentThreadKey) {
+            return core::UsersKeysResolver::createFromDelta(
+                currentThread.users, currentThread.managers, delta.usersToAdd, delta.managersToAdd, delta.userIdsToRemove, currentThreadKey,
+                [&](const std::vector<std::string>& userIds) { return delta.getContextUsersPubKeys(currentThread.contextId, userIds); }
+            );
+        }, thread.publicMeta, thread.privateMeta, currentThread.version, false, std::nullopt);
+    } catch (const privmx::utils::PrivmxException&) {
+        // the update is rejected when the Thread has been modified since it was fetched
+        std::optional<int64_t> version;
+        try {
+            version = _serverApi.threadGet(getModel).thread.version;
+        } catch (...) {}
+        if(version.has_value() && version.value() != currentThread.version) {
+            throw core::ContainerVersionConflictException();
+        }
+        throw;
+    }
+}
+
+void ThreadApiImpl::updateThreadRequest(
+    const server::ThreadInfo& currentThread,
+    const std::function<std::shared_ptr<core::UsersKeysResolver>(const core::DecryptedEncKeyV2&)>& createUsersKeysResolver,
+    const core::Buffer& publicMeta,
+    const core::Buffer& privateMeta,
+    const int64_t version,
+    const bool force,
+    const std::optional<core::ContainerPolicy>& policies
+) {
+    PRIVMX_DEBUG_TIME_START(PlatformThread, updateThread)
+    const auto& threadId = currentThread.id;
     const auto& currentThreadEntry = currentThread.data.back();
     auto currentThreadResourceId = currentThread.resourceId ? currentThread.resourceId.value() : core::EndpointUtils::generateId();
     core::EncKeyLocation location{.contextId=currentThread.contextId, .resourceId=currentThreadResourceId};
@@ -172,7 +236,7 @@ void ThreadApiImpl::updateThread(
     auto currentThreadKey {findEncKeyByKeyId(threadKeys, currentThreadEntry.keyId)};
     auto threadInternalMeta = extractAndDecryptModuleInternalMeta(currentThreadEntry, currentThreadKey);
 
-    auto usersKeysResolver {core::UsersKeysResolver::create(currentThread.users, currentThread.managers, users, managers, forceGenerateNewKey, currentThreadKey)};
+    auto usersKeysResolver {createUsersKeysResolver(currentThreadKey)};
 
     if(!_keyProvider->verifyKeysSecret(threadKeys, location, threadInternalMeta.secret)) {
         throw ThreadEncryptionKeyValidationException();
@@ -193,10 +257,12 @@ void ThreadApiImpl::updateThread(
         );
     }
 
+    // new users get only the newest key, the older ones are reachable through the key chain
+    auto keyChain {_keyProvider->prepareKeyChain(threadInternalMeta.keyChain, threadKeys, currentThreadKey, threadKey)};
     auto usersToAddMissingKey {usersKeysResolver->getUsersToAddKey()};
     if(usersToAddMissingKey.size() > 0) {
         auto tmp = _keyProvider->prepareMissingKeysForNewUsers(
-            threadKeys,
+            _keyProvider->getKeysOutsideKeyChain(threadKeys, keyChain, threadKey.id),
             usersToAddMissingKey,
             updateThreadDio,
             location,
@@ -209,8 +275,8 @@ void ThreadApiImpl::updateThread(
     model.resourceId = currentThreadResourceId;
     model.keyId = threadKey.id;
     model.keys = keys;
-    model.users = mapUsers(users);
-    model.managers = mapUsers(managers);
+    model.users = usersKeysResolver->getUserIds();
+    model.managers = usersKeysResolver->getManagerIds();
     model.version = version;
     model.force = force;
     if (policies.has_value()) {
@@ -219,14 +285,24 @@ void ThreadApiImpl::updateThread(
     core::ModuleDataToEncryptV5 threadDataToEncrypt {
         .publicMeta = publicMeta,
         .privateMeta = privateMeta,
-        .internalMeta = core::ModuleInternalMetaV5{.secret=threadInternalMeta.secret, .resourceId=currentThreadResourceId, .randomId=updateThreadDio.randomId},
+        .internalMeta = core::ModuleInternalMetaV5{.secret=threadInternalMeta.secret, .resourceId=currentThreadResourceId, .randomId=updateThreadDio.randomId, .keyChain=keyChain},
         .dio = updateThreadDio
     };
     model.data = _threadDataEncryptorV5.encrypt(threadDataToEncrypt, _userPrivKey, threadKey.key).toJSON();
 
     PRIVMX_DEBUG_TIME_CHECKPOINT(PlatformThread, updateThread, data encrypted)
     _serverApi.threadUpdate(model);
-    invalidateModuleKeysInCache(threadId);
+    if(force) {
+        invalidateModuleKeysInCache(threadId);
+    } else {
+        // the keys after the update are already known, so the next operation on the Thread does not fetch them
+        auto updatedKeys {threadToModuleKeys(currentThread)};
+        updatedKeys.currentKeyId = threadKey.id;
+        updatedKeys.moduleSchemaVersion = ThreadDataSchema::Version::VERSION_5;
+        updatedKeys.moduleResourceId = currentThreadResourceId;
+        updatedKeys.currentData = model.data;
+        writeThroughModuleKeysInCache(threadId, updatedKeys, keys, updateThreadDio.creatorUserId, version + 1);
+    }
     PRIVMX_DEBUG_TIME_STOP(PlatformThread, updateThread, data send)
 }
 
@@ -291,7 +367,7 @@ core::PagingList<Thread> ThreadApiImpl::_listThreadsEx(const std::string& contex
         .readItems = threads
     });
 }
-Message ThreadApiImpl::getMessage(const std::string& messageId) {
+Message ThreadApiImpl::getMessage(const std::string& messageId, int64_t fields) {
     PRIVMX_DEBUG_TIME_START(PlatformThread, getMessage)
     server::ThreadMessageGetModel model {.messageId = messageId};
     PRIVMX_DEBUG_TIME_CHECKPOINT(PlatformThread, getMessage, getting message)
@@ -299,41 +375,71 @@ Message ThreadApiImpl::getMessage(const std::string& messageId) {
     PRIVMX_DEBUG_TIME_CHECKPOINT(PlatformThread, getMessage, data recived);
     Message result;
     PRIVMX_DEBUG_TIME_CHECKPOINT(PlatformThread, getMessage, decrypting message)
-    result = validateDecryptAndConvertMessageDataToMessage(message, getMessageDecryptionKeys(message));
+    result = validateDecryptAndConvertMessageDataToMessage(message, getMessageDecryptionKeys(message), fields);
     PRIVMX_DEBUG_TIME_STOP(PlatformThread, getMessage, data decrypted)
     return result;
 }
 
-core::PagingList<Message> ThreadApiImpl::listMessages(const std::string& threadId, const core::PagingQuery& pagingQuery) {
+core::PagingList<Message> ThreadApiImpl::listMessages(const std::string& threadId, const core::PagingQuery& pagingQuery, int64_t fields) {
+    auto cache = getMessageCache();
+    if (cache) {
+        auto cached = cache->list(threadId, pagingQuery);
+        if (cached.has_value()) {
+            if (fields != core::DataField::ALL_DATA_FIELDS) {
+                for (auto& message : cached->readItems) {
+                    message = selectMessageFields(message, fields);
+                }
+            }
+            return cached.value();
+        }
+    }
+    return listMessagesFromServer(threadId, pagingQuery, fields);
+}
+
+core::PagingList<Message> ThreadApiImpl::listMessagesFromServer(const std::string& threadId, const core::PagingQuery& pagingQuery, int64_t fields) {
     PRIVMX_DEBUG_TIME_START(PlatformThread, listMessages)
+    auto page = fetchMessagesPage(threadId, pagingQuery, fields);
+    PRIVMX_DEBUG_TIME_CHECKPOINT(PlatformThread, listMessages, data send)
+    auto messages = page.decrypt();
+    PRIVMX_DEBUG_TIME_STOP(PlatformThread, listMessages, data decrypted)
+    return core::PagingList<Message>({
+        .totalAvailable = page.totalAvailable,
+        .readItems = messages
+    });
+}
+
+core::CursorPage<Message> ThreadApiImpl::fetchMessagesPage(const std::string& threadId, const core::PagingQuery& pagingQuery, int64_t fields) {
     server::ThreadMessagesGetModel model;
     model.threadId = threadId;
     core::ListQueryMapper::map(model, pagingQuery);
-    PRIVMX_DEBUG_TIME_CHECKPOINT(PlatformThread, listMessages, getting messageList)
     auto messagesList = _serverApi.threadMessagesGet(model);
-    PRIVMX_DEBUG_TIME_CHECKPOINT(PlatformThread, listMessages, getting thread)
     const auto& thread = messagesList.thread;
     assertThreadDataIntegrity(thread);
     setNewModuleKeysInCache(thread.id, threadToModuleKeys(thread), thread.version);
-    PRIVMX_DEBUG_TIME_CHECKPOINT(PlatformThread, listMessages, data send)
-    auto messages = validateDecryptAndConvertMessagesDataToMessages(messagesList.messages, threadToModuleKeys(thread));
-    PRIVMX_DEBUG_TIME_STOP(PlatformThread, listMessages, data decrypted)
-    return core::PagingList<Message>({
+    auto messages = messagesList.messages;
+    return core::CursorPage<Message>{
         .totalAvailable = messagesList.count,
-        .readItems = messages
-    });
+        .size = messages.size(),
+        .lastId = messages.empty() ? std::nullopt : std::make_optional(messages.back().id),
+        .decrypt = [this, messages, threadKeys = threadToModuleKeys(thread), fields]() {
+            return validateDecryptAndConvertMessagesDataToMessages(messages, threadKeys, fields);
+        }
+    };
 }
 std::string ThreadApiImpl::sendMessage(const std::string& threadId, const core::Buffer& publicMeta, const core::Buffer& privateMeta, const core::Buffer& data) {
+    std::string messageId;
     try {
         auto currentKeys{getModuleKeys(threadId)};
-        return sendMessageRequest(threadId, publicMeta, privateMeta, data, currentKeys);
+        messageId = sendMessageRequest(threadId, publicMeta, privateMeta, data, currentKeys);
     } catch (const privmx::utils::PrivmxException& e) {
-        if (core::ExceptionConverter::convert(e).getCode() == privmx::endpoint::server::InvalidThreadKeyException().getCode()) {
-            auto newestKeys{getNewModuleKeysAndUpdateCache(threadId)};
-            return sendMessageRequest(threadId, publicMeta, privateMeta, data, newestKeys);
+        if (core::ExceptionConverter::convert(e).getCode() != privmx::endpoint::server::InvalidThreadKeyException().getCode()) {
+            throw e;
         }
-        throw e;
+        auto newestKeys{getNewModuleKeysAndUpdateCache(threadId)};
+        messageId = sendMessageRequest(threadId, publicMeta, privateMeta, data, newestKeys);
     }
+    putOwnMessageInCache(threadId, messageId);
+    return messageId;
 }
 
 std::string ThreadApiImpl::sendMessageRequest(const std::string& threadId, const core::Buffer& publicMeta, const core::Buffer& privateMeta, const core::Buffer& data, const core::ModuleKeys& keys) {
@@ -357,6 +463,10 @@ std::string ThreadApiImpl::sendMessageRequest(const std::string& threadId, const
 void ThreadApiImpl::deleteMessage(const std::string& messageId) {
     server::ThreadMessageDeleteModel model {.messageId = messageId};
     _serverApi.threadMessageDelete(model);
+    auto cache = getMessageCache();
+    if (cache) {
+        cache->removeMessage(messageId);
+    }
 }
 void ThreadApiImpl::updateMessage(
     const std::string& messageId,
@@ -371,22 +481,23 @@ void ThreadApiImpl::updateMessage(
     auto message = _serverApi.threadMessageGet(model).message;
     try {
         auto currentKeys{getModuleKeys(message.threadId)};
-        return updateMessageRequest(messageId, message.resourceId.empty() ? core::EndpointUtils::generateId() : message.resourceId, message.threadId, publicMeta, privateMeta, data, currentKeys);
+        updateMessageRequest(messageId, message.resourceId.empty() ? core::EndpointUtils::generateId() : message.resourceId, message.threadId, publicMeta, privateMeta, data, currentKeys);
     } catch (const privmx::utils::PrivmxException& e) {
-        if (core::ExceptionConverter::convert(e).getCode() == privmx::endpoint::server::InvalidThreadKeyException().getCode()) {
-            auto newestKeys{getNewModuleKeysAndUpdateCache(message.threadId)};
-            return updateMessageRequest(
-                messageId,
-                message.resourceId.empty() ? core::EndpointUtils::generateId() : message.resourceId,
-                message.threadId,
-                publicMeta,
-                privateMeta,
-                data,
-                newestKeys
-            );
+        if (core::ExceptionConverter::convert(e).getCode() != privmx::endpoint::server::InvalidThreadKeyException().getCode()) {
+            e.rethrow();
         }
-        e.rethrow();
+        auto newestKeys{getNewModuleKeysAndUpdateCache(message.threadId)};
+        updateMessageRequest(
+            messageId,
+            message.resourceId.empty() ? core::EndpointUtils::generateId() : message.resourceId,
+            message.threadId,
+            publicMeta,
+            privateMeta,
+            data,
+            newestKeys
+        );
     }
+    putOwnMessageInCache(message.threadId, messageId);
 }
 
 void ThreadApiImpl::updateMessageRequest(
@@ -438,6 +549,9 @@ void ThreadApiImpl::processNotificationEvent(const std::string& type, const core
             auto raw = server::ThreadDeletedEventData::fromJSON(notification.data);
             if(raw.type.value_or(std::string(THREAD_TYPE_FILTER_FLAG)) == THREAD_TYPE_FILTER_FLAG) {
                 invalidateModuleKeysInCache(raw.threadId);
+                if (auto cache = getMessageCache()) {
+                    cache->clear(raw.threadId);
+                }
                 auto data = Mapper::mapToThreadDeletedEventData(raw);
                 auto event = core::EventBuilder::buildEvent<ThreadDeletedEvent>("thread", data, notification);
                 _eventMiddleware->emitApiEvent(event);
@@ -453,6 +567,9 @@ void ThreadApiImpl::processNotificationEvent(const std::string& type, const core
             auto raw = server::ThreadMessageEventData::fromJSON(notification.data);
             if(raw.containerType.value_or(std::string(THREAD_TYPE_FILTER_FLAG)) == THREAD_TYPE_FILTER_FLAG) {
                 auto data = validateDecryptAndConvertMessageDataToMessage(raw, getMessageDecryptionKeys(raw));
+                if (auto cache = getMessageCache()) {
+                    cache->put(data, getMessageLastUpdate(raw));
+                }
                 auto event = core::EventBuilder::buildEvent<ThreadNewMessageEvent>("thread/" + raw.threadId + "/messages", data, notification);
                 _eventMiddleware->emitApiEvent(event);
             }
@@ -460,12 +577,18 @@ void ThreadApiImpl::processNotificationEvent(const std::string& type, const core
             auto raw = server::ThreadMessageEventData::fromJSON(notification.data);
             if(raw.containerType.value_or(std::string(THREAD_TYPE_FILTER_FLAG)) == THREAD_TYPE_FILTER_FLAG) {
                 auto data = validateDecryptAndConvertMessageDataToMessage(raw, getMessageDecryptionKeys(raw));
+                if (auto cache = getMessageCache()) {
+                    cache->put(data, getMessageLastUpdate(raw));
+                }
                 auto event = core::EventBuilder::buildEvent<ThreadMessageUpdatedEvent>("thread/" + raw.threadId + "/messages", data, notification);
                 _eventMiddleware->emitApiEvent(event);
             }
         } else if (type == "threadDeletedMessage") {
             auto raw = server::ThreadDeletedMessageEventData::fromJSON(notification.data);
             if(raw.containerType.value_or(std::string(THREAD_TYPE_FILTER_FLAG)) == THREAD_TYPE_FILTER_FLAG) {
+                if (auto cache = getMessageCache()) {
+                    cache->remove(raw.threadId, raw.messageId);
+                }
                 auto data = Mapper::mapToThreadDeletedMessageEventData(raw);
                 auto event = core::EventBuilder::buildEvent<ThreadMessageDeletedEvent>("thread/" + raw.threadId + "/messages", data, notification);
                 _eventMiddleware->emitApiEvent(event);
@@ -482,15 +605,141 @@ void ThreadApiImpl::processNotificationEvent(const std::string& type, const core
 }
 
 void ThreadApiImpl::processConnectedEvent() {
-    invalidateModuleKeysInCache();
+    revalidateModuleKeysInCache();
 }
 
 void ThreadApiImpl::processDisconnectedEvent() {
     LOG_TRACE("ThreadApiImpl recived DisconnectedEvent");
-    invalidateModuleKeysInCache();
+    revalidateModuleKeysInCache();
+    if (auto cache = getMessageCache()) {
+        // events may be missed while disconnected
+        cache->invalidateSynced();
+    }
     privmx::utils::ManualManagedClass<ThreadApiImpl>::cleanup();
 }
 
+void ThreadApiImpl::enableMessageCache(const std::string& cacheDirectory, const int64_t maxCacheSize) {
+    auto key = privmx::crypto::Crypto::hmacSha256(_userPrivKey.getPrivateEncKey(), "privmx-thread-message-cache");
+    // every user has its own subdirectory, so the logs of other users sharing the directory are not taken as corrupted
+    auto userDirectory = utils::Hex::from(privmx::crypto::Crypto::sha256(_host + "/" + _userPrivKey.getPublicKey().toBase58DER()));
+    auto cache = std::make_shared<MessageCache>((std::filesystem::path(cacheDirectory) / userDirectory).string(), maxCacheSize, key);
+    std::lock_guard<std::mutex> lock(_messageCacheMutex);
+    _messageCache = cache;
+}
+
+void ThreadApiImpl::syncThread(const std::string& threadId) {
+    auto cache = getMessageCache();
+    if (!cache) {
+        throw MessageCacheNotEnabledException();
+    }
+    PRIVMX_DEBUG_TIME_START(PlatformThread, syncThread)
+    auto contextId = syncThreadMessages(cache, threadId);
+    PRIVMX_DEBUG_TIME_CHECKPOINT(PlatformThread, syncThread, messages synchronized)
+    // without events the cache would miss later changes, so it is used for listing only while they are delivered
+    cache->setSynced(threadId, isSubscribedForMessages(threadId, contextId));
+    PRIVMX_DEBUG_TIME_STOP(PlatformThread, syncThread, done)
+}
+
+std::string ThreadApiImpl::syncThreadMessages(const std::shared_ptr<MessageCache>& cache, const std::string& threadId) {
+    // the server cannot list messages changed since a date, so all of them are listed
+    // and only the new and updated ones are decrypted
+    auto cachedLastUpdates = cache->getLastUpdates(threadId);
+    core::PagingQuery query {
+        .skip = 0,
+        .limit = MESSAGE_CACHE_SYNC_PAGE_SIZE,
+        .sortOrder = "asc",
+        .lastId = std::nullopt,
+        .sortBy = std::nullopt,
+        .queryAsJson = std::nullopt
+    };
+    std::string contextId;
+    while (true) {
+        server::ThreadMessagesGetModel model;
+        model.threadId = threadId;
+        core::ListQueryMapper::map(model, query);
+        auto messagesList = _serverApi.threadMessagesGet(model);
+        const auto& thread = messagesList.thread;
+        assertThreadDataIntegrity(thread);
+        setNewModuleKeysInCache(thread.id, threadToModuleKeys(thread), thread.version);
+        contextId = thread.contextId;
+        std::vector<server::Message> changed;
+        std::unordered_map<std::string, int64_t> changedLastUpdates;
+        for (const auto& message : messagesList.messages) {
+            auto lastUpdate = getMessageLastUpdate(message);
+            auto cached = cachedLastUpdates.find(message.id);
+            if (cached == cachedLastUpdates.end() || cached->second != lastUpdate) {
+                changed.push_back(message);
+                changedLastUpdates.emplace(message.id, lastUpdate);
+            }
+            if (cached != cachedLastUpdates.end()) {
+                cachedLastUpdates.erase(cached);
+            }
+        }
+        if (!changed.empty()) {
+            auto messages = validateDecryptAndConvertMessagesDataToMessages(changed, threadToModuleKeys(thread));
+            std::vector<std::pair<Message, int64_t>> toCache;
+            for (const auto& message : messages) {
+                toCache.push_back({message, changedLastUpdates.at(message.info.messageId)});
+            }
+            cache->putMany(threadId, toCache);
+        }
+        if ((int64_t)messagesList.messages.size() < query.limit) {
+            break;
+        }
+        query.lastId = messagesList.messages.back().id;
+    }
+    // cached messages not listed anymore were deleted on the server
+    std::vector<std::string> deleted;
+    for (const auto& [messageId, lastUpdate] : cachedLastUpdates) {
+        deleted.push_back(messageId);
+    }
+    if (!deleted.empty()) {
+        cache->removeMany(threadId, deleted);
+    }
+    return contextId;
+}
+
+bool ThreadApiImpl::isSubscribedForMessages(const std::string& threadId, const std::string& contextId) {
+    for (auto eventType : {EventType::MESSAGE_CREATE, EventType::MESSAGE_UPDATE, EventType::MESSAGE_DELETE}) {
+        if (
+            !_subscriber.isSubscribedFor(SubscriberImpl::buildQuery(eventType, EventSelectorType::THREAD_ID, threadId)) &&
+            !_subscriber.isSubscribedFor(SubscriberImpl::buildQuery(eventType, EventSelectorType::CONTEXT_ID, contextId))
+        ) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int64_t ThreadApiImpl::getMessageLastUpdate(const server::Message& message) {
+    int64_t result = message.createDate;
+    for (const auto& update : message.updates) {
+        result = std::max(result, update.createDate);
+    }
+    return result;
+}
+
+void ThreadApiImpl::putOwnMessageInCache(const std::string& threadId, const std::string& messageId) {
+    auto cache = getMessageCache();
+    if (!cache || !cache->isSynced(threadId)) {
+        return;
+    }
+    // the message is cached right away, so it is listed from the cache before its event arrives
+    try {
+        server::ThreadMessageGetModel model {.messageId = messageId};
+        auto message = _serverApi.threadMessageGet(model).message;
+        cache->put(validateDecryptAndConvertMessageDataToMessage(message, getMessageDecryptionKeys(message)), getMessageLastUpdate(message));
+    } catch (...) {
+        // the message was sent, so the Thread is listed from the server until it is synced again
+        cache->setSynced(threadId, false);
+    }
+}
+
+std::shared_ptr<MessageCache> ThreadApiImpl::getMessageCache() {
+    std::lock_guard<std::mutex> lock(_messageCacheMutex);
+    return _messageCache;
+}
+
 std::vector<std::string> ThreadApiImpl::mapUsers(const std::vector<core::UserWithPubKey>& users) {
     std::vector<std::string> result;
     for (const auto& user : users) {
@@ -586,6 +835,7 @@ ThreadDataSchema::Version ThreadApiImpl::getThreadEntryDataStructureVersion(serv
             case core::ModuleDataSchema::Version::VERSION_4:
                 return ThreadDataSchema::Version::VERSION_4;
             case core::ModuleDataSchema::Version::VERSION_5:
+            case core::ModuleDataSchema::Version::VERSION_6:
                 return ThreadDataSchema::Version::VERSION_5;
             default:
                 return ThreadDataSchema::Version::UNKNOWN;
@@ -811,7 +1061,7 @@ DecryptedMessageDataV4 ThreadApiImpl::decryptMessageDataV4(server::Message messa
     }
 }
 
-DecryptedMessageDataV5 ThreadApiImpl::decryptMessageDataV5(server::Message message, const core::DecryptedEncKey& encKey) {
+DecryptedMessageDataV5 ThreadApiImpl::decryptMessageDataV5(server::Message message, const core::DecryptedEncKey& encKey, int64_t fields) {
     try {
         auto encryptedMessageData = server::EncryptedMessageDataV5::fromJSON(message.data);
         if(encKey.statusCode != 0) {
@@ -819,7 +1069,7 @@ DecryptedMessageDataV5 ThreadApiImpl::decryptMessageDataV5(server::Message messa
             tmp.statusCode = encKey.statusCode;
             return tmp;
         }
-        return _messageDataEncryptorV5.decrypt(encryptedMessageData, encKey.key);
+        return _messageDataEncryptorV5.decrypt(encryptedMessageData, encKey.key, fields);
     } catch (const core::Exception& e) {
         return DecryptedMessageDataV5{{.dataStructureVersion = MessageDataSchema::Version::VERSION_5, .statusCode = e.getCode()}, {},{},{},{},{},{}};
     } catch (const privmx::utils::PrivmxException& e) {
@@ -903,6 +1153,18 @@ Message ThreadApiImpl::convertDecryptedMessageDataV5ToMessage(server::Message me
     );
 }
 
+Message ThreadApiImpl::selectMessageFields(Message message, int64_t fields) {
+    if (!(fields & core::DataField::PUBLIC_META)) {
+        message.publicMeta = core::Buffer();
+    }
+    if (!(fields & core::DataField::PRIVATE_META)) {
+        message.privateMeta = core::Buffer();
+    }
+    if (!(fields & core::DataField::DATA)) {
+        message.data = core::Buffer();
+    }
+    return message;
+}
 
 MessageDataSchema::Version ThreadApiImpl::getMessagesDataStructureVersion(server::Message message) {
     // If data is not string, then data is object and has version field
@@ -928,7 +1190,7 @@ MessageDataSchema::Version ThreadApiImpl::getMessagesDataStructureVersion(server
     return MessageDataSchema::Version::UNKNOWN;
 }
 
-std::tuple<Message, core::DataIntegrityObject> ThreadApiImpl::decryptAndConvertMessageDataToMessage(server::Message message, const core::DecryptedEncKey& encKey) {
+std::tuple<Message, core::DataIntegrityObject> ThreadApiImpl::decryptAndConvertMessageDataToMessage(server::Message message, const core::DecryptedEncKey& encKey, int64_t fields) {
     switch (getMessagesDataStructureVersion(message)) {
         case MessageDataSchema::Version::UNKNOWN: {
             auto e = UnknowMessageFormatException();
@@ -936,7 +1198,7 @@ std::tuple<Message, core::DataIntegrityObject> ThreadApiImpl::decryptAndConvertM
         }
         case MessageDataSchema::Version::VERSION_2: {
             return std::make_tuple(
-                convertMessageDataV2ToMessage(message,  decryptMessageDataV2(message, encKey)),
+                selectMessageFields(convertMessageDataV2ToMessage(message,  decryptMessageDataV2(message, encKey)), fields),
                 core::DataIntegrityObject{
                     .creatorUserId = message.updates.empty() ? message.author : message.updates.back().author,
                     .creatorPubKey = "",
@@ -952,7 +1214,7 @@ std::tuple<Message, core::DataIntegrityObject> ThreadApiImpl::decryptAndConvertM
         }
         case MessageDataSchema::Version::VERSION_3: {
             return std::make_tuple(
-                convertMessageDataV3ToMessage(message,  decryptMessageDataV3(message, encKey)),
+                selectMessageFields(convertMessageDataV3ToMessage(message,  decryptMessageDataV3(message, encKey)), fields),
                 core::DataIntegrityObject{
                     .creatorUserId = message.updates.empty() ? message.author : message.updates.back().author,
                     .creatorPubKey = std::string(),
@@ -969,7 +1231,7 @@ std::tuple<Message, core::DataIntegrityObject> ThreadApiImpl::decryptAndConvertM
         case MessageDataSchema::Version::VERSION_4: {
             auto decryptedMessage = decryptMessageDataV4(message, encKey);
             return std::make_tuple(
-                convertDecryptedMessageDataV4ToMessage(message, decryptedMessage),
+                selectMessageFields(convertDecryptedMessageDataV4ToMessage(message, decryptedMessage), fields),
                 core::DataIntegrityObject{
                     .creatorUserId = message.updates.empty() ? message.author : message.updates.back().author,
                     .creatorPubKey = decryptedMessage.authorPubKey,
@@ -984,7 +1246,7 @@ std::tuple<Message, core::DataIntegrityObject> ThreadApiImpl::decryptAndConvertM
             );
         }
         case MessageDataSchema::Version::VERSION_5: {
-            auto decryptedMessage = decryptMessageDataV5(message, encKey);
+            auto decryptedMessage = decryptMessageDataV5(message, encKey, fields);
             return std::make_tuple(
                 convertDecryptedMessageDataV5ToMessage(message, decryptedMessage),
                 decryptedMessage.dio
@@ -995,7 +1257,7 @@ std::tuple<Message, core::DataIntegrityObject> ThreadApiImpl::decryptAndConvertM
     return std::make_tuple(convertServerMessageToLibMessage(message,{},{},{},{},e.getCode()), core::DataIntegrityObject());
 }
 
-std::vector<Message> ThreadApiImpl::validateDecryptAndConvertMessagesDataToMessages(std::vector<server::Message> messages, const core::ModuleKeys& threadKeys) {
+std::vector<Message> ThreadApiImpl::validateDecryptAndConvertMessagesDataToMessages(std::vector<server::Message> messages, const core::ModuleKeys& threadKeys, int64_t fields) {
     std::set<std::string> keyIds;
     for (const auto& message : messages) {
         keyIds.insert(message.keyId);
@@ -1003,6 +1265,7 @@ std::vector<Message> ThreadApiImpl::validateDecryptAndConvertMessagesDataToMessa
     core::KeyDecryptionAndVerificationRequest keyProviderRequest;
     core::EncKeyLocation location{.contextId=threadKeys.contextId, .resourceId=threadKeys.moduleResourceId};
     keyProviderRequest.addMany(threadKeys.keys, keyIds, location);
+    keyProviderRequest.addKeyChain(threadKeys, location);
     auto keyMap = _keyProvider->getKeysAndVerify(keyProviderRequest).at(location);
     std::vector<Message> result;
     std::vector<core::DataIntegrityObject> messagesDIO;
@@ -1011,7 +1274,7 @@ std::vector<Message> ThreadApiImpl::validateDecryptAndConvertMessagesDataToMessa
         try {
             auto statusCode = validateMessageDataIntegrity(message, threadKeys.moduleResourceId);
             if(statusCode == 0) {
-                auto tmp = decryptAndConvertMessageDataToMessage(message, keyMap.at(message.keyId));
+                auto tmp = decryptAndConvertMessageDataToMessage(message, keyMap.at(message.keyId), fields);
                 result.push_back(std::get<0>(tmp));
                 auto messageDIO = std::get<1>(tmp);
                 messagesDIO.push_back(messageDIO);
@@ -1056,7 +1319,7 @@ std::vector<Message> ThreadApiImpl::validateDecryptAndConvertMessagesDataToMessa
     return result;
 }
 
-Message ThreadApiImpl::validateDecryptAndConvertMessageDataToMessage(server::Message message, const core::ModuleKeys& threadKeys) {
+Message ThreadApiImpl::validateDecryptAndConvertMessageDataToMessage(server::Message message, const core::ModuleKeys& threadKeys, int64_t fields) {
     try {
         auto keyId = message.keyId;
         // Validate data Integrity
@@ -1069,12 +1332,13 @@ Message ThreadApiImpl::validateDecryptAndConvertMessageDataToMessage(server::Mes
         core::KeyDecryptionAndVerificationRequest keyProviderRequest;
         core::EncKeyLocation location{.contextId=message.contextId, .resourceId=threadKeys.moduleResourceId};
         keyProviderRequest.addOne(threadKeys.keys, keyId, location);
+        keyProviderRequest.addKeyChain(threadKeys, location);
         // Send request to KeyProvider
         auto encKey = _keyProvider->getKeysAndVerify(keyProviderRequest).at(location).at(keyId);
         // decrypt message
         Message result;
         core::DataIntegrityObject messageDIO;
-        std::tie(result, messageDIO) = decryptAndConvertMessageDataToMessage(message, encKey);
+        std::tie(result, messageDIO) = decryptAndConvertMessageDataToMessage(message, encKey, fields);
         if(result.statusCode != 0) return result;
         // Validate with UserVerifier
         std::vector<core::VerificationRequest> verifierInput {};
@@ -1181,7 +1445,8 @@ core::ModuleKeys ThreadApiImpl::threadToModuleKeys(server::ThreadInfo thread) {
         .currentKeyId=thread.keyId,
         .moduleSchemaVersion=getThreadEntryDataStructureVersion(thread.data.back()),
         .moduleResourceId=thread.resourceId.value_or(""),
-        .contextId = thread.contextId
+        .contextId = thread.contextId,
+        .currentData = thread.data.back().data
     };
 }
 
@@ -1268,6 +1533,10 @@ std::vector<std::string> ThreadApiImpl::subscribeFor(const std::vector<std::stri
 }
 
 void ThreadApiImpl::unsubscribeFrom(const std::vector<std::string>& subscriptionIds) {
+    if (auto cache = getMessageCache()) {
+        // the cache stops receiving changes of the Threads it covered, they have to be synced again
+        cache->invalidateSynced();
+    }
     _subscriber.unsubscribeFrom(subscriptionIds);
     _eventMiddleware->notificationEventListenerRemoveSubscriptionIds(_notificationListenerId, subscriptionIds);
 }
@@ -47,7 +47,7 @@ dynamic::MessageDataV3Signed  MessageDataV3Encryptor::decryptAndGetSign(const st
     dynamic::MessageDataV3Signed result;
     Pson::BinaryString dataBuf, dataSignature;
     std::tie(dataSignature, dataBuf) = _dataEncryptorMessageDataV3.extractSignAndDataBuff(utils::Base64::toString(data));
-    dynamic::MessageDataV3 messageDataV3Encrypted = dynamic::MessageDataV3::fromJSON(privmx::utils::Utils::parseJsonObject(dataBuf));
+    dynamic::MessageDataV3 messageDataV3Encrypted = dynamic::MessageDataV3::deserialize(dataBuf);
     dynamic::MessageDataV3 messageDataV3;
     messageDataV3.publicMeta = utils::Base64::toString(messageDataV3Encrypted.publicMeta);
     try {
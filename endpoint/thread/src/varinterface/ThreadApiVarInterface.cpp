@@ -31,7 +31,11 @@ std::map<ThreadApiVarInterface::METHOD, Poco::Dynamic::Var (ThreadApiVarInterfac
                                         {UpdateMessage, &ThreadApiVarInterface::updateMessage},
                                         {SubscribeFor, &ThreadApiVarInterface::subscribeFor},
                                         {UnsubscribeFrom, &ThreadApiVarInterface::unsubscribeFrom},
-                                        {BuildSubscriptionQuery, &ThreadApiVarInterface::buildSubscriptionQuery}};
+                                        {BuildSubscriptionQuery, &ThreadApiVarInterface::buildSubscriptionQuery},
+                                        {EnableMessageCache, &ThreadApiVarInterface::enableMessageCache},
+                                        {SyncThread, &ThreadApiVarInterface::syncThread},
+                                        {AddThreadMembers, &ThreadApiVarInterface::addThreadMembers},
+                                        {RemoveThreadMembers, &ThreadApiVarInterface::removeThreadMembers}};
 
 Poco::Dynamic::Var ThreadApiVarInterface::create(const Poco::Dynamic::Var& args) {
     core::VarInterfaceUtil::validateAndExtractArray(args, 0);
@@ -66,6 +70,23 @@ Poco::Dynamic::Var ThreadApiVarInterface::updateThread(const Poco::Dynamic::Var&
     return {};
 }
 
+Poco::Dynamic::Var ThreadApiVarInterface::addThreadMembers(const Poco::Dynamic::Var& args) {
+    auto argsArr = core::VarInterfaceUtil::validateAndExtractArray(args, 3);
+    auto threadId = _deserializer.deserialize<std::string>(argsArr->get(0), "threadId");
+    auto users = _deserializer.deserializeVector<core::UserWithPubKey>(argsArr->get(1), "users");
+    auto managers = _deserializer.deserializeVector<core::UserWithPubKey>(argsArr->get(2), "managers");
+    _threadApi.addThreadMembers(threadId, users, managers);
+    return {};
+}
+
+Poco::Dynamic::Var ThreadApiVarInterface::removeThreadMembers(const Poco::Dynamic::Var& args) {
+    auto argsArr = core::VarInterfaceUtil::validateAndExtractArray(args, 2);
+    auto threadId = _deserializer.deserialize<std::string>(argsArr->get(0), "threadId");
+    auto userIds = _deserializer.deserializeVector<std::string>(argsArr->get(1), "userIds");
+    _threadApi.removeThreadMembers(threadId, userIds);
+    return {};
+}
+
 Poco::Dynamic::Var ThreadApiVarInterface::deleteThread(const Poco::Dynamic::Var& args) {
     auto argsArr = core::VarInterfaceUtil::validateAndExtractArray(args, 1);
     auto threadId = _deserializer.deserialize<std::string>(argsArr->get(0), "threadId");
@@ -89,17 +110,25 @@ Poco::Dynamic::Var ThreadApiVarInterface::listThreads(const Poco::Dynamic::Var&
 }
 
 Poco::Dynamic::Var ThreadApiVarInterface::getMessage(const Poco::Dynamic::Var& args) {
-    auto argsArr = core::VarInterfaceUtil::validateAndExtractArray(args, 1);
+    auto argsArr = core::VarInterfaceUtil::validateAndExtractArray(args, 1, 2);
     auto messageId = _deserializer.deserialize<std::string>(argsArr->get(0), "messageId");
-    auto result = _threadApi.getMessage(messageId);
+    int64_t fields = core::DataField::ALL_DATA_FIELDS;
+    if(argsArr->size() >= 2) {
+        fields = _deserializer.deserialize<int64_t>(argsArr->get(1), "fields");
+    }
+    auto result = _threadApi.getMessage(messageId, fields);
     return _serializer.serialize(result);
 }
 
 Poco::Dynamic::Var ThreadApiVarInterface::listMessages(const Poco::Dynamic::Var& args) {
-    auto argsArr = core::VarInterfaceUtil::validateAndExtractArray(args, 2);
+    auto argsArr = core::VarInterfaceUtil::validateAndExtractArray(args, 2, 3);
     auto threadId = _deserializer.deserialize<std::string>(argsArr->get(0), "threadId");
     auto pagingQuery = _deserializer.deserialize<core::PagingQuery>(argsArr->get(1), "pagingQuery");
-    auto result = _threadApi.listMessages(threadId, pagingQuery);
+    int64_t fields = core::DataField::ALL_DATA_FIELDS;
+    if(argsArr->size() >= 3) {
+        fields = _deserializer.deserialize<int64_t>(argsArr->get(2), "fields");
+    }
+    auto result = _threadApi.listMessages(threadId, pagingQuery, fields);
     return _serializer.serialize(result);
 }
 
@@ -153,6 +182,21 @@ Poco::Dynamic::Var ThreadApiVarInterface::buildSubscriptionQuery(const Poco::Dyn
     return _serializer.serialize(result);
 }
 
+Poco::Dynamic::Var ThreadApiVarInterface::enableMessageCache(const Poco::Dynamic::Var& args) {
+    auto argsArr = core::VarInterfaceUtil::validateAndExtractArray(args, 2);
+    auto cacheDirectory = _deserializer.deserialize<std::string>(argsArr->get(0), "cacheDirectory");
+    auto maxCacheSize = _deserializer.deserialize<int64_t>(argsArr->get(1), "maxCacheSize");
+    _threadApi.enableMessageCache(cacheDirectory, maxCacheSize);
+    return {};
+}
+
+Poco::Dynamic::Var ThreadApiVarInterface::syncThread(const Poco::Dynamic::Var& args) {
+    auto argsArr = core::VarInterfaceUtil::validateAndExtractArray(args, 1);
+    auto threadId = _deserializer.deserialize<std::string>(argsArr->get(0), "threadId");
+    _threadApi.syncThread(threadId);
+    return {};
+}
+
 Poco::Dynamic::Var ThreadApiVarInterface::exec(METHOD method, const Poco::Dynamic::Var& args) {
     auto it = methodMap.find(method);
     if (it == methodMap.end()) {
@@ -17,6 +17,7 @@ limitations under the License.
 #include <privmx/rpc/RpcException.hpp>
 #include <privmx/rpc/RpcConfig.hpp>
 #include <privmx/utils/Logger.hpp>
+#include <privmx/utils/MetricsRegistry.hpp>
 
 #ifdef PRIVMX_ENABLE_NET_EMSCRIPTEN
 #include <emscripten/emscripten.h>
@@ -76,6 +77,7 @@ const ConnectionOptionsFull& AuthorizedConnection::getOptions() {
 
 Var AuthorizedConnection::call(const std::string& method, Poco::JSON::Object::Ptr params, const MessageSendOptionsEx& options, privmx::utils::CancellationToken::Ptr token, bool force_plain) {
     ClientEndpoint endpoint(_tickets_manager, _options);
+    auto start = utils::MetricsRegistry::Clock::now();
     try {
         auto result = endpoint.call(method, params, force_plain);
         bool web_socket = options.channel_type.value_or(_options.main_channel) == ChannelType::WEBSOCKET;
@@ -88,12 +90,16 @@ Var AuthorizedConnection::call(const std::string& method, Poco::JSON::Object::Pt
             emscripten_sleep(10);
         } while(status == std::future_status::timeout);
         #endif
-        return result.get();
+        auto value = result.get();
+        utils::MetricsRegistry::recordRpcCall(method, start, false);
+        return value;
     } catch (const TicketsCountIsEqualZeroException& e) {
+        utils::MetricsRegistry::recordRpcCall(method, start, true);
         _session_established = false;
         _session_lost_event_dispatcher.dispatch({});
         e.rethrow();
     } catch (const utils::PrivmxException& e) {
+        utils::MetricsRegistry::recordRpcCall(method, start, true);
         if (e.hasTypeAndMessage(utils::PrivmxException::ALERT, "Invalid ticket")) {
             _session_established = false;
         }
@@ -0,0 +1,107 @@
+#include <string>
+#include <gtest/gtest.h>
+#include "../utils/BaseTest.hpp"
+#include <privmx/endpoint/core/EventQueue.hpp>
+#include <privmx/endpoint/core/cinterface/core.h>
+#include <privmx/endpoint/core/cinterface/InterfaceException.hpp>
+#include <privmx/endpoint/event/cinterface/event.h>
+#include <privmx/endpoint/kvdb/cinterface/kvdb.h>
+#include <privmx/endpoint/store/cinterface/store.h>
+#include <privmx/endpoint/thread/cinterface/thread.h>
+
+using namespace privmx::endpoint;
+
+class CInterfaceTest : public privmx::test::BaseTest {
+protected:
+    CInterfaceTest() : BaseTest(privmx::test::BaseTestMode::offline) {}
+    void customSetUp() override {
+        privmx_endpoint_newConnection(&connection);
+    }
+    void customTearDown() override {
+        privmx_endpoint_freeConnection(connection);
+        connection = nullptr;
+    }
+    void expectNullPointerError(int status, const privmx_error& error) {
+        EXPECT_EQ(status, 0);
+        EXPECT_EQ(error.code, cinterface::NullPointerException().getCode());
+    }
+    Connection* connection = nullptr;
+    privmx_const_buffer empty = {.data = nullptr, .size = 0};
+    privmx_const_buffer nullData = {.data = nullptr, .size = 4};
+};
+
+TEST_F(CInterfaceTest, waitEvent_returns_event_as_buffers) {
+    EventQueue* queue = nullptr;
+    privmx_endpoint_newEventQueue(&queue);
+    core::EventQueue::getInstance().emitBreakEvent();
+    privmx_event event;
+    privmx_error error;
+    EXPECT_EQ(privmx_endpoint_waitEvent(queue, &event, &error), 1);
+    EXPECT_EQ(error.code, 0);
+    EXPECT_EQ(std::string(event.type.data, event.type.size), "libBreak");
+    EXPECT_EQ(event.type.data[event.type.size], '\0');
+    EXPECT_NE(std::string(event.json.data, event.json.size).find("libBreak"), std::string::npos);
+    privmx_endpoint_freeEvent(&event);
+    EXPECT_EQ(event.type.data, nullptr);
+    EXPECT_EQ(event.json.owner, nullptr);
+    privmx_endpoint_freeEvent(nullptr);
+    privmx_endpoint_freeBuffer(nullptr);
+    privmx_endpoint_freeKvdbEntry(nullptr);
+    expectNullPointerError(privmx_endpoint_waitEvent(queue, nullptr, &error), error);
+    expectNullPointerError(privmx_endpoint_waitEvent(nullptr, &event, &error), error);
+    privmx_endpoint_freeEventQueue(queue);
+}
+
+TEST_F(CInterfaceTest, null_arguments_are_reported_as_error) {
+    privmx_error error;
+    privmx_buffer out;
+    privmx_kvdb_entry entry;
+    privmx_user_with_pub_key users[] = {{.userId = "user", .pubKey = nullptr}};
+
+    ThreadApi* threadApi = nullptr;
+    privmx_endpoint_newThreadApi(connection, &threadApi);
+    expectNullPointerError(privmx_endpoint_threadSendMessage(nullptr, "threadId", empty, empty, empty, &out, &error), error);
+    expectNullPointerError(privmx_endpoint_threadSendMessage(threadApi, nullptr, empty, empty, empty, &out, &error), error);
+    expectNullPointerError(privmx_endpoint_threadSendMessage(threadApi, "threadId", empty, empty, nullData, &out, &error), error);
+    expectNullPointerError(privmx_endpoint_threadSendMessage(threadApi, "threadId", empty, empty, empty, nullptr, &error), error);
+    EXPECT_EQ(privmx_endpoint_threadSendMessage(threadApi, nullptr, empty, empty, empty, &out, nullptr), 0);
+    privmx_endpoint_freeThreadApi(threadApi);
+
+    StoreApi* storeApi = nullptr;
+    privmx_endpoint_newStoreApi(connection, &storeApi);
+    expectNullPointerError(privmx_endpoint_storeWriteToFile(nullptr, 0, empty, 0, &error), error);
+    expectNullPointerError(privmx_endpoint_storeWriteToFile(storeApi, 0, nullData, 0, &error), error);
+    expectNullPointerError(privmx_endpoint_storeReadFromFile(nullptr, 0, 1, &out, &error), error);
+    expectNullPointerError(privmx_endpoint_storeReadFromFile(storeApi, 0, 1, nullptr, &error), error);
+    privmx_endpoint_freeStoreApi(storeApi);
+
+    KvdbApi* kvdbApi = nullptr;
+    privmx_endpoint_newKvdbApi(connection, &kvdbApi);
+    expectNullPointerError(privmx_endpoint_kvdbGetEntry(nullptr, "kvdbId", "key", &entry, &error), error);
+    expectNullPointerError(privmx_endpoint_kvdbGetEntry(kvdbApi, nullptr, "key", &entry, &error), error);
+    expectNullPointerError(privmx_endpoint_kvdbGetEntry(kvdbApi, "kvdbId", nullptr, &entry, &error), error);
+    expectNullPointerError(privmx_endpoint_kvdbGetEntry(kvdbApi, "kvdbId", "key", nullptr, &error), error);
+    privmx_endpoint_freeKvdbApi(kvdbApi);
+
+    EventApi* eventApi = nullptr;
+    privmx_endpoint_newEventApi(connection, &eventApi);
+    expectNullPointerError(privmx_endpoint_eventEmitEvent(nullptr, "contextId", nullptr, 0, "channel", empty, &error), error);
+    expectNullPointerError(privmx_endpoint_eventEmitEvent(eventApi, nullptr, nullptr, 0, "channel", empty, &error), error);
+    expectNullPointerError(privmx_endpoint_eventEmitEvent(eventApi, "contextId", nullptr, 1, "channel", empty, &error), error);
+    expectNullPointerError(privmx_endpoint_eventEmitEvent(eventApi, "contextId", users, 1, "channel", empty, &error), error);
+    expectNullPointerError(privmx_endpoint_eventEmitEvent(eventApi, "contextId", nullptr, 0, nullptr, empty, &error), error);
+    expectNullPointerError(privmx_endpoint_eventEmitEvent(eventApi, "contextId", nullptr, 0, "channel", nullData, &error), error);
+    privmx_endpoint_freeEventApi(eventApi);
+}
+
+TEST_F(CInterfaceTest, calls_on_not_initialized_api_fail_with_error) {
+    privmx_error error;
+    privmx_buffer out;
+    ThreadApi* threadApi = nullptr;
+    privmx_endpoint_newThreadApi(connection, &threadApi);
+    EXPECT_EQ(privmx_endpoint_threadSendMessage(threadApi, "threadId", empty, empty, empty, &out, &error), 0);
+    EXPECT_NE(error.code, 0);
+    EXPECT_NE(error.code, cinterface::NullPointerException().getCode());
+    EXPECT_GT(std::string(error.message).size(), 0);
+    privmx_endpoint_freeThreadApi(threadApi);
+}
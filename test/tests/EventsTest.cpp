@@ -256,4 +256,71 @@ TEST_F(EventTest, subscribeFor_unsubscribeFor) {
             invalid_subscriptions 
         });
     });
-}
\ No newline at end of file
+}
+TEST_F(EventTest, emitEvent_channelSession) {
+    std::shared_ptr<privmx::endpoint::core::Event> event = nullptr;
+    EXPECT_NO_THROW({
+        std::optional<core::EventHolder> eventHolder = eventQueue.waitEvent();
+        if(eventHolder.has_value()) {
+            event = eventHolder.value().get();
+        } else {
+            event = nullptr;
+        }
+    });
+    if(event != nullptr) {
+        EXPECT_EQ(event->type, "libConnected");
+    } else {
+        FAIL();
+    }
+    EXPECT_THROW({
+        eventApi->enableChannelSession(reader->getString("Context_1.contextId"), "testing", -1, 60000);
+    }, core::Exception);
+    EXPECT_THROW({
+        eventApi->enableChannelSession(reader->getString("Context_1.contextId"), "testing", 2, 0);
+    }, core::Exception);
+    EXPECT_NO_THROW({
+        eventApi->subscribeFor({
+            eventApi->buildSubscriptionQuery(
+                "testing", 
+                event::EventSelectorType::CONTEXT_ID,
+                reader->getString("Context_1.contextId")
+            )
+        });
+        eventApi->enableChannelSession(reader->getString("Context_1.contextId"), "testing", 2, 60000);
+    });
+    // first event carries the wrapped key, the second one references it, the third one rotates the key
+    EXPECT_NO_THROW({
+        std::vector<privmx::endpoint::core::UserWithPubKey> users;
+        users.push_back(privmx::endpoint::core::UserWithPubKey{.userId=reader->getString("Login.user_1_id"), .pubKey=reader->getString("Login.user_1_pubKey")});
+        for(int i = 0; i < 3; i++) {
+            eventApi->emitEvent(
+                reader->getString("Context_1.contextId"),
+                users,
+                "testing", 
+                core::Buffer::from("test event " + std::to_string(i))
+            );
+        }
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+    for(int i = 0; i < 3; i++) {
+        EXPECT_NO_THROW({
+            std::optional<core::EventHolder> eventHolder = eventQueue.getEvent();
+            if(eventHolder.has_value()) {
+                event = eventHolder.value().get();
+            } else {
+                event = nullptr;
+            }
+        });
+        if(event != nullptr && event::Events::isContextCustomEvent(event)) {
+            event::ContextCustomEvent customContextEvent = event::Events::extractContextCustomEvent(event);
+            EXPECT_EQ(customContextEvent.data.userId, reader->getString("Login.user_1_id"));
+            EXPECT_EQ(customContextEvent.data.payload.stdString(), "test event " + std::to_string(i));
+            EXPECT_EQ(customContextEvent.data.statusCode, 0);
+        } else {
+            FAIL();
+        }
+    }
+    EXPECT_NO_THROW({
+        eventApi->disableChannelSession(reader->getString("Context_1.contextId"), "testing");
+    });
+}
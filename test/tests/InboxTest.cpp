@@ -2171,4 +2171,215 @@ TEST_F(InboxTest, falseUserVerifierInterface) {
     } else {
         FAIL();
     }
-}
\ No newline at end of file
+}
+TEST_F(InboxTest, sendEntry_many_files_interleaved_writes) {
+    const size_t filesCount = 6;
+    const size_t chunksCount = 40;
+    std::vector<int64_t> fileHandles;
+    std::vector<std::string> filesData(filesCount);
+    for(size_t i = 0; i < filesCount; i++) {
+        EXPECT_NO_THROW({
+            fileHandles.push_back(inboxApi->createFileHandle(
+                privmx::endpoint::core::Buffer::from("publicMeta_" + std::to_string(i)),
+                privmx::endpoint::core::Buffer::from("privateMeta_" + std::to_string(i)),
+                (chunksCount * 4096) + i
+            ));
+        });
+    }
+    ASSERT_EQ(fileHandles.size(), filesCount);
+    int64_t inboxHandle = 0;
+    EXPECT_NO_THROW({
+        inboxHandle = inboxApi->prepareEntry(
+            reader->getString("Inbox_2.inboxId"),
+            core::Buffer::from("test_sendEntry"),
+            fileHandles,
+            reader->getString("Login.user_1_privKey")
+        );
+    });
+    ASSERT_NE(inboxHandle, 0);
+    // writes to different files are interleaved, data of each file must keep its order
+    EXPECT_NO_THROW({
+        for(size_t chunk = 0; chunk < chunksCount; chunk++) {
+            for(size_t i = 0; i < filesCount; i++) {
+                std::string random_data = privmx::crypto::Crypto::randomBytes(4096);
+                inboxApi->writeToFile(inboxHandle, fileHandles[i], core::Buffer::from(random_data));
+                filesData[i] += random_data;
+            }
+        }
+        for(size_t i = 0; i < filesCount; i++) {
+            std::string random_data = privmx::crypto::Crypto::randomBytes(i);
+            inboxApi->writeToFile(inboxHandle, fileHandles[i], core::Buffer::from(random_data));
+            filesData[i] += random_data;
+        }
+    });
+    EXPECT_NO_THROW({
+        inboxApi->sendEntry(inboxHandle);
+    });
+    auto entries = inboxApi->listEntries(
+        reader->getString("Inbox_2.inboxId"),
+        {
+            .skip=0,
+            .limit=1,
+            .sortOrder="asc"
+        }
+    );
+    ASSERT_EQ(entries.readItems.size(), 1);
+    auto entry = entries.readItems[0];
+    EXPECT_EQ(entry.data.stdString(), "test_sendEntry");
+    ASSERT_EQ(entry.files.size(), filesCount);
+    for(size_t i = 0; i < filesCount; i++) {
+        auto file = entry.files[i];
+        EXPECT_EQ(file.statusCode, 0);
+        EXPECT_EQ(file.publicMeta.stdString(), "publicMeta_" + std::to_string(i));
+        EXPECT_EQ(file.privateMeta.stdString(), "privateMeta_" + std::to_string(i));
+        EXPECT_EQ(file.size, (int64_t)filesData[i].size());
+        int64_t readHandle = inboxApi->openFile(file.info.fileId);
+        EXPECT_EQ(inboxApi->readFromFile(readHandle, file.size).stdString(), filesData[i]);
+        inboxApi->closeFile(readHandle);
+    }
+}
+
+TEST_F(InboxTest, sendEntry_file_write_error_reported) {
+    int64_t fileHandle_1 = 0;
+    int64_t fileHandle_2 = 0;
+    EXPECT_NO_THROW({
+        fileHandle_1 = inboxApi->createFileHandle(core::Buffer::from("publicMeta_1"), core::Buffer::from("privateMeta_1"), 1024);
+        fileHandle_2 = inboxApi->createFileHandle(core::Buffer::from("publicMeta_2"), core::Buffer::from("privateMeta_2"), 1024);
+    });
+    int64_t inboxHandle = 0;
+    EXPECT_NO_THROW({
+        inboxHandle = inboxApi->prepareEntry(
+            reader->getString("Inbox_2.inboxId"),
+            core::Buffer::from("test_sendEntry"),
+            {fileHandle_1, fileHandle_2},
+            reader->getString("Login.user_1_privKey")
+        );
+    });
+    ASSERT_NE(inboxHandle, 0);
+    // file handle not tied to the inbox handle
+    int64_t fileHandle_3 = inboxApi->createFileHandle(core::Buffer::from("publicMeta_3"), core::Buffer::from("privateMeta_3"), 1024);
+    EXPECT_THROW({
+        inboxApi->writeToFile(inboxHandle, fileHandle_3, core::Buffer::from("data"));
+    }, inbox::InboxHandleIsNotTiedToInboxFileHandleException);
+    // data bigger than declared, the error of the background write is reported by sendEntry
+    EXPECT_NO_THROW({
+        inboxApi->writeToFile(inboxHandle, fileHandle_1, core::Buffer::from(privmx::crypto::Crypto::randomBytes(1024)));
+        inboxApi->writeToFile(inboxHandle, fileHandle_2, core::Buffer::from(privmx::crypto::Crypto::randomBytes(2048)));
+    });
+    EXPECT_THROW({
+        inboxApi->sendEntry(inboxHandle);
+    }, core::DataBiggerThanDeclaredException);
+    // the failed entry is aborted together with its file handles
+    EXPECT_THROW({
+        inboxApi->sendEntry(inboxHandle);
+    }, inbox::UnknownInboxHandleException);
+    EXPECT_THROW({
+        inboxApi->writeToFile(inboxHandle, fileHandle_1, core::Buffer::from("data"));
+    }, inbox::UnknownInboxHandleException);
+}
+
+TEST_F(InboxTest, listEntries_files_meta_batched_and_deferred) {
+    const size_t entriesCount = 3;
+    const size_t filesPerEntry = 3;
+    for(size_t e = 0; e < entriesCount; e++) {
+        std::vector<int64_t> fileHandles;
+        for(size_t f = 0; f < filesPerEntry; f++) {
+            fileHandles.push_back(inboxApi->createFileHandle(
+                core::Buffer::from("publicMeta_" + std::to_string(e) + "_" + std::to_string(f)),
+                core::Buffer::from("privateMeta_" + std::to_string(e) + "_" + std::to_string(f)),
+                0
+            ));
+        }
+        EXPECT_NO_THROW({
+            auto inboxHandle = inboxApi->prepareEntry(
+                reader->getString("Inbox_2.inboxId"),
+                core::Buffer::from("entry_" + std::to_string(e)),
+                fileHandles,
+                reader->getString("Login.user_1_privKey")
+            );
+            inboxApi->sendEntry(inboxHandle);
+        });
+    }
+    core::PagingList<inbox::InboxEntry> entries;
+    core::PagingList<inbox::InboxEntry> entriesWithoutFilesMeta;
+    EXPECT_NO_THROW({
+        entries = inboxApi->listEntries(reader->getString("Inbox_2.inboxId"), {.skip=0, .limit=10, .sortOrder="asc"});
+        entriesWithoutFilesMeta = inboxApi->listEntriesWithoutFilesMeta(reader->getString("Inbox_2.inboxId"), {.skip=0, .limit=10, .sortOrder="asc"});
+    });
+    ASSERT_EQ(entries.readItems.size(), entriesCount);
+    ASSERT_EQ(entriesWithoutFilesMeta.readItems.size(), entriesCount);
+    for(size_t e = 0; e < entriesCount; e++) {
+        auto entry = entries.readItems[e];
+        auto entryWithoutFilesMeta = entriesWithoutFilesMeta.readItems[e];
+        EXPECT_EQ(entry.statusCode, 0);
+        EXPECT_EQ(entry.data.stdString(), "entry_" + std::to_string(e));
+        EXPECT_EQ(entryWithoutFilesMeta.entryId, entry.entryId);
+        EXPECT_EQ(entryWithoutFilesMeta.data.stdString(), entry.data.stdString());
+        ASSERT_EQ(entry.files.size(), filesPerEntry);
+        ASSERT_EQ(entryWithoutFilesMeta.files.size(), filesPerEntry);
+        auto readEntry = inboxApi->readEntry(entry.entryId);
+        ASSERT_EQ(readEntry.files.size(), filesPerEntry);
+        for(size_t f = 0; f < filesPerEntry; f++) {
+            EXPECT_EQ(entry.files[f].statusCode, 0);
+            EXPECT_EQ(entry.files[f].publicMeta.stdString(), "publicMeta_" + std::to_string(e) + "_" + std::to_string(f));
+            EXPECT_EQ(entry.files[f].privateMeta.stdString(), "privateMeta_" + std::to_string(e) + "_" + std::to_string(f));
+            EXPECT_EQ(entry.files[f].info.fileId, readEntry.files[f].info.fileId);
+            EXPECT_EQ(entryWithoutFilesMeta.files[f].info.fileId, entry.files[f].info.fileId);
+            EXPECT_EQ(entryWithoutFilesMeta.files[f].info.storeId, entry.files[f].info.storeId);
+            EXPECT_EQ(entryWithoutFilesMeta.files[f].publicMeta.size(), 0);
+        }
+    }
+}
+
+TEST_F(InboxTest, addInboxMembers_and_removeInboxMembers) {
+    inbox::Inbox inbox;
+    // Inbox_1 has only user_1, user_2 is added as a user
+    EXPECT_NO_THROW({
+        inboxApi->addInboxMembers(
+            reader->getString("Inbox_1.inboxId"),
+            std::vector<core::UserWithPubKey>{core::UserWithPubKey{
+                .userId=reader->getString("Login.user_2_id"),
+                .pubKey=reader->getString("Login.user_2_pubKey")
+            }},
+            std::vector<core::UserWithPubKey>{}
+        );
+    });
+    EXPECT_NO_THROW({
+        inbox = inboxApi->getInbox(
+            reader->getString("Inbox_1.inboxId")
+        );
+    });
+    EXPECT_EQ(inbox.version, 2);
+    EXPECT_EQ(inbox.users, std::vector<std::string>({reader->getString("Login.user_1_id"), reader->getString("Login.user_2_id")}));
+    EXPECT_EQ(inbox.managers, std::vector<std::string>({reader->getString("Login.user_1_id")}));
+    EXPECT_EQ(inbox.publicMeta.stdString(), privmx::utils::Hex::toString(reader->getString("Inbox_1.publicMeta_inHex")));
+    EXPECT_EQ(inbox.privateMeta.stdString(), privmx::utils::Hex::toString(reader->getString("Inbox_1.privateMeta_inHex")));
+    // Inbox_3 has user_1 and user_2, user_2 is removed
+    EXPECT_NO_THROW({
+        inboxApi->removeInboxMembers(
+            reader->getString("Inbox_3.inboxId"),
+            std::vector<std::string>{reader->getString("Login.user_2_id")}
+        );
+    });
+    EXPECT_NO_THROW({
+        inbox = inboxApi->getInbox(
+            reader->getString("Inbox_3.inboxId")
+        );
+    });
+    EXPECT_EQ(inbox.users, std::vector<std::string>({reader->getString("Login.user_1_id")}));
+    EXPECT_EQ(inbox.managers, std::vector<std::string>({reader->getString("Login.user_1_id")}));
+    EXPECT_EQ(inbox.statusCode, 0);
+    disconnect();
+    connectAs(User2);
+    EXPECT_NO_THROW({
+        inbox = inboxApi->getInbox(
+            reader->getString("Inbox_1.inboxId")
+        );
+    });
+    EXPECT_EQ(inbox.statusCode, 0);
+    EXPECT_THROW({
+        inboxApi->getInbox(
+            reader->getString("Inbox_3.inboxId")
+        );
+    }, core::Exception);
+}
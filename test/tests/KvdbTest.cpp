@@ -1644,3 +1644,58 @@ TEST_F(KvdbTest, falseUserVerifierInterface) {
         FAIL();
     }
 }
+
+TEST_F(KvdbTest, addKvdbMembers_and_removeKvdbMembers) {
+    kvdb::Kvdb kvdb;
+    // Kvdb_1 has only user_1, user_2 is added as a user
+    EXPECT_NO_THROW({
+        kvdbApi->addKvdbMembers(
+            reader->getString("Kvdb_1.kvdbId"),
+            std::vector<core::UserWithPubKey>{core::UserWithPubKey{
+                .userId=reader->getString("Login.user_2_id"),
+                .pubKey=reader->getString("Login.user_2_pubKey")
+            }},
+            std::vector<core::UserWithPubKey>{}
+        );
+    });
+    EXPECT_NO_THROW({
+        kvdb = kvdbApi->getKvdb(
+            reader->getString("Kvdb_1.kvdbId")
+        );
+    });
+    EXPECT_EQ(kvdb.version, 2);
+    EXPECT_EQ(kvdb.users, std::vector<std::string>({reader->getString("Login.user_1_id"), reader->getString("Login.user_2_id")}));
+    EXPECT_EQ(kvdb.managers, std::vector<std::string>({reader->getString("Login.user_1_id")}));
+    EXPECT_EQ(kvdb.publicMeta.stdString(), privmx::utils::Hex::toString(reader->getString("Kvdb_1.publicMeta_inHex")));
+    EXPECT_EQ(kvdb.privateMeta.stdString(), privmx::utils::Hex::toString(reader->getString("Kvdb_1.privateMeta_inHex")));
+    // Kvdb_3 has user_1 and user_2, user_2 is removed
+    EXPECT_NO_THROW({
+        kvdbApi->removeKvdbMembers(
+            reader->getString("Kvdb_3.kvdbId"),
+            std::vector<std::string>{reader->getString("Login.user_2_id")}
+        );
+    });
+    EXPECT_NO_THROW({
+        kvdb = kvdbApi->getKvdb(
+            reader->getString("Kvdb_3.kvdbId")
+        );
+    });
+    EXPECT_EQ(kvdb.users, std::vector<std::string>({reader->getString("Login.user_1_id")}));
+    EXPECT_EQ(kvdb.managers, std::vector<std::string>({reader->getString("Login.user_1_id")}));
+    EXPECT_EQ(kvdb.statusCode, 0);
+    disconnect();
+    connectAs(User2);
+    privmx::endpoint::kvdb::KvdbEntry entry;
+    EXPECT_NO_THROW({
+        entry = kvdbApi->getEntry(
+            reader->getString("Kvdb_1.kvdbId"),
+            reader->getString("KvdbEntry_1.info_key")
+        );
+    });
+    EXPECT_EQ(entry.statusCode, 0);
+    EXPECT_THROW({
+        kvdbApi->getKvdb(
+            reader->getString("Kvdb_3.kvdbId")
+        );
+    }, core::Exception);
+}
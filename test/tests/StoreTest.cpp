@@ -13,6 +13,8 @@
 #include <privmx/endpoint/store/StoreException.hpp>
 #include <privmx/endpoint/core/CoreException.hpp>
 #include <privmx/endpoint/core/UserVerifierInterface.hpp>
+#include <filesystem>
+#include <fstream>
 
 using namespace privmx::endpoint;
 
@@ -2981,3 +2983,431 @@ TEST_F(StoreTest, falseUserVerifierInterface) {
         FAIL();
     }
 }
+
+TEST_F(StoreTest, uploadFileFromPath_downloadFileToPath) {
+    std::string uploadPath = "/tmp/privmx_store_test_upload.bin";
+    std::string downloadPath = "/tmp/privmx_store_test_download.bin";
+    std::string data = privmx::crypto::Crypto::randomBytes(1024*1024 + 123);
+    {
+        std::ofstream out(uploadPath, std::ios::binary);
+        out.write(data.data(), data.size());
+    }
+    std::string fileId;
+    EXPECT_NO_THROW({
+        fileId = storeApi->uploadFileFromPath(
+            reader->getString("Store_1.storeId"),
+            privmx::endpoint::core::Buffer::from("publicMeta"),
+            privmx::endpoint::core::Buffer::from("privateMeta"),
+            uploadPath
+        );
+    });
+    if(fileId.empty()) {
+        std::cout << "uploadFileFromPath Failed" << std::endl;
+        FAIL();
+    }
+    store::File file;
+    EXPECT_NO_THROW({
+        file = storeApi->getFile(fileId);
+    });
+    EXPECT_EQ(file.size, (int64_t)data.size());
+    EXPECT_NO_THROW({
+        storeApi->downloadFileToPath(fileId, downloadPath);
+    });
+    std::ifstream in(downloadPath, std::ios::binary);
+    std::string downloaded((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    EXPECT_EQ(downloaded, data);
+    // not existing local file
+    EXPECT_THROW({
+        storeApi->uploadFileFromPath(
+            reader->getString("Store_1.storeId"),
+            privmx::endpoint::core::Buffer::from("publicMeta"),
+            privmx::endpoint::core::Buffer::from("privateMeta"),
+            "/tmp/privmx_store_test_not_existing/file.bin"
+        );
+    }, store::LocalFileOpenFailedException);
+    std::remove(uploadPath.c_str());
+    std::remove(downloadPath.c_str());
+}
+
+TEST_F(StoreTest, resumeUpload_from_checkpoint) {
+    std::string data = privmx::crypto::Crypto::randomBytes(3*128*1024 + 4321);
+    size_t firstPart = 128*1024 + 1000;
+    int64_t handle = 0;
+    EXPECT_NO_THROW({
+        storeApi->enableUploadProgressJournal("/tmp/privmx_store_test_upload_journal");
+        handle = storeApi->createFile(
+            reader->getString("Store_1.storeId"),
+            privmx::endpoint::core::Buffer::from("publicMeta"),
+            privmx::endpoint::core::Buffer::from("privateMeta"),
+            data.size()
+        );
+    });
+    if(handle == 0) {
+        std::cout << "createFile Failed" << std::endl;
+        FAIL();
+    }
+    storeApi->writeToFile(handle, core::Buffer::from(data.substr(0, firstPart)));
+    store::UploadCheckpoint checkpoint;
+    EXPECT_NO_THROW({
+        checkpoint = storeApi->getUploadCheckpoint(handle);
+    });
+    EXPECT_EQ(checkpoint.offset, (int64_t)firstPart);
+    // simulate a lost connection, the old handle is gone together with the connection
+    disconnect();
+    connectAs(ConnectionType::User1);
+    // tampered checkpoint
+    std::string tampered = checkpoint.data.stdString();
+    tampered[tampered.size() / 2] ^= 0x01;
+    EXPECT_THROW({
+        storeApi->resumeUpload(core::Buffer::from(tampered));
+    }, store::InvalidUploadCheckpointException);
+    int64_t resumedHandle = 0;
+    EXPECT_NO_THROW({
+        resumedHandle = storeApi->resumeUpload(checkpoint.data);
+    });
+    if(resumedHandle == 0) {
+        std::cout << "resumeUpload Failed" << std::endl;
+        FAIL();
+    }
+    std::string fileId;
+    EXPECT_NO_THROW({
+        storeApi->writeToFile(resumedHandle, core::Buffer::from(data.substr(checkpoint.offset)));
+        fileId = storeApi->closeFile(resumedHandle);
+    });
+    int64_t readHandle = 0;
+    EXPECT_NO_THROW({
+        readHandle = storeApi->openFile(fileId);
+    });
+    if(readHandle == 0) {
+        std::cout << "openFile Failed" << std::endl;
+        FAIL();
+    }
+    core::Buffer fileData;
+    EXPECT_NO_THROW({
+        fileData = storeApi->readFromFile(readHandle, data.size());
+    });
+    EXPECT_EQ(fileData.stdString(), data);
+}
+
+TEST_F(StoreTest, resumeUpload_from_stale_checkpoint) {
+    std::string data = privmx::crypto::Crypto::randomBytes(8*1024*1024 + 4321);
+    size_t firstPart = 128*1024 + 1000;
+    size_t secondPart = 6*1024*1024;
+    std::string journalDirectory = "/tmp/privmx_store_test_stale_upload_journal";
+    std::filesystem::remove_all(journalDirectory);
+    int64_t handle = 0;
+    EXPECT_NO_THROW({
+        storeApi->enableUploadProgressJournal(journalDirectory);
+        handle = storeApi->createFile(
+            reader->getString("Store_1.storeId"),
+            privmx::endpoint::core::Buffer::from("publicMeta"),
+            privmx::endpoint::core::Buffer::from("privateMeta"),
+            data.size()
+        );
+    });
+    if(handle == 0) {
+        std::cout << "createFile Failed" << std::endl;
+        FAIL();
+    }
+    store::UploadCheckpoint oldCheckpoint;
+    store::UploadCheckpoint newCheckpoint;
+    EXPECT_NO_THROW({
+        storeApi->writeToFile(handle, core::Buffer::from(data.substr(0, firstPart)));
+        oldCheckpoint = storeApi->getUploadCheckpoint(handle);
+        // sends chunks to the server after the first checkpoint
+        storeApi->writeToFile(handle, core::Buffer::from(data.substr(firstPart, secondPart)));
+        newCheckpoint = storeApi->getUploadCheckpoint(handle);
+    });
+    EXPECT_EQ(newCheckpoint.offset, (int64_t)(firstPart + secondPart));
+    // the progress accepted by the server is kept on disk, to refuse the old checkpoint also after a restart
+    EXPECT_FALSE(std::filesystem::is_empty(journalDirectory));
+    disconnect();
+    connectAs(ConnectionType::User1);
+    EXPECT_THROW({
+        storeApi->resumeUpload(oldCheckpoint.data);
+    }, store::StaleUploadCheckpointException);
+    int64_t resumedHandle = 0;
+    EXPECT_NO_THROW({
+        resumedHandle = storeApi->resumeUpload(newCheckpoint.data);
+    });
+    if(resumedHandle == 0) {
+        std::cout << "resumeUpload Failed" << std::endl;
+        FAIL();
+    }
+    std::string fileId;
+    EXPECT_NO_THROW({
+        storeApi->writeToFile(resumedHandle, core::Buffer::from(data.substr(newCheckpoint.offset)));
+        fileId = storeApi->closeFile(resumedHandle);
+    });
+    // a finished upload cannot be resumed again
+    EXPECT_THROW({
+        storeApi->resumeUpload(newCheckpoint.data);
+    }, store::StaleUploadCheckpointException);
+    int64_t readHandle = 0;
+    EXPECT_NO_THROW({
+        readHandle = storeApi->openFile(fileId);
+    });
+    if(readHandle == 0) {
+        std::cout << "openFile Failed" << std::endl;
+        FAIL();
+    }
+    core::Buffer fileData;
+    EXPECT_NO_THROW({
+        fileData = storeApi->readFromFile(readHandle, data.size());
+    });
+    EXPECT_EQ(fileData.stdString(), data);
+}
+
+TEST_F(StoreTest, random_write_writeBackBuffer) {
+    int64_t rwFileHandle = 0;
+    std::string fileId = "";
+    EXPECT_NO_THROW({
+        auto t = storeApi->createFile(reader->getString("Store_1.storeId"), core::Buffer::from("RW_publicMeta"), core::Buffer::from("RW_privateMeta"), 0, true);
+        fileId = storeApi->closeFile(t);
+        rwFileHandle = storeApi->openFile(fileId);
+    });
+    if(rwFileHandle == 0) {
+        std::cout << "openFile Failed" << std::endl;
+        FAIL();
+    }
+    EXPECT_NO_THROW({
+        storeApi->setWriteBackBufferSize(rwFileHandle, 1024*1024);
+    });
+    std::string expected = std::string();
+    EXPECT_NO_THROW({
+        // many small writes stay in the buffer and must be visible to reads on the same handle
+        for(int i = 0; i < 100; i++) {
+            std::string part = std::string(100, (char)('A' + i % 26));
+            storeApi->writeToFile(rwFileHandle, core::Buffer::from(part));
+            expected += part;
+        }
+        storeApi->seekInFile(rwFileHandle, 50);
+        storeApi->writeToFile(rwFileHandle, core::Buffer::from("write-back"));
+        expected.replace(50, 10, "write-back");
+        storeApi->seekInFile(rwFileHandle, 0);
+        auto testWrite = storeApi->readFromFile(rwFileHandle, expected.size()+1).stdString();
+        EXPECT_EQ(testWrite, expected);
+    });
+    EXPECT_NO_THROW({
+        storeApi->closeFile(rwFileHandle);
+    });
+    store::File file;
+    std::string writtenData = "";
+    EXPECT_NO_THROW({
+        file = storeApi->getFile(fileId);
+        rwFileHandle = storeApi->openFile(fileId);
+        writtenData = storeApi->readFromFile(rwFileHandle, file.size).stdString();
+    });
+    EXPECT_EQ(file.size, (int64_t)expected.size());
+    EXPECT_EQ(writtenData, expected);
+    EXPECT_THROW({
+        storeApi->setWriteBackBufferSize(rwFileHandle, -1);
+    }, core::Exception);
+}
+
+TEST_F(StoreTest, random_write_writeBackBuffer_flush_failed) {
+    int64_t rwFileHandle = 0;
+    int64_t otherHandle = 0;
+    std::string fileId = "";
+    EXPECT_NO_THROW({
+        auto t = storeApi->createFile(reader->getString("Store_1.storeId"), core::Buffer::from("RW_publicMeta"), core::Buffer::from("RW_privateMeta"), 0, true);
+        fileId = storeApi->closeFile(t);
+        rwFileHandle = storeApi->openFile(fileId);
+        otherHandle = storeApi->openFile(fileId);
+    });
+    if(rwFileHandle == 0 || otherHandle == 0) {
+        std::cout << "openFile Failed" << std::endl;
+        FAIL();
+    }
+    EXPECT_NO_THROW({
+        storeApi->setWriteBackBufferSize(rwFileHandle, 1024*1024);
+        storeApi->writeToFile(rwFileHandle, core::Buffer::from("buffered"));
+        // newer version of the file written by the other handle
+        storeApi->writeToFile(otherHandle, core::Buffer::from("direct"));
+        storeApi->closeFile(otherHandle);
+    });
+    // pending writes are kept after the server refused them
+    EXPECT_THROW({
+        storeApi->setWriteBackBufferSize(rwFileHandle, 0);
+    }, core::Exception);
+    EXPECT_EQ(storeApi->readFromFile(rwFileHandle, 100).stdString(), "buffered");
+    // the handle is released although its pending writes cannot be sent
+    EXPECT_THROW({
+        storeApi->closeFile(rwFileHandle);
+    }, core::Exception);
+    EXPECT_THROW({
+        storeApi->closeFile(rwFileHandle);
+    }, store::InvalidFileHandleException);
+    // sync with writes that cannot be sent closes the handle
+    EXPECT_NO_THROW({
+        rwFileHandle = storeApi->openFile(fileId);
+        otherHandle = storeApi->openFile(fileId);
+        storeApi->setWriteBackBufferSize(rwFileHandle, 1024*1024);
+        storeApi->writeToFile(rwFileHandle, core::Buffer::from("buffered"));
+        storeApi->writeToFile(otherHandle, core::Buffer::from("direct2"));
+        storeApi->closeFile(otherHandle);
+    });
+    EXPECT_THROW({
+        storeApi->syncFile(rwFileHandle);
+    }, store::FileSyncFailedHandleCloseException);
+    EXPECT_THROW({
+        storeApi->readFromFile(rwFileHandle, 100);
+    }, store::InvalidFileHandleException);
+    std::string writtenData = "";
+    EXPECT_NO_THROW({
+        auto readHandle = storeApi->openFile(fileId);
+        writtenData = storeApi->readFromFile(readHandle, 100).stdString();
+        storeApi->closeFile(readHandle);
+    });
+    EXPECT_EQ(writtenData, "direct2");
+}
+
+TEST_F(StoreTest, random_write_sparse_file) {
+    int64_t rwFileHandle = 0;
+    std::string fileId = "";
+    EXPECT_NO_THROW({
+        auto t = storeApi->createFile(reader->getString("Store_1.storeId"), core::Buffer::from("RW_publicMeta"), core::Buffer::from("RW_privateMeta"), 0, true);
+        fileId = storeApi->closeFile(t);
+        rwFileHandle = storeApi->openFile(fileId);
+    });
+    if(rwFileHandle == 0) {
+        std::cout << "openFile Failed" << std::endl;
+        FAIL();
+    }
+    size_t holeOffset = 16*1024*1024 + 7;
+    std::string expected = "head" + std::string(holeOffset - 4, (char)0x00) + "tail";
+    EXPECT_NO_THROW({
+        storeApi->writeToFile(rwFileHandle, core::Buffer::from("head"));
+        // write far past the end of file, the chunks in between are left as holes
+        storeApi->seekInFile(rwFileHandle, holeOffset);
+        storeApi->writeToFile(rwFileHandle, core::Buffer::from("tail"));
+        storeApi->seekInFile(rwFileHandle, 0);
+        auto testWrite = storeApi->readFromFile(rwFileHandle, expected.size()+1).stdString();
+        EXPECT_EQ(testWrite, expected);
+    });
+    EXPECT_NO_THROW({
+        // write inside a hole
+        storeApi->seekInFile(rwFileHandle, holeOffset / 2);
+        storeApi->writeToFile(rwFileHandle, core::Buffer::from("middle"));
+        expected.replace(holeOffset / 2, 6, "middle");
+        storeApi->closeFile(rwFileHandle);
+    });
+    store::File file;
+    std::string writtenData = "";
+    EXPECT_NO_THROW({
+        file = storeApi->getFile(fileId);
+        // opening checks that the server extended the file over the holes to the size of the dense file
+        rwFileHandle = storeApi->openFile(fileId);
+        writtenData = storeApi->readFromFile(rwFileHandle, file.size).stdString();
+    });
+    EXPECT_EQ(file.size, (int64_t)expected.size());
+    EXPECT_EQ(writtenData, expected);
+}
+
+TEST_F(StoreTest, addStoreMembers_and_removeStoreMembers) {
+    store::Store store;
+    // Store_1 has only user_1, user_2 is added as a user
+    EXPECT_NO_THROW({
+        storeApi->addStoreMembers(
+            reader->getString("Store_1.storeId"),
+            std::vector<core::UserWithPubKey>{core::UserWithPubKey{
+                .userId=reader->getString("Login.user_2_id"),
+                .pubKey=reader->getString("Login.user_2_pubKey")
+            }},
+            std::vector<core::UserWithPubKey>{}
+        );
+    });
+    EXPECT_NO_THROW({
+        store = storeApi->getStore(
+            reader->getString("Store_1.storeId")
+        );
+    });
+    EXPECT_EQ(store.version, 2);
+    EXPECT_EQ(store.users, std::vector<std::string>({reader->getString("Login.user_1_id"), reader->getString("Login.user_2_id")}));
+    EXPECT_EQ(store.managers, std::vector<std::string>({reader->getString("Login.user_1_id")}));
+    EXPECT_EQ(store.publicMeta.stdString(), privmx::utils::Hex::toString(reader->getString("Store_1.publicMeta_inHex")));
+    EXPECT_EQ(store.privateMeta.stdString(), privmx::utils::Hex::toString(reader->getString("Store_1.privateMeta_inHex")));
+    // Store_3 has user_1 and user_2, user_2 is removed
+    EXPECT_NO_THROW({
+        storeApi->removeStoreMembers(
+            reader->getString("Store_3.storeId"),
+            std::vector<std::string>{reader->getString("Login.user_2_id")}
+        );
+    });
+    EXPECT_NO_THROW({
+        store = storeApi->getStore(
+            reader->getString("Store_3.storeId")
+        );
+    });
+    EXPECT_EQ(store.users, std::vector<std::string>({reader->getString("Login.user_1_id")}));
+    EXPECT_EQ(store.managers, std::vector<std::string>({reader->getString("Login.user_1_id")}));
+    EXPECT_EQ(store.statusCode, 0);
+    disconnect();
+    connectAs(User2);
+    privmx::endpoint::store::File file;
+    EXPECT_NO_THROW({
+        file = storeApi->getFile(
+            reader->getString("File_1.info_fileId")
+        );
+    });
+    EXPECT_EQ(file.statusCode, 0);
+    EXPECT_THROW({
+        storeApi->getStore(
+            reader->getString("Store_3.storeId")
+        );
+    }, core::Exception);
+}
+
+TEST_F(StoreTest, addStoreMembers_after_key_rotations_reads_older_files) {
+    connection->setKeyChainEnabled(true);
+    // every update generates a new key, File_1 stays encrypted with the oldest one
+    for(int64_t version = 1; version <= 3; version++) {
+        EXPECT_NO_THROW({
+            storeApi->updateStore(
+                reader->getString("Store_1.storeId"),
+                std::vector<core::UserWithPubKey>{core::UserWithPubKey{
+                    .userId=reader->getString("Login.user_1_id"),
+                    .pubKey=reader->getString("Login.user_1_pubKey")
+                }},
+                std::vector<core::UserWithPubKey>{core::UserWithPubKey{
+                    .userId=reader->getString("Login.user_1_id"),
+                    .pubKey=reader->getString("Login.user_1_pubKey")
+                }},
+                core::Buffer::from("public"),
+                core::Buffer::from("private"),
+                version,
+                false,
+                true
+            );
+        });
+    }
+    EXPECT_NO_THROW({
+        storeApi->addStoreMembers(
+            reader->getString("Store_1.storeId"),
+            std::vector<core::UserWithPubKey>{core::UserWithPubKey{
+                .userId=reader->getString("Login.user_2_id"),
+                .pubKey=reader->getString("Login.user_2_pubKey")
+            }},
+            std::vector<core::UserWithPubKey>{}
+        );
+    });
+    disconnect();
+    connectAs(User2);
+    privmx::endpoint::store::File file;
+    EXPECT_NO_THROW({
+        file = storeApi->getFile(
+            reader->getString("File_1.info_fileId")
+        );
+    });
+    EXPECT_EQ(file.statusCode, 0);
+    core::PagingList<store::File> files;
+    EXPECT_NO_THROW({
+        files = storeApi->listFiles(
+            reader->getString("Store_1.storeId"),
+            {.skip=0, .limit=100, .sortOrder="desc"}
+        );
+    });
+    for(const auto& listedFile : files.readItems) {
+        EXPECT_EQ(listedFile.statusCode, 0);
+    }
+}
@@ -13,6 +13,8 @@
 #include <privmx/endpoint/core/CoreException.hpp>
 #include <privmx/endpoint/core/UserVerifierInterface.hpp>
 #include <privmx/endpoint/stream/WebRTCInterface.hpp>
+#include <privmx/endpoint/stream/StreamException.hpp>
+#include <privmx/endpoint/stream/encryptors/dataChannel/DataChannelMessageEncryptorV2.hpp>
 
 using namespace privmx::endpoint;
 
@@ -715,4 +717,64 @@ TEST_F(StreamLowTest, falseUserVerifierInterface) {
     } else {
         FAIL();
     }
-}
\ No newline at end of file
+}
+TEST(DataChannelMessageEncryptorV2Test, encrypt_decrypt_reordered) {
+    std::vector<stream::Key> keys {
+        stream::Key{.keyId="local", .key=core::Buffer::from(privmx::crypto::Crypto::randomBytes(32)), .type=stream::KeyType::LOCAL}
+    };
+    stream::DataChannelMessageEncryptorV2 sender(keys);
+    stream::DataChannelMessageEncryptorV2 receiver(keys);
+    std::vector<core::Buffer> encrypted;
+    for(int64_t seq = 0; seq < 100; seq++) {
+        encrypted.push_back(sender.encryptMessage({core::Buffer::from("message " + std::to_string(seq)), seq}));
+    }
+    // counter nonces, no nonce repeats
+    EXPECT_NE(encrypted[0].stdString().substr(5, 12), encrypted[1].stdString().substr(5, 12));
+    EXPECT_EQ(encrypted[0].stdString().substr(5, 8), encrypted[1].stdString().substr(5, 8));
+    // reordered messages are accepted
+    for(int64_t seq : {1, 0, 5, 3, 2, 4}) {
+        auto decrypted = receiver.decryptMessage("remote", encrypted[seq]);
+        EXPECT_EQ(decrypted.statusCode, 0);
+        EXPECT_EQ(decrypted.seq, seq);
+        EXPECT_EQ(decrypted.data.stdString(), "message " + std::to_string(seq));
+    }
+    // replayed message is rejected
+    EXPECT_EQ(receiver.decryptMessage("remote", encrypted[3]).statusCode, stream::InvalidDataChannelSeqException().getCode());
+    // message older than the replay window is rejected
+    EXPECT_EQ(receiver.decryptMessage("remote", encrypted[99]).statusCode, 0);
+    EXPECT_EQ(receiver.decryptMessage("remote", encrypted[10]).statusCode, stream::InvalidDataChannelSeqException().getCode());
+    EXPECT_EQ(receiver.decryptMessage("remote", encrypted[50]).statusCode, 0);
+    // other remote streams have their own window
+    EXPECT_EQ(receiver.decryptMessage("remote2", encrypted[10]).statusCode, 0);
+}
+
+TEST(DataChannelMessageEncryptorV2Test, decrypt_invalid_data) {
+    std::vector<stream::Key> keys {
+        stream::Key{.keyId="local", .key=core::Buffer::from(privmx::crypto::Crypto::randomBytes(32)), .type=stream::KeyType::LOCAL}
+    };
+    stream::DataChannelMessageEncryptorV2 sender(keys);
+    stream::DataChannelMessageEncryptorV2 receiver(keys);
+    auto encrypted = sender.encryptMessage({core::Buffer::from("message"), 0});
+    // tampered header
+    auto tampered = encrypted.stdString();
+    tampered[2] ^= 0x01;
+    EXPECT_NE(receiver.decryptMessage("remote", core::Buffer::from(tampered)).statusCode, 0);
+    // tampered ciphertext
+    tampered = encrypted.stdString();
+    tampered[tampered.size() - 1] ^= 0x01;
+    EXPECT_NE(receiver.decryptMessage("remote", core::Buffer::from(tampered)).statusCode, 0);
+    // truncated message
+    EXPECT_EQ(
+        receiver.decryptMessage("remote", core::Buffer::from(encrypted.stdString().substr(0, 10))).statusCode,
+        stream::InvalidMessageHeaderLengthException().getCode()
+    );
+    // V1 message
+    tampered = encrypted.stdString();
+    tampered[0] = 1;
+    EXPECT_EQ(
+        receiver.decryptMessage("remote", core::Buffer::from(tampered)).statusCode,
+        stream::UnsupportedMessageFormatVersionException().getCode()
+    );
+    // failed messages do not move the window
+    EXPECT_EQ(receiver.decryptMessage("remote", encrypted).statusCode, 0);
+}
@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <filesystem>
 #include "../utils/BaseTest.hpp"
 #include "../utils/FalseUserVerifierInterface.hpp"
 #include <privmx/endpoint/core/Exception.hpp>
@@ -1099,6 +1100,47 @@ TEST_F(ThreadTest, listMessages_correct_input_data) {
 
 }
 
+TEST_F(ThreadTest, listMessages_selected_fields) {
+    // incorrect fields
+    EXPECT_THROW({
+        threadApi->listMessages(
+            reader->getString("Thread_1.threadId"),
+            {.skip=1, .limit=1, .sortOrder="desc"},
+            8
+        );
+    }, core::Exception);
+    core::PagingList<thread::Message> listMessages;
+    EXPECT_NO_THROW({
+        listMessages = threadApi->listMessages(
+            reader->getString("Thread_1.threadId"),
+            {.skip=1, .limit=1, .sortOrder="desc"},
+            core::DataField::PUBLIC_META
+        );
+    });
+    EXPECT_EQ(listMessages.totalAvailable, 2);
+    EXPECT_EQ(listMessages.readItems.size(), 1);
+    if(listMessages.readItems.size() >= 1) {
+        auto message = listMessages.readItems[0];
+        EXPECT_EQ(message.info.messageId, reader->getString("Message_1.info_messageId"));
+        EXPECT_EQ(message.publicMeta.stdString(), privmx::utils::Hex::toString(reader->getString("Message_1.publicMeta_inHex")));
+        EXPECT_EQ(message.privateMeta.size(), 0);
+        EXPECT_EQ(message.data.size(), 0);
+        EXPECT_EQ(message.statusCode, 0);
+    }
+    // fields left out of the list read later
+    thread::Message message;
+    EXPECT_NO_THROW({
+        message = threadApi->getMessage(
+            reader->getString("Message_1.info_messageId"),
+            core::DataField::PRIVATE_META | core::DataField::DATA
+        );
+    });
+    EXPECT_EQ(message.publicMeta.size(), 0);
+    EXPECT_EQ(message.privateMeta.stdString(), privmx::utils::Hex::toString(reader->getString("Message_1.privateMeta_inHex")));
+    EXPECT_EQ(message.data.stdString(), privmx::utils::Hex::toString(reader->getString("Message_1.data_inHex")));
+    EXPECT_EQ(message.statusCode, 0);
+}
+
 TEST_F(ThreadTest, sendMessage) {
     // incorrect_threadId
     EXPECT_THROW({
@@ -2163,4 +2205,188 @@ TEST_F(ThreadTest, falseUserVerifierInterface) {
     } else {
         FAIL();
     }
-}
\ No newline at end of file
+}
+TEST_F(ThreadTest, enableMessageCache_syncThread) {
+    std::string threadId = reader->getString("Thread_1.threadId");
+    std::string cacheDirectory = "/tmp/privmx_thread_test_cache_" + privmx::utils::Hex::from(privmx::crypto::Crypto::randomBytes(8));
+    auto subscribeForMessages = [&]() {
+        threadApi->subscribeFor({
+            threadApi->buildSubscriptionQuery(thread::EventType::MESSAGE_CREATE, thread::EventSelectorType::THREAD_ID, threadId),
+            threadApi->buildSubscriptionQuery(thread::EventType::MESSAGE_UPDATE, thread::EventSelectorType::THREAD_ID, threadId),
+            threadApi->buildSubscriptionQuery(thread::EventType::MESSAGE_DELETE, thread::EventSelectorType::THREAD_ID, threadId)
+        });
+    };
+    auto expectSameLists = [](const core::PagingList<thread::Message>& cachedList, const core::PagingList<thread::Message>& serverList) {
+        EXPECT_EQ(cachedList.totalAvailable, serverList.totalAvailable);
+        ASSERT_EQ(cachedList.readItems.size(), serverList.readItems.size());
+        for (size_t i = 0; i < cachedList.readItems.size(); i++) {
+            EXPECT_EQ(cachedList.readItems[i].info.messageId, serverList.readItems[i].info.messageId);
+            EXPECT_EQ(cachedList.readItems[i].data.stdString(), serverList.readItems[i].data.stdString());
+            EXPECT_EQ(cachedList.readItems[i].privateMeta.stdString(), serverList.readItems[i].privateMeta.stdString());
+            EXPECT_EQ(cachedList.readItems[i].statusCode, serverList.readItems[i].statusCode);
+        }
+    };
+    core::PagingList<thread::Message> serverList;
+    EXPECT_NO_THROW({
+        serverList = threadApi->listMessages(threadId, {.skip=0, .limit=100, .sortOrder="desc"});
+    });
+    // sync before enabling cache
+    EXPECT_THROW({
+        threadApi->syncThread(threadId);
+    }, core::Exception);
+    EXPECT_NO_THROW({
+        threadApi->enableMessageCache(cacheDirectory, 16*1024*1024);
+        subscribeForMessages();
+        threadApi->syncThread(threadId);
+    });
+    core::PagingList<thread::Message> cachedList;
+    EXPECT_NO_THROW({
+        cachedList = threadApi->listMessages(threadId, {.skip=0, .limit=100, .sortOrder="desc"});
+    });
+    expectSameLists(cachedList, serverList);
+    // new messages after sync
+    std::string editedMessageId;
+    std::string deletedMessageId;
+    EXPECT_NO_THROW({
+        editedMessageId = threadApi->sendMessage(threadId, core::Buffer::from("publicMeta"), core::Buffer::from("privateMeta"), core::Buffer::from("data"));
+        deletedMessageId = threadApi->sendMessage(threadId, core::Buffer::from("publicMeta"), core::Buffer::from("privateMeta"), core::Buffer::from("data"));
+        threadApi->syncThread(threadId);
+        cachedList = threadApi->listMessages(threadId, {.skip=0, .limit=2, .sortOrder="desc"});
+    });
+    EXPECT_EQ(cachedList.totalAvailable, serverList.totalAvailable + 2);
+    ASSERT_EQ(cachedList.readItems.size(), 2);
+    EXPECT_EQ(cachedList.readItems[0].info.messageId, deletedMessageId);
+    EXPECT_EQ(cachedList.readItems[1].info.messageId, editedMessageId);
+    EXPECT_EQ(cachedList.readItems[1].data.stdString(), "data");
+    // changes made while the cache does not receive events, a delete and a new message keep the count unchanged
+    disconnect();
+    connectAs(ConnectionType::User1);
+    std::string newMessageId;
+    EXPECT_NO_THROW({
+        threadApi->updateMessage(editedMessageId, core::Buffer::from("publicMeta"), core::Buffer::from("privateMeta"), core::Buffer::from("edited"));
+        threadApi->deleteMessage(deletedMessageId);
+        newMessageId = threadApi->sendMessage(threadId, core::Buffer::from("publicMeta"), core::Buffer::from("privateMeta"), core::Buffer::from("new"));
+        serverList = threadApi->listMessages(threadId, {.skip=0, .limit=100, .sortOrder="desc"});
+    });
+    EXPECT_NO_THROW({
+        threadApi->enableMessageCache(cacheDirectory, 16*1024*1024);
+        subscribeForMessages();
+        threadApi->syncThread(threadId);
+        cachedList = threadApi->listMessages(threadId, {.skip=0, .limit=100, .sortOrder="desc"});
+    });
+    expectSameLists(cachedList, serverList);
+    ASSERT_GE(cachedList.readItems.size(), 2);
+    EXPECT_EQ(cachedList.readItems[0].info.messageId, newMessageId);
+    EXPECT_EQ(cachedList.readItems[1].info.messageId, editedMessageId);
+    EXPECT_EQ(cachedList.readItems[1].data.stdString(), "edited");
+    std::error_code ec;
+    std::filesystem::remove_all(cacheDirectory, ec);
+}
+
+TEST_F(ThreadTest, addThreadMembers_and_removeThreadMembers) {
+    thread::Thread thread;
+    // Thread_1 has only user_1, user_2 is added as a user
+    EXPECT_NO_THROW({
+        threadApi->addThreadMembers(
+            reader->getString("Thread_1.threadId"),
+            std::vector<core::UserWithPubKey>{core::UserWithPubKey{
+                .userId=reader->getString("Login.user_2_id"),
+                .pubKey=reader->getString("Login.user_2_pubKey")
+            }},
+            std::vector<core::UserWithPubKey>{}
+        );
+    });
+    EXPECT_NO_THROW({
+        thread = threadApi->getThread(
+            reader->getString("Thread_1.threadId")
+        );
+    });
+    EXPECT_EQ(thread.version, 2);
+    EXPECT_EQ(thread.users, std::vector<std::string>({reader->getString("Login.user_1_id"), reader->getString("Login.user_2_id")}));
+    EXPECT_EQ(thread.managers, std::vector<std::string>({reader->getString("Login.user_1_id")}));
+    EXPECT_EQ(thread.publicMeta.stdString(), privmx::utils::Hex::toString(reader->getString("Thread_1.publicMeta_inHex")));
+    EXPECT_EQ(thread.privateMeta.stdString(), privmx::utils::Hex::toString(reader->getString("Thread_1.privateMeta_inHex")));
+    // Thread_3 has user_1 and user_2, user_2 is removed
+    EXPECT_NO_THROW({
+        threadApi->removeThreadMembers(
+            reader->getString("Thread_3.threadId"),
+            std::vector<std::string>{reader->getString("Login.user_2_id")}
+        );
+    });
+    EXPECT_NO_THROW({
+        thread = threadApi->getThread(
+            reader->getString("Thread_3.threadId")
+        );
+    });
+    EXPECT_EQ(thread.users, std::vector<std::string>({reader->getString("Login.user_1_id")}));
+    EXPECT_EQ(thread.managers, std::vector<std::string>({reader->getString("Login.user_1_id")}));
+    EXPECT_EQ(thread.statusCode, 0);
+    disconnect();
+    connectAs(User2);
+    privmx::endpoint::thread::Message message;
+    EXPECT_NO_THROW({
+        message = threadApi->getMessage(
+            reader->getString("Message_1.info_messageId")
+        );
+    });
+    EXPECT_EQ(message.statusCode, 0);
+    EXPECT_THROW({
+        threadApi->getThread(
+            reader->getString("Thread_3.threadId")
+        );
+    }, core::Exception);
+}
+
+TEST_F(ThreadTest, addThreadMembers_after_key_rotations_reads_older_messages) {
+    connection->setKeyChainEnabled(true);
+    std::vector<std::string> messageIds {reader->getString("Message_1.info_messageId")};
+    // every update generates a new key, a message is sent with each of them
+    for(int64_t version = 1; version <= 3; version++) {
+        EXPECT_NO_THROW({
+            threadApi->updateThread(
+                reader->getString("Thread_1.threadId"),
+                std::vector<core::UserWithPubKey>{core::UserWithPubKey{
+                    .userId=reader->getString("Login.user_1_id"),
+                    .pubKey=reader->getString("Login.user_1_pubKey")
+                }},
+                std::vector<core::UserWithPubKey>{core::UserWithPubKey{
+                    .userId=reader->getString("Login.user_1_id"),
+                    .pubKey=reader->getString("Login.user_1_pubKey")
+                }},
+                core::Buffer::from("public"),
+                core::Buffer::from("private"),
+                version,
+                false,
+                true
+            );
+            messageIds.push_back(threadApi->sendMessage(
+                reader->getString("Thread_1.threadId"),
+                core::Buffer::from("publicMeta"),
+                core::Buffer::from("privateMeta"),
+                core::Buffer::from("data_" + std::to_string(version))
+            ));
+        });
+    }
+    EXPECT_NO_THROW({
+        threadApi->addThreadMembers(
+            reader->getString("Thread_1.threadId"),
+            std::vector<core::UserWithPubKey>{core::UserWithPubKey{
+                .userId=reader->getString("Login.user_2_id"),
+                .pubKey=reader->getString("Login.user_2_pubKey")
+            }},
+            std::vector<core::UserWithPubKey>{}
+        );
+    });
+    disconnect();
+    connectAs(User2);
+    for(size_t i = 0; i < messageIds.size(); i++) {
+        privmx::endpoint::thread::Message message;
+        EXPECT_NO_THROW({
+            message = threadApi->getMessage(messageIds[i]);
+        });
+        EXPECT_EQ(message.statusCode, 0);
+        if(i > 0) {
+            EXPECT_EQ(message.data.stdString(), "data_" + std::to_string(i));
+        }
+    }
+}
@@ -1,11 +1,31 @@
 
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <utility>
 #include <gtest/gtest.h>
 #include "../utils/BaseTest.hpp"
+#include <privmx/crypto/ecc/ECIES.hpp>
 #include <privmx/crypto/ecc/PrivateKey.hpp>
 #include <privmx/crypto/ecc/PublicKey.hpp>
 #include <privmx/endpoint/core/Exception.hpp>
 #include <Poco/Util/IniFileConfiguration.h>
 #include <privmx/endpoint/core/Utils.hpp>
+#include <privmx/endpoint/core/SharedBuffer.hpp>
+#include <privmx/endpoint/core/UserVerifier.hpp>
+#include <privmx/endpoint/core/UsersKeysResolver.hpp>
+#include <privmx/endpoint/core/EndpointUtils.hpp>
+#include <privmx/endpoint/core/KeyProvider.hpp>
+#include <privmx/endpoint/core/ContainerKeyCache.hpp>
+#include <privmx/endpoint/core/ContainerMembersUpdater.hpp>
+#include <privmx/endpoint/core/AsyncRequestQueue.hpp>
+#include <privmx/endpoint/core/PrefetchingCursor.hpp>
+#include <privmx/utils/MetricsRegistry.hpp>
+#include <privmx/endpoint/core/CoreException.hpp>
+#include <privmx/endpoint/core/encryptors/module/ModuleDataEncryptorV5.hpp>
+#include <privmx/endpoint/core/encryptors/DataCompressor.hpp>
 #include <privmx/crypto/Crypto.hpp>
 
 using namespace privmx::endpoint;
@@ -67,4 +87,710 @@ TEST_F(UtilsTest, Utils) {
     EXPECT_EQ("test ", test);
     privmx::endpoint::core::Utils::rtrim(test);
     EXPECT_EQ("test", test);
-}
\ No newline at end of file
+}
+TEST_F(UtilsTest, Buffer) {
+    std::string text = "Test Buffer";
+    core::Buffer buffer = core::Buffer::from(text);
+    EXPECT_EQ(text, buffer.stdString());
+    EXPECT_EQ("Test Buffer", buffer.view());
+    // a string too long for the small string buffer keeps its data when moved in
+    std::string source(64, 'x');
+    const char* sourceData = source.data();
+    EXPECT_EQ(sourceData, core::Buffer::from(std::move(source)).data());
+    core::Buffer copy = buffer;
+    copy.stdString().append("!");
+    EXPECT_EQ(text, buffer.stdString());
+    EXPECT_EQ(text + "!", copy.stdString());
+    EXPECT_EQ(buffer, core::Buffer::from(text.data(), text.size()));
+    core::Buffer moved = std::move(buffer);
+    EXPECT_EQ(text, moved.stdString());
+    EXPECT_EQ(core::Buffer(), core::Buffer::from(""));
+}
+TEST_F(UtilsTest, SharedBuffer) {
+    std::string text = "Test Buffer";
+    core::SharedBuffer buffer = core::SharedBuffer::from(std::string(text));
+    core::SharedBuffer copy = buffer;
+    EXPECT_EQ(buffer.data(), copy.data());
+    const core::SharedBuffer slice = buffer.slice(5, 3);
+    EXPECT_EQ("Buf", slice.view());
+    EXPECT_EQ(buffer.data() + 5, slice.data());
+    EXPECT_EQ("Buffer", buffer.slice(5).view());
+    EXPECT_EQ(0u, buffer.slice(text.size()).size());
+    EXPECT_THROW(buffer.slice(text.size() + 1), std::out_of_range);
+    core::SharedBuffer fromVector = core::SharedBuffer::from(std::vector<uint8_t>(text.begin(), text.end()));
+    EXPECT_EQ(buffer, fromVector);
+    bool released = false;
+    {
+        core::SharedBuffer adopted = core::SharedBuffer::adopt(text.data(), text.size(), [&]{ released = true; });
+        const core::SharedBuffer adoptedSlice = adopted.slice(0, 4);
+        adopted = core::SharedBuffer();
+        EXPECT_FALSE(released);
+        EXPECT_EQ("Test", adoptedSlice.view());
+    }
+    EXPECT_TRUE(released);
+    // a shared string is copied to a Buffer, a string used only by one SharedBuffer is moved
+    EXPECT_EQ("Buf", slice.toBuffer().stdString());
+    core::Buffer copied = std::move(copy).toBuffer();
+    EXPECT_EQ(text, copied.stdString());
+    EXPECT_NE(buffer.data(), copied.data());
+    const char* data = buffer.data();
+    core::Buffer taken = std::move(buffer).toBuffer();
+    EXPECT_NE(data, taken.data());
+    copy = core::SharedBuffer();
+    core::SharedBuffer single = core::SharedBuffer::from(std::string(64, 'x'));
+    data = single.data();
+    taken = std::move(single).toBuffer();
+    EXPECT_EQ(data, taken.data());
+    EXPECT_EQ(std::string(64, 'x'), taken.stdString());
+    EXPECT_EQ(core::SharedBuffer(), core::SharedBuffer::from(std::string()));
+}
+
+namespace {
+// accepts key "key1" from date 10 until its revocation at date 1000
+class CountingUserVerifierInterface : public core::UserVerifierInterface {
+public:
+    std::vector<bool> verify(const std::vector<core::VerificationRequest>& request) override {
+        calls++;
+        lastSize = request.size();
+        std::vector<bool> result;
+        for(const auto& item : request) {
+            result.push_back(item.senderPubKey == "key1" && item.date >= 10 && item.date < 1000);
+        }
+        return result;
+    }
+    int calls = 0;
+    size_t lastSize = 0;
+};
+
+core::VerificationRequest verificationRequest(const std::string& senderId, const std::string& senderPubKey, int64_t date) {
+    return core::VerificationRequest{.contextId = "context", .senderId = senderId, .senderPubKey = senderPubKey, .date = date, .bridgeIdentity = std::nullopt};
+}
+} // namespace
+
+TEST_F(UtilsTest, UserVerifierCache) {
+    auto verifierInterface = std::make_shared<CountingUserVerifierInterface>();
+    core::UserVerifier verifier(verifierInterface);
+    std::vector<core::VerificationRequest> request;
+    for(int64_t date = 100; date < 200; ++date) {
+        request.push_back(verificationRequest("user1", "key1", date));
+    }
+    request.push_back(verificationRequest("user1", "key1", 1500));
+    request.push_back(verificationRequest("user1", "key1", 5));
+    request.push_back(verificationRequest("user2", "key2", 150));
+    request.push_back(verificationRequest("user2", "key2", 150));
+    request.push_back(verificationRequest("user1", "key1", 150));
+    auto result = verifier.verify(request);
+    ASSERT_EQ(request.size(), result.size());
+    for(size_t i = 0; i < 100; ++i) {
+        EXPECT_TRUE(result[i]);
+    }
+    EXPECT_FALSE(result[100]);
+    EXPECT_FALSE(result[101]);
+    EXPECT_FALSE(result[102]);
+    EXPECT_FALSE(result[103]);
+    EXPECT_TRUE(result[104]);
+    // key1 is not valid at both ends of its range, so its distinct dates are verified in a second call
+    EXPECT_EQ(2, verifierInterface->calls);
+    auto metrics = verifier.getMetrics();
+    EXPECT_EQ(103, metrics.verifierItems);
+    // identical items of one batch are not cache hits
+    EXPECT_EQ(0, metrics.cacheHits);
+    // the cache is enabled by default and keeps the range of dates key1 was verified valid for
+    EXPECT_TRUE(verifier.verify({verificationRequest("user1", "key1", 150)})[0]);
+    EXPECT_EQ(2, verifierInterface->calls);
+    result = verifier.verify({verificationRequest("user1", "key1", 120), verificationRequest("user1", "key1", 300), verificationRequest("user1", "key1", 2000)});
+    EXPECT_EQ(std::vector<bool>({true, true, false}), result);
+    EXPECT_EQ(3, verifierInterface->calls);
+    EXPECT_EQ(2, verifierInterface->lastSize);
+    // a key valid at both ends of the range of a batch is verified once for all of its dates
+    request.clear();
+    for(int64_t date = 400; date < 500; ++date) {
+        request.push_back(verificationRequest("user1", "key1", date));
+    }
+    result = verifier.verify(request);
+    EXPECT_EQ(std::vector<bool>(100, true), result);
+    EXPECT_EQ(4, verifierInterface->calls);
+    EXPECT_EQ(2, verifierInterface->lastSize);
+    EXPECT_TRUE(verifier.verify({verificationRequest("user1", "key1", 350)})[0]);
+    EXPECT_EQ(4, verifierInterface->calls);
+    verifier.invalidate("context", "user1");
+    EXPECT_TRUE(verifier.verify({verificationRequest("user1", "key1", 150)})[0]);
+    EXPECT_EQ(5, verifierInterface->calls);
+    metrics = verifier.getMetrics();
+    EXPECT_EQ(5, metrics.verifierCalls);
+    EXPECT_EQ(3, metrics.cacheHits);
+    verifier.setCacheOptions({.ttl = 0, .maxEntries = 10});
+    verifier.verify({verificationRequest("user1", "key1", 150)});
+    verifier.verify({verificationRequest("user1", "key1", 150)});
+    EXPECT_EQ(7, verifierInterface->calls);
+}
+
+TEST_F(UtilsTest, UsersKeysResolverDelta) {
+    core::DecryptedEncKeyV2 key {};
+    key.dataStructureVersion = 2;
+    std::vector<std::string> requestedIds;
+    auto getUsersPubKeys = [&](const std::vector<std::string>& userIds) {
+        requestedIds = userIds;
+        std::vector<core::UserWithPubKey> result;
+        for(const auto& userId : userIds) {
+            result.push_back({.userId = userId, .pubKey = "pubKey-" + userId});
+        }
+        return result;
+    };
+    // adding keeps the key and gives it only to the new member
+    auto resolver = core::UsersKeysResolver::createFromDelta(
+        {"user1", "user2", "user3"}, {"user1"}, {{.userId = "user4", .pubKey = "key4"}, {.userId = "user1", .pubKey = "key1"}}, {}, {}, key, getUsersPubKeys
+    );
+    EXPECT_EQ(std::vector<std::string>({"user1", "user2", "user3", "user4"}), resolver->getUserIds());
+    EXPECT_EQ(std::vector<std::string>({"user1"}), resolver->getManagerIds());
+    EXPECT_FALSE(resolver->doNeedNewKey());
+    ASSERT_EQ(1, resolver->getUsersToAddKey().size());
+    EXPECT_EQ("user4", resolver->getUsersToAddKey()[0].userId);
+    EXPECT_TRUE(requestedIds.empty());
+    // removing generates a new key for the remaining members
+    resolver = core::UsersKeysResolver::createFromDelta({"user1", "user2", "user3"}, {"user1", "user2"}, {}, {}, {"user2"}, key, getUsersPubKeys);
+    EXPECT_EQ(std::vector<std::string>({"user1", "user3"}), resolver->getUserIds());
+    EXPECT_EQ(std::vector<std::string>({"user1"}), resolver->getManagerIds());
+    EXPECT_TRUE(resolver->doNeedNewKey());
+    EXPECT_EQ(std::vector<std::string>({"user1", "user3"}), requestedIds);
+    EXPECT_EQ(2, resolver->getNewUsers().size());
+    // a member who has left the Context is dropped instead of failing the removal
+    auto getPubKeysWithoutLeft = [&](const std::vector<std::string>& userIds) {
+        auto result = getUsersPubKeys(userIds);
+        result.erase(std::remove_if(result.begin(), result.end(), [](const core::UserWithPubKey& user) { return user.userId == "user3"; }), result.end());
+        return result;
+    };
+    resolver = core::UsersKeysResolver::createFromDelta({"user1", "user2", "user3"}, {"user1", "user3"}, {}, {}, {"user2"}, key, getPubKeysWithoutLeft);
+    EXPECT_EQ(std::vector<std::string>({"user1"}), resolver->getUserIds());
+    EXPECT_EQ(std::vector<std::string>({"user1"}), resolver->getManagerIds());
+    ASSERT_EQ(1, resolver->getNewUsers().size());
+    EXPECT_EQ("user1", resolver->getNewUsers()[0].userId);
+    EXPECT_EQ(std::vector<std::string>({"a", "b", "c"}), core::EndpointUtils::uniqueList({"c", "a"}, {"b", "a"}));
+}
+
+class AcceptingUserVerifierInterface : public core::UserVerifierInterface {
+public:
+    std::vector<bool> verify(const std::vector<core::VerificationRequest>& request) override {
+        return std::vector<bool>(request.size(), true);
+    }
+};
+
+TEST_F(UtilsTest, KeyChain) {
+    auto privKey = privmx::crypto::PrivateKey::generateRandom();
+    auto pubKey = privKey.getPublicKey().toBase58DER();
+    auto userVerifier = std::make_shared<core::UserVerifier>(std::make_shared<AcceptingUserVerifierInterface>());
+    core::KeyProvider keyProvider(privKey, [&]() { return userVerifier; });
+    core::EncKeyLocation location {.contextId = "context", .resourceId = "resource"};
+    core::DataIntegrityObject dio {
+        .creatorUserId = "user", .creatorPubKey = pubKey, .contextId = "context", .resourceId = "resource",
+        .timestamp = 1, .randomId = "random", .containerId = std::nullopt, .containerResourceId = std::nullopt, .bridgeIdentity = std::nullopt
+    };
+    auto decrypted = [](const core::EncKey& key) {
+        core::DecryptedEncKeyV2 result {};
+        result.id = key.id;
+        result.key = key.key;
+        result.dataStructureVersion = 2;
+        result.statusCode = 0;
+        return result;
+    };
+    auto legacyKey = keyProvider.generateKey();
+    auto key1 = keyProvider.generateKey();
+    auto key2 = keyProvider.generateKey();
+    auto key3 = keyProvider.generateKey();
+    std::unordered_map<std::string, core::DecryptedEncKeyV2> allKeys {
+        {legacyKey.id, decrypted(legacyKey)}, {key1.id, decrypted(key1)}, {key2.id, decrypted(key2)}, {key3.id, decrypted(key3)}
+    };
+    // without the key chain enabled a container gets none, so its data stays readable by older clients
+    EXPECT_TRUE(keyProvider.prepareKeyChain({}, allKeys, key1, key2).empty());
+    keyProvider.setKeyChainEnabled(true);
+    // each rotation links the new key to the previous one
+    auto keyChain = keyProvider.prepareKeyChain({}, {}, key1, key2);
+    keyChain = keyProvider.prepareKeyChain(keyChain, {}, key2, key3);
+    EXPECT_EQ(2, keyChain.size());
+    auto outside = keyProvider.getKeysOutsideKeyChain(allKeys, keyChain, key3.id);
+    EXPECT_EQ(2, outside.size());
+    EXPECT_EQ(1, outside.count(key3.id));
+    EXPECT_EQ(1, outside.count(legacyKey.id));
+    // keys from before the chain are linked on the next update
+    keyChain = keyProvider.prepareKeyChain(keyChain, allKeys, key3, key3);
+    EXPECT_EQ(3, keyChain.size());
+    // an existing chain is kept up to date even when the key chain is disabled
+    keyProvider.setKeyChainEnabled(false);
+    EXPECT_EQ(3, keyProvider.prepareKeyChain(keyChain, allKeys, key3, key3).size());
+    EXPECT_EQ(1, keyProvider.getKeysOutsideKeyChain(allKeys, keyChain, key3.id).size());
+    // a member having only the newest key resolves the older ones through the chain
+    auto keyEntrySet = keyProvider.prepareKeysList({{.userId = "user", .pubKey = pubKey}}, key3, dio, location, "secret")[0];
+    core::server::KeyEntry keyEntry;
+    keyEntry.keyId = keyEntrySet.keyId;
+    keyEntry.data = keyEntrySet.data;
+    core::ModuleDataEncryptorV5 moduleDataEncryptor;
+    core::ModuleDataToEncryptV5 moduleData {
+        .publicMeta = core::Buffer::from("public"),
+        .privateMeta = core::Buffer::from("private"),
+        .internalMeta = core::ModuleInternalMetaV5{.secret = "secret", .resourceId = "resource", .randomId = "random", .keyChain = keyChain},
+        .dio = dio
+    };
+    core::ModuleKeys moduleKeys {
+        .keys = {keyEntry},
+        .currentKeyId = key3.id,
+        .moduleSchemaVersion = 5,
+        .moduleResourceId = "resource",
+        .contextId = "context",
+        .currentData = moduleDataEncryptor.encrypt(moduleData, privKey, key3.key).toJSON()
+    };
+    core::KeyDecryptionAndVerificationRequest request;
+    request.addMany(moduleKeys.keys, {key1.id, legacyKey.id, "unknown"}, location);
+    request.addKeyChain(moduleKeys, location);
+    auto result = keyProvider.getKeysAndVerify(request).at(location);
+    EXPECT_EQ(0, result.at(key1.id).statusCode);
+    EXPECT_EQ(key1.key, result.at(key1.id).key);
+    EXPECT_EQ(0, result.at(legacyKey.id).statusCode);
+    EXPECT_EQ(legacyKey.key, result.at(legacyKey.id).key);
+    EXPECT_NE(0, result.at("unknown").statusCode);
+}
+
+TEST_F(UtilsTest, ContainerMembersUpdater) {
+    std::atomic_int pubKeysRequests = 0;
+    core::ContainerMembersUpdater updater([&](const std::string& contextId, const std::vector<std::string>& userIds) {
+        pubKeysRequests++;
+        std::vector<core::UserWithPubKey> result;
+        for(const auto& userId : userIds) {
+            if(userId != "missing") {
+                result.push_back({.userId = userId, .pubKey = contextId + "-" + userId});
+            }
+        }
+        // other users read on the way
+        result.push_back({.userId = "user3", .pubKey = contextId + "-user3"});
+        result.push_back({.userId = "untrusted", .pubKey = "forged"});
+        return result;
+    }, [&](const std::string& contextId, const std::vector<core::UserWithPubKey>& users) {
+        std::vector<bool> result;
+        for(const auto& user : users) {
+            result.push_back(user.pubKey == contextId + "-" + user.userId);
+        }
+        return result;
+    });
+    std::mutex mutex;
+    std::map<std::string, int> calls;
+    int handlerId = updater.addHandler("thread", [&](const std::string& containerId, const core::ContainerMembersDelta& delta) {
+        EXPECT_EQ("user2", delta.userIdsToRemove.at(0));
+        EXPECT_EQ("context-user1", delta.getContextUsersPubKeys("context", {"user1"}).at(0).pubKey);
+        EXPECT_EQ("context-user3", delta.getContextUsersPubKeys("context", {"user3"}).at(0).pubKey);
+        int call;
+        {
+            std::unique_lock lock(mutex);
+            call = ++calls[containerId];
+        }
+        if(containerId == "conflict" && call == 1) {
+            throw core::ContainerVersionConflictException();
+        }
+        if(containerId == "alwaysConflict") {
+            throw core::ContainerVersionConflictException();
+        }
+        if(containerId == "failure") {
+            // a user who has left the Context is skipped, a key failing verification stops the update
+            EXPECT_TRUE(delta.getContextUsersPubKeys("context", {"missing"}).empty());
+            delta.getContextUsersPubKeys("context", {"user1", "untrusted"});
+        }
+        if(containerId == "stdFailure") {
+            throw std::runtime_error("failure");
+        }
+    });
+    std::vector<core::ContainerMembersTarget> targets {
+        {.module = "thread", .containerId = "ok"},
+        {.module = "thread", .containerId = "conflict"},
+        {.module = "thread", .containerId = "alwaysConflict"},
+        {.module = "thread", .containerId = "failure"},
+        {.module = "store", .containerId = "ok"}
+    };
+    for(int i = 0; i < 20; i++) {
+        targets.push_back({.module = "thread", .containerId = "container" + std::to_string(i)});
+    }
+    auto results = updater.update(targets, {}, {}, {"user2"});
+    ASSERT_EQ(targets.size(), results.size());
+    for(size_t i = 0; i < targets.size(); i++) {
+        EXPECT_EQ(targets[i].module, results[i].module);
+        EXPECT_EQ(targets[i].containerId, results[i].containerId);
+    }
+    EXPECT_TRUE(results[0].success);
+    EXPECT_EQ(1, results[0].attempts);
+    EXPECT_FALSE(results[0].errorCode.has_value());
+    EXPECT_TRUE(results[1].success);
+    EXPECT_EQ(2, results[1].attempts);
+    EXPECT_FALSE(results[2].success);
+    EXPECT_EQ(core::ContainerMembersUpdater::MAX_ATTEMPTS, results[2].attempts);
+    EXPECT_EQ(core::ContainerVersionConflictException().getCode(), results[2].errorCode.value());
+    EXPECT_FALSE(results[3].success);
+    EXPECT_EQ(1, results[3].attempts);
+    EXPECT_EQ(core::UserVerificationFailureException().getCode(), results[3].errorCode.value());
+    EXPECT_FALSE(results[4].success);
+    EXPECT_EQ(0, results[4].attempts);
+    EXPECT_EQ(core::UnknownContainerModuleException().getCode(), results[4].errorCode.value());
+    // one fetch for all the containers of the Context and one for the user missing in it
+    EXPECT_EQ(2, pubKeysRequests.load());
+    // an error other than an endpoint exception still has an error code
+    results = updater.update({{.module = "thread", .containerId = "stdFailure"}}, {}, {}, {"user2"});
+    EXPECT_FALSE(results[0].success);
+    EXPECT_EQ(core::EndpointCoreException().getCode(), results[0].errorCode.value());
+    updater.removeHandler(handlerId);
+    results = updater.update({{.module = "thread", .containerId = "ok"}}, {}, {}, {"user2"});
+    EXPECT_FALSE(results[0].success);
+}
+
+TEST_F(UtilsTest, ContainerKeyCacheRevalidation) {
+    auto stats = std::make_shared<core::ContainerKeyCacheStats>();
+    core::ContainerKeyCache cache(stats);
+    auto cachedKeys = [](int64_t version, const std::vector<std::string>& keyIds, const std::string& currentKeyId) {
+        core::ContainerKeyCache::CachedModuleKeys result {
+            .keys = {},
+            .currentKeyId = currentKeyId,
+            .moduleSchemaVersion = 5,
+            .moduleResourceId = "resource",
+            .contextId = "context",
+            .moduleVersion = version,
+            .currentData = Poco::Dynamic::Var(),
+            .keyIdsMissingOnServer = {}
+        };
+        for(const auto& keyId : keyIds) {
+            core::server::KeyEntry entry;
+            entry.keyId = keyId;
+            entry.data = "data";
+            result.keys.push_back(entry);
+        }
+        return result;
+    };
+    EXPECT_FALSE(cache.getKeys("module").has_value());
+    cache.set("module", cachedKeys(1, {"key1"}, "key1"));
+    cache.setKeysMissingOnServer("module", 1, {"oldKey"});
+    EXPECT_TRUE(cache.getKeys("module").has_value());
+    cache.writeThrough("module", cachedKeys(2, {"key1", "key2"}, "key2"));
+    EXPECT_EQ("key2", cache.getKeys("module", std::set<std::string>{"key2"}, 5)->currentKeyId);
+    // a write-through older than the cached version is ignored
+    cache.writeThrough("module", cachedKeys(1, {"key1"}, "key1"));
+    EXPECT_EQ("key2", cache.getKeys("module")->currentKeyId);
+
+    cache.setKeysMissingOnServer("module", 2, {"oldKey"});
+    cache.markForRevalidation();
+    // the current key needs to be checked with the server, keys requested by ID do not
+    EXPECT_FALSE(cache.getKeys("module").has_value());
+    EXPECT_TRUE(cache.getKeys("module", std::set<std::string>{"key1"}, 5).has_value());
+    cache.set("module", cachedKeys(2, {"key1", "key2"}, "key2"));
+    EXPECT_TRUE(cache.getKeys("module").has_value());
+    EXPECT_TRUE(cache.getKeys("module", std::set<std::string>{"oldKey"}, 5).has_value());
+
+    cache.markForRevalidation();
+    cache.set("module", cachedKeys(4, {"key1", "key2", "key3"}, "key3"));
+    EXPECT_EQ("key3", cache.getKeys("module")->currentKeyId);
+    EXPECT_FALSE(cache.getKeys("module", std::set<std::string>{"oldKey"}, 5).has_value());
+
+    EXPECT_EQ(1, stats->writeThroughUpdates.load());
+    EXPECT_EQ(1, stats->revalidatedEntries.load());
+    EXPECT_EQ(1, stats->invalidatedEntries.load());
+    EXPECT_EQ(7, stats->hits.load());
+    EXPECT_EQ(3, stats->misses.load());
+    cache.clear();
+    EXPECT_EQ(2, stats->invalidatedEntries.load());
+}
+
+TEST_F(UtilsTest, AsyncRequestQueue) {
+    core::AsyncRequestQueue queue({.maxInFlightRequests = 4, .completionExecutor = {}});
+    std::atomic_int running = 0;
+    std::atomic_int maxRunning = 0;
+    std::vector<core::Future<int>> results;
+    for(int i = 0; i < 16; i++) {
+        results.push_back(queue.submit<int>([&, i]() {
+            int current = ++running;
+            int max = maxRunning;
+            while(current > max && !maxRunning.compare_exchange_weak(max, current));
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            running--;
+            return i;
+        }));
+    }
+    for(int i = 0; i < 16; i++) {
+        EXPECT_EQ(i, results[i].get());
+    }
+    EXPECT_EQ(4, maxRunning.load());
+    auto failed = queue.submit<void>([]() {
+        throw core::InvalidParamsException();
+    });
+    EXPECT_THROW(failed.get(), core::InvalidParamsException);
+
+    // a cancelled call waiting in the queue is never started, a call past its deadline fails right away
+    queue.setOptions({.maxInFlightRequests = 1, .completionExecutor = {}});
+    std::atomic_bool started = false;
+    auto first = queue.submit<int>([]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        return 1;
+    });
+    auto cancelled = queue.submit<int>([&]() {
+        started = true;
+        return 2;
+    });
+    cancelled.cancel();
+    auto timedOut = queue.submit<int>([]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        return 3;
+    }, {.timeout = 150});
+    EXPECT_THROW(cancelled.get(), core::AsyncRequestCancelledException);
+    EXPECT_EQ(1, first.get());
+    EXPECT_THROW(timedOut.get(), core::AsyncRequestTimeoutException);
+    EXPECT_FALSE(started.load());
+
+    // a running call past its deadline gives its slot to the next call while it is still blocked,
+    // the next call past its deadline keeps its slot once maxInFlightRequests calls are abandoned
+    core::AsyncRequestQueue blockingQueue({.maxInFlightRequests = 1, .completionExecutor = {}});
+    std::promise<void> release;
+    std::function<int()> blocking = [released = release.get_future().share()]() {
+        released.wait();
+        return 5;
+    };
+    auto abandoned = blockingQueue.submit<int>(blocking, {.timeout = 50});
+    auto stuck = blockingQueue.submit<int>(blocking, {.timeout = 100});
+    auto next = blockingQueue.submit<int>([]() {
+        return 6;
+    });
+    EXPECT_THROW(abandoned.get(), core::AsyncRequestTimeoutException);
+    EXPECT_THROW(stuck.get(), core::AsyncRequestTimeoutException);
+    EXPECT_FALSE(next.waitFor(50));
+    release.set_value();
+    EXPECT_EQ(6, next.get());
+
+    // completion callbacks are passed to the completion executor
+    std::mutex mutex;
+    std::vector<std::function<void()>> posted;
+    queue.setOptions({.maxInFlightRequests = 1, .completionExecutor = [&](const std::function<void()>& callback) {
+        std::unique_lock lock(mutex);
+        posted.push_back(callback);
+    }});
+    int value = 0;
+    auto completed = queue.submit<int>([]() {
+        return 4;
+    });
+    completed.wait();
+    completed.then([&](const core::Future<int>& future) {
+        value = future.get();
+    });
+    EXPECT_EQ(0, value);
+    std::unique_lock lock(mutex);
+    ASSERT_EQ(1, posted.size());
+    posted[0]();
+    EXPECT_EQ(4, value);
+}
+
+TEST_F(UtilsTest, MetricsRegistry) {
+    for(int64_t value : {0, 1, 15, 16, 17, 100, 1000, 123456, 1000000000}) {
+        auto upperBound = privmx::utils::LatencyHistogram::getBucketUpperBound(privmx::utils::LatencyHistogram::getBucket(value));
+        EXPECT_GE(upperBound, value);
+        EXPECT_LE(upperBound - value, value / 8);
+    }
+    privmx::utils::LatencyHistogram histogram;
+    for(int64_t i = 1; i <= 1000; i++) {
+        histogram.record(i);
+    }
+    auto latency = histogram.getSnapshot();
+    EXPECT_EQ(1000, latency.count);
+    EXPECT_EQ(500500, latency.total);
+    EXPECT_EQ(1000, latency.max);
+    EXPECT_NEAR(500, latency.p50, 500 / 8);
+    EXPECT_NEAR(900, latency.p90, 900 / 8);
+    EXPECT_NEAR(990, latency.p99, 990 / 8);
+    histogram.reset();
+    EXPECT_EQ(0, histogram.getSnapshot().count);
+
+    privmx::utils::MetricsRegistry::reset();
+    auto start = privmx::utils::MetricsRegistry::Clock::now() - std::chrono::milliseconds(5);
+    privmx::utils::MetricsRegistry::recordRpcCall("metricsTestMethod", start, false);
+    privmx::utils::MetricsRegistry::recordRpcCall("metricsTestMethod", start, true);
+    privmx::crypto::Crypto::sha256(std::string(100, 'a'));
+    privmx::utils::MetricsRegistry::setEnabled(false);
+    privmx::crypto::Crypto::sha256(std::string(100, 'a'));
+    privmx::utils::MetricsRegistry::recordRpcCall("metricsTestMethod", start, false);
+    privmx::utils::MetricsRegistry::setEnabled(true);
+    privmx::utils::MetricsRegistry::recordEventQueued();
+    privmx::utils::MetricsRegistry::recordEventQueued();
+    privmx::utils::MetricsRegistry::recordEventDequeued();
+    auto snapshot = privmx::utils::MetricsRegistry::getSnapshot();
+    auto method = std::find_if(snapshot.rpcMethods.begin(), snapshot.rpcMethods.end(), [](const auto& method) {
+        return method.method == "metricsTestMethod";
+    });
+    ASSERT_NE(snapshot.rpcMethods.end(), method);
+    EXPECT_EQ(2, method->latency.count);
+    EXPECT_EQ(1, method->errors);
+    EXPECT_GE(method->latency.p50, 5000);
+    auto hash = std::find_if(snapshot.cryptoOperations.begin(), snapshot.cryptoOperations.end(), [](const auto& operation) {
+        return operation.operation == "hash";
+    });
+    ASSERT_NE(snapshot.cryptoOperations.end(), hash);
+    EXPECT_EQ(1, hash->operations);
+    EXPECT_EQ(100, hash->bytes);
+    EXPECT_EQ(snapshot.eventQueue.depth + 1, snapshot.eventQueue.maxDepth);
+    privmx::utils::MetricsRegistry::recordEventDequeued();
+    privmx::utils::MetricsRegistry::reset();
+    snapshot = privmx::utils::MetricsRegistry::getSnapshot();
+    EXPECT_EQ(snapshot.eventQueue.depth, snapshot.eventQueue.maxDepth);
+    method = std::find_if(snapshot.rpcMethods.begin(), snapshot.rpcMethods.end(), [](const auto& method) {
+        return method.method == "metricsTestMethod";
+    });
+    ASSERT_NE(snapshot.rpcMethods.end(), method);
+    EXPECT_EQ(0, method->latency.count);
+
+    // the AES and HMAC done inside ECIES are counted only as ECIES
+    auto privKey = privmx::crypto::PrivateKey::generateRandom();
+    privmx::crypto::ECIES ecies(privKey, privKey.getPublicKey());
+    privmx::utils::MetricsRegistry::reset();
+    ecies.decrypt(ecies.encrypt(std::string(100, 'a')));
+    snapshot = privmx::utils::MetricsRegistry::getSnapshot();
+    for(const auto& operation : snapshot.cryptoOperations) {
+        bool isEcies = operation.operation == "eciesEncrypt" || operation.operation == "eciesDecrypt";
+        EXPECT_EQ(isEcies ? 1 : 0, operation.operations) << operation.operation;
+    }
+}
+
+TEST_F(UtilsTest, DataCompressor) {
+    auto privKey = privmx::crypto::PrivateKey::generateRandom();
+    auto encryptionKey = privmx::crypto::Crypto::randomBytes(32);
+    std::string json;
+    for(int i = 0; json.size() < 8192; i++) {
+        json += "{\"id\":" + std::to_string(i) + ",\"name\":\"item\",\"tags\":[\"a\",\"b\"]},";
+    }
+    core::Buffer large = core::Buffer::from(json);
+    core::Buffer small = core::Buffer::from("small private data");
+    core::Buffer publicData = core::Buffer::from(json);
+
+    auto compressor = std::make_shared<core::DataCompressor>();
+    core::DataEncryptorV4 plainEncryptor;
+    core::DataEncryptorV4 encryptor;
+    encryptor.setCompressor(compressor);
+    auto plain = plainEncryptor.signAndEncryptAndEncode(large, privKey, encryptionKey);
+    EXPECT_EQ(plain.size(), encryptor.signAndEncryptAndEncode(large, privKey, encryptionKey).size());
+
+    compressor->setOptions({.enabled = true, .minSize = 1024, .maxDecompressedSize = core::DataCompressor::DEFAULT_MAX_DECOMPRESSED_SIZE});
+    auto compressed = encryptor.signAndEncryptAndEncode(large, privKey, encryptionKey);
+    EXPECT_LT(compressed.size() * 4, plain.size());
+    EXPECT_EQ(large, plainEncryptor.decodeAndDecryptAndVerify(compressed, privKey.getPublicKey(), encryptionKey));
+    EXPECT_EQ(large, plainEncryptor.decodeAndDecryptAndVerify(plain, privKey.getPublicKey(), encryptionKey));
+
+    auto encoded = encryptor.signAndEncodeMany({{publicData, std::nullopt}, {small, encryptionKey}, {large, encryptionKey}}, privKey);
+    EXPECT_EQ(plainEncryptor.signAndEncode(publicData, privKey).size(), encoded[0].size());
+    auto decoded = plainEncryptor.decodeAndVerifyMany({{encoded[0], std::nullopt}, {encoded[1], encryptionKey}, {encoded[2], encryptionKey}}, privKey.getPublicKey());
+    EXPECT_EQ(publicData, decoded[0]);
+    EXPECT_EQ(small, decoded[1]);
+    EXPECT_EQ(large, decoded[2]);
+
+    auto deflated = core::DataCompressor::deflate(large).stdString();
+    EXPECT_EQ(large, core::DataCompressor::decompress(core::Buffer::from(deflated)));
+    auto wrongSize = deflated;
+    wrongSize[4] = wrongSize[4] - 1;
+    EXPECT_THROW(core::DataCompressor::decompress(core::Buffer::from(wrongSize)), core::DataDecompressionException);
+    auto tooLarge = deflated;
+    tooLarge[1] = (char)0xFF;
+    EXPECT_THROW(core::DataCompressor::decompress(core::Buffer::from(tooLarge)), core::DataDecompressionException);
+    auto corrupted = deflated.substr(0, 5) + std::string(deflated.size() - 5, 'x');
+    EXPECT_THROW(core::DataCompressor::decompress(core::Buffer::from(corrupted)), core::DataDecompressionException);
+    std::string bomb(core::DataCompressor::DEFAULT_MAX_DECOMPRESSED_SIZE + 1, 0);
+    EXPECT_FALSE(compressor->compress(core::Buffer::from(bomb)).has_value());
+
+    compressor->setOptions({.enabled = true, .minSize = 1024, .maxDecompressedSize = 4096});
+    EXPECT_FALSE(compressor->compress(large).has_value());
+    EXPECT_THROW(encryptor.decodeAndDecryptAndVerify(compressed, privKey.getPublicKey(), encryptionKey), core::DataDecompressionException);
+    EXPECT_EQ(large, core::DataCompressor::decompress(core::Buffer::from(deflated), large.size()));
+    EXPECT_THROW(core::DataCompressor::decompress(core::Buffer::from(deflated), large.size() - 1), core::DataDecompressionException);
+}
+
+TEST_F(UtilsTest, PrefetchingCursor) {
+    std::mutex mutex;
+    std::vector<core::PagingQuery> queries;
+    std::atomic_int decrypted = 0;
+    auto fetchPage = [&](const core::PagingQuery& query) {
+        {
+            std::unique_lock lock(mutex);
+            queries.push_back(query);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        int64_t first = query.lastId.has_value() ? std::stoll(query.lastId.value()) + 1 : query.skip;
+        int64_t size = std::max<int64_t>(std::min<int64_t>(query.limit, 25 - first), 0);
+        return core::CursorPage<int64_t>{
+            .totalAvailable = 25,
+            .size = (size_t)size,
+            .lastId = size > 0 ? std::make_optional(std::to_string(first + size - 1)) : std::nullopt,
+            .decrypt = [first, size, &decrypted]() {
+                decrypted++;
+                std::vector<int64_t> items;
+                for(int64_t i = first; i < first + size; i++) {
+                    items.push_back(i);
+                }
+                return items;
+            }
+        };
+    };
+    core::PagingQuery query {.skip = 0, .limit = 10, .sortOrder = "asc", .lastId = std::nullopt, .sortBy = std::nullopt, .queryAsJson = std::nullopt};
+    core::Cursor<int64_t> cursor(std::make_shared<core::PrefetchingCursor<int64_t>>(fetchPage, query, 2));
+    EXPECT_EQ(25, cursor.getTotalAvailable());
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    {
+        // the cursor stops after downloading pagesAhead pages which have not been read
+        std::unique_lock lock(mutex);
+        EXPECT_EQ(2, queries.size());
+    }
+    EXPECT_EQ(0, decrypted);
+    std::vector<int64_t> items;
+    for(auto page = cursor.next(); !page.empty(); page = cursor.next()) {
+        items.insert(items.end(), page.begin(), page.end());
+    }
+    ASSERT_EQ(25, items.size());
+    for(int64_t i = 0; i < 25; i++) {
+        EXPECT_EQ(i, items[i]);
+    }
+    EXPECT_EQ(3, decrypted);
+    ASSERT_EQ(3, queries.size());
+    EXPECT_FALSE(queries[0].lastId.has_value());
+    EXPECT_EQ("9", queries[1].lastId.value_or(""));
+    EXPECT_EQ("19", queries[2].lastId.value_or(""));
+    EXPECT_TRUE(cursor.next().empty());
+
+    // a server returning fewer items than the limit does not end the cursor early
+    auto cappedQuery = query;
+    cappedQuery.skip = 5;
+    cappedQuery.limit = 100;
+    core::Cursor<int64_t> capped(std::make_shared<core::PrefetchingCursor<int64_t>>([&](core::PagingQuery pageQuery) {
+        pageQuery.limit = std::min<int64_t>(pageQuery.limit, 10);
+        return fetchPage(pageQuery);
+    }, cappedQuery, 1));
+    items.clear();
+    for(auto page = capped.next(); !page.empty(); page = capped.next()) {
+        items.insert(items.end(), page.begin(), page.end());
+    }
+    ASSERT_EQ(20, items.size());
+    EXPECT_EQ(5, items.front());
+    EXPECT_EQ(24, items.back());
+    {
+        std::unique_lock lock(mutex);
+        EXPECT_EQ(5, queries.size());
+    }
+
+    query.sortBy = "updates";
+    auto next = core::PrefetchingCursor<int64_t>::getNextQuery(query, 10, "9");
+    EXPECT_EQ(10, next.skip);
+    EXPECT_FALSE(next.lastId.has_value());
+
+    std::atomic_int fetched = 0;
+    core::Cursor<int64_t> failing(std::make_shared<core::PrefetchingCursor<int64_t>>([&](const core::PagingQuery& query) {
+        if(fetched++ > 0) {
+            throw core::AsyncRequestTimeoutException();
+        }
+        return fetchPage(query);
+    }, query, 1));
+    EXPECT_EQ(10, failing.next().size());
+    EXPECT_THROW(failing.next(), core::AsyncRequestTimeoutException);
+    EXPECT_THROW(failing.next(), core::AsyncRequestTimeoutException);
+
+    core::Cursor<int64_t> closed(std::make_shared<core::PrefetchingCursor<int64_t>>([](const core::PagingQuery& query) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        return core::CursorPage<int64_t>{.totalAvailable = 1, .size = 1, .lastId = "0", .decrypt = []() {
+            return std::vector<int64_t>{0};
+        }};
+    }, query, 1));
+    closed.close();
+    EXPECT_TRUE(closed.next().empty());
+}
@@ -7,7 +7,7 @@ if [[ ! -f "$INI_FILE_PATH" ]]; then
 fi
 if [ $# -ne 1 ]; then
     echo "Poszę podać nazwę testu"
-    echo "lista testów: CoreTest, CoreModuleEventsTest, ThreadTest, ThreadModuleEventsTest, StoreTest, StoreModuleEventsTest, InboxTest, InboxModuleEventsTest, KvdbModule, KvdbModuleEventsTest, EventsTest, CryptoTest, UtilsTest"
+    echo "lista testów: CoreTest, CoreModuleEventsTest, ThreadTest, ThreadModuleEventsTest, StoreTest, StoreModuleEventsTest, InboxTest, InboxModuleEventsTest, KvdbModule, KvdbModuleEventsTest, EventsTest, CryptoTest, UtilsTest, CInterfaceTest"
     exit -1
 else
     first_arg="$1"
@@ -41,6 +41,8 @@ elif [ "${first_arg}" == "CryptoTest" ]; then
     ./test_e2e_CryptoTest $@
 elif [ "${first_arg}" == "UtilsTest" ]; then
     ./test_e2e_UtilsTest $@
+elif [ "${first_arg}" == "CInterfaceTest" ]; then
+    ./test_e2e_CInterfaceTest $@
 elif [ "${first_arg}" == "All" ]; then
     set -e
     ./test_e2e_CoreTest $@
@@ -56,6 +58,7 @@ elif [ "${first_arg}" == "All" ]; then
     ./test_e2e_EventsTest $@
     ./test_e2e_CryptoTest $@
     ./test_e2e_UtilsTest $@
+    ./test_e2e_CInterfaceTest $@
 else
     echo "unknown test"
 fi
@@ -21,6 +21,7 @@ limitations under the License.
 #include "privmx/utils/ThreadSafeQueue.hpp"
 #include "privmx/utils/ExecutorConfig.hpp"
 #include "privmx/utils/Logger.hpp"
+#include "privmx/utils/MetricsRegistry.hpp"
 
 #ifndef PRIVMX_EXECUTOR_THREAD_POOL_SIZE
 #define PRIVMX_EXECUTOR_THREAD_POOL_SIZE 4
@@ -48,6 +49,7 @@ private:
     struct TaskData {
         TaskType type;
         std::function<void()> callback;
+        MetricsRegistry::Clock::time_point queuedAt;
     };
 
     struct ExecutorThread {
@@ -12,9 +12,12 @@ limitations under the License.
 #ifndef _PRIVMXLIB_UTILS_JSON_HELPER_HPP_
 #define _PRIVMXLIB_UTILS_JSON_HELPER_HPP_
 
+#include <algorithm>
 #include <type_traits>
 #include <iostream>
+#include <numeric>
 #include <string>
+#include <string_view>
 #include <map>
 #include <unordered_map>
 #include <optional>
@@ -22,6 +25,8 @@ limitations under the License.
 #include <Pson/BinaryString.hpp>
 #include <Poco/JSON/Array.h>
 #include <Poco/JSON/Object.h>
+#include <privmx/utils/JsonReader.hpp>
+#include <privmx/utils/JsonWriter.hpp>
 #include <privmx/utils/PrivmxExtExceptions.hpp>
 #include <privmx/utils/Logger.hpp>
 #include <privmx/utils/Utils.hpp>
@@ -72,6 +77,14 @@ struct is_optional_null : std::false_type {};
 template<typename T>
 struct is_optional_null<optional_null<T>> : std::true_type {};
 
+template<typename T, typename = void>
+struct has_direct_json : std::false_type {};
+template<typename T>
+struct has_direct_json<T, std::void_t<decltype(T::readJSON(std::declval<JsonReader&>()))>> : std::true_type {};
+
+// thrown by JsonHelper::write for values which have no direct JSON text form
+class DirectJsonUnsupportedException : public std::exception {};
+
 class JsonHelper {
 public:
     template<typename T>
@@ -161,6 +174,106 @@ public:
             return Poco::Dynamic::Var(element.toJSON());
         }
     }
+
+    // Direct path: JSON text is read into and written from JSON_STRUCT types field by field,
+    // without the intermediate Poco::JSON tree. Only fields typed as Poco values are parsed into a tree.
+    template<typename T>
+    static T read(JsonReader& reader) {
+        if constexpr (is_vector<T>::value) {
+            T result;
+            reader.beginArray();
+            while(reader.nextElement()) result.push_back(JsonHelper::read<typename T::value_type>(reader));
+            return result;
+        } else if constexpr (is_optional<T>::value || is_optional_null<T>::value) {
+            if(reader.readNull()) return std::nullopt;
+            return JsonHelper::read<typename T::value_type>(reader);
+        } else if constexpr (is_unordered_map<T>::value || is_map<T>::value) {
+            T result;
+            std::string key;
+            reader.beginObject();
+            while(reader.nextKey(key)) result[key] = JsonHelper::read<typename T::mapped_type>(reader);
+            return result;
+        } else if constexpr (has_direct_json<T>::value) {
+            return T::readJSON(reader);
+        } else {
+            return JsonHelper::deserialize<T>(Utils::parseJson(std::string(reader.readRaw())));
+        }
+    }
+    template<typename T>
+    static void write(JsonWriter& writer, const T& element) {
+        if constexpr (is_vector<T>::value) {
+            writer.beginArray();
+            for(const auto& e : element) JsonHelper::write(writer, e);
+            writer.endArray();
+        } else if constexpr (is_optional<T>::value || is_optional_null<T>::value) {
+            if(!element.has_value()) return writer.writeNull();
+            JsonHelper::write(writer, element.value());
+        } else if constexpr (is_map<T>::value) {
+            writer.beginObject();
+            for(const auto& kv : element) {
+                writer.key(kv.first);
+                JsonHelper::write(writer, kv.second);
+            }
+            writer.endObject();
+        } else if constexpr (is_unordered_map<T>::value) {
+            // keys in the same sorted order as Poco::JSON::Object writes them
+            std::vector<const typename T::value_type*> entries;
+            entries.reserve(element.size());
+            for(const auto& kv : element) entries.push_back(&kv);
+            std::sort(entries.begin(), entries.end(), [](auto a, auto b) { return a->first < b->first; });
+            writer.beginObject();
+            for(const auto* kv : entries) {
+                writer.key(kv->first);
+                JsonHelper::write(writer, kv->second);
+            }
+            writer.endObject();
+        } else if constexpr (has_direct_json<T>::value) {
+            element.writeJSON(writer);
+        } else {
+            writer.writeVar(JsonHelper::serialize(element));
+        }
+    }
+    // whether an optional field is written, the same as in the tree path
+    template<typename T>
+    static bool hasValue(const T& element) {
+        if constexpr (!is_optional<T>::value) {
+            return true;
+        } else if constexpr (std::is_same<typename T::value_type, Poco::Dynamic::Var>::value) {
+            return element.has_value() && !element.value().isEmpty();
+        } else {
+            return element.has_value();
+        }
+    }
+    // Any failure of the direct reader (syntax it does not handle, wrong types, missing fields) falls back
+    // to the tree path, so results and errors are the same as from fromJSON(Utils::parseJsonObject(json)).
+    template<typename T>
+    static T deserializeDirect(const std::string& json) {
+        try {
+            JsonReader reader(json);
+            T result = T::readJSON(reader);
+            reader.finish();
+            return result;
+        } catch (...) {
+            return T::fromJSON(Utils::parseJson(json));
+        }
+    }
+    // order in which serialize() writes the fields, Poco::JSON::Object sorts the keys
+    static std::vector<size_t> sortedFieldOrder(const std::vector<std::string_view>& names) {
+        std::vector<size_t> order(names.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return names[a] < names[b]; });
+        return order;
+    }
+    template<typename T>
+    static std::string serializeDirect(const T& element) {
+        try {
+            JsonWriter writer;
+            element.writeJSON(writer);
+            return writer.release();
+        } catch (const DirectJsonUnsupportedException&) {
+            return Utils::stringify(element.toJSON());
+        }
+    }
 };
 template<>
 inline Poco::Dynamic::Var JsonHelper::deserialize<Poco::Dynamic::Var>(const Poco::Dynamic::Var& element) {
@@ -207,6 +320,38 @@ inline bool JsonHelper::deserialize<bool>(const Poco::Dynamic::Var& element) {
     return element.convert<bool>();
 };
 template<>
+inline std::string JsonHelper::read<std::string>(JsonReader& reader) {
+    return reader.readString();
+};
+template<>
+inline Pson::BinaryString JsonHelper::read<Pson::BinaryString>(JsonReader& reader) {
+    return Pson::BinaryString(reader.readString());
+};
+template<>
+inline int64_t JsonHelper::read<int64_t>(JsonReader& reader) {
+    return reader.readInt64();
+};
+template<>
+inline bool JsonHelper::read<bool>(JsonReader& reader) {
+    return reader.readBool();
+};
+template<>
+inline void JsonHelper::write<std::string>(JsonWriter& writer, const std::string& element) {
+    writer.writeString(element);
+};
+template<>
+inline void JsonHelper::write<Pson::BinaryString>(JsonWriter&, const Pson::BinaryString&) {
+    throw DirectJsonUnsupportedException();
+};
+template<>
+inline void JsonHelper::write<int64_t>(JsonWriter& writer, const int64_t& element) {
+    writer.writeInt64(element);
+};
+template<>
+inline void JsonHelper::write<bool>(JsonWriter& writer, const bool& element) {
+    writer.writeBool(element);
+};
+template<>
 inline Poco::Dynamic::Var JsonHelper::serialize<Poco::Dynamic::Var>(const Poco::Dynamic::Var& element) {
     return Poco::Dynamic::Var(element);
 };
@@ -234,7 +379,6 @@ inline Poco::Dynamic::Var JsonHelper::serialize<bool>(const bool& element) {
 // Internal helpers — not for direct use
 // F(NAME, TYPE) — name first, type last (variadic to support template types with commas, e.g. std::map<K,V>)
 #define _JSON_DECL(NAME, ...) __VA_ARGS__ NAME;
-#define _JSON_FROM(NAME, ...) NAME = privmx::utils::JsonHelper::deserialize<__VA_ARGS__>(JSON->has(#NAME) ? JSON->get(#NAME) : Poco::Dynamic::Var());
 #define _JSON_TO(NAME, ...)   {\
     if constexpr (privmx::utils::is_optional<__VA_ARGS__>::value) {\
         auto __value = privmx::utils::JsonHelper::serialize<__VA_ARGS__>(NAME);\
@@ -244,6 +388,29 @@ inline Poco::Dynamic::Var JsonHelper::serialize<bool>(const bool& element) {
     }\
 }
 
+#define _JSON_COUNT(NAME, ...) + 1
+#define _JSON_NAME(NAME, ...) #NAME,
+#define _JSON_FROM_FIELD(NAME, ...) \
+    if(_jsonKey == #NAME) { NAME = privmx::utils::JsonHelper::deserialize<__VA_ARGS__>(_jsonValue); _jsonSeen[_jsonIndex] = true; return true; } \
+    ++_jsonIndex;
+#define _JSON_READ(NAME, ...) \
+    if(_jsonKey == #NAME) { NAME = privmx::utils::JsonHelper::read<__VA_ARGS__>(_jsonReader); _jsonSeen[_jsonIndex] = true; return true; } \
+    ++_jsonIndex;
+#define _JSON_READ_MISSING(NAME, ...) \
+    if(!_jsonSeen[_jsonIndex]) { NAME = privmx::utils::JsonHelper::deserialize<__VA_ARGS__>(Poco::Dynamic::Var()); } \
+    ++_jsonIndex;
+#define _JSON_WRITE(NAME, ...) \
+    if(_jsonIndex == _jsonI) {\
+        if constexpr (privmx::utils::is_optional<__VA_ARGS__>::value) {\
+            if(privmx::utils::JsonHelper::hasValue(NAME)) {_jsonWriter.key(#NAME); privmx::utils::JsonHelper::write<__VA_ARGS__>(_jsonWriter, NAME);}\
+        } else {\
+            _jsonWriter.key(#NAME);\
+            privmx::utils::JsonHelper::write<__VA_ARGS__>(_jsonWriter, NAME);\
+        }\
+        return;\
+    }\
+    ++_jsonI;
+
 // Generate a JsonCompatable struct from an X-macro field list.
 // Usage:
 //   #define MY_FIELDS(F) F(foo, std::string) F(bar, int64_t)
@@ -262,20 +429,65 @@ struct STRUCT_NAME { \
         obj._parseFields(JSON); \
         return obj; \
     } \
-    static STRUCT_NAME deserialize(std::string JSON_string) { \
-        return STRUCT_NAME::fromJSON(privmx::utils::Utils::parseJsonObject(JSON_string)); \
+    static STRUCT_NAME deserialize(const std::string& JSON_string) { \
+        return privmx::utils::JsonHelper::deserializeDirect<STRUCT_NAME>(JSON_string); \
+    } \
+    static STRUCT_NAME readJSON(privmx::utils::JsonReader& _jsonReader) { \
+        STRUCT_NAME obj; \
+        bool _jsonSeen[_fieldsCount + 1] = {}; \
+        std::string _jsonKey; \
+        _jsonReader.beginObject(); \
+        while(_jsonReader.nextKey(_jsonKey)) { if(!obj._readField(_jsonKey, _jsonReader, _jsonSeen)) _jsonReader.skip(); } \
+        obj._readMissingFields(_jsonSeen); \
+        return obj; \
     } \
     Poco::JSON::Object::Ptr toJSON() const { \
         Poco::JSON::Object::Ptr result(new Poco::JSON::Object()); \
         serializeFields(result); \
         return result; \
     } \
+    void writeJSON(privmx::utils::JsonWriter& _jsonWriter) const { \
+        _jsonWriter.beginObject(); \
+        for(size_t _jsonIndex : _writeOrder()) _writeField(_jsonIndex, _jsonWriter); \
+        _jsonWriter.endObject(); \
+    } \
     std::string serialize() const { \
-        return privmx::utils::Utils::stringify(toJSON()); \
+        return privmx::utils::JsonHelper::serializeDirect(*this); \
     } \
 protected: \
-    void _parseFields(Poco::JSON::Object::Ptr JSON) { FIELDS(_JSON_FROM) } \
+    static constexpr size_t _fieldsCount = 0 FIELDS(_JSON_COUNT); \
+    static const std::vector<std::string_view>& _fieldNames() { \
+        static const std::vector<std::string_view> names = {FIELDS(_JSON_NAME)}; \
+        return names; \
+    } \
+    static const std::vector<size_t>& _writeOrder() { \
+        static const std::vector<size_t> order = privmx::utils::JsonHelper::sortedFieldOrder(_fieldNames()); \
+        return order; \
+    } \
+    void _parseFields(Poco::JSON::Object::Ptr JSON) { \
+        bool _jsonSeen[_fieldsCount + 1] = {}; \
+        for(const auto& kv : *JSON) _parseField(kv.first, kv.second, _jsonSeen); \
+        _readMissingFields(_jsonSeen); \
+    } \
+    bool _parseField([[maybe_unused]] const std::string& _jsonKey, [[maybe_unused]] const Poco::Dynamic::Var& _jsonValue, [[maybe_unused]] bool* _jsonSeen) { \
+        [[maybe_unused]] size_t _jsonIndex = 0; \
+        FIELDS(_JSON_FROM_FIELD) \
+        return false; \
+    } \
     void serializeFields([[maybe_unused]] Poco::JSON::Object::Ptr result) const { FIELDS(_JSON_TO) } \
+    bool _readField([[maybe_unused]] const std::string& _jsonKey, [[maybe_unused]] privmx::utils::JsonReader& _jsonReader, [[maybe_unused]] bool* _jsonSeen) { \
+        [[maybe_unused]] size_t _jsonIndex = 0; \
+        FIELDS(_JSON_READ) \
+        return false; \
+    } \
+    void _readMissingFields([[maybe_unused]] const bool* _jsonSeen) { \
+        [[maybe_unused]] size_t _jsonIndex = 0; \
+        FIELDS(_JSON_READ_MISSING) \
+    } \
+    void _writeField([[maybe_unused]] size_t _jsonIndex, [[maybe_unused]] privmx::utils::JsonWriter& _jsonWriter) const { \
+        [[maybe_unused]] size_t _jsonI = 0; \
+        FIELDS(_JSON_WRITE) \
+    } \
 };
 
 // Extend a JSON_STRUCT with additional fields. Chains to base deserialization/serialization.
@@ -296,24 +508,73 @@ struct STRUCT_NAME : public BASE_NAME { \
         obj._parseFields(JSON); \
         return obj; \
     } \
-    static STRUCT_NAME deserialize(std::string JSON_string) { \
-        return STRUCT_NAME::fromJSON(privmx::utils::Utils::parseJsonObject(JSON_string)); \
+    static STRUCT_NAME deserialize(const std::string& JSON_string) { \
+        return privmx::utils::JsonHelper::deserializeDirect<STRUCT_NAME>(JSON_string); \
+    } \
+    static STRUCT_NAME readJSON(privmx::utils::JsonReader& _jsonReader) { \
+        STRUCT_NAME obj; \
+        bool _jsonSeen[_fieldsCount + 1] = {}; \
+        std::string _jsonKey; \
+        _jsonReader.beginObject(); \
+        while(_jsonReader.nextKey(_jsonKey)) { if(!obj._readField(_jsonKey, _jsonReader, _jsonSeen)) _jsonReader.skip(); } \
+        obj._readMissingFields(_jsonSeen); \
+        return obj; \
     } \
     Poco::JSON::Object::Ptr toJSON() const { \
         Poco::JSON::Object::Ptr result(new Poco::JSON::Object()); \
-        BASE_NAME::serializeFields(result); \
         serializeFields(result); \
         return result; \
     } \
+    void writeJSON(privmx::utils::JsonWriter& _jsonWriter) const { \
+        _jsonWriter.beginObject(); \
+        for(size_t _jsonIndex : _writeOrder()) _writeField(_jsonIndex, _jsonWriter); \
+        _jsonWriter.endObject(); \
+    } \
     std::string serialize() const { \
-        return privmx::utils::Utils::stringify(toJSON()); \
+        return privmx::utils::JsonHelper::serializeDirect(*this); \
     } \
 protected: \
+    static constexpr size_t _fieldsCount = BASE_NAME::_fieldsCount FIELDS(_JSON_COUNT); \
+    static const std::vector<std::string_view>& _fieldNames() { \
+        static const std::vector<std::string_view> names = [] { \
+            std::vector<std::string_view> result = BASE_NAME::_fieldNames(); \
+            result.insert(result.end(), std::initializer_list<std::string_view>{FIELDS(_JSON_NAME)}); \
+            return result; \
+        }(); \
+        return names; \
+    } \
+    static const std::vector<size_t>& _writeOrder() { \
+        static const std::vector<size_t> order = privmx::utils::JsonHelper::sortedFieldOrder(_fieldNames()); \
+        return order; \
+    } \
     void _parseFields(Poco::JSON::Object::Ptr JSON) { \
-        BASE_NAME::_parseFields(JSON); \
-        FIELDS(_JSON_FROM) \
+        bool _jsonSeen[_fieldsCount + 1] = {}; \
+        for(const auto& kv : *JSON) _parseField(kv.first, kv.second, _jsonSeen); \
+        _readMissingFields(_jsonSeen); \
+    } \
+    bool _parseField([[maybe_unused]] const std::string& _jsonKey, [[maybe_unused]] const Poco::Dynamic::Var& _jsonValue, [[maybe_unused]] bool* _jsonSeen) { \
+        if(BASE_NAME::_parseField(_jsonKey, _jsonValue, _jsonSeen)) return true; \
+        [[maybe_unused]] size_t _jsonIndex = BASE_NAME::_fieldsCount; \
+        FIELDS(_JSON_FROM_FIELD) \
+        return false; \
+    } \
+    void serializeFields(Poco::JSON::Object::Ptr result) const { BASE_NAME::serializeFields(result); FIELDS(_JSON_TO) } \
+    bool _readField([[maybe_unused]] const std::string& _jsonKey, [[maybe_unused]] privmx::utils::JsonReader& _jsonReader, [[maybe_unused]] bool* _jsonSeen) { \
+        if(BASE_NAME::_readField(_jsonKey, _jsonReader, _jsonSeen)) return true; \
+        [[maybe_unused]] size_t _jsonIndex = BASE_NAME::_fieldsCount; \
+        FIELDS(_JSON_READ) \
+        return false; \
+    } \
+    void _readMissingFields([[maybe_unused]] const bool* _jsonSeen) { \
+        BASE_NAME::_readMissingFields(_jsonSeen); \
+        [[maybe_unused]] size_t _jsonIndex = BASE_NAME::_fieldsCount; \
+        FIELDS(_JSON_READ_MISSING) \
+    } \
+    void _writeField([[maybe_unused]] size_t _jsonIndex, [[maybe_unused]] privmx::utils::JsonWriter& _jsonWriter) const { \
+        if(_jsonIndex < BASE_NAME::_fieldsCount) return BASE_NAME::_writeField(_jsonIndex, _jsonWriter); \
+        [[maybe_unused]] size_t _jsonI = BASE_NAME::_fieldsCount; \
+        FIELDS(_JSON_WRITE) \
     } \
-    void serializeFields([[maybe_unused]] Poco::JSON::Object::Ptr result) const { FIELDS(_JSON_TO) } \
 }
 
 } // utils
@@ -0,0 +1,67 @@
+/*
+PrivMX Endpoint.
+Copyright © 2024 Simplito sp. z o.o.
+
+This file is part of the PrivMX Platform (https://privmx.dev).
+This software is Licensed under the PrivMX Free License.
+
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef _PRIVMXLIB_UTILS_JSON_READER_HPP_
+#define _PRIVMXLIB_UTILS_JSON_READER_HPP_
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace privmx {
+namespace utils {
+
+// Pull parser reading JSON text value by value, without building a Poco object tree.
+// Throws JSONParseException on malformed input and on values it does not handle
+// (e.g. non-integer numbers), callers fall back to Utils::parseJson in such cases.
+class JsonReader
+{
+public:
+    explicit JsonReader(std::string_view json);
+
+    void beginObject();
+    // reads the next key of the current object, returns false (and leaves the object) at its end
+    bool nextKey(std::string& key);
+    void beginArray();
+    // moves to the next element of the current array, returns false (and leaves the array) at its end
+    bool nextElement();
+    // consumes null and returns true if it is the next value
+    bool readNull();
+    std::string readString();
+    int64_t readInt64();
+    bool readBool();
+    // skips the next value and returns its JSON text
+    std::string_view readRaw();
+    void skip();
+    // checks that only whitespace is left
+    void finish();
+
+private:
+    void skipWhitespace();
+    char peek();
+    void expect(char c);
+    void expectLiteral(std::string_view literal);
+    void skipString();
+    void skipNumber();
+    void appendCodePoint(std::string& out, uint32_t codePoint);
+    uint32_t readHex4();
+    [[noreturn]] void fail();
+
+    std::string_view _json;
+    size_t _pos = 0;
+    std::vector<bool> _first;
+};
+
+} // utils
+} // privmx
+
+#endif // _PRIVMXLIB_UTILS_JSON_READER_HPP_
@@ -0,0 +1,53 @@
+/*
+PrivMX Endpoint.
+Copyright © 2024 Simplito sp. z o.o.
+
+This file is part of the PrivMX Platform (https://privmx.dev).
+This software is Licensed under the PrivMX Free License.
+
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef _PRIVMXLIB_UTILS_JSON_WRITER_HPP_
+#define _PRIVMXLIB_UTILS_JSON_WRITER_HPP_
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <Poco/Dynamic/Var.h>
+
+namespace privmx {
+namespace utils {
+
+// Writes compact JSON text directly to a string, without building a Poco object tree.
+class JsonWriter
+{
+public:
+    void beginObject();
+    void endObject();
+    void beginArray();
+    void endArray();
+    void key(std::string_view name);
+    void writeString(std::string_view value);
+    void writeInt64(int64_t value);
+    void writeBool(bool value);
+    void writeNull();
+    // writes a value held by Poco::Dynamic::Var the same way Utils::stringify does
+    void writeVar(const Poco::Dynamic::Var& value);
+    const std::string& str() const { return _out; }
+    std::string release() { return std::move(_out); }
+
+private:
+    void beforeValue();
+
+    std::string _out;
+    std::vector<bool> _first;
+    bool _afterKey = false;
+};
+
+} // utils
+} // privmx
+
+#endif // _PRIVMXLIB_UTILS_JSON_WRITER_HPP_
@@ -0,0 +1,116 @@
+/*
+PrivMX Endpoint.
+Copyright © 2024 Simplito sp. z o.o.
+
+This file is part of the PrivMX Platform (https://privmx.dev).
+This software is Licensed under the PrivMX Free License.
+
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef _PRIVMXLIB_UTILS_METRICSREGISTRY_HPP_
+#define _PRIVMXLIB_UTILS_METRICSREGISTRY_HPP_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace privmx {
+namespace utils {
+
+// Histogram of durations in microseconds. Every power of two range is split into SUB_BUCKETS linear buckets,
+// so a percentile is known with a relative error below 1 / SUB_BUCKETS, whatever the magnitude of the values.
+class LatencyHistogram
+{
+public:
+    struct Snapshot {
+        int64_t count;
+        int64_t total;
+        int64_t max;
+        int64_t p50;
+        int64_t p90;
+        int64_t p99;
+    };
+
+    void record(int64_t value);
+    Snapshot getSnapshot() const;
+    void reset();
+
+    static size_t getBucket(int64_t value);
+    static int64_t getBucketUpperBound(size_t bucket);
+
+private:
+    static constexpr int SUB_BUCKET_BITS = 3;
+    static constexpr int64_t SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static constexpr size_t BUCKETS = (64 - SUB_BUCKET_BITS) * SUB_BUCKETS;
+
+    std::array<std::atomic<int64_t>, BUCKETS> _buckets {};
+    std::atomic<int64_t> _total {0};
+    std::atomic<int64_t> _max {0};
+};
+
+// Process-wide performance counters fed by the RPC layer, the crypto facade, the Executor and the event queue.
+// Recording is a few relaxed atomic operations, RPC methods are looked up in a map under a shared lock.
+class MetricsRegistry
+{
+public:
+    enum CryptoOperation {
+        AES_ENCRYPT = 0,
+        AES_DECRYPT = 1,
+        HASH = 2,
+        HMAC = 3,
+        ECIES_ENCRYPT = 4,
+        ECIES_DECRYPT = 5,
+        ECDH = 6,
+        ECDSA_SIGN = 7,
+        ECDSA_VERIFY = 8,
+        CRYPTO_OPERATIONS_COUNT = 9
+    };
+    struct RpcMethodSnapshot {
+        std::string method;
+        int64_t errors;
+        LatencyHistogram::Snapshot latency;
+    };
+    struct CryptoOperationSnapshot {
+        std::string operation;
+        int64_t operations;
+        int64_t bytes;
+    };
+    struct QueueSnapshot {
+        int64_t depth;
+        int64_t maxDepth;
+    };
+    struct Snapshot {
+        std::vector<RpcMethodSnapshot> rpcMethods;
+        std::vector<CryptoOperationSnapshot> cryptoOperations;
+        QueueSnapshot executorQueue;
+        LatencyHistogram::Snapshot executorQueueWait;
+        QueueSnapshot eventQueue;
+    };
+    using Clock = std::chrono::steady_clock;
+
+    static bool isEnabled();
+    // queue depths are tracked also while disabled, so they stay right after enabling again
+    static void setEnabled(bool enabled);
+    static void recordRpcCall(const std::string& method, Clock::time_point start, bool failed);
+    static void recordCryptoOperation(CryptoOperation operation, size_t bytes);
+    static void recordExecutorTaskQueued();
+    static void recordExecutorTaskStarted(Clock::time_point queuedAt);
+    static void recordExecutorQueueCleared();
+    static void recordEventQueued();
+    static void recordEventDequeued();
+    static void recordEventQueueCleared();
+    static Snapshot getSnapshot();
+    // clears counters and histograms, the current queue depths are kept as the new maximum
+    static void reset();
+};
+
+} // utils
+} // privmx
+
+#endif // _PRIVMXLIB_UTILS_METRICSREGISTRY_HPP_
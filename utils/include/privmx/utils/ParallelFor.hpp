@@ -0,0 +1,34 @@
+/*
+PrivMX Endpoint.
+Copyright © 2024 Simplito sp. z o.o.
+
+This file is part of the PrivMX Platform (https://privmx.dev).
+This software is Licensed under the PrivMX Free License.
+
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef _PRIVMXLIB_UTILS_PARALLELFOR_HPP_
+#define _PRIVMXLIB_UTILS_PARALLELFOR_HPP_
+
+#include <cstddef>
+#include <functional>
+
+namespace privmx {
+namespace utils {
+
+class ParallelFor
+{
+public:
+    static constexpr size_t MAX_THREADS = 4;
+
+    // Calls task(i) for every i in [0, count) using at most maxThreads threads, the calling thread included.
+    // Returns when all calls are finished and rethrows the first exception thrown by a task.
+    static void run(size_t count, const std::function<void(size_t)>& task, size_t maxThreads = MAX_THREADS);
+};
+
+} // utils
+} // privmx
+
+#endif // _PRIVMXLIB_UTILS_PARALLELFOR_HPP_
@@ -35,7 +35,8 @@ Executor::~Executor() {
 }
 
 void Executor::exec(std::function<void()> task) {
-    _tasksToDo->push(TaskData{.type = TaskType::NORMAL, .callback = task});
+    MetricsRegistry::recordExecutorTaskQueued();
+    _tasksToDo->push(TaskData{.type = TaskType::NORMAL, .callback = task, .queuedAt = MetricsRegistry::Clock::now()});
 }
 
 void Executor::createThread() {
@@ -50,6 +51,7 @@ void Executor::createThread() {
                     LOG_TRACE("Executor recived StopTask")
                     break;
                 }
+                MetricsRegistry::recordExecutorTaskStarted(task.queuedAt);
                 task.callback();
             } catch (const std::exception& e) {
                 LOG_ERROR("Executor thread catch'ed exception '", e.what(), "' when processing task")
@@ -77,10 +79,11 @@ void Executor::initializeThreadPool() {
 void Executor::stopAllThreadInThePool() {
     if(_threadPool.size() != 0) {
         _tasksToDo->clear();
+        MetricsRegistry::recordExecutorQueueCleared();
         LOG_INFO("Executor stopping ", PRIVMX_EXECUTOR_THREAD_POOL_SIZE, " threads")
         for(auto& executorThread: _threadPool) {
             executorThread.token->cancel();
-            _tasksToDo->push(TaskData{.type = TaskType::STOP, .callback = std::function<void()>()});
+            _tasksToDo->push(TaskData{.type = TaskType::STOP, .callback = std::function<void()>(), .queuedAt = MetricsRegistry::Clock::now()});
         }
         for(auto& executorThread: _threadPool) {
             if(executorThread.thread.joinable()) {
@@ -0,0 +1,312 @@
+/*
+PrivMX Endpoint.
+Copyright © 2024 Simplito sp. z o.o.
+
+This file is part of the PrivMX Platform (https://privmx.dev).
+This software is Licensed under the PrivMX Free License.
+
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <limits>
+
+#include "privmx/utils/JsonReader.hpp"
+#include "privmx/utils/PrivmxExtExceptions.hpp"
+
+using namespace privmx::utils;
+
+JsonReader::JsonReader(std::string_view json) : _json(json) {}
+
+void JsonReader::beginObject() {
+    expect('{');
+    _first.push_back(true);
+}
+
+bool JsonReader::nextKey(std::string& key) {
+    if (_first.empty()) {
+        fail();
+    }
+    if (peek() == '}') {
+        ++_pos;
+        _first.pop_back();
+        return false;
+    }
+    if (!_first.back()) {
+        expect(',');
+    }
+    _first.back() = false;
+    key = readString();
+    expect(':');
+    return true;
+}
+
+void JsonReader::beginArray() {
+    expect('[');
+    _first.push_back(true);
+}
+
+bool JsonReader::nextElement() {
+    if (_first.empty()) {
+        fail();
+    }
+    if (peek() == ']') {
+        ++_pos;
+        _first.pop_back();
+        return false;
+    }
+    if (!_first.back()) {
+        expect(',');
+    }
+    _first.back() = false;
+    return true;
+}
+
+bool JsonReader::readNull() {
+    if (peek() != 'n') {
+        return false;
+    }
+    expectLiteral("null");
+    return true;
+}
+
+std::string JsonReader::readString() {
+    expect('"');
+    std::string result;
+    size_t start = _pos;
+    while (true) {
+        if (_pos >= _json.size()) {
+            fail();
+        }
+        char c = _json[_pos];
+        if (c == '"') {
+            result.append(_json.data() + start, _pos - start);
+            ++_pos;
+            return result;
+        }
+        if (static_cast<unsigned char>(c) < 0x20) {
+            fail();
+        }
+        if (c != '\\') {
+            ++_pos;
+            continue;
+        }
+        result.append(_json.data() + start, _pos - start);
+        if (++_pos >= _json.size()) {
+            fail();
+        }
+        switch (_json[_pos++]) {
+            case '"': result.push_back('"'); break;
+            case '\\': result.push_back('\\'); break;
+            case '/': result.push_back('/'); break;
+            case 'b': result.push_back('\b'); break;
+            case 'f': result.push_back('\f'); break;
+            case 'n': result.push_back('\n'); break;
+            case 'r': result.push_back('\r'); break;
+            case 't': result.push_back('\t'); break;
+            case 'u': {
+                uint32_t codePoint = readHex4();
+                if (codePoint >= 0xD800 && codePoint <= 0xDBFF) {
+                    expectLiteral("\\u");
+                    uint32_t low = readHex4();
+                    if (low < 0xDC00 || low > 0xDFFF) {
+                        fail();
+                    }
+                    codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+                } else if (codePoint >= 0xDC00 && codePoint <= 0xDFFF) {
+                    fail();
+                }
+                appendCodePoint(result, codePoint);
+                break;
+            }
+            default: fail();
+        }
+        start = _pos;
+    }
+}
+
+int64_t JsonReader::readInt64() {
+    skipWhitespace();
+    size_t start = _pos;
+    bool negative = false;
+    if (_pos < _json.size() && _json[_pos] == '-') {
+        negative = true;
+        ++_pos;
+    }
+    if (_pos >= _json.size() || _json[_pos] < '0' || _json[_pos] > '9') {
+        fail();
+    }
+    // accumulated as negative, so INT64_MIN fits
+    int64_t value = 0;
+    while (_pos < _json.size() && _json[_pos] >= '0' && _json[_pos] <= '9') {
+        int digit = _json[_pos++] - '0';
+        if (value < (std::numeric_limits<int64_t>::min() + digit) / 10) {
+            fail();
+        }
+        value = value * 10 - digit;
+    }
+    if (_pos < _json.size() && (_json[_pos] == '.' || _json[_pos] == 'e' || _json[_pos] == 'E')) {
+        fail();
+    }
+    if (_json[start + (negative ? 1 : 0)] == '0' && _pos - start > (negative ? 2u : 1u)) {
+        fail();
+    }
+    if (!negative) {
+        if (value == std::numeric_limits<int64_t>::min()) {
+            fail();
+        }
+        value = -value;
+    }
+    return value;
+}
+
+bool JsonReader::readBool() {
+    char c = peek();
+    if (c == 't') {
+        expectLiteral("true");
+        return true;
+    }
+    if (c == 'f') {
+        expectLiteral("false");
+        return false;
+    }
+    fail();
+}
+
+std::string_view JsonReader::readRaw() {
+    skipWhitespace();
+    size_t start = _pos;
+    skip();
+    return _json.substr(start, _pos - start);
+}
+
+void JsonReader::skip() {
+    char c = peek();
+    if (c == '{') {
+        beginObject();
+        std::string key;
+        while (nextKey(key)) {
+            skip();
+        }
+    } else if (c == '[') {
+        beginArray();
+        while (nextElement()) {
+            skip();
+        }
+    } else if (c == '"') {
+        skipString();
+    } else if (c == 't' || c == 'f') {
+        readBool();
+    } else if (c == 'n') {
+        expectLiteral("null");
+    } else {
+        skipNumber();
+    }
+}
+
+void JsonReader::finish() {
+    skipWhitespace();
+    if (_pos != _json.size() || !_first.empty()) {
+        fail();
+    }
+}
+
+void JsonReader::skipWhitespace() {
+    while (_pos < _json.size() && (_json[_pos] == ' ' || _json[_pos] == '\n' || _json[_pos] == '\r' || _json[_pos] == '\t')) {
+        ++_pos;
+    }
+}
+
+char JsonReader::peek() {
+    skipWhitespace();
+    if (_pos >= _json.size()) {
+        fail();
+    }
+    return _json[_pos];
+}
+
+void JsonReader::expect(char c) {
+    if (peek() != c) {
+        fail();
+    }
+    ++_pos;
+}
+
+void JsonReader::expectLiteral(std::string_view literal) {
+    if (_json.substr(_pos, literal.size()) != literal) {
+        fail();
+    }
+    _pos += literal.size();
+}
+
+void JsonReader::skipString() {
+    expect('"');
+    while (_pos < _json.size() && _json[_pos] != '"') {
+        if (static_cast<unsigned char>(_json[_pos]) < 0x20) {
+            fail();
+        }
+        _pos += (_json[_pos] == '\\') ? 2 : 1;
+    }
+    if (_pos >= _json.size()) {
+        fail();
+    }
+    ++_pos;
+}
+
+void JsonReader::skipNumber() {
+    size_t start = _pos;
+    while (_pos < _json.size()) {
+        char c = _json[_pos];
+        if ((c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E') {
+            ++_pos;
+        } else {
+            break;
+        }
+    }
+    if (_pos == start) {
+        fail();
+    }
+}
+
+void JsonReader::appendCodePoint(std::string& out, uint32_t codePoint) {
+    if (codePoint < 0x80) {
+        out.push_back(static_cast<char>(codePoint));
+    } else if (codePoint < 0x800) {
+        out.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    } else if (codePoint < 0x10000) {
+        out.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    } else {
+        out.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    }
+}
+
+uint32_t JsonReader::readHex4() {
+    if (_pos + 4 > _json.size()) {
+        fail();
+    }
+    uint32_t result = 0;
+    for (int i = 0; i < 4; ++i) {
+        char c = _json[_pos++];
+        result <<= 4;
+        if (c >= '0' && c <= '9') {
+            result |= c - '0';
+        } else if (c >= 'a' && c <= 'f') {
+            result |= c - 'a' + 10;
+        } else if (c >= 'A' && c <= 'F') {
+            result |= c - 'A' + 10;
+        } else {
+            fail();
+        }
+    }
+    return result;
+}
+
+void JsonReader::fail() {
+    throw JSONParseException("Invalid or unsupported JSON at position " + std::to_string(_pos));
+}
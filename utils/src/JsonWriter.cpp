@@ -0,0 +1,109 @@
+/*
+PrivMX Endpoint.
+Copyright © 2024 Simplito sp. z o.o.
+
+This file is part of the PrivMX Platform (https://privmx.dev).
+This software is Licensed under the PrivMX Free License.
+
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <sstream>
+#include <Poco/JSON/Stringifier.h>
+
+#include "privmx/utils/JsonWriter.hpp"
+#include "privmx/utils/Utils.hpp"
+
+using namespace privmx::utils;
+
+void JsonWriter::beginObject() {
+    beforeValue();
+    _out.push_back('{');
+    _first.push_back(true);
+}
+
+void JsonWriter::endObject() {
+    _out.push_back('}');
+    _first.pop_back();
+}
+
+void JsonWriter::beginArray() {
+    beforeValue();
+    _out.push_back('[');
+    _first.push_back(true);
+}
+
+void JsonWriter::endArray() {
+    _out.push_back(']');
+    _first.pop_back();
+}
+
+void JsonWriter::key(std::string_view name) {
+    writeString(name);
+    _out.push_back(':');
+    _afterKey = true;
+}
+
+void JsonWriter::writeString(std::string_view value) {
+    static const char* HEX = "0123456789abcdef";
+    beforeValue();
+    _out.reserve(_out.size() + value.size() + 2);
+    _out.push_back('"');
+    for (char c : value) {
+        switch (c) {
+            case '"': _out.append("\\\""); break;
+            case '\\': _out.append("\\\\"); break;
+            case '\b': _out.append("\\b"); break;
+            case '\f': _out.append("\\f"); break;
+            case '\n': _out.append("\\n"); break;
+            case '\r': _out.append("\\r"); break;
+            case '\t': _out.append("\\t"); break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    _out.append("\\u00");
+                    _out.push_back(HEX[(c >> 4) & 0x0F]);
+                    _out.push_back(HEX[c & 0x0F]);
+                } else {
+                    _out.push_back(c);
+                }
+        }
+    }
+    _out.push_back('"');
+}
+
+void JsonWriter::writeInt64(int64_t value) {
+    beforeValue();
+    _out.append(std::to_string(value));
+}
+
+void JsonWriter::writeBool(bool value) {
+    beforeValue();
+    _out.append(value ? "true" : "false");
+}
+
+void JsonWriter::writeNull() {
+    beforeValue();
+    _out.append("null");
+}
+
+void JsonWriter::writeVar(const Poco::Dynamic::Var& value) {
+    beforeValue();
+    std::ostringstream stream;
+    Poco::JSON::Stringifier::stringify(value, stream);
+    _out.append(Utils::removeEscape(stream.str()));
+}
+
+void JsonWriter::beforeValue() {
+    if (_afterKey) {
+        // the comma was written before the key
+        _afterKey = false;
+        return;
+    }
+    if (!_first.empty()) {
+        if (!_first.back()) {
+            _out.push_back(',');
+        }
+        _first.back() = false;
+    }
+}
@@ -0,0 +1,287 @@
+/*
+PrivMX Endpoint.
+Copyright © 2024 Simplito sp. z o.o.
+
+This file is part of the PrivMX Platform (https://privmx.dev).
+This software is Licensed under the PrivMX Free License.
+
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+#include "privmx/utils/MetricsRegistry.hpp"
+
+using namespace privmx::utils;
+
+namespace {
+
+void updateMax(std::atomic<int64_t>& max, int64_t value) {
+    int64_t current = max.load(std::memory_order_relaxed);
+    while(value > current && !max.compare_exchange_weak(current, value, std::memory_order_relaxed));
+}
+
+class QueueDepth
+{
+public:
+    void add(int64_t delta) {
+        int64_t depth = _depth.fetch_add(delta, std::memory_order_relaxed) + delta;
+        if(delta > 0) {
+            updateMax(_maxDepth, depth);
+        }
+    }
+    void clear() {
+        _depth.store(0, std::memory_order_relaxed);
+    }
+    void resetMax() {
+        _maxDepth.store(_depth.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+    MetricsRegistry::QueueSnapshot getSnapshot() const {
+        return MetricsRegistry::QueueSnapshot{
+            .depth = std::max<int64_t>(_depth.load(std::memory_order_relaxed), 0),
+            .maxDepth = _maxDepth.load(std::memory_order_relaxed)
+        };
+    }
+
+private:
+    std::atomic<int64_t> _depth {0};
+    std::atomic<int64_t> _maxDepth {0};
+};
+
+struct RpcMethodStats {
+    std::atomic<int64_t> errors {0};
+    LatencyHistogram latency;
+};
+
+struct CryptoOperationStats {
+    std::atomic<int64_t> operations {0};
+    std::atomic<int64_t> bytes {0};
+};
+
+const char* CRYPTO_OPERATION_NAMES[MetricsRegistry::CRYPTO_OPERATIONS_COUNT] = {
+    "aesEncrypt",
+    "aesDecrypt",
+    "hash",
+    "hmac",
+    "eciesEncrypt",
+    "eciesDecrypt",
+    "ecdh",
+    "ecdsaSign",
+    "ecdsaVerify"
+};
+
+struct State {
+    std::atomic_bool enabled {true};
+    std::shared_mutex rpcMethodsMutex;
+    std::unordered_map<std::string, std::unique_ptr<RpcMethodStats>> rpcMethods;
+    std::array<CryptoOperationStats, MetricsRegistry::CRYPTO_OPERATIONS_COUNT> cryptoOperations;
+    QueueDepth executorQueue;
+    LatencyHistogram executorQueueWait;
+    QueueDepth eventQueue;
+};
+
+State& getState() {
+    // never destroyed, as the library threads may still record while static objects are destroyed
+    static State* state = new State();
+    return *state;
+}
+
+int64_t getMicroseconds(MetricsRegistry::Clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(MetricsRegistry::Clock::now() - start).count();
+}
+
+RpcMethodStats& getRpcMethodStats(State& state, const std::string& method) {
+    {
+        std::shared_lock lock(state.rpcMethodsMutex);
+        auto stats = state.rpcMethods.find(method);
+        if(stats != state.rpcMethods.end()) {
+            return *stats->second;
+        }
+    }
+    std::unique_lock lock(state.rpcMethodsMutex);
+    auto& stats = state.rpcMethods[method];
+    if(!stats) {
+        stats = std::make_unique<RpcMethodStats>();
+    }
+    return *stats;
+}
+
+}
+
+size_t LatencyHistogram::getBucket(int64_t value) {
+    if(value < SUB_BUCKETS) {
+        return value < 0 ? 0 : value;
+    }
+    int exponent = 63 - __builtin_clzll(value);
+    int shift = exponent - SUB_BUCKET_BITS;
+    return (shift + 1) * SUB_BUCKETS + ((value >> shift) & (SUB_BUCKETS - 1));
+}
+
+int64_t LatencyHistogram::getBucketUpperBound(size_t bucket) {
+    if(bucket < 2 * SUB_BUCKETS) {
+        return bucket;
+    }
+    int shift = bucket / SUB_BUCKETS - 1;
+    int64_t lower = (SUB_BUCKETS + (int64_t)(bucket % SUB_BUCKETS)) << shift;
+    return lower + (int64_t(1) << shift) - 1;
+}
+
+void LatencyHistogram::record(int64_t value) {
+    _buckets[getBucket(value)].fetch_add(1, std::memory_order_relaxed);
+    _total.fetch_add(value, std::memory_order_relaxed);
+    updateMax(_max, value);
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::getSnapshot() const {
+    std::array<int64_t, BUCKETS> buckets;
+    int64_t count = 0;
+    for(size_t i = 0; i < BUCKETS; ++i) {
+        buckets[i] = _buckets[i].load(std::memory_order_relaxed);
+        count += buckets[i];
+    }
+    Snapshot result {
+        .count = count,
+        .total = _total.load(std::memory_order_relaxed),
+        .max = _max.load(std::memory_order_relaxed),
+        .p50 = 0,
+        .p90 = 0,
+        .p99 = 0
+    };
+    std::pair<int64_t*, int64_t> percentiles[] = {{&result.p50, 50}, {&result.p90, 90}, {&result.p99, 99}};
+    for(auto& [percentile, level] : percentiles) {
+        int64_t rank = (count * level + 99) / 100;
+        int64_t seen = 0;
+        for(size_t i = 0; i < BUCKETS && rank > 0; ++i) {
+            seen += buckets[i];
+            if(seen >= rank) {
+                *percentile = std::min(getBucketUpperBound(i), result.max);
+                break;
+            }
+        }
+    }
+    return result;
+}
+
+void LatencyHistogram::reset() {
+    for(auto& bucket : _buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    _total.store(0, std::memory_order_relaxed);
+    _max.store(0, std::memory_order_relaxed);
+}
+
+bool MetricsRegistry::isEnabled() {
+    return getState().enabled.load(std::memory_order_relaxed);
+}
+
+void MetricsRegistry::setEnabled(bool enabled) {
+    getState().enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void MetricsRegistry::recordRpcCall(const std::string& method, Clock::time_point start, bool failed) {
+    auto& state = getState();
+    if(!state.enabled.load(std::memory_order_relaxed)) {
+        return;
+    }
+    auto& stats = getRpcMethodStats(state, method);
+    stats.latency.record(getMicroseconds(start));
+    if(failed) {
+        stats.errors.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void MetricsRegistry::recordCryptoOperation(CryptoOperation operation, size_t bytes) {
+    auto& state = getState();
+    if(!state.enabled.load(std::memory_order_relaxed)) {
+        return;
+    }
+    auto& stats = state.cryptoOperations[operation];
+    stats.operations.fetch_add(1, std::memory_order_relaxed);
+    stats.bytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void MetricsRegistry::recordExecutorTaskQueued() {
+    getState().executorQueue.add(1);
+}
+
+void MetricsRegistry::recordExecutorTaskStarted(Clock::time_point queuedAt) {
+    auto& state = getState();
+    state.executorQueue.add(-1);
+    if(state.enabled.load(std::memory_order_relaxed)) {
+        state.executorQueueWait.record(getMicroseconds(queuedAt));
+    }
+}
+
+void MetricsRegistry::recordExecutorQueueCleared() {
+    getState().executorQueue.clear();
+}
+
+void MetricsRegistry::recordEventQueued() {
+    getState().eventQueue.add(1);
+}
+
+void MetricsRegistry::recordEventDequeued() {
+    getState().eventQueue.add(-1);
+}
+
+void MetricsRegistry::recordEventQueueCleared() {
+    getState().eventQueue.clear();
+}
+
+MetricsRegistry::Snapshot MetricsRegistry::getSnapshot() {
+    auto& state = getState();
+    Snapshot result {
+        .rpcMethods = {},
+        .cryptoOperations = {},
+        .executorQueue = state.executorQueue.getSnapshot(),
+        .executorQueueWait = state.executorQueueWait.getSnapshot(),
+        .eventQueue = state.eventQueue.getSnapshot()
+    };
+    {
+        std::shared_lock lock(state.rpcMethodsMutex);
+        // sorted by the method name for a stable output
+        std::map<std::string, RpcMethodStats*> methods;
+        for(const auto& [method, stats] : state.rpcMethods) {
+            methods.emplace(method, stats.get());
+        }
+        for(const auto& [method, stats] : methods) {
+            result.rpcMethods.push_back(RpcMethodSnapshot{
+                .method = method,
+                .errors = stats->errors.load(std::memory_order_relaxed),
+                .latency = stats->latency.getSnapshot()
+            });
+        }
+    }
+    for(size_t i = 0; i < CRYPTO_OPERATIONS_COUNT; ++i) {
+        result.cryptoOperations.push_back(CryptoOperationSnapshot{
+            .operation = CRYPTO_OPERATION_NAMES[i],
+            .operations = state.cryptoOperations[i].operations.load(std::memory_order_relaxed),
+            .bytes = state.cryptoOperations[i].bytes.load(std::memory_order_relaxed)
+        });
+    }
+    return result;
+}
+
+void MetricsRegistry::reset() {
+    auto& state = getState();
+    {
+        std::shared_lock lock(state.rpcMethodsMutex);
+        for(auto& [method, stats] : state.rpcMethods) {
+            stats->errors.store(0, std::memory_order_relaxed);
+            stats->latency.reset();
+        }
+    }
+    for(auto& stats : state.cryptoOperations) {
+        stats.operations.store(0, std::memory_order_relaxed);
+        stats.bytes.store(0, std::memory_order_relaxed);
+    }
+    state.executorQueue.resetMax();
+    state.executorQueueWait.reset();
+    state.eventQueue.resetMax();
+}
@@ -0,0 +1,58 @@
+/*
+PrivMX Endpoint.
+Copyright © 2024 Simplito sp. z o.o.
+
+This file is part of the PrivMX Platform (https://privmx.dev).
+This software is Licensed under the PrivMX Free License.
+
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <future>
+#include <vector>
+
+#include "privmx/utils/ParallelFor.hpp"
+
+using namespace privmx::utils;
+
+void ParallelFor::run(size_t count, const std::function<void(size_t)>& task, size_t maxThreads) {
+    size_t threads = std::min(count, maxThreads);
+    if(threads <= 1) {
+        for(size_t i = 0; i < count; ++i) {
+            task(i);
+        }
+        return;
+    }
+    std::atomic_size_t next(0);
+    auto worker = [&]() {
+        for(size_t i = next++; i < count; i = next++) {
+            task(i);
+        }
+    };
+    std::vector<std::future<void>> futures;
+    for(size_t i = 1; i < threads; ++i) {
+        futures.push_back(std::async(std::launch::async, worker));
+    }
+    std::exception_ptr error;
+    try {
+        worker();
+    } catch (...) {
+        error = std::current_exception();
+    }
+    for(auto& future : futures) {
+        try {
+            future.get();
+        } catch (...) {
+            if(!error) {
+                error = std::current_exception();
+            }
+        }
+    }
+    if(error) {
+        std::rethrow_exception(error);
+    }
+}
@@ -0,0 +1,127 @@
+/*
+PrivMX Endpoint.
+Copyright © 2024 Simplito sp. z o.o.
+
+This file is part of the PrivMX Platform (https://privmx.dev).
+This software is Licensed under the PrivMX Free License.
+
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include <privmx/utils/JsonHelper.hpp>
+
+using namespace std;
+
+namespace privmx {
+namespace utils {
+namespace {
+
+#define TEST_ITEM_FIELDS(F)\
+    F(id,        std::string)\
+    F(count,     int64_t)\
+    F(enabled,   bool)\
+    F(tags,      std::vector<std::string>)\
+    F(note,      std::optional<std::string>)\
+    F(data,      Poco::Dynamic::Var)
+JSON_STRUCT(TestItem, TEST_ITEM_FIELDS);
+
+#define TEST_LIST_FIELDS(F)\
+    F(items,     std::vector<TestItem>)\
+    F(names,     std::map<std::string, int64_t>)
+JSON_STRUCT(TestList, TEST_LIST_FIELDS);
+
+#define TEST_EXT_FIELDS(F)\
+    F(extra,     std::optional<int64_t>)
+JSON_STRUCT_EXT(TestExt, TestItem, TEST_EXT_FIELDS);
+
+#define TEST_KEYED_FIELDS(F)\
+    F(key,       std::string)\
+    F(attributes, std::unordered_map<std::string, int64_t>)\
+    F(blank,     std::optional<std::string>)
+JSON_STRUCT_EXT(TestKeyed, TestExt, TEST_KEYED_FIELDS);
+
+const string ITEM = R"({"id":"a\"\\\n\u00e9\ud83d\ude00","count":-42,"enabled":true,"tags":["x","y"],"unknown":{"a":[1,2,{"b":null}]},"data":{"k":[1,"v"]}})";
+
+TEST(JsonHelper, DirectReadMatchesTree) {
+    auto direct = TestItem::deserialize(ITEM);
+    auto tree = TestItem::fromJSON(Utils::parseJsonObject(ITEM));
+    EXPECT_EQ(direct.id, tree.id);
+    EXPECT_EQ(direct.id, "a\"\\\n\xC3\xA9\xF0\x9F\x98\x80");
+    EXPECT_EQ(direct.count, -42);
+    EXPECT_TRUE(direct.enabled);
+    EXPECT_EQ(direct.tags, vector<string>({"x", "y"}));
+    EXPECT_FALSE(direct.note.has_value());
+    ASSERT_EQ(direct.data.type(), typeid(Poco::JSON::Object::Ptr));
+    EXPECT_TRUE(direct.data.extract<Poco::JSON::Object::Ptr>()->has("k"));
+}
+
+TEST(JsonHelper, DirectWriteRoundTrip) {
+    auto item = TestItem::deserialize(ITEM);
+    item.note = "n";
+    auto again = TestItem::deserialize(item.serialize());
+    EXPECT_EQ(again.id, item.id);
+    EXPECT_EQ(again.count, item.count);
+    EXPECT_EQ(again.tags, item.tags);
+    EXPECT_EQ(again.note, item.note);
+    TestList list;
+    list.items = {item, item};
+    list.names = {{"a", 1}, {"b", 2}};
+    auto listAgain = TestList::deserialize(list.serialize());
+    ASSERT_EQ(listAgain.items.size(), 2u);
+    EXPECT_EQ(listAgain.items[1].id, item.id);
+    EXPECT_EQ(listAgain.names, list.names);
+}
+
+TEST(JsonHelper, DirectReadExtendedStruct) {
+    auto ext = TestExt::deserialize(R"({"extra":7,"id":"i","count":1,"enabled":false,"tags":[],"data":null})");
+    EXPECT_EQ(ext.id, "i");
+    EXPECT_EQ(ext.extra, 7);
+    EXPECT_TRUE(ext.data.isEmpty());
+    auto again = TestExt::deserialize(ext.serialize());
+    EXPECT_EQ(again.extra, 7);
+    EXPECT_EQ(again.id, "i");
+}
+
+TEST(JsonHelper, DirectWriteKeepsTreeKeyOrder) {
+    auto keyed = TestKeyed::deserialize(R"({"key":"k","attributes":{"z":1,"a":2,"m":3},"extra":1,"id":"i","count":1,"enabled":true,"tags":["t"],"data":{"b":1,"a":2}})");
+    EXPECT_EQ(keyed.key, "k");
+    EXPECT_EQ(keyed.serialize(), Utils::stringify(keyed.toJSON()));
+}
+
+TEST(JsonHelper, TreeReadMatchesDirect) {
+    const string json = R"({"key":"k","attributes":{"a":2},"extra":1,"id":"i","count":1,"enabled":true,"tags":["t"],"data":null,"unknown":[1]})";
+    auto tree = TestKeyed::fromJSON(Utils::parseJsonObject(json));
+    EXPECT_EQ(tree.key, "k");
+    EXPECT_EQ(tree.extra, 1);
+    EXPECT_EQ(tree.tags, vector<string>({"t"}));
+    EXPECT_FALSE(tree.blank.has_value());
+    EXPECT_EQ(tree.serialize(), TestKeyed::deserialize(json).serialize());
+    // missing required field
+    EXPECT_THROW(TestKeyed::fromJSON(Utils::parseJsonObject(R"({"key":"k","attributes":{},"id":"i","count":1,"enabled":true,"data":1})")), JSONParseException);
+}
+
+TEST(JsonHelper, DirectReadFallsBackToTree) {
+    // non-integer number is not handled by the direct reader, the tree path reports the error
+    EXPECT_THROW(TestItem::deserialize(R"({"id":"a","count":1.5,"enabled":true,"tags":[],"data":1})"), JSONParseException);
+    // missing required field
+    EXPECT_THROW(TestItem::deserialize(R"({"count":1,"enabled":true,"tags":[],"data":1})"), JSONParseException);
+    EXPECT_THROW(TestItem::deserialize(R"({"id":"a")"), std::exception);
+}
+
+TEST(JsonHelper, ReaderRejectsMalformedInput) {
+    for (string json : {"", "{", "[1,]", "{\"a\" 1}", "\"\\x\"", "01", "tru", "\"\\ud800\"", "9223372036854775808"}) {
+        JsonReader reader(json);
+        EXPECT_THROW({ reader.skip(); reader.finish(); reader.readInt64(); }, JSONParseException) << json;
+    }
+    JsonReader reader("-9223372036854775808");
+    EXPECT_EQ(reader.readInt64(), std::numeric_limits<int64_t>::min());
+}
+
+} // namespace
+} // namespace utils
+} // namespace privmx
@@ -0,0 +1,49 @@
+/*
+PrivMX Endpoint.
+Copyright © 2024 Simplito sp. z o.o.
+
+This file is part of the PrivMX Platform (https://privmx.dev).
+This software is Licensed under the PrivMX Free License.
+
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include <privmx/utils/ParallelFor.hpp>
+
+using namespace std;
+
+namespace privmx {
+namespace utils {
+
+TEST(ParallelFor, CallsTaskForEveryIndexOnce) {
+    for(size_t maxThreads : {1, 2, 4, 16}) {
+        vector<atomic_int> calls(1000);
+        ParallelFor::run(calls.size(), [&](size_t i) { calls[i]++; }, maxThreads);
+        for(auto& c : calls) {
+            EXPECT_EQ(c.load(), 1);
+        }
+    }
+    ParallelFor::run(0, [](size_t) { FAIL(); });
+}
+
+TEST(ParallelFor, RethrowsTaskException) {
+    atomic_int finished(0);
+    EXPECT_THROW({
+        ParallelFor::run(100, [&](size_t i) {
+            if(i == 42) {
+                throw runtime_error("task failed");
+            }
+            finished++;
+        });
+    }, runtime_error);
+    EXPECT_LE(finished.load(), 99);
+}
+
+} // utils
+} // privmx